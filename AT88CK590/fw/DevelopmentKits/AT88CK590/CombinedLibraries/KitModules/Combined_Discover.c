@@ -26,6 +26,7 @@
 #include "Combined_Discover.h"
 #include "delay_x.h"
 #include "i2c_phys.h"
+#include "cryptoauth_crc.h"
 
 #include "aes132_lib_return_codes.h"
 #include "aes132_commands.h"
@@ -43,6 +44,10 @@
 #endif
 
 
+//! number of DevRev attempts on a SWI pin whose responses fail the CRC check
+#define DEVREV_ATTEMPTS_MAX    (3)
+
+
 //! This macro updates the device type.
 #define UPDATE_DEVICE_TYPE device_info[device_count].device_type = \
 		device_info[device_count].dev_rev[2] == 0 ? DEVICE_TYPE_SHA204 : DEVICE_TYPE_ECC108
@@ -81,24 +86,19 @@ device_type_t GetDeviceType(uint8_t index) {
 }
 
 
-/** This function checks the consistency of a SHA204 response.
+/** This function checks the count byte of a SHA204 response.
+ *
+ * The CRC has already been checked by the Physical layer while the response was received.
  * \param[in] response pointer to response buffer
  * \return status of the operation
  */
 uint8_t VerifyResponse(uint8_t *response)
 {
-	uint8_t crc[SHA204_CRC_SIZE];
-
-	// Check count byte.
 	uint8_t count = response[SHA204_COUNT_IDX];
 	if (count < SHA204_RSP_SIZE_MIN || count > SHA204_RSP_SIZE_MAX)
 		return SHA204_INVALID_SIZE;
 
-	// Check CRC.
-	count -= SHA204_CRC_SIZE;
-	sha204c_calculate_crc(count, response, crc);
-	return (*((uint16_t *) crc) == *((uint16_t *) (response + count)))
-		? SHA204_SUCCESS : SHA204_BAD_CRC;
+	return SHA204_SUCCESS;
 }
 
 
@@ -115,6 +115,7 @@ uint8_t DetectSwiDevices(void)
 		return 0;
 
 	static uint8_t lib_return;
+	uint8_t devrev_sent, crc_errors;
 	uint8_t command[SHA204_CMD_SIZE_MIN];
 	uint8_t response[SHA204_RSP_SIZE_VAL];
 	uint8_t device_id;
@@ -150,11 +151,19 @@ uint8_t DetectSwiDevices(void)
 		// We found a device.
 		// Send a SHA204 "Device Revision" command (same as ECC108 "Info") and receive its response.
 		// We don't use sha204c_send_and_receive() because this function would retry
-		// even if we woke up an SA10xS device.
-		lib_return = sha204p_send_command(sha204_devrev_command[SHA204_COUNT_IDX], sha204_devrev_command);
-		if (lib_return == SHA204_SUCCESS) {
+		// even if we woke up an SA10xS device. A response with a bad CRC can only come
+		// from a SHA204 or ECC108 device, so only that case is retried here.
+		devrev_sent = crc_errors = 0;
+		do {
+			lib_return = sha204p_send_command(sha204_devrev_command[SHA204_COUNT_IDX], sha204_devrev_command);
+			if (lib_return != SHA204_SUCCESS)
+				break;
+			devrev_sent = 1;
 			_delay_ms(DEVREV_EXEC_MAX);
 			lib_return = sha204p_receive_response(sizeof(response), response);
+		} while ((lib_return == SHA204_BAD_CRC) && (++crc_errors < DEVREV_ATTEMPTS_MAX));
+
+		if (devrev_sent) {
 			if (lib_return == SHA204_SUCCESS) {
 				// We found a SHA204 or ECC108 device.
 				if (VerifyResponse(response) == SHA204_SUCCESS) {
@@ -174,11 +183,12 @@ uint8_t DetectSwiDevices(void)
 						memset(&device_info[device_count], 0, sizeof(device_info_t));
 				}
 			}
-			else {
+			else if (crc_errors == 0) {
 				// Since a device has woken up with an expected response and it did not reply
 				// to a DevRev / Info command, we probably found an SA10x device. Let's confirm this
 				// by sending a GenPersonizationKey command that is the same for all three
 				// types of SA10x devices, SA100S, SA102S, and SA10HS.
+				// We never get here after a response with a bad CRC. That pin is skipped.
 				uint8_t count = sa10_genkey_command[SHA204_COUNT_IDX];
 				uint8_t len = count - SHA204_CRC_SIZE;
 				sha204c_calculate_crc(len, sa10_genkey_command, sa10_genkey_command + len);
@@ -265,6 +275,8 @@ uint8_t DetectI2cCryptoAuth(uint8_t i2c_address)
 	uint8_t sha204_command[2] = {i2c_address, 3};
 	uint8_t sha204_response[DEVREV_RSP_SIZE];
 	uint8_t response_status;
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE];
+	struct cryptoauth_crc_rx crc_rx;
 	uint8_t wakeup_response_expected[] = {0x04, 0x11, 0x33, 0x43};
 	uint8_t i2c_status = i2c_send_start();
 	if (i2c_status != I2C_FUNCTION_RETCODE_SUCCESS)
@@ -308,8 +320,9 @@ uint8_t DetectI2cCryptoAuth(uint8_t i2c_address)
 		i2c_send_stop();
 		return i2c_status;
 	}
-	// i2c_receive_bytes sends at Stop after the last byte has been received.
-	i2c_status = i2c_receive_bytes(sizeof(sha204_response), sha204_response);
+	// i2c_receive_bytes_crc sends at Stop after the last byte has been received.
+	cryptoauth_crc_rx_init(&crc_rx, 0);
+	i2c_status = i2c_receive_bytes_crc(sizeof(sha204_response), sha204_response, &crc_rx);
 	if (i2c_status != I2C_FUNCTION_RETCODE_SUCCESS)
 		return i2c_status;
 
@@ -321,7 +334,10 @@ uint8_t DetectI2cCryptoAuth(uint8_t i2c_address)
 
 	// Validate response.
 	response_status = VerifyResponse(sha204_response);
-	if (response_status != SHA204_SUCCESS)
+	if ((response_status != SHA204_SUCCESS) || (sha204_response[SHA204_COUNT_IDX] != sizeof(sha204_response)))
+		return I2C_FUNCTION_RETCODE_COMM_FAIL;
+	cryptoauth_crc_rx_final(&crc_rx, crc);
+	if (memcmp(crc, &sha204_response[sizeof(sha204_response) - CRYPTOAUTH_CRC_SIZE], sizeof(crc)))
 		return I2C_FUNCTION_RETCODE_COMM_FAIL;
 
 	// Found SHA204. Update device_info array.
@@ -82,6 +82,7 @@ uint8_t (*aes132d_select_device)(uint8_t) = twi_aes132p_select_device;
 uint8_t (*aes132d_resync_physical)(void) = twi_aes132p_resync_physical;
 uint8_t (*aes132d_write_memory_physical)(uint8_t, uint16_t, uint8_t*) = twi_aes132p_write_memory_physical;
 uint8_t (*aes132d_read_memory_physical)(uint8_t, uint16_t, uint8_t*) = twi_aes132p_read_memory_physical;
+uint8_t (*aes132d_read_memory_physical_crc)(uint8_t, uint16_t, uint8_t*, struct cryptoauth_crc_rx*) = twi_aes132p_read_memory_physical_crc;
 
 void  (*sha204d_enable_interface)(void) = twi_sha204p_init;
 void  (*sha204d_disable_interface)(void) = i2c_sha204p_close_channel;
@@ -112,6 +113,7 @@ uint8_t aes132p_set_interface(interface_id_t interface)
 		aes132d_select_device = twi_aes132p_select_device;
 		aes132d_resync_physical = twi_aes132p_resync_physical;
 		aes132d_read_memory_physical = twi_aes132p_read_memory_physical;
+		aes132d_read_memory_physical_crc = twi_aes132p_read_memory_physical_crc;
 		aes132d_write_memory_physical = twi_aes132p_write_memory_physical;
 	}
 	else if (interface == DEVKIT_IF_SPI) {
@@ -122,6 +124,7 @@ uint8_t aes132p_set_interface(interface_id_t interface)
 		aes132d_select_device = spi_aes132p_select_device;
 		aes132d_resync_physical = spi_aes132p_resync_physical;
 		aes132d_read_memory_physical = spi_aes132p_read_memory_physical;
+		aes132d_read_memory_physical_crc = spi_aes132p_read_memory_physical_crc;
 		aes132d_write_memory_physical = spi_aes132p_write_memory_physical;
 	}
 	else
@@ -228,6 +231,19 @@ uint8_t aes132p_read_memory_physical(uint8_t count, uint16_t word_address, uint8
 }
 
 
+/** \brief This function reads bytes from the device and calculates their CRC.
+ * \param[in] count number of bytes to read
+ * \param[in] word_address word address to read from
+ * \param[out] data pointer to rx buffer
+ * \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t aes132p_read_memory_physical_crc(uint8_t count, uint16_t word_address, uint8_t *data, struct cryptoauth_crc_rx *crc)
+{
+	return aes132d_read_memory_physical_crc ? aes132d_read_memory_physical_crc(count, word_address, data, crc) : KIT_STATUS_INVALID_IF_FUNCTION;
+}
+
+
 /** \brief This function writes bytes to the device.
  * \param[in] count number of bytes to write
  * \param[in] word_address word address to write to
@@ -19,6 +19,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include <avr/io.h>
 #include <avr/interrupt.h>
 
@@ -228,6 +229,20 @@ uint8_t swi_send_byte(uint8_t value)
  * \return status of the operation
  */
 uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
+	return swi_receive_bytes_crc(count, buffer, NULL);
+}
+
+
+/** \brief This function receives bytes from device and calculates their CRC.
+ *
+ * Every byte is folded into the CRC after its last bit has been sampled,
+ * in the idle time before the start pulse of the next bit.
+ *  \param[in] count number of bytes to receive
+ *  \param[in] buffer pointer to rx buffer
+ *  \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t swi_receive_bytes_crc(uint8_t count, uint8_t *buffer, struct cryptoauth_crc_rx *crc) {
 	uint8_t status = SHA204_SUCCESS;
 	uint8_t i;
 	uint8_t bitMask;
@@ -307,6 +322,9 @@ uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
 		}
 		if (status != SHA204_SUCCESS)
 			break;
+
+		if (crc)
+			cryptoauth_crc_rx_byte(crc, buffer[i]);
 	}
 
 	if (status == SHA204_TIMEOUT) {
@@ -400,6 +418,9 @@ uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
 		}
 		if (status != SHA204_SUCCESS)
 			break;
+
+		if (crc)
+			cryptoauth_crc_rx_byte(crc, buffer[i]);
 	}
 
 	if (status == SHA204_TIMEOUT) {
@@ -197,6 +197,10 @@ uint8_t ParseEccCommands(uint16_t commandLength, uint8_t *command, uint16_t *res
 		// Reset count byte.
 		response[ECC108_BUFFER_POS_COUNT] = 0;
 		status = ecc108p_receive_response(*data[0], response);
+		// The Physical layer checks the CRC while receiving. This raw command
+		// passes the received bytes on unchanged and leaves the CRC check to the host.
+		if (status == ECC108_BAD_CRC)
+			status = ECC108_SUCCESS;
 		*responseLength = response[ECC108_BUFFER_POS_COUNT];
 		break;
 
@@ -241,6 +245,10 @@ uint8_t ParseEccCommands(uint16_t commandLength, uint8_t *command, uint16_t *res
 			// Reset count byte.
 			response[ECC108_BUFFER_POS_COUNT] = 0;
 			status = ecc108p_receive_response(*data[0], response);
+			// The Physical layer checks the CRC while receiving. This raw command
+			// passes the received bytes on unchanged and leaves the CRC check to the host.
+			if (status == ECC108_BAD_CRC)
+				status = ECC108_SUCCESS;
 			*responseLength = response[ECC108_BUFFER_POS_COUNT];
 			break;
 
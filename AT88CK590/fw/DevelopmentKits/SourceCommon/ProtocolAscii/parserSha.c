@@ -263,6 +263,10 @@ uint8_t ParseShaCommands(uint16_t commandLength, uint8_t *command, uint16_t *res
 		// Reset count byte.
 		response[SHA204_BUFFER_POS_COUNT] = 0;
 		status = sha204p_receive_response(*data_load[0], response);
+		// The Physical layer checks the CRC while receiving. This raw command
+		// passes the received bytes on unchanged and leaves the CRC check to the host.
+		if (status == SHA204_BAD_CRC)
+			status = SHA204_SUCCESS;
 		*responseLength = response[SHA204_BUFFER_POS_COUNT];
 		break;
 
@@ -325,6 +329,10 @@ uint8_t ParseShaCommands(uint16_t commandLength, uint8_t *command, uint16_t *res
 			// Reset count byte.
 			response[SHA204_BUFFER_POS_COUNT] = 0;
 			status = sha204p_receive_response(*data_load[0], response);
+			// The Physical layer checks the CRC while receiving. This raw command
+			// passes the received bytes on unchanged and leaves the CRC check to the host.
+			if (status == SHA204_BAD_CRC)
+				status = SHA204_SUCCESS;
 			*responseLength = response[SHA204_BUFFER_POS_COUNT];
 			break;
 
@@ -27,6 +27,7 @@
 #include "aes132_lib_return_codes.h"
 #include "aes132_physical.h"
 #include "timer_utilities.h"
+#include "cryptoauth_crc.h"
 
 
 /** \brief These enumerations are used as arguments
@@ -115,31 +116,8 @@ uint8_t aes132m_execute(uint8_t op_code, uint8_t mode, uint16_t param1, uint16_t
  */
 void aes132c_calculate_crc(uint8_t length, uint8_t *data, uint8_t *crc)
 {
-	uint8_t counter;
-	uint8_t crc_low = 0, crc_high = 0, crc_carry;
-	uint8_t poly_low = 0x05, poly_high = 0x80;
-	uint8_t shift_register;
-	uint8_t data_bit, crc_bit;
-
-	for (counter = 0; counter < length; counter++) {
-		for (shift_register = 0x80; shift_register > 0x00; shift_register >>= 1) {
-			data_bit = (data[counter] & shift_register) ? 1 : 0;
-			crc_bit = crc_high >> 7;
-
-			// Shift CRC to the left by 1.
-			crc_carry = crc_low >> 7;
-			crc_low <<= 1;
-			crc_high <<= 1;
-			crc_high |= crc_carry;
-
-			if ((data_bit ^ crc_bit) != 0) {
-				crc_low ^= poly_low;
-				crc_high ^= poly_high;
-			}
-		}
-	}
-	crc[0] = crc_high;
-	crc[1] = crc_low;
+	crc[0] = crc[1] = 0;
+	cryptoauth_calculate_crc_msb_first(length, data, crc);
 }
 
 
@@ -488,6 +466,7 @@ uint8_t aes132c_receive_response(uint8_t size, uint8_t *response)
 	uint8_t crc[AES132_CRC_SIZE];
 	uint8_t crc_index;
 	uint8_t count_byte;
+	struct cryptoauth_crc_rx crc_rx;
 
 	do {
 		aes132_lib_return = aes132c_wait_for_response_ready();
@@ -529,8 +508,11 @@ uint8_t aes132c_receive_response(uint8_t size, uint8_t *response)
 			continue;
 		}
 
-		// Read remainder of response.
-		aes132_lib_return = aes132p_read_memory_physical(count_byte - 1, AES132_IO_ADDR, &response[AES132_RESPONSE_INDEX_RETURN_CODE]);
+		// Read remainder of response and calculate its CRC while it arrives.
+		cryptoauth_crc_rx_init(&crc_rx, 1);
+		cryptoauth_crc_rx_byte(&crc_rx, count_byte);
+		aes132_lib_return = aes132p_read_memory_physical_crc(count_byte - 1, AES132_IO_ADDR,
+					&response[AES132_RESPONSE_INDEX_RETURN_CODE], &crc_rx);
 		if (aes132_lib_return != AES132_FUNCTION_RETCODE_SUCCESS) {
 			// Reading the remainder of the response failed. We might have lost communication.
 			// Re-synchronize and retry.
@@ -541,7 +523,7 @@ uint8_t aes132c_receive_response(uint8_t size, uint8_t *response)
 
 		// Check CRC.
 		crc_index = count_byte - AES132_CRC_SIZE;
-		aes132c_calculate_crc(crc_index, response, crc);
+		cryptoauth_crc_rx_final(&crc_rx, crc);
 		if ((crc[0] == response[crc_index]) && (crc[1] == response[crc_index + 1]))
 			// We received a consistent response packet. Return the response return code.
 			return response[AES132_RESPONSE_INDEX_RETURN_CODE];
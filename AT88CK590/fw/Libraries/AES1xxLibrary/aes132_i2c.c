@@ -20,6 +20,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include "aes132_lib_return_codes.h"
 #include "i2c_phys.h"
 #include "aes132_physical.h"
@@ -138,6 +139,20 @@ uint8_t aes132p_write_memory_physical(uint8_t count, uint16_t word_address, uint
  * \return status of the operation
  */
 uint8_t aes132p_read_memory_physical(uint8_t size, uint16_t word_address, uint8_t *data)
+{
+	return aes132p_read_memory_physical_crc(size, word_address, data, NULL);
+}
+
+
+/** \brief This function reads bytes from the device and calculates their CRC
+ *         while they arrive.
+ * \param[in] size number of bytes to read
+ * \param[in] word_address word address to read from
+ * \param[out] data pointer to rx buffer
+ * \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t aes132p_read_memory_physical_crc(uint8_t size, uint16_t word_address, uint8_t *data, struct cryptoauth_crc_rx *crc)
 {
 	// Random read:
 	// Start, I2C address with write bit, word address,
@@ -163,7 +178,7 @@ uint8_t aes132p_read_memory_physical(uint8_t size, uint16_t word_address, uint8_
 	if (aes132_lib_return != AES132_FUNCTION_RETCODE_SUCCESS)
 		return aes132_lib_return;
 
-	return i2c_receive_bytes(size, data);
+	return i2c_receive_bytes_crc(size, data, crc);
 }
 
 
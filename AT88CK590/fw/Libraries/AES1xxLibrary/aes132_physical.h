@@ -24,12 +24,14 @@
 #   define AES132_PHYSICAL_H
 
 #include <stdint.h>
+#include "cryptoauth_crc.h"
 
 
 void    aes132p_enable_interface(void);
 void    aes132p_disable_interface(void);
 uint8_t aes132p_select_device(uint8_t device_id);
 uint8_t aes132p_read_memory_physical(uint8_t size, uint16_t word_address, uint8_t *data);
+uint8_t aes132p_read_memory_physical_crc(uint8_t size, uint16_t word_address, uint8_t *data, struct cryptoauth_crc_rx *crc);
 uint8_t aes132p_write_memory_physical(uint8_t count, uint16_t word_address, uint8_t *data);
 uint8_t aes132p_resync_physical(void);
 
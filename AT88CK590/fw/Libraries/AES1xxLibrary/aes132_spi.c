@@ -21,6 +21,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 #include "aes132_lib_return_codes.h"
 #include "spi_phys.h"
 #include "aes132_physical.h"
@@ -109,6 +110,20 @@ uint8_t aes132p_write_memory_physical(uint8_t count, uint16_t word_address, uint
  * \return status of the operation
  */
 uint8_t aes132p_read_memory_physical(uint8_t size, uint16_t word_address, uint8_t *data)
+{
+	return aes132p_read_memory_physical_crc(size, word_address, data, NULL);
+}
+
+
+/** \brief This function reads bytes from the device and calculates their CRC
+ *         while they arrive.
+ * \param[in] size number of bytes to read
+ * \param[in] word_address word address to read from
+ * \param[out] data pointer to rx buffer
+ * \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t aes132p_read_memory_physical_crc(uint8_t size, uint16_t word_address, uint8_t *data, struct cryptoauth_crc_rx *crc)
 {
 	uint8_t aes132_lib_return;
 	uint8_t preface[] =
@@ -117,7 +132,7 @@ uint8_t aes132p_read_memory_physical(uint8_t size, uint16_t word_address, uint8_
 	spi_select_slave();
 	aes132_lib_return = spi_send_bytes(AES132_SPI_PREFACE_SIZE, preface);
 	if (aes132_lib_return == AES132_FUNCTION_RETCODE_SUCCESS)
-		aes132_lib_return = spi_receive_bytes(size, data);
+		aes132_lib_return = spi_receive_bytes_crc(size, data, crc);
 
 	spi_deselect_slave();
 
@@ -41,6 +41,7 @@
 #include "sha204_comm.h"                // definitions and declarations for the Communication module
 #include "timer_utilities.h"            // definitions for delay functions
 #include "sha204_lib_return_codes.h"    // declarations of function return codes
+#include "cryptoauth_crc.h"             // definitions and declarations for the shared CRC calculation
 
 
 /** \brief This function calculates CRC.
@@ -50,23 +51,8 @@
  * \param[out] crc pointer to 16-bit CRC
  */
 void sha204c_calculate_crc(uint8_t length, uint8_t *data, uint8_t *crc) {
-	uint8_t counter;
-	uint16_t crc_register = 0;
-	uint16_t polynom = 0x8005;
-	uint8_t shift_register;
-	uint8_t data_bit, crc_bit;
-
-	for (counter = 0; counter < length; counter++) {
-	  for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1) {
-		 data_bit = (data[counter] & shift_register) ? 1 : 0;
-		 crc_bit = crc_register >> 15;
-		 crc_register <<= 1;
-		 if (data_bit != crc_bit)
-			crc_register ^= polynom;
-	  }
-	}
-	crc[0] = (uint8_t) (crc_register & 0x00FF);
-	crc[1] = (uint8_t) (crc_register >> 8);
+	crc[0] = crc[1] = 0;
+	cryptoauth_calculate_crc(length, data, crc);
 }
 
 
@@ -101,7 +87,7 @@ uint8_t sha204c_wakeup(uint8_t *response)
 		return ret_code;
 
 	ret_code = sha204p_receive_response(SHA204_RSP_SIZE_MIN, response);
-	if (ret_code != SHA204_SUCCESS)
+	if ((ret_code != SHA204_SUCCESS) && (ret_code != SHA204_BAD_CRC))
 		return ret_code;
 
 	// Verify status response.
@@ -264,9 +250,8 @@ uint8_t sha204c_send_and_receive(uint8_t *tx_buffer, uint8_t rx_size, uint8_t *r
 					return ret_code;
 			}
 
-			// We received a response of valid size.
-			// Check the consistency of the response.
-			ret_code = sha204c_check_crc(rx_buffer);
+			// We received a response of valid size. The Physical layer
+			// has checked its CRC while receiving it.
 			if (ret_code == SHA204_SUCCESS) {
 				// Received valid response.
 				if (rx_buffer[SHA204_BUFFER_POS_COUNT] > SHA204_RSP_SIZE_MIN)
@@ -91,6 +91,7 @@
  * - SHA204_SWI_BITBANG (SWI using GPIO peripheral)
  * - SHA204_SWI_UART (SWI using UART peripheral)
  * - SHA204_I2C (I<SUP>2</SUP>C using I<SUP>2</SUP>C peripheral)
+ * - SHA204_VIRTUAL (virtual device on a host, \ref atsha204_virtual_device)
  *
 @{ */
 //! Dummy macro that allow Doxygen to parse this group.
@@ -98,6 +99,7 @@
 // #define SHA204_SWI_BITBANG
 // #define SHA204_SWI_UART
 // #define SHA204_I2C
+// #define SHA204_VIRTUAL
 
 /** @} */
 
@@ -176,6 +178,24 @@
 #endif
 
 
+
+#ifdef SHA204_VIRTUAL
+/** \name Configuration Definitions for the Virtual Device
+@{ */
+
+/** \brief The virtual device is polled like an I<SUP>2</SUP>C device.
+ *
+ *         This value is used to timeout when waiting for a response.
+ */
+#   ifndef SHA204_RESPONSE_TIMEOUT
+#      define SHA204_RESPONSE_TIMEOUT     ((uint16_t) 37)
+#   endif
+
+/** @} */
+
+#endif
+
+
 /** @} */
 
 #endif
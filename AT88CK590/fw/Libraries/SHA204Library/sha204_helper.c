@@ -44,6 +44,10 @@
 #include "sha204_helper.h"             // header module for this C module
 #include "sha204_lib_return_codes.h"   // declarations of function return codes
 #include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+#include "sha256_batch.h"              // definitions and declarations for the SHA-256 batch module
+#include "cryptoauth_core.h"           // definitions and declarations for the shared digest calculations
+#include "cryptoauth_crc.h"            // definitions and declarations for the shared CRC calculation
 
 
 /** \brief This function returns the library version.
@@ -65,42 +69,7 @@ char *sha204h_get_library_version(void)
  */
 uint8_t *sha204h_include_data(struct sha204h_include_data_in_out *param)
 {
-	if (param->mode & MAC_MODE_INCLUDE_OTP_88) {
-		memcpy(param->p_temp, param->otp, SHA204_OTP_SIZE_8 + SHA204_OTP_SIZE_3);            // use OTP[0:10], Mode:5 is overridden
-		param->p_temp += SHA204_OTP_SIZE_8 + SHA204_OTP_SIZE_3;
-	}
-	else {
-		if (param->mode & MAC_MODE_INCLUDE_OTP_64)
-			memcpy(param->p_temp, param->otp, SHA204_OTP_SIZE_8);        // use 8 bytes OTP[0:7] for (6)
-		else
-			memset(param->p_temp, 0, SHA204_OTP_SIZE_8);                 // use 8 zeros for (6)
-		param->p_temp += SHA204_OTP_SIZE_8;
-
-		memset(param->p_temp, 0, SHA204_OTP_SIZE_3);                     // use 3 zeros for (7)
-		param->p_temp += SHA204_OTP_SIZE_3;
-	}
-
-	// (8) 1 byte SN[8] = 0xEE
-	*param->p_temp++ = SHA204_SN_8;
-
-	// (9) 4 bytes SN[4:7] or zeros
-	if (param->mode & MAC_MODE_INCLUDE_SN)
-		memcpy(param->p_temp, &param->sn[4], SHA204_SN_SIZE_4);          //use SN[4:7] for (9)
-	else
-		memset(param->p_temp, 0, SHA204_SN_SIZE_4);                      //use zeros for (9)
-	param->p_temp += SHA204_SN_SIZE_4;
-
-	// (10) 2 bytes SN[0:1] = 0x0123
-	*param->p_temp++ = SHA204_SN_0;
-	*param->p_temp++ = SHA204_SN_1;
-
-	// (11) 2 bytes SN[2:3] or zeros
-	if (param->mode & MAC_MODE_INCLUDE_SN)
-		memcpy(param->p_temp, &param->sn[2], SHA204_SN_SIZE_2);          //use SN[2:3] for (11)
-	else
-		memset(param->p_temp, 0, SHA204_SN_SIZE_2);                      //use zeros for (9)
-	param->p_temp += SHA204_SN_SIZE_2;
-	
+	param->p_temp = cryptoauth_include_data(param->mode, param->otp, param->sn, param->p_temp);
 	return param->p_temp;
 }
 
@@ -118,9 +87,6 @@ This function can also be used to fill in the nonce directly to TempKey (pass-th
  */
 uint8_t sha204h_nonce(struct sha204h_nonce_in_out *param)
 {
-	uint8_t temporary[SHA204_MSG_SIZE_NONCE];
-	uint8_t *p_temp;
-
 	// Check parameters
 	if (!param->temp_key || !param->num_in || (param->mode > NONCE_MODE_PASSTHROUGH) || (param->mode == NONCE_MODE_INVALID)
 			|| (((param->mode == NONCE_MODE_SEED_UPDATE || (param->mode == NONCE_MODE_NO_SEED_UPDATE)) && !param->rand_out)))
@@ -129,20 +95,7 @@ uint8_t sha204h_nonce(struct sha204h_nonce_in_out *param)
 	// Calculate or pass-through the nonce to TempKey->Value
 	if ((param->mode == NONCE_MODE_SEED_UPDATE) || (param->mode == NONCE_MODE_NO_SEED_UPDATE)) {
 		// Calculate nonce using SHA-256 (refer to data sheet)
-		p_temp = temporary;
-
-		memcpy(p_temp, param->rand_out, NONCE_RSP_SIZE_LONG - SHA204_PACKET_OVERHEAD);
-		p_temp += NONCE_RSP_SIZE_LONG - SHA204_PACKET_OVERHEAD;
-
-		memcpy(p_temp, param->num_in, NONCE_NUMIN_SIZE);
-		p_temp += NONCE_NUMIN_SIZE;
-
-		*p_temp++ = SHA204_NONCE;
-		*p_temp++ = param->mode;
-		*p_temp++ = 0x00;
-
-		// Calculate SHA256 to get the nonce
-		sha204h_calculate_sha256(SHA204_MSG_SIZE_NONCE, temporary, param->temp_key->value);
+		cryptoauth_nonce(SHA204_NONCE, param->mode, param->rand_out, param->num_in, param->temp_key->value);
 
 		// Update TempKey->SourceFlag to 0 (random)
 		param->temp_key->source_flag = 0;
@@ -175,12 +128,6 @@ The TempKey (if used) should be valid (temp_key.valid = 1) before executing this
  */
 uint8_t sha204h_mac(struct sha204h_mac_in_out *param)
 {
-	uint8_t temporary[SHA204_MSG_SIZE_MAC];
-	uint8_t *p_temp;
-	struct sha204h_include_data_in_out include_data = {
-		.otp = param->otp, .sn = param->sn, .mode = param->mode
-	};
-	
 	// Check parameters
 	if (!param->response
 		|| (param->mode & ~MAC_MODE_MASK)
@@ -206,36 +153,66 @@ uint8_t sha204h_mac(struct sha204h_mac_in_out *param)
 		return SHA204_CMD_FAIL;
 	}
 
-	// Start calculation
-	p_temp = temporary;
+	// Calculate SHA256 to get the MAC digest
+	cryptoauth_mac(SHA204_MAC, param->mode, param->key_id,
+			param->mode & MAC_MODE_BLOCK1_TEMPKEY ? param->temp_key->value : param->key,
+			param->mode & MAC_MODE_BLOCK2_TEMPKEY ? param->temp_key->value : param->challenge,
+			param->otp, param->sn, param->response);
+
+	// Update TempKey fields
+	if (param->temp_key)
+		param->temp_key->valid = 0;
 
-	// (1) first 32 bytes
-	memcpy(p_temp, param->mode & MAC_MODE_BLOCK1_TEMPKEY ? param->temp_key->value : param->key, SHA204_KEY_SIZE);                // use Key[KeyID]
-	p_temp += SHA204_KEY_SIZE;
+	return SHA204_SUCCESS;
+}
 
-	// (2) second 32 bytes
-	memcpy(p_temp, param->mode & MAC_MODE_BLOCK2_TEMPKEY ? param->temp_key->value : param->challenge, SHA204_KEY_SIZE);          // use Key[KeyID]
-	p_temp += SHA204_KEY_SIZE;
+/** \brief This function generates the SHA-256 digests (MACs) of many key / challenge pairs in one call.
+ 
+The digests are the same as the ones sha204h_mac() calculates for each record, but several
+of them are hashed in parallel by the multi-buffer kernels of the SHA-256 batch module.
+This is meant for hosts that verify the responses of many devices, e.g. on a production line.
+Since every record uses its own key and challenge, modes that use TempKey are not supported.
+ 
+ * \param[in, out] param pointer to parameter structure
+ * \return status of the operation
+ */
+uint8_t sha204h_mac_batch(struct sha204h_mac_batch_in_out *param)
+{
+	uint8_t messages[SHA256_BATCH_LANES_MAX][SHA204_MSG_SIZE_MAC];
+	const uint8_t *p_messages[SHA256_BATCH_LANES_MAX];
+	struct cryptoauth_message_fields fields = {CRYPTOAUTH_LAYOUT_MAC, SHA204_MAC, param->mode, param->key_id,
+			NULL, NULL, NULL, NULL, NULL};
+	uint16_t record;
+	uint16_t group;
+	uint16_t i;
 
-	// (3) 1 byte opcode
-	*p_temp++ = SHA204_MAC;
+	// Check parameters
+	if (!param->key || !param->challenge || !param->response
+		|| (param->mode & ~MAC_MODE_MASK)
+		|| (param->mode & MAC_MODE_USE_TEMPKEY_MASK)
+		|| (((param->mode & MAC_MODE_INCLUDE_OTP_64) || (param->mode & MAC_MODE_INCLUDE_OTP_88)) && !param->otp)
+		|| ((param->mode & MAC_MODE_INCLUDE_SN) && !param->sn)
+		)
+		return SHA204_BAD_PARAM;
 
-	// (4) 1 byte mode parameter
-	*p_temp++ = param->mode;
+	for (record = 0; record < param->count; record += group) {
+		group = param->count - record;
+		if (group > SHA256_BATCH_LANES_MAX)
+			group = SHA256_BATCH_LANES_MAX;
 
-	// (5) 2 bytes keyID
-	*p_temp++ = param->key_id & 0xFF;
-	*p_temp++ = (param->key_id >> 8) & 0xFF;
-	
-	include_data.p_temp = p_temp;
-	sha204h_include_data(&include_data);
+		// Assemble the same message sha204h_mac() hashes for every record of this group.
+		for (i = 0; i < group; i++) {
+			fields.block1 = param->key[record + i];
+			fields.block2 = param->challenge[record + i];
+			fields.otp = param->otp ? param->otp[record + i] : NULL;
+			fields.sn = param->sn ? param->sn[record + i] : NULL;
+			cryptoauth_message(&fields, messages[i]);
 
-	// Calculate SHA256 to get the MAC digest
-	sha204h_calculate_sha256(SHA204_MSG_SIZE_MAC, temporary, param->response);
+			p_messages[i] = messages[i];
+		}
 
-	// Update TempKey fields
-	if (param->temp_key)
-		param->temp_key->valid = 0;
+		sha256_batch(group, SHA204_MSG_SIZE_MAC, p_messages, &param->response[record]);
+	}
 
 	return SHA204_SUCCESS;
 }
@@ -264,9 +241,6 @@ Therefore the application has to make sure that password checking operation succ
  */
 uint8_t sha204h_check_mac(struct sha204h_check_mac_in_out *param)
 {
-	uint8_t temporary[SHA204_MSG_SIZE_MAC];
-	uint8_t *p_temp;
-
 	// Check parameters
 	if (((param->mode & MAC_MODE_USE_TEMPKEY_MASK) != MAC_MODE_BLOCK2_TEMPKEY)
 			|| !param->password || !param->other_data
@@ -284,50 +258,9 @@ uint8_t sha204h_check_mac(struct sha204h_check_mac_in_out *param)
 		return SHA204_CMD_FAIL;
 	}
 
-	// Start calculation
-	p_temp = temporary;
-
-	// (1) first 32 bytes
-	memcpy(p_temp, param->password, SHA204_KEY_SIZE);           // password to be checked
-	p_temp += SHA204_KEY_SIZE;
-
-	// (2) second 32 bytes
-	memcpy(p_temp, param->temp_key->value, SHA204_KEY_SIZE);    // use TempKey.Value
-	p_temp += SHA204_KEY_SIZE;
-
-	// (3, 4, 5) 4 byte OtherData[0:3]
-	memcpy(p_temp, &param->other_data[0], SHA204_OTHER_DATA_SIZE_4);
-	p_temp += SHA204_OTHER_DATA_SIZE_4;
-
-	// (6) 8 bytes OTP[0:7] or 0x00's
-	if (param->mode & MAC_MODE_INCLUDE_OTP_64)
-		memcpy(p_temp, param->otp, SHA204_OTP_SIZE_8);         // use 8 bytes OTP[0:7] for (6)
-	else
-		memset(p_temp, 0, SHA204_OTP_SIZE_8);         // use 8 zeros for (6)
-	p_temp += SHA204_OTP_SIZE_8;
-
-	// (7) 3 byte OtherData[4:6]
-	memcpy(p_temp, &param->other_data[SHA204_OTHER_DATA_SIZE_4], SHA204_OTHER_DATA_SIZE_3);  // use OtherData[4:6] for (7)
-	p_temp += SHA204_OTHER_DATA_SIZE_3;
-
-	// (8) 1 byte SN[8] = 0xEE
-	*p_temp++ = SHA204_SN_8;
-
-	// (9) 4 byte OtherData[7:10]
-	memcpy(p_temp, &param->other_data[SHA204_OTHER_DATA_SIZE_4 + SHA204_OTHER_DATA_SIZE_3], SHA204_OTHER_DATA_SIZE_4);  // use OtherData[7:10] for (9)
-	p_temp += SHA204_OTHER_DATA_SIZE_4;
-
-	// (10) 2 bytes SN[0:1] = 0x0123
-	*p_temp++ = SHA204_SN_0;
-	*p_temp++ = SHA204_SN_1;
-
-	// (11) 2 byte OtherData[11:12]
-	memcpy(p_temp, &param->other_data[SHA204_OTHER_DATA_SIZE_4 + SHA204_OTHER_DATA_SIZE_3 + SHA204_OTHER_DATA_SIZE_2], 
-			SHA204_OTHER_DATA_SIZE_2); // use OtherData[11:12] for (11)
-	p_temp += SHA204_OTHER_DATA_SIZE_2;
-
 	// Calculate SHA256 to get the MAC digest
-	sha204h_calculate_sha256(SHA204_MSG_SIZE_MAC, temporary, param->client_resp);
+	cryptoauth_check_mac(param->password, param->temp_key->value, param->other_data,
+			param->mode & MAC_MODE_INCLUDE_OTP_64 ? param->otp : NULL, param->client_resp);
 
 	// Update TempKey fields
 	memcpy(param->temp_key->value, param->target_key, SHA204_KEY_SIZE);
@@ -339,6 +272,26 @@ uint8_t sha204h_check_mac(struct sha204h_check_mac_in_out *param)
 }
 
 
+/** \brief This function precomputes an HMAC key for sha204h_hmac_precomputed().
+ 
+It hashes the (K0 ^ ipad) and (K0 ^ opad) blocks of a 32-byte key once, so that
+sha204h_hmac_precomputed() can start both of its hash calculations from these midstates.
+ 
+ * \param[out] hmac_key pointer to precomputed key
+ * \param[in] key pointer to 32-byte key
+ * \return status of the operation
+ */
+uint8_t sha204h_hmac_key_init(struct sha204h_hmac_key *hmac_key, const uint8_t *key)
+{
+	if (!hmac_key || !key)
+		return SHA204_BAD_PARAM;
+
+	cryptoauth_hmac_key_init(key, hmac_key->inner, hmac_key->outer);
+
+	return SHA204_SUCCESS;
+}
+
+
 /** \brief This function generates an HMAC / SHA-256 hash of a key and other information.
  
 The resulting hash will match with the one generated in the device by an HMAC command.
@@ -348,17 +301,28 @@ The TempKey has to be valid (temp_key.valid = 1) before executing this function.
  * \return status of the operation
  */
 uint8_t sha204h_hmac(struct sha204h_hmac_in_out *param)
+{
+	return sha204h_hmac_precomputed(param, NULL);
+}
+
+
+/** \brief This function generates an HMAC / SHA-256 hash from a precomputed key.
+ 
+It works like sha204h_hmac(), but calculates the digest from the midstates of a key
+precomputed with sha204h_hmac_key_init(), and param->key is not used.
+If hmac_key is NULL, the key is precomputed from param->key first.
+ 
+ * \param[in, out] param pointer to parameter structure
+ * \param[in] hmac_key pointer to precomputed key, or NULL
+ * \return status of the operation
+ */
+uint8_t sha204h_hmac_precomputed(struct sha204h_hmac_in_out *param, const struct sha204h_hmac_key *hmac_key)
 {
 	// Local Variables
-	struct sha204h_include_data_in_out include_data = {
-		.otp = param->otp, .sn = param->sn, .mode = param->mode
-	};
-	uint8_t temporary[SHA204_MSG_SIZE_HMAC_INNER];
-	uint8_t i;
-	uint8_t *p_temp;
+	struct sha204h_hmac_key local_key;
 
 	// Check parameters
-	if (!param->response || !param->key || !param->temp_key
+	if (!param->response || (!param->key && !hmac_key) || !param->temp_key
 		|| (param->mode & ~HMAC_MODE_MASK)
 		|| (((param->mode & MAC_MODE_INCLUDE_OTP_64) || (param->mode & MAC_MODE_INCLUDE_OTP_88)) && !param->otp)
 		|| ((param->mode & MAC_MODE_INCLUDE_SN) && !param->sn) 
@@ -378,64 +342,15 @@ uint8_t sha204h_hmac(struct sha204h_hmac_in_out *param)
 		return SHA204_CMD_FAIL;
 	}
 
-	// Start first calculation (inner)
-	p_temp = temporary;
-
-	// Refer to fips-198a.pdf, length Key = 32 bytes, Block size = 512 bits = 64 bytes.
-	// So the Key must be padded with zeros.
-	// XOR K0 with ipad, then append
-	for (i = 0; i < SHA204_KEY_SIZE; i++)
-		*p_temp++ = param->key[i] ^ 0x36;
-
-	// XOR the remaining zeros and append
-	for (i = 0; i < HMAC_BLOCK_SIZE - SHA204_KEY_SIZE; i++)
-		*p_temp++ = 0 ^ 0x36;
-
-	// Next append the stream of data 'text'
-	// (1) first 32 bytes: zeros
-	memset(p_temp, 0, HMAC_BLOCK_SIZE - SHA204_KEY_SIZE);
-	p_temp += HMAC_BLOCK_SIZE - SHA204_KEY_SIZE;
-
-	// (2) second 32 bytes: TempKey
-	memcpy(p_temp, param->temp_key->value, SHA204_KEY_SIZE);
-	p_temp += SHA204_KEY_SIZE;
-
-	// (3) 1 byte opcode
-	*p_temp++ = SHA204_HMAC;
-
-	// (4) 1 byte mode parameter
-	*p_temp++ = param->mode;
-
-	// (5) 2 bytes keyID
-	*p_temp++ = param->key_id & 0xFF;
-	*p_temp++ = (param->key_id >> 8) & 0xFF;
-
-	// Calculate SHA256
-	// H((K0^ipad):text), use param.response for temporary storage
-	sha204h_calculate_sha256(SHA204_MSG_SIZE_HMAC_INNER, temporary, param->response);
-
-	// Start second calculation (outer)
-	p_temp = temporary;
-
-	// XOR K0 with opad, then append
-	for (i = 0; i < SHA204_KEY_SIZE; i++) {
-		*p_temp++ = param->key[i] ^ 0x5C;
-	}
-
-	// XOR the remaining zeros and append
-	for (i = 0; i < HMAC_BLOCK_SIZE - SHA204_KEY_SIZE; i++) {
-		*p_temp++ = 0 ^ 0x5C;
+	// Without a precomputed key, hash (K0 ^ ipad) and (K0 ^ opad) now.
+	if (!hmac_key) {
+		sha204h_hmac_key_init(&local_key, param->key);
+		hmac_key = &local_key;
 	}
 
-	// Append result from last calculation H((K0 ^ ipad): text)
-	memcpy(p_temp, param->response, SHA204_KEY_SIZE);
-	p_temp += SHA204_KEY_SIZE;
-	
-	include_data.p_temp = p_temp;
-	sha204h_include_data(&include_data);
-
-	// Calculate SHA256 to get the resulting HMAC
-	sha204h_calculate_sha256(SHA204_MSG_SIZE_HMAC, temporary, param->response);
+	// Calculate H((K0 ^ opad) : H((K0 ^ ipad) : text)) from the key midstates
+	cryptoauth_hmac(SHA204_HMAC, param->mode, param->key_id, hmac_key->inner, hmac_key->outer,
+			param->temp_key->value, param->otp, param->sn, param->response);
 
 	// Update TempKey fields
 	param->temp_key->valid = 0;
@@ -459,9 +374,6 @@ The function calculates a new TempKey and returns it.
  */
 uint8_t sha204h_gen_dig(struct sha204h_gen_dig_in_out *param)
 {
-	uint8_t temporary[SHA204_MSG_SIZE_GEN_DIG];
-	uint8_t *p_temp;
-
 	// Check parameters
 	if (!param->stored_value || !param->temp_key
 			|| ((param->zone != GENDIG_ZONE_OTP) 
@@ -480,40 +392,9 @@ uint8_t sha204h_gen_dig(struct sha204h_gen_dig_in_out *param)
 		return SHA204_CMD_FAIL;
 	}
 
-	// Start calculation
-	p_temp = temporary;
-
-	// (1) 32 bytes inputKey
-	//     (Config[KeyID] or OTP[KeyID] or Data.slot[KeyID] or TransportKey[KeyID])
-	memcpy(p_temp, param->stored_value, SHA204_KEY_SIZE);
-	p_temp += SHA204_KEY_SIZE;
-
-	// (2) 1 byte Opcode
-	*p_temp++ = SHA204_GENDIG;
-
-	// (3) 1 byte Param1 (zone)
-	*p_temp++ = param->zone;
-
-	// (4) 2 bytes Param2 (keyID)
-	*p_temp++ = param->key_id & 0xFF;
-	*p_temp++ = (param->key_id >> 8) & 0xFF;
-
-	// (5) 1 byte SN[8] = 0xEE
-	*p_temp++ = SHA204_SN_8;
-
-	// (6) 2 bytes SN[0:1] = 0x0123
-	*p_temp++ = SHA204_SN_0;
-	*p_temp++ = SHA204_SN_1;
-
-	// (7) 25 zeros
-	memset(p_temp, 0, SHA204_GENDIG_ZEROS_SIZE);
-	p_temp += SHA204_GENDIG_ZEROS_SIZE;
-
-	// (8) 32 bytes TempKey
-	memcpy(p_temp, param->temp_key->value, SHA204_KEY_SIZE);
-
-	// Calculate SHA256 to get the new TempKey
-	sha204h_calculate_sha256(SHA204_MSG_SIZE_GEN_DIG, temporary, param->temp_key->value);
+	// Calculate SHA256 of the stored value, the command parameters and TempKey to get the new TempKey
+	cryptoauth_key_digest(SHA204_GENDIG, param->zone, param->key_id, param->stored_value,
+			param->temp_key->value, param->temp_key->value);
 
 	// Update TempKey fields
 	param->temp_key->valid = 1;
@@ -547,9 +428,6 @@ The TempKey should be valid (temp_key.valid = 1) before executing this function.
  */
 uint8_t sha204h_derive_key(struct sha204h_derive_key_in_out *param)
 {
-	uint8_t temporary[SHA204_MSG_SIZE_DERIVE_KEY];
-	uint8_t *p_temp;
-
 	// Check parameters
 	if (!param->parent_key || !param->target_key || !param->temp_key
 		|| (param->random & ~DERIVE_KEY_RANDOM_FLAG) || (param->target_key_id > SHA204_KEY_ID_MAX))
@@ -568,40 +446,9 @@ uint8_t sha204h_derive_key(struct sha204h_derive_key_in_out *param)
 		return SHA204_CMD_FAIL;
 	}
 
-	// Start calculation
-	p_temp = temporary;
-
-	// (1) 32 bytes parent key
-	memcpy(p_temp, param->parent_key, SHA204_KEY_SIZE);
-	p_temp += SHA204_KEY_SIZE;
-
-	// (2) 1 byte Opcode
-	*p_temp++ = SHA204_DERIVE_KEY;
-
-	// (3) 1 byte Param1 (random)
-	*p_temp++ = param->random;
-
-	// (4) 2 bytes Param2 (keyID)
-	*p_temp++ = param->target_key_id & 0xFF;
-	*p_temp++ = (param->target_key_id >> 8) & 0xFF;
-
-	// (5) 1 byte SN[8] = 0xEE
-	*p_temp++ = SHA204_SN_8;
-
-	// (6) 2 bytes SN[0:1] = 0x0123
-	*p_temp++ = SHA204_SN_0;
-	*p_temp++ = SHA204_SN_1;
-
-	// (7) 25 zeros
-	memset(p_temp, 0, SHA204_DERIVE_KEY_ZEROS_SIZE);
-	p_temp += SHA204_DERIVE_KEY_ZEROS_SIZE;
-	
-	// (8) 32 bytes TempKey
-	memcpy(p_temp, param->temp_key->value, SHA204_KEY_SIZE);
-	p_temp += SHA204_KEY_SIZE;
-
 	// Calculate SHA256 to get the derived key.
-	sha204h_calculate_sha256(SHA204_MSG_SIZE_DERIVE_KEY, temporary, param->target_key);
+	cryptoauth_key_digest(SHA204_DERIVE_KEY, param->random, param->target_key_id, param->parent_key,
+			param->temp_key->value, param->target_key);
 
 	// Update TempKey fields
 	param->temp_key->valid = 0;
@@ -619,40 +466,14 @@ The DeriveKey command will need an input MAC if SlotConfig[TargetKey].Bit15 is s
  */
 uint8_t sha204h_derive_key_mac(struct sha204h_derive_key_mac_in_out *param)
 {
-	uint8_t temporary[SHA204_MSG_SIZE_DERIVE_KEY_MAC];
-	uint8_t *p_temp;
-
 	// Check parameters
 	if (!param->parent_key || !param->mac || (param->random & ~DERIVE_KEY_RANDOM_FLAG)
 									|| (param->target_key_id > SHA204_KEY_ID_MAX))
 		return SHA204_BAD_PARAM;
 
-	// Start calculation
-	p_temp = temporary;
-
-	// (1) 32 bytes parent key
-	memcpy(p_temp, param->parent_key, SHA204_KEY_SIZE);
-	p_temp += SHA204_KEY_SIZE;
-
-	// (2) 1 byte Opcode
-	*p_temp++ = SHA204_DERIVE_KEY;
-
-	// (3) 1 byte Param1 (random)
-	*p_temp++ = param->random;
-
-	// (4) 2 bytes Param2 (keyID)
-	*p_temp++ = param->target_key_id & 0xFF;
-	*p_temp++ = (param->target_key_id >> 8) & 0xFF;
-
-	// (5) 1 byte SN[8] = 0xEE
-	*p_temp++ = SHA204_SN_8;
-
-	// (6) 2 bytes SN[0:1] = 0x0123
-	*p_temp++ = SHA204_SN_0;
-	*p_temp++ = SHA204_SN_1;
-
 	// Calculate SHA256 to get the input MAC for DeriveKey command
-	sha204h_calculate_sha256(SHA204_MSG_SIZE_DERIVE_KEY_MAC, temporary, param->mac);
+	cryptoauth_key_digest(SHA204_DERIVE_KEY, param->random, param->target_key_id, param->parent_key,
+			NULL, param->mac);
 
 	return SHA204_SUCCESS;
 }
@@ -679,9 +500,7 @@ has to make sure that prior GenDig calculation was done using the correct Parent
  */
 uint8_t sha204h_encrypt(struct sha204h_encrypt_in_out *param)
 {
-	uint8_t temporary[SHA204_MSG_SIZE_ENCRYPT_MAC];
 	uint8_t i;
-	uint8_t *p_temp;
 
 	// Check parameters
 	if (!param->crypto_data || !param->temp_key || (param->zone & ~WRITE_ZONE_MASK))
@@ -709,41 +528,9 @@ uint8_t sha204h_encrypt(struct sha204h_encrypt_in_out *param)
 	}
 
 	// If the pointer *mac is provided by the caller then calculate input MAC
-	if (param->mac) {
-		// Start calculation
-		p_temp = temporary;
-
-		// (1) 32 bytes parent key
-		memcpy(p_temp, param->temp_key->value, SHA204_KEY_SIZE);
-		p_temp += SHA204_KEY_SIZE;
-
-		// (2) 1 byte Opcode
-		*p_temp++ = SHA204_WRITE;
-
-		// (3) 1 byte Param1 (zone)
-		*p_temp++ = param->zone;
-
-		// (4) 2 bytes Param2 (address)
-		*p_temp++ = param->address & 0xFF;
-		*p_temp++ = (param->address >> 8) & 0xFF;
-
-		// (5) 1 byte SN[8] = 0xEE
-		*p_temp++ = SHA204_SN_8;
-
-		// (6) 2 bytes SN[0:1] = 0x0123
-		*p_temp++ = SHA204_SN_0;
-		*p_temp++ = SHA204_SN_1;
-
-		// (7) 25 zeros
-		memset(p_temp, 0, SHA204_GENDIG_ZEROS_SIZE);
-		p_temp += SHA204_GENDIG_ZEROS_SIZE;
-
-		// (8) 32 bytes data
-		memcpy(p_temp, param->crypto_data, SHA204_KEY_SIZE);
-
-		// Calculate SHA256 to get the input MAC
-		sha204h_calculate_sha256(SHA204_MSG_SIZE_ENCRYPT_MAC, temporary, param->mac);
-	}
+	if (param->mac)
+		cryptoauth_key_digest(SHA204_WRITE, param->zone, param->address, param->temp_key->value,
+				param->crypto_data, param->mac);
 
 	// Encrypt by XOR-ing Data with the TempKey
 	for (i = 0; i < SHA204_KEY_SIZE; i++)
@@ -823,40 +610,14 @@ to 0 by the caller.
 */
 void sha204h_calculate_crc_chain(uint8_t length, uint8_t *data, uint8_t *crc)
 {
-	uint8_t counter;
-	uint16_t crc_register = 0;
-	uint16_t polynom = 0x8005;
-	uint8_t shift_register;
-	uint8_t data_bit, crc_bit;
-
-	crc_register = (((uint16_t) crc[0]) & 0x00FF) | (((uint16_t) crc[1]) << 8);
-
-	for (counter = 0; counter < length; counter++) {
-	  for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1) {
-		 data_bit = (data[counter] & shift_register) ? 1 : 0;
-		 crc_bit = crc_register >> 15;
-
-		 // Shift CRC to the left by 1.
-		 crc_register <<= 1;
-
-		 if ((data_bit ^ crc_bit) != 0)
-			crc_register ^= polynom;
-	  }
-	}
-
-	crc[0] = (uint8_t) (crc_register & 0x00FF);
-	crc[1] = (uint8_t) (crc_register >> 8);
+	cryptoauth_calculate_crc(length, data, crc);
 }
 
 
-#define rotate_right(value, places) ((value >> places) | (value << (32 - places)))
-#define SHA256_BLOCK_SIZE   (64)   // bytes
-
-
-/** \brief This function creates a SHA256 digest on a little-endian system.
+/** \brief This function creates a SHA256 digest.
  *
- * Limitations: This function was implemented with the ATSHA204 CryptoAuth device
- * in mind. It will therefore only work for length values of len % 64 < 62.
+ * The calculation is done by the SHA-256 module, so messages of any length can be hashed.
+ * Use the functions of that module directly to hash a message that is not held in one buffer.
  *
  * \param[in] len byte length of message
  * \param[in] message pointer to message
@@ -864,135 +625,5 @@ void sha204h_calculate_crc_chain(uint8_t length, uint8_t *data, uint8_t *crc)
  */
 void sha204h_calculate_sha256(int32_t len, uint8_t *message, uint8_t *digest)
 {
-	int32_t j, swap_counter, len_mod = len % sizeof(int32_t);
-	uint32_t i, w_index;
-	int32_t message_index = 0;
-	uint32_t padded_len = len + 8; // 8 bytes for bit length
-	uint32_t bit_len = len * 8;
-	uint32_t s0, s1;
-	uint32_t t1, t2;
-	uint32_t maj, ch;
-	uint32_t word_value;
-	uint32_t rotate_register[8];
-
-	union {
-		uint32_t w_word[SHA256_BLOCK_SIZE];
-		uint8_t w_byte[SHA256_BLOCK_SIZE * sizeof(int32_t)];
-	} w_union;
-
-	uint32_t hash[] = {
-		0x6a09e667, 0xbb67ae85, 0x3c6ef372,	0xa54ff53a,
-		0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-	};
-
-	const uint32_t k[] = {
-		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-	};
-
-	// Process message.
-	while (message_index <= padded_len) {
-
-		// Break message into 64-byte blocks.
-		w_index = 0;
-		do {
-			// Copy message chunk of four bytes (size of integer) into compression array.
-			if (message_index < (len - len_mod)) {
-				for (swap_counter = sizeof(int32_t) - 1; swap_counter >= 0; swap_counter--)
-					// No padding needed. Swap four message bytes to chunk array.
-					w_union.w_byte[swap_counter + w_index] = message[message_index++];
-
-				w_index += sizeof(int32_t);
-			}
-			else {
-				// We reached last complete word of message {len - (len mod 4)}.
-				// Swap remaining bytes if any, append '1' bit and pad remaining
-				// bytes of the last word.
-				for (swap_counter = sizeof(int32_t) - 1;
-						swap_counter >= sizeof(int32_t) - len_mod; swap_counter--)
-					w_union.w_byte[swap_counter + w_index] = message[message_index++];
-				w_union.w_byte[swap_counter + w_index] = 0x80;
-				for (swap_counter--; swap_counter >= 0; swap_counter--)
-					w_union.w_byte[swap_counter + w_index] = 0;
-
-				// Switch to word indexing.
-				w_index += sizeof(int32_t);
-				w_index /= sizeof(int32_t);
-
-				// Pad last block with zeros to a block length % 56 = 0
-				// and pad the four high bytes of "len" since we work only
-				// with integers and not with long integers.
-				while (w_index < 15)
-					 w_union.w_word[w_index++] = 0;
-				// Append original message length as 32-bit integer.
-				w_union.w_word[w_index] = bit_len;
-				// Indicate that the last block is being processed.
-				message_index += SHA256_BLOCK_SIZE;
-				// We are done with pre-processing last block.
-				break;
-			}
-		} while (message_index % SHA256_BLOCK_SIZE);
-		// Created one block.
-
-		w_index = 16;
-		while (w_index < SHA256_BLOCK_SIZE) {
-			// right rotate for 32-bit variable in C: (value >> places) | (value << 32 - places)
-			word_value = w_union.w_word[w_index - 15];
-			s0 = rotate_right(word_value, 7) ^ rotate_right(word_value, 18) ^ (word_value >> 3);
-
-			word_value = w_union.w_word[w_index - 2];
-			s1 = rotate_right(word_value, 17) ^ rotate_right(word_value, 19) ^ (word_value >> 10);
-
-			w_union.w_word[w_index] = w_union.w_word[w_index - 16] + s0 + w_union.w_word[w_index - 7] + s1;
-
-			w_index++;
-		}
-
-		// Initialize hash value for this chunk.
-		for (i = 0; i < 8; i++)
-			rotate_register[i] = hash[i];
-
-		// hash calculation loop
-		for (i = 0; i < SHA256_BLOCK_SIZE; i++) {
-			s0 = rotate_right(rotate_register[0], 2)
-				^ rotate_right(rotate_register[0], 13)
-				^ rotate_right(rotate_register[0], 22);
-			maj = (rotate_register[0] & rotate_register[1])
-				^ (rotate_register[0] & rotate_register[2])
-				^ (rotate_register[1] & rotate_register[2]);
-			t2 = s0 + maj;
-			s1 = rotate_right(rotate_register[4], 6)
-				^ rotate_right(rotate_register[4], 11)
-				^ rotate_right(rotate_register[4], 25);
-			ch =  (rotate_register[4] & rotate_register[5])
-				^ (~rotate_register[4] & rotate_register[6]);
-			t1 = rotate_register[7] + s1 + ch + k[i] + w_union.w_word[i];
-
-			rotate_register[7] = rotate_register[6];
-			rotate_register[6] = rotate_register[5];
-			rotate_register[5] = rotate_register[4];
-			rotate_register[4] = rotate_register[3] + t1;
-			rotate_register[3] = rotate_register[2];
-			rotate_register[2] = rotate_register[1];
-			rotate_register[1] = rotate_register[0];
-			rotate_register[0] = t1 + t2;
-		}
-
-	    // Add the hash of this block to current result.
-		for (i = 0; i < 8; i++)
-			hash[i] += rotate_register[i];
-	}
-
-	// All blocks have been processed.
-	// Concatenate the hashes to produce digest, MSB of every hash first.
-	for (i = 0; i < 8; i++) {
-		for (j = sizeof(int32_t) - 1; j >= 0; j--, hash[i] >>= 8)
-			digest[i * sizeof(int32_t) + j] = hash[i] & 0xFF;
-	}
+	cryptoauth_sha256((uint32_t) len, message, digest);
 }
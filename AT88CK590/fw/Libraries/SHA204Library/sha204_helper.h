@@ -42,6 +42,7 @@
 #   define SHA204_HELPER_H
 
 #include "sha204_comm_marshaling.h" // definitions and declarations for the Command Marshaling module
+#include "sha256.h"                 // definitions and declarations for the SHA-256 module
 
 
 /** \defgroup atsha204_helper Module 06: Helper Functions
@@ -242,6 +243,55 @@ struct sha204h_mac_in_out {
 };
 
 
+/** \struct sha204h_mac_batch_in_out
+ *  \brief Input/output parameters for function sha204h_mac_batch().
+ *  \var sha204h_mac_batch_in_out::count
+ *       \brief [in] Number of MAC digests to calculate.
+ *  \var sha204h_mac_batch_in_out::mode
+ *       \brief [in] Mode parameter used in MAC command (Param1). Modes that use TempKey are not supported.
+ *  \var sha204h_mac_batch_in_out::key_id
+ *       \brief [in] KeyID parameter used in MAC command (Param2).
+ *  \var sha204h_mac_batch_in_out::key
+ *       \brief [in] Array of count pointers to 32-byte keys.
+ *  \var sha204h_mac_batch_in_out::challenge
+ *       \brief [in] Array of count pointers to 32-byte challenges.
+ *  \var sha204h_mac_batch_in_out::otp
+ *       \brief [in] Array of count pointers to 11-byte OTP, optionally included in MAC digest, depending on mode.
+ *  \var sha204h_mac_batch_in_out::sn
+ *       \brief [in] Array of count pointers to 9-byte SN, optionally included in MAC digest, depending on mode.
+ *  \var sha204h_mac_batch_in_out::response
+ *       \brief [out] Array of count pointers to 32-byte SHA-256 digests (MAC).
+ */
+struct sha204h_mac_batch_in_out {
+	uint16_t count;
+	uint8_t mode;
+	uint16_t key_id;
+	uint8_t **key;
+	uint8_t **challenge;
+	uint8_t **otp;
+	uint8_t **sn;
+	uint8_t **response;
+};
+
+
+/** \struct sha204h_hmac_key
+ *  \brief Precomputed HMAC key, created by sha204h_hmac_key_init().
+ *
+ *  It holds the SHA-256 midstates of the (K0 ^ ipad) and (K0 ^ opad) blocks of a slot key.
+ *  An application that calculates many HMAC digests with the same key creates it once
+ *  and passes it to sha204h_hmac_precomputed(), which saves two of the five
+ *  SHA-256 block compressions per digest.
+ *  \var sha204h_hmac_key::inner
+ *       \brief Intermediate hash value after hashing (K0 ^ ipad).
+ *  \var sha204h_hmac_key::outer
+ *       \brief Intermediate hash value after hashing (K0 ^ opad).
+ */
+struct sha204h_hmac_key {
+	uint32_t inner[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+	uint32_t outer[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+};
+
+
 /** \struct sha204h_hmac_in_out
  *  \brief Input/output parameters for function sha204h_hmac().
  *  \var sha204h_hmac_in_out::mode
@@ -396,8 +446,11 @@ struct sha204h_check_mac_in_out {
 char   *sha204h_get_library_version(void);
 uint8_t sha204h_nonce(struct sha204h_nonce_in_out *param);
 uint8_t sha204h_mac(struct sha204h_mac_in_out *param);
+uint8_t sha204h_mac_batch(struct sha204h_mac_batch_in_out *param);
 uint8_t sha204h_check_mac(struct sha204h_check_mac_in_out *param);
+uint8_t sha204h_hmac_key_init(struct sha204h_hmac_key *hmac_key, const uint8_t *key);
 uint8_t sha204h_hmac(struct sha204h_hmac_in_out *param);
+uint8_t sha204h_hmac_precomputed(struct sha204h_hmac_in_out *param, const struct sha204h_hmac_key *hmac_key);
 uint8_t sha204h_gen_dig(struct sha204h_gen_dig_in_out *param);
 uint8_t sha204h_derive_key(struct sha204h_derive_key_in_out *param);
 uint8_t sha204h_derive_key_mac(struct sha204h_derive_key_mac_in_out *param);
@@ -247,6 +247,9 @@ uint8_t sha204p_reset_io(void)
 
 
 /** \brief This function receives a response from the device.
+ *
+ * The CRC of the response is calculated while the response is being received.
+ * The function returns #SHA204_BAD_CRC if it does not match the received one.
  *
  * \param[in] size size of rx buffer
  * \param[out] response pointer to rx buffer
@@ -255,6 +258,8 @@ uint8_t sha204p_reset_io(void)
 uint8_t sha204p_receive_response(uint8_t size, uint8_t *response)
 {
 	uint8_t count;
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE];
+	struct cryptoauth_crc_rx crc_rx;
 
 	// Address the device and indicate that bytes are to be read.
 	uint8_t i2c_status = sha204p_send_slave_address(I2C_READ);
@@ -279,12 +284,18 @@ uint8_t sha204p_receive_response(uint8_t size, uint8_t *response)
 		return SHA204_INVALID_SIZE;
 	}		
 
-	i2c_status = i2c_receive_bytes(count - 1, &response[SHA204_BUFFER_POS_DATA]);
-
+	// Calculate the CRC while the remaining bytes arrive.
+	cryptoauth_crc_rx_init(&crc_rx, 0);
+	cryptoauth_crc_rx_byte(&crc_rx, count);
+	i2c_status = i2c_receive_bytes_crc(count - 1, &response[SHA204_BUFFER_POS_DATA], &crc_rx);
 	if (i2c_status != I2C_FUNCTION_RETCODE_SUCCESS)
 		return SHA204_COMM_FAIL;
-	else
-		return SHA204_SUCCESS;
+
+	cryptoauth_crc_rx_final(&crc_rx, crc);
+	if ((crc[0] != response[count - CRYPTOAUTH_CRC_SIZE]) || (crc[1] != response[count - 1]))
+		return SHA204_BAD_CRC;
+
+	return SHA204_SUCCESS;
 }
 
 
@@ -0,0 +1,453 @@
+/** \file
+ *  \brief  Sharded Least-Recently-Used Cache of Diversified Keys
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdlib.h>                    // needed for calloc()
+#include <stdio.h>                     // needed for fopen()
+#include <pthread.h>                   // needed for the shard locks
+
+#include "sha204_key_cache.h"          // definitions and declarations for this module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "cryptoauth_core.h"           // definitions and declarations for the digest calculations
+#include "cryptoauth_wipe.h"           // definitions and declarations for the Wipe module
+
+
+//! index that marks the end of a bucket chain or of the LRU list
+#define SHA204K_NONE                 (0xFFFFFFFFUL)
+
+
+/** \brief A cached child key.
+ *
+ *  Entries are linked into the chain of their hash bucket, and into the
+ *  LRU list of their shard, by array indexes.
+ */
+struct sha204k_entry {
+	uint8_t sn[SHA204K_SN_SIZE];
+	uint8_t child_key[SHA204_KEY_SIZE];
+	uint32_t hash_next;
+	uint32_t lru_prev;
+	uint32_t lru_next;
+};
+
+
+/** \brief One shard of the cache. It is aligned to a cache line, so the locks of neighbor shards do not share one.
+ *
+ *  The LRU list runs from the most recently used entry (lru_head) to the least recently used one (lru_tail).
+ */
+struct sha204k_shard {
+	pthread_mutex_t mutex;
+	struct sha204k_entry *entries;
+	uint32_t *buckets;
+	uint32_t capacity;
+	uint32_t bucket_mask;
+	uint32_t used;
+	uint32_t lru_head;
+	uint32_t lru_tail;
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+} __attribute__((aligned(64)));
+
+
+/** \brief Cache of child keys and the parameters to derive them.
+ */
+struct sha204k_cache {
+	uint8_t parent_key[SHA204_KEY_SIZE];
+	uint16_t target_key_id;
+	uint16_t shard_count;
+	struct sha204k_shard *shards;
+};
+
+
+/** \brief This function hashes a serial number (64-bit FNV-1a).
+ *
+ * \param[in] sn pointer to 9-byte serial number
+ * \return hash value, its low bits select the shard, its high bits the bucket
+ */
+static uint64_t sha204k_hash(const uint8_t *sn)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	uint8_t i;
+
+	for (i = 0; i < SHA204K_SN_SIZE; i++) {
+		hash ^= sn[i];
+		hash *= 0x100000001B3ULL;
+	}
+
+	return hash;
+}
+
+
+/** \brief This function derives the child key of a device.
+ *
+ * The host stores the serial number padded with zeros in TempKey with a pass-through
+ * Nonce command, so the DeriveKey random parameter has to match TempKey.SourceFlag = 1.
+ *
+ * \param[in] cache pointer to cache
+ * \param[in] sn pointer to 9-byte serial number
+ * \param[out] child_key pointer to 32-byte child key
+ */
+static void sha204k_derive(const struct sha204k_cache *cache, const uint8_t *sn, uint8_t *child_key)
+{
+	uint8_t temp_key[NONCE_NUMIN_SIZE_PASSTHROUGH];
+
+	memset(temp_key, 0, sizeof(temp_key));
+	memcpy(temp_key, sn, SHA204K_SN_SIZE);
+
+	cryptoauth_key_digest(SHA204_DERIVE_KEY, DERIVE_KEY_RANDOM_FLAG, cache->target_key_id, cache->parent_key,
+			temp_key, child_key);
+}
+
+
+/** \brief This function finds the entry of a serial number in a shard.
+ *
+ * \param[in] shard pointer to locked shard
+ * \param[in] bucket bucket of the serial number
+ * \param[in] sn pointer to 9-byte serial number
+ * \return index of the entry, SHA204K_NONE if the serial number is not cached
+ */
+static uint32_t sha204k_find(const struct sha204k_shard *shard, uint32_t bucket, const uint8_t *sn)
+{
+	uint32_t index = shard->buckets[bucket];
+
+	while (index != SHA204K_NONE && memcmp(shard->entries[index].sn, sn, SHA204K_SN_SIZE))
+		index = shard->entries[index].hash_next;
+
+	return index;
+}
+
+
+/** \brief This function removes an entry from the LRU list of its shard.
+ *
+ * \param[in, out] shard pointer to locked shard
+ * \param[in] index index of the entry
+ */
+static void sha204k_lru_unlink(struct sha204k_shard *shard, uint32_t index)
+{
+	struct sha204k_entry *entry = &shard->entries[index];
+
+	if (entry->lru_prev != SHA204K_NONE)
+		shard->entries[entry->lru_prev].lru_next = entry->lru_next;
+	else
+		shard->lru_head = entry->lru_next;
+
+	if (entry->lru_next != SHA204K_NONE)
+		shard->entries[entry->lru_next].lru_prev = entry->lru_prev;
+	else
+		shard->lru_tail = entry->lru_prev;
+}
+
+
+/** \brief This function makes an entry the most recently used one of its shard.
+ *
+ * \param[in, out] shard pointer to locked shard
+ * \param[in] index index of an entry that is not in the LRU list
+ */
+static void sha204k_lru_push(struct sha204k_shard *shard, uint32_t index)
+{
+	struct sha204k_entry *entry = &shard->entries[index];
+
+	entry->lru_prev = SHA204K_NONE;
+	entry->lru_next = shard->lru_head;
+	if (shard->lru_head != SHA204K_NONE)
+		shard->entries[shard->lru_head].lru_prev = index;
+	else
+		shard->lru_tail = index;
+	shard->lru_head = index;
+}
+
+
+/** \brief This function stores a child key in a shard, evicting the least recently used one if the shard is full.
+ *
+ * \param[in, out] shard pointer to locked shard
+ * \param[in] hash hash of the serial number
+ * \param[in] sn pointer to 9-byte serial number that is not cached yet
+ * \param[in] child_key pointer to 32-byte child key
+ */
+static void sha204k_insert(struct sha204k_shard *shard, uint64_t hash, const uint8_t *sn, const uint8_t *child_key)
+{
+	uint32_t bucket = (uint32_t) (hash >> 32) & shard->bucket_mask;
+	uint32_t index, *link;
+	struct sha204k_entry *entry;
+
+	if (shard->used < shard->capacity)
+		index = shard->used++;
+	else {
+		// Unlink the least recently used entry from its bucket chain and reuse it.
+		index = shard->lru_tail;
+		sha204k_lru_unlink(shard, index);
+		link = &shard->buckets[(uint32_t) (sha204k_hash(shard->entries[index].sn) >> 32) & shard->bucket_mask];
+		while (*link != index)
+			link = &shard->entries[*link].hash_next;
+		*link = shard->entries[index].hash_next;
+		shard->evictions++;
+	}
+
+	entry = &shard->entries[index];
+	memcpy(entry->sn, sn, SHA204K_SN_SIZE);
+	memcpy(entry->child_key, child_key, SHA204_KEY_SIZE);
+	entry->hash_next = shard->buckets[bucket];
+	shard->buckets[bucket] = index;
+	sha204k_lru_push(shard, index);
+}
+
+
+/** \brief This function creates a cache.
+ *
+ * The capacity is divided among the shards. The first capacity % shards shards
+ * hold one entry more than the others, so the shards together hold exactly
+ * capacity entries. Every child key is derived with the same parent key and
+ * DeriveKey target key id, as programmed into the client devices during
+ * personalization.
+ *
+ * \param[in] capacity maximum number of cached child keys
+ * \param[in] shards number of shards (1 to SHA204K_SHARDS_MAX)
+ * \param[in] parent_key pointer to 32-byte parent key
+ * \param[in] target_key_id key id of the child key in the client devices (TargetKey parameter of DeriveKey)
+ * \param[out] cache pointer to the created cache
+ * \return status of the operation
+ */
+uint8_t sha204k_cache_create(uint32_t capacity, uint16_t shards, const uint8_t *parent_key,
+		uint16_t target_key_id, struct sha204k_cache **cache)
+{
+	struct sha204k_cache *new_cache;
+	struct sha204k_shard *shard;
+	uint32_t shard_capacity, bucket_count;
+	uint16_t i;
+
+	if (!cache || !parent_key || !shards || (shards > SHA204K_SHARDS_MAX)
+			|| (capacity < shards) || (target_key_id > SHA204_KEY_ID_MAX))
+		return SHA204_BAD_PARAM;
+
+	new_cache = (struct sha204k_cache *) calloc(1, sizeof(*new_cache));
+	if (!new_cache)
+		return SHA204_FUNC_FAIL;
+	if (posix_memalign((void **) &new_cache->shards, 64, shards * sizeof(struct sha204k_shard))) {
+		free(new_cache);
+		return SHA204_FUNC_FAIL;
+	}
+	memset(new_cache->shards, 0, shards * sizeof(struct sha204k_shard));
+
+	memcpy(new_cache->parent_key, parent_key, SHA204_KEY_SIZE);
+	new_cache->target_key_id = target_key_id;
+	new_cache->shard_count = shards;
+
+	// All shards share one bucket count, sized for the larger shards.
+	shard_capacity = (capacity + shards - 1) / shards;
+	for (bucket_count = 1; bucket_count < shard_capacity; bucket_count <<= 1)
+		;
+
+	for (i = 0; i < shards; i++) {
+		shard = &new_cache->shards[i];
+		pthread_mutex_init(&shard->mutex, NULL);
+		shard_capacity = capacity / shards + (i < capacity % shards ? 1 : 0);
+		shard->capacity = shard_capacity;
+		shard->bucket_mask = bucket_count - 1;
+		shard->lru_head = shard->lru_tail = SHA204K_NONE;
+		shard->entries = (struct sha204k_entry *) malloc(shard_capacity * sizeof(struct sha204k_entry));
+		shard->buckets = (uint32_t *) malloc(bucket_count * sizeof(uint32_t));
+		new_cache->shard_count = i + 1;
+		if (!shard->entries || !shard->buckets) {
+			sha204k_cache_destroy(new_cache);
+			return SHA204_FUNC_FAIL;
+		}
+		memset(shard->buckets, 0xFF, bucket_count * sizeof(uint32_t));
+	}
+
+	*cache = new_cache;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function wipes the keys of a cache and frees it.
+ *
+ * \param[in] cache pointer to cache, created by sha204k_cache_create()
+ */
+void sha204k_cache_destroy(struct sha204k_cache *cache)
+{
+	struct sha204k_shard *shard;
+	uint16_t i;
+
+	if (!cache)
+		return;
+
+	for (i = 0; i < cache->shard_count; i++) {
+		shard = &cache->shards[i];
+		if (shard->entries) {
+			cryptoauth_wipe(shard->entries, shard->used * sizeof(struct sha204k_entry));
+			free(shard->entries);
+		}
+		free(shard->buckets);
+		pthread_mutex_destroy(&shard->mutex);
+	}
+
+	cryptoauth_wipe(cache->parent_key, sizeof(cache->parent_key));
+	free(cache->shards);
+	free(cache);
+}
+
+
+/** \brief This function looks up a child key, and derives and caches it if it is not cached.
+ *
+ * \param[in] cache pointer to cache
+ * \param[in] sn pointer to 9-byte serial number
+ * \param[out] child_key pointer to 32-byte child key
+ * \param[in] count_stats 1 to count the look-up as hit or miss, 0 for warm-up
+ */
+static void sha204k_lookup(struct sha204k_cache *cache, const uint8_t *sn, uint8_t *child_key, uint8_t count_stats)
+{
+	uint64_t hash = sha204k_hash(sn);
+	struct sha204k_shard *shard = &cache->shards[hash % cache->shard_count];
+	uint32_t bucket = (uint32_t) (hash >> 32) & shard->bucket_mask;
+	uint32_t index;
+
+	pthread_mutex_lock(&shard->mutex);
+	index = sha204k_find(shard, bucket, sn);
+	if (index != SHA204K_NONE) {
+		memcpy(child_key, shard->entries[index].child_key, SHA204_KEY_SIZE);
+		sha204k_lru_unlink(shard, index);
+		sha204k_lru_push(shard, index);
+		if (count_stats)
+			shard->hits++;
+		pthread_mutex_unlock(&shard->mutex);
+		return;
+	}
+	if (count_stats)
+		shard->misses++;
+	pthread_mutex_unlock(&shard->mutex);
+
+	// Derive without holding the lock, so other look-ups of this shard proceed meanwhile.
+	sha204k_derive(cache, sn, child_key);
+
+	// Another thread may have cached the same device in the meantime.
+	pthread_mutex_lock(&shard->mutex);
+	if (sha204k_find(shard, bucket, sn) == SHA204K_NONE)
+		sha204k_insert(shard, hash, sn, child_key);
+	pthread_mutex_unlock(&shard->mutex);
+}
+
+
+/** \brief This function returns the child key of a device.
+ *
+ * The key is the same sha204h_derive_key() calculates with the padded serial number in
+ * TempKey (pass-through nonce) and the parent key and target key id of the cache.
+ * It can be passed as key to sha204h_mac() or sha204h_check_mac() to verify a response of the device.
+ * This function can be called from several threads at the same time.
+ *
+ * \param[in] cache pointer to cache
+ * \param[in] sn pointer to 9-byte serial number of the device
+ * \param[out] child_key pointer to 32-byte child key
+ * \return status of the operation
+ */
+uint8_t sha204k_cache_get(struct sha204k_cache *cache, const uint8_t *sn, uint8_t *child_key)
+{
+	if (!cache || !sn || !child_key)
+		return SHA204_BAD_PARAM;
+
+	sha204k_lookup(cache, sn, child_key, 1);
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function derives and caches the child keys of the devices listed in a file.
+ *
+ * The file holds the 9-byte serial numbers of the devices back to back, e.g. the
+ * devices that authenticated most recently. It does not hold any keys; they are
+ * derived while loading. Warm-up look-ups are not counted as hits or misses.
+ * If the file lists more devices than the cache holds, the last ones listed stay cached.
+ *
+ * \param[in] cache pointer to cache
+ * \param[in] file_name name of the file
+ * \param[out] loaded pointer to the number of serial numbers read, can be NULL
+ * \return status of the operation
+ */
+uint8_t sha204k_cache_warm_up(struct sha204k_cache *cache, const char *file_name, uint32_t *loaded)
+{
+	uint8_t sn[SHA204K_SN_SIZE];
+	uint8_t child_key[SHA204_KEY_SIZE];
+	uint32_t count = 0;
+	size_t size;
+	FILE *file;
+
+	if (!cache || !file_name)
+		return SHA204_BAD_PARAM;
+
+	file = fopen(file_name, "rb");
+	if (!file)
+		return SHA204_FUNC_FAIL;
+
+	while ((size = fread(sn, 1, SHA204K_SN_SIZE, file)) == SHA204K_SN_SIZE) {
+		sha204k_lookup(cache, sn, child_key, 0);
+		count++;
+	}
+	fclose(file);
+	cryptoauth_wipe(child_key, sizeof(child_key));
+
+	if (loaded)
+		*loaded = count;
+
+	// A partial serial number at the end means the file is not a list of serial numbers.
+	return size ? SHA204_INVALID_SIZE : SHA204_SUCCESS;
+}
+
+
+/** \brief This function sums the counters of all shards.
+ *
+ * \param[in] cache pointer to cache
+ * \param[out] stats pointer to counters
+ */
+void sha204k_cache_get_stats(struct sha204k_cache *cache, struct sha204k_cache_stats *stats)
+{
+	struct sha204k_shard *shard;
+	uint16_t i;
+
+	memset(stats, 0, sizeof(*stats));
+
+	for (i = 0; i < cache->shard_count; i++) {
+		shard = &cache->shards[i];
+		pthread_mutex_lock(&shard->mutex);
+		stats->hits += shard->hits;
+		stats->misses += shard->misses;
+		stats->evictions += shard->evictions;
+		stats->entries += shard->used;
+		pthread_mutex_unlock(&shard->mutex);
+	}
+}
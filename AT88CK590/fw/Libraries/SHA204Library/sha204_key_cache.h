@@ -0,0 +1,103 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Diversified Key Cache
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#ifndef SHA204_KEY_CACHE_H
+#   define SHA204_KEY_CACHE_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+
+
+/** \defgroup atsha204_key_cache Module 10: Diversified Key Cache
+ *
+ * \brief
+ * Use these functions on a server that authenticates many client devices whose keys
+ * were diversified from a parent key and their serial number, as in
+ * \ref sha204e_checkmac_diversified_key. The child key of a device is the digest a
+ * DeriveKey command calculates over the parent key and the padded serial number,
+ * as sha204h_derive_key() does. The cache keeps the child keys of the most recently
+ * authenticated devices, so repeated authentications of a device skip this hash.
+ *
+ * The cache is split into shards, each with its own lock, hash table and
+ * least-recently-used list, so threads that look up different devices rarely
+ * wait for each other. A child key is derived outside the lock of its shard.
+ *
+ * This module needs POSIX threads, so it is meant for hosts and not for firmware.
+@{ */
+
+//! size of the serial number that identifies a device in the cache
+#define SHA204K_SN_SIZE              (9)
+
+//! maximum number of shards
+#define SHA204K_SHARDS_MAX         (256)
+
+
+/** \struct sha204k_cache_stats
+ *  \brief Counters of a cache, summed over all shards.
+ *  \var sha204k_cache_stats::hits
+ *       \brief Number of look-ups that found the child key in the cache.
+ *  \var sha204k_cache_stats::misses
+ *       \brief Number of look-ups that derived the child key.
+ *  \var sha204k_cache_stats::evictions
+ *       \brief Number of child keys removed to make room for others.
+ *  \var sha204k_cache_stats::entries
+ *       \brief Number of child keys in the cache.
+ */
+struct sha204k_cache_stats {
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+	uint32_t entries;
+};
+
+
+//! opaque cache, created by sha204k_cache_create()
+struct sha204k_cache;
+
+
+uint8_t sha204k_cache_create(uint32_t capacity, uint16_t shards, const uint8_t *parent_key,
+		uint16_t target_key_id, struct sha204k_cache **cache);
+void sha204k_cache_destroy(struct sha204k_cache *cache);
+uint8_t sha204k_cache_get(struct sha204k_cache *cache, const uint8_t *sn, uint8_t *child_key);
+uint8_t sha204k_cache_warm_up(struct sha204k_cache *cache, const char *file_name, uint32_t *loaded);
+void sha204k_cache_get_stats(struct sha204k_cache *cache, struct sha204k_cache_stats *stats);
+
+/** @} */
+
+#endif //SHA204_KEY_CACHE_H
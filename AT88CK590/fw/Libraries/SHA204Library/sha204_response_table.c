@@ -0,0 +1,617 @@
+/** \file
+ *  \brief  Challenge / Response Tables for Fixed-Challenge Authentication
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdlib.h>                    // needed for qsort()
+#include <errno.h>                     // needed for errno
+#include <fcntl.h>                     // needed for open()
+#include <unistd.h>                    // needed for close()
+#include <sys/mman.h>                  // needed for mmap()
+#include <sys/stat.h>                  // needed for fstat()
+#include <pthread.h>                   // needed for the build threads
+
+#include "sha204_response_table.h"     // definitions and declarations for this module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "cryptoauth_core.h"           // definitions and declarations for the digest calculations
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+#include "cryptoauth_wipe.h"           // definitions and declarations for the Wipe module
+#include "cryptoauth_file.h"           // definitions and declarations for writing mapped files
+
+
+//! identifies a table file, followed by the version and the record size
+static const uint8_t sha204t_magic[8] = {'S', 'H', 'A', '2', '0', '4', 'C', 'R'};
+
+//! maximum number of records in a table, so the hash index stays below 4 GB
+#define SHA204T_RECORDS_MAX         (1UL << 29)
+
+//! size of a hash index entry
+#define SHA204T_BUCKET_SIZE          (4)
+
+
+/** \brief Header of a table file.
+ *
+ *  It is followed by the records, sorted by serial number and challenge ID, and by
+ *  the hash index. The index has bucket_count entries, a power of two that is at
+ *  least twice the record count. An entry holds the position of a record plus one,
+ *  or zero if it is empty. Collisions go to the next entry. All numbers are stored
+ *  LSB first.
+ */
+struct sha204t_header {
+	uint8_t magic[sizeof(sha204t_magic)];
+	uint8_t version[2];
+	uint8_t record_size[2];
+	uint8_t count[4];
+	uint8_t bucket_count[4];
+	uint8_t reserved[SHA204T_HEADER_SIZE - sizeof(sha204t_magic) - 12];
+};
+
+
+/** \brief Mapping of a table file.
+ */
+struct sha204t_table {
+	void *map;
+	size_t size;
+	uint32_t count;
+	uint32_t bucket_mask;
+	const struct sha204t_record *records;
+	const uint8_t *buckets;
+};
+
+
+/** \brief Part of the manifest that one build thread calculates.
+ */
+struct sha204t_job {
+	const struct sha204t_manifest_entry *entries;
+	struct sha204t_record *records;
+	uint16_t challenge_count;
+	uint32_t first;
+	uint32_t count;
+	pthread_t thread;
+};
+
+
+/** \brief This function reads a number that is stored LSB first.
+ *
+ * \param[in] bytes pointer to number
+ * \param[in] size size of number, up to 4
+ * \return number
+ */
+static uint32_t sha204t_get(const uint8_t *bytes, uint8_t size)
+{
+	uint32_t value = 0;
+
+	while (size--)
+		value = (value << 8) | bytes[size];
+	return value;
+}
+
+
+/** \brief This function stores a number LSB first.
+ *
+ * \param[out] bytes pointer to number
+ * \param[in] size size of number, up to 4
+ * \param[in] value number
+ */
+static void sha204t_put(uint8_t *bytes, uint8_t size, uint32_t value)
+{
+	for (; size; size--, value >>= 8)
+		*bytes++ = (uint8_t) value;
+}
+
+
+/** \brief This function hashes a serial number and a challenge ID into the index (FNV-1a).
+ *
+ * \param[in] sn pointer to 9-byte serial number
+ * \param[in] challenge_id challenge ID
+ * \return hash value
+ */
+static uint32_t sha204t_hash(const uint8_t *sn, uint16_t challenge_id)
+{
+	uint32_t hash = 2166136261UL;
+	uint8_t i;
+
+	for (i = 0; i < SHA204T_SN_SIZE; i++)
+		hash = (hash ^ sn[i]) * 16777619UL;
+	hash = (hash ^ (challenge_id & 0xFF)) * 16777619UL;
+	hash = (hash ^ (challenge_id >> 8)) * 16777619UL;
+
+	// The index is addressed by the low bits, so the high bits are mixed into them.
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6BUL;
+	return hash ^ (hash >> 13);
+}
+
+
+/** \brief This function calculates a challenge and its response.
+ *
+ * \param[in] entry pointer to manifest entry
+ * \param[in] challenge_id number of the challenge
+ * \param[out] record pointer to record
+ */
+static void sha204t_record_init(const struct sha204t_manifest_entry *entry, uint16_t challenge_id,
+		struct sha204t_record *record)
+{
+	uint8_t message[SHA204T_SEED_SIZE + SHA204T_SN_SIZE + 2];
+
+	memset(record, 0, sizeof(*record));
+	memcpy(record->sn, entry->sn, SHA204T_SN_SIZE);
+	record->mode = entry->mode;
+	record->key_id[0] = entry->key_id;
+	sha204t_put(record->challenge_id, sizeof(record->challenge_id), challenge_id);
+
+	memcpy(message, entry->challenge_seed, SHA204T_SEED_SIZE);
+	memcpy(&message[SHA204T_SEED_SIZE], entry->sn, SHA204T_SN_SIZE);
+	memcpy(&message[SHA204T_SEED_SIZE + SHA204T_SN_SIZE], record->challenge_id, sizeof(record->challenge_id));
+	sha256(sizeof(message), message, record->challenge);
+
+	cryptoauth_mac(SHA204_MAC, entry->mode, entry->key_id, entry->key, record->challenge,
+			entry->otp, entry->sn, record->response);
+}
+
+
+/** \brief This function is the body of a build thread.
+ *
+ * \param[in] arg pointer to job
+ * \return NULL
+ */
+static void *sha204t_thread(void *arg)
+{
+	struct sha204t_job *job = (struct sha204t_job *) arg;
+	struct sha204t_record *record = &job->records[(size_t) job->first * job->challenge_count];
+	uint32_t i;
+	uint16_t challenge_id;
+
+	for (i = job->first; i < job->first + job->count; i++)
+		for (challenge_id = 0; challenge_id < job->challenge_count; challenge_id++)
+			sha204t_record_init(&job->entries[i], challenge_id, record++);
+
+	return NULL;
+}
+
+
+/** \brief This function compares two records by serial number and challenge ID, for qsort().
+ *
+ * \param[in] a pointer to record
+ * \param[in] b pointer to record
+ * \return less than, equal to, or greater than zero
+ */
+static int sha204t_compare(const void *a, const void *b)
+{
+	const struct sha204t_record *record_a = (const struct sha204t_record *) a;
+	const struct sha204t_record *record_b = (const struct sha204t_record *) b;
+	int difference = memcmp(record_a->sn, record_b->sn, SHA204T_SN_SIZE);
+
+	if (difference)
+		return difference;
+	return (int) sha204t_get(record_a->challenge_id, sizeof(record_a->challenge_id))
+			- (int) sha204t_get(record_b->challenge_id, sizeof(record_b->challenge_id));
+}
+
+
+/** \brief This function calculates the sorted records of a manifest.
+ *
+ * The manifest is split into equal parts that are calculated by threads - 1 new
+ * threads and the calling thread.
+ *
+ * \param[in] threads number of threads, 1 to SHA204T_THREADS_MAX
+ * \param[in] count number of devices
+ * \param[in] entries array of count manifest entries
+ * \param[in] challenge_count number of challenges per device
+ * \param[out] records pointer to the new records, to be released with free()
+ * \return status of the operation, SHA204_BAD_PARAM if an entry is invalid or a serial number appears twice
+ */
+static uint8_t sha204t_records_build(uint8_t threads, uint32_t count, const struct sha204t_manifest_entry *entries,
+		uint16_t challenge_count, struct sha204t_record **records)
+{
+	struct sha204t_job job[SHA204T_THREADS_MAX];
+	struct sha204t_record *new_records;
+	uint32_t record_count, i;
+	uint8_t started;
+
+	if ((!entries && count) || !threads || (threads > SHA204T_THREADS_MAX) || !challenge_count
+			|| ((uint64_t) count * challenge_count > SHA204T_RECORDS_MAX))
+		return SHA204_BAD_PARAM;
+
+	for (i = 0; i < count; i++) {
+		if ((entries[i].key_id > SHA204_KEY_ID_MAX) || (entries[i].mode & ~MAC_MODE_MASK)
+				|| (entries[i].mode & SHA204T_MODE_TEMPKEY))
+			return SHA204_BAD_PARAM;
+	}
+	if (threads > count)
+		threads = count ? (uint8_t) count : 1;
+
+	record_count = count * challenge_count;
+	new_records = malloc(record_count ? (size_t) record_count * SHA204T_RECORD_SIZE : 1);
+	if (!new_records)
+		return SHA204_FUNC_FAIL;
+
+	for (i = 0; i < threads; i++) {
+		job[i].entries = entries;
+		job[i].records = new_records;
+		job[i].challenge_count = challenge_count;
+		job[i].first = (uint32_t) ((uint64_t) count * i / threads);
+		job[i].count = (uint32_t) ((uint64_t) count * (i + 1) / threads) - job[i].first;
+	}
+	// The calling thread calculates the first part, and also any part a new thread could not be started for.
+	for (started = 1; started < threads; started++) {
+		if (pthread_create(&job[started].thread, NULL, sha204t_thread, &job[started]))
+			break;
+	}
+	sha204t_thread(&job[0]);
+	for (i = started; i < threads; i++)
+		sha204t_thread(&job[i]);
+	for (i = 1; i < started; i++)
+		pthread_join(job[i].thread, NULL);
+
+	qsort(new_records, record_count, SHA204T_RECORD_SIZE, sha204t_compare);
+	for (i = 1; i < record_count; i++) {
+		if (!sha204t_compare(&new_records[i - 1], &new_records[i])) {
+			cryptoauth_wipe(new_records, (size_t) record_count * SHA204T_RECORD_SIZE);
+			free(new_records);
+			return SHA204_BAD_PARAM;
+		}
+	}
+
+	*records = new_records;
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function merges two sorted record arrays.
+ *
+ * A new record replaces an old record with the same serial number and challenge ID.
+ *
+ * \param[in] old_records old records, sorted
+ * \param[in] old_count number of old records
+ * \param[in] new_records new records, sorted
+ * \param[in] new_count number of new records
+ * \param[out] records merged records, NULL to only count them
+ * \return number of merged records
+ */
+static uint32_t sha204t_merge(const struct sha204t_record *old_records, uint32_t old_count,
+		const struct sha204t_record *new_records, uint32_t new_count, struct sha204t_record *records)
+{
+	uint32_t old_index = 0, new_index = 0, count = 0;
+	const struct sha204t_record *next;
+	int difference;
+
+	while (old_index < old_count || new_index < new_count) {
+		if (old_index == old_count)
+			difference = 1;
+		else if (new_index == new_count)
+			difference = -1;
+		else
+			difference = sha204t_compare(&old_records[old_index], &new_records[new_index]);
+
+		if (difference < 0)
+			next = &old_records[old_index++];
+		else {
+			next = &new_records[new_index++];
+			if (!difference)
+				old_index++;
+		}
+		if (records)
+			memcpy(&records[count], next, SHA204T_RECORD_SIZE);
+		count++;
+	}
+
+	return count;
+}
+
+
+/** \brief This function writes the merged records and their hash index into a new table file.
+ *
+ * The file is written under a temporary name and renamed to file_name when it is
+ * complete (see cryptoauth_file_commit()). If the function fails, file_name is left as it was.
+ *
+ * \param[in] old_records old records, sorted
+ * \param[in] old_count number of old records
+ * \param[in] new_records new records, sorted
+ * \param[in] new_count number of new records
+ * \param[in] file_name name of the table file
+ * \return status of the operation
+ */
+static uint8_t sha204t_table_write(const struct sha204t_record *old_records, uint32_t old_count,
+		const struct sha204t_record *new_records, uint32_t new_count, const char *file_name)
+{
+	struct sha204t_header *header;
+	struct sha204t_record *records;
+	uint8_t *buckets;
+	uint32_t count = sha204t_merge(old_records, old_count, new_records, new_count, NULL);
+	uint32_t bucket_count = 2, bucket, i;
+	size_t size;
+	struct cryptoauth_file file;
+
+	if (count > SHA204T_RECORDS_MAX)
+		return SHA204_BAD_PARAM;
+	while (bucket_count < 2 * count)
+		bucket_count <<= 1;
+	size = SHA204T_HEADER_SIZE + (size_t) count * SHA204T_RECORD_SIZE + (size_t) bucket_count * SHA204T_BUCKET_SIZE;
+
+	if (cryptoauth_file_create(file_name, size, &file) != CRYPTOAUTH_FILE_SUCCESS)
+		return SHA204_FUNC_FAIL;
+
+	header = (struct sha204t_header *) file.map;
+	records = (struct sha204t_record *) ((uint8_t *) file.map + SHA204T_HEADER_SIZE);
+	buckets = (uint8_t *) file.map + SHA204T_HEADER_SIZE + (size_t) count * SHA204T_RECORD_SIZE;
+
+	sha204t_merge(old_records, old_count, new_records, new_count, records);
+	for (i = 0; i < count; i++) {
+		bucket = sha204t_hash(records[i].sn, (uint16_t) sha204t_get(records[i].challenge_id, 2)) & (bucket_count - 1);
+		while (sha204t_get(&buckets[bucket * SHA204T_BUCKET_SIZE], SHA204T_BUCKET_SIZE))
+			bucket = (bucket + 1) & (bucket_count - 1);
+		sha204t_put(&buckets[bucket * SHA204T_BUCKET_SIZE], SHA204T_BUCKET_SIZE, i + 1);
+	}
+
+	// The header is written last, so a file that was not completed is never accepted by sha204t_table_open().
+	header->version[0] = SHA204T_VERSION;
+	header->record_size[0] = SHA204T_RECORD_SIZE;
+	sha204t_put(header->count, sizeof(header->count), count);
+	sha204t_put(header->bucket_count, sizeof(header->bucket_count), bucket_count);
+	memcpy(header->magic, sha204t_magic, sizeof(sha204t_magic));
+
+	return cryptoauth_file_commit(&file, SHA204_SUCCESS);
+}
+
+
+/** \brief This function calculates the challenges and responses of a production lot and
+ *         writes them to a new table file.
+ *
+ * An existing file of that name is replaced.
+ *
+ * \param[in] threads number of threads, 1 to SHA204T_THREADS_MAX
+ * \param[in] count number of devices
+ * \param[in] entries array of count manifest entries
+ * \param[in] challenge_count number of challenges per device, at least 1
+ * \param[in] file_name name of the table file
+ * \return status of the operation, SHA204_BAD_PARAM if an entry is invalid or a serial number appears twice
+ */
+uint8_t sha204t_table_build(uint8_t threads, uint32_t count, const struct sha204t_manifest_entry *entries,
+		uint16_t challenge_count, const char *file_name)
+{
+	struct sha204t_record *records;
+	uint32_t record_count = count * challenge_count;
+	uint8_t ret_code;
+
+	if (!file_name)
+		return SHA204_BAD_PARAM;
+
+	ret_code = sha204t_records_build(threads, count, entries, challenge_count, &records);
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	ret_code = sha204t_table_write(NULL, 0, records, record_count, file_name);
+
+	cryptoauth_wipe(records, (size_t) record_count * SHA204T_RECORD_SIZE);
+	free(records);
+
+	return ret_code;
+}
+
+
+/** \brief This function adds the challenges and responses of a production lot to a table file.
+ *
+ * Only the new lot is calculated. Its records are merged with the existing ones into
+ * a new file, which then replaces the old one. A device that is already in the table
+ * gets the new challenges and responses. If the file does not exist, it is created.
+ *
+ * \param[in] threads number of threads, 1 to SHA204T_THREADS_MAX
+ * \param[in] count number of devices
+ * \param[in] entries array of count manifest entries
+ * \param[in] challenge_count number of challenges per device, at least 1
+ * \param[in] file_name name of the table file
+ * \return status of the operation, SHA204_INVALID_SIZE if the existing file is not a complete table file
+ */
+uint8_t sha204t_table_append(uint8_t threads, uint32_t count, const struct sha204t_manifest_entry *entries,
+		uint16_t challenge_count, const char *file_name)
+{
+	struct sha204t_table *table = NULL;
+	struct sha204t_record *records;
+	uint32_t record_count = count * challenge_count;
+	uint8_t ret_code;
+
+	if (!file_name)
+		return SHA204_BAD_PARAM;
+
+	ret_code = sha204t_table_open(file_name, &table);
+	if (ret_code == SHA204_FUNC_FAIL && errno == ENOENT)
+		table = NULL;
+	else if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	ret_code = sha204t_records_build(threads, count, entries, challenge_count, &records);
+	if (ret_code == SHA204_SUCCESS) {
+		ret_code = sha204t_table_write(table ? table->records : NULL, table ? table->count : 0,
+				records, record_count, file_name);
+		cryptoauth_wipe(records, (size_t) record_count * SHA204T_RECORD_SIZE);
+		free(records);
+	}
+
+	sha204t_table_close(table);
+	return ret_code;
+}
+
+
+/** \brief This function maps a table file for reading.
+ *
+ * \param[in] file_name name of the table file
+ * \param[out] table pointer to the new mapping, to be released with sha204t_table_close()
+ * \return status of the operation, SHA204_INVALID_SIZE if the file is not a complete table file
+ */
+uint8_t sha204t_table_open(const char *file_name, struct sha204t_table **table)
+{
+	const struct sha204t_header *header;
+	struct sha204t_table *new_table;
+	struct stat status;
+	uint32_t count, bucket_count;
+	void *map;
+	int fd;
+
+	if (!file_name || !table)
+		return SHA204_BAD_PARAM;
+
+	fd = open(file_name, O_RDONLY);
+	if (fd < 0)
+		return SHA204_FUNC_FAIL;
+	if (fstat(fd, &status) || (status.st_size < SHA204T_HEADER_SIZE)) {
+		close(fd);
+		return SHA204_INVALID_SIZE;
+	}
+	map = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return SHA204_FUNC_FAIL;
+
+	header = (const struct sha204t_header *) map;
+	count = sha204t_get(header->count, sizeof(header->count));
+	bucket_count = sha204t_get(header->bucket_count, sizeof(header->bucket_count));
+	if (memcmp(header->magic, sha204t_magic, sizeof(sha204t_magic))
+			|| (header->version[0] != SHA204T_VERSION) || header->version[1]
+			|| (header->record_size[0] != SHA204T_RECORD_SIZE) || header->record_size[1]
+			|| (count > SHA204T_RECORDS_MAX) || (bucket_count <= count) || (bucket_count & (bucket_count - 1))
+			|| ((uint64_t) status.st_size != SHA204T_HEADER_SIZE + (uint64_t) count * SHA204T_RECORD_SIZE
+					+ (uint64_t) bucket_count * SHA204T_BUCKET_SIZE)) {
+		munmap(map, (size_t) status.st_size);
+		return SHA204_INVALID_SIZE;
+	}
+
+	new_table = malloc(sizeof(*new_table));
+	if (!new_table) {
+		munmap(map, (size_t) status.st_size);
+		return SHA204_FUNC_FAIL;
+	}
+	new_table->map = map;
+	new_table->size = (size_t) status.st_size;
+	new_table->count = count;
+	new_table->bucket_mask = bucket_count - 1;
+	new_table->records = (const struct sha204t_record *) ((const uint8_t *) map + SHA204T_HEADER_SIZE);
+	new_table->buckets = (const uint8_t *) map + SHA204T_HEADER_SIZE + (size_t) count * SHA204T_RECORD_SIZE;
+	*table = new_table;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function unmaps a table file.
+ *
+ * \param[in] table pointer to mapping, can be NULL
+ */
+void sha204t_table_close(struct sha204t_table *table)
+{
+	if (!table)
+		return;
+
+	munmap(table->map, table->size);
+	free(table);
+}
+
+
+/** \brief This function returns the number of records in a table.
+ *
+ * \param[in] table pointer to mapping
+ * \return number of records
+ */
+uint32_t sha204t_table_count(const struct sha204t_table *table)
+{
+	return table->count;
+}
+
+
+/** \brief This function returns a record by its position in the table.
+ *
+ * \param[in] table pointer to mapping
+ * \param[in] index position of the record, records are sorted by serial number and challenge ID
+ * \return pointer to record, NULL if index is out of range
+ */
+const struct sha204t_record *sha204t_table_record(const struct sha204t_table *table, uint32_t index)
+{
+	return index < table->count ? &table->records[index] : NULL;
+}
+
+
+/** \brief This function finds a record through the hash index.
+ *
+ * \param[in] table pointer to mapping
+ * \param[in] sn pointer to 9-byte serial number
+ * \param[in] challenge_id challenge ID
+ * \return pointer to record, NULL if the table has no such challenge for the device
+ */
+const struct sha204t_record *sha204t_table_find(const struct sha204t_table *table, const uint8_t *sn,
+		uint16_t challenge_id)
+{
+	uint32_t bucket = sha204t_hash(sn, challenge_id) & table->bucket_mask;
+	uint32_t index, probes;
+	const struct sha204t_record *record;
+
+	// The index is never full, so the search ends at an empty entry at the latest.
+	for (probes = 0; probes <= table->bucket_mask; probes++) {
+		index = sha204t_get(&table->buckets[bucket * SHA204T_BUCKET_SIZE], SHA204T_BUCKET_SIZE);
+		if (!index || index > table->count)
+			return NULL;
+		record = &table->records[index - 1];
+		if (!memcmp(record->sn, sn, SHA204T_SN_SIZE)
+				&& (sha204t_get(record->challenge_id, sizeof(record->challenge_id)) == challenge_id))
+			return record;
+		bucket = (bucket + 1) & table->bucket_mask;
+	}
+
+	return NULL;
+}
+
+
+/** \brief This function compares the response of a device with the recorded one.
+ *
+ * The comparison takes the same time wherever the responses differ.
+ *
+ * \param[in] record pointer to record found by sha204t_table_find()
+ * \param[in] response pointer to the 32-byte MAC of the MAC response packet
+ * \return SHA204_SUCCESS if the responses match, SHA204_FUNC_FAIL if not
+ */
+uint8_t sha204t_verify(const struct sha204t_record *record, const uint8_t *response)
+{
+	uint8_t i, difference = 0;
+
+	if (!record || !response)
+		return SHA204_BAD_PARAM;
+
+	for (i = 0; i < SHA204_KEY_SIZE; i++)
+		difference |= record->response[i] ^ response[i];
+
+	return difference ? SHA204_FUNC_FAIL : SHA204_SUCCESS;
+}
@@ -0,0 +1,169 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Challenge / Response Table Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#ifndef SHA204_RESPONSE_TABLE_H
+#   define SHA204_RESPONSE_TABLE_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+
+
+/** \defgroup atsha204_response_table Module 14: Challenge / Response Tables
+ *
+ * \brief
+ * Use these functions to authenticate accessories and consumables whose keys the
+ * server must not hold, with the fixed challenge / response scheme of
+ * sha204e_fixed_challenge_response(). At manufacturing time, while the keys are at
+ * hand, sha204t_table_build() calculates a number of challenges for every device
+ * and the MAC responses the device will give to them, and stores them in a table file.
+ * The server maps the table with sha204t_table_open(). To authenticate a device, it
+ * picks a challenge ID it has not used for this device yet, sends the challenge of
+ * sha204t_table_find() in a MAC command, and compares the response with
+ * sha204t_verify(). No key material is needed online.
+ *
+ * The challenge of a device is SHA-256(challenge seed || SN || challenge ID), so
+ * challenges differ between devices even if a lot shares one seed.
+ *
+ * The records are sorted by serial number and challenge ID. A hash index behind them
+ * finds a record with one or two page accesses, independent of the table size.
+ * sha204t_table_append() adds the devices of a new lot: it merges the new records
+ * with the existing ones into a new file and renames it over the old one. Servers
+ * that still map the old file keep reading it until they open the table again.
+ *
+ * This module needs POSIX threads and memory-mapped files, so it is meant for hosts
+ * and not for firmware.
+@{ */
+
+//! size of the serial number that identifies a device in a table
+#define SHA204T_SN_SIZE              (9)
+
+//! size of a challenge seed
+#define SHA204T_SEED_SIZE           (32)
+
+//! size of the OTP bytes a MAC can include, OTP[0:10]
+#define SHA204T_OTP_SIZE            (11)
+
+//! size of a record in a table file
+#define SHA204T_RECORD_SIZE         (80)
+
+//! size of the header of a table file
+#define SHA204T_HEADER_SIZE         (64)
+
+//! version of the table file format
+#define SHA204T_VERSION              (1)
+
+//! maximum number of threads sha204t_table_build() and sha204t_table_append() use
+#define SHA204T_THREADS_MAX         (64)
+
+//! MAC mode bits that take TempKey, and so a nonce, into the MAC; they cannot be precomputed
+#define SHA204T_MODE_TEMPKEY        (MAC_MODE_PASSTHROUGH)
+
+
+/** \struct sha204t_manifest_entry
+ *  \brief One device of a production lot.
+ *  \var sha204t_manifest_entry::sn
+ *       \brief [in] 9-byte serial number of the device.
+ *  \var sha204t_manifest_entry::otp
+ *       \brief [in] OTP[0:10] of the device, used if the mode includes OTP.
+ *  \var sha204t_manifest_entry::challenge_seed
+ *       \brief [in] 32-byte seed of the challenges.
+ *  \var sha204t_manifest_entry::mode
+ *       \brief [in] Mode parameter of the MAC command, without the TempKey bits.
+ *  \var sha204t_manifest_entry::key_id
+ *       \brief [in] KeyID parameter of the MAC command (0 to 15).
+ *  \var sha204t_manifest_entry::key
+ *       \brief [in] 32-byte key in slot key_id.
+ */
+struct sha204t_manifest_entry {
+	uint8_t sn[SHA204T_SN_SIZE];
+	uint8_t otp[SHA204T_OTP_SIZE];
+	uint8_t challenge_seed[SHA204T_SEED_SIZE];
+	uint8_t mode;
+	uint8_t key_id;
+	uint8_t key[SHA204_KEY_SIZE];
+};
+
+
+/** \struct sha204t_record
+ *  \brief Precomputed challenge and response, as stored in a table file.
+ *
+ *  All multi-byte parameters are stored LSB first, as they are sent to the device.
+ *  \var sha204t_record::sn
+ *       \brief 9-byte serial number of the device.
+ *  \var sha204t_record::mode
+ *       \brief Mode parameter of the MAC command (Param1).
+ *  \var sha204t_record::key_id
+ *       \brief KeyID parameter of the MAC command (Param2).
+ *  \var sha204t_record::challenge_id
+ *       \brief Number of the challenge of this device.
+ *  \var sha204t_record::challenge
+ *       \brief 32-byte challenge of the MAC command.
+ *  \var sha204t_record::response
+ *       \brief 32-byte MAC the device responds with.
+ */
+struct sha204t_record {
+	uint8_t sn[SHA204T_SN_SIZE];
+	uint8_t mode;
+	uint8_t key_id[2];
+	uint8_t challenge_id[2];
+	uint8_t reserved[2];
+	uint8_t challenge[MAC_CHALLENGE_SIZE];
+	uint8_t response[SHA204_KEY_SIZE];
+};
+
+
+//! opaque table file mapping, created by sha204t_table_open()
+struct sha204t_table;
+
+
+uint8_t sha204t_table_build(uint8_t threads, uint32_t count, const struct sha204t_manifest_entry *entries,
+		uint16_t challenge_count, const char *file_name);
+uint8_t sha204t_table_append(uint8_t threads, uint32_t count, const struct sha204t_manifest_entry *entries,
+		uint16_t challenge_count, const char *file_name);
+uint8_t sha204t_table_open(const char *file_name, struct sha204t_table **table);
+void sha204t_table_close(struct sha204t_table *table);
+uint32_t sha204t_table_count(const struct sha204t_table *table);
+const struct sha204t_record *sha204t_table_record(const struct sha204t_table *table, uint32_t index);
+const struct sha204t_record *sha204t_table_find(const struct sha204t_table *table, const uint8_t *sn,
+		uint16_t challenge_id);
+uint8_t sha204t_verify(const struct sha204t_record *record, const uint8_t *response);
+
+/** @} */
+
+#endif //SHA204_RESPONSE_TABLE_H
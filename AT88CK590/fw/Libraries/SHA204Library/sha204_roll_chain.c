@@ -0,0 +1,480 @@
+/** \file
+ *  \brief  Functions that Follow Rolled DeriveKey Chains
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdlib.h>                    // needed for malloc()
+#include <fcntl.h>                     // needed for open()
+#include <unistd.h>                    // needed for close()
+#include <sys/mman.h>                  // needed for mmap()
+#include <sys/stat.h>                  // needed for fstat()
+#include <pthread.h>                   // needed for the roll threads
+
+#include "sha204_roll_chain.h"         // definitions and declarations for this module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "cryptoauth_core.h"           // definitions of the digest message sizes
+#include "sha256_batch.h"              // definitions and declarations for the Multi-Buffer SHA-256 module
+#include "cryptoauth_wipe.h"           // definitions and declarations for the Wipe module
+#include "cryptoauth_file.h"           // definitions and declarations for writing mapped files
+
+
+//! number of chains a thread stages and rolls together
+#define SHA204R_GROUP_SIZE          (64)
+
+//! identifies an index file
+static const uint8_t sha204r_magic[8] = {'S', 'H', 'A', '2', '0', '4', 'R', 'C'};
+
+
+/** \brief Header of an index file. It is followed by the entries, sorted by serial number.
+ *
+ *  All numbers are stored LSB first. An entry holds the serial number, the DeriveKey
+ *  parameters and the nonce of a device in its first SHA204R_ENTRY_HEADER_SIZE bytes,
+ *  followed by checkpoint_count keys.
+ */
+struct sha204r_header {
+	uint8_t magic[sizeof(sha204r_magic)];
+	uint8_t version[2];
+	uint8_t reserved1[2];
+	uint8_t interval[4];
+	uint8_t checkpoint_count[4];
+	uint8_t count[4];
+	uint8_t reserved2[SHA204R_HEADER_SIZE - sizeof(sha204r_magic) - 16];
+};
+
+
+/** \brief Mapping of an index file.
+ */
+struct sha204r_index {
+	void *map;
+	size_t size;
+	const uint8_t *entries;
+	size_t entry_size;
+	uint32_t count;
+	uint32_t interval;
+	uint32_t checkpoint_count;
+};
+
+
+/** \brief Chains that one thread rolls.
+ */
+struct sha204r_job {
+	struct sha204r_chain *chains;
+	uint32_t count;
+	uint32_t rolls;
+	pthread_t thread;
+};
+
+
+/** \brief This function reads a number stored LSB first.
+ *
+ * \param[in] bytes pointer to four bytes
+ * \return number
+ */
+static uint32_t sha204r_get_u32(const uint8_t *bytes)
+{
+	return bytes[0] | ((uint32_t) bytes[1] << 8) | ((uint32_t) bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+
+/** \brief This function stores a number LSB first.
+ *
+ * \param[out] bytes pointer to four bytes
+ * \param[in] value number
+ */
+static void sha204r_put_u32(uint8_t *bytes, uint32_t value)
+{
+	uint8_t i;
+
+	for (i = 0; i < 4; i++)
+		bytes[i] = (uint8_t) (value >> (i << 3));
+}
+
+
+/** \brief This function builds the DeriveKey message of a chain.
+ *
+ * The message is Key{32} || OpCode || Param1 || Param2{2} || SN[8] || SN[0:1] || 0{25} || TempKey{32},
+ * as cryptoauth_key_digest() hashes it. Only the key changes from roll to roll.
+ *
+ * \param[in] chain pointer to chain
+ * \param[out] message pointer to CRYPTOAUTH_MSG_SIZE_KEY bytes
+ */
+static void sha204r_message_init(const struct sha204r_chain *chain, uint8_t *message)
+{
+	const struct cryptoauth_message_fields fields = {CRYPTOAUTH_LAYOUT_KEY, SHA204_DERIVE_KEY, chain->random,
+			chain->target_key_id, chain->key, chain->nonce, NULL, NULL, NULL};
+
+	cryptoauth_message(&fields, message);
+}
+
+
+/** \brief This function rolls up to SHA204R_GROUP_SIZE chains.
+ *
+ * Every digest is written over the key at the start of its own message, so the
+ * messages are ready for the next roll without copying.
+ *
+ * \param[in,out] chains pointer to chains
+ * \param[in] count number of chains
+ * \param[in] rolls number of rolls
+ */
+static void sha204r_roll_group(struct sha204r_chain *chains, uint8_t count, uint32_t rolls)
+{
+	uint8_t buffer[SHA204R_GROUP_SIZE][CRYPTOAUTH_MSG_SIZE_KEY];
+	uint8_t *messages[SHA204R_GROUP_SIZE];
+	uint8_t i;
+
+	for (i = 0; i < count; i++) {
+		sha204r_message_init(&chains[i], buffer[i]);
+		messages[i] = buffer[i];
+	}
+
+	while (rolls--)
+		sha256_batch(count, CRYPTOAUTH_MSG_SIZE_KEY, (const uint8_t *const *) messages, messages);
+
+	for (i = 0; i < count; i++)
+		memcpy(chains[i].key, buffer[i], SHA204_KEY_SIZE);
+
+	cryptoauth_wipe(buffer, count * CRYPTOAUTH_MSG_SIZE_KEY);
+}
+
+
+/** \brief This function is the body of a roll thread.
+ *
+ * \param[in] arg pointer to job
+ * \return NULL
+ */
+static void *sha204r_thread(void *arg)
+{
+	struct sha204r_job *job = (struct sha204r_job *) arg;
+	uint32_t i, group;
+
+	for (i = 0; i < job->count; i += group) {
+		group = job->count - i < SHA204R_GROUP_SIZE ? job->count - i : SHA204R_GROUP_SIZE;
+		sha204r_roll_group(&job->chains[i], (uint8_t) group, job->rolls);
+	}
+
+	return NULL;
+}
+
+
+/** \brief This function rolls the keys of many chains by the same number of rolls.
+ *
+ * The chains are split into equal parts that are rolled by threads - 1 new threads
+ * and the calling thread. The result is the one of calling sha204h_derive_key() for
+ * every roll, with TempKey set to the nonce of the chain by a pass-through Nonce.
+ *
+ * \param[in] threads number of threads, 1 to SHA204R_THREADS_MAX
+ * \param[in] count number of chains
+ * \param[in,out] chains array of count chains
+ * \param[in] rolls number of rolls
+ * \return status of the operation
+ */
+uint8_t sha204r_advance(uint8_t threads, uint32_t count, struct sha204r_chain *chains, uint32_t rolls)
+{
+	struct sha204r_job job[SHA204R_THREADS_MAX];
+	uint32_t first, i;
+	uint8_t started;
+
+	if ((!chains && count) || !threads || (threads > SHA204R_THREADS_MAX))
+		return SHA204_BAD_PARAM;
+	for (i = 0; i < count; i++) {
+		if ((chains[i].target_key_id > SHA204_KEY_ID_MAX) || (chains[i].random & ~DERIVE_KEY_RANDOM_FLAG))
+			return SHA204_BAD_PARAM;
+	}
+	if (threads > count)
+		threads = count ? (uint8_t) count : 1;
+
+	for (i = 0; i < threads; i++) {
+		first = (uint32_t) ((uint64_t) count * i / threads);
+		job[i].chains = &chains[first];
+		job[i].count = (uint32_t) ((uint64_t) count * (i + 1) / threads) - first;
+		job[i].rolls = rolls;
+	}
+	// The calling thread rolls the first part, and also any part a new thread could not be started for.
+	for (started = 1; started < threads; started++) {
+		if (pthread_create(&job[started].thread, NULL, sha204r_thread, &job[started]))
+			break;
+	}
+	sha204r_thread(&job[0]);
+	for (i = started; i < threads; i++)
+		sha204r_thread(&job[i]);
+	for (i = 1; i < started; i++)
+		pthread_join(job[i].thread, NULL);
+
+	for (i = 0; i < count; i++)
+		chains[i].rolls += rolls;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function compares the serial numbers of two chains, for qsort().
+ *
+ * \param[in] a pointer to chain
+ * \param[in] b pointer to chain
+ * \return less than, equal to, or greater than zero
+ */
+static int sha204r_compare(const void *a, const void *b)
+{
+	return memcmp(((const struct sha204r_chain *) a)->sn, ((const struct sha204r_chain *) b)->sn, SHA204R_SN_SIZE);
+}
+
+
+/** \brief This function writes the checkpoints of many chains to an index file.
+ *
+ * The chains must not have been rolled yet. The index holds the key of every chain
+ * after every multiple of interval rolls up to horizon. The chains are rolled from
+ * checkpoint to checkpoint by sha204r_advance(). The index is written to a temporary file
+ * that replaces an existing index file only when it is complete (see cryptoauth_file_commit()).
+ * If the function fails, an existing index file is kept.
+ *
+ * \param[in] threads number of threads, 1 to SHA204R_THREADS_MAX
+ * \param[in] count number of chains
+ * \param[in] chains array of count chains, with sha204r_chain::rolls equal to 0
+ * \param[in] interval number of rolls between checkpoints (K)
+ * \param[in] horizon highest number of rolls the index covers with checkpoints
+ * \param[in] file_name name of the index file to create
+ * \return status of the operation, SHA204_BAD_PARAM if a chain is invalid or a serial number appears twice
+ */
+uint8_t sha204r_index_build(uint8_t threads, uint32_t count, const struct sha204r_chain *chains,
+		uint32_t interval, uint32_t horizon, const char *file_name)
+{
+	struct sha204r_chain *work;
+	struct sha204r_header *header;
+	uint32_t checkpoint_count, checkpoint, i;
+	size_t entry_size, size;
+	uint8_t *entries, *entry;
+	uint8_t ret_code = SHA204_SUCCESS;
+	struct cryptoauth_file file;
+
+	if ((!chains && count) || !file_name || !interval)
+		return SHA204_BAD_PARAM;
+	for (i = 0; i < count; i++) {
+		if (chains[i].rolls)
+			return SHA204_BAD_PARAM;
+	}
+
+	checkpoint_count = horizon / interval + 1;
+	entry_size = SHA204R_ENTRY_HEADER_SIZE + (size_t) checkpoint_count * SHA204_KEY_SIZE;
+	size = SHA204R_HEADER_SIZE + (size_t) count * entry_size;
+
+	// Roll copies of the chains, sorted by serial number like the entries.
+	work = malloc(count ? count * sizeof(*work) : 1);
+	if (!work)
+		return SHA204_FUNC_FAIL;
+	memcpy(work, chains, count * sizeof(*work));
+	qsort(work, count, sizeof(*work), sha204r_compare);
+	for (i = 1; i < count; i++) {
+		if (!memcmp(work[i - 1].sn, work[i].sn, SHA204R_SN_SIZE)) {
+			cryptoauth_wipe(work, count * sizeof(*work));
+			free(work);
+			return SHA204_BAD_PARAM;
+		}
+	}
+
+	if (cryptoauth_file_create(file_name, size, &file) != CRYPTOAUTH_FILE_SUCCESS)
+		ret_code = SHA204_FUNC_FAIL;
+
+	if (ret_code == SHA204_SUCCESS) {
+		header = (struct sha204r_header *) file.map;
+		entries = (uint8_t *) file.map + SHA204R_HEADER_SIZE;
+
+		for (i = 0, entry = entries; i < count; i++, entry += entry_size) {
+			memcpy(entry, work[i].sn, SHA204R_SN_SIZE);
+			entry[SHA204R_SN_SIZE] = work[i].target_key_id;
+			entry[SHA204R_SN_SIZE + 1] = work[i].random;
+			memcpy(&entry[SHA204R_ENTRY_HEADER_SIZE - SHA204_KEY_SIZE], work[i].nonce, SHA204_KEY_SIZE);
+		}
+
+		for (checkpoint = 0; checkpoint < checkpoint_count; checkpoint++) {
+			if (checkpoint) {
+				ret_code = sha204r_advance(threads, count, work, interval);
+				if (ret_code != SHA204_SUCCESS)
+					break;
+			}
+			for (i = 0, entry = entries; i < count; i++, entry += entry_size)
+				memcpy(&entry[SHA204R_ENTRY_HEADER_SIZE + (size_t) checkpoint * SHA204_KEY_SIZE],
+						work[i].key, SHA204_KEY_SIZE);
+		}
+
+		// The header is written last, so a file that was not completed is never accepted by sha204r_index_open().
+		if (ret_code == SHA204_SUCCESS) {
+			header->version[0] = SHA204R_VERSION;
+			sha204r_put_u32(header->interval, interval);
+			sha204r_put_u32(header->checkpoint_count, checkpoint_count);
+			sha204r_put_u32(header->count, count);
+			memcpy(header->magic, sha204r_magic, sizeof(sha204r_magic));
+		}
+
+		ret_code = cryptoauth_file_commit(&file, ret_code);
+	}
+
+	cryptoauth_wipe(work, count * sizeof(*work));
+	free(work);
+
+	return ret_code;
+}
+
+
+/** \brief This function maps an index file for reading.
+ *
+ * \param[in] file_name name of the index file
+ * \param[out] index pointer to the new mapping, to be released with sha204r_index_close()
+ * \return status of the operation, SHA204_INVALID_SIZE if the file is not a complete index file
+ */
+uint8_t sha204r_index_open(const char *file_name, struct sha204r_index **index)
+{
+	const struct sha204r_header *header;
+	struct sha204r_index *new_index;
+	struct stat status;
+	uint32_t count, interval, checkpoint_count;
+	void *map;
+	int fd;
+
+	if (!file_name || !index)
+		return SHA204_BAD_PARAM;
+
+	fd = open(file_name, O_RDONLY);
+	if (fd < 0)
+		return SHA204_FUNC_FAIL;
+	if (fstat(fd, &status) || (status.st_size < SHA204R_HEADER_SIZE)) {
+		close(fd);
+		return SHA204_INVALID_SIZE;
+	}
+	map = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return SHA204_FUNC_FAIL;
+
+	header = (const struct sha204r_header *) map;
+	count = sha204r_get_u32(header->count);
+	interval = sha204r_get_u32(header->interval);
+	checkpoint_count = sha204r_get_u32(header->checkpoint_count);
+	if (memcmp(header->magic, sha204r_magic, sizeof(sha204r_magic))
+			|| (header->version[0] != SHA204R_VERSION) || header->version[1]
+			|| !interval || !checkpoint_count
+			|| ((uint64_t) status.st_size != SHA204R_HEADER_SIZE + (uint64_t) count
+				* (SHA204R_ENTRY_HEADER_SIZE + (uint64_t) checkpoint_count * SHA204_KEY_SIZE))) {
+		munmap(map, (size_t) status.st_size);
+		return SHA204_INVALID_SIZE;
+	}
+
+	new_index = malloc(sizeof(*new_index));
+	if (!new_index) {
+		munmap(map, (size_t) status.st_size);
+		return SHA204_FUNC_FAIL;
+	}
+	new_index->map = map;
+	new_index->size = (size_t) status.st_size;
+	new_index->entries = (const uint8_t *) map + SHA204R_HEADER_SIZE;
+	new_index->entry_size = SHA204R_ENTRY_HEADER_SIZE + (size_t) checkpoint_count * SHA204_KEY_SIZE;
+	new_index->count = count;
+	new_index->interval = interval;
+	new_index->checkpoint_count = checkpoint_count;
+	*index = new_index;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function unmaps an index file.
+ *
+ * \param[in] index pointer to mapping, can be NULL
+ */
+void sha204r_index_close(struct sha204r_index *index)
+{
+	if (!index)
+		return;
+
+	munmap(index->map, index->size);
+	free(index);
+}
+
+
+/** \brief This function calculates the key of a device after a number of rolls.
+ *
+ * The entry of the device is found by binary search. The key is rolled from the
+ * checkpoint at or below rolls.
+ *
+ * \param[in] index pointer to mapping
+ * \param[in] sn pointer to 9-byte serial number
+ * \param[in] rolls number of rolls of the key
+ * \param[out] key pointer to 32-byte key
+ * \return status of the operation, SHA204_BAD_PARAM if the device is not in the index
+ */
+uint8_t sha204r_index_key(const struct sha204r_index *index, const uint8_t *sn, uint32_t rolls, uint8_t *key)
+{
+	struct sha204r_chain chain;
+	const uint8_t *entry = NULL;
+	uint32_t low = 0, high, middle, checkpoint;
+	int order;
+
+	if (!index || !sn || !key)
+		return SHA204_BAD_PARAM;
+
+	for (high = index->count; low < high; ) {
+		middle = low + (high - low) / 2;
+		entry = index->entries + (size_t) middle * index->entry_size;
+		order = memcmp(sn, entry, SHA204R_SN_SIZE);
+		if (!order)
+			break;
+		if (order < 0)
+			high = middle;
+		else
+			low = middle + 1;
+		entry = NULL;
+	}
+	if (!entry)
+		return SHA204_BAD_PARAM;
+
+	checkpoint = rolls / index->interval;
+	if (checkpoint >= index->checkpoint_count)
+		checkpoint = index->checkpoint_count - 1;
+
+	memcpy(chain.sn, entry, SHA204R_SN_SIZE);
+	chain.target_key_id = entry[SHA204R_SN_SIZE];
+	chain.random = entry[SHA204R_SN_SIZE + 1];
+	memcpy(chain.nonce, &entry[SHA204R_ENTRY_HEADER_SIZE - SHA204_KEY_SIZE], SHA204_KEY_SIZE);
+	memcpy(chain.key, &entry[SHA204R_ENTRY_HEADER_SIZE + (size_t) checkpoint * SHA204_KEY_SIZE], SHA204_KEY_SIZE);
+	chain.rolls = checkpoint * index->interval;
+
+	sha204r_roll_group(&chain, 1, rolls - chain.rolls);
+	memcpy(key, chain.key, SHA204_KEY_SIZE);
+	cryptoauth_wipe(&chain, sizeof(chain));
+
+	return SHA204_SUCCESS;
+}
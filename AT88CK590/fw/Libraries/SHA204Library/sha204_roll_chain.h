@@ -0,0 +1,124 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Rolled Key Chain Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#ifndef SHA204_ROLL_CHAIN_H
+#   define SHA204_ROLL_CHAIN_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+
+
+/** \defgroup atsha204_roll_chain Module 12: Rolled Key Chains
+ *
+ * \brief
+ * Use these functions on a server that has to know the current key of devices whose
+ * key slot is rolled with DeriveKey, as configured by sha204e_configure_derive_key().
+ * Every roll replaces the key with the digest sha204h_derive_key() calculates over the
+ * key itself and TempKey. The server can only follow a chain if it knows TempKey, so
+ * every roll of a device uses the same pass-through nonce, for example the padded
+ * serial number as in sha204e_configure_diversify_key().
+ *
+ * sha204r_advance() rolls many chains at once. It splits them among threads, and
+ * every thread hashes its chains in the lanes of the multi-buffer SHA-256 module.
+ *
+ * sha204r_index_build() stores the key of every device after 0, K, 2K, ... rolls in a
+ * memory-mapped index file, up to a horizon. sha204r_index_key() then calculates the
+ * key after any number of rolls within the horizon from the nearest checkpoint below,
+ * so it hashes at most K - 1 rolls. Beyond the horizon it rolls on from the last
+ * checkpoint. The index holds keys, so it has to be protected like them.
+ *
+ * This module needs POSIX threads and memory-mapped files, so it is meant for hosts
+ * and not for firmware.
+@{ */
+
+//! size of the serial number that identifies a device in an index
+#define SHA204R_SN_SIZE              (9)
+
+//! size of the header of an index file
+#define SHA204R_HEADER_SIZE         (64)
+
+//! size of the part of an index entry that precedes the checkpoints
+#define SHA204R_ENTRY_HEADER_SIZE   (48)
+
+//! version of the index file format
+#define SHA204R_VERSION              (1)
+
+//! maximum number of threads
+#define SHA204R_THREADS_MAX         (64)
+
+
+/** \struct sha204r_chain
+ *  \brief State of the rolled key of one device.
+ *  \var sha204r_chain::sn
+ *       \brief [in] 9-byte serial number of the device.
+ *  \var sha204r_chain::target_key_id
+ *       \brief [in] Slot that is rolled, TargetKey parameter used in DeriveKey command (Param2).
+ *  \var sha204r_chain::random
+ *       \brief [in] Random parameter used in DeriveKey command (Param1).
+ *  \var sha204r_chain::nonce
+ *       \brief [in] 32-byte pass-through nonce that is in TempKey for every roll.
+ *  \var sha204r_chain::key
+ *       \brief [in,out] 32-byte key after sha204r_chain::rolls rolls.
+ *  \var sha204r_chain::rolls
+ *       \brief [in,out] Number of rolls of the key.
+ */
+struct sha204r_chain {
+	uint8_t sn[SHA204R_SN_SIZE];
+	uint8_t target_key_id;
+	uint8_t random;
+	uint8_t nonce[SHA204_KEY_SIZE];
+	uint8_t key[SHA204_KEY_SIZE];
+	uint32_t rolls;
+};
+
+
+//! opaque index file mapping, created by sha204r_index_open()
+struct sha204r_index;
+
+
+uint8_t sha204r_advance(uint8_t threads, uint32_t count, struct sha204r_chain *chains, uint32_t rolls);
+uint8_t sha204r_index_build(uint8_t threads, uint32_t count, const struct sha204r_chain *chains,
+		uint32_t interval, uint32_t horizon, const char *file_name);
+uint8_t sha204r_index_open(const char *file_name, struct sha204r_index **index);
+void sha204r_index_close(struct sha204r_index *index);
+uint8_t sha204r_index_key(const struct sha204r_index *index, const uint8_t *sn, uint32_t rolls, uint8_t *key);
+
+/** @} */
+
+#endif //SHA204_ROLL_CHAIN_H
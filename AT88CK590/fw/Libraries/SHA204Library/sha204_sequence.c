@@ -0,0 +1,383 @@
+/** \file
+ *  \brief  Functions that Calculate the Results of Command Sequences
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdint.h>                    // data type definitions
+
+#include "sha204_sequence.h"           // definitions and declarations for this module
+#include "sha204_helper.h"             // definitions of the mode masks
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "cryptoauth_core.h"           // definitions and declarations for the digest calculations
+#include "sha256_batch.h"              // definitions and declarations for the Multi-Buffer SHA-256 module
+#include "cryptoauth_wipe.h"           // definitions and declarations for the Wipe module
+
+
+//! number of devices whose TempKey values are calculated together
+#define SHA204S_GROUP_SIZE          (64)
+
+//! number of midstates that are kept per command, a power of 2
+#define SHA204S_CACHE_SIZE          (64)
+
+
+/** \brief Key of a GenDig or HMAC command and the midstates of its first message block(s).
+ *
+ *  A GenDig command uses only the inner midstate. An HMAC command uses both.
+ */
+struct sha204s_midstate {
+	const uint8_t *key;
+	uint8_t ready;
+	uint32_t inner[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+	uint32_t outer[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+};
+
+
+/** \brief This function finds the midstates of a key in the cache of a command.
+ *
+ * The cache is direct-mapped by key address. A key that is seen for the first time
+ * replaces the entry of its cache line, and its message is hashed in full. When it
+ * is seen again, the midstates are calculated and used from then on.
+ *
+ * \param[in] step pointer to command
+ * \param[in,out] cache pointer to the SHA204S_CACHE_SIZE entries of the command
+ * \param[in] key pointer to 32-byte key
+ * \return pointer to midstates, NULL if the message has to be hashed in full
+ */
+static const struct sha204s_midstate *sha204s_cache_lookup(const struct sha204s_step *step,
+		struct sha204s_midstate *cache, const uint8_t *key)
+{
+	uintptr_t address = (uintptr_t) key;
+	struct sha204s_midstate *entry = &cache[((address >> 5) ^ (address >> 13)) & (SHA204S_CACHE_SIZE - 1)];
+
+	if (entry->key != key) {
+		entry->key = key;
+		entry->ready = 0;
+		return NULL;
+	}
+	if (!entry->ready) {
+		if (step->opcode == SHA204_GENDIG)
+			cryptoauth_key_digest_init(SHA204_GENDIG, step->param1, step->param2, key, entry->inner);
+		else
+			cryptoauth_hmac_key_init(key, entry->inner, entry->outer);
+		entry->ready = 1;
+	}
+
+	return entry;
+}
+
+
+/** \brief This function checks a sequence of commands and the TempKey flags they require.
+ *
+ * The checks are the ones sha204h_nonce(), sha204h_gen_dig(), sha204h_mac() and
+ * sha204h_hmac() do. In addition, GenDig commands over the data zone and commands that
+ * use a key have to address one of the slots.
+ *
+ * \param[out] sequence pointer to checked sequence
+ * \param[in] count number of commands, 1 to SHA204S_STEPS_MAX
+ * \param[in] steps array of count commands
+ * \return status of the operation, SHA204_CMD_FAIL if a command would find TempKey in the wrong state
+ */
+uint8_t sha204s_sequence_init(struct sha204s_sequence *sequence, uint8_t count, const struct sha204s_step *steps)
+{
+	const struct sha204s_step *step;
+	uint8_t source_flag;
+	uint8_t i;
+
+	if (!sequence || !steps || !count || (count > SHA204S_STEPS_MAX))
+		return SHA204_BAD_PARAM;
+
+	// The sequence starts with a Nonce command, which makes TempKey valid.
+	if ((steps[0].opcode != SHA204_NONCE) || (steps[0].param1 > NONCE_MODE_PASSTHROUGH)
+			|| (steps[0].param1 == NONCE_MODE_INVALID))
+		return SHA204_BAD_PARAM;
+	source_flag = (steps[0].param1 == NONCE_MODE_PASSTHROUGH);
+
+	for (i = 1; i < count; i++) {
+		step = &steps[i];
+		switch (step->opcode) {
+		case SHA204_GENDIG:
+			if ((step->param1 != GENDIG_ZONE_OTP) && (step->param1 != GENDIG_ZONE_DATA)
+					&& (step->param1 != GENDIG_ZONE_CONFIG))
+				return SHA204_BAD_PARAM;
+			if ((step->param1 == GENDIG_ZONE_DATA) && (step->param2 > SHA204_KEY_ID_MAX))
+				return SHA204_BAD_PARAM;
+			break;
+
+		case SHA204_MAC:
+			// MAC and HMAC invalidate TempKey, so they end the sequence.
+			if ((i != count - 1) || (step->param1 & ~MAC_MODE_MASK)
+					|| (!(step->param1 & MAC_MODE_BLOCK1_TEMPKEY) && (step->param2 > SHA204_KEY_ID_MAX)))
+				return SHA204_BAD_PARAM;
+			if ((step->param1 & MAC_MODE_USE_TEMPKEY_MASK)
+					&& (!(step->param1 & MAC_MODE_SOURCE_FLAG_MATCH) != !source_flag))
+				return SHA204_CMD_FAIL;
+			break;
+
+		case SHA204_HMAC:
+			if ((i != count - 1) || (step->param1 & ~HMAC_MODE_MASK) || (step->param2 > SHA204_KEY_ID_MAX))
+				return SHA204_BAD_PARAM;
+			if (!(step->param1 & MAC_MODE_SOURCE_FLAG_MATCH) != !source_flag)
+				return SHA204_CMD_FAIL;
+			break;
+
+		default:
+			return SHA204_BAD_PARAM;
+		}
+	}
+
+	sequence->count = count;
+	memcpy(sequence->step, steps, count * sizeof(steps[0]));
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function checks that a device provides all inputs of a sequence.
+ *
+ * \param[in] sequence pointer to checked sequence
+ * \param[in] device pointer to device
+ * \return 1 if all inputs are present, otherwise 0
+ */
+static uint8_t sha204s_device_check(const struct sha204s_sequence *sequence, const struct sha204s_device *device)
+{
+	const struct sha204s_step *step;
+	uint8_t i;
+
+	if (!device->num_in || !device->response
+			|| ((sequence->step[0].param1 != NONCE_MODE_PASSTHROUGH) && !device->rand_out))
+		return 0;
+
+	for (i = 1; i < sequence->count; i++) {
+		step = &sequence->step[i];
+		if (step->opcode == SHA204_GENDIG) {
+			if (step->param1 == GENDIG_ZONE_DATA
+					? !device->slots || !device->slots[step->param2] : !device->stored_value)
+				return 0;
+			continue;
+		}
+		if (((step->param1 & MAC_MODE_INCLUDE_OTP_64) || (step->param1 & MAC_MODE_INCLUDE_OTP_88)) && !device->otp)
+			return 0;
+		if ((step->param1 & MAC_MODE_INCLUDE_SN) && !device->sn)
+			return 0;
+		if ((step->opcode == SHA204_HMAC) || !(step->param1 & MAC_MODE_BLOCK1_TEMPKEY)) {
+			if (!device->slots || !device->slots[step->param2])
+				return 0;
+		}
+		if ((step->opcode == SHA204_MAC) && !(step->param1 & MAC_MODE_BLOCK2_TEMPKEY) && !device->challenge)
+			return 0;
+	}
+
+	return 1;
+}
+
+
+/** \brief This function calculates the results of a group of devices.
+ *
+ * \param[in] sequence pointer to checked sequence
+ * \param[in] count number of devices, 1 to SHA204S_GROUP_SIZE
+ * \param[in] devices array of count devices
+ * \param[in,out] cache midstate caches of the commands
+ */
+static void sha204s_evaluate_group(const struct sha204s_sequence *sequence, uint8_t count,
+		const struct sha204s_device *devices, struct sha204s_midstate (*cache)[SHA204S_CACHE_SIZE])
+{
+	uint8_t temp_key[SHA204S_GROUP_SIZE][SHA204_KEY_SIZE];
+	uint8_t messages[SHA204S_GROUP_SIZE][CRYPTOAUTH_MSG_SIZE_HMAC_INNER];
+	const uint8_t *p_messages[SHA204S_GROUP_SIZE];
+	uint8_t *p_digests[SHA204S_GROUP_SIZE];
+	uint8_t index[SHA204S_GROUP_SIZE];
+	const struct sha204s_step *step = &sequence->step[0];
+	const struct sha204s_midstate *midstate;
+	const struct sha204s_device *device;
+	struct cryptoauth_message_fields fields = {CRYPTOAUTH_LAYOUT_NONCE, step->opcode, step->param1, step->param2,
+			NULL, NULL, NULL, NULL, NULL};
+	uint8_t pad[CRYPTOAUTH_HMAC_BLOCK_SIZE];
+	const uint8_t *key;
+	uint8_t full, i, j, k, s;
+
+	// Nonce: TempKey = SHA-256(RandOut, NumIn, OpCode, Mode, 0), or NumIn in pass-through mode
+	for (i = 0; i < count; i++) {
+		if (step->param1 == NONCE_MODE_PASSTHROUGH) {
+			memcpy(temp_key[i], devices[i].num_in, SHA204_KEY_SIZE);
+			continue;
+		}
+		fields.block1 = devices[i].rand_out;
+		fields.block2 = devices[i].num_in;
+		cryptoauth_message(&fields, messages[i]);
+		p_messages[i] = messages[i];
+		p_digests[i] = temp_key[i];
+	}
+	if (step->param1 != NONCE_MODE_PASSTHROUGH)
+		sha256_batch(count, CRYPTOAUTH_MSG_SIZE_NONCE, p_messages, p_digests);
+
+	for (s = 1; s < sequence->count; s++) {
+		step = &sequence->step[s];
+		fields.opcode = step->opcode;
+		fields.param1 = step->param1;
+		fields.param2 = step->param2;
+		fields.otp = NULL;
+		fields.sn = NULL;
+
+		switch (step->opcode) {
+		case SHA204_GENDIG:
+			// TempKey = SHA-256(stored value, OpCode, Zone, KeyId, SN, zeros, TempKey)
+			for (i = 0, full = 0; i < count; i++) {
+				key = step->param1 == GENDIG_ZONE_DATA ? devices[i].slots[step->param2] : devices[i].stored_value;
+				midstate = sha204s_cache_lookup(step, cache[s], key);
+				if (midstate) {
+					cryptoauth_key_digest_final(midstate->inner, temp_key[i], temp_key[i]);
+					continue;
+				}
+				fields.layout = CRYPTOAUTH_LAYOUT_KEY;
+				fields.block1 = key;
+				fields.block2 = temp_key[i];
+				cryptoauth_message(&fields, messages[full]);
+				p_messages[full] = messages[full];
+				p_digests[full++] = temp_key[i];
+			}
+			sha256_batch(full, CRYPTOAUTH_MSG_SIZE_KEY, p_messages, p_digests);
+			break;
+
+		case SHA204_MAC:
+			for (i = 0; i < count; i++) {
+				device = &devices[i];
+				fields.layout = CRYPTOAUTH_LAYOUT_MAC;
+				fields.block1 = step->param1 & MAC_MODE_BLOCK1_TEMPKEY ? temp_key[i] : device->slots[step->param2];
+				fields.block2 = step->param1 & MAC_MODE_BLOCK2_TEMPKEY ? temp_key[i] : device->challenge;
+				fields.otp = device->otp;
+				fields.sn = device->sn;
+				cryptoauth_message(&fields, messages[i]);
+				p_messages[i] = messages[i];
+				p_digests[i] = device->response;
+			}
+			sha256_batch(count, CRYPTOAUTH_MSG_SIZE_MAC, p_messages, p_digests);
+			break;
+
+		case SHA204_HMAC:
+			// Inner messages first, in full or from the ipad midstate.
+			for (i = 0, full = 0; i < count; i++) {
+				device = &devices[i];
+				key = device->slots[step->param2];
+				midstate = sha204s_cache_lookup(step, cache[s], key);
+				if (midstate) {
+					cryptoauth_hmac(SHA204_HMAC, step->param1, step->param2, midstate->inner, midstate->outer,
+							temp_key[i], device->otp, device->sn, device->response);
+					continue;
+				}
+				for (j = 0; j < CRYPTOAUTH_HMAC_BLOCK_SIZE; j++)
+					pad[j] = (j < SHA204_KEY_SIZE ? key[j] : 0) ^ 0x36;
+				fields.layout = CRYPTOAUTH_LAYOUT_HMAC_INNER;
+				fields.block1 = pad;
+				fields.block2 = temp_key[i];
+				fields.otp = device->otp;
+				fields.sn = device->sn;
+				cryptoauth_message(&fields, messages[full]);
+				p_messages[full] = messages[full];
+				p_digests[full] = temp_key[i];
+				index[full++] = i;
+			}
+			sha256_batch(full, CRYPTOAUTH_MSG_SIZE_HMAC_INNER, p_messages, p_digests);
+
+			// Outer messages of the devices hashed in full. The inner digest is in TempKey.
+			for (j = 0; j < full; j++) {
+				i = index[j];
+				key = devices[i].slots[step->param2];
+				for (k = 0; k < CRYPTOAUTH_HMAC_BLOCK_SIZE; k++)
+					pad[k] = (k < SHA204_KEY_SIZE ? key[k] : 0) ^ 0x5C;
+				fields.layout = CRYPTOAUTH_LAYOUT_HMAC_OUTER;
+				fields.block1 = pad;
+				fields.block2 = temp_key[i];
+				cryptoauth_message(&fields, messages[j]);
+				p_digests[j] = devices[i].response;
+			}
+			sha256_batch(full, CRYPTOAUTH_MSG_SIZE_HMAC_OUTER, p_messages, p_digests);
+			break;
+		}
+	}
+
+	// Without a MAC or HMAC command, the result is TempKey.
+	step = &sequence->step[sequence->count - 1];
+	if ((step->opcode != SHA204_MAC) && (step->opcode != SHA204_HMAC)) {
+		for (i = 0; i < count; i++)
+			memcpy(devices[i].response, temp_key[i], SHA204_KEY_SIZE);
+	}
+
+	cryptoauth_wipe(temp_key, sizeof(temp_key));
+	cryptoauth_wipe(messages, sizeof(messages));
+	cryptoauth_wipe(pad, sizeof(pad));
+}
+
+
+/** \brief This function calculates the results of a sequence for many devices.
+ *
+ * The devices are processed in groups. All commands of a group are calculated
+ * before the next group starts, so the TempKey values stay in the cache.
+ *
+ * \param[in] sequence pointer to sequence checked by sha204s_sequence_init()
+ * \param[in] count number of devices
+ * \param[in,out] devices array of count devices, their results are written to sha204s_device::response
+ * \return status of the operation, SHA204_BAD_PARAM if a device lacks an input, in which case no result is written
+ */
+uint8_t sha204s_evaluate(const struct sha204s_sequence *sequence, uint32_t count, const struct sha204s_device *devices)
+{
+	static const struct sha204s_midstate empty_entry;
+	struct sha204s_midstate cache[SHA204S_STEPS_MAX][SHA204S_CACHE_SIZE];
+	uint32_t i, group;
+	uint8_t s;
+
+	if (!sequence || !sequence->count || (sequence->count > SHA204S_STEPS_MAX) || (!devices && count))
+		return SHA204_BAD_PARAM;
+	for (i = 0; i < count; i++) {
+		if (!sha204s_device_check(sequence, &devices[i]))
+			return SHA204_BAD_PARAM;
+	}
+
+	for (s = 0; s < SHA204S_STEPS_MAX; s++) {
+		for (i = 0; i < SHA204S_CACHE_SIZE; i++)
+			cache[s][i] = empty_entry;
+	}
+
+	for (i = 0; i < count; i += group) {
+		group = count - i < SHA204S_GROUP_SIZE ? count - i : SHA204S_GROUP_SIZE;
+		sha204s_evaluate_group(sequence, (uint8_t) group, &devices[i], cache);
+	}
+
+	cryptoauth_wipe(cache, sizeof(cache));
+
+	return SHA204_SUCCESS;
+}
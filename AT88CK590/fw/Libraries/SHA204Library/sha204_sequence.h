@@ -0,0 +1,139 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Command Sequence Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#ifndef SHA204_SEQUENCE_H
+#   define SHA204_SEQUENCE_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+
+
+/** \defgroup atsha204_sequence Module 13: Command Sequences
+ *
+ * \brief
+ * Use these functions to calculate the expected result of a whole authentication
+ * flow, for many devices at once. A sequence starts with a Nonce command, followed
+ * by GenDig commands, and optionally ends with a MAC or HMAC command. Its
+ * result is the digest of the last command, or TempKey if the sequence has no MAC
+ * or HMAC command. It is the result of calling sha204h_nonce(), sha204h_gen_dig(),
+ * sha204h_mac() and sha204h_hmac() in this order.
+ *
+ * sha204s_sequence_init() checks the parameters of the commands and the TempKey
+ * flags they require once, instead of once per command and device.
+ * sha204s_evaluate() then calculates the results of many devices without filling
+ * parameter structures or TempKey flags. It hashes the messages of the devices in
+ * the lanes of the multi-buffer SHA-256 module. If a key appears a second time in
+ * the same command of a call, e.g. because all devices share a root key, it hashes
+ * the first message block of that key once and starts from its midstate for every
+ * further device.
+ *
+ * The keys of a device are passed as an array of slot pointers. Devices that share
+ * keys should point to the same buffers, since keys are recognized by their address.
+@{ */
+
+//! maximum number of commands in a sequence
+#define SHA204S_STEPS_MAX            (4)
+
+
+/** \struct sha204s_step
+ *  \brief One command of a sequence.
+ *  \var sha204s_step::opcode
+ *       \brief [in] SHA204_NONCE, SHA204_GENDIG, SHA204_MAC or SHA204_HMAC.
+ *  \var sha204s_step::param1
+ *       \brief [in] Mode or zone parameter of the command.
+ *  \var sha204s_step::param2
+ *       \brief [in] Key id parameter of the command, not used for Nonce.
+ */
+struct sha204s_step {
+	uint8_t opcode;
+	uint8_t param1;
+	uint16_t param2;
+};
+
+
+/** \struct sha204s_sequence
+ *  \brief Checked sequence, created by sha204s_sequence_init().
+ *  \var sha204s_sequence::count
+ *       \brief Number of commands.
+ *  \var sha204s_sequence::step
+ *       \brief Commands in the order they are sent.
+ */
+struct sha204s_sequence {
+	uint8_t count;
+	struct sha204s_step step[SHA204S_STEPS_MAX];
+};
+
+
+/** \struct sha204s_device
+ *  \brief Inputs and result of one device.
+ *  \var sha204s_device::num_in
+ *       \brief [in] NumIn of the Nonce command, 20 bytes, or 32 bytes in pass-through mode.
+ *  \var sha204s_device::rand_out
+ *       \brief [in] 32-byte RandOut of the Nonce command, not used in pass-through mode.
+ *  \var sha204s_device::slots
+ *       \brief [in] Array of SHA204_KEY_COUNT pointers to the 32-byte slots of the device. Only the slots the commands use have to be set.
+ *  \var sha204s_device::stored_value
+ *       \brief [in] 32-byte stored value of a GenDig command over the OTP or configuration zone.
+ *  \var sha204s_device::challenge
+ *       \brief [in] 32-byte challenge of a MAC command whose mode does not take it from TempKey.
+ *  \var sha204s_device::otp
+ *       \brief [in] 11-byte OTP, if the mode of the MAC or HMAC command includes it.
+ *  \var sha204s_device::sn
+ *       \brief [in] 9-byte SN, if the mode of the MAC or HMAC command includes it.
+ *  \var sha204s_device::response
+ *       \brief [out] 32-byte result of the sequence.
+ */
+struct sha204s_device {
+	const uint8_t *num_in;
+	const uint8_t *rand_out;
+	const uint8_t *const *slots;
+	const uint8_t *stored_value;
+	const uint8_t *challenge;
+	const uint8_t *otp;
+	const uint8_t *sn;
+	uint8_t *response;
+};
+
+
+uint8_t sha204s_sequence_init(struct sha204s_sequence *sequence, uint8_t count, const struct sha204s_step *steps);
+uint8_t sha204s_evaluate(const struct sha204s_sequence *sequence, uint32_t count, const struct sha204s_device *devices);
+
+/** @} */
+
+#endif //SHA204_SEQUENCE_H
@@ -0,0 +1,500 @@
+/** \file
+ *  \brief  Multi-Threaded Verification of MAC, HMAC and CheckMac Responses
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdlib.h>                    // needed for calloc()
+#include <pthread.h>                   // needed for the thread pool
+
+#include "sha204_verify.h"             // definitions and declarations for this module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "sha256_batch.h"              // definitions and declarations for the Multi-Buffer SHA-256 module
+#include "cryptoauth_core.h"           // definitions and declarations for the digest calculations
+
+
+/** \brief One thread of the pool and its share of the chunks.
+ *
+ *  The low 32 bits of range are the next chunk the thread verifies itself,
+ *  the high 32 bits are the end of its share. The thread takes chunks from the
+ *  front, other threads steal chunks from the back. Both sides update range
+ *  with a compare-and-swap, so a chunk is never taken twice.
+ */
+struct sha204v_worker {
+	struct sha204v_pool *pool;
+	pthread_t thread;
+	uint64_t range;
+	uint8_t index;
+};
+
+
+/** \brief Thread pool and the batch it currently verifies.
+ *
+ *  The calling thread of sha204v_verify() works as thread 0, so a pool
+ *  of n threads starts n - 1 POSIX threads.
+ */
+struct sha204v_pool {
+	uint8_t threads;
+	pthread_mutex_t mutex;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	uint32_t generation;
+	uint8_t busy;
+	uint8_t shutdown;
+	const struct sha204v_key_table *table;
+	const struct sha204v_record *records;
+	uint32_t count;
+	uint8_t *passed;
+	struct sha204v_worker worker[SHA204V_THREADS_MAX];
+};
+
+
+/** \brief This function initializes an empty key table.
+ *
+ * \param[out] table pointer to key table
+ * \return status of the operation
+ */
+uint8_t sha204v_key_table_init(struct sha204v_key_table *table)
+{
+	if (!table)
+		return SHA204_BAD_PARAM;
+
+	memset(table, 0, sizeof(*table));
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function loads the key of a slot into a key table.
+ *
+ * Besides the key, it stores the padded HMAC key blocks of the slot, so that
+ * the HMAC messages of a batch only have to be copied and not XORed.
+ * Do not load keys while sha204v_verify() uses the table.
+ *
+ * \param[in, out] table pointer to key table
+ * \param[in] key_id slot of the key (0 to 15)
+ * \param[in] key pointer to 32-byte key
+ * \return status of the operation
+ */
+uint8_t sha204v_key_table_load(struct sha204v_key_table *table, uint16_t key_id, const uint8_t *key)
+{
+	uint8_t i;
+
+	if (!table || !key || (key_id > SHA204_KEY_ID_MAX))
+		return SHA204_BAD_PARAM;
+
+	memcpy(table->key[key_id], key, SHA204_KEY_SIZE);
+
+	// Refer to fips-198a.pdf, length Key = 32 bytes, Block size = 512 bits = 64 bytes.
+	for (i = 0; i < 2 * SHA204_KEY_SIZE; i++) {
+		table->ipad[key_id][i] = (i < SHA204_KEY_SIZE ? key[i] : 0) ^ 0x36;
+		table->opad[key_id][i] = (i < SHA204_KEY_SIZE ? key[i] : 0) ^ 0x5C;
+	}
+
+	table->loaded |= (uint16_t) (1 << key_id);
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function checks whether a record can be verified.
+ *
+ * \param[in] table pointer to key table
+ * \param[in] record pointer to record
+ * \return 1 if opcode, mode and key id are supported, 0 if the record fails without hashing
+ */
+static uint8_t sha204v_record_valid(const struct sha204v_key_table *table, const struct sha204v_record *record)
+{
+	if ((record->key_id > SHA204_KEY_ID_MAX) || !(table->loaded & (1 << record->key_id)))
+		return 0;
+
+	switch (record->opcode) {
+	case SHA204_MAC:
+		return !(record->mode & ~MAC_MODE_MASK) && !(record->mode & MAC_MODE_BLOCK1_TEMPKEY);
+
+	case SHA204_HMAC:
+		return !(record->mode & ~HMAC_MODE_MASK);
+
+	case SHA204_CHECKMAC:
+		return !(record->mode & ~CHECKMAC_MODE_MASK) && !(record->mode & CHECKMAC_MODE_BLOCK1_TEMPKEY);
+
+	default:
+		return 0;
+	}
+}
+
+
+/** \brief This function assembles the message of a record.
+ *
+ * MAC and CheckMac messages are CRYPTOAUTH_MSG_SIZE_MAC bytes long, so they are hashed in
+ * the same batch. For HMAC this is the inner message.
+ *
+ * \param[in] table pointer to key table
+ * \param[in] record pointer to record
+ * \param[out] message pointer to message buffer of CRYPTOAUTH_MSG_SIZE_HMAC_INNER bytes
+ */
+static void sha204v_message(const struct sha204v_key_table *table, const struct sha204v_record *record,
+		uint8_t *message)
+{
+	struct cryptoauth_message_fields fields = {CRYPTOAUTH_LAYOUT_MAC, record->opcode, record->mode, record->key_id,
+			table->key[record->key_id], record->challenge, record->otp, record->sn, NULL};
+
+	if (record->opcode == SHA204_HMAC) {
+		fields.layout = CRYPTOAUTH_LAYOUT_HMAC_INNER;
+		fields.block1 = table->ipad[record->key_id];
+	}
+	else if (record->opcode == SHA204_CHECKMAC) {
+		fields.layout = CRYPTOAUTH_LAYOUT_CHECK_MAC;
+		fields.otp = record->mode & CHECKMAC_MODE_INCLUDE_OTP_64 ? record->otp : NULL;
+		fields.other_data = record->other_data;
+	}
+
+	cryptoauth_message(&fields, message);
+}
+
+
+/** \brief This function compares two digests in constant time.
+ *
+ * \param[in] a pointer to first 32-byte digest
+ * \param[in] b pointer to second 32-byte digest
+ * \return 1 if the digests are equal, otherwise 0
+ */
+static uint8_t sha204v_digest_equal(const uint8_t *a, const uint8_t *b)
+{
+	uint8_t diff = 0;
+	uint8_t i;
+
+	for (i = 0; i < SHA204_KEY_SIZE; i++)
+		diff |= a[i] ^ b[i];
+
+	return diff == 0;
+}
+
+
+/** \brief This function verifies one chunk of records.
+ *
+ * The MAC and CheckMac messages of the chunk are hashed in one batch,
+ * the inner and outer HMAC messages in two more.
+ *
+ * \param[in] table pointer to key table
+ * \param[in] records pointer to the first record of the chunk
+ * \param[in] count number of records in the chunk (1 to SHA204V_CHUNK_SIZE)
+ * \param[out] passed pointer to the first byte of the chunk in the result bitmap
+ */
+static void sha204v_verify_chunk(const struct sha204v_key_table *table, const struct sha204v_record *records,
+		uint8_t count, uint8_t *passed)
+{
+	uint8_t messages[SHA204V_CHUNK_SIZE][CRYPTOAUTH_MSG_SIZE_HMAC_INNER];
+	uint8_t digests[SHA204V_CHUNK_SIZE][SHA256_DIGEST_SIZE];
+	const uint8_t *p_messages[SHA204V_CHUNK_SIZE];
+	uint8_t *p_digests[SHA204V_CHUNK_SIZE];
+	uint8_t mac_index[SHA204V_CHUNK_SIZE];
+	uint8_t hmac_index[SHA204V_CHUNK_SIZE];
+	uint8_t mac_count = 0;
+	uint8_t hmac_count = 0;
+	struct cryptoauth_message_fields outer = {CRYPTOAUTH_LAYOUT_HMAC_OUTER, 0, 0, 0, NULL, NULL, NULL, NULL, NULL};
+	const struct sha204v_record *record;
+	uint8_t i;
+
+	memset(passed, 0, (count + 7) / 8);
+
+	// MAC and CheckMac messages fill the buffers from the front, HMAC messages from the back.
+	for (i = 0; i < count; i++) {
+		record = &records[i];
+		if (!sha204v_record_valid(table, record))
+			continue;
+		if (record->opcode == SHA204_HMAC) {
+			hmac_index[hmac_count] = i;
+			sha204v_message(table, record, messages[SHA204V_CHUNK_SIZE - 1 - hmac_count]);
+			hmac_count++;
+		}
+		else {
+			mac_index[mac_count] = i;
+			sha204v_message(table, record, messages[mac_count]);
+			mac_count++;
+		}
+	}
+
+	for (i = 0; i < SHA204V_CHUNK_SIZE; i++) {
+		p_messages[i] = messages[i];
+		p_digests[i] = digests[i];
+	}
+
+	if (mac_count)
+		sha256_batch(mac_count, CRYPTOAUTH_MSG_SIZE_MAC, p_messages, p_digests);
+
+	if (hmac_count) {
+		// H((K0 ^ ipad) : text)
+		sha256_batch(hmac_count, CRYPTOAUTH_MSG_SIZE_HMAC_INNER, &p_messages[SHA204V_CHUNK_SIZE - hmac_count],
+				&p_digests[SHA204V_CHUNK_SIZE - hmac_count]);
+
+		// H((K0 ^ opad) : H((K0 ^ ipad) : text)), message[n] pairs with digest[n]
+		for (i = SHA204V_CHUNK_SIZE - hmac_count; i < SHA204V_CHUNK_SIZE; i++) {
+			record = &records[hmac_index[SHA204V_CHUNK_SIZE - 1 - i]];
+			outer.block1 = table->opad[record->key_id];
+			outer.block2 = digests[i];
+			cryptoauth_message(&outer, messages[i]);
+		}
+		sha256_batch(hmac_count, CRYPTOAUTH_MSG_SIZE_HMAC_OUTER, &p_messages[SHA204V_CHUNK_SIZE - hmac_count],
+				&p_digests[SHA204V_CHUNK_SIZE - hmac_count]);
+	}
+
+	for (i = 0; i < mac_count; i++) {
+		if (sha204v_digest_equal(digests[i], records[mac_index[i]].response))
+			passed[mac_index[i] >> 3] |= (uint8_t) (1 << (mac_index[i] & 7));
+	}
+	for (i = 0; i < hmac_count; i++) {
+		if (sha204v_digest_equal(digests[SHA204V_CHUNK_SIZE - 1 - i], records[hmac_index[i]].response))
+			passed[hmac_index[i] >> 3] |= (uint8_t) (1 << (hmac_index[i] & 7));
+	}
+}
+
+
+/** \brief This function takes a chunk from the share of a thread.
+ *
+ * \param[in, out] worker pointer to the thread whose share the chunk is taken from
+ * \param[in] steal 0 to take the first chunk (own share), 1 to take the last chunk (other share)
+ * \param[out] chunk pointer to the index of the chunk taken
+ * \return 1 if a chunk was taken, 0 if the share is empty
+ */
+static uint8_t sha204v_take_chunk(struct sha204v_worker *worker, uint8_t steal, uint32_t *chunk)
+{
+	uint64_t range = __atomic_load_n(&worker->range, __ATOMIC_RELAXED);
+	uint64_t next;
+	uint32_t head, tail;
+
+	do {
+		head = (uint32_t) range;
+		tail = (uint32_t) (range >> 32);
+		if (head >= tail)
+			return 0;
+		if (steal)
+			*chunk = --tail;
+		else
+			*chunk = head++;
+		next = ((uint64_t) tail << 32) | head;
+	} while (!__atomic_compare_exchange_n(&worker->range, &range, next, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	return 1;
+}
+
+
+/** \brief This function verifies chunks until no thread has any left.
+ *
+ * \param[in, out] worker pointer to the thread that runs this function
+ */
+static void sha204v_work(struct sha204v_worker *worker)
+{
+	struct sha204v_pool *pool = worker->pool;
+	uint32_t chunk = 0;
+	uint32_t first;
+	uint8_t victim = worker->index;
+	uint8_t i;
+
+	for (;;) {
+		if (!sha204v_take_chunk(&pool->worker[victim], victim != worker->index, &chunk)) {
+			// The current share is empty. Look for a thread that still has chunks.
+			for (i = 1; i < pool->threads; i++) {
+				victim = (uint8_t) ((worker->index + i) % pool->threads);
+				if (sha204v_take_chunk(&pool->worker[victim], 1, &chunk))
+					break;
+			}
+			if (i == pool->threads)
+				return;
+		}
+
+		first = chunk * SHA204V_CHUNK_SIZE;
+		sha204v_verify_chunk(pool->table, &pool->records[first],
+				(uint8_t) (pool->count - first < SHA204V_CHUNK_SIZE ? pool->count - first : SHA204V_CHUNK_SIZE),
+				&pool->passed[first / 8]);
+	}
+}
+
+
+/** \brief This function is the main function of the POSIX threads of a pool.
+ *
+ * It sleeps until sha204v_verify() starts a new batch or sha204v_pool_destroy() shuts the pool down.
+ *
+ * \param[in] arg pointer to the sha204v_worker structure of the thread
+ * \return NULL
+ */
+static void *sha204v_thread(void *arg)
+{
+	struct sha204v_worker *worker = (struct sha204v_worker *) arg;
+	struct sha204v_pool *pool = worker->pool;
+	uint32_t generation = 0;
+
+	pthread_mutex_lock(&pool->mutex);
+	for (;;) {
+		while (pool->generation == generation && !pool->shutdown)
+			pthread_cond_wait(&pool->start, &pool->mutex);
+		if (pool->shutdown)
+			break;
+		generation = pool->generation;
+		pthread_mutex_unlock(&pool->mutex);
+
+		sha204v_work(worker);
+
+		pthread_mutex_lock(&pool->mutex);
+		if (--pool->busy == 0)
+			pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->mutex);
+
+	return NULL;
+}
+
+
+/** \brief This function creates a thread pool.
+ *
+ * \param[in] threads number of threads (1 to SHA204V_THREADS_MAX), including the thread that calls sha204v_verify()
+ * \param[out] pool pointer to the created pool
+ * \return status of the operation
+ */
+uint8_t sha204v_pool_create(uint8_t threads, struct sha204v_pool **pool)
+{
+	struct sha204v_pool *new_pool;
+	uint8_t i;
+
+	if (!pool || !threads || (threads > SHA204V_THREADS_MAX))
+		return SHA204_BAD_PARAM;
+
+	new_pool = (struct sha204v_pool *) calloc(1, sizeof(*new_pool));
+	if (!new_pool)
+		return SHA204_FUNC_FAIL;
+
+	new_pool->threads = threads;
+	pthread_mutex_init(&new_pool->mutex, NULL);
+	pthread_cond_init(&new_pool->start, NULL);
+	pthread_cond_init(&new_pool->done, NULL);
+
+	for (i = 0; i < threads; i++) {
+		new_pool->worker[i].pool = new_pool;
+		new_pool->worker[i].index = i;
+		if (i && pthread_create(&new_pool->worker[i].thread, NULL, sha204v_thread, &new_pool->worker[i])) {
+			new_pool->threads = i;
+			sha204v_pool_destroy(new_pool);
+			return SHA204_FUNC_FAIL;
+		}
+	}
+
+	*pool = new_pool;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function stops the threads of a pool and frees it.
+ *
+ * \param[in] pool pointer to pool, created by sha204v_pool_create()
+ */
+void sha204v_pool_destroy(struct sha204v_pool *pool)
+{
+	uint8_t i;
+
+	if (!pool)
+		return;
+
+	pthread_mutex_lock(&pool->mutex);
+	pool->shutdown = 1;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->mutex);
+
+	for (i = 1; i < pool->threads; i++)
+		pthread_join(pool->worker[i].thread, NULL);
+
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->start);
+	pthread_mutex_destroy(&pool->mutex);
+	free(pool);
+}
+
+
+/** \brief This function verifies a batch of client responses.
+ *
+ * For every record, it calculates the digest the client device calculates when it
+ * executes the MAC or HMAC command, or the ClientResp a CheckMac command expects,
+ * and compares it with the response of the record.
+ * Records with an unsupported opcode or mode, or with a key id whose key is not
+ * loaded, fail.
+ * Only one batch at a time can be verified by a pool.
+ *
+ * \param[in] pool pointer to pool, created by sha204v_pool_create()
+ * \param[in] table pointer to key table
+ * \param[in] count number of records
+ * \param[in] records pointer to array of records
+ * \param[out] passed pointer to result bitmap of (count + 7) / 8 bytes. Bit (n % 8) of byte (n / 8) is set if record n passed.
+ * \return status of the operation
+ */
+uint8_t sha204v_verify(struct sha204v_pool *pool, const struct sha204v_key_table *table,
+		uint32_t count, const struct sha204v_record *records, uint8_t *passed)
+{
+	uint32_t chunks, share, first, end;
+	uint8_t i;
+
+	if (!pool || !table || !records || !passed)
+		return SHA204_BAD_PARAM;
+
+	// Deal the chunks out in contiguous shares.
+	chunks = (count + SHA204V_CHUNK_SIZE - 1) / SHA204V_CHUNK_SIZE;
+	share = chunks / pool->threads;
+	for (i = 0, first = 0; i < pool->threads; i++) {
+		end = first + share + (i < chunks % pool->threads ? 1 : 0);
+		pool->worker[i].range = ((uint64_t) end << 32) | first;
+		first = end;
+	}
+
+	pthread_mutex_lock(&pool->mutex);
+	pool->table = table;
+	pool->records = records;
+	pool->count = count;
+	pool->passed = passed;
+	pool->busy = pool->threads - 1;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->mutex);
+
+	sha204v_work(&pool->worker[0]);
+
+	// Wait until the other threads finished the chunks they took.
+	pthread_mutex_lock(&pool->mutex);
+	while (pool->busy)
+		pthread_cond_wait(&pool->done, &pool->mutex);
+	pthread_mutex_unlock(&pool->mutex);
+
+	return SHA204_SUCCESS;
+}
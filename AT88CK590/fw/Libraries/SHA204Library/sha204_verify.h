@@ -0,0 +1,138 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Multi-Threaded Verification Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#ifndef SHA204_VERIFY_H
+#   define SHA204_VERIFY_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+
+
+/** \defgroup atsha204_verify Module 09: Multi-Threaded Verification
+ *
+ * \brief
+ * Use these functions on a server that verifies the MAC, HMAC and CheckMac responses
+ * of many ATSHA204 client devices. A batch of records is split into chunks that are
+ * distributed across a pool of POSIX threads. A thread that runs out of chunks steals
+ * chunks from the other threads. Inside a chunk, the messages are hashed in parallel
+ * by the multi-buffer kernels of the SHA-256 batch module.
+ *
+ * The keys are not part of the records. They are loaded once into a key table
+ * and looked up by the key id of every record.
+ *
+ * This module needs POSIX threads, so it is meant for hosts and not for firmware.
+@{ */
+
+//! maximum number of threads in a pool
+#define SHA204V_THREADS_MAX         (64)
+
+//! number of records a thread verifies at a time, a multiple of eight, so that chunks do not share bytes of the result bitmap
+#define SHA204V_CHUNK_SIZE          (16)
+
+//! size of the OTP bytes a MAC or HMAC message can include
+#define SHA204V_OTP_SIZE            (11)
+
+//! size of the serial number
+#define SHA204V_SN_SIZE              (9)
+
+
+/** \struct sha204v_key_table
+ *  \brief Keys of the client devices, indexed by key id.
+ *  \var sha204v_key_table::key
+ *       \brief The 32-byte key of every slot.
+ *  \var sha204v_key_table::ipad
+ *       \brief (K0 ^ ipad) block of every slot, the start of the inner HMAC message.
+ *  \var sha204v_key_table::opad
+ *       \brief (K0 ^ opad) block of every slot, the start of the outer HMAC message.
+ *  \var sha204v_key_table::loaded
+ *       \brief Bit n is set if the key of slot n is loaded.
+ */
+struct sha204v_key_table {
+	uint8_t key[SHA204_KEY_COUNT][SHA204_KEY_SIZE];
+	uint8_t ipad[SHA204_KEY_COUNT][2 * SHA204_KEY_SIZE];
+	uint8_t opad[SHA204_KEY_COUNT][2 * SHA204_KEY_SIZE];
+	uint16_t loaded;
+};
+
+
+/** \struct sha204v_record
+ *  \brief One client response to be verified.
+ *  \var sha204v_record::opcode
+ *       \brief [in] Command that generated the response: SHA204_MAC, SHA204_HMAC or SHA204_CHECKMAC.
+ *  \var sha204v_record::mode
+ *       \brief [in] Mode parameter of the command (Param1). Modes with the first SHA block from TempKey are not supported.
+ *  \var sha204v_record::key_id
+ *       \brief [in] KeyID parameter of the command (Param2). It selects the key in the key table.
+ *  \var sha204v_record::challenge
+ *       \brief [in] Second SHA block: the challenge, or TempKey if the mode selects it. HMAC always uses TempKey.
+ *  \var sha204v_record::otp
+ *       \brief [in] 11-byte OTP, included depending on mode.
+ *  \var sha204v_record::sn
+ *       \brief [in] 9-byte SN, included depending on mode. Not used by CheckMac.
+ *  \var sha204v_record::other_data
+ *       \brief [in] 13 bytes of OtherData. Only used by CheckMac.
+ *  \var sha204v_record::response
+ *       \brief [in] 32-byte response of the client to be verified.
+ */
+struct sha204v_record {
+	uint8_t opcode;
+	uint8_t mode;
+	uint16_t key_id;
+	uint8_t challenge[SHA204_KEY_SIZE];
+	uint8_t otp[SHA204V_OTP_SIZE];
+	uint8_t sn[SHA204V_SN_SIZE];
+	uint8_t other_data[CHECKMAC_OTHER_DATA_SIZE];
+	uint8_t response[SHA204_KEY_SIZE];
+};
+
+
+//! opaque thread pool, created by sha204v_pool_create()
+struct sha204v_pool;
+
+
+uint8_t sha204v_key_table_init(struct sha204v_key_table *table);
+uint8_t sha204v_key_table_load(struct sha204v_key_table *table, uint16_t key_id, const uint8_t *key);
+uint8_t sha204v_pool_create(uint8_t threads, struct sha204v_pool **pool);
+void sha204v_pool_destroy(struct sha204v_pool *pool);
+uint8_t sha204v_verify(struct sha204v_pool *pool, const struct sha204v_key_table *table,
+		uint32_t count, const struct sha204v_record *records, uint8_t *passed);
+
+/** @} */
+
+#endif //SHA204_VERIFY_H
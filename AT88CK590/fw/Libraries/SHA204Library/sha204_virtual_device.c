@@ -0,0 +1,1227 @@
+/** \file
+ *  \brief  ATSHA204 Virtual Device
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+
+#include "sha204_virtual_device.h"     // definitions and declarations for the Virtual Device module
+#include "sha204_physical.h"           // declarations that are common to all interface implementations
+#include "sha204_comm.h"               // definitions of status bytes and packet sizes
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "cryptoauth_core.h"           // definitions and declarations for the digest calculations
+#include "timer_utilities_host.h"      // definitions for delay functions and the virtual clock
+
+
+/** \ingroup atsha204_virtual_device
+@{ */
+
+//! revision a virtual device reports in RevNum and with the DevRev command
+static const uint8_t sha204d_revision[] = {0x00, 0x00, 0x00, 0x09};
+
+//! serial number of a device initialized without one
+static const uint8_t sha204d_sn_default[SHA204D_SN_SIZE] = {0x01, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEE};
+
+//! attached devices and their IDs
+static struct {
+	uint8_t id;
+	struct sha204d_device *device;
+} sha204d_devices[SHA204D_DEVICES_MAX];
+
+//! ID of the device the physical layer functions address, set by #sha204p_init or #sha204p_set_device_id
+static uint8_t sha204d_device_id = SHA204D_DEFAULT_ID;
+
+//! fault injector of the bus, set by #sha204d_set_fault_injector
+static struct fault_injector *sha204d_faults;
+
+//! whether the selected device lost synchronization and sends 0xFF
+static uint8_t sha204d_sync_lost;
+
+
+/** \brief This function initializes a virtual device to its state as shipped.
+ *
+ * All zones are unlocked. The data and OTP zones are erased to 0xFF. Every slot
+ * has a SlotConfig of 0, so it can be read and written in the clear, and the
+ * OTP mode is read-only. The device is asleep.
+ * \param[out] device pointer to device
+ * \param[in] sn pointer to 9-byte serial number, or NULL for 01 23 00 00 00 00 00 00 EE
+ * \param[in] seed pointer to 32-byte seed of the random number generator, or NULL for zeros
+ */
+void sha204d_device_init(struct sha204d_device *device, const uint8_t *sn, const uint8_t *seed)
+{
+	if (!sn)
+		sn = sha204d_sn_default;
+
+	memset(device, 0, sizeof(*device));
+	memcpy(&device->config[0], &sn[0], 4);
+	memcpy(&device->config[SHA204D_CONFIG_REVISION], sha204d_revision, sizeof(sha204d_revision));
+	memcpy(&device->config[SHA204D_CONFIG_SN_4], &sn[4], SHA204D_SN_SIZE - 4);
+	device->config[SHA204D_CONFIG_I2C_ADDRESS] = SHA204D_DEFAULT_ID;
+	device->config[SHA204D_CONFIG_OTP_MODE] = SHA204D_OTP_MODE_READ_ONLY;
+	device->config[SHA204D_CONFIG_LOCK_VALUE] = SHA204D_UNLOCKED;
+	device->config[SHA204D_CONFIG_LOCK_CONFIG] = SHA204D_UNLOCKED;
+	memset(device->otp, 0xFF, sizeof(device->otp));
+	memset(device->data, 0xFF, sizeof(device->data));
+	if (seed)
+		memcpy(device->seed, seed, sizeof(device->seed));
+	device->state = SHA204D_STATE_SLEEP;
+}
+
+
+/** \brief This function attaches a device under an ID, or detaches the device with this ID.
+ * \param[in] id device ID, as passed to sha204p_set_device_id()
+ * \param[in] device pointer to initialized device, NULL to detach
+ * \return status of the operation
+ */
+uint8_t sha204d_attach(uint8_t id, struct sha204d_device *device)
+{
+	uint8_t i;
+	uint8_t free_entry = SHA204D_DEVICES_MAX;
+
+	for (i = 0; i < SHA204D_DEVICES_MAX; i++) {
+		if (sha204d_devices[i].device && (sha204d_devices[i].id == id)) {
+			sha204d_devices[i].device = device;
+			return SHA204_SUCCESS;
+		}
+		if (!sha204d_devices[i].device && (free_entry == SHA204D_DEVICES_MAX))
+			free_entry = i;
+	}
+	if (!device)
+		return SHA204_SUCCESS;
+	if (free_entry == SHA204D_DEVICES_MAX)
+		return SHA204_FUNC_FAIL;
+
+	sha204d_devices[free_entry].id = id;
+	sha204d_devices[free_entry].device = device;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function returns the device attached under an ID.
+ * \param[in] id device ID
+ * \return pointer to device, NULL if none is attached
+ */
+struct sha204d_device *sha204d_get_device(uint8_t id)
+{
+	uint8_t i;
+
+	for (i = 0; i < SHA204D_DEVICES_MAX; i++)
+		if (sha204d_devices[i].device && (sha204d_devices[i].id == id))
+			return sha204d_devices[i].device;
+
+	return NULL;
+}
+
+
+/** \brief This function places a fault injector between the Communication layer and the devices.
+ * \param[in] injector pointer to injector, NULL to stop injecting faults
+ */
+void sha204d_set_fault_injector(struct fault_injector *injector)
+{
+	sha204d_faults = injector;
+	sha204d_sync_lost = 0;
+}
+
+
+/** \brief This function returns the SlotConfig of a slot.
+ * \param[in] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \return SlotConfig
+ */
+uint16_t sha204d_get_slot_config(const struct sha204d_device *device, uint8_t key_id)
+{
+	const uint8_t *slot_config = &device->config[SHA204D_CONFIG_SLOT_CONFIG + 2 * key_id];
+
+	return slot_config[0] | ((uint16_t) slot_config[1] << 8);
+}
+
+
+/** \brief This function sets the SlotConfig of a slot.
+ *
+ * Use it to personalize a device before locking its configuration zone,
+ * instead of writing the configuration zone with Write commands.
+ * \param[in,out] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \param[in] slot_config SlotConfig
+ */
+void sha204d_set_slot_config(struct sha204d_device *device, uint8_t key_id, uint16_t slot_config)
+{
+	device->config[SHA204D_CONFIG_SLOT_CONFIG + 2 * key_id] = slot_config & 0xFF;
+	device->config[SHA204D_CONFIG_SLOT_CONFIG + 2 * key_id + 1] = slot_config >> 8;
+}
+
+
+/** \brief This function places a response with data into the output buffer.
+ * \param[in,out] device pointer to device
+ * \param[in] size number of data bytes
+ * \param[in] data pointer to data
+ */
+static void sha204d_respond(struct sha204d_device *device, uint8_t size, const uint8_t *data)
+{
+	uint8_t count = size + SHA204_PACKET_OVERHEAD;
+
+	device->response[SHA204_BUFFER_POS_COUNT] = count;
+	memcpy(&device->response[SHA204_BUFFER_POS_DATA], data, size);
+	device->response[count - SHA204_CRC_SIZE] = 0;
+	device->response[count - 1] = 0;
+	sha204h_calculate_crc_chain(count - SHA204_CRC_SIZE, device->response, &device->response[count - SHA204_CRC_SIZE]);
+}
+
+
+/** \brief This function places a status response into the output buffer.
+ * \param[in,out] device pointer to device
+ * \param[in] status status byte
+ */
+static void sha204d_respond_status(struct sha204d_device *device, uint8_t status)
+{
+	sha204d_respond(device, 1, &status);
+}
+
+
+/** \brief This function translates a return code of the Helper module into a status byte.
+ * \param[in] ret_code return code of a sha204h_* function
+ * \return status byte
+ */
+static uint8_t sha204d_status(uint8_t ret_code)
+{
+	if (ret_code == SHA204_SUCCESS)
+		return SHA204D_STATUS_BYTE_SUCCESS;
+	if (ret_code == SHA204_CMD_FAIL)
+		return SHA204_STATUS_BYTE_EXEC;
+
+	return SHA204_STATUS_BYTE_PARSE;
+}
+
+
+/** \brief This function invalidates TempKey and returns the execution error status byte.
+ * \param[in,out] device pointer to device
+ * \return #SHA204_STATUS_BYTE_EXEC
+ */
+static uint8_t sha204d_fail(struct sha204d_device *device)
+{
+	device->temp_key.valid = 0;
+
+	return SHA204_STATUS_BYTE_EXEC;
+}
+
+
+//! This function returns whether the configuration zone is locked.
+static uint8_t sha204d_config_locked(const struct sha204d_device *device)
+{
+	return device->config[SHA204D_CONFIG_LOCK_CONFIG] != SHA204D_UNLOCKED;
+}
+
+
+//! This function returns whether the data and OTP zones are locked.
+static uint8_t sha204d_data_locked(const struct sha204d_device *device)
+{
+	return device->config[SHA204D_CONFIG_LOCK_VALUE] != SHA204D_UNLOCKED;
+}
+
+
+/** \brief This function assembles the 9-byte serial number from the configuration zone.
+ * \param[in] device pointer to device
+ * \param[out] sn pointer to 9-byte buffer
+ */
+static void sha204d_get_sn(const struct sha204d_device *device, uint8_t *sn)
+{
+	memcpy(&sn[0], &device->config[0], 4);
+	memcpy(&sn[4], &device->config[SHA204D_CONFIG_SN_4], SHA204D_SN_SIZE - 4);
+}
+
+
+/** \brief This function returns a 32-byte slot of the data zone.
+ * \param[in] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \return pointer to slot
+ */
+static uint8_t *sha204d_slot(struct sha204d_device *device, uint16_t key_id)
+{
+	return &device->data[key_id * SHA204_KEY_SIZE];
+}
+
+
+/** \brief This function generates a random number.
+ *
+ * As long as the configuration zone is not locked, the device returns
+ * the fixed pattern FF FF 00 00 instead.
+ * \param[in,out] device pointer to device
+ * \param[in] update_seed whether to update the seed after generating the number
+ * \param[out] random pointer to 32-byte buffer
+ */
+static void sha204d_random(struct sha204d_device *device, uint8_t update_seed, uint8_t *random)
+{
+	uint8_t message[SHA204_KEY_SIZE + 5];
+	uint8_t i;
+
+	if (!sha204d_config_locked(device)) {
+		for (i = 0; i < SHA204_KEY_SIZE; i++)
+			random[i] = (i & 2) ? 0x00 : 0xFF;
+		return;
+	}
+
+	// Seed{32} || count{4} || 0 gives the number, Seed{32} || count{4} || 1 the next seed.
+	memcpy(message, device->seed, SHA204_KEY_SIZE);
+	message[SHA204_KEY_SIZE] = device->random_count & 0xFF;
+	message[SHA204_KEY_SIZE + 1] = (device->random_count >> 8) & 0xFF;
+	message[SHA204_KEY_SIZE + 2] = (device->random_count >> 16) & 0xFF;
+	message[SHA204_KEY_SIZE + 3] = (device->random_count >> 24) & 0xFF;
+	message[SHA204_KEY_SIZE + 4] = 0;
+	sha204h_calculate_sha256(sizeof(message), message, random);
+	device->random_count++;
+
+	if (update_seed) {
+		message[SHA204_KEY_SIZE + 4] = 1;
+		sha204h_calculate_sha256(sizeof(message), message, device->seed);
+	}
+}
+
+
+/** \brief This function returns the location of a Read or Write access.
+ * \param[in] device pointer to device
+ * \param[in] zone zone parameter of the command
+ * \param[in] address word address parameter of the command
+ * \param[in] size number of bytes accessed (4 or 32)
+ * \return pointer to the first byte, NULL if the access exceeds the zone
+ */
+static uint8_t *sha204d_locate(struct sha204d_device *device, uint8_t zone, uint16_t address, uint8_t size)
+{
+	uint16_t offset = address * SHA204_ZONE_ACCESS_4;
+	uint16_t zone_size;
+	uint8_t *base;
+
+	// A 32-byte access starts at the beginning of the block that contains the word.
+	if (size == SHA204_ZONE_ACCESS_32)
+		offset &= ~(SHA204_ZONE_ACCESS_32 - 1);
+
+	switch (zone & SHA204_ZONE_MASK) {
+	case SHA204_ZONE_CONFIG:
+		base = device->config;
+		zone_size = SHA204_CONFIG_SIZE;
+		break;
+
+	case SHA204_ZONE_OTP:
+		base = device->otp;
+		zone_size = SHA204_OTP_SIZE;
+		break;
+
+	case SHA204_ZONE_DATA:
+		base = device->data;
+		zone_size = SHA204_DATA_SIZE;
+		break;
+
+	default:
+		return NULL;
+	}
+
+	if ((address & ~SHA204_ADDRESS_MASK) || (offset + size > zone_size))
+		return NULL;
+
+	return &base[offset];
+}
+
+
+/** \brief This function executes a Nonce command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t sha204d_nonce(struct sha204d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct sha204h_nonce_in_out param;
+	uint8_t mode = command[NONCE_MODE_IDX];
+
+	if (mode == NONCE_MODE_PASSTHROUGH) {
+		if (count != NONCE_COUNT_LONG)
+			return SHA204_STATUS_BYTE_PARSE;
+	}
+	else if ((mode & ~NONCE_MODE_MASK) || (mode == NONCE_MODE_INVALID) || (count != NONCE_COUNT_SHORT))
+		return SHA204_STATUS_BYTE_PARSE;
+
+	param.mode = mode;
+	param.num_in = &command[NONCE_INPUT_IDX];
+	param.rand_out = data;
+	param.temp_key = &device->temp_key;
+	if (mode != NONCE_MODE_PASSTHROUGH) {
+		sha204d_random(device, mode == NONCE_MODE_SEED_UPDATE, data);
+		*size = SHA204_KEY_SIZE;
+	}
+
+	return sha204d_status(sha204h_nonce(&param));
+}
+
+
+/** \brief This function executes a GenDig command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t sha204d_gen_dig(struct sha204d_device *device, uint8_t count, uint8_t *command)
+{
+	struct sha204h_gen_dig_in_out param;
+	uint8_t stored_value[SHA204_KEY_SIZE];
+	uint8_t zone = command[GENDIG_ZONE_IDX];
+	uint16_t key_id = command[GENDIG_KEYID_IDX] | ((uint16_t) command[GENDIG_KEYID_IDX + 1] << 8);
+
+	if (count != GENDIG_COUNT)
+		return SHA204_STATUS_BYTE_PARSE;
+
+	switch (zone) {
+	case GENDIG_ZONE_CONFIG:
+		// The last block of the configuration zone is padded with zeros.
+		if (key_id * SHA204_KEY_SIZE >= SHA204_CONFIG_SIZE)
+			return SHA204_STATUS_BYTE_PARSE;
+		memset(stored_value, 0, sizeof(stored_value));
+		memcpy(stored_value, &device->config[key_id * SHA204_KEY_SIZE],
+				key_id * SHA204_KEY_SIZE + SHA204_KEY_SIZE > SHA204_CONFIG_SIZE
+				? SHA204_CONFIG_SIZE - key_id * SHA204_KEY_SIZE : SHA204_KEY_SIZE);
+		param.stored_value = stored_value;
+		break;
+
+	case GENDIG_ZONE_OTP:
+		if (key_id > SHA204_OTP_BLOCK_MAX)
+			return SHA204_STATUS_BYTE_PARSE;
+		param.stored_value = &device->otp[key_id * SHA204_KEY_SIZE];
+		break;
+
+	case GENDIG_ZONE_DATA:
+		if (key_id > SHA204_KEY_ID_MAX)
+			return SHA204_STATUS_BYTE_PARSE;
+		param.stored_value = sha204d_slot(device, key_id);
+		break;
+
+	default:
+		return SHA204_STATUS_BYTE_PARSE;
+	}
+
+	param.zone = zone;
+	param.key_id = key_id;
+	param.temp_key = &device->temp_key;
+
+	return sha204d_status(sha204h_gen_dig(&param));
+}
+
+
+/** \brief This function executes a MAC command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t sha204d_mac(struct sha204d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct sha204h_mac_in_out param;
+	uint8_t sn[SHA204D_SN_SIZE];
+	uint8_t mode = command[MAC_MODE_IDX];
+	uint16_t key_id = command[MAC_KEYID_IDX] | ((uint16_t) command[MAC_KEYID_IDX + 1] << 8);
+
+	if ((mode & ~MAC_MODE_MASK) || (key_id > SHA204_KEY_ID_MAX))
+		return SHA204_STATUS_BYTE_PARSE;
+
+	// The challenge is only sent if the second SHA block does not come from TempKey.
+	if (count == MAC_COUNT_LONG)
+		param.challenge = &command[MAC_CHALLENGE_IDX];
+	else if ((count == MAC_COUNT_SHORT) && (mode & MAC_MODE_BLOCK2_TEMPKEY))
+		param.challenge = NULL;
+	else
+		return SHA204_STATUS_BYTE_PARSE;
+
+	if (!(mode & MAC_MODE_BLOCK1_TEMPKEY) && (sha204d_get_slot_config(device, key_id) & SHA204D_SLOT_CHECK_ONLY))
+		return sha204d_fail(device);
+
+	sha204d_get_sn(device, sn);
+	param.mode = mode;
+	param.key_id = key_id;
+	param.key = sha204d_slot(device, key_id);
+	param.otp = device->otp;
+	param.sn = sn;
+	param.response = data;
+	param.temp_key = &device->temp_key;
+	*size = SHA204_KEY_SIZE;
+
+	return sha204d_status(sha204h_mac(&param));
+}
+
+
+/** \brief This function executes an HMAC command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t sha204d_hmac(struct sha204d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct sha204h_hmac_in_out param;
+	uint8_t sn[SHA204D_SN_SIZE];
+	uint8_t mode = command[HMAC_MODE_IDX];
+	uint16_t key_id = command[HMAC_KEYID_IDX] | ((uint16_t) command[HMAC_KEYID_IDX + 1] << 8);
+
+	if ((count != HMAC_COUNT) || (mode & ~HMAC_MODE_MASK) || (key_id > SHA204_KEY_ID_MAX))
+		return SHA204_STATUS_BYTE_PARSE;
+
+	if (sha204d_get_slot_config(device, key_id) & SHA204D_SLOT_CHECK_ONLY)
+		return sha204d_fail(device);
+
+	sha204d_get_sn(device, sn);
+	param.mode = mode;
+	param.key_id = key_id;
+	param.key = sha204d_slot(device, key_id);
+	param.otp = device->otp;
+	param.sn = sn;
+	param.response = data;
+	param.temp_key = &device->temp_key;
+	*size = SHA204_KEY_SIZE;
+
+	return sha204d_status(sha204h_hmac(&param));
+}
+
+
+/** \brief This function executes a CheckMac command.
+ *
+ * If the response matches and the command has the form sha204h_check_mac() calculates,
+ * i.e. the second SHA block comes from a random TempKey, the device copies the target
+ * slot into TempKey: the password slot itself if its number is odd, otherwise the next one.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t sha204d_check_mac(struct sha204d_device *device, uint8_t count, uint8_t *command)
+{
+	struct sha204h_temp_key *temp_key = &device->temp_key;
+	uint8_t digest[SHA204_KEY_SIZE];
+	uint8_t mode = command[CHECKMAC_MODE_IDX];
+	uint16_t key_id = command[CHECKMAC_KEYID_IDX] | ((uint16_t) command[CHECKMAC_KEYID_IDX + 1] << 8);
+
+	if ((count != CHECKMAC_COUNT) || (mode & ~CHECKMAC_MODE_MASK) || (key_id > SHA204_KEY_ID_MAX))
+		return SHA204_STATUS_BYTE_PARSE;
+
+	// Check TempKey if it is used, the same way sha204h_mac() does.
+	if ((mode & MAC_MODE_USE_TEMPKEY_MASK)
+			&& (temp_key->check_flag || !temp_key->valid
+			|| (!(mode & CHECKMAC_MODE_SOURCE_FLAG_MATCH) != !temp_key->source_flag)))
+		return sha204d_fail(device);
+
+	cryptoauth_check_mac(
+			mode & CHECKMAC_MODE_BLOCK1_TEMPKEY ? temp_key->value : sha204d_slot(device, key_id),
+			mode & CHECKMAC_MODE_BLOCK2_TEMPKEY ? temp_key->value : &command[CHECKMAC_CLIENT_CHALLENGE_IDX],
+			&command[CHECKMAC_DATA_IDX], mode & CHECKMAC_MODE_INCLUDE_OTP_64 ? device->otp : NULL, digest);
+
+	if (memcmp(digest, &command[CHECKMAC_CLIENT_RESPONSE_IDX], sizeof(digest))) {
+		temp_key->valid = 0;
+		return SHA204D_STATUS_BYTE_CHECKMAC;
+	}
+
+	if ((mode & (MAC_MODE_USE_TEMPKEY_MASK | CHECKMAC_MODE_SOURCE_FLAG_MATCH)) == CHECKMAC_MODE_BLOCK2_TEMPKEY) {
+		memcpy(temp_key->value, sha204d_slot(device, key_id | 1), SHA204_KEY_SIZE);
+		temp_key->gen_data = 0;
+		temp_key->source_flag = 1;
+		temp_key->valid = 1;
+	}
+	else
+		temp_key->valid = 0;
+
+	return SHA204D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a DeriveKey command.
+ *
+ * The parent key is the slot WriteKey points to if SlotConfig[TargetKey] selects
+ * Create, and the target slot itself (Roll) otherwise.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t sha204d_derive_key(struct sha204d_device *device, uint8_t count, uint8_t *command)
+{
+	struct sha204h_derive_key_in_out param;
+	struct sha204h_derive_key_mac_in_out mac_param;
+	uint8_t mac[DERIVE_KEY_MAC_SIZE];
+	uint8_t random = command[DERIVE_KEY_RANDOM_IDX];
+	uint16_t target = command[DERIVE_KEY_TARGETKEY_IDX] | ((uint16_t) command[DERIVE_KEY_TARGETKEY_IDX + 1] << 8);
+	uint16_t slot_config;
+
+	if ((random & ~DERIVE_KEY_RANDOM_FLAG) || (target > SHA204_KEY_ID_MAX)
+			|| ((count != DERIVE_KEY_COUNT_SMALL) && (count != DERIVE_KEY_COUNT_LARGE)))
+		return SHA204_STATUS_BYTE_PARSE;
+
+	slot_config = sha204d_get_slot_config(device, target);
+	if (!(slot_config & SHA204D_SLOT_DERIVE_KEY))
+		return sha204d_fail(device);
+
+	param.random = random;
+	param.target_key_id = target;
+	param.target_key = sha204d_slot(device, target);
+	param.parent_key = (slot_config & SHA204D_SLOT_DERIVE_CREATE)
+			? sha204d_slot(device, (slot_config & SHA204D_SLOT_WRITE_KEY_MASK) >> SHA204D_SLOT_WRITE_KEY_SHIFT)
+			: param.target_key;
+	param.temp_key = &device->temp_key;
+
+	if (slot_config & SHA204D_SLOT_DERIVE_MAC) {
+		if (count != DERIVE_KEY_COUNT_LARGE)
+			return sha204d_fail(device);
+		mac_param.random = random;
+		mac_param.target_key_id = target;
+		mac_param.parent_key = param.parent_key;
+		mac_param.mac = mac;
+		(void) sha204h_derive_key_mac(&mac_param);
+		if (memcmp(mac, &command[DERIVE_KEY_MAC_IDX], sizeof(mac)))
+			return sha204d_fail(device);
+	}
+
+	return sha204d_status(sha204h_derive_key(&param));
+}
+
+
+/** \brief This function executes a Read command.
+ *
+ * The configuration zone can always be read, the OTP and data zones only after they
+ * are locked. Slots with EncryptRead set return 32 bytes encrypted with a TempKey
+ * that GenDig generated from ReadKey. Other secret slots cannot be read.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t sha204d_read(struct sha204d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct sha204h_decrypt_in_out param;
+	uint8_t zone = command[READ_ZONE_IDX];
+	uint16_t address = command[READ_ADDR_IDX] | ((uint16_t) command[READ_ADDR_IDX + 1] << 8);
+	uint8_t access = (zone & SHA204_ZONE_COUNT_FLAG) ? SHA204_ZONE_ACCESS_32 : SHA204_ZONE_ACCESS_4;
+	uint8_t *location;
+	uint16_t slot_config;
+
+	if ((count != READ_COUNT) || (zone & ~READ_ZONE_MASK))
+		return SHA204_STATUS_BYTE_PARSE;
+	location = sha204d_locate(device, zone, address, access);
+	if (!location)
+		return SHA204_STATUS_BYTE_PARSE;
+
+	if (((zone & SHA204_ZONE_MASK) != SHA204_ZONE_CONFIG) && !sha204d_data_locked(device))
+		return SHA204_STATUS_BYTE_EXEC;
+
+	memcpy(data, location, access);
+	*size = access;
+	if ((zone & SHA204_ZONE_MASK) != SHA204_ZONE_DATA)
+		return SHA204D_STATUS_BYTE_SUCCESS;
+
+	slot_config = sha204d_get_slot_config(device, (location - device->data) / SHA204_KEY_SIZE);
+	if (slot_config & SHA204D_SLOT_ENCRYPT_READ) {
+		if ((access != SHA204_ZONE_ACCESS_32)
+				|| (device->temp_key.key_id != (slot_config & SHA204D_SLOT_READ_KEY_MASK)))
+			return sha204d_fail(device);
+		param.crypto_data = data;
+		param.temp_key = &device->temp_key;
+		return sha204d_status(sha204h_decrypt(&param));
+	}
+	if (slot_config & SHA204D_SLOT_IS_SECRET)
+		return SHA204_STATUS_BYTE_EXEC;
+
+	return SHA204D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a Write command.
+ *
+ * Before it is locked, the configuration zone can be written except for the serial
+ * number, the revision, and bytes 84 to 87, which Write leaves unchanged. Before
+ * they are locked, the OTP and data zones can be written in the clear. After locking,
+ * OTP bits can only be cleared, and only in consumption mode. Slots can then be
+ * written in 32-byte blocks, in the clear if WriteConfig is 0, or encrypted with a
+ * TempKey that GenDig generated from WriteKey and authenticated with the MAC of
+ * sha204h_encrypt() if WriteConfig allows encrypted writes.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t sha204d_write(struct sha204d_device *device, uint8_t count, uint8_t *command)
+{
+	struct sha204h_decrypt_in_out param;
+	uint8_t key[SHA204_KEY_SIZE];
+	uint8_t value[SHA204_KEY_SIZE];
+	uint8_t digest[WRITE_MAC_SIZE];
+	uint8_t zone = command[WRITE_ZONE_IDX];
+	uint16_t address = command[WRITE_ADDR_IDX] | ((uint16_t) command[WRITE_ADDR_IDX + 1] << 8);
+	uint8_t access = (zone & SHA204_ZONE_COUNT_FLAG) ? SHA204_ZONE_ACCESS_32 : SHA204_ZONE_ACCESS_4;
+	uint8_t *mac = NULL;
+	uint8_t *location;
+	uint16_t offset;
+	uint16_t slot_config;
+	uint8_t i;
+
+	if (zone & ~WRITE_ZONE_MASK)
+		return SHA204_STATUS_BYTE_PARSE;
+	if (count == SHA204_CMD_SIZE_MIN + access + WRITE_MAC_SIZE)
+		mac = &command[WRITE_VALUE_IDX + access];
+	else if (count != SHA204_CMD_SIZE_MIN + access)
+		return SHA204_STATUS_BYTE_PARSE;
+	location = sha204d_locate(device, zone, address, access);
+	if (!location)
+		return SHA204_STATUS_BYTE_PARSE;
+	memcpy(value, &command[WRITE_VALUE_IDX], access);
+
+	switch (zone & SHA204_ZONE_MASK) {
+	case SHA204_ZONE_CONFIG:
+		if (sha204d_config_locked(device) || mac || (zone & WRITE_ZONE_WITH_MAC))
+			return SHA204_STATUS_BYTE_EXEC;
+		offset = location - device->config;
+		for (i = 0; i < access; i++, offset++)
+			if ((offset >= SHA204D_CONFIG_WRITABLE) && (offset < SHA204D_CONFIG_USER_EXTRA))
+				device->config[offset] = value[i];
+		break;
+
+	case SHA204_ZONE_OTP:
+		if (mac || (zone & WRITE_ZONE_WITH_MAC))
+			return SHA204_STATUS_BYTE_EXEC;
+		if (!sha204d_data_locked(device))
+			memcpy(location, value, access);
+		else if (device->config[SHA204D_CONFIG_OTP_MODE] == SHA204D_OTP_MODE_CONSUMPTION)
+			for (i = 0; i < access; i++)
+				location[i] &= value[i];
+		else
+			return SHA204_STATUS_BYTE_EXEC;
+		break;
+
+	default:
+		if (!sha204d_data_locked(device)) {
+			if (zone & WRITE_ZONE_WITH_MAC)
+				return SHA204_STATUS_BYTE_EXEC;
+			memcpy(location, value, access);
+			break;
+		}
+		if (access != SHA204_ZONE_ACCESS_32)
+			return SHA204_STATUS_BYTE_EXEC;
+
+		slot_config = sha204d_get_slot_config(device, (location - device->data) / SHA204_KEY_SIZE);
+		if (!(zone & WRITE_ZONE_WITH_MAC)) {
+			if (slot_config & SHA204D_SLOT_WRITE_CONFIG_MASK)
+				return SHA204_STATUS_BYTE_EXEC;
+			memcpy(location, value, access);
+			break;
+		}
+
+		if (!(slot_config & SHA204D_SLOT_WRITE_ENCRYPT) || !mac
+				|| (device->temp_key.key_id != ((slot_config & SHA204D_SLOT_WRITE_KEY_MASK) >> SHA204D_SLOT_WRITE_KEY_SHIFT)))
+			return sha204d_fail(device);
+
+		// Decrypt with TempKey, then check the MAC sha204h_encrypt() calculated over the plain text.
+		memcpy(key, device->temp_key.value, sizeof(key));
+		param.crypto_data = value;
+		param.temp_key = &device->temp_key;
+		if (sha204h_decrypt(&param) != SHA204_SUCCESS)
+			return SHA204_STATUS_BYTE_EXEC;
+		cryptoauth_key_digest(SHA204_WRITE, zone, address, key, value, digest);
+		if (memcmp(digest, mac, sizeof(digest)))
+			return SHA204_STATUS_BYTE_EXEC;
+		memcpy(location, value, access);
+		break;
+	}
+
+	return SHA204D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a Lock command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t sha204d_lock(struct sha204d_device *device, uint8_t count, uint8_t *command)
+{
+	uint8_t zone = command[LOCK_ZONE_IDX];
+	uint16_t summary = command[LOCK_SUMMARY_IDX] | ((uint16_t) command[LOCK_SUMMARY_IDX + 1] << 8);
+	uint8_t crc[SHA204_CRC_SIZE] = {0, 0};
+	uint16_t offset;
+
+	if ((count != LOCK_COUNT) || (zone & ~LOCK_ZONE_MASK))
+		return SHA204_STATUS_BYTE_PARSE;
+
+	if (!(zone & LOCK_ZONE_NO_CONFIG)) {
+		if (sha204d_config_locked(device))
+			return SHA204_STATUS_BYTE_EXEC;
+		sha204h_calculate_crc_chain(SHA204_CONFIG_SIZE, device->config, crc);
+	}
+	else {
+		if (!sha204d_config_locked(device) || sha204d_data_locked(device))
+			return SHA204_STATUS_BYTE_EXEC;
+		// The summary covers the data zone followed by the OTP zone.
+		for (offset = 0; offset < SHA204_DATA_SIZE; offset += SHA204_OTP_SIZE)
+			sha204h_calculate_crc_chain(SHA204_OTP_SIZE, &device->data[offset], crc);
+		sha204h_calculate_crc_chain(SHA204_OTP_SIZE, device->otp, crc);
+	}
+
+	if (!(zone & LOCK_ZONE_NO_CRC) && (summary != (crc[0] | ((uint16_t) crc[1] << 8))))
+		return SHA204_STATUS_BYTE_EXEC;
+
+	device->config[(zone & LOCK_ZONE_NO_CONFIG) ? SHA204D_CONFIG_LOCK_VALUE : SHA204D_CONFIG_LOCK_CONFIG] = SHA204D_LOCKED;
+
+	return SHA204D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes an UpdateExtra command.
+ *
+ * Mode 0 writes UserExtra (byte 84), mode 1 Selector (byte 85). Either byte can
+ * only be written once, after the configuration zone is locked.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t sha204d_update_extra(struct sha204d_device *device, uint8_t count, uint8_t *command)
+{
+	uint8_t mode = command[UPDATE_MODE_IDX];
+
+	if ((count != UPDATE_COUNT) || (mode > UPDATE_CONFIG_BYTE_86))
+		return SHA204_STATUS_BYTE_PARSE;
+	if (!sha204d_config_locked(device) || device->config[SHA204D_CONFIG_USER_EXTRA + mode])
+		return SHA204_STATUS_BYTE_EXEC;
+
+	device->config[SHA204D_CONFIG_USER_EXTRA + mode] = command[UPDATE_VALUE_IDX];
+
+	return SHA204D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a command packet.
+ *
+ * The physical layer calls this function for every packet it sends to an awake
+ * device. The function checks count and CRC, executes the command, and places the
+ * response into the output buffer. A Pause command whose selector does not match
+ * puts the device into Idle mode without a response.
+ * \param[in,out] device pointer to device
+ * \param[in] count number of bytes in packet
+ * \param[in] command pointer to packet, count byte to CRC
+ */
+void sha204d_execute(struct sha204d_device *device, uint8_t count, const uint8_t *command)
+{
+	uint8_t packet[SHA204_CMD_SIZE_MAX];
+	uint8_t crc[SHA204_CRC_SIZE] = {0, 0};
+	uint8_t data[SHA204_KEY_SIZE];
+	uint8_t size = 0;
+	uint8_t status;
+
+	device->commands++;
+
+	if ((count < SHA204_CMD_SIZE_MIN) || (count > SHA204_CMD_SIZE_MAX) || (command[SHA204_COUNT_IDX] != count)) {
+		sha204d_respond_status(device, SHA204_STATUS_BYTE_COMM);
+		return;
+	}
+	memcpy(packet, command, count);
+	sha204h_calculate_crc_chain(count - SHA204_CRC_SIZE, packet, crc);
+	if ((crc[0] != packet[count - SHA204_CRC_SIZE]) || (crc[1] != packet[count - 1])) {
+		sha204d_respond_status(device, SHA204_STATUS_BYTE_COMM);
+		return;
+	}
+
+	switch (packet[SHA204_OPCODE_IDX]) {
+	case SHA204_CHECKMAC:
+		status = sha204d_check_mac(device, count, packet);
+		break;
+
+	case SHA204_DERIVE_KEY:
+		status = sha204d_derive_key(device, count, packet);
+		break;
+
+	case SHA204_DEVREV:
+		status = (count == DEVREV_COUNT) ? SHA204D_STATUS_BYTE_SUCCESS : SHA204_STATUS_BYTE_PARSE;
+		memcpy(data, &device->config[SHA204D_CONFIG_REVISION], sizeof(sha204d_revision));
+		size = sizeof(sha204d_revision);
+		break;
+
+	case SHA204_GENDIG:
+		status = sha204d_gen_dig(device, count, packet);
+		break;
+
+	case SHA204_HMAC:
+		status = sha204d_hmac(device, count, packet, data, &size);
+		break;
+
+	case SHA204_LOCK:
+		status = sha204d_lock(device, count, packet);
+		break;
+
+	case SHA204_MAC:
+		status = sha204d_mac(device, count, packet, data, &size);
+		break;
+
+	case SHA204_NONCE:
+		status = sha204d_nonce(device, count, packet, data, &size);
+		break;
+
+	case SHA204_PAUSE:
+		status = (count == PAUSE_COUNT) ? SHA204D_STATUS_BYTE_SUCCESS : SHA204_STATUS_BYTE_PARSE;
+		if ((status == SHA204D_STATUS_BYTE_SUCCESS)
+				&& (packet[PAUSE_SELECT_IDX] != device->config[SHA204D_CONFIG_SELECTOR])) {
+			device->state = SHA204D_STATE_IDLE;
+			device->response[SHA204_BUFFER_POS_COUNT] = 0;
+			return;
+		}
+		break;
+
+	case SHA204_RANDOM:
+		status = ((count == RANDOM_COUNT) && (packet[RANDOM_MODE_IDX] <= RANDOM_NO_SEED_UPDATE))
+				? SHA204D_STATUS_BYTE_SUCCESS : SHA204_STATUS_BYTE_PARSE;
+		if (status == SHA204D_STATUS_BYTE_SUCCESS) {
+			sha204d_random(device, packet[RANDOM_MODE_IDX] == RANDOM_SEED_UPDATE, data);
+			size = SHA204_KEY_SIZE;
+		}
+		break;
+
+	case SHA204_READ:
+		status = sha204d_read(device, count, packet, data, &size);
+		break;
+
+	case SHA204_UPDATE_EXTRA:
+		status = sha204d_update_extra(device, count, packet);
+		break;
+
+	case SHA204_WRITE:
+		status = sha204d_write(device, count, packet);
+		break;
+
+	default:
+		status = SHA204_STATUS_BYTE_PARSE;
+		break;
+	}
+
+	if ((status == SHA204D_STATUS_BYTE_SUCCESS) && size)
+		sha204d_respond(device, size, data);
+	else
+		sha204d_respond_status(device, status);
+}
+
+
+/** \brief This function returns the execution time of a command in timing-accurate mode.
+ * \param[in] device pointer to device
+ * \param[in] op_code op-code of the command
+ * \return execution time in us
+ */
+static uint32_t sha204d_execution_time(const struct sha204d_device *device, uint8_t op_code)
+{
+	uint8_t typical;
+	uint8_t max;
+
+	switch (op_code) {
+	case SHA204_CHECKMAC:      typical = CHECKMAC_DELAY;    max = CHECKMAC_EXEC_MAX;    break;
+	case SHA204_DERIVE_KEY:    typical = DERIVE_KEY_DELAY;  max = DERIVE_KEY_EXEC_MAX;  break;
+	case SHA204_DEVREV:        typical = DEVREV_DELAY;      max = DEVREV_EXEC_MAX;      break;
+	case SHA204_GENDIG:        typical = GENDIG_DELAY;      max = GENDIG_EXEC_MAX;      break;
+	case SHA204_HMAC:          typical = HMAC_DELAY;        max = HMAC_EXEC_MAX;        break;
+	case SHA204_LOCK:          typical = LOCK_DELAY;        max = LOCK_EXEC_MAX;        break;
+	case SHA204_MAC:           typical = MAC_DELAY;         max = MAC_EXEC_MAX;         break;
+	case SHA204_NONCE:         typical = NONCE_DELAY;       max = NONCE_EXEC_MAX;       break;
+	case SHA204_PAUSE:         typical = PAUSE_DELAY;       max = PAUSE_EXEC_MAX;       break;
+	case SHA204_RANDOM:        typical = RANDOM_DELAY;      max = RANDOM_EXEC_MAX;      break;
+	case SHA204_READ:          typical = READ_DELAY;        max = READ_EXEC_MAX;        break;
+	case SHA204_UPDATE_EXTRA:  typical = UPDATE_DELAY;      max = UPDATE_EXEC_MAX;      break;
+	case SHA204_WRITE:         typical = WRITE_DELAY;       max = WRITE_EXEC_MAX;       break;
+	default:                   return 0;
+	}
+
+	return (uint32_t) (device->timing == SHA204D_TIMING_MAX ? max : typical) * 1000;
+}
+
+
+/** \brief This function checks whether the virtual clock has reached a time.
+ * \param[in] time virtual time in us
+ * \return 1 if the clock is at or past the time, 0 otherwise
+ */
+static uint8_t sha204d_reached(uint32_t time)
+{
+	return (int32_t) (timer_host_get_time() - time) >= 0;
+}
+
+
+/** \brief This function returns the selected device after running its watchdog.
+ *
+ * In timing-accurate mode, a device that has been awake for #SHA204D_WATCHDOG_TIME
+ * goes to sleep and loses TempKey.
+ * \return pointer to device, NULL if none is attached
+ */
+static struct sha204d_device *sha204d_selected(void)
+{
+	struct sha204d_device *device = sha204d_get_device(sha204d_device_id);
+
+	if (device && device->timing && (device->state == SHA204D_STATE_AWAKE)
+				&& sha204d_reached(device->awake_since + SHA204D_WATCHDOG_TIME)) {
+		device->state = SHA204D_STATE_SLEEP;
+		device->temp_key.valid = 0;
+		device->response[SHA204_BUFFER_POS_COUNT] = 0;
+		device->watchdog_expirations++;
+	}
+
+	return device;
+}
+
+
+/** \brief This function selects the device the other physical layer functions address.
+ *
+ *  \param[in] id ID a device was attached under with sha204d_attach()
+ */
+void sha204p_set_device_id(uint8_t id)
+{
+	sha204d_device_id = id;
+}
+
+
+/** \brief This function selects the default device ID.
+ */
+void sha204p_init(void)
+{
+	sha204d_device_id = SHA204D_DEFAULT_ID;
+}
+
+
+/** \brief This function sends a Wake token and delays.
+ *
+ * A sleeping or idle device wakes up and places the Wake status into its output buffer.
+ * Waking up from Sleep mode loses TempKey. An awake device ignores the token.
+ * \return status of the operation
+ */
+uint8_t sha204p_wakeup(void)
+{
+	struct sha204d_device *device = sha204d_selected();
+
+	if (device && (device->state != SHA204D_STATE_AWAKE)) {
+		if (device->state == SHA204D_STATE_SLEEP)
+			device->temp_key.valid = 0;
+		device->state = SHA204D_STATE_AWAKE;
+		sha204d_respond_status(device, SHA204_STATUS_BYTE_WAKEUP);
+		device->awake_since = timer_host_get_time();
+		device->busy_until = device->awake_since + (device->timing ? SHA204D_WAKEUP_TIME : 0);
+	}
+	sha204d_sync_lost = 0;
+
+	delay_ms(SHA204_WAKEUP_DELAY);
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function sends a command to the device.
+ * \param[in] count number of bytes to send
+ * \param[in] command pointer to command buffer
+ * \return status of the operation
+ */
+uint8_t sha204p_send_command(uint8_t count, uint8_t *command)
+{
+	struct sha204d_device *device = sha204d_selected();
+	uint8_t status;
+
+	if (!device || (device->state != SHA204D_STATE_AWAKE))
+		return SHA204_COMM_FAIL;
+
+	// Without acknowledge, the device discards the command.
+	if (fault_inject(sha204d_faults, FAULT_ACK)) {
+		if (device->timing)
+			timer_host_advance(SHA204D_BYTE_TIME);
+		return SHA204_COMM_FAIL;
+	}
+
+	if (device->timing) {
+		// A busy device ignores the command.
+		if (!sha204d_reached(device->busy_until))
+			return SHA204_COMM_FAIL;
+		timer_host_advance(count * SHA204D_BYTE_TIME);
+	}
+
+	sha204d_execute(device, count, command);
+
+	if (device->timing) {
+		// Parse and communication errors are reported right away.
+		status = device->response[SHA204_BUFFER_POS_STATUS];
+		device->busy_until = timer_host_get_time();
+		if ((device->response[SHA204_BUFFER_POS_COUNT] != SHA204_RSP_SIZE_MIN)
+					|| ((status != SHA204_STATUS_BYTE_PARSE) && (status != SHA204_STATUS_BYTE_COMM)))
+			device->busy_until += sha204d_execution_time(device, command[SHA204_OPCODE_IDX]);
+	}
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function puts the device into a power state.
+ * \param[in] state #SHA204D_STATE_IDLE or #SHA204D_STATE_SLEEP
+ * \return status of the operation
+ */
+static uint8_t sha204d_power_down(uint8_t state)
+{
+	struct sha204d_device *device = sha204d_selected();
+
+	if (!device || (device->state != SHA204D_STATE_AWAKE))
+		return SHA204_COMM_FAIL;
+
+	device->state = state;
+	device->response[SHA204_BUFFER_POS_COUNT] = 0;
+	if (state == SHA204D_STATE_SLEEP)
+		device->temp_key.valid = 0;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function puts the device into idle state.
+ * \return status of the operation
+ */
+uint8_t sha204p_idle(void)
+{
+	return sha204d_power_down(SHA204D_STATE_IDLE);
+}
+
+
+/** \brief This function puts the device into low-power state.
+ *  \return status of the operation
+ */
+uint8_t sha204p_sleep(void)
+{
+	return sha204d_power_down(SHA204D_STATE_SLEEP);
+}
+
+
+/** \brief This function resets the I/O buffer of the device.
+ *
+ * The response stays in the output buffer, so it can be read again.
+ * \return status of the operation
+ */
+uint8_t sha204p_reset_io(void)
+{
+	struct sha204d_device *device = sha204d_selected();
+
+	if (!device || (device->state != SHA204D_STATE_AWAKE))
+		return SHA204_COMM_FAIL;
+
+	if (device->timing)
+		timer_host_advance(SHA204D_BYTE_TIME);
+	sha204d_sync_lost = 0;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function receives a response from the device.
+ *
+ * The CRC of the response is checked as in the other physical layers.
+ * The function returns #SHA204_BAD_CRC if it does not match the received one.
+ *
+ * \param[in] size size of rx buffer
+ * \param[out] response pointer to rx buffer
+ * \return status of the operation
+ */
+uint8_t sha204p_receive_response(uint8_t size, uint8_t *response)
+{
+	struct sha204d_device *device = sha204d_selected();
+	uint8_t crc[SHA204_CRC_SIZE] = {0, 0};
+	uint8_t count;
+
+	if (device && device->timing && (device->state == SHA204D_STATE_AWAKE) && !sha204d_reached(device->busy_until)) {
+		// A response that becomes ready while the host listens is received.
+		if (!sha204d_reached(device->busy_until - SHA204_RESPONSE_TIMEOUT)) {
+			timer_host_advance(SHA204_RESPONSE_TIMEOUT);
+			return SHA204_RX_NO_RESPONSE;
+		}
+		timer_host_advance(device->busy_until - timer_host_get_time());
+	}
+
+	if (!device || (device->state != SHA204D_STATE_AWAKE) || !device->response[SHA204_BUFFER_POS_COUNT]) {
+		if (device && device->timing)
+			timer_host_advance(SHA204_RESPONSE_TIMEOUT);
+		return SHA204_RX_NO_RESPONSE;
+	}
+
+	// Faults corrupt the response on the bus only.
+	count = device->response[SHA204_BUFFER_POS_COUNT];
+	if (sha204d_sync_lost || fault_inject(sha204d_faults, FAULT_SYNC)) {
+		sha204d_sync_lost = 1;
+		count = 0xFF;
+	}
+	else if (fault_inject(sha204d_faults, FAULT_COUNT))
+		count = (uint8_t) (fault_random(sha204d_faults) % count);
+	response[SHA204_BUFFER_POS_COUNT] = count;
+	if ((count < SHA204_RSP_SIZE_MIN) || (count > size)) {
+		if (device->timing)
+			timer_host_advance(SHA204D_BYTE_TIME);
+		return SHA204_INVALID_SIZE;
+	}
+
+	if (device->timing)
+		timer_host_advance(count * SHA204D_BYTE_TIME);
+
+	memcpy(&response[SHA204_BUFFER_POS_STATUS], &device->response[SHA204_BUFFER_POS_STATUS], count - 1);
+	if (fault_inject(sha204d_faults, FAULT_CRC))
+		response[count - 1 - (fault_random(sha204d_faults) & 1)] ^= 1 << (fault_random(sha204d_faults) & 7);
+	sha204h_calculate_crc_chain(count - SHA204_CRC_SIZE, response, crc);
+	if ((crc[0] != response[count - SHA204_CRC_SIZE]) || (crc[1] != response[count - 1]))
+		return SHA204_BAD_CRC;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function resynchronizes communication.
+ *
+ * An awake device acknowledges and resets its I/O buffer. A sleeping or idle
+ * device does not, so the Communication layer sends a Wake token next.
+ * \param[in] size size of rx buffer
+ * \param[out] response pointer to response buffer
+ * \return status of the operation
+ */
+uint8_t sha204p_resync(uint8_t size, uint8_t *response)
+{
+	(void) size;
+	(void) response;
+
+	return sha204p_reset_io();
+}
+
+/** @} */
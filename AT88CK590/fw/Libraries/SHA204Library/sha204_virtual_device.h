@@ -0,0 +1,227 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the ATSHA204 Virtual Device
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#ifndef SHA204_VIRTUAL_DEVICE_H
+#   define SHA204_VIRTUAL_DEVICE_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "fault_injection.h"           // definitions and declarations for the Fault Injection module
+
+
+/** \defgroup atsha204_virtual_device Module 15: Virtual Device
+ *
+ * \brief
+ * This module is a software model of an ATSHA204 device. It implements the functions
+ * declared in \ref sha204_physical.h, so it can be linked instead of sha204_swi.c or
+ * sha204_i2c.c. The unmodified Communication and Command Marshaling layers then
+ * run against it on a host, at memory speed and without hardware. Define SHA204_VIRTUAL
+ * for these builds, and link timer_utilities_host.c instead of timer_utilities.c.
+ *
+ * The model holds the configuration, OTP, and data zones, the lock bytes, TempKey, and
+ * the sleep / idle / awake state of a device. It parses command packets, checks their
+ * CRC, and executes the command set of \ref sha204_comm_marshaling.h. The cryptographic
+ * results are calculated with the sha204h_* functions of the Helper module. Status
+ * responses use the status bytes the device returns. The Communication layer
+ * translates them into the same return codes as with a real device.
+ *
+ * Up to #SHA204D_DEVICES_MAX devices can be attached, each under an ID for
+ * sha204p_set_device_id(). An application allocates a struct sha204d_device,
+ * initializes it with sha204d_device_init(), and personalizes it like a real
+ * device, with Write and Lock commands. It can also fill the zones directly
+ * before it locks them.
+ *
+ * The model follows the access rules this library relies on. It does not model
+ * the SingleUse / UseFlag counters, LastKeyUse, or the transport keys.
+ * Random numbers come from a deterministic generator seeded by
+ * sha204d_device_init(), so that runs can be reproduced. They are not secure.
+ *
+ * By default a device answers at memory speed. Set sha204d_device::timing to
+ * #SHA204D_TIMING_TYPICAL or #SHA204D_TIMING_MAX to make it run on the virtual clock
+ * of timer_utilities_host.c instead. A command then executes for the typical
+ * (*_DELAY) or maximum (*_EXEC_MAX) time of \ref sha204_comm_marshaling.h, during
+ * which the device does not respond. A device woken up responds after
+ * #SHA204D_WAKEUP_TIME, and its watchdog puts it to sleep, losing TempKey,
+ * #SHA204D_WATCHDOG_TIME after it woke up. Transfers advance the clock by
+ * #SHA204D_BYTE_TIME per byte, and a poll without response by
+ * #SHA204_RESPONSE_TIMEOUT. The application measures a command schedule
+ * with timer_host_get_time(), and can tie the clock to real time, sped up,
+ * with timer_host_set_acceleration().
+ *
+ * sha204d_set_fault_injector() places a \ref fault_injection "fault injector" on the
+ * bus. It drops the acknowledge of commands, and flips CRC bits, truncates the count
+ * byte, or loses synchronization when the host reads a response. The response stays
+ * in the output buffer, so the retry and resynchronization paths of the Communication
+ * layer can recover it. A device that lost synchronization sends 0xFF until the host
+ * resynchronizes or wakes it up.
+@{ */
+
+//! maximum number of devices that can be attached at the same time
+#define SHA204D_DEVICES_MAX              (8)
+
+//! device ID sha204p_init() selects, the default I<SUP>2</SUP>C address of an ATSHA204
+#define SHA204D_DEFAULT_ID               ((uint8_t) 0xC8)
+
+/** \name Times of the Timing-Accurate Mode in us
+@{ */
+#define SHA204D_WAKEUP_TIME              ((uint32_t) 2500)     //!< tWHI, the device does not respond before
+#define SHA204D_WATCHDOG_TIME            ((uint32_t) 1300000)  //!< tWATCHDOG, the device goes to sleep after being awake this long
+#define SHA204D_BYTE_TIME                ((uint32_t) 23)       //!< time to transfer a byte, nine clocks at 400 kHz
+/** @} */
+
+//! size of the serial number
+#define SHA204D_SN_SIZE                  (9)
+
+/** \name Configuration Zone Addresses
+@{ */
+#define SHA204D_CONFIG_REVISION          ( 4)      //!< RevNum[0:3]
+#define SHA204D_CONFIG_SN_4              ( 8)      //!< SN[4:8]
+#define SHA204D_CONFIG_I2C_ADDRESS       (16)      //!< I2C address
+#define SHA204D_CONFIG_OTP_MODE          (18)      //!< OTP mode
+#define SHA204D_CONFIG_SLOT_CONFIG       (20)      //!< SlotConfig[0:15], two bytes each, LSB first
+#define SHA204D_CONFIG_WRITABLE          (16)      //!< first byte the Write command can change
+#define SHA204D_CONFIG_USER_EXTRA        (84)      //!< UserExtra, written by UpdateExtra mode 0
+#define SHA204D_CONFIG_SELECTOR          (85)      //!< Selector, written by UpdateExtra mode 1
+#define SHA204D_CONFIG_LOCK_VALUE        (86)      //!< lock byte of Data and OTP zones
+#define SHA204D_CONFIG_LOCK_CONFIG       (87)      //!< lock byte of Configuration zone
+/** @} */
+
+/** \name Lock Byte and OTP Mode Values
+@{ */
+#define SHA204D_UNLOCKED                 ((uint8_t) 0x55)  //!< zone is not locked
+#define SHA204D_LOCKED                   ((uint8_t) 0x00)  //!< zone is locked
+#define SHA204D_OTP_MODE_CONSUMPTION     ((uint8_t) 0x55)  //!< OTP bits can be cleared after locking
+#define SHA204D_OTP_MODE_READ_ONLY       ((uint8_t) 0xAA)  //!< OTP zone cannot be written after locking
+/** @} */
+
+/** \name SlotConfig Bits
+@{ */
+#define SHA204D_SLOT_READ_KEY_MASK       (0x000F)  //!< key for encrypted reads
+#define SHA204D_SLOT_CHECK_ONLY          (0x0010)  //!< key can only be used by CheckMac and GenDig
+#define SHA204D_SLOT_ENCRYPT_READ        (0x0040)  //!< 32-byte reads are encrypted
+#define SHA204D_SLOT_IS_SECRET           (0x0080)  //!< slot cannot be read
+#define SHA204D_SLOT_WRITE_KEY_SHIFT     (8)       //!< position of the key for encrypted writes and DeriveKey
+#define SHA204D_SLOT_WRITE_KEY_MASK      (0x0F00)  //!< key for encrypted writes and DeriveKey
+#define SHA204D_SLOT_WRITE_CONFIG_MASK   (0xF000)  //!< WriteConfig, 0 allows clear writes
+#define SHA204D_SLOT_DERIVE_CREATE       (0x1000)  //!< DeriveKey uses WriteKey as parent, otherwise the slot itself
+#define SHA204D_SLOT_DERIVE_KEY          (0x2000)  //!< DeriveKey is allowed
+#define SHA204D_SLOT_WRITE_ENCRYPT       (0x4000)  //!< encrypted writes with MAC are allowed
+#define SHA204D_SLOT_DERIVE_MAC          (0x8000)  //!< DeriveKey requires an input MAC
+/** @} */
+
+/** \name Response Status Bytes not defined by the Communication Module
+@{ */
+#define SHA204D_STATUS_BYTE_SUCCESS      ((uint8_t) 0x00)  //!< command succeeded
+#define SHA204D_STATUS_BYTE_CHECKMAC     ((uint8_t) 0x01)  //!< CheckMac miscompare
+/** @} */
+
+
+//! power states of a virtual device
+enum sha204d_state {
+	SHA204D_STATE_SLEEP,   //!< TempKey is lost, only a Wake token is answered
+	SHA204D_STATE_IDLE,    //!< TempKey is kept, only a Wake token is answered
+	SHA204D_STATE_AWAKE    //!< commands are accepted
+};
+
+
+//! timing modes of a virtual device
+enum sha204d_timing {
+	SHA204D_TIMING_OFF,     //!< commands execute at memory speed
+	SHA204D_TIMING_TYPICAL, //!< commands take their typical execution time
+	SHA204D_TIMING_MAX      //!< commands take their maximum execution time
+};
+
+
+/** \struct sha204d_device
+ *  \brief State of a virtual device.
+ *  \var sha204d_device::config
+ *       \brief Configuration zone.
+ *  \var sha204d_device::otp
+ *       \brief OTP zone.
+ *  \var sha204d_device::data
+ *       \brief Data zone, 16 slots of 32 bytes.
+ *  \var sha204d_device::temp_key
+ *       \brief TempKey register and its flags.
+ *  \var sha204d_device::seed
+ *       \brief State of the random number generator.
+ *  \var sha204d_device::random_count
+ *       \brief Number of random numbers generated.
+ *  \var sha204d_device::state
+ *       \brief Power state, one of #sha204d_state.
+ *  \var sha204d_device::response
+ *       \brief Output buffer, count byte to CRC.
+ *  \var sha204d_device::commands
+ *       \brief Number of command packets received.
+ *  \var sha204d_device::timing
+ *       \brief Timing mode, one of #sha204d_timing.
+ *  \var sha204d_device::awake_since
+ *       \brief Virtual time at which the device woke up.
+ *  \var sha204d_device::busy_until
+ *       \brief Virtual time at which the device responds again.
+ *  \var sha204d_device::watchdog_expirations
+ *       \brief Number of times the watchdog put the device to sleep.
+ */
+struct sha204d_device {
+	uint8_t config[SHA204_CONFIG_SIZE];
+	uint8_t otp[SHA204_OTP_SIZE];
+	uint8_t data[SHA204_DATA_SIZE];
+	struct sha204h_temp_key temp_key;
+	uint8_t seed[SHA204_KEY_SIZE];
+	uint32_t random_count;
+	uint8_t state;
+	uint8_t response[SHA204_RSP_SIZE_MAX];
+	uint32_t commands;
+	uint8_t timing;
+	uint32_t awake_since;
+	uint32_t busy_until;
+	uint32_t watchdog_expirations;
+};
+
+
+void sha204d_device_init(struct sha204d_device *device, const uint8_t *sn, const uint8_t *seed);
+uint8_t sha204d_attach(uint8_t id, struct sha204d_device *device);
+struct sha204d_device *sha204d_get_device(uint8_t id);
+uint16_t sha204d_get_slot_config(const struct sha204d_device *device, uint8_t key_id);
+void sha204d_set_slot_config(struct sha204d_device *device, uint8_t key_id, uint16_t slot_config);
+void sha204d_execute(struct sha204d_device *device, uint8_t count, const uint8_t *command);
+void sha204d_set_fault_injector(struct fault_injector *injector);
+
+/** @} */
+
+#endif
@@ -0,0 +1,394 @@
+/** \file
+ *  \brief  Functions that Precompute Encrypted Writes of a Production Lot
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdlib.h>                    // needed for qsort()
+#include <fcntl.h>                     // needed for open()
+#include <unistd.h>                    // needed for close()
+#include <sys/mman.h>                  // needed for mmap()
+#include <sys/stat.h>                  // needed for fstat()
+#include <pthread.h>                   // needed for the build threads
+
+#include "sha204_write_lot.h"          // definitions and declarations for this module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "cryptoauth_core.h"           // definitions and declarations for the digest calculations
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+#include "cryptoauth_wipe.h"           // definitions and declarations for the Wipe module
+#include "cryptoauth_file.h"           // definitions and declarations for writing mapped files
+
+
+//! identifies a lot file, followed by the version and the record size
+static const uint8_t sha204w_magic[8] = {'S', 'H', 'A', '2', '0', '4', 'W', 'L'};
+
+
+/** \brief Header of a lot file. It is followed by the records, sorted by serial number.
+ *
+ *  The version, the record size and the record count are stored LSB first.
+ */
+struct sha204w_header {
+	uint8_t magic[sizeof(sha204w_magic)];
+	uint8_t version[2];
+	uint8_t record_size[2];
+	uint8_t count[4];
+	uint8_t reserved[SHA204W_HEADER_SIZE - sizeof(sha204w_magic) - 8];
+};
+
+
+/** \brief Mapping of a lot file.
+ */
+struct sha204w_lot {
+	void *map;
+	size_t size;
+	uint32_t count;
+	const struct sha204w_record *records;
+};
+
+
+/** \brief Part of the manifest that one build thread calculates.
+ */
+struct sha204w_job {
+	const struct sha204w_manifest_entry *entries;
+	struct sha204w_record *records;
+	uint32_t first;
+	uint32_t count;
+	pthread_t thread;
+};
+
+
+/** \brief This function calculates the record of one device.
+ *
+ * \param[in] entry pointer to manifest entry
+ * \param[out] record pointer to record
+ */
+static void sha204w_record_init(const struct sha204w_manifest_entry *entry, struct sha204w_record *record)
+{
+	uint8_t message[SHA204W_NONCE_SEED_SIZE + SHA204W_SN_SIZE];
+	uint8_t digest[SHA256_DIGEST_SIZE];
+	uint32_t midstate[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+	uint16_t address = (uint16_t) entry->slot << 3;
+	uint8_t i;
+
+	memset(record, 0, sizeof(*record));
+	memcpy(record->sn, entry->sn, SHA204W_SN_SIZE);
+
+	// NumIn is taken from SHA-256(seed || SN), so every device gets its own even if a lot shares one seed.
+	memcpy(message, entry->nonce_seed, SHA204W_NONCE_SEED_SIZE);
+	memcpy(&message[SHA204W_NONCE_SEED_SIZE], entry->sn, SHA204W_SN_SIZE);
+	sha256(sizeof(message), message, digest);
+	memcpy(record->num_in, digest, NONCE_NUMIN_SIZE);
+	record->nonce_mode = NONCE_MODE_SEED_UPDATE;
+
+	record->gen_dig_zone = GENDIG_ZONE_DATA;
+	record->gen_dig_key_id[0] = entry->parent_key_id;
+	cryptoauth_key_digest_init(SHA204_GENDIG, GENDIG_ZONE_DATA, entry->parent_key_id, entry->parent_key, midstate);
+	for (i = 0; i < SHA256_DIGEST_SIZE; i++)
+		record->gen_dig_midstate[i] = (uint8_t) (midstate[i >> 2] >> (24 - ((i & 3) << 3)));
+
+	record->write_zone = SHA204_ZONE_DATA | SHA204_ZONE_COUNT_FLAG;
+	record->write_address[0] = address & 0xFF;
+	record->write_address[1] = address >> 8;
+	memcpy(record->data, entry->data, SHA204_KEY_SIZE);
+
+	cryptoauth_wipe(message, sizeof(message));
+	cryptoauth_wipe(midstate, sizeof(midstate));
+}
+
+
+/** \brief This function is the body of a build thread.
+ *
+ * \param[in] arg pointer to job
+ * \return NULL
+ */
+static void *sha204w_thread(void *arg)
+{
+	struct sha204w_job *job = (struct sha204w_job *) arg;
+	uint32_t i;
+
+	for (i = job->first; i < job->first + job->count; i++)
+		sha204w_record_init(&job->entries[i], &job->records[i]);
+
+	return NULL;
+}
+
+
+/** \brief This function compares the serial numbers of two records, for qsort() and bsearch().
+ *
+ * \param[in] a pointer to serial number or record
+ * \param[in] b pointer to record
+ * \return less than, equal to, or greater than zero
+ */
+static int sha204w_compare(const void *a, const void *b)
+{
+	return memcmp(a, ((const struct sha204w_record *) b)->sn, SHA204W_SN_SIZE);
+}
+
+
+/** \brief This function calculates the records of a production lot and writes them to a lot file.
+ *
+ * The manifest is split into equal parts that are calculated by threads - 1 new
+ * threads and the calling thread. The records are written straight into a mapped
+ * temporary file and then sorted by serial number. The temporary file replaces an
+ * existing lot file only when it is complete (see cryptoauth_file_commit()), so
+ * mappings of the old file stay valid and a failed build keeps the old file.
+ *
+ * \param[in] threads number of threads, 1 to SHA204W_THREADS_MAX
+ * \param[in] count number of devices
+ * \param[in] entries array of count manifest entries
+ * \param[in] file_name name of the lot file to create
+ * \return status of the operation, SHA204_BAD_PARAM if an entry is invalid or a serial number appears twice
+ */
+uint8_t sha204w_lot_build(uint8_t threads, uint32_t count, const struct sha204w_manifest_entry *entries,
+		const char *file_name)
+{
+	struct sha204w_job job[SHA204W_THREADS_MAX];
+	struct sha204w_header *header;
+	struct sha204w_record *records;
+	size_t size = SHA204W_HEADER_SIZE + (size_t) count * SHA204W_RECORD_SIZE;
+	uint8_t ret_code = SHA204_SUCCESS;
+	uint8_t started;
+	uint32_t i;
+	struct cryptoauth_file file;
+
+	if ((!entries && count) || !file_name || !threads || (threads > SHA204W_THREADS_MAX))
+		return SHA204_BAD_PARAM;
+
+	for (i = 0; i < count; i++) {
+		if ((entries[i].slot > SHA204_KEY_ID_MAX) || (entries[i].parent_key_id > SHA204_KEY_ID_MAX))
+			return SHA204_BAD_PARAM;
+	}
+	if (threads > count)
+		threads = count ? (uint8_t) count : 1;
+
+	if (cryptoauth_file_create(file_name, size, &file) != CRYPTOAUTH_FILE_SUCCESS)
+		return SHA204_FUNC_FAIL;
+
+	header = (struct sha204w_header *) file.map;
+	records = (struct sha204w_record *) ((uint8_t *) file.map + SHA204W_HEADER_SIZE);
+
+	for (i = 0; i < threads; i++) {
+		job[i].entries = entries;
+		job[i].records = records;
+		job[i].first = (uint32_t) ((uint64_t) count * i / threads);
+		job[i].count = (uint32_t) ((uint64_t) count * (i + 1) / threads) - job[i].first;
+	}
+	// The calling thread calculates the first part, and also any part a new thread could not be started for.
+	for (started = 1; started < threads; started++) {
+		if (pthread_create(&job[started].thread, NULL, sha204w_thread, &job[started]))
+			break;
+	}
+	sha204w_thread(&job[0]);
+	for (i = started; i < threads; i++)
+		sha204w_thread(&job[i]);
+	for (i = 1; i < started; i++)
+		pthread_join(job[i].thread, NULL);
+
+	qsort(records, count, SHA204W_RECORD_SIZE, sha204w_compare);
+	for (i = 1; i < count; i++) {
+		if (!memcmp(records[i - 1].sn, records[i].sn, SHA204W_SN_SIZE)) {
+			ret_code = SHA204_BAD_PARAM;
+			break;
+		}
+	}
+
+	// The header is written last, so a file that was not completed is never accepted by sha204w_lot_open().
+	if (ret_code == SHA204_SUCCESS) {
+		header->version[0] = SHA204W_VERSION;
+		header->record_size[0] = SHA204W_RECORD_SIZE;
+		for (i = 0; i < sizeof(header->count); i++)
+			header->count[i] = (uint8_t) (count >> (i << 3));
+		memcpy(header->magic, sha204w_magic, sizeof(sha204w_magic));
+	}
+
+	return cryptoauth_file_commit(&file, ret_code);
+}
+
+
+/** \brief This function maps a lot file for reading.
+ *
+ * \param[in] file_name name of the lot file
+ * \param[out] lot pointer to the new mapping, to be released with sha204w_lot_close()
+ * \return status of the operation, SHA204_INVALID_SIZE if the file is not a complete lot file
+ */
+uint8_t sha204w_lot_open(const char *file_name, struct sha204w_lot **lot)
+{
+	const struct sha204w_header *header;
+	struct sha204w_lot *new_lot;
+	struct stat status;
+	uint32_t count = 0;
+	uint8_t i;
+	void *map;
+	int fd;
+
+	if (!file_name || !lot)
+		return SHA204_BAD_PARAM;
+
+	fd = open(file_name, O_RDONLY);
+	if (fd < 0)
+		return SHA204_FUNC_FAIL;
+	if (fstat(fd, &status) || (status.st_size < SHA204W_HEADER_SIZE)) {
+		close(fd);
+		return SHA204_INVALID_SIZE;
+	}
+	map = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return SHA204_FUNC_FAIL;
+
+	header = (const struct sha204w_header *) map;
+	for (i = 0; i < sizeof(header->count); i++)
+		count |= (uint32_t) header->count[i] << (i << 3);
+	if (memcmp(header->magic, sha204w_magic, sizeof(sha204w_magic))
+			|| (header->version[0] != SHA204W_VERSION) || header->version[1]
+			|| (header->record_size[0] != SHA204W_RECORD_SIZE) || header->record_size[1]
+			|| ((uint64_t) status.st_size != SHA204W_HEADER_SIZE + (uint64_t) count * SHA204W_RECORD_SIZE)) {
+		munmap(map, (size_t) status.st_size);
+		return SHA204_INVALID_SIZE;
+	}
+
+	new_lot = malloc(sizeof(*new_lot));
+	if (!new_lot) {
+		munmap(map, (size_t) status.st_size);
+		return SHA204_FUNC_FAIL;
+	}
+	new_lot->map = map;
+	new_lot->size = (size_t) status.st_size;
+	new_lot->count = count;
+	new_lot->records = (const struct sha204w_record *) ((const uint8_t *) map + SHA204W_HEADER_SIZE);
+	*lot = new_lot;
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function unmaps a lot file.
+ *
+ * \param[in] lot pointer to mapping, can be NULL
+ */
+void sha204w_lot_close(struct sha204w_lot *lot)
+{
+	if (!lot)
+		return;
+
+	munmap(lot->map, lot->size);
+	free(lot);
+}
+
+
+/** \brief This function returns the number of records in a lot.
+ *
+ * \param[in] lot pointer to mapping
+ * \return number of records
+ */
+uint32_t sha204w_lot_count(const struct sha204w_lot *lot)
+{
+	return lot->count;
+}
+
+
+/** \brief This function returns a record by its position in the lot.
+ *
+ * \param[in] lot pointer to mapping
+ * \param[in] index position of the record, records are sorted by serial number
+ * \return pointer to record, NULL if index is out of range
+ */
+const struct sha204w_record *sha204w_lot_record(const struct sha204w_lot *lot, uint32_t index)
+{
+	return index < lot->count ? &lot->records[index] : NULL;
+}
+
+
+/** \brief This function finds the record of a device by binary search.
+ *
+ * \param[in] lot pointer to mapping
+ * \param[in] sn pointer to 9-byte serial number
+ * \return pointer to record, NULL if the device is not in the lot
+ */
+const struct sha204w_record *sha204w_lot_find(const struct sha204w_lot *lot, const uint8_t *sn)
+{
+	return (const struct sha204w_record *) bsearch(sn, lot->records, lot->count, SHA204W_RECORD_SIZE,
+			sha204w_compare);
+}
+
+
+/** \brief This function calculates the cipher text and the input MAC of an encrypted write.
+ *
+ * Send the Nonce command with the NumIn and mode of the record first, and pass the
+ * RandOut of its response. Then send the GenDig command and the Write command with
+ * the parameters of the record, the cipher text and the MAC. The results are the
+ * ones sha204h_nonce(), sha204h_gen_dig() and sha204h_encrypt() calculate.
+ *
+ * \param[in] record pointer to record
+ * \param[in] rand_out pointer to 32-byte RandOut of the Nonce command
+ * \param[out] crypto_data pointer to 32-byte cipher text, Value field of the Write command
+ * \param[out] mac pointer to 32-byte input MAC of the Write command
+ * \return status of the operation
+ */
+uint8_t sha204w_finish(const struct sha204w_record *record, const uint8_t *rand_out, uint8_t *crypto_data,
+		uint8_t *mac)
+{
+	uint8_t temp_key[SHA204_KEY_SIZE];
+	uint32_t midstate[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+	uint8_t i;
+
+	if (!record || !rand_out || !crypto_data || !mac)
+		return SHA204_BAD_PARAM;
+
+	// TempKey after the Nonce command
+	cryptoauth_nonce(SHA204_NONCE, record->nonce_mode, rand_out, record->num_in, temp_key);
+
+	// TempKey after the GenDig command, only the block with the old TempKey is left to hash
+	for (i = 0; i < SHA256_DIGEST_SIZE / sizeof(uint32_t); i++)
+		midstate[i] = ((uint32_t) record->gen_dig_midstate[4 * i] << 24)
+				| ((uint32_t) record->gen_dig_midstate[4 * i + 1] << 16)
+				| ((uint32_t) record->gen_dig_midstate[4 * i + 2] << 8)
+				| (uint32_t) record->gen_dig_midstate[4 * i + 3];
+	cryptoauth_key_digest_final(midstate, temp_key, temp_key);
+
+	cryptoauth_key_digest(SHA204_WRITE, record->write_zone,
+			record->write_address[0] | ((uint16_t) record->write_address[1] << 8),
+			temp_key, record->data, mac);
+
+	for (i = 0; i < SHA204_KEY_SIZE; i++)
+		crypto_data[i] = record->data[i] ^ temp_key[i];
+
+	cryptoauth_wipe(temp_key, sizeof(temp_key));
+	cryptoauth_wipe(midstate, sizeof(midstate));
+
+	return SHA204_SUCCESS;
+}
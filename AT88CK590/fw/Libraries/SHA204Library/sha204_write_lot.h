@@ -0,0 +1,171 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Encrypted Write Lot Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atsha204_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atsha204_library_license_stop
+ */
+
+#ifndef SHA204_WRITE_LOT_H
+#   define SHA204_WRITE_LOT_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+
+
+/** \defgroup atsha204_write_lot Module 11: Encrypted Write Lots
+ *
+ * \brief
+ * Use these functions to provision a production lot with encrypted writes, as
+ * encrypted_write_procedure() of the ECC108 workshop and sha204h_encrypt() do for a
+ * single device. An encrypted write needs a random nonce, so the TempKey, the cipher
+ * text and the input MAC depend on the RandOut of the device and cannot be
+ * calculated before the device answers its Nonce command. Everything else is
+ * calculated offline, in parallel, by sha204w_lot_build():
+ * <ul>
+ * <li>the NumIn of the Nonce command, derived from a nonce seed and the serial number,</li>
+ * <li>the midstate of the first GenDig block, which holds the parent key,</li>
+ * <li>the Param1 and Param2 of the GenDig and Write commands.</li>
+ * </ul>
+ * The results are stored in a lot file, sorted by serial number. The provisioning
+ * line maps it with sha204w_lot_open(), finds the record of a device with
+ * sha204w_lot_find(), and after the Nonce command calls sha204w_finish(), which
+ * hashes four SHA-256 blocks instead of the five of the interactive calculation.
+ *
+ * A lot file holds the slot data in clear text and midstates that are as secret as
+ * the parent keys, so it has to be protected like the manifest it was built from.
+ *
+ * This module needs POSIX threads and memory-mapped files, so it is meant for hosts
+ * and not for firmware.
+@{ */
+
+//! size of the serial number that identifies a device in a lot
+#define SHA204W_SN_SIZE              (9)
+
+//! size of a nonce seed
+#define SHA204W_NONCE_SEED_SIZE     (32)
+
+//! size of a record in a lot file
+#define SHA204W_RECORD_SIZE        (128)
+
+//! size of the header of a lot file
+#define SHA204W_HEADER_SIZE         (64)
+
+//! version of the lot file format
+#define SHA204W_VERSION              (1)
+
+//! maximum number of threads sha204w_lot_build() uses
+#define SHA204W_THREADS_MAX         (64)
+
+
+/** \struct sha204w_manifest_entry
+ *  \brief One device of a production lot.
+ *  \var sha204w_manifest_entry::sn
+ *       \brief [in] 9-byte serial number of the device.
+ *  \var sha204w_manifest_entry::nonce_seed
+ *       \brief [in] 32-byte seed of the NumIn of the Nonce command.
+ *  \var sha204w_manifest_entry::slot
+ *       \brief [in] Data slot to write (0 to 15).
+ *  \var sha204w_manifest_entry::data
+ *       \brief [in] 32 bytes of clear text data to write into the slot.
+ *  \var sha204w_manifest_entry::parent_key_id
+ *       \brief [in] Slot of the parent key, SlotConfig[slot].WriteKey (0 to 15).
+ *  \var sha204w_manifest_entry::parent_key
+ *       \brief [in] 32-byte parent key.
+ */
+struct sha204w_manifest_entry {
+	uint8_t sn[SHA204W_SN_SIZE];
+	uint8_t nonce_seed[SHA204W_NONCE_SEED_SIZE];
+	uint8_t slot;
+	uint8_t data[SHA204_KEY_SIZE];
+	uint8_t parent_key_id;
+	uint8_t parent_key[SHA204_KEY_SIZE];
+};
+
+
+/** \struct sha204w_record
+ *  \brief Precomputed encrypted write of one device, as stored in a lot file.
+ *
+ *  All multi-byte parameters are stored LSB first, as they are sent to the device.
+ *  \var sha204w_record::sn
+ *       \brief 9-byte serial number of the device.
+ *  \var sha204w_record::nonce_mode
+ *       \brief Mode parameter of the Nonce command (Param1).
+ *  \var sha204w_record::gen_dig_zone
+ *       \brief Zone parameter of the GenDig command (Param1).
+ *  \var sha204w_record::gen_dig_key_id
+ *       \brief KeyID parameter of the GenDig command (Param2).
+ *  \var sha204w_record::write_zone
+ *       \brief Zone parameter of the Write command (Param1).
+ *  \var sha204w_record::write_address
+ *       \brief Address parameter of the Write command (Param2).
+ *  \var sha204w_record::num_in
+ *       \brief 20-byte NumIn of the Nonce command.
+ *  \var sha204w_record::gen_dig_midstate
+ *       \brief Midstate of the first GenDig block, eight words MSB first.
+ *  \var sha204w_record::data
+ *       \brief 32 bytes of clear text data.
+ */
+struct sha204w_record {
+	uint8_t sn[SHA204W_SN_SIZE];
+	uint8_t nonce_mode;
+	uint8_t gen_dig_zone;
+	uint8_t gen_dig_key_id[2];
+	uint8_t write_zone;
+	uint8_t write_address[2];
+	uint8_t num_in[NONCE_NUMIN_SIZE];
+	uint8_t reserved1[12];
+	uint8_t gen_dig_midstate[SHA204_KEY_SIZE];
+	uint8_t data[SHA204_KEY_SIZE];
+	uint8_t reserved2[16];
+};
+
+
+//! opaque lot file mapping, created by sha204w_lot_open()
+struct sha204w_lot;
+
+
+uint8_t sha204w_lot_build(uint8_t threads, uint32_t count, const struct sha204w_manifest_entry *entries,
+		const char *file_name);
+uint8_t sha204w_lot_open(const char *file_name, struct sha204w_lot **lot);
+void sha204w_lot_close(struct sha204w_lot *lot);
+uint32_t sha204w_lot_count(const struct sha204w_lot *lot);
+const struct sha204w_record *sha204w_lot_record(const struct sha204w_lot *lot, uint32_t index);
+const struct sha204w_record *sha204w_lot_find(const struct sha204w_lot *lot, const uint8_t *sn);
+uint8_t sha204w_finish(const struct sha204w_record *record, const uint8_t *rand_out, uint8_t *crypto_data,
+		uint8_t *mac);
+
+/** @} */
+
+#endif //SHA204_WRITE_LOT_H
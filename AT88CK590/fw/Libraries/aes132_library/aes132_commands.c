@@ -26,8 +26,10 @@
 #   include "aes132_i2c.h"
 #elif AES132_SPI
 #   include "aes132_spi.h"
+#elif defined(AES132_VIRTUAL)
+#   include "aes132_virtual_device.h"
 #else
-#   error You have to define AES132_I2C or AES132_SPI.
+#   error You have to define AES132_I2C, AES132_SPI, or AES132_VIRTUAL.
 #endif
 
 
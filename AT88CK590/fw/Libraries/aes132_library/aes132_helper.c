@@ -0,0 +1,334 @@
+// ----------------------------------------------------------------------------
+//         ATMEL Crypto-Devices Software Support  -  Colorado Springs, CO -
+// ----------------------------------------------------------------------------
+// DISCLAIMER:  THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+// DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+// OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+/** \file
+ *  \brief  AES132 Helper Functions
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "aes132_helper.h"
+#include "cryptoauth_wipe.h"
+
+
+#define AES132H_AAD_SIZE             (14)  //!< size of the authenticate-only data after its length field
+#define AES132H_CCM_NONCE_SIZE       (AES132H_NONCE_SIZE + 1)      //!< nonce register and MacCount
+#define AES132H_MAC_BLOCKS_MAX       (4)   //!< B0, B1 and two data blocks
+#define AES132H_COUNTER_BLOCKS_MAX   (3)   //!< A0 and two data blocks
+
+
+/** \brief This function calculates the nonce the device stores when executing a Nonce command.
+ *
+ * Without the random mode bit, the nonce is InSeed. With it, the nonce is the first
+ * 12 bytes of InSeed || 0x00{4}, encrypted with RandOut as key. MacCount starts at zero.
+ *
+ * \param[in,out] param pointer to parameter structure
+ * \return status of the operation
+ */
+uint8_t aes132h_nonce(struct aes132h_nonce_in_out *param)
+{
+	uint8_t block[AES128_BLOCK_SIZE];
+	struct aes128_key key;
+
+	if (!param || !param->in_seed || !param->nonce
+				|| ((param->mode & AES132H_NONCE_MODE_RANDOM) && !param->rand_out))
+		return AES132_FUNCTION_RETCODE_BAD_PARAM;
+
+	if (param->mode & AES132H_NONCE_MODE_RANDOM) {
+		memcpy(block, param->in_seed, AES132H_IN_SEED_SIZE);
+		memset(&block[AES132H_IN_SEED_SIZE], 0, sizeof(block) - AES132H_IN_SEED_SIZE);
+		aes128_key_init(&key, param->rand_out);
+		aes128_encrypt(&key, block, block);
+		memcpy(param->nonce->value, block, AES132H_NONCE_SIZE);
+		param->nonce->random = 1;
+		cryptoauth_wipe(&key, sizeof(key));
+	}
+	else {
+		memcpy(param->nonce->value, param->in_seed, AES132H_NONCE_SIZE);
+		param->nonce->random = 0;
+	}
+	param->nonce->mac_count = 0;
+	param->nonce->valid = 1;
+
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function checks the parameters of a MAC calculation.
+ *
+ * \param[in] param pointer to parameter structure
+ * \return status of the operation
+ */
+static uint8_t aes132h_mac_check_param(const struct aes132h_mac_in_out *param)
+{
+	if (!param || !param->key || !param->nonce || !param->manufacturing_id || !param->mac
+				|| param->data_len > AES132H_DATA_SIZE_MAX
+				|| (param->data_len && (!param->in_data || !param->out_data)))
+		return AES132_FUNCTION_RETCODE_BAD_PARAM;
+
+	if (!param->nonce->valid || param->nonce->mac_count >= AES132H_MAC_COUNT_MAX)
+		return AES132_FUNCTION_RETCODE_NONCE_INVALID;
+
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function formats the CCM nonce and the authenticate-only data of a MAC,
+ *         and increments MacCount.
+ *
+ * \param[in,out] param pointer to parameter structure, checked by aes132h_mac_check_param()
+ * \param[in] device 1 if the device generated the MAC, 0 if the host does
+ * \param[out] ccm_nonce 13-byte CCM nonce: Nonce{12} || MacCount{1}
+ * \param[out] aad 14-byte authenticate-only data of block B1
+ */
+static void aes132h_mac_format(struct aes132h_mac_in_out *param, uint8_t device, uint8_t *ccm_nonce, uint8_t *aad)
+{
+	memcpy(ccm_nonce, param->nonce->value, AES132H_NONCE_SIZE);
+	ccm_nonce[AES132H_NONCE_SIZE] = param->nonce->mac_count++;
+
+	memset(aad, 0, AES132H_AAD_SIZE);
+	aad[0] = param->manufacturing_id[0];
+	aad[1] = param->manufacturing_id[1];
+	aad[2] = param->opcode;
+	aad[3] = param->mode;
+	aad[4] = (uint8_t) (param->param1 >> 8);
+	aad[5] = (uint8_t) param->param1;
+	aad[6] = (uint8_t) (param->param2 >> 8);
+	aad[7] = (uint8_t) param->param2;
+	aad[8] = (device ? AES132H_MAC_FLAG_DEVICE : 0) | (param->nonce->random ? AES132H_MAC_FLAG_RANDOM : 0);
+}
+
+
+/** \brief This function calculates the MAC and encrypted data the host sends with a command.
+ *
+ * Use it for the input MAC of an Auth command and for the data and MAC of an
+ * EncWrite command.
+ *
+ * \param[in,out] param pointer to parameter structure
+ * \return status of the operation
+ */
+uint8_t aes132h_mac_compute(struct aes132h_mac_in_out *param)
+{
+	uint8_t ccm_nonce[AES132H_CCM_NONCE_SIZE];
+	uint8_t aad[AES132H_AAD_SIZE];
+	uint8_t ret_code = aes132h_mac_check_param(param);
+
+	if (ret_code != AES132_FUNCTION_RETCODE_SUCCESS)
+		return ret_code;
+
+	aes132h_mac_format(param, 0, ccm_nonce, aad);
+	aes128_ccm_encrypt(param->key, sizeof(ccm_nonce), ccm_nonce, sizeof(aad), aad,
+				param->data_len, param->in_data, param->out_data, AES132H_MAC_SIZE, param->mac);
+
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function checks the MAC of a response and decrypts its data.
+ *
+ * Use it for the output MAC of an Auth command and for the data and MAC of an
+ * EncRead response. If the MAC does not match, the decrypted data are wiped.
+ *
+ * \param[in,out] param pointer to parameter structure
+ * \return status of the operation
+ */
+uint8_t aes132h_mac_check(struct aes132h_mac_in_out *param)
+{
+	uint8_t i, diff = 0;
+	uint8_t ccm_nonce[AES132H_CCM_NONCE_SIZE];
+	uint8_t aad[AES132H_AAD_SIZE];
+	uint8_t mac[AES132H_MAC_SIZE];
+	uint8_t ret_code = aes132h_mac_check_param(param);
+
+	if (ret_code != AES132_FUNCTION_RETCODE_SUCCESS)
+		return ret_code;
+
+	aes132h_mac_format(param, 1, ccm_nonce, aad);
+	aes128_ccm_decrypt(param->key, sizeof(ccm_nonce), ccm_nonce, sizeof(aad), aad,
+				param->data_len, param->in_data, param->out_data, AES132H_MAC_SIZE, mac);
+
+	for (i = 0; i < AES132H_MAC_SIZE; i++)
+		diff |= mac[i] ^ param->mac[i];
+	if (diff) {
+		if (param->data_len)
+			cryptoauth_wipe(param->out_data, param->data_len);
+		return AES132_FUNCTION_RETCODE_MAC_MISMATCH;
+	}
+
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function computes or checks the MACs of up to #AES128_LANES_MAX commands.
+ *
+ * The counter blocks of all commands are encrypted first, eight at a time. Then the
+ * CBC-MAC chains of all commands advance together, one block per step, so every
+ * step encrypts one block per command in one aes128_encrypt_lanes() call.
+ *
+ * \param[in] count number of commands, at most #AES128_LANES_MAX
+ * \param[in,out] params parameter structures of the commands
+ * \param[in] device 1: check MACs generated by the devices, 0: compute MACs for the devices
+ * \param[out] results status of every command
+ */
+static void aes132h_mac_lanes(uint8_t count, struct aes132h_mac_in_out *params, uint8_t device, uint8_t *results)
+{
+	uint8_t i, j, k, lane, block_count, diff;
+	uint8_t ccm_nonce[AES132H_CCM_NONCE_SIZE];
+	uint8_t blocks[AES128_LANES_MAX][AES132H_MAC_BLOCKS_MAX][AES128_BLOCK_SIZE];
+	uint8_t mac_block_count[AES128_LANES_MAX];
+	uint8_t stream[AES128_LANES_MAX * AES132H_COUNTER_BLOCKS_MAX][AES128_BLOCK_SIZE];
+	uint8_t stream_first[AES128_LANES_MAX];
+	const struct aes128_key *stream_keys[AES128_LANES_MAX * AES132H_COUNTER_BLOCKS_MAX];
+	uint8_t stream_count = 0;
+	uint8_t chain[AES128_LANES_MAX][AES128_BLOCK_SIZE];
+	uint8_t lanes[AES128_LANES_MAX][AES128_BLOCK_SIZE];
+	const struct aes128_key *lane_keys[AES128_LANES_MAX];
+	uint8_t lane_command[AES128_LANES_MAX];
+	struct aes132h_mac_in_out *param;
+
+	// B0, B1 and the counter blocks of every command
+	for (i = 0; i < count; i++) {
+		param = &params[i];
+		mac_block_count[i] = 0;
+		results[i] = aes132h_mac_check_param(param);
+		if (results[i] != AES132_FUNCTION_RETCODE_SUCCESS)
+			continue;
+
+		block_count = (param->data_len + AES128_BLOCK_SIZE - 1) / AES128_BLOCK_SIZE;
+		mac_block_count[i] = 2 + block_count;
+		memset(blocks[i], 0, sizeof(blocks[i]));
+		aes132h_mac_format(param, device, ccm_nonce, &blocks[i][1][2]);
+		blocks[i][0][0] = 0x79;
+		memcpy(&blocks[i][0][1], ccm_nonce, sizeof(ccm_nonce));
+		blocks[i][0][AES128_BLOCK_SIZE - 1] = param->data_len;
+		blocks[i][1][1] = AES132H_AAD_SIZE;
+
+		stream_first[i] = stream_count;
+		for (j = 0; j <= block_count; j++, stream_count++) {
+			memset(stream[stream_count], 0, AES128_BLOCK_SIZE);
+			stream[stream_count][0] = 0x01;
+			memcpy(&stream[stream_count][1], ccm_nonce, sizeof(ccm_nonce));
+			stream[stream_count][AES128_BLOCK_SIZE - 1] = j;
+			stream_keys[stream_count] = param->key;
+		}
+	}
+
+	// key stream
+	for (j = 0; j < stream_count; j += AES128_LANES_MAX) {
+		k = stream_count - j < AES128_LANES_MAX ? stream_count - j : AES128_LANES_MAX;
+		aes128_encrypt_lanes(k, &stream_keys[j], stream[j], stream[j]);
+	}
+
+	// Data blocks enter the CBC-MAC as clear text.
+	for (i = 0; i < count; i++) {
+		param = &params[i];
+		if (!mac_block_count[i] || !param->data_len)
+			continue;
+		memcpy(blocks[i][2], param->in_data, param->data_len);
+		for (j = 0; j < param->data_len; j++) {
+			k = stream[stream_first[i] + 1 + j / AES128_BLOCK_SIZE][j % AES128_BLOCK_SIZE];
+			if (device)
+				blocks[i][2 + j / AES128_BLOCK_SIZE][j % AES128_BLOCK_SIZE] ^= k;
+			else
+				param->out_data[j] = param->in_data[j] ^ k;
+		}
+		if (device)
+			memcpy(param->out_data, blocks[i][2], param->data_len);
+	}
+
+	// CBC-MAC, one block of every command per step
+	memset(chain, 0, sizeof(chain));
+	for (j = 0; j < AES132H_MAC_BLOCKS_MAX; j++) {
+		lane = 0;
+		for (i = 0; i < count; i++) {
+			if (j >= mac_block_count[i])
+				continue;
+			for (k = 0; k < AES128_BLOCK_SIZE; k++)
+				lanes[lane][k] = chain[i][k] ^ blocks[i][j][k];
+			lane_keys[lane] = params[i].key;
+			lane_command[lane++] = i;
+		}
+		if (!lane)
+			break;
+		aes128_encrypt_lanes(lane, lane_keys, lanes[0], lanes[0]);
+		for (k = 0; k < lane; k++)
+			memcpy(chain[lane_command[k]], lanes[k], AES128_BLOCK_SIZE);
+	}
+
+	// MAC = CBC-MAC XOR E(A0)
+	for (i = 0; i < count; i++) {
+		if (!mac_block_count[i])
+			continue;
+		param = &params[i];
+		if (!device) {
+			for (k = 0; k < AES132H_MAC_SIZE; k++)
+				param->mac[k] = chain[i][k] ^ stream[stream_first[i]][k];
+			continue;
+		}
+		diff = 0;
+		for (k = 0; k < AES132H_MAC_SIZE; k++)
+			diff |= chain[i][k] ^ stream[stream_first[i]][k] ^ param->mac[k];
+		if (diff) {
+			if (param->data_len)
+				cryptoauth_wipe(param->out_data, param->data_len);
+			results[i] = AES132_FUNCTION_RETCODE_MAC_MISMATCH;
+		}
+	}
+
+	cryptoauth_wipe(blocks, sizeof(blocks));
+	cryptoauth_wipe(stream, sizeof(stream));
+	cryptoauth_wipe(lanes, sizeof(lanes));
+}
+
+
+/** \brief This function calculates the MACs and encrypted data of many commands.
+ *
+ * It gives the same results as calling aes132h_mac_compute() for every command in
+ * order, including commands that share a nonce register.
+ *
+ * \param[in] count number of commands
+ * \param[in,out] params parameter structures of the commands
+ * \param[out] results status of every command
+ */
+void aes132h_mac_compute_batch(uint32_t count, struct aes132h_mac_in_out *params, uint8_t *results)
+{
+	uint32_t i;
+
+	for (i = 0; i < count; i += AES128_LANES_MAX)
+		aes132h_mac_lanes(count - i < AES128_LANES_MAX ? (uint8_t) (count - i) : AES128_LANES_MAX,
+					&params[i], 0, &results[i]);
+}
+
+
+/** \brief This function checks the MACs of many responses and decrypts their data.
+ *
+ * It gives the same results as calling aes132h_mac_check() for every response in
+ * order, including responses that share a nonce register.
+ *
+ * \param[in] count number of responses
+ * \param[in,out] params parameter structures of the responses
+ * \param[out] results status of every response
+ */
+void aes132h_mac_check_batch(uint32_t count, struct aes132h_mac_in_out *params, uint8_t *results)
+{
+	uint32_t i;
+
+	for (i = 0; i < count; i += AES128_LANES_MAX)
+		aes132h_mac_lanes(count - i < AES128_LANES_MAX ? (uint8_t) (count - i) : AES128_LANES_MAX,
+					&params[i], 1, &results[i]);
+}
@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------------------
+//         ATMEL Crypto-Devices Software Support  -  Colorado Springs, CO -
+// ----------------------------------------------------------------------------
+// DISCLAIMER:  THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+// DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+// OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+/** \file
+ *  \brief  Definitions and Prototypes for AES132 Helper Functions
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ */
+
+#ifndef AES132_HELPER_H
+#   define AES132_HELPER_H
+
+#include <stdint.h>
+
+#include "aes128.h"
+
+
+/** \defgroup aes132_helper AES132 Helper Functions
+ *
+ * \brief
+ * These functions calculate on the host what the AES132 device calculates: its
+ * nonce, the MACs of its commands and responses, and the encrypted data of EncRead
+ * and EncWrite. A host uses them to check an Auth or EncRead response, and to build
+ * the input MAC and encrypted data of an Auth or EncWrite command. Unlike the
+ * library modules, this module does not need AES132_I2C or AES132_SPI to be defined.
+ *
+ * All MACs are AES-CCM with a 16-byte tag, using the 12-byte nonce register
+ * followed by MacCount as the 13-byte CCM nonce. The blocks are:
+ *
+ *   B0: 0x79 || Nonce{12} || MacCount{1} || DataLength{2}\n
+ *   B1: 0x00 0x0E || ManufacturingID{2} || Opcode{1} || Mode{1} || Param1{2} || Param2{2} || MacFlag{1} || 0x00{5}\n
+ *   B2, B3: data, padded with zeros (EncRead and EncWrite only)\n
+ *   A(i): 0x01 || Nonce{12} || MacCount{1} || i{2}
+ *
+ * MacCount starts at zero with every Nonce command and is incremented with every
+ * MAC the device generates or checks. struct aes132h_nonce tracks it on the host.
+ *
+ * Servers checking the responses of many devices call aes132h_mac_check_batch().
+ * It runs the AES blocks of up to #AES128_LANES_MAX devices side by side.
+@{ */
+
+// ------------------------ library return codes ------------------------------
+#ifndef AES132_FUNCTION_RETCODE_SUCCESS
+#   define AES132_FUNCTION_RETCODE_SUCCESS           ((uint8_t) 0x00) //!< Function succeeded.
+#endif
+#define AES132_FUNCTION_RETCODE_MAC_MISMATCH         ((uint8_t) 0xD1) //!< MAC of the response does not match the calculated one.
+#define AES132_FUNCTION_RETCODE_NONCE_INVALID        ((uint8_t) 0xE1) //!< Nonce is not valid, or MacCount is exhausted.
+#define AES132_FUNCTION_RETCODE_BAD_PARAM            ((uint8_t) 0xE2) //!< bad argument (out of range, null pointer, etc.)
+
+
+// ------------------------ helper definitions --------------------------------
+#define AES132H_NONCE_SIZE                ((uint8_t) 12)     //!< size of the nonce register
+#define AES132H_IN_SEED_SIZE              ((uint8_t) 12)     //!< size of InSeed of the Nonce command
+#define AES132H_RAND_OUT_SIZE             ((uint8_t) 16)     //!< size of RandOut of the Nonce command
+#define AES132H_MAC_SIZE                  ((uint8_t) 16)     //!< size of a MAC
+#define AES132H_DATA_SIZE_MAX             ((uint8_t) 32)     //!< maximum size of EncRead and EncWrite data
+#define AES132H_MANUFACTURING_ID_SIZE     ((uint8_t)  2)     //!< size of the ManufacturingID configuration field
+#define AES132H_MAC_COUNT_MAX             ((uint8_t) 255)    //!< MacCount at which a new nonce is needed
+
+#define AES132H_NONCE_MODE_RANDOM         ((uint8_t) 0x01)   //!< Nonce mode bit: combine InSeed with a random number
+
+#define AES132H_MAC_FLAG_DEVICE           ((uint8_t) 0x01)   //!< MacFlag bit: MAC generated by the device
+#define AES132H_MAC_FLAG_RANDOM           ((uint8_t) 0x02)   //!< MacFlag bit: nonce is random
+
+
+/** \struct aes132h_nonce
+ *  \brief Structure to hold the host copy of the nonce register
+ *  \var aes132h_nonce::value
+ *       \brief The value of the nonce register.
+ *  \var aes132h_nonce::mac_count
+ *       \brief Number of MACs generated or checked since the Nonce command.
+ *  \var aes132h_nonce::random
+ *       \brief 1 if the nonce was combined with a random number, 0 if it is InSeed.
+ *  \var aes132h_nonce::valid
+ *       \brief Indicates if the nonce is valid.
+ */
+struct aes132h_nonce {
+	uint8_t value[AES132H_NONCE_SIZE];
+	uint8_t mac_count;
+	uint8_t random;
+	uint8_t valid;
+};
+
+
+/** \struct aes132h_nonce_in_out
+ *  \brief Input/output parameters for function aes132h_nonce().
+ *  \var aes132h_nonce_in_out::mode
+ *       \brief [in] Mode parameter used in Nonce command.
+ *  \var aes132h_nonce_in_out::in_seed
+ *       \brief [in] Pointer to 12-byte InSeed data used in Nonce command.
+ *  \var aes132h_nonce_in_out::rand_out
+ *       \brief [in] Pointer to 16-byte RandOut data from Nonce command (random mode only).
+ *  \var aes132h_nonce_in_out::nonce
+ *       \brief [out] Pointer to the host copy of the nonce register.
+ */
+struct aes132h_nonce_in_out {
+	uint8_t mode;
+	const uint8_t *in_seed;
+	const uint8_t *rand_out;
+	struct aes132h_nonce *nonce;
+};
+
+
+/** \struct aes132h_mac_in_out
+ *  \brief Input/output parameters for the aes132h_mac_* functions.
+ *  \var aes132h_mac_in_out::key
+ *       \brief [in] Pointer to the expanded key the device uses for this command.
+ *  \var aes132h_mac_in_out::nonce
+ *       \brief [in,out] Pointer to the nonce register of the device. MacCount is incremented.
+ *  \var aes132h_mac_in_out::manufacturing_id
+ *       \brief [in] Pointer to the 2-byte ManufacturingID of the device configuration.
+ *  \var aes132h_mac_in_out::opcode
+ *       \brief [in] Op-code of the command.
+ *  \var aes132h_mac_in_out::mode
+ *       \brief [in] Mode parameter of the command.
+ *  \var aes132h_mac_in_out::param1
+ *       \brief [in] Param1 of the command.
+ *  \var aes132h_mac_in_out::param2
+ *       \brief [in] Param2 of the command.
+ *  \var aes132h_mac_in_out::data_len
+ *       \brief [in] Number of data bytes, 0 for a MAC over the command only.
+ *  \var aes132h_mac_in_out::in_data
+ *       \brief [in] Pointer to clear text (compute) or encrypted data (check).
+ *  \var aes132h_mac_in_out::out_data
+ *       \brief [out] Pointer to encrypted data (compute) or clear text (check), may equal in_data.
+ *  \var aes132h_mac_in_out::mac
+ *       \brief [out] MAC to send (compute), [in] MAC received (check).
+ */
+struct aes132h_mac_in_out {
+	const struct aes128_key *key;
+	struct aes132h_nonce *nonce;
+	const uint8_t *manufacturing_id;
+	uint8_t opcode;
+	uint8_t mode;
+	uint16_t param1;
+	uint16_t param2;
+	uint8_t data_len;
+	const uint8_t *in_data;
+	uint8_t *out_data;
+	uint8_t *mac;
+};
+
+
+uint8_t aes132h_nonce(struct aes132h_nonce_in_out *param);
+uint8_t aes132h_mac_compute(struct aes132h_mac_in_out *param);
+uint8_t aes132h_mac_check(struct aes132h_mac_in_out *param);
+void aes132h_mac_compute_batch(uint32_t count, struct aes132h_mac_in_out *params, uint8_t *results);
+void aes132h_mac_check_batch(uint32_t count, struct aes132h_mac_in_out *params, uint8_t *results);
+
+/** @} */
+
+#endif
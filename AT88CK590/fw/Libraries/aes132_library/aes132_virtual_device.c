@@ -0,0 +1,615 @@
+// ----------------------------------------------------------------------------
+//         ATMEL Crypto-Devices Software Support  -  Colorado Springs, CO -
+// ----------------------------------------------------------------------------
+// DISCLAIMER:  THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+// DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+// OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+/** \file
+ *  \brief 	This file contains the virtual device layer of the AES132 library.
+ *  \author Atmel Crypto Products
+ *  \date 	October 17, 2026
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "aes132_commands.h"
+
+
+//! attached devices
+static struct {
+	uint8_t id;
+	struct aes132d_device *device;
+} aes132d_devices[AES132D_DEVICES_MAX];
+
+//! number of attached devices
+static uint8_t aes132d_device_count;
+
+//! ID of the selected device
+static uint8_t aes132d_id_current = AES132D_DEFAULT_ID;
+
+//! bus time in us
+static uint32_t aes132d_time;
+
+//! fault injector of the bus
+static struct fault_injector *aes132d_faults;
+
+//! whether the selected device lost synchronization and reads as 0xFF
+static uint8_t aes132d_sync_lost;
+
+
+/** \brief execution times in us of the op-codes after parsing
+ *
+ * The values are estimates of typical times. Set the entries of
+ * aes132d_device::execution_time to profile other ones.
+ */
+static const uint32_t aes132d_execution_time_default[AES132D_OPCODE_COUNT] = {
+	  200,    //!< Reset
+	 2000,    //!< Nonce
+	 2000,    //!< Random
+	 3000,    //!< Auth
+	 3000,    //!< EncRead
+	 5000,    //!< EncWrite
+	 3000,    //!< Encrypt
+	 3000,    //!< Decrypt
+	 5000,    //!< KeyCreate
+	 5000,    //!< KeyLoad
+	 5000,    //!< Counter
+	 1000,    //!< Crunch
+	  200,    //!< Info
+	 5000,    //!< Lock
+	60000,    //!< TempSense
+	 1000,    //!< Legacy
+	  200,    //!< BlockRead
+	    0,    //!< Sleep
+	    0,    //!< unused
+	 2000,    //!< NonceCompute
+	 3000,    //!< AuthCompute
+	 3000,    //!< AuthCheck
+	 3000,    //!< WriteCompute
+	 3000,    //!< DecRead
+	 3000,    //!< KeyExport
+	 5000,    //!< KeyImport
+	 5000     //!< KeyTransfer
+};
+
+
+/** \brief This function initializes a virtual device.
+ *
+ * The user memory is erased to 0xFF, and the device is awake and in power-up state.
+ * \param[out] device pointer to the device
+ * \param[in] seed pointer to 16-byte seed of the random number generator, or NULL for zeros
+ */
+void aes132d_device_init(struct aes132d_device *device, const uint8_t *seed)
+{
+	uint8_t key[AES128_KEY_SIZE];
+
+	memset(device, 0, sizeof(*device));
+	memset(device->memory, 0xFF, sizeof(device->memory));
+	memset(key, 0, sizeof(key));
+	if (seed)
+		memcpy(key, seed, sizeof(key));
+	aes128_key_init(&device->seed, key);
+	device->state = AES132D_STATE_AWAKE;
+	device->chip_state = AES132D_CHIP_STATE_POWER_UP;
+	memcpy(device->execution_time, aes132d_execution_time_default, sizeof(device->execution_time));
+}
+
+
+/** \brief This function attaches a device under an ID, or detaches the device with this ID.
+ * \param[in] id device ID as passed to aes132p_select_device()
+ * \param[in] device pointer to the device, or NULL to detach
+ * \return status of the operation
+ */
+uint8_t aes132d_attach(uint8_t id, struct aes132d_device *device)
+{
+	uint8_t i;
+
+	id &= ~1;
+	for (i = 0; i < aes132d_device_count; i++) {
+		if (aes132d_devices[i].id != id)
+			continue;
+		if (device) {
+			aes132d_devices[i].device = device;
+			return AES132_FUNCTION_RETCODE_SUCCESS;
+		}
+		aes132d_devices[i] = aes132d_devices[--aes132d_device_count];
+		return AES132_FUNCTION_RETCODE_SUCCESS;
+	}
+	if (!device)
+		return AES132_FUNCTION_RETCODE_SUCCESS;
+	if (aes132d_device_count >= AES132D_DEVICES_MAX)
+		return AES132_FUNCTION_RETCODE_DEVICE_SELECT_FAIL;
+
+	aes132d_devices[aes132d_device_count].id = id;
+	aes132d_devices[aes132d_device_count++].device = device;
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function returns the device attached under an ID.
+ * \param[in] id device ID
+ * \return pointer to the device, or NULL if none is attached
+ */
+struct aes132d_device *aes132d_get_device(uint8_t id)
+{
+	uint8_t i;
+
+	id &= ~1;
+	for (i = 0; i < aes132d_device_count; i++)
+		if (aes132d_devices[i].id == id)
+			return aes132d_devices[i].device;
+
+	return (struct aes132d_device *) 0;
+}
+
+
+/** \brief This function returns the bus time.
+ * \return time in us the accesses to all devices took, including the polling of the Communication layer
+ */
+uint32_t aes132d_get_time(void)
+{
+	return aes132d_time;
+}
+
+
+/** \brief This function places a fault injector between the Communication layer and the devices.
+ * \param[in] injector pointer to the injector, NULL to stop injecting faults
+ */
+void aes132d_set_fault_injector(struct fault_injector *injector)
+{
+	aes132d_faults = injector;
+	aes132d_sync_lost = 0;
+}
+
+
+/** \brief This function checks whether a bus time has been reached.
+ * \param[in] time bus time in us
+ * \return 1 if the bus clock is at or past the time, 0 otherwise
+ */
+static uint8_t aes132d_reached(uint32_t time)
+{
+	return (int32_t) (aes132d_time - time) >= 0;
+}
+
+
+/** \brief This function generates a random number.
+ * \param[in] device pointer to the device
+ * \param[out] random pointer to 16-byte buffer
+ */
+static void aes132d_random(struct aes132d_device *device, uint8_t *random)
+{
+	uint8_t block[AES128_BLOCK_SIZE];
+
+	memset(block, 0, sizeof(block));
+	block[0] = device->random_count & 0xFF;
+	block[1] = (device->random_count >> 8) & 0xFF;
+	block[2] = (device->random_count >> 16) & 0xFF;
+	block[3] = (device->random_count >> 24) & 0xFF;
+	aes128_encrypt(&device->seed, block, random);
+	device->random_count++;
+}
+
+
+/** \brief This function places a response into the buffer.
+ * \param[in] device pointer to the device
+ * \param[in] return_code response return code
+ * \param[in] count number of data bytes
+ * \param[in] data pointer to data bytes, may point into the buffer
+ */
+static void aes132d_respond(struct aes132d_device *device, uint8_t return_code, uint8_t count, const uint8_t *data)
+{
+	uint8_t *buffer = device->buffer;
+	uint8_t size = count + AES132_RESPONSE_SIZE_MIN;
+
+	if (count)
+		memmove(&buffer[AES132_RESPONSE_INDEX_DATA], data, count);
+	buffer[AES132_RESPONSE_INDEX_COUNT] = size;
+	buffer[AES132_RESPONSE_INDEX_RETURN_CODE] = return_code;
+	aes132c_calculate_crc(size - AES132_CRC_SIZE, buffer, &buffer[size - AES132_CRC_SIZE]);
+
+	if (return_code == AES132_DEVICE_RETCODE_SUCCESS)
+		device->status &= ~AES132_DEVICE_ERROR_BIT;
+	else
+		device->status |= AES132_DEVICE_ERROR_BIT;
+	device->response_ready = 1;
+}
+
+
+/** \brief This function checks the address range of a user memory access.
+ * \param[in] word_address first address
+ * \param[in] count number of bytes
+ * \param[in] page_size size of the pages the access must not cross
+ * \return device return code
+ */
+static uint8_t aes132d_check_range(uint16_t word_address, uint8_t count, uint16_t page_size)
+{
+	if (count == 0 || count > AES132_MEM_ACCESS_MAX)
+		return AES132_DEVICE_RETCODE_COUNT_ERROR;
+	if (word_address >= AES132D_USER_MEMORY_SIZE)
+		return AES132_DEVICE_RETCODE_BAD_ADDR;
+	if (word_address / page_size != (word_address + count - 1) / page_size)
+		return AES132_DEVICE_RETCODE_BOUNDARY_ERROR;
+
+	return AES132_DEVICE_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function executes the command in the buffer and places its response there.
+ * \param[in] device pointer to the device
+ * \return execution time in us after parsing
+ */
+static uint32_t aes132d_execute(struct aes132d_device *device)
+{
+	uint8_t *command = device->buffer;
+	uint8_t count = command[AES132_COMMAND_INDEX_COUNT];
+	uint8_t op_code = command[AES132_COMMAND_INDEX_OPCODE];
+	uint8_t mode = command[AES132_COMMAND_INDEX_MODE];
+	uint16_t param1 = (command[AES132_COMMAND_INDEX_PARAM1_MSB] << 8) | command[AES132_COMMAND_INDEX_PARAM1_LSB];
+	uint16_t param2 = (command[AES132_COMMAND_INDEX_PARAM2_MSB] << 8) | command[AES132_COMMAND_INDEX_PARAM2_LSB];
+	uint8_t data_count = count - AES132_COMMAND_SIZE_MIN;
+	uint8_t data[AES132D_BUFFER_SIZE];
+	uint8_t return_code = AES132_DEVICE_RETCODE_SUCCESS;
+	uint8_t response_count = 0;
+	struct aes132h_nonce_in_out nonce_param;
+
+	device->statistics.commands++;
+
+	switch (op_code) {
+	case AES132_OPCODE_INFO:
+		data[0] = 0;
+		data[1] = 0;
+		response_count = 2;
+		if (param1 == AES132_INFO_MAC_COUNT)
+			data[1] = device->nonce.mac_count;
+		else if (param1 == AES132_INFO_DEVICE_AUTH_OK)
+			data[0] = data[1] = 0xFF;
+		else if (param1 == AES132_INFO_DEV_NUM) {
+			data[0] = AES132D_DEV_NUM >> 8;
+			data[1] = AES132D_DEV_NUM & 0xFF;
+		}
+		else if (param1 == AES132_INFO_CHIP_STATE) {
+			data[0] = device->chip_state >> 8;
+			data[1] = device->chip_state & 0xFF;
+		}
+		else {
+			return_code = AES132_DEVICE_RETCODE_PARSE_ERROR;
+			response_count = 0;
+		}
+		break;
+
+	case AES132_OPCODE_RANDOM:
+		if (data_count != 0) {
+			return_code = AES132_DEVICE_RETCODE_PARSE_ERROR;
+			break;
+		}
+		aes132d_random(device, data);
+		response_count = AES132D_RANDOM_SIZE;
+		break;
+
+	case AES132_OPCODE_NONCE:
+		if (data_count != AES132H_IN_SEED_SIZE) {
+			return_code = AES132_DEVICE_RETCODE_PARSE_ERROR;
+			break;
+		}
+		nonce_param.mode = mode;
+		nonce_param.in_seed = &command[AES132_COMMAND_SIZE_MIN - AES132_CRC_SIZE];
+		nonce_param.rand_out = data;
+		nonce_param.nonce = &device->nonce;
+		if (mode & AES132H_NONCE_MODE_RANDOM) {
+			aes132d_random(device, data);
+			response_count = AES132H_RAND_OUT_SIZE;
+		}
+		(void) aes132h_nonce(&nonce_param);
+		break;
+
+	case AES132_OPCODE_BLOCK_READ:
+		return_code = (param2 > AES132_MEM_ACCESS_MAX ? AES132_DEVICE_RETCODE_COUNT_ERROR
+					: aes132d_check_range(param1, (uint8_t) param2, AES132D_USER_MEMORY_SIZE));
+		if (return_code != AES132_DEVICE_RETCODE_SUCCESS)
+			break;
+		memcpy(data, &device->memory[param1], param2);
+		response_count = (uint8_t) param2;
+		break;
+
+	case AES132_OPCODE_TEMP_SENSE:
+		data[0] = AES132D_TEMP_CODE_HIGH >> 8;
+		data[1] = AES132D_TEMP_CODE_HIGH & 0xFF;
+		data[2] = AES132D_TEMP_CODE_LOW >> 8;
+		data[3] = AES132D_TEMP_CODE_LOW & 0xFF;
+		response_count = 4;
+		break;
+
+	case AES132_OPCODE_RESET:
+		device->nonce.valid = 0;
+		break;
+
+	case AES132_OPCODE_SLEEP:
+		// The device goes to sleep without a response.
+		device->state = (mode == AES132_COMMAND_MODE_STANDBY ? AES132D_STATE_STANDBY : AES132D_STATE_SLEEP);
+		if (device->state == AES132D_STATE_SLEEP)
+			device->nonce.valid = 0;
+		return 0;
+
+	default:
+		return_code = AES132_DEVICE_RETCODE_PARSE_ERROR;
+		break;
+	}
+
+	device->chip_state = AES132D_CHIP_STATE_ACTIVE;
+	aes132d_respond(device, return_code, response_count, data);
+
+	return (return_code == AES132_DEVICE_RETCODE_SUCCESS && op_code < AES132D_OPCODE_COUNT
+				? device->execution_time[op_code] : 0);
+}
+
+
+/** \brief This function checks the command in the buffer once a write to the I/O buffer has ended.
+ * \param[in] device pointer to the device
+ */
+static void aes132d_receive_command(struct aes132d_device *device)
+{
+	uint8_t count = device->buffer[AES132_COMMAND_INDEX_COUNT];
+	uint8_t count_valid = (count >= AES132_COMMAND_SIZE_MIN && count <= AES132_COMMAND_SIZE_MAX);
+	uint8_t crc[AES132_CRC_SIZE] = {0, 0};
+	uint32_t execution_time;
+
+	if (count_valid && device->index < count)
+		// Wait for the remainder of the command.
+		return;
+
+	// The response is read from the start of the buffer.
+	device->index = 0;
+	if (count_valid)
+		aes132c_calculate_crc(count - AES132_CRC_SIZE, device->buffer, crc);
+	if (!count_valid || crc[0] != device->buffer[count - AES132_CRC_SIZE]
+				|| crc[1] != device->buffer[count - AES132_CRC_SIZE + 1]) {
+		// An invalid count byte is treated like a corrupted packet.
+		device->status |= AES132_CRC_ERROR_BIT;
+		device->statistics.crc_errors++;
+		return;
+	}
+
+	execution_time = aes132d_execute(device);
+	if (device->state != AES132D_STATE_AWAKE)
+		return;
+
+	device->nack_until = aes132d_time + AES132D_PARSE_TIME;
+	device->ready_at = device->nack_until + execution_time;
+}
+
+
+/** \brief This function writes user memory and places the return code into the buffer.
+ * \param[in] device pointer to the device
+ * \param[in] count number of bytes to write
+ * \param[in] word_address address to write to
+ * \param[in] data pointer to the bytes to write
+ */
+static void aes132d_write_memory(struct aes132d_device *device, uint8_t count, uint16_t word_address, const uint8_t *data)
+{
+	uint8_t return_code = aes132d_check_range(word_address, count, AES132D_PAGE_SIZE);
+
+	device->statistics.memory_writes++;
+	device->index = 0;
+	device->nack_until = aes132d_time + AES132D_PARSE_TIME;
+	if (return_code == AES132_DEVICE_RETCODE_SUCCESS) {
+		memcpy(&device->memory[word_address], data, count);
+		device->nack_until = aes132d_time + AES132D_WRITE_TIME;
+	}
+	device->ready_at = device->nack_until;
+	aes132d_respond(device, return_code, 0, (uint8_t *) 0);
+}
+
+
+/** \brief This function returns the selected device if it acknowledges its address.
+ *
+ * It advances the bus clock by the duration of a not acknowledged access if the device
+ * is missing, busy, or asleep. A device in Sleep or Standby mode starts waking up.
+ * \return pointer to the device, or NULL if it does not acknowledge
+ */
+static struct aes132d_device *aes132d_address(void)
+{
+	struct aes132d_device *device = aes132d_get_device(aes132d_id_current);
+
+	if (device && device->state != AES132D_STATE_AWAKE) {
+		device->nack_until = aes132d_time + (device->state == AES132D_STATE_SLEEP
+					? AES132D_WAKEUP_TIME_SLEEP : AES132D_WAKEUP_TIME_STANDBY);
+		device->ready_at = device->nack_until;
+		if (device->state == AES132D_STATE_SLEEP)
+			device->chip_state = AES132D_CHIP_STATE_WAKEUP;
+		device->state = AES132D_STATE_AWAKE;
+		device->response_ready = 0;
+		device->index = 0;
+		device->statistics.wakeups++;
+	}
+	else if (device && aes132d_reached(device->nack_until) && !fault_inject(aes132d_faults, FAULT_ACK))
+		return device;
+
+	aes132d_time += AES132_STATUS_REG_POLL_TIME_NACK;
+	if (device)
+		device->statistics.nacks++;
+
+	return (struct aes132d_device *) 0;
+}
+
+
+/** \brief This function returns the value of the device status register.
+ * \param[in] device pointer to the device
+ * \return register value
+ */
+static uint8_t aes132d_status_register(const struct aes132d_device *device)
+{
+	if (!aes132d_reached(device->ready_at))
+		return device->status | AES132_WIP_BIT;
+	if (device->response_ready)
+		return device->status | AES132_RESPONSE_READY_BIT;
+
+	return device->status;
+}
+
+
+/** \brief This function lets the fault injector corrupt bytes read from a response.
+ * \param[in] device pointer to the device
+ * \param[in] start buffer index of the first byte read
+ * \param[in] size number of bytes read
+ * \param[in, out] data pointer to the bytes read
+ */
+static void aes132d_corrupt_response(const struct aes132d_device *device, uint8_t start, uint8_t size, uint8_t *data)
+{
+	uint8_t count = device->buffer[AES132_RESPONSE_INDEX_COUNT];
+	uint8_t crc_index;
+
+	if (aes132d_sync_lost || ((start == AES132_RESPONSE_INDEX_COUNT) && fault_inject(aes132d_faults, FAULT_SYNC))) {
+		aes132d_sync_lost = 1;
+		memset(data, 0xFF, size);
+		return;
+	}
+
+	if ((start == AES132_RESPONSE_INDEX_COUNT) && fault_inject(aes132d_faults, FAULT_COUNT))
+		data[0] = (uint8_t) (fault_random(aes132d_faults) % count);
+
+	// Flip a bit of a CRC byte if the read covers both of them.
+	if ((start + size >= count) && (start + AES132_CRC_SIZE <= count) && fault_inject(aes132d_faults, FAULT_CRC)) {
+		crc_index = count - 1 - (fault_random(aes132d_faults) & 1);
+		data[crc_index - start] ^= 1 << (fault_random(aes132d_faults) & 7);
+	}
+}
+
+
+/** \brief This function does nothing. The virtual bus needs no initialization. */
+void aes132p_enable_interface(void)
+{
+}
+
+
+/** \brief This function does nothing. */
+void aes132p_disable_interface(void)
+{
+}
+
+
+/** \brief This function selects a virtual device.
+ *
+ * @param[in] device_id ID under which the device was attached
+ * @return always success
+ */
+uint8_t aes132p_select_device(uint8_t device_id)
+{
+	aes132d_id_current = device_id & ~1;
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function writes bytes to the device.
+ * \param[in] count number of bytes to write
+ * \param[in] word_address word address to write to
+ * \param[in] data pointer to tx buffer
+ * \return status of the operation
+ */
+uint8_t aes132p_write_memory_physical(uint8_t count, uint16_t word_address, uint8_t *data)
+{
+	struct aes132d_device *device = aes132d_address();
+	uint8_t i;
+
+	if (!device)
+		return AES132_FUNCTION_RETCODE_ADDRESS_WRITE_NACK;
+
+	aes132d_time += AES132D_ACCESS_OVERHEAD + (3 + count) * AES132D_BYTE_TIME;
+	device->statistics.accesses++;
+
+	if (word_address == AES132_RESET_ADDR) {
+		device->index = 0;
+		return AES132_FUNCTION_RETCODE_SUCCESS;
+	}
+
+	if (word_address >= AES132_IO_ADDR && word_address < AES132_IO_ADDR + AES132D_BUFFER_SIZE) {
+		if (count == 0)
+			return AES132_FUNCTION_RETCODE_SUCCESS;
+
+		// Writes start at the buffer offset of the word address. Reads continue at the index.
+		device->index = (uint8_t) (word_address - AES132_IO_ADDR);
+		if (device->index == 0) {
+			// A new command replaces the response and clears the CRC bit.
+			device->response_ready = 0;
+			device->status &= ~AES132_CRC_ERROR_BIT;
+		}
+		for (i = 0; i < count && device->index < AES132D_BUFFER_SIZE; i++)
+			device->buffer[device->index++] = data[i];
+		aes132d_receive_command(device);
+		return AES132_FUNCTION_RETCODE_SUCCESS;
+	}
+
+	if (word_address < AES132_IO_ADDR && count > 0)
+		aes132d_write_memory(device, count, word_address, data);
+
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function reads bytes from the device.
+ * \param[in] size number of bytes to read
+ * \param[in] word_address pointer to word address to read from
+ * \param[out] data pointer to rx buffer
+ * \return status of the operation
+ */
+uint8_t aes132p_read_memory_physical(uint8_t size, uint16_t word_address, uint8_t *data)
+{
+	struct aes132d_device *device = aes132d_address();
+	uint8_t start;
+	uint8_t i;
+
+	if (!device)
+		return AES132_FUNCTION_RETCODE_ADDRESS_WRITE_NACK;
+
+	aes132d_time += AES132D_ACCESS_OVERHEAD + (4 + size) * AES132D_BYTE_TIME;
+	device->statistics.accesses++;
+
+	if (word_address == AES132_STATUS_ADDR) {
+		device->statistics.status_reads++;
+		memset(data, aes132d_status_register(device), size);
+	}
+	else if (word_address >= AES132_IO_ADDR && word_address < AES132_IO_ADDR + AES132D_BUFFER_SIZE) {
+		// The buffer reads as 0xFF while no response is ready.
+		start = device->index;
+		for (i = 0; i < size; i++)
+			data[i] = (device->response_ready && aes132d_reached(device->ready_at)
+						&& device->index < AES132D_BUFFER_SIZE) ? device->buffer[device->index++] : 0xFF;
+		if (size && device->response_ready && aes132d_reached(device->ready_at))
+			aes132d_corrupt_response(device, start, size, data);
+	}
+	else {
+		// Configuration memory and other addresses read as 0xFF.
+		for (i = 0; i < size; i++, word_address++)
+			data[i] = word_address < AES132D_USER_MEMORY_SIZE ? device->memory[word_address] : 0xFF;
+	}
+
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
+
+
+/** \brief This function resynchronizes communication.
+ *
+ * It takes as long as a Start condition, nine clocks, and a Stop condition.
+ * The device keeps its state and regains synchronization.
+ * \return always success
+ */
+uint8_t aes132p_resync_physical(void)
+{
+	struct aes132d_device *device = aes132d_get_device(aes132d_id_current);
+
+	aes132d_time += AES132D_ACCESS_OVERHEAD + AES132D_BYTE_TIME;
+	aes132d_sync_lost = 0;
+	if (device)
+		device->statistics.resyncs++;
+
+	return AES132_FUNCTION_RETCODE_SUCCESS;
+}
@@ -0,0 +1,276 @@
+// ----------------------------------------------------------------------------
+//         ATMEL Crypto-Devices Software Support  -  Colorado Springs, CO -
+// ----------------------------------------------------------------------------
+// DISCLAIMER:  THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+// DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+// OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+/** \file
+ *  \brief 	This file contains definitions of the virtual device layer of the AES132 library.
+ *  \author Atmel Crypto Products
+ *  \date 	October 17, 2026
+ */
+
+#ifndef AES132_VIRTUAL_DEVICE_H
+#   define AES132_VIRTUAL_DEVICE_H
+
+#include <stdint.h>
+
+#include "aes132_helper.h"
+#include "fault_injection.h"
+
+
+/** \defgroup aes132_virtual_device AES132 Virtual Device
+ *
+ * \brief
+ * This module is a software model of an AES132 device behind the memory map the
+ * Communication layer in aes132.c works with. It implements the aes132p_* functions,
+ * so it can be linked instead of aes132_i2c.c or aes132_spi.c. Define AES132_VIRTUAL
+ * for these builds. aes132c_access_memory(), aes132c_send_command(), and
+ * aes132c_receive_response() then run unmodified on a host.
+ *
+ * The model behaves like an I<SUP>2</SUP>C device:
+ * - Writing to #AES132_IO_ADDR fills the command buffer. The command executes when
+ *   "count" bytes have arrived. A command with a wrong CRC sets #AES132_CRC_ERROR_BIT
+ *   and is discarded.
+ * - The device does not acknowledge its address while it parses a command, writes its
+ *   EEPROM, or wakes up. Such accesses return #AES132_FUNCTION_RETCODE_ADDRESS_WRITE_NACK.
+ * - While a command executes, #AES132_WIP_BIT is set. Then the response is placed into
+ *   the buffer, #AES132_RESPONSE_READY_BIT is set, and the buffer index is reset.
+ * - Reads from #AES132_IO_ADDR return the response and increment the buffer index.
+ *   Writing to #AES132_RESET_ADDR resets it.
+ * - Writing below #AES132_IO_ADDR writes user memory and places a four-byte response
+ *   into the buffer.
+ * - A device in Sleep or Standby mode wakes up when it is addressed.
+ *
+ * Time is virtual. Every access advances a bus clock by what it would take on a
+ * 400 kHz I<SUP>2</SUP>C bus, and the parse, execution, write, and wake-up windows
+ * run on that clock. Because the timing definitions below are the measured ones of
+ * aes132_i2c.h, the retry counts are the same as on hardware, and the polling loops
+ * spin as often as they would there. The execution time of every op-code can be
+ * changed in struct aes132d_device to tune the timeouts and retry counts.
+ * The statistics count accesses, NACKs, and CRC errors, and aes132d_get_time()
+ * returns the bus time spent.
+ *
+ * The model executes the Info, Random, Nonce, BlockRead, TempSense, Sleep, and Reset
+ * commands and user memory writes. Other op-codes return
+ * #AES132_DEVICE_RETCODE_PARSE_ERROR. Configuration memory, keys, and counters are
+ * not modeled. Random numbers come from a deterministic generator seeded by
+ * aes132d_device_init(), so that runs can be reproduced. They are not secure.
+ *
+ * aes132d_set_fault_injector() places a \ref fault_injection "fault injector" on the
+ * bus. It drops the acknowledge of the address, and flips CRC bits, truncates the count
+ * byte, or loses synchronization when the host reads a response from the buffer. The
+ * response itself stays intact. A device that lost synchronization reads as 0xFF from
+ * the buffer until aes132p_resync_physical() is called.
+@{ */
+
+// ----------------------------------------------------------------------------------
+// ------------------------ definitions for timeout counters ------------------------
+// ----------------------------------------------------------------------------------
+
+//! time in us for polling a bit in the device status register when acked (same as aes132_i2c.h)
+#define AES132_STATUS_REG_POLL_TIME_ACK     (158)
+
+//! time in us for polling a bit in the device status register when nacked (same as aes132_i2c.h)
+#define AES132_STATUS_REG_POLL_TIME_NACK     (41)
+
+//! timeout loop iterations per ms derived from the times it takes to communicate and loop when acknowledged
+#define AES132_ITERATIONS_PER_MS_ACK      (1000 / AES132_STATUS_REG_POLL_TIME_ACK)
+
+//! timeout loop iterations per ms derived from the times it takes to communicate and loop when not acknowledged
+#define AES132_ITERATIONS_PER_MS_NACK     (1000 / AES132_STATUS_REG_POLL_TIME_NACK)
+
+//! Poll this many times for the device being ready for access.
+#define AES132_RETRY_COUNT_DEVICE_READY   ((uint16_t) (AES132_DEVICE_READY_TIMEOUT * AES132_ITERATIONS_PER_MS_NACK))
+
+//! Poll this many times for the response buffer being ready for reading.
+#define AES132_RETRY_COUNT_RESPONSE_READY ((uint16_t) (AES132_RESPONSE_READY_TIMEOUT * AES132_ITERATIONS_PER_MS_ACK * 2 \
+			+ 2 * AES132_ITERATIONS_PER_MS_NACK))
+
+// ----------------------------------------------------------------------------------
+// --------------- end of definitions for timeout counter values --------------------
+// ----------------------------------------------------------------------------------
+
+
+// ------------ definitions for library return codes ----------------------------
+
+#define AES132_FUNCTION_RETCODE_ADDRESS_WRITE_NACK   ((uint8_t) 0xA0) //!< I2C nack when sending a I2C address for writing
+#define AES132_FUNCTION_RETCODE_ADDRESS_READ_NACK    ((uint8_t) 0xA1) //!< I2C nack when sending a I2C address for reading
+#define AES132_FUNCTION_RETCODE_SIZE_TOO_SMALL       ((uint8_t) 0xA2) //!< Count value in response was bigger than buffer.
+
+// The codes below are the same as in the SHA204 library.
+#define AES132_FUNCTION_RETCODE_SUCCESS              ((uint8_t) 0x00) //!< Function succeeded.
+#define AES132_FUNCTION_RETCODE_BAD_CRC_TX           ((uint8_t) 0xD4) //!< Device status register bit 4 (CRC) is set.
+#define AES132_FUNCTION_RETCODE_NOT_IMPLEMENTED      ((uint8_t) 0xE0) //!< interface function not implemented
+#define AES132_FUNCTION_RETCODE_DEVICE_SELECT_FAIL   ((uint8_t) 0xE3) //!< device index out of bounds
+#define AES132_FUNCTION_RETCODE_COUNT_INVALID        ((uint8_t) 0xE4) //!< count byte in response is out of range
+#define AES132_FUNCTION_RETCODE_BAD_CRC_RX           ((uint8_t) 0xE5) //!< incorrect CRC received
+#define AES132_FUNCTION_RETCODE_TIMEOUT              ((uint8_t) 0xE7) //!< Function timed out while waiting for response.
+#define AES132_FUNCTION_RETCODE_COMM_FAIL            ((uint8_t) 0xF0) //!< Communication with device failed.
+
+
+// ------------ definitions for the virtual device ----------------------------
+
+//! maximum number of devices that can be attached at the same time
+#define AES132D_DEVICES_MAX               (8)
+
+//! device ID aes132p_select_device() starts with, the default I2C address of an AES132
+#define AES132D_DEFAULT_ID                ((uint8_t) 0xA0)
+
+//! size of the user memory, 16 zones of 256 bytes
+#define AES132D_USER_MEMORY_SIZE          ((uint16_t) 0x1000)
+
+//! size of a user memory page, the most a memory write can change
+#define AES132D_PAGE_SIZE                 ((uint16_t) 32)
+
+//! size of the command / response buffer
+#define AES132D_BUFFER_SIZE               (64)
+
+//! number of op-codes, #AES132_OPCODE_KEY_TRANSFER + 1
+#define AES132D_OPCODE_COUNT              (0x1B)
+
+//! size of the numbers the Random command returns
+#define AES132D_RANDOM_SIZE               (16)
+
+//! device code and revision the Info command returns for selector #AES132_INFO_DEV_NUM
+#define AES132D_DEV_NUM                   ((uint16_t) 0x0A07)
+
+//! temperature codes the TempSense command returns
+#define AES132D_TEMP_CODE_HIGH            ((uint16_t) 0x0164)
+#define AES132D_TEMP_CODE_LOW             ((uint16_t) 0x0120)
+
+/** \name ChipState Values of the Info Command
+@{ */
+#define AES132D_CHIP_STATE_ACTIVE         ((uint16_t) 0x0000)  //!< device has executed a command since it woke up
+#define AES132D_CHIP_STATE_WAKEUP         ((uint16_t) 0x5555)  //!< device has woken up from Sleep mode
+#define AES132D_CHIP_STATE_POWER_UP       ((uint16_t) 0xFFFF)  //!< device has powered up
+/** @} */
+
+/** \name Bus Timing in us
+@{ */
+#define AES132D_BYTE_TIME                 (23)     //!< nine clocks at 400 kHz
+#define AES132D_ACCESS_OVERHEAD           (AES132_STATUS_REG_POLL_TIME_ACK - 5 * AES132D_BYTE_TIME) //!< Start, Stop, and host overhead of an access
+/** @} */
+
+/** \name Device Timing in us
+@{ */
+#define AES132D_PARSE_TIME                (2000)   //!< address is nacked while a command is parsed
+#define AES132D_WRITE_TIME                (5000)   //!< address is nacked while user memory is written
+#define AES132D_WAKEUP_TIME_SLEEP         (1500)   //!< address is nacked while waking up from Sleep mode
+#define AES132D_WAKEUP_TIME_STANDBY       ( 300)   //!< address is nacked while waking up from Standby mode
+/** @} */
+
+
+//! power states of a virtual device
+enum aes132d_state {
+	AES132D_STATE_AWAKE,   //!< device answers accesses
+	AES132D_STATE_SLEEP,   //!< nonce is lost, device wakes up when addressed
+	AES132D_STATE_STANDBY  //!< nonce is kept, device wakes up when addressed
+};
+
+
+/** \struct aes132d_statistics
+ *  \brief Counters of a virtual device.
+ *  \var aes132d_statistics::commands
+ *       \brief Number of command packets executed.
+ *  \var aes132d_statistics::memory_writes
+ *       \brief Number of memory writes executed.
+ *  \var aes132d_statistics::crc_errors
+ *       \brief Number of command packets discarded because of a wrong CRC.
+ *  \var aes132d_statistics::accesses
+ *       \brief Number of reads and writes that were acknowledged.
+ *  \var aes132d_statistics::nacks
+ *       \brief Number of reads and writes that were not acknowledged.
+ *  \var aes132d_statistics::status_reads
+ *       \brief Number of acknowledged reads of the device status register.
+ *  \var aes132d_statistics::resyncs
+ *       \brief Number of calls to aes132p_resync_physical().
+ *  \var aes132d_statistics::wakeups
+ *       \brief Number of times the device woke up from Sleep or Standby mode.
+ */
+struct aes132d_statistics {
+	uint32_t commands;
+	uint32_t memory_writes;
+	uint32_t crc_errors;
+	uint32_t accesses;
+	uint32_t nacks;
+	uint32_t status_reads;
+	uint32_t resyncs;
+	uint32_t wakeups;
+};
+
+
+/** \struct aes132d_device
+ *  \brief State of a virtual device.
+ *  \var aes132d_device::memory
+ *       \brief User memory.
+ *  \var aes132d_device::nonce
+ *       \brief Nonce register and MacCount.
+ *  \var aes132d_device::seed
+ *       \brief Key of the random number generator.
+ *  \var aes132d_device::random_count
+ *       \brief Number of random numbers generated.
+ *  \var aes132d_device::state
+ *       \brief Power state, one of #aes132d_state.
+ *  \var aes132d_device::chip_state
+ *       \brief ChipState the Info command returns.
+ *  \var aes132d_device::status
+ *       \brief CRC and error bits of the device status register.
+ *  \var aes132d_device::buffer
+ *       \brief Command / response buffer.
+ *  \var aes132d_device::index
+ *       \brief Index into the command / response buffer.
+ *  \var aes132d_device::response_ready
+ *       \brief Indicates that the buffer holds a response.
+ *  \var aes132d_device::nack_until
+ *       \brief Bus time until which the address is not acknowledged.
+ *  \var aes132d_device::ready_at
+ *       \brief Bus time at which the executing command or write finishes.
+ *  \var aes132d_device::execution_time
+ *       \brief Execution time in us of every op-code, after parsing.
+ *  \var aes132d_device::statistics
+ *       \brief Counters, reset by the application.
+ */
+struct aes132d_device {
+	uint8_t memory[AES132D_USER_MEMORY_SIZE];
+	struct aes132h_nonce nonce;
+	struct aes128_key seed;
+	uint32_t random_count;
+	uint8_t state;
+	uint16_t chip_state;
+	uint8_t status;
+	uint8_t buffer[AES132D_BUFFER_SIZE];
+	uint8_t index;
+	uint8_t response_ready;
+	uint32_t nack_until;
+	uint32_t ready_at;
+	uint32_t execution_time[AES132D_OPCODE_COUNT];
+	struct aes132d_statistics statistics;
+};
+
+
+void    aes132d_device_init(struct aes132d_device *device, const uint8_t *seed);
+uint8_t aes132d_attach(uint8_t id, struct aes132d_device *device);
+struct aes132d_device *aes132d_get_device(uint8_t id);
+uint32_t aes132d_get_time(void);
+void    aes132d_set_fault_injector(struct fault_injector *injector);
+
+void    aes132p_enable_interface(void);
+void    aes132p_disable_interface(void);
+uint8_t aes132p_select_device(uint8_t device_id);
+uint8_t aes132p_read_memory_physical(uint8_t size, uint16_t word_address, uint8_t *data);
+uint8_t aes132p_write_memory_physical(uint8_t count, uint16_t word_address, uint8_t *data);
+uint8_t aes132p_resync_physical(void);
+
+/** @} */
+
+#endif
@@ -41,6 +41,7 @@
 #include "ecc108_comm.h"                // definitions and declarations for the Communication module
 #include "timer_utilities.h"            // definitions for delay functions
 #include "ecc108_lib_return_codes.h"    // declarations of function return codes
+#include "cryptoauth_crc.h"             // definitions and declarations for the shared CRC calculation
 
 
 /** \brief This function calculates CRC.
@@ -50,23 +51,8 @@
  * \param[out] crc pointer to 16-bit CRC
  */
 void ecc108c_calculate_crc(uint8_t length, uint8_t *data, uint8_t *crc) {
-	uint8_t counter;
-	uint16_t crc_register = 0;
-	uint16_t polynom = 0x8005;
-	uint8_t shift_register;
-	uint8_t data_bit, crc_bit;
-
-	for (counter = 0; counter < length; counter++) {
-	  for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1) {
-		 data_bit = (data[counter] & shift_register) ? 1 : 0;
-		 crc_bit = crc_register >> 15;
-		 crc_register <<= 1;
-		 if (data_bit != crc_bit)
-			crc_register ^= polynom;
-	  }
-	}
-	crc[0] = (uint8_t) (crc_register & 0x00FF);
-	crc[1] = (uint8_t) (crc_register >> 8);
+	crc[0] = crc[1] = 0;
+	cryptoauth_calculate_crc(length, data, crc);
 }
 
 
@@ -99,7 +85,7 @@ uint8_t ecc108c_wakeup(uint8_t *response)
 		return ret_code;
 
 	ret_code = ecc108p_receive_response(ECC108_RESPONSE_SIZE_MIN, response);
-	if (ret_code != ECC108_SUCCESS)
+	if ((ret_code != ECC108_SUCCESS) && (ret_code != ECC108_BAD_CRC))
 		return ret_code;
 
 	// Verify status response.
@@ -191,7 +177,7 @@ uint8_t ecc108c_send_and_receive(uint8_t *tx_buffer, uint8_t rx_size, uint8_t *r
 	uint8_t count = tx_buffer[ECC108_BUFFER_POS_COUNT];
 	uint8_t count_minus_crc = count - ECC108_CRC_SIZE;
 	uint32_t execution_timeout_us = ((uint32_t) execution_timeout * 1000) + ECC108_RESPONSE_TIMEOUT;
-	volatile uint16_t timeout_countdown;
+	volatile uint32_t timeout_countdown;
 
 	// Append CRC.
 	ecc108c_calculate_crc(count_minus_crc, tx_buffer, tx_buffer + count_minus_crc);
@@ -254,8 +240,8 @@ uint8_t ecc108c_send_and_receive(uint8_t *tx_buffer, uint8_t rx_size, uint8_t *r
 					return ret_code;
 			}
 
-			// We received a response of valid size. Check the consistency of the response.
-			ret_code = ecc108c_check_crc(rx_buffer);
+			// We received a response of valid size. The Physical layer
+			// has checked its CRC while receiving it.
 			if (ret_code == ECC108_SUCCESS) {
 				// Received valid response.
 				if (rx_buffer[ECC108_BUFFER_POS_COUNT] > ECC108_RESPONSE_SIZE_MIN)
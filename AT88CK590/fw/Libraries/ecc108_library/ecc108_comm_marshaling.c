@@ -103,6 +103,11 @@ static uint8_t ecc108m_check_parameters(uint8_t op_code, uint8_t param1, uint16_
 			return ECC108_BAD_PARAM;
 		break;
 
+	case ECC108_GENKEY:
+		if (((param1 != GENKEY_MODE_PUBLIC) && (param1 != GENKEY_MODE_PRIVATE)) || (param2 > ECC108_KEY_ID_MAX))
+			return ECC108_BAD_PARAM;
+		break;
+
 	case ECC108_HMAC:
 		if ((param1 & ~HMAC_MODE_MASK) != 0)
 			return ECC108_BAD_PARAM;
@@ -131,6 +136,12 @@ static uint8_t ecc108m_check_parameters(uint8_t op_code, uint8_t param1, uint16_
 	case ECC108_PAUSE:
 		break;
 
+	case ECC108_PRIVWRITE:
+		if (((param1 & ~PRIVWRITE_ZONE_MASK) != 0) || (param2 > ECC108_KEY_ID_MAX)
+					|| (datalen1 != PRIVWRITE_VALUE_SIZE) || (datalen2 != PRIVWRITE_MAC_SIZE))
+			return ECC108_BAD_PARAM;
+		break;
+
 	case ECC108_RANDOM:
 		if (param1 > RANDOM_NO_SEED_UPDATE)
 			return ECC108_BAD_PARAM;
@@ -142,6 +153,11 @@ static uint8_t ecc108m_check_parameters(uint8_t op_code, uint8_t param1, uint16_
 			return ECC108_BAD_PARAM;
 		break;
 
+	case ECC108_SIGN:
+		if ((param1 != SIGN_MODE_TEMPKEY) || (param2 > ECC108_KEY_ID_MAX))
+			return ECC108_BAD_PARAM;
+		break;
+
 	case ECC108_TEMPSENSE:
 		break;
 
@@ -150,6 +166,11 @@ static uint8_t ecc108m_check_parameters(uint8_t op_code, uint8_t param1, uint16_
 			return ECC108_BAD_PARAM;
 		break;
 
+	case ECC108_VERIFY:
+		if (((param1 != VERIFY_MODE_STORED) && (param1 != VERIFY_MODE_EXTERNAL)) || !data1)
+			return ECC108_BAD_PARAM;
+		break;
+
 	case ECC108_WRITE:
 		if (!data1 || ((param1 & ~WRITE_ZONE_MASK) != 0))
 			return ECC108_BAD_PARAM;
@@ -225,6 +246,12 @@ uint8_t ecc108m_execute(uint8_t op_code, uint8_t param1, uint16_t param2,
 		response_size = GENDIG_RSP_SIZE;
 		break;
 
+	case ECC108_GENKEY:
+		poll_delay = GENKEY_DELAY;
+		poll_timeout = GENKEY_EXEC_MAX - GENKEY_DELAY;
+		response_size = GENKEY_RSP_SIZE;
+		break;
+
 	case ECC108_HMAC:
 		poll_delay = HMAC_DELAY;
 		poll_timeout = HMAC_EXEC_MAX - HMAC_DELAY;
@@ -256,6 +283,12 @@ uint8_t ecc108m_execute(uint8_t op_code, uint8_t param1, uint16_t param2,
 		response_size = PAUSE_RSP_SIZE;
 		break;
 
+	case ECC108_PRIVWRITE:
+		poll_delay = PRIVWRITE_DELAY;
+		poll_timeout = PRIVWRITE_EXEC_MAX - PRIVWRITE_DELAY;
+		response_size = PRIVWRITE_RSP_SIZE;
+		break;
+
 	case ECC108_RANDOM:
 		poll_delay = RANDOM_DELAY;
 		poll_timeout = RANDOM_EXEC_MAX - RANDOM_DELAY;
@@ -269,12 +302,24 @@ uint8_t ecc108m_execute(uint8_t op_code, uint8_t param1, uint16_t param2,
 							? READ_32_RSP_SIZE : READ_4_RSP_SIZE;
 		break;
 
+	case ECC108_SIGN:
+		poll_delay = SIGN_DELAY;
+		poll_timeout = SIGN_EXEC_MAX - SIGN_DELAY;
+		response_size = SIGN_RSP_SIZE;
+		break;
+
 	case ECC108_UPDATE_EXTRA:
 		poll_delay = UPDATE_DELAY;
 		poll_timeout = UPDATE_EXEC_MAX - UPDATE_DELAY;
 		response_size = UPDATE_RSP_SIZE;
 		break;
 
+	case ECC108_VERIFY:
+		poll_delay = VERIFY_DELAY;
+		poll_timeout = VERIFY_EXEC_MAX - VERIFY_DELAY;
+		response_size = VERIFY_RSP_SIZE;
+		break;
+
 	case ECC108_WRITE:
 		poll_delay = WRITE_DELAY;
 		poll_timeout = WRITE_EXEC_MAX - WRITE_DELAY;
@@ -90,21 +90,27 @@
 #define ECC108_DERIVE_KEY               ((uint8_t) 0x1C)       //!< DeriveKey command op-code
 #define ECC108_INFO                   ((uint8_t) 0x30)       //!< DevRev command op-code
 #define ECC108_GENDIG                   ((uint8_t) 0x15)       //!< GenDig command op-code
+#define ECC108_GENKEY                   ((uint8_t) 0x40)       //!< GenKey command op-code
 #define ECC108_HMAC                     ((uint8_t) 0x11)       //!< HMAC command op-code
 #define ECC108_LOCK                     ((uint8_t) 0x17)       //!< Lock command op-code
 #define ECC108_MAC                      ((uint8_t) 0x08)       //!< MAC command op-code
 #define ECC108_NONCE                    ((uint8_t) 0x16)       //!< Nonce command op-code
 #define ECC108_PAUSE                    ((uint8_t) 0x01)       //!< Pause command op-code
+#define ECC108_PRIVWRITE                ((uint8_t) 0x46)       //!< PrivWrite command op-code
 #define ECC108_RANDOM                   ((uint8_t) 0x1B)       //!< Random command op-code
 #define ECC108_READ                     ((uint8_t) 0x02)       //!< Read command op-code
+#define ECC108_SIGN                     ((uint8_t) 0x41)       //!< Sign command op-code
 #define ECC108_UPDATE_EXTRA             ((uint8_t) 0x20)       //!< UpdateExtra command op-code
+#define ECC108_VERIFY                   ((uint8_t) 0x45)       //!< Verify command op-code
 #define ECC108_WRITE                    ((uint8_t) 0x12)       //!< Write command op-code
 /** @} */
 
 
 /** \name Definitions of Data and Packet Sizes
 @{ */
+#define ECC108_RSP_SIZE_MIN             ECC108_RESPONSE_SIZE_MIN    //!< size of response packet containing only a status byte
 #define ECC108_RSP_SIZE_VAL             ((uint8_t)  7)         //!< size of response packet containing four bytes of data
+#define ECC108_RSP_SIZE_MAX             ECC108_RESPONSE_SIZE_MAX    //!< maximum size of response packet
 #define ECC108_KEY_SIZE                 (32)                   //!< size of key
 /** @} */
 
@@ -181,6 +187,19 @@
 #define GENDIG_ZONE_DATA                ((uint8_t) 2)          //!< GenDig zone id data
 /** @} */
 
+/** \name Definitions for the GenKey Command
+@{ */
+#define GENKEY_MODE_IDX                 ECC108_PARAM1_IDX      //!< GenKey command index for mode
+#define GENKEY_KEYID_IDX                ECC108_PARAM2_IDX      //!< GenKey command index for key id
+#define GENKEY_DATA_IDX                 ECC108_DATA_IDX        //!< GenKey command index for optional data
+#define GENKEY_COUNT                    ECC108_CMD_SIZE_MIN    //!< GenKey command packet size without "other data"
+#define GENKEY_COUNT_DATA               (10)                   //!< GenKey command packet size with "other data"
+#define GENKEY_OTHER_DATA_SIZE          (3)                    //!< GenKey size of "other data"
+#define GENKEY_MODE_PUBLIC              ((uint8_t) 0x00)       //!< GenKey mode: calculate public key of stored private key
+#define GENKEY_MODE_PRIVATE             ((uint8_t) 0x04)       //!< GenKey mode: generate new private key
+#define GENKEY_PUBLIC_KEY_SIZE          (64)                   //!< GenKey size of public key X || Y
+/** @} */
+
 /** \name Definitions for the HMAC Command
 @{ */
 #define HMAC_MODE_IDX                   ECC108_PARAM1_IDX      //!< HMAC command index for mode
@@ -257,6 +276,19 @@
 #define PAUSE_COUNT                     ECC108_CMD_SIZE_MIN    //!< Pause command packet size
 /** @} */
 
+/** \name Definitions for the PrivWrite Command
+@{ */
+#define PRIVWRITE_ZONE_IDX              ECC108_PARAM1_IDX      //!< PrivWrite command index for zone
+#define PRIVWRITE_KEYID_IDX             ECC108_PARAM2_IDX      //!< PrivWrite command index for key id
+#define PRIVWRITE_VALUE_IDX             ECC108_DATA_IDX        //!< PrivWrite command index for value
+#define PRIVWRITE_MAC_IDX               (41)                   //!< PrivWrite command index for MAC
+#define PRIVWRITE_COUNT                 (75)                   //!< PrivWrite command packet size
+#define PRIVWRITE_VALUE_SIZE            (36)                   //!< PrivWrite value size: four pad bytes and private key
+#define PRIVWRITE_MAC_SIZE              (32)                   //!< PrivWrite MAC size
+#define PRIVWRITE_ZONE_MASK             ((uint8_t) 0x40)       //!< PrivWrite zone bits 0 to 5 and 7 are 0.
+#define PRIVWRITE_ZONE_ENCRYPT          ((uint8_t) 0x40)       //!< PrivWrite zone bit 6: value is encrypted
+/** @} */
+
 /** \name Definitions for the Random Command
 @{ */
 #define RANDOM_MODE_IDX                 ECC108_PARAM1_IDX      //!< Random command index for mode
@@ -275,6 +307,15 @@
 #define READ_ZONE_MODE_32_BYTES         ((uint8_t) 0x80)       //!< Read mode: 32 bytes
 /** @} */
 
+/** \name Definitions for the Sign Command
+@{ */
+#define SIGN_MODE_IDX                   ECC108_PARAM1_IDX      //!< Sign command index for mode
+#define SIGN_KEYID_IDX                  ECC108_PARAM2_IDX      //!< Sign command index for key id
+#define SIGN_COUNT                      ECC108_CMD_SIZE_MIN    //!< Sign command packet size
+#define SIGN_MODE_TEMPKEY               ((uint8_t) 0x80)       //!< Sign mode: sign the external message in TempKey
+#define SIGN_SIGNATURE_SIZE             (64)                   //!< Sign size of signature R || S
+/** @} */
+
 /** \name Definitions for the UpdateExtra Command
 @{ */
 #define UPDATE_MODE_IDX                  ECC108_PARAM1_IDX     //!< UpdateExtra command index for mode
@@ -299,22 +340,41 @@
 #define WRITE_ZONE_WITH_MAC             ((uint8_t) 0x40)       //!< Write zone bit 6: write encrypted with MAC
 /** @} */
 
+/** \name Definitions for the Verify Command
+@{ */
+#define VERIFY_MODE_IDX                 ECC108_PARAM1_IDX      //!< Verify command index for mode
+#define VERIFY_KEYID_IDX                ECC108_PARAM2_IDX      //!< Verify command index for key id or key type
+#define VERIFY_DATA_IDX                 ECC108_DATA_IDX        //!< Verify command index for signature
+#define VERIFY_KEY_IDX                  (69)                   //!< Verify command index for public key in external mode
+#define VERIFY_COUNT_STORED             (71)                   //!< Verify command packet size with signature
+#define VERIFY_COUNT_EXTERNAL           (135)                  //!< Verify command packet size with signature and public key
+#define VERIFY_MODE_STORED              ((uint8_t) 0x00)       //!< Verify mode: public key is stored in the slot given by key id
+#define VERIFY_MODE_EXTERNAL            ((uint8_t) 0x02)       //!< Verify mode: public key is sent with the command
+#define VERIFY_KEY_P256                 ((uint16_t) 0x0004)    //!< Verify key type in external mode: P-256
+#define VERIFY_SIGNATURE_SIZE           (64)                   //!< Verify size of signature R || S
+#define VERIFY_PUBLIC_KEY_SIZE          (64)                   //!< Verify size of public key X || Y
+/** @} */
+
 /** \name Response Size Definitions
 @{ */
 #define CHECKMAC_RSP_SIZE               ECC108_RESPONSE_SIZE_MIN    //!< response size of DeriveKey command
 #define DERIVE_KEY_RSP_SIZE             ECC108_RESPONSE_SIZE_MIN    //!< response size of DeriveKey command
 #define INFO_RSP_SIZE                   ECC108_RSP_SIZE_VAL         //!< response size of Info command returns 4 bytes
 #define GENDIG_RSP_SIZE                 ECC108_RESPONSE_SIZE_MIN    //!< response size of GenDig command
+#define GENKEY_RSP_SIZE                 ECC108_RESPONSE_SIZE_MAX    //!< response size of GenKey command
 #define HMAC_RSP_SIZE                   ECC108_RESPONSE_SIZE_MAX    //!< response size of HMAC command
 #define LOCK_RSP_SIZE                   ECC108_RESPONSE_SIZE_MIN    //!< response size of Lock command
 #define MAC_RSP_SIZE                    ECC108_RESPONSE_SIZE_MAX    //!< response size of MAC command
 #define NONCE_RSP_SIZE_SHORT            ECC108_RESPONSE_SIZE_MIN    //!< response size of Nonce command with mode[0:1] = 3
 #define NONCE_RSP_SIZE_LONG             ECC108_RESPONSE_SIZE_MAX    //!< response size of Nonce command
 #define PAUSE_RSP_SIZE                  ECC108_RESPONSE_SIZE_MIN    //!< response size of Pause command
+#define PRIVWRITE_RSP_SIZE              ECC108_RESPONSE_SIZE_MIN    //!< response size of PrivWrite command
 #define RANDOM_RSP_SIZE                 ECC108_RESPONSE_SIZE_MAX    //!< response size of Random command
 #define READ_4_RSP_SIZE                 ECC108_RSP_SIZE_VAL         //!< response size of Read command when reading 4 bytes
 #define READ_32_RSP_SIZE                ECC108_RESPONSE_SIZE_MAX    //!< response size of Read command when reading 32 bytes
+#define SIGN_RSP_SIZE                   ECC108_RESPONSE_SIZE_MAX    //!< response size of Sign command
 #define UPDATE_RSP_SIZE                 ECC108_RESPONSE_SIZE_MIN    //!< response size of UpdateExtra command
+#define VERIFY_RSP_SIZE                 ECC108_RESPONSE_SIZE_MIN    //!< response size of Verify command
 #define WRITE_RSP_SIZE                  ECC108_RESPONSE_SIZE_MIN    //!< response size of Write command
 /** @} */
 
@@ -335,6 +395,9 @@
 //! GenDig typical command delay
 #define GENDIG_DELAY                    ((uint8_t) (11.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
 
+//! GenKey typical command delay
+#define GENKEY_DELAY                    ((uint8_t) (70.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
+
 //! HMAC typical command delay
 #define HMAC_DELAY                      ((uint8_t) (27.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
 
@@ -351,6 +414,9 @@
 // We set the delay value to 1.0 instead of 0.4 because we have to make sure that we don't poll immediately.
 #define PAUSE_DELAY                     ((uint8_t) ( 1))
 
+//! PrivWrite typical command delay, the same as for the Write command
+#define PRIVWRITE_DELAY                 ((uint8_t) ( 4.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
+
 //! Random typical command delay
 #define RANDOM_DELAY                    ((uint8_t) (11.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
 
@@ -358,9 +424,15 @@
 // We set the delay value to 1.0 instead of 0.4 because we have to make sure that we don't poll immediately.
 #define READ_DELAY                      ((uint8_t) ( 1))
 
+//! Sign typical command delay
+#define SIGN_DELAY                      ((uint8_t) (60.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
+
 //! UpdateExtra typical command delay
 #define UPDATE_DELAY                    ((uint8_t) ( 8.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
 
+//! Verify typical command delay
+#define VERIFY_DELAY                    ((uint8_t) (80.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
+
 //! Write typical command delay
 #define WRITE_DELAY                     ((uint8_t) ( 4.0 * CPU_CLOCK_DEVIATION_NEGATIVE + 0.5))
 /** @} */
@@ -380,6 +452,9 @@
 //! GenDig maximum execution time
 #define GENDIG_EXEC_MAX                  ((uint8_t) (43.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
 
+//! GenKey maximum execution time
+#define GENKEY_EXEC_MAX                  ((uint8_t) (250.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
+
 //! HMAC maximum execution time
 #define HMAC_EXEC_MAX                    ((uint8_t) (69.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
 
@@ -395,15 +470,24 @@
 //! Pause maximum execution time
 #define PAUSE_EXEC_MAX                   ((uint8_t) ( 2.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
 
+//! PrivWrite maximum execution time, the same as for the Write command
+#define PRIVWRITE_EXEC_MAX               ((uint8_t) (42.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
+
 //! Random maximum execution time
 #define RANDOM_EXEC_MAX                  ((uint8_t) (50.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
 
 //! Read maximum execution time
 #define READ_EXEC_MAX                    ((uint8_t) ( 4.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
 
+//! Sign maximum execution time
+#define SIGN_EXEC_MAX                    ((uint8_t) (100.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
+
 //! UpdateExtra maximum execution time
 #define UPDATE_EXEC_MAX                  ((uint8_t) (12.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
 
+//! Verify maximum execution time
+#define VERIFY_EXEC_MAX                  ((uint8_t) (100.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
+
 //! Write maximum execution time
 #define WRITE_EXEC_MAX                   ((uint8_t) (42.0 * CPU_CLOCK_DEVIATION_POSITIVE + 0.5))
 
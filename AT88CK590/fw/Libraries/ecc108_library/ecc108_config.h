@@ -97,6 +97,7 @@
  * - SHA204_SWI_BITBANG (SWI using GPIO peripheral)
  * - SHA204_SWI_UART (SWI using UART peripheral)
  * - SHA204_I2C (I<SUP>2</SUP>C using I<SUP>2</SUP>C peripheral)
+ * - ECC108_VIRTUAL (virtual device on a host, \ref atecc108_virtual_device)
  *
 @{ */
 
@@ -105,6 +106,7 @@
 //#define ECC108_SWI_BITBANG
 //#define ECC108_SWI_UART
 //#define ECC108_I2C
+//#define ECC108_VIRTUAL
 /** @} */
 
 ////////////////////////////// GPIO configurations //////////////////////////////
@@ -177,6 +179,23 @@
 
 #endif
 
+
+////////////////////////////// virtual device configurations //////////////////////////////
+#ifdef ECC108_VIRTUAL
+/** \name Configuration Definitions for the Virtual Device
+@{ */
+
+/** \brief The virtual device is polled like an I<SUP>2</SUP>C device.
+ *
+ *         This value is used to timeout when waiting for a response.
+ */
+#   ifndef ECC108_RESPONSE_TIMEOUT
+#      define ECC108_RESPONSE_TIMEOUT     ((uint16_t) 37)
+#   endif
+/** @} */
+
+#endif
+
 /** @} */
 
 #endif
@@ -79,9 +79,9 @@
 #include "ecc108_examples.h"          // definitions and declarations for example functions
 #include "timer_utilities.h"          // definitions and declarations for timer functions
 
-#ifdef ECC108_I2C
+#if defined(ECC108_I2C)
 #   include "i2c_phys.h"
-#else
+#elif !defined(ECC108_VIRTUAL)
 #   include "swi_phys.h"
 #endif
 
@@ -784,7 +784,7 @@ uint8_t ecc108e_change_i2c_address(void)
 		return ret_code;
 	}
 	config_data[0] = ECC108_HOST_ADDRESS;
-	memcpy(&config_data[1], &response[ECC108_BUFFER_POS_DATA + 1], sizeof(config_data - 1));
+	memcpy(&config_data[1], &response[ECC108_BUFFER_POS_DATA + 1], sizeof(config_data) - 1);
 
 	ret_code = ecc108m_write(command, response, ECC108_ZONE_CONFIG, config_address, config_data, NULL);
 
@@ -56,6 +56,8 @@
 #ifndef ECC108_HELPER_H
 #   define ECC108_HELPER_H
 
+#include "sha256.h"                                  // definitions and declarations for the SHA-256 module
+
 //-------------------
 // Macro definitions
 //-------------------
@@ -69,6 +71,9 @@
 #define ECC108_MSG_SIZE_DERIVE_KEY_MAC   (39)  // (32+1+1+2+1+2)
 #define ECC108_MSG_SIZE_ENCRYPT_MAC      (96)  // (32+1+1+2+1+2+25+32)
 
+// HMAC block size, the key is padded with zeros to this size
+#define ECC108_HMAC_BLOCK_SIZE           (64)
+
 // SN[0:1] and SN[8]
 #define ECC108_SN_0                    (0x01)
 #define ECC108_SN_1                    (0x23)
@@ -175,6 +180,22 @@ struct ecc108h_mac_in_out {
 };
 
 
+/** \struct ecc108h_hmac_key
+ *  \brief Precomputed HMAC key, created by ecc108h_hmac_key_init().
+ *
+ *  It holds the SHA-256 midstates of the (K0 ^ ipad) and (K0 ^ opad) blocks of a slot key.
+ *  Passing it to ecc108h_hmac_precomputed() saves two of the five SHA-256 block
+ *  compressions of every HMAC digest calculated with that key.
+ *  \var ecc108h_hmac_key::inner
+ *       \brief Intermediate hash value after hashing (K0 ^ ipad).
+ *  \var ecc108h_hmac_key::outer
+ *       \brief Intermediate hash value after hashing (K0 ^ opad).
+ */
+struct ecc108h_hmac_key {
+	uint32_t inner[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+	uint32_t outer[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+};
+
 /** \struct ecc108h_hmac_in_out
  *  \brief Input/output parameters for function ecc108h_hmac().
  *  \var ecc108h_hmac_in_out::mode
@@ -331,7 +352,9 @@ struct ecc108h_check_mac_in_out {
 uint8_t ecc108h_nonce(struct ecc108h_nonce_in_out *param);
 uint8_t ecc108h_mac(struct ecc108h_mac_in_out *param);
 uint8_t ecc108h_check_mac(struct ecc108h_check_mac_in_out *param);
+uint8_t ecc108h_hmac_key_init(struct ecc108h_hmac_key *hmac_key, const uint8_t *key);
 uint8_t ecc108h_hmac(struct ecc108h_hmac_in_out *param);
+uint8_t ecc108h_hmac_precomputed(struct ecc108h_hmac_in_out *param, const struct ecc108h_hmac_key *hmac_key);
 uint8_t ecc108h_gen_dig(struct ecc108h_gen_dig_in_out *param);
 uint8_t ecc108h_derive_key(struct ecc108h_derive_key_in_out *param);
 uint8_t ecc108h_derive_key_mac(struct ecc108h_derive_key_mac_in_out *param);
@@ -80,6 +80,9 @@ uint8_t ecc108p_send_command(uint8_t count, uint8_t *command)
 
 
 /** \brief This SWI function receives a response from the device.
+ *
+ * The CRC of the response is calculated while the response is being received.
+ * The function returns #ECC108_BAD_CRC if it does not match the received one.
  * \param[in] size number of bytes to receive
  * \param[out] response pointer to response buffer
  * \return status of the operation
@@ -89,18 +92,26 @@ uint8_t ecc108p_receive_response(uint8_t size, uint8_t *response)
 	uint8_t count_byte;
 	uint8_t i;
 	uint8_t ret_code;
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE];
+	struct cryptoauth_crc_rx crc_rx;
 
 	for (i = 0; i < size; i++)
 		response[i] = 0;
 
 	(void) swi_send_byte(ECC108_SWI_FLAG_TX);
 
-	ret_code = swi_receive_bytes(size, response);
+	// Calculate the CRC between the bytes of the response.
+	cryptoauth_crc_rx_init(&crc_rx, 0);
+	ret_code = swi_receive_bytes_crc(size, response, &crc_rx);
 	if (ret_code == SWI_FUNCTION_RETCODE_SUCCESS || ret_code == SWI_FUNCTION_RETCODE_RX_FAIL) {
 		count_byte = response[ECC108_BUFFER_POS_COUNT];
 		if ((count_byte < ECC108_RESPONSE_SIZE_MIN) || (count_byte > size))
 			return ECC108_INVALID_SIZE;
 
+		cryptoauth_crc_rx_final(&crc_rx, crc);
+		if ((crc[0] != response[count_byte - CRYPTOAUTH_CRC_SIZE]) || (crc[1] != response[count_byte - 1]))
+			return ECC108_BAD_CRC;
+
 		return ECC108_SUCCESS;
 	}
 
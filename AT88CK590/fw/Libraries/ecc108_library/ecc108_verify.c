@@ -0,0 +1,204 @@
+/** \file
+ *  \brief  Multi-Threaded Batch Verification of ECC108 Signatures
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memset()
+#include <pthread.h>                   // needed for the worker threads
+
+#include "ecc108_verify.h"             // definitions and declarations for this module
+#include "ecc108_lib_return_codes.h"   // declarations of function return codes
+
+
+/** \brief Batch that the threads of ecc108v_verify() share.
+ *
+ *  Every thread takes the next group of records by incrementing next_group,
+ *  so threads that finish early take more groups.
+ */
+struct ecc108v_job {
+	const struct ecc108v_key_table *table;
+	const struct ecc108v_record *records;
+	uint32_t count;
+	uint32_t group_count;
+	uint32_t next_group;
+	uint8_t *passed;
+};
+
+
+/** \brief This function initializes an empty key table.
+ *
+ * \param[out] table pointer to key table
+ * \return status of the operation
+ */
+uint8_t ecc108v_key_table_init(struct ecc108v_key_table *table)
+{
+	if (!table)
+		return ECC108_BAD_PARAM;
+
+	table->loaded = 0;
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function loads a public key into a key table and builds its comb table.
+ *
+ * Do not load keys while ecc108v_verify() uses the table.
+ *
+ * \param[in, out] table pointer to key table
+ * \param[in] key_index index of the key (0 to ECC108V_KEYS_MAX - 1)
+ * \param[in] public_key pointer to 64-byte public key X || Y
+ * \return status of the operation, ECC108_BAD_PARAM also if the key is not on the curve
+ */
+uint8_t ecc108v_key_table_load(struct ecc108v_key_table *table, uint8_t key_index, const uint8_t *public_key)
+{
+	if (!table || !public_key || (key_index >= ECC108V_KEYS_MAX))
+		return ECC108_BAD_PARAM;
+
+	if (p256_comb_init(&table->comb[key_index], public_key) != P256_SUCCESS)
+		return ECC108_BAD_PARAM;
+
+	memcpy(table->public_key[key_index], public_key, P256_KEY_SIZE);
+	table->loaded |= (uint8_t) (1 << key_index);
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function verifies one group of records.
+ *
+ * Records that refer to a key that is not loaded fail without being verified.
+ *
+ * \param[in] job pointer to batch
+ * \param[in] group index of the group
+ */
+static void ecc108v_verify_group(struct ecc108v_job *job, uint32_t group)
+{
+	struct p256_verify_item items[ECC108V_GROUP_SIZE];
+	uint8_t status[ECC108V_GROUP_SIZE];
+	uint8_t index[ECC108V_GROUP_SIZE];
+	const struct ecc108v_record *record;
+	uint32_t first = group * ECC108V_GROUP_SIZE;
+	uint32_t count = job->count - first < ECC108V_GROUP_SIZE ? job->count - first : ECC108V_GROUP_SIZE;
+	uint8_t *passed = &job->passed[first / 8];
+	uint32_t item_count = 0;
+	uint32_t i;
+
+	for (i = 0; i < count; i++) {
+		record = &job->records[first + i];
+		items[item_count].digest = record->digest;
+		items[item_count].signature = record->signature;
+		items[item_count].public_key = record->public_key;
+		items[item_count].comb = NULL;
+		if (record->key_index != ECC108V_KEY_NONE) {
+			if (!job->table || (record->key_index >= ECC108V_KEYS_MAX)
+					|| !(job->table->loaded & (1 << record->key_index)))
+				continue;
+			items[item_count].comb = &job->table->comb[record->key_index];
+		}
+		index[item_count++] = (uint8_t) i;
+	}
+
+	if (item_count)
+		p256_verify_batch(item_count, items, status);
+
+	memset(passed, 0, (count + 7) / 8);
+	for (i = 0; i < item_count; i++) {
+		if (status[i] == P256_SUCCESS)
+			passed[index[i] >> 3] |= (uint8_t) (1 << (index[i] & 7));
+	}
+}
+
+
+/** \brief This function is the main function of the worker threads. It verifies groups until none are left.
+ *
+ * \param[in] arg pointer to batch
+ * \return NULL
+ */
+static void *ecc108v_thread(void *arg)
+{
+	struct ecc108v_job *job = (struct ecc108v_job *) arg;
+	uint32_t group;
+
+	while ((group = __atomic_fetch_add(&job->next_group, 1, __ATOMIC_RELAXED)) < job->group_count)
+		ecc108v_verify_group(job, group);
+
+	return NULL;
+}
+
+
+/** \brief This function verifies a batch of signatures.
+ *
+ * The calling thread verifies groups of records as well, so threads - 1 threads are started.
+ * If a thread cannot be started, the remaining threads verify its groups.
+ *
+ * \param[in] threads number of threads (1 to ECC108V_THREADS_MAX)
+ * \param[in] table pointer to key table, can be NULL if every record carries its public key
+ * \param[in] count number of records
+ * \param[in] records pointer to array of records
+ * \param[out] passed pointer to result bitmap of (count + 7) / 8 bytes. Bit (n % 8) of byte (n / 8) is set if the signature of record n is valid.
+ * \return status of the operation
+ */
+uint8_t ecc108v_verify(uint8_t threads, const struct ecc108v_key_table *table,
+		uint32_t count, const struct ecc108v_record *records, uint8_t *passed)
+{
+	pthread_t thread[ECC108V_THREADS_MAX];
+	struct ecc108v_job job;
+	uint8_t started, i;
+
+	if (!records || !passed || !threads || (threads > ECC108V_THREADS_MAX))
+		return ECC108_BAD_PARAM;
+
+	job.table = table;
+	job.records = records;
+	job.count = count;
+	job.group_count = (count + ECC108V_GROUP_SIZE - 1) / ECC108V_GROUP_SIZE;
+	job.next_group = 0;
+	job.passed = passed;
+
+	for (started = 1; started < threads; started++) {
+		if (pthread_create(&thread[started], NULL, ecc108v_thread, &job))
+			break;
+	}
+
+	ecc108v_thread(&job);
+
+	for (i = 1; i < started; i++)
+		pthread_join(thread[i], NULL);
+
+	return ECC108_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the ECC108 Batch Signature Verification Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef ECC108_VERIFY_H
+#   define ECC108_VERIFY_H
+
+#include <stdint.h>                    // data type definitions
+#include "p256.h"                      // definitions and declarations for the P-256 module
+
+
+/** \defgroup atecc108_verify Module 09: Batch Signature Verification
+ *
+ * \brief
+ * Use these functions on a server that verifies the signatures of many ATECC108 devices,
+ * e.g. the certificate and challenge signatures that \ref Auth checks with Verify commands
+ * one at a time. A record holds the same data as a Verify command in external mode:
+ * the digest in TempKey, and the signature and public key in the command data.
+ *
+ * Public keys that sign many messages, such as root and signer keys, are loaded once
+ * into a key table, which builds their comb tables. The batch is split into groups of
+ * signatures that share their modular inversions, and the groups are distributed
+ * across POSIX threads.
+ *
+ * This module needs POSIX threads, so it is meant for hosts and not for firmware.
+@{ */
+
+//! maximum number of public keys in a key table
+#define ECC108V_KEYS_MAX             (8)
+
+//! key index of a record that carries its own public key
+#define ECC108V_KEY_NONE          (0xFF)
+
+//! maximum number of threads
+#define ECC108V_THREADS_MAX         (64)
+
+//! number of records a thread verifies at a time, a multiple of eight, so that groups do not share bytes of the result bitmap
+#define ECC108V_GROUP_SIZE          (64)
+
+
+/** \struct ecc108v_key_table
+ *  \brief Public keys with comb tables, indexed by key index. It takes 64 KB per key, so allocate it statically or on the heap.
+ *  \var ecc108v_key_table::public_key
+ *       \brief The 64-byte public key (X || Y) of every index.
+ *  \var ecc108v_key_table::comb
+ *       \brief The comb table of every index.
+ *  \var ecc108v_key_table::loaded
+ *       \brief Bit n is set if the key of index n is loaded.
+ */
+struct ecc108v_key_table {
+	uint8_t public_key[ECC108V_KEYS_MAX][P256_KEY_SIZE];
+	struct p256_comb comb[ECC108V_KEYS_MAX];
+	uint8_t loaded;
+};
+
+
+/** \struct ecc108v_record
+ *  \brief One signature to be verified.
+ *  \var ecc108v_record::digest
+ *       \brief [in] 32-byte message digest, the TempKey value of a Verify command.
+ *  \var ecc108v_record::signature
+ *       \brief [in] 64-byte signature R || S, as the Sign command returns it.
+ *  \var ecc108v_record::public_key
+ *       \brief [in] 64-byte public key X || Y. Only used if key_index is ECC108V_KEY_NONE.
+ *  \var ecc108v_record::key_index
+ *       \brief [in] Index of the public key in the key table, or ECC108V_KEY_NONE.
+ */
+struct ecc108v_record {
+	uint8_t digest[P256_INT_SIZE];
+	uint8_t signature[P256_SIGNATURE_SIZE];
+	uint8_t public_key[P256_KEY_SIZE];
+	uint8_t key_index;
+};
+
+
+uint8_t ecc108v_key_table_init(struct ecc108v_key_table *table);
+uint8_t ecc108v_key_table_load(struct ecc108v_key_table *table, uint8_t key_index, const uint8_t *public_key);
+uint8_t ecc108v_verify(uint8_t threads, const struct ecc108v_key_table *table,
+		uint32_t count, const struct ecc108v_record *records, uint8_t *passed);
+
+/** @} */
+
+#endif //ECC108_VERIFY_H
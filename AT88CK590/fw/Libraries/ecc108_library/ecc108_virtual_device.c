@@ -0,0 +1,1586 @@
+/** \file
+ *  \brief  ATECC108 Virtual Device
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+
+#include "ecc108_virtual_device.h"     // definitions and declarations for the Virtual Device module
+#include "ecc108_physical.h"           // declarations that are common to all interface implementations
+#include "ecc108_comm.h"               // definitions of status bytes and packet sizes
+#include "ecc108_lib_return_codes.h"   // declarations of function return codes
+#include "cryptoauth_core.h"           // definitions and declarations for the digest calculations
+#include "p256.h"                      // definitions and declarations for the P-256 module
+#include "timer_utilities_host.h"      // definitions for delay functions and the virtual clock
+
+
+/** \ingroup atecc108_virtual_device
+@{ */
+
+//! revision a virtual device reports in RevNum and with the Info command
+static const uint8_t ecc108d_revision[] = {0x00, 0x00, 0x10, 0x05};
+
+//! serial number of a device initialized without one
+static const uint8_t ecc108d_sn_default[ECC108D_SN_SIZE] = {0x01, 0x23, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEE};
+
+//! number of nonces the Sign command draws before it gives up
+#define ECC108D_SIGN_TRIES               (4)
+
+//! attached devices and their IDs
+static struct {
+	uint8_t id;
+	struct ecc108d_device *device;
+} ecc108d_devices[ECC108D_DEVICES_MAX];
+
+//! ID of the device the physical layer functions address, set by #ecc108p_init or #ecc108p_set_device_id
+static uint8_t ecc108d_device_id = ECC108D_DEFAULT_ID;
+
+
+/** \brief This function initializes a virtual device to its state as shipped.
+ *
+ * All zones are unlocked. The data and OTP zones are erased to 0xFF. Every slot
+ * has a SlotConfig of 0, so it can be read and written in the clear, and a KeyConfig
+ * with key type #ECC108D_KEY_TYPE_NOT_ECC. The OTP mode is read-only. The device is asleep.
+ * \param[out] device pointer to device
+ * \param[in] sn pointer to 9-byte serial number, or NULL for 01 23 00 00 00 00 00 00 EE
+ * \param[in] seed pointer to 32-byte seed of the random number generator, or NULL for zeros
+ */
+void ecc108d_device_init(struct ecc108d_device *device, const uint8_t *sn, const uint8_t *seed)
+{
+	uint8_t key_id;
+
+	if (!sn)
+		sn = ecc108d_sn_default;
+
+	memset(device, 0, sizeof(*device));
+	memcpy(&device->config[0], &sn[0], 4);
+	memcpy(&device->config[ECC108D_CONFIG_REVISION], ecc108d_revision, sizeof(ecc108d_revision));
+	memcpy(&device->config[ECC108D_CONFIG_SN_4], &sn[4], ECC108D_SN_SIZE - 4);
+	device->config[ECC108D_CONFIG_I2C_ADDRESS] = ECC108D_DEFAULT_ID;
+	device->config[ECC108D_CONFIG_OTP_MODE] = ECC108D_OTP_MODE_READ_ONLY;
+	device->config[ECC108D_CONFIG_LOCK_VALUE] = ECC108D_UNLOCKED;
+	device->config[ECC108D_CONFIG_LOCK_CONFIG] = ECC108D_UNLOCKED;
+	for (key_id = 0; key_id <= ECC108_KEY_ID_MAX; key_id++)
+		ecc108d_set_key_config(device, key_id, ECC108D_KEY_TYPE_NOT_ECC << ECC108D_KEY_TYPE_SHIFT);
+	memset(device->otp, 0xFF, sizeof(device->otp));
+	memset(device->data, 0xFF, sizeof(device->data));
+	if (seed)
+		memcpy(device->seed, seed, sizeof(device->seed));
+	device->state = ECC108D_STATE_SLEEP;
+}
+
+
+/** \brief This function attaches a device under an ID, or detaches the device with this ID.
+ * \param[in] id device ID, as passed to ecc108p_set_device_id()
+ * \param[in] device pointer to initialized device, NULL to detach
+ * \return status of the operation
+ */
+uint8_t ecc108d_attach(uint8_t id, struct ecc108d_device *device)
+{
+	uint8_t i;
+	uint8_t free_entry = ECC108D_DEVICES_MAX;
+
+	for (i = 0; i < ECC108D_DEVICES_MAX; i++) {
+		if (ecc108d_devices[i].device && (ecc108d_devices[i].id == id)) {
+			ecc108d_devices[i].device = device;
+			return ECC108_SUCCESS;
+		}
+		if (!ecc108d_devices[i].device && (free_entry == ECC108D_DEVICES_MAX))
+			free_entry = i;
+	}
+	if (!device)
+		return ECC108_SUCCESS;
+	if (free_entry == ECC108D_DEVICES_MAX)
+		return ECC108_FUNC_FAIL;
+
+	ecc108d_devices[free_entry].id = id;
+	ecc108d_devices[free_entry].device = device;
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function returns the device attached under an ID.
+ * \param[in] id device ID
+ * \return pointer to device, NULL if none is attached
+ */
+struct ecc108d_device *ecc108d_get_device(uint8_t id)
+{
+	uint8_t i;
+
+	for (i = 0; i < ECC108D_DEVICES_MAX; i++)
+		if (ecc108d_devices[i].device && (ecc108d_devices[i].id == id))
+			return ecc108d_devices[i].device;
+
+	return NULL;
+}
+
+
+/** \brief This function returns the SlotConfig of a slot.
+ * \param[in] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \return SlotConfig
+ */
+uint16_t ecc108d_get_slot_config(const struct ecc108d_device *device, uint8_t key_id)
+{
+	const uint8_t *slot_config = &device->config[ECC108D_CONFIG_SLOT_CONFIG + 2 * key_id];
+
+	return slot_config[0] | ((uint16_t) slot_config[1] << 8);
+}
+
+
+/** \brief This function sets the SlotConfig of a slot.
+ *
+ * Use it to personalize a device before locking its configuration zone,
+ * instead of writing the configuration zone with Write commands.
+ * \param[in,out] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \param[in] slot_config SlotConfig
+ */
+void ecc108d_set_slot_config(struct ecc108d_device *device, uint8_t key_id, uint16_t slot_config)
+{
+	device->config[ECC108D_CONFIG_SLOT_CONFIG + 2 * key_id] = slot_config & 0xFF;
+	device->config[ECC108D_CONFIG_SLOT_CONFIG + 2 * key_id + 1] = slot_config >> 8;
+}
+
+
+/** \brief This function returns the KeyConfig of a slot.
+ * \param[in] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \return KeyConfig
+ */
+uint16_t ecc108d_get_key_config(const struct ecc108d_device *device, uint8_t key_id)
+{
+	const uint8_t *key_config = &device->config[ECC108D_CONFIG_KEY_CONFIG + 2 * key_id];
+
+	return key_config[0] | ((uint16_t) key_config[1] << 8);
+}
+
+
+/** \brief This function sets the KeyConfig of a slot.
+ * \param[in,out] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \param[in] key_config KeyConfig
+ */
+void ecc108d_set_key_config(struct ecc108d_device *device, uint8_t key_id, uint16_t key_config)
+{
+	device->config[ECC108D_CONFIG_KEY_CONFIG + 2 * key_id] = key_config & 0xFF;
+	device->config[ECC108D_CONFIG_KEY_CONFIG + 2 * key_id + 1] = key_config >> 8;
+}
+
+
+/** \brief This function returns a slot of the data zone.
+ * \param[in] device pointer to device
+ * \param[in] key_id slot (0 to 15)
+ * \param[out] size pointer to size of the slot, or NULL
+ * \return pointer to slot
+ */
+uint8_t *ecc108d_slot(struct ecc108d_device *device, uint8_t key_id, uint16_t *size)
+{
+	uint16_t offset;
+	uint16_t slot_size;
+
+	if (key_id < 8) {
+		offset = key_id * ECC108D_SLOT_SIZE_KEY;
+		slot_size = ECC108D_SLOT_SIZE_KEY;
+	}
+	else if (key_id == 8) {
+		offset = 8 * ECC108D_SLOT_SIZE_KEY;
+		slot_size = ECC108D_SLOT_SIZE_8;
+	}
+	else {
+		offset = 8 * ECC108D_SLOT_SIZE_KEY + ECC108D_SLOT_SIZE_8 + (key_id - 9) * ECC108D_SLOT_SIZE_PUBLIC;
+		slot_size = ECC108D_SLOT_SIZE_PUBLIC;
+	}
+	if (size)
+		*size = slot_size;
+
+	return &device->data[offset];
+}
+
+
+/** \brief This function places a response with data into the output buffer.
+ * \param[in,out] device pointer to device
+ * \param[in] size number of data bytes
+ * \param[in] data pointer to data
+ */
+static void ecc108d_respond(struct ecc108d_device *device, uint8_t size, const uint8_t *data)
+{
+	uint8_t count = size + ECC108_RESPONSE_SIZE_MIN - 1;
+
+	device->response[ECC108_BUFFER_POS_COUNT] = count;
+	memcpy(&device->response[ECC108_BUFFER_POS_DATA], data, size);
+	device->response[count - ECC108_CRC_SIZE] = 0;
+	device->response[count - 1] = 0;
+	ecc108h_calculate_crc_chain(count - ECC108_CRC_SIZE, device->response, &device->response[count - ECC108_CRC_SIZE]);
+}
+
+
+/** \brief This function places a status response into the output buffer.
+ * \param[in,out] device pointer to device
+ * \param[in] status status byte
+ */
+static void ecc108d_respond_status(struct ecc108d_device *device, uint8_t status)
+{
+	ecc108d_respond(device, 1, &status);
+}
+
+
+/** \brief This function translates a return code of the Helper module into a status byte.
+ * \param[in] ret_code return code of an ecc108h_* function
+ * \return status byte
+ */
+static uint8_t ecc108d_status(uint8_t ret_code)
+{
+	if (ret_code == ECC108_SUCCESS)
+		return ECC108D_STATUS_BYTE_SUCCESS;
+	if (ret_code == ECC108_CMD_FAIL)
+		return ECC108_STATUS_BYTE_EXEC;
+
+	return ECC108_STATUS_BYTE_PARSE;
+}
+
+
+/** \brief This function invalidates TempKey and returns the execution error status byte.
+ * \param[in,out] device pointer to device
+ * \return #ECC108_STATUS_BYTE_EXEC
+ */
+static uint8_t ecc108d_fail(struct ecc108d_device *device)
+{
+	device->temp_key.valid = 0;
+
+	return ECC108_STATUS_BYTE_EXEC;
+}
+
+
+//! This function returns whether the configuration zone is locked.
+static uint8_t ecc108d_config_locked(const struct ecc108d_device *device)
+{
+	return device->config[ECC108D_CONFIG_LOCK_CONFIG] != ECC108D_UNLOCKED;
+}
+
+
+//! This function returns whether the data and OTP zones are locked.
+static uint8_t ecc108d_data_locked(const struct ecc108d_device *device)
+{
+	return device->config[ECC108D_CONFIG_LOCK_VALUE] != ECC108D_UNLOCKED;
+}
+
+
+//! This function returns whether a slot holds a private key.
+static uint8_t ecc108d_is_private(const struct ecc108d_device *device, uint8_t key_id)
+{
+	return (ecc108d_get_key_config(device, key_id) & ECC108D_KEY_PRIVATE) != 0;
+}
+
+
+//! This function returns whether a slot holds a P-256 key.
+static uint8_t ecc108d_is_p256(const struct ecc108d_device *device, uint8_t key_id)
+{
+	return ((ecc108d_get_key_config(device, key_id) & ECC108D_KEY_TYPE_MASK) >> ECC108D_KEY_TYPE_SHIFT)
+			== ECC108D_KEY_TYPE_P256;
+}
+
+
+/** \brief This function assembles the 9-byte serial number from the configuration zone.
+ * \param[in] device pointer to device
+ * \param[out] sn pointer to 9-byte buffer
+ */
+static void ecc108d_get_sn(const struct ecc108d_device *device, uint8_t *sn)
+{
+	memcpy(&sn[0], &device->config[0], 4);
+	memcpy(&sn[4], &device->config[ECC108D_CONFIG_SN_4], ECC108D_SN_SIZE - 4);
+}
+
+
+/** \brief This function generates a random number.
+ *
+ * As long as the configuration zone is not locked, the device returns
+ * the fixed pattern FF FF 00 00 instead.
+ * \param[in,out] device pointer to device
+ * \param[in] update_seed whether to update the seed after generating the number
+ * \param[out] random pointer to 32-byte buffer
+ */
+static void ecc108d_random(struct ecc108d_device *device, uint8_t update_seed, uint8_t *random)
+{
+	uint8_t message[ECC108_KEY_SIZE + 5];
+	uint8_t i;
+
+	if (!ecc108d_config_locked(device)) {
+		for (i = 0; i < ECC108_KEY_SIZE; i++)
+			random[i] = (i & 2) ? 0x00 : 0xFF;
+		return;
+	}
+
+	// Seed{32} || count{4} || 0 gives the number, Seed{32} || count{4} || 1 the next seed.
+	memcpy(message, device->seed, ECC108_KEY_SIZE);
+	message[ECC108_KEY_SIZE] = device->random_count & 0xFF;
+	message[ECC108_KEY_SIZE + 1] = (device->random_count >> 8) & 0xFF;
+	message[ECC108_KEY_SIZE + 2] = (device->random_count >> 16) & 0xFF;
+	message[ECC108_KEY_SIZE + 3] = (device->random_count >> 24) & 0xFF;
+	message[ECC108_KEY_SIZE + 4] = 0;
+	ecc108h_calculate_sha256(sizeof(message), message, random);
+	device->random_count++;
+
+	if (update_seed) {
+		message[ECC108_KEY_SIZE + 4] = 1;
+		ecc108h_calculate_sha256(sizeof(message), message, device->seed);
+	}
+}
+
+
+/** \brief This function returns the location of a Read or Write access.
+ *
+ * Configuration and OTP zone addresses are word addresses. Data zone addresses
+ * select a slot, a 32-byte block within the slot, and a word within the block.
+ * A 32-byte access to the last block of a slot can extend past the end of the
+ * slot. Only the bytes inside the slot are accessed then.
+ * \param[in] device pointer to device
+ * \param[in] zone zone parameter of the command
+ * \param[in] address address parameter of the command
+ * \param[in] size number of bytes accessed (4 or 32)
+ * \param[out] length pointer to number of bytes inside the zone or slot
+ * \param[out] key_id pointer to slot of a data zone access
+ * \return pointer to the first byte, NULL if the access is outside the zone or slot
+ */
+static uint8_t *ecc108d_locate(struct ecc108d_device *device, uint8_t zone, uint16_t address, uint8_t size,
+			uint8_t *length, uint8_t *key_id)
+{
+	uint16_t offset, zone_size;
+	uint8_t *base;
+
+	*length = size;
+	*key_id = 0;
+
+	switch (zone & ECC108_ZONE_MASK) {
+	case ECC108_ZONE_CONFIG:
+		if (address & ~ECC108_ADDRESS_MASK_CONFIG)
+			return NULL;
+		base = device->config;
+		zone_size = ECC108D_CONFIG_SIZE;
+		break;
+
+	case ECC108_ZONE_OTP:
+		if (address & ~ECC108_ADDRESS_MASK_OTP)
+			return NULL;
+		base = device->otp;
+		zone_size = ECC108D_OTP_SIZE;
+		break;
+
+	case ECC108_ZONE_DATA:
+		*key_id = (address >> 3) & ECC108_KEY_ID_MAX;
+		base = ecc108d_slot(device, *key_id, &zone_size);
+		offset = (address >> 8) * ECC108_ZONE_ACCESS_32;
+		if (size == ECC108_ZONE_ACCESS_4)
+			offset += (address & 0x07) * ECC108_ZONE_ACCESS_4;
+		if ((address & 0xE080) || (offset >= zone_size))
+			return NULL;
+		if (offset + size > zone_size) {
+			if (size == ECC108_ZONE_ACCESS_4)
+				return NULL;
+			*length = zone_size - offset;
+		}
+		return &base[offset];
+
+	default:
+		return NULL;
+	}
+
+	// A 32-byte access starts at the beginning of the block that contains the word.
+	offset = address * ECC108_ZONE_ACCESS_4;
+	if (size == ECC108_ZONE_ACCESS_32)
+		offset &= ~(ECC108_ZONE_ACCESS_32 - 1);
+	if (offset + size > zone_size)
+		return NULL;
+
+	return &base[offset];
+}
+
+
+/** \brief This function executes a Nonce command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t ecc108d_nonce(struct ecc108d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct ecc108h_nonce_in_out param;
+	uint8_t mode = command[NONCE_MODE_IDX];
+
+	if (mode == NONCE_MODE_PASSTHROUGH) {
+		if (count != NONCE_COUNT_LONG)
+			return ECC108_STATUS_BYTE_PARSE;
+	}
+	else if ((mode & ~NONCE_MODE_MASK) || (mode == NONCE_MODE_INVALID) || (count != NONCE_COUNT_SHORT))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	param.mode = mode;
+	param.num_in = &command[NONCE_INPUT_IDX];
+	param.rand_out = data;
+	param.temp_key = &device->temp_key;
+	if (mode != NONCE_MODE_PASSTHROUGH) {
+		ecc108d_random(device, mode == NONCE_MODE_SEED_UPDATE, data);
+		*size = ECC108_KEY_SIZE;
+	}
+
+	return ecc108d_status(ecc108h_nonce(&param));
+}
+
+
+/** \brief This function executes a GenDig command.
+ *
+ * With four bytes of other data, they replace op-code and parameters in the digest,
+ * so that TempKey becomes the key a DeriveKey command with these parameters derives.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_gen_dig(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	struct ecc108h_gen_dig_in_out param;
+	struct ecc108h_temp_key *temp_key = &device->temp_key;
+	uint8_t *other_data = &command[GENDIG_DATA_IDX];
+	uint8_t zone = command[GENDIG_ZONE_IDX];
+	uint16_t key_id = command[GENDIG_KEYID_IDX] | ((uint16_t) command[GENDIG_KEYID_IDX + 1] << 8);
+
+	if ((count != GENDIG_COUNT) && (count != GENDIG_COUNT_DATA))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	switch (zone) {
+	case GENDIG_ZONE_CONFIG:
+		if (key_id * ECC108_KEY_SIZE >= ECC108D_CONFIG_SIZE)
+			return ECC108_STATUS_BYTE_PARSE;
+		param.stored_value = &device->config[key_id * ECC108_KEY_SIZE];
+		break;
+
+	case GENDIG_ZONE_OTP:
+		if (key_id > ECC108_OTP_BLOCK_MAX)
+			return ECC108_STATUS_BYTE_PARSE;
+		param.stored_value = &device->otp[key_id * ECC108_KEY_SIZE];
+		break;
+
+	case GENDIG_ZONE_DATA:
+		if (key_id > ECC108_KEY_ID_MAX)
+			return ECC108_STATUS_BYTE_PARSE;
+		if (ecc108d_is_private(device, key_id))
+			return ecc108d_fail(device);
+		param.stored_value = ecc108d_slot(device, key_id, NULL);
+		break;
+
+	default:
+		return ECC108_STATUS_BYTE_PARSE;
+	}
+
+	param.zone = zone;
+	param.key_id = key_id;
+	param.temp_key = temp_key;
+	if (count == GENDIG_COUNT)
+		return ecc108d_status(ecc108h_gen_dig(&param));
+
+	// TempKey has to be valid, the same way ecc108h_gen_dig() checks it.
+	if (temp_key->check_flag || !temp_key->valid)
+		return ecc108d_fail(device);
+
+	cryptoauth_key_digest(other_data[0], other_data[1], other_data[2] | ((uint16_t) other_data[3] << 8),
+			param.stored_value, temp_key->value, temp_key->value);
+	temp_key->gen_data = (zone == GENDIG_ZONE_DATA);
+	temp_key->key_id = (zone == GENDIG_ZONE_DATA) ? key_id : 0;
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a MAC command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t ecc108d_mac(struct ecc108d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct ecc108h_mac_in_out param;
+	uint8_t sn[ECC108D_SN_SIZE];
+	uint8_t mode = command[MAC_MODE_IDX];
+	uint16_t key_id = command[MAC_KEYID_IDX] | ((uint16_t) command[MAC_KEYID_IDX + 1] << 8);
+
+	if ((mode & ~MAC_MODE_MASK) || (key_id > ECC108_KEY_ID_MAX))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	// The challenge is only sent if the second SHA block does not come from TempKey.
+	if (count == MAC_COUNT_LONG)
+		param.challenge = &command[MAC_CHALLENGE_IDX];
+	else if ((count == MAC_COUNT_SHORT) && (mode & MAC_MODE_BLOCK2_TEMPKEY))
+		param.challenge = NULL;
+	else
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (!(mode & MAC_MODE_BLOCK1_TEMPKEY) && ((ecc108d_get_slot_config(device, key_id) & ECC108D_SLOT_NO_MAC)
+			|| ecc108d_is_private(device, key_id)))
+		return ecc108d_fail(device);
+
+	ecc108d_get_sn(device, sn);
+	param.mode = mode;
+	param.key_id = key_id;
+	param.key = ecc108d_slot(device, key_id, NULL);
+	param.otp = device->otp;
+	param.sn = sn;
+	param.response = data;
+	param.temp_key = &device->temp_key;
+	*size = ECC108_KEY_SIZE;
+
+	return ecc108d_status(ecc108h_mac(&param));
+}
+
+
+/** \brief This function executes an HMAC command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t ecc108d_hmac(struct ecc108d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct ecc108h_hmac_in_out param;
+	uint8_t sn[ECC108D_SN_SIZE];
+	uint8_t mode = command[HMAC_MODE_IDX];
+	uint16_t key_id = command[HMAC_KEYID_IDX] | ((uint16_t) command[HMAC_KEYID_IDX + 1] << 8);
+
+	if ((count != HMAC_COUNT) || (mode & ~HMAC_MODE_MASK) || (key_id > ECC108_KEY_ID_MAX))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if ((ecc108d_get_slot_config(device, key_id) & ECC108D_SLOT_NO_MAC) || ecc108d_is_private(device, key_id))
+		return ecc108d_fail(device);
+
+	ecc108d_get_sn(device, sn);
+	param.mode = mode;
+	param.key_id = key_id;
+	param.key = ecc108d_slot(device, key_id, NULL);
+	param.otp = device->otp;
+	param.sn = sn;
+	param.response = data;
+	param.temp_key = &device->temp_key;
+	*size = ECC108_KEY_SIZE;
+
+	return ecc108d_status(ecc108h_hmac(&param));
+}
+
+
+/** \brief This function executes a CheckMac command.
+ *
+ * If the response matches and the command has the form ecc108h_check_mac() calculates,
+ * i.e. the second SHA block comes from a random TempKey, the device copies the target
+ * slot into TempKey: the password slot itself if its number is odd, otherwise the next one.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_check_mac(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	struct ecc108h_temp_key *temp_key = &device->temp_key;
+	uint8_t digest[ECC108_KEY_SIZE];
+	uint8_t mode = command[CHECKMAC_MODE_IDX];
+	uint16_t key_id = command[CHECKMAC_KEYID_IDX] | ((uint16_t) command[CHECKMAC_KEYID_IDX + 1] << 8);
+
+	if ((count != CHECKMAC_COUNT) || (mode & ~CHECKMAC_MODE_MASK) || (key_id > ECC108_KEY_ID_MAX))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (ecc108d_is_private(device, key_id))
+		return ecc108d_fail(device);
+
+	// Check TempKey if it is used, the same way ecc108h_mac() does.
+	if ((mode & MAC_MODE_USE_TEMPKEY_MASK)
+			&& (temp_key->check_flag || !temp_key->valid
+			|| (!(mode & CHECKMAC_MODE_SOURCE_FLAG_MATCH) != !temp_key->source_flag)))
+		return ecc108d_fail(device);
+
+	cryptoauth_check_mac(
+			mode & CHECKMAC_MODE_BLOCK1_TEMPKEY ? temp_key->value : ecc108d_slot(device, key_id, NULL),
+			mode & CHECKMAC_MODE_BLOCK2_TEMPKEY ? temp_key->value : &command[CHECKMAC_CLIENT_CHALLENGE_IDX],
+			&command[CHECKMAC_DATA_IDX], mode & CHECKMAC_MODE_INCLUDE_OTP_64 ? device->otp : NULL, digest);
+
+	if (memcmp(digest, &command[CHECKMAC_CLIENT_RESPONSE_IDX], sizeof(digest))) {
+		temp_key->valid = 0;
+		return ECC108D_STATUS_BYTE_MISCOMPARE;
+	}
+
+	if ((mode & (MAC_MODE_USE_TEMPKEY_MASK | CHECKMAC_MODE_SOURCE_FLAG_MATCH)) == CHECKMAC_MODE_BLOCK2_TEMPKEY) {
+		memcpy(temp_key->value, ecc108d_slot(device, key_id | 1, NULL), ECC108_KEY_SIZE);
+		temp_key->gen_data = 0;
+		temp_key->source_flag = 1;
+		temp_key->valid = 1;
+	}
+	else
+		temp_key->valid = 0;
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a DeriveKey command.
+ *
+ * The parent key is the slot WriteKey points to if SlotConfig[TargetKey] selects
+ * Create, and the target slot itself (Roll) otherwise.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_derive_key(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	struct ecc108h_derive_key_in_out param;
+	struct ecc108h_derive_key_mac_in_out mac_param;
+	uint8_t mac[DERIVE_KEY_MAC_SIZE];
+	uint8_t random = command[DERIVE_KEY_RANDOM_IDX];
+	uint16_t target = command[DERIVE_KEY_TARGETKEY_IDX] | ((uint16_t) command[DERIVE_KEY_TARGETKEY_IDX + 1] << 8);
+	uint16_t slot_config;
+
+	if ((random & ~DERIVE_KEY_RANDOM_FLAG) || (target > ECC108_KEY_ID_MAX)
+			|| ((count != DERIVE_KEY_COUNT_SMALL) && (count != DERIVE_KEY_COUNT_LARGE)))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	slot_config = ecc108d_get_slot_config(device, target);
+	if (!(slot_config & ECC108D_SLOT_DERIVE_KEY) || ecc108d_is_private(device, target))
+		return ecc108d_fail(device);
+
+	param.random = random;
+	param.target_key_id = target;
+	param.target_key = ecc108d_slot(device, target, NULL);
+	param.parent_key = (slot_config & ECC108D_SLOT_DERIVE_CREATE)
+			? ecc108d_slot(device, (slot_config & ECC108D_SLOT_WRITE_KEY_MASK) >> ECC108D_SLOT_WRITE_KEY_SHIFT, NULL)
+			: param.target_key;
+	param.temp_key = &device->temp_key;
+
+	if (slot_config & ECC108D_SLOT_DERIVE_MAC) {
+		if (count != DERIVE_KEY_COUNT_LARGE)
+			return ecc108d_fail(device);
+		mac_param.random = random;
+		mac_param.target_key_id = target;
+		mac_param.parent_key = param.parent_key;
+		mac_param.mac = mac;
+		(void) ecc108h_derive_key_mac(&mac_param);
+		if (memcmp(mac, &command[DERIVE_KEY_MAC_IDX], sizeof(mac)))
+			return ecc108d_fail(device);
+	}
+
+	return ecc108d_status(ecc108h_derive_key(&param));
+}
+
+
+/** \brief This function executes a Read command.
+ *
+ * The configuration zone can always be read, the OTP and data zones only after they
+ * are locked. Slots with EncryptRead set return 32 bytes encrypted with a TempKey
+ * that GenDig generated from ReadKey. Other secret slots and private keys cannot be read.
+ * Bytes of a 32-byte block past the end of a slot read as zeros.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t ecc108d_read(struct ecc108d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct ecc108h_decrypt_in_out param;
+	uint8_t zone = command[READ_ZONE_IDX];
+	uint16_t address = command[READ_ADDR_IDX] | ((uint16_t) command[READ_ADDR_IDX + 1] << 8);
+	uint8_t access = (zone & ECC108_ZONE_COUNT_FLAG) ? ECC108_ZONE_ACCESS_32 : ECC108_ZONE_ACCESS_4;
+	uint8_t *location;
+	uint8_t length, key_id;
+	uint16_t slot_config;
+
+	if ((count != READ_COUNT) || (zone & ~READ_ZONE_MASK))
+		return ECC108_STATUS_BYTE_PARSE;
+	location = ecc108d_locate(device, zone, address, access, &length, &key_id);
+	if (!location)
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (((zone & ECC108_ZONE_MASK) != ECC108_ZONE_CONFIG) && !ecc108d_data_locked(device))
+		return ECC108_STATUS_BYTE_EXEC;
+
+	memset(data, 0, access);
+	memcpy(data, location, length);
+	*size = access;
+	if ((zone & ECC108_ZONE_MASK) != ECC108_ZONE_DATA)
+		return ECC108D_STATUS_BYTE_SUCCESS;
+
+	if (ecc108d_is_private(device, key_id))
+		return ECC108_STATUS_BYTE_EXEC;
+	slot_config = ecc108d_get_slot_config(device, key_id);
+	if (slot_config & ECC108D_SLOT_ENCRYPT_READ) {
+		if ((access != ECC108_ZONE_ACCESS_32)
+				|| (device->temp_key.key_id != (slot_config & ECC108D_SLOT_READ_KEY_MASK)))
+			return ecc108d_fail(device);
+		param.data = data;
+		param.temp_key = &device->temp_key;
+		return ecc108d_status(ecc108h_decrypt(&param));
+	}
+	if (slot_config & ECC108D_SLOT_IS_SECRET)
+		return ECC108_STATUS_BYTE_EXEC;
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a Write command.
+ *
+ * Before it is locked, the configuration zone can be written except for the serial
+ * number, the revision, and bytes 84 to 87, which Write leaves unchanged. Before
+ * they are locked, the OTP and data zones can be written in the clear. After locking,
+ * OTP bits can only be cleared, and only in consumption mode. Slots can then be
+ * written in 32-byte blocks, in the clear if WriteConfig is 0, or encrypted with a
+ * TempKey that GenDig generated from WriteKey and authenticated with the MAC of
+ * ecc108h_encrypt() if WriteConfig allows encrypted writes. Private keys can only
+ * be written with PrivWrite once the configuration zone is locked.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_write(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	struct ecc108h_decrypt_in_out param;
+	uint8_t key[ECC108_KEY_SIZE];
+	uint8_t value[ECC108_KEY_SIZE];
+	uint8_t digest[WRITE_MAC_SIZE];
+	uint8_t zone = command[WRITE_ZONE_IDX];
+	uint16_t address = command[WRITE_ADDR_IDX] | ((uint16_t) command[WRITE_ADDR_IDX + 1] << 8);
+	uint8_t access = (zone & ECC108_ZONE_COUNT_FLAG) ? ECC108_ZONE_ACCESS_32 : ECC108_ZONE_ACCESS_4;
+	uint8_t *mac = NULL;
+	uint8_t *location;
+	uint8_t length, key_id;
+	uint16_t offset;
+	uint16_t slot_config;
+	uint8_t i;
+
+	if (zone & ~WRITE_ZONE_MASK)
+		return ECC108_STATUS_BYTE_PARSE;
+	if (count == ECC108_CMD_SIZE_MIN + access + WRITE_MAC_SIZE)
+		mac = &command[WRITE_VALUE_IDX + access];
+	else if (count != ECC108_CMD_SIZE_MIN + access)
+		return ECC108_STATUS_BYTE_PARSE;
+	location = ecc108d_locate(device, zone, address, access, &length, &key_id);
+	if (!location)
+		return ECC108_STATUS_BYTE_PARSE;
+	memcpy(value, &command[WRITE_VALUE_IDX], access);
+
+	switch (zone & ECC108_ZONE_MASK) {
+	case ECC108_ZONE_CONFIG:
+		if (ecc108d_config_locked(device) || mac || (zone & WRITE_ZONE_WITH_MAC))
+			return ECC108_STATUS_BYTE_EXEC;
+		offset = location - device->config;
+		for (i = 0; i < access; i++, offset++)
+			if ((offset >= ECC108D_CONFIG_WRITABLE)
+					&& ((offset < ECC108D_CONFIG_USER_EXTRA) || (offset >= ECC108D_CONFIG_WRITABLE_2)))
+				device->config[offset] = value[i];
+		break;
+
+	case ECC108_ZONE_OTP:
+		if (mac || (zone & WRITE_ZONE_WITH_MAC))
+			return ECC108_STATUS_BYTE_EXEC;
+		if (!ecc108d_data_locked(device))
+			memcpy(location, value, access);
+		else if (device->config[ECC108D_CONFIG_OTP_MODE] == ECC108D_OTP_MODE_CONSUMPTION)
+			for (i = 0; i < access; i++)
+				location[i] &= value[i];
+		else
+			return ECC108_STATUS_BYTE_EXEC;
+		break;
+
+	default:
+		if (ecc108d_config_locked(device) && ecc108d_is_private(device, key_id))
+			return ECC108_STATUS_BYTE_EXEC;
+		if (!ecc108d_data_locked(device)) {
+			if (zone & WRITE_ZONE_WITH_MAC)
+				return ECC108_STATUS_BYTE_EXEC;
+			memcpy(location, value, length);
+			break;
+		}
+		if (access != ECC108_ZONE_ACCESS_32)
+			return ECC108_STATUS_BYTE_EXEC;
+
+		slot_config = ecc108d_get_slot_config(device, key_id);
+		if (!(zone & WRITE_ZONE_WITH_MAC)) {
+			if (slot_config & ECC108D_SLOT_WRITE_CONFIG_MASK)
+				return ECC108_STATUS_BYTE_EXEC;
+			memcpy(location, value, length);
+			break;
+		}
+
+		if (!(slot_config & ECC108D_SLOT_WRITE_ENCRYPT) || !mac
+				|| (device->temp_key.key_id != ((slot_config & ECC108D_SLOT_WRITE_KEY_MASK) >> ECC108D_SLOT_WRITE_KEY_SHIFT)))
+			return ecc108d_fail(device);
+
+		// Decrypt with TempKey, then check the MAC ecc108h_encrypt() calculated over the plain text.
+		memcpy(key, device->temp_key.value, sizeof(key));
+		param.data = value;
+		param.temp_key = &device->temp_key;
+		if (ecc108h_decrypt(&param) != ECC108_SUCCESS)
+			return ECC108_STATUS_BYTE_EXEC;
+		cryptoauth_key_digest(ECC108_WRITE, zone, address, key, value, digest);
+		if (memcmp(digest, mac, sizeof(digest)))
+			return ECC108_STATUS_BYTE_EXEC;
+		memcpy(location, value, length);
+		break;
+	}
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a Lock command.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_lock(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	uint8_t zone = command[LOCK_ZONE_IDX];
+	uint16_t summary = command[LOCK_SUMMARY_IDX] | ((uint16_t) command[LOCK_SUMMARY_IDX + 1] << 8);
+	uint8_t crc[ECC108_CRC_SIZE] = {0, 0};
+	uint16_t offset;
+
+	if ((count != LOCK_COUNT) || (zone & ~LOCK_ZONE_MASK))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (!(zone & LOCK_ZONE_NO_CONFIG)) {
+		if (ecc108d_config_locked(device))
+			return ECC108_STATUS_BYTE_EXEC;
+		ecc108h_calculate_crc_chain(ECC108D_CONFIG_SIZE, device->config, crc);
+	}
+	else {
+		if (!ecc108d_config_locked(device) || ecc108d_data_locked(device))
+			return ECC108_STATUS_BYTE_EXEC;
+		// The summary covers the data zone followed by the OTP zone.
+		for (offset = 0; offset < ECC108D_DATA_SIZE; offset += ECC108D_OTP_SIZE)
+			ecc108h_calculate_crc_chain(offset + ECC108D_OTP_SIZE > ECC108D_DATA_SIZE
+					? ECC108D_DATA_SIZE - offset : ECC108D_OTP_SIZE, &device->data[offset], crc);
+		ecc108h_calculate_crc_chain(ECC108D_OTP_SIZE, device->otp, crc);
+	}
+
+	if (!(zone & LOCK_ZONE_NO_CRC) && (summary != (crc[0] | ((uint16_t) crc[1] << 8))))
+		return ECC108_STATUS_BYTE_EXEC;
+
+	device->config[(zone & LOCK_ZONE_NO_CONFIG) ? ECC108D_CONFIG_LOCK_VALUE : ECC108D_CONFIG_LOCK_CONFIG] = ECC108D_LOCKED;
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes an UpdateExtra command.
+ *
+ * Mode 0 writes UserExtra (byte 84), mode 1 Selector (byte 85). Either byte can
+ * only be written once, after the configuration zone is locked.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_update_extra(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	uint8_t mode = command[UPDATE_MODE_IDX];
+
+	if ((count != UPDATE_COUNT) || (mode > UPDATE_CONFIG_BYTE_86))
+		return ECC108_STATUS_BYTE_PARSE;
+	if (!ecc108d_config_locked(device) || device->config[ECC108D_CONFIG_USER_EXTRA + mode])
+		return ECC108_STATUS_BYTE_EXEC;
+
+	device->config[ECC108D_CONFIG_USER_EXTRA + mode] = command[UPDATE_VALUE_IDX];
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes an Info command.
+ *
+ * Mode 0 returns the revision. Mode 1 returns 1 in the first byte if the slot in
+ * the second parameter holds a valid P-256 private key. The State and GPIO modes
+ * return zeros, because the model has no GPIO pin.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t ecc108d_info(struct ecc108d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	uint8_t public_key[GENKEY_PUBLIC_KEY_SIZE];
+	uint8_t mode = command[INFO_PARAM1_IDX];
+	uint16_t param2 = command[INFO_PARAM2_IDX] | ((uint16_t) command[INFO_PARAM2_IDX + 1] << 8);
+
+	if ((count != INFO_COUNT) || (mode > INFO_MODE_MAX))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	memset(data, 0, ECC108_ZONE_ACCESS_4);
+	*size = ECC108_ZONE_ACCESS_4;
+	switch (mode) {
+	case INFO_MODE_REVISION:
+		memcpy(data, &device->config[ECC108D_CONFIG_REVISION], sizeof(ecc108d_revision));
+		break;
+
+	case INFO_MODE_KEY_VALID:
+		if (param2 > ECC108_KEY_ID_MAX)
+			return ECC108_STATUS_BYTE_PARSE;
+		data[0] = ecc108d_is_private(device, param2) && ecc108d_is_p256(device, param2)
+				&& (p256_public_key(public_key, ecc108d_slot(device, param2, NULL) + ECC108D_KEY_PAD_SIZE) == P256_SUCCESS);
+		break;
+
+	default:
+		break;
+	}
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a GenKey command.
+ *
+ * Mode 4 generates a random private key, stores it in the slot, and returns its
+ * public key. After the data zone is locked, this requires the GenKey bit of
+ * SlotConfig. Mode 0 returns the public key of the private key stored in the slot.
+ * The three bytes of other data of the digest modes are accepted but not used.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t ecc108d_gen_key(struct ecc108d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	uint8_t private_key[ECC108_KEY_SIZE];
+	uint8_t mode = command[GENKEY_MODE_IDX];
+	uint16_t key_id = command[GENKEY_KEYID_IDX] | ((uint16_t) command[GENKEY_KEYID_IDX + 1] << 8);
+	uint8_t *slot;
+
+	if (((mode != GENKEY_MODE_PUBLIC) && (mode != GENKEY_MODE_PRIVATE)) || (key_id > ECC108_KEY_ID_MAX)
+			|| ((count != GENKEY_COUNT) && (count != GENKEY_COUNT_DATA)))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (!ecc108d_config_locked(device) || !ecc108d_is_private(device, key_id) || !ecc108d_is_p256(device, key_id))
+		return ECC108_STATUS_BYTE_EXEC;
+
+	slot = ecc108d_slot(device, key_id, NULL);
+	if (mode == GENKEY_MODE_PRIVATE) {
+		if (ecc108d_data_locked(device) && !(ecc108d_get_slot_config(device, key_id) & ECC108D_SLOT_GEN_KEY))
+			return ECC108_STATUS_BYTE_EXEC;
+		// Draw until the number is a valid scalar. A SHA-256 output fails with a probability of 2^-32.
+		do
+			ecc108d_random(device, 0, private_key);
+		while (p256_public_key(data, private_key) != P256_SUCCESS);
+		memset(slot, 0, ECC108D_KEY_PAD_SIZE);
+		memcpy(slot + ECC108D_KEY_PAD_SIZE, private_key, sizeof(private_key));
+		memset(private_key, 0, sizeof(private_key));
+	}
+	else if (p256_public_key(data, slot + ECC108D_KEY_PAD_SIZE) != P256_SUCCESS)
+		return ECC108_STATUS_BYTE_EXEC;
+
+	*size = GENKEY_PUBLIC_KEY_SIZE;
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a Sign command.
+ *
+ * The message is the digest in TempKey, which a pass-through Nonce has to have loaded.
+ * The private key has to allow external signatures. Sign invalidates TempKey.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \param[out] data pointer to response data
+ * \param[out] size pointer to number of response data bytes
+ * \return status byte
+ */
+static uint8_t ecc108d_sign(struct ecc108d_device *device, uint8_t count, uint8_t *command, uint8_t *data, uint8_t *size)
+{
+	struct ecc108h_temp_key *temp_key = &device->temp_key;
+	uint8_t nonce[ECC108_KEY_SIZE];
+	uint8_t mode = command[SIGN_MODE_IDX];
+	uint16_t key_id = command[SIGN_KEYID_IDX] | ((uint16_t) command[SIGN_KEYID_IDX + 1] << 8);
+	uint8_t ret_code = P256_BAD_PARAM;
+	uint8_t i;
+
+	if ((count != SIGN_COUNT) || (mode != SIGN_MODE_TEMPKEY) || (key_id > ECC108_KEY_ID_MAX))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (!ecc108d_config_locked(device) || !ecc108d_is_private(device, key_id) || !ecc108d_is_p256(device, key_id)
+			|| !(ecc108d_get_slot_config(device, key_id) & ECC108D_SLOT_SIGN_EXTERNAL)
+			|| temp_key->check_flag || !temp_key->valid || !temp_key->source_flag)
+		return ecc108d_fail(device);
+
+	for (i = 0; (i < ECC108D_SIGN_TRIES) && (ret_code != P256_SUCCESS); i++) {
+		ecc108d_random(device, 0, nonce);
+		ret_code = p256_sign(data, temp_key->value, ecc108d_slot(device, key_id, NULL) + ECC108D_KEY_PAD_SIZE, nonce);
+	}
+	memset(nonce, 0, sizeof(nonce));
+	temp_key->valid = 0;
+	if (ret_code != P256_SUCCESS)
+		return ECC108_STATUS_BYTE_EXEC;
+
+	*size = SIGN_SIGNATURE_SIZE;
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a Verify command.
+ *
+ * The message is the digest in TempKey. In external mode, the command carries the
+ * public key, and the second parameter has to select P-256. In stored mode, the
+ * public key is read from the slot the second parameter selects. The device returns
+ * #ECC108D_STATUS_BYTE_MISCOMPARE for a wrong signature, and an execution error for
+ * a public key that is not on the curve. Verify invalidates TempKey.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_verify(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	struct ecc108h_temp_key *temp_key = &device->temp_key;
+	uint8_t public_key[VERIFY_PUBLIC_KEY_SIZE];
+	uint8_t mode = command[VERIFY_MODE_IDX];
+	uint16_t key_id = command[VERIFY_KEYID_IDX] | ((uint16_t) command[VERIFY_KEYID_IDX + 1] << 8);
+	uint16_t slot_size;
+	uint8_t *slot;
+	uint8_t ret_code;
+
+	if (mode == VERIFY_MODE_EXTERNAL) {
+		if ((count != VERIFY_COUNT_EXTERNAL) || (key_id != VERIFY_KEY_P256))
+			return ECC108_STATUS_BYTE_PARSE;
+		memcpy(public_key, &command[VERIFY_KEY_IDX], sizeof(public_key));
+	}
+	else if (mode == VERIFY_MODE_STORED) {
+		if ((count != VERIFY_COUNT_STORED) || (key_id > ECC108_KEY_ID_MAX))
+			return ECC108_STATUS_BYTE_PARSE;
+		slot = ecc108d_slot(device, key_id, &slot_size);
+		if (!ecc108d_config_locked(device) || ecc108d_is_private(device, key_id) || !ecc108d_is_p256(device, key_id)
+				|| (slot_size < ECC108D_SLOT_SIZE_PUBLIC))
+			return ecc108d_fail(device);
+		// The slot holds pad{4} || X{32} || pad{4} || Y{32}.
+		memcpy(public_key, slot + ECC108D_KEY_PAD_SIZE, ECC108_KEY_SIZE);
+		memcpy(public_key + ECC108_KEY_SIZE, slot + 2 * ECC108D_KEY_PAD_SIZE + ECC108_KEY_SIZE, ECC108_KEY_SIZE);
+	}
+	else
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (temp_key->check_flag || !temp_key->valid)
+		return ecc108d_fail(device);
+
+	ret_code = p256_verify(temp_key->value, &command[VERIFY_DATA_IDX], public_key, NULL);
+	temp_key->valid = 0;
+	if (ret_code == P256_BAD_PARAM)
+		return ECC108_STATUS_BYTE_EXEC;
+
+	return (ret_code == P256_SUCCESS) ? ECC108D_STATUS_BYTE_SUCCESS : ECC108D_STATUS_BYTE_MISCOMPARE;
+}
+
+
+/** \brief This function executes a PrivWrite command.
+ *
+ * Before the data zone is locked, the value is written in the clear. After locking,
+ * it has to be encrypted with a TempKey that GenDig generated from WriteKey, and
+ * SlotConfig has to allow encrypted writes: the first 32 bytes are XORed with TempKey,
+ * the last four with the first bytes of SHA-256(TempKey). The MAC is
+ * SHA-256(TempKey{32} || op-code{1} || zone{1} || key id{2} || SN[8]{1} || SN[0:1]{2} || 0{21} || value{36})
+ * over the plain value.
+ * \param[in,out] device pointer to device
+ * \param[in] count size of command packet
+ * \param[in] command pointer to command packet
+ * \return status byte
+ */
+static uint8_t ecc108d_priv_write(struct ecc108d_device *device, uint8_t count, uint8_t *command)
+{
+	struct ecc108h_temp_key *temp_key = &device->temp_key;
+	uint8_t message[ECC108_KEY_SIZE + 7 + 21 + PRIVWRITE_VALUE_SIZE];
+	uint8_t value[PRIVWRITE_VALUE_SIZE];
+	uint8_t digest[ECC108_KEY_SIZE];
+	uint8_t zone = command[PRIVWRITE_ZONE_IDX];
+	uint16_t key_id = command[PRIVWRITE_KEYID_IDX] | ((uint16_t) command[PRIVWRITE_KEYID_IDX + 1] << 8);
+	uint16_t slot_config;
+	uint8_t *p_message;
+	uint8_t i;
+
+	if ((count != PRIVWRITE_COUNT) || (zone & ~PRIVWRITE_ZONE_MASK) || (key_id > ECC108_KEY_ID_MAX))
+		return ECC108_STATUS_BYTE_PARSE;
+
+	if (!ecc108d_config_locked(device) || !ecc108d_is_private(device, key_id) || !ecc108d_is_p256(device, key_id))
+		return ECC108_STATUS_BYTE_EXEC;
+
+	memcpy(value, &command[PRIVWRITE_VALUE_IDX], sizeof(value));
+	if (!ecc108d_data_locked(device)) {
+		if (zone & PRIVWRITE_ZONE_ENCRYPT)
+			return ECC108_STATUS_BYTE_EXEC;
+		memcpy(ecc108d_slot(device, key_id, NULL), value, sizeof(value));
+		return ECC108D_STATUS_BYTE_SUCCESS;
+	}
+
+	slot_config = ecc108d_get_slot_config(device, key_id);
+	if (!(zone & PRIVWRITE_ZONE_ENCRYPT) || !(slot_config & ECC108D_SLOT_WRITE_ENCRYPT)
+			|| temp_key->check_flag || !temp_key->valid || !temp_key->gen_data || temp_key->source_flag
+			|| (temp_key->key_id != ((slot_config & ECC108D_SLOT_WRITE_KEY_MASK) >> ECC108D_SLOT_WRITE_KEY_SHIFT)))
+		return ecc108d_fail(device);
+
+	ecc108h_calculate_sha256(ECC108_KEY_SIZE, temp_key->value, digest);
+	for (i = 0; i < ECC108_KEY_SIZE; i++)
+		value[i] ^= temp_key->value[i];
+	for (; i < sizeof(value); i++)
+		value[i] ^= digest[i - ECC108_KEY_SIZE];
+
+	p_message = message;
+	memcpy(p_message, temp_key->value, ECC108_KEY_SIZE);
+	p_message += ECC108_KEY_SIZE;
+	*p_message++ = ECC108_PRIVWRITE;
+	*p_message++ = zone;
+	*p_message++ = key_id & 0xFF;
+	*p_message++ = key_id >> 8;
+	*p_message++ = device->config[ECC108D_CONFIG_SN_4 + 4];
+	*p_message++ = device->config[0];
+	*p_message++ = device->config[1];
+	memset(p_message, 0, 21);
+	p_message += 21;
+	memcpy(p_message, value, sizeof(value));
+	ecc108h_calculate_sha256(sizeof(message), message, digest);
+
+	temp_key->valid = 0;
+	if (memcmp(digest, &command[PRIVWRITE_MAC_IDX], sizeof(digest)))
+		return ECC108_STATUS_BYTE_EXEC;
+
+	memcpy(ecc108d_slot(device, key_id, NULL), value, sizeof(value));
+
+	return ECC108D_STATUS_BYTE_SUCCESS;
+}
+
+
+/** \brief This function executes a command packet.
+ *
+ * The physical layer calls this function for every packet it sends to an awake
+ * device. The function checks count and CRC, executes the command, and places the
+ * response into the output buffer. A Pause command whose selector does not match
+ * puts the device into Idle mode without a response.
+ * \param[in,out] device pointer to device
+ * \param[in] count number of bytes in packet
+ * \param[in] command pointer to packet, count byte to CRC
+ */
+void ecc108d_execute(struct ecc108d_device *device, uint8_t count, const uint8_t *command)
+{
+	uint8_t packet[ECC108_CMD_SIZE_MAX];
+	uint8_t crc[ECC108_CRC_SIZE] = {0, 0};
+	uint8_t data[GENKEY_PUBLIC_KEY_SIZE];
+	uint8_t size = 0;
+	uint8_t status;
+
+	device->commands++;
+
+	if ((count < ECC108_CMD_SIZE_MIN) || (count > ECC108_CMD_SIZE_MAX) || (command[ECC108_COUNT_IDX] != count)) {
+		ecc108d_respond_status(device, ECC108_STATUS_BYTE_COMM);
+		return;
+	}
+	memcpy(packet, command, count);
+	ecc108h_calculate_crc_chain(count - ECC108_CRC_SIZE, packet, crc);
+	if ((crc[0] != packet[count - ECC108_CRC_SIZE]) || (crc[1] != packet[count - 1])) {
+		ecc108d_respond_status(device, ECC108_STATUS_BYTE_COMM);
+		return;
+	}
+
+	switch (packet[ECC108_OPCODE_IDX]) {
+	case ECC108_CHECKMAC:
+		status = ecc108d_check_mac(device, count, packet);
+		break;
+
+	case ECC108_DERIVE_KEY:
+		status = ecc108d_derive_key(device, count, packet);
+		break;
+
+	case ECC108_INFO:
+		status = ecc108d_info(device, count, packet, data, &size);
+		break;
+
+	case ECC108_GENDIG:
+		status = ecc108d_gen_dig(device, count, packet);
+		break;
+
+	case ECC108_GENKEY:
+		status = ecc108d_gen_key(device, count, packet, data, &size);
+		break;
+
+	case ECC108_HMAC:
+		status = ecc108d_hmac(device, count, packet, data, &size);
+		break;
+
+	case ECC108_LOCK:
+		status = ecc108d_lock(device, count, packet);
+		break;
+
+	case ECC108_MAC:
+		status = ecc108d_mac(device, count, packet, data, &size);
+		break;
+
+	case ECC108_NONCE:
+		status = ecc108d_nonce(device, count, packet, data, &size);
+		break;
+
+	case ECC108_PAUSE:
+		status = (count == PAUSE_COUNT) ? ECC108D_STATUS_BYTE_SUCCESS : ECC108_STATUS_BYTE_PARSE;
+		if ((status == ECC108D_STATUS_BYTE_SUCCESS)
+				&& (packet[PAUSE_SELECT_IDX] != device->config[ECC108D_CONFIG_SELECTOR])) {
+			device->state = ECC108D_STATE_IDLE;
+			device->response[ECC108_BUFFER_POS_COUNT] = 0;
+			return;
+		}
+		break;
+
+	case ECC108_PRIVWRITE:
+		status = ecc108d_priv_write(device, count, packet);
+		break;
+
+	case ECC108_RANDOM:
+		status = ((count == RANDOM_COUNT) && (packet[RANDOM_MODE_IDX] <= RANDOM_NO_SEED_UPDATE))
+				? ECC108D_STATUS_BYTE_SUCCESS : ECC108_STATUS_BYTE_PARSE;
+		if (status == ECC108D_STATUS_BYTE_SUCCESS) {
+			ecc108d_random(device, packet[RANDOM_MODE_IDX] == RANDOM_SEED_UPDATE, data);
+			size = ECC108_KEY_SIZE;
+		}
+		break;
+
+	case ECC108_READ:
+		status = ecc108d_read(device, count, packet, data, &size);
+		break;
+
+	case ECC108_SIGN:
+		status = ecc108d_sign(device, count, packet, data, &size);
+		break;
+
+	case ECC108_UPDATE_EXTRA:
+		status = ecc108d_update_extra(device, count, packet);
+		break;
+
+	case ECC108_VERIFY:
+		status = ecc108d_verify(device, count, packet);
+		break;
+
+	case ECC108_WRITE:
+		status = ecc108d_write(device, count, packet);
+		break;
+
+	default:
+		status = ECC108_STATUS_BYTE_PARSE;
+		break;
+	}
+
+	if ((status == ECC108D_STATUS_BYTE_SUCCESS) && size)
+		ecc108d_respond(device, size, data);
+	else
+		ecc108d_respond_status(device, status);
+}
+
+
+/** \brief This function returns the execution time of a command in timing-accurate mode.
+ * \param[in] device pointer to device
+ * \param[in] op_code op-code of the command
+ * \return execution time in us
+ */
+static uint32_t ecc108d_execution_time(const struct ecc108d_device *device, uint8_t op_code)
+{
+	uint8_t typical;
+	uint8_t max;
+
+	switch (op_code) {
+	case ECC108_CHECKMAC:      typical = CHECKMAC_DELAY;    max = CHECKMAC_EXEC_MAX;    break;
+	case ECC108_DERIVE_KEY:    typical = DERIVE_KEY_DELAY;  max = DERIVE_KEY_EXEC_MAX;  break;
+	case ECC108_INFO:          typical = INFO_DELAY;        max = INFO_EXEC_MAX;        break;
+	case ECC108_GENDIG:        typical = GENDIG_DELAY;      max = GENDIG_EXEC_MAX;      break;
+	case ECC108_GENKEY:        typical = GENKEY_DELAY;      max = GENKEY_EXEC_MAX;      break;
+	case ECC108_HMAC:          typical = HMAC_DELAY;        max = HMAC_EXEC_MAX;        break;
+	case ECC108_LOCK:          typical = LOCK_DELAY;        max = LOCK_EXEC_MAX;        break;
+	case ECC108_MAC:           typical = MAC_DELAY;         max = MAC_EXEC_MAX;         break;
+	case ECC108_NONCE:         typical = NONCE_DELAY;       max = NONCE_EXEC_MAX;       break;
+	case ECC108_PAUSE:         typical = PAUSE_DELAY;       max = PAUSE_EXEC_MAX;       break;
+	case ECC108_PRIVWRITE:     typical = PRIVWRITE_DELAY;   max = PRIVWRITE_EXEC_MAX;   break;
+	case ECC108_RANDOM:        typical = RANDOM_DELAY;      max = RANDOM_EXEC_MAX;      break;
+	case ECC108_READ:          typical = READ_DELAY;        max = READ_EXEC_MAX;        break;
+	case ECC108_SIGN:          typical = SIGN_DELAY;        max = SIGN_EXEC_MAX;        break;
+	case ECC108_UPDATE_EXTRA:  typical = UPDATE_DELAY;      max = UPDATE_EXEC_MAX;      break;
+	case ECC108_VERIFY:        typical = VERIFY_DELAY;      max = VERIFY_EXEC_MAX;      break;
+	case ECC108_WRITE:         typical = WRITE_DELAY;       max = WRITE_EXEC_MAX;       break;
+	default:                   return 0;
+	}
+
+	return (uint32_t) (device->timing == ECC108D_TIMING_MAX ? max : typical) * 1000;
+}
+
+
+/** \brief This function checks whether the virtual clock has reached a time.
+ * \param[in] time virtual time in us
+ * \return 1 if the clock is at or past the time, 0 otherwise
+ */
+static uint8_t ecc108d_reached(uint32_t time)
+{
+	return (int32_t) (timer_host_get_time() - time) >= 0;
+}
+
+
+/** \brief This function returns the selected device after running its watchdog.
+ *
+ * In timing-accurate mode, a device that has been awake for #ECC108D_WATCHDOG_TIME
+ * goes to sleep and loses TempKey.
+ * \return pointer to device, NULL if none is attached
+ */
+static struct ecc108d_device *ecc108d_selected(void)
+{
+	struct ecc108d_device *device = ecc108d_get_device(ecc108d_device_id);
+
+	if (device && device->timing && (device->state == ECC108D_STATE_AWAKE)
+				&& ecc108d_reached(device->awake_since + ECC108D_WATCHDOG_TIME)) {
+		device->state = ECC108D_STATE_SLEEP;
+		device->temp_key.valid = 0;
+		device->response[ECC108_BUFFER_POS_COUNT] = 0;
+		device->watchdog_expirations++;
+	}
+
+	return device;
+}
+
+
+/** \brief This function selects the device the other physical layer functions address.
+ *
+ *  \param[in] id ID a device was attached under with ecc108d_attach()
+ */
+void ecc108p_set_device_id(uint8_t id)
+{
+	ecc108d_device_id = id;
+}
+
+
+/** \brief This function selects the default device ID.
+ */
+void ecc108p_init(void)
+{
+	ecc108d_device_id = ECC108D_DEFAULT_ID;
+}
+
+
+/** \brief This function sends a Wake token and delays.
+ *
+ * A sleeping or idle device wakes up and places the Wake status into its output buffer.
+ * Waking up from Sleep mode loses TempKey. An awake device ignores the token.
+ * \return status of the operation
+ */
+uint8_t ecc108p_wakeup(void)
+{
+	struct ecc108d_device *device = ecc108d_selected();
+
+	if (device && (device->state != ECC108D_STATE_AWAKE)) {
+		if (device->state == ECC108D_STATE_SLEEP)
+			device->temp_key.valid = 0;
+		device->state = ECC108D_STATE_AWAKE;
+		ecc108d_respond_status(device, ECC108_STATUS_BYTE_WAKEUP);
+		device->awake_since = timer_host_get_time();
+		device->busy_until = device->awake_since + (device->timing ? ECC108D_WAKEUP_TIME : 0);
+	}
+
+	delay_10us(ECC108_WAKEUP_DELAY);
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function sends a command to the device.
+ * \param[in] count number of bytes to send
+ * \param[in] command pointer to command buffer
+ * \return status of the operation
+ */
+uint8_t ecc108p_send_command(uint8_t count, uint8_t *command)
+{
+	struct ecc108d_device *device = ecc108d_selected();
+	uint8_t status;
+
+	if (!device || (device->state != ECC108D_STATE_AWAKE))
+		return ECC108_COMM_FAIL;
+
+	if (device->timing) {
+		// A busy device ignores the command.
+		if (!ecc108d_reached(device->busy_until))
+			return ECC108_COMM_FAIL;
+		timer_host_advance(count * ECC108D_BYTE_TIME);
+	}
+
+	ecc108d_execute(device, count, command);
+
+	if (device->timing) {
+		// Parse and communication errors are reported right away.
+		status = device->response[ECC108_BUFFER_POS_STATUS];
+		device->busy_until = timer_host_get_time();
+		if ((device->response[ECC108_BUFFER_POS_COUNT] != ECC108_RESPONSE_SIZE_MIN)
+					|| ((status != ECC108_STATUS_BYTE_PARSE) && (status != ECC108_STATUS_BYTE_COMM)))
+			device->busy_until += ecc108d_execution_time(device, command[ECC108_OPCODE_IDX]);
+	}
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function puts the device into a power state.
+ * \param[in] state #ECC108D_STATE_IDLE or #ECC108D_STATE_SLEEP
+ * \return status of the operation
+ */
+static uint8_t ecc108d_power_down(uint8_t state)
+{
+	struct ecc108d_device *device = ecc108d_selected();
+
+	if (!device || (device->state != ECC108D_STATE_AWAKE))
+		return ECC108_COMM_FAIL;
+
+	device->state = state;
+	device->response[ECC108_BUFFER_POS_COUNT] = 0;
+	if (state == ECC108D_STATE_SLEEP)
+		device->temp_key.valid = 0;
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function puts the device into idle state.
+ * \return status of the operation
+ */
+uint8_t ecc108p_idle(void)
+{
+	return ecc108d_power_down(ECC108D_STATE_IDLE);
+}
+
+
+/** \brief This function puts the device into low-power state.
+ *  \return status of the operation
+ */
+uint8_t ecc108p_sleep(void)
+{
+	return ecc108d_power_down(ECC108D_STATE_SLEEP);
+}
+
+
+/** \brief This function resets the I/O buffer of the device.
+ *
+ * The response stays in the output buffer, so it can be read again.
+ * \return status of the operation
+ */
+uint8_t ecc108p_reset_io(void)
+{
+	struct ecc108d_device *device = ecc108d_selected();
+
+	if (!device || (device->state != ECC108D_STATE_AWAKE))
+		return ECC108_COMM_FAIL;
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function receives a response from the device.
+ *
+ * The CRC of the response is checked as in the other physical layers.
+ * The function returns #ECC108_BAD_CRC if it does not match the received one.
+ *
+ * \param[in] size size of rx buffer
+ * \param[out] response pointer to rx buffer
+ * \return status of the operation
+ */
+uint8_t ecc108p_receive_response(uint8_t size, uint8_t *response)
+{
+	struct ecc108d_device *device = ecc108d_selected();
+	uint8_t crc[ECC108_CRC_SIZE] = {0, 0};
+	uint8_t count;
+
+	if (device && device->timing && (device->state == ECC108D_STATE_AWAKE) && !ecc108d_reached(device->busy_until)) {
+		// A response that becomes ready while the host listens is received.
+		if (!ecc108d_reached(device->busy_until - ECC108_RESPONSE_TIMEOUT)) {
+			timer_host_advance(ECC108_RESPONSE_TIMEOUT);
+			return ECC108_RX_NO_RESPONSE;
+		}
+		timer_host_advance(device->busy_until - timer_host_get_time());
+	}
+
+	if (!device || (device->state != ECC108D_STATE_AWAKE) || !device->response[ECC108_BUFFER_POS_COUNT]) {
+		if (device && device->timing)
+			timer_host_advance(ECC108_RESPONSE_TIMEOUT);
+		return ECC108_RX_NO_RESPONSE;
+	}
+
+	count = device->response[ECC108_BUFFER_POS_COUNT];
+	response[ECC108_BUFFER_POS_COUNT] = count;
+	if ((count < ECC108_RESPONSE_SIZE_MIN) || (count > size))
+		return ECC108_INVALID_SIZE;
+
+	if (device->timing)
+		timer_host_advance(count * ECC108D_BYTE_TIME);
+
+	memcpy(response, device->response, count);
+	ecc108h_calculate_crc_chain(count - ECC108_CRC_SIZE, response, crc);
+	if ((crc[0] != response[count - ECC108_CRC_SIZE]) || (crc[1] != response[count - 1]))
+		return ECC108_BAD_CRC;
+
+	return ECC108_SUCCESS;
+}
+
+
+/** \brief This function resynchronizes communication.
+ *
+ * An awake device acknowledges and resets its I/O buffer. A sleeping or idle
+ * device does not, so the Communication layer sends a Wake token next.
+ * \param[in] size size of rx buffer
+ * \param[out] response pointer to response buffer
+ * \return status of the operation
+ */
+uint8_t ecc108p_resync(uint8_t size, uint8_t *response)
+{
+	(void) size;
+	(void) response;
+
+	return ecc108p_reset_io();
+}
+
+/** @} */
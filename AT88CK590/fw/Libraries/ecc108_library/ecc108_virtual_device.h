@@ -0,0 +1,253 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the ATECC108 Virtual Device
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef ECC108_VIRTUAL_DEVICE_H
+#   define ECC108_VIRTUAL_DEVICE_H
+
+#include <stdint.h>                    // data type definitions
+#include "ecc108_helper.h"             // definitions and declarations for the Helper module
+#include "ecc108_comm_marshaling.h"    // definitions of commands, key size, and response size
+
+
+/** \defgroup atecc108_virtual_device Module 10: Virtual Device
+ *
+ * \brief
+ * This module is a software model of an ATECC108 device. It implements the functions
+ * declared in \ref ecc108_physical.h, so it can be linked instead of ecc108_swi.c or
+ * ecc108_i2c.c. The unmodified Communication and Command Marshaling layers then
+ * run against it on a host, at memory speed and without hardware. Define ECC108_VIRTUAL
+ * for these builds, and link timer_utilities_host.c instead of timer_utilities.c.
+ *
+ * The model holds the configuration, OTP, and data zones, the lock bytes, TempKey, and
+ * the sleep / idle / awake state of a device. It parses command packets, checks their
+ * CRC, and executes Info, Nonce, Random, GenDig, MAC, HMAC, CheckMac, DeriveKey,
+ * Read, Write, Lock, UpdateExtra, Pause, GenKey, Sign, Verify, and PrivWrite.
+ * The digests are calculated with the ecc108h_* functions of the Helper module,
+ * the P-256 keys and signatures with the \ref p256 module.
+ *
+ * The data zone has the ATECC108 layout: slots 0 to 7 hold 36 bytes, slot 8
+ * holds 416 bytes, and slots 9 to 15 hold 72 bytes. Data zone addresses
+ * are (block << 8) | (slot << 3) | word. A private key is stored as four pad
+ * bytes followed by the 32-byte key, the form PrivWrite writes. A public key
+ * that Verify reads from a slot is stored as four pad bytes, X, four pad bytes, Y.
+ * KeyConfig bit 0 marks a slot as private key, bits 2 to 4 give the key type.
+ * Private keys cannot be read, written, or used by GenDig and MAC.
+ *
+ * Up to #ECC108D_DEVICES_MAX devices can be attached, each under an ID for
+ * ecc108p_set_device_id(). An application allocates a struct ecc108d_device,
+ * initializes it with ecc108d_device_init(), and personalizes it like a real
+ * device, with Write, PrivWrite, and Lock commands. It can also fill the zones
+ * directly before it locks them.
+ *
+ * The model follows the access rules this library relies on. It does not model
+ * the use counters, the GenKey digest modes, or the ECDH and GPIO functions.
+ * Random numbers, private keys, and signature nonces come from a deterministic
+ * generator seeded by ecc108d_device_init(), so that runs can be reproduced.
+ * They are not secure, and the P-256 calculations are not constant time.
+ *
+ * By default a device answers at memory speed. Set ecc108d_device::timing to
+ * #ECC108D_TIMING_TYPICAL or #ECC108D_TIMING_MAX to make it run on the virtual clock
+ * of timer_utilities_host.c instead. A command then executes for the typical
+ * (*_DELAY) or maximum (*_EXEC_MAX) time of \ref ecc108_comm_marshaling.h, during
+ * which the device does not respond. A device woken up responds after
+ * #ECC108D_WAKEUP_TIME, and its watchdog puts it to sleep, losing TempKey,
+ * #ECC108D_WATCHDOG_TIME after it woke up. The model always uses the 1.3 s watchdog,
+ * whatever ChipMode selects. Transfers advance the clock by #ECC108D_BYTE_TIME per
+ * byte, and a poll without response by #ECC108_RESPONSE_TIMEOUT.
+@{ */
+
+//! maximum number of devices that can be attached at the same time
+#define ECC108D_DEVICES_MAX              (8)
+
+//! device ID ecc108p_init() selects, the default I<SUP>2</SUP>C address of an ATECC108
+#define ECC108D_DEFAULT_ID               ((uint8_t) 0xC0)
+
+/** \name Times of the Timing-Accurate Mode in us
+@{ */
+#define ECC108D_WAKEUP_TIME              ((uint32_t) 1500)     //!< tWHI, the device does not respond before
+#define ECC108D_WATCHDOG_TIME            ((uint32_t) 1300000)  //!< tWATCHDOG, the device goes to sleep after being awake this long
+#define ECC108D_BYTE_TIME                ((uint32_t) 23)       //!< time to transfer a byte, nine clocks at 400 kHz
+/** @} */
+
+//! size of the serial number
+#define ECC108D_SN_SIZE                  (9)
+
+/** \name Zone and Slot Sizes
+@{ */
+#define ECC108D_CONFIG_SIZE              (128)     //!< size of the configuration zone
+#define ECC108D_OTP_SIZE                 (64)      //!< size of the OTP zone
+#define ECC108D_DATA_SIZE                (1208)    //!< size of the data zone
+#define ECC108D_SLOT_SIZE_KEY            (36)      //!< size of slots 0 to 7
+#define ECC108D_SLOT_SIZE_8              (416)     //!< size of slot 8
+#define ECC108D_SLOT_SIZE_PUBLIC         (72)      //!< size of slots 9 to 15
+#define ECC108D_KEY_PAD_SIZE             (4)       //!< pad bytes in front of a stored private key or coordinate
+/** @} */
+
+/** \name Configuration Zone Addresses
+@{ */
+#define ECC108D_CONFIG_REVISION          ( 4)      //!< RevNum[0:3]
+#define ECC108D_CONFIG_SN_4              ( 8)      //!< SN[4:8]
+#define ECC108D_CONFIG_I2C_ADDRESS       (16)      //!< I2C address
+#define ECC108D_CONFIG_OTP_MODE          (18)      //!< OTP mode
+#define ECC108D_CONFIG_SLOT_CONFIG       (20)      //!< SlotConfig[0:15], two bytes each, LSB first
+#define ECC108D_CONFIG_WRITABLE          (16)      //!< first byte the Write command can change
+#define ECC108D_CONFIG_USER_EXTRA        (84)      //!< UserExtra, written by UpdateExtra mode 0
+#define ECC108D_CONFIG_SELECTOR          (85)      //!< Selector, written by UpdateExtra mode 1
+#define ECC108D_CONFIG_LOCK_VALUE        (86)      //!< lock byte of Data and OTP zones
+#define ECC108D_CONFIG_LOCK_CONFIG       (87)      //!< lock byte of Configuration zone
+#define ECC108D_CONFIG_WRITABLE_2        (88)      //!< first byte the Write command can change after the lock bytes
+#define ECC108D_CONFIG_KEY_CONFIG        (96)      //!< KeyConfig[0:15], two bytes each, LSB first
+/** @} */
+
+/** \name Lock Byte and OTP Mode Values
+@{ */
+#define ECC108D_UNLOCKED                 ((uint8_t) 0x55)  //!< zone is not locked
+#define ECC108D_LOCKED                   ((uint8_t) 0x00)  //!< zone is locked
+#define ECC108D_OTP_MODE_CONSUMPTION     ((uint8_t) 0x55)  //!< OTP bits can be cleared after locking
+#define ECC108D_OTP_MODE_READ_ONLY       ((uint8_t) 0xAA)  //!< OTP zone cannot be written after locking
+/** @} */
+
+/** \name SlotConfig Bits
+@{ */
+#define ECC108D_SLOT_READ_KEY_MASK       (0x000F)  //!< key for encrypted reads
+#define ECC108D_SLOT_SIGN_EXTERNAL       (0x0001)  //!< private key: Sign of external messages is allowed
+#define ECC108D_SLOT_NO_MAC              (0x0010)  //!< key cannot be used by MAC and HMAC
+#define ECC108D_SLOT_ENCRYPT_READ        (0x0040)  //!< 32-byte reads are encrypted
+#define ECC108D_SLOT_IS_SECRET           (0x0080)  //!< slot cannot be read
+#define ECC108D_SLOT_WRITE_KEY_SHIFT     (8)       //!< position of the key for encrypted writes and DeriveKey
+#define ECC108D_SLOT_WRITE_KEY_MASK      (0x0F00)  //!< key for encrypted writes and DeriveKey
+#define ECC108D_SLOT_WRITE_CONFIG_MASK   (0xF000)  //!< WriteConfig, 0 allows clear writes
+#define ECC108D_SLOT_DERIVE_CREATE       (0x1000)  //!< DeriveKey uses WriteKey as parent, otherwise the slot itself
+#define ECC108D_SLOT_DERIVE_KEY          (0x2000)  //!< DeriveKey is allowed
+#define ECC108D_SLOT_GEN_KEY             (0x2000)  //!< private key: GenKey is allowed after the data zone is locked
+#define ECC108D_SLOT_WRITE_ENCRYPT       (0x4000)  //!< encrypted Write, or encrypted PrivWrite of a private key, is allowed
+#define ECC108D_SLOT_DERIVE_MAC          (0x8000)  //!< DeriveKey requires an input MAC
+/** @} */
+
+/** \name KeyConfig Bits
+@{ */
+#define ECC108D_KEY_PRIVATE              (0x0001)  //!< slot holds a private key
+#define ECC108D_KEY_TYPE_SHIFT           (2)       //!< position of the key type
+#define ECC108D_KEY_TYPE_MASK            (0x001C)  //!< key type
+#define ECC108D_KEY_TYPE_P256            (4)       //!< key type of a P-256 key
+#define ECC108D_KEY_TYPE_NOT_ECC         (7)       //!< key type of a SHA key or data
+/** @} */
+
+/** \name Response Status Bytes not defined by the Communication Module
+@{ */
+#define ECC108D_STATUS_BYTE_SUCCESS      ((uint8_t) 0x00)  //!< command succeeded
+#define ECC108D_STATUS_BYTE_MISCOMPARE   ((uint8_t) 0x01)  //!< CheckMac or Verify miscompare
+/** @} */
+
+
+//! power states of a virtual device
+enum ecc108d_state {
+	ECC108D_STATE_SLEEP,   //!< TempKey is lost, only a Wake token is answered
+	ECC108D_STATE_IDLE,    //!< TempKey is kept, only a Wake token is answered
+	ECC108D_STATE_AWAKE    //!< commands are accepted
+};
+
+
+//! timing modes of a virtual device
+enum ecc108d_timing {
+	ECC108D_TIMING_OFF,     //!< commands execute at memory speed
+	ECC108D_TIMING_TYPICAL, //!< commands take their typical execution time
+	ECC108D_TIMING_MAX      //!< commands take their maximum execution time
+};
+
+
+/** \struct ecc108d_device
+ *  \brief State of a virtual device.
+ *  \var ecc108d_device::config
+ *       \brief Configuration zone.
+ *  \var ecc108d_device::otp
+ *       \brief OTP zone.
+ *  \var ecc108d_device::data
+ *       \brief Data zone, 16 slots of 36, 416, or 72 bytes.
+ *  \var ecc108d_device::temp_key
+ *       \brief TempKey register and its flags.
+ *  \var ecc108d_device::seed
+ *       \brief State of the random number generator.
+ *  \var ecc108d_device::random_count
+ *       \brief Number of random numbers generated.
+ *  \var ecc108d_device::state
+ *       \brief Power state, one of #ecc108d_state.
+ *  \var ecc108d_device::response
+ *       \brief Output buffer, count byte to CRC.
+ *  \var ecc108d_device::commands
+ *       \brief Number of command packets received.
+ *  \var ecc108d_device::timing
+ *       \brief Timing mode, one of #ecc108d_timing.
+ *  \var ecc108d_device::awake_since
+ *       \brief Virtual time at which the device woke up.
+ *  \var ecc108d_device::busy_until
+ *       \brief Virtual time at which the device responds again.
+ *  \var ecc108d_device::watchdog_expirations
+ *       \brief Number of times the watchdog put the device to sleep.
+ */
+struct ecc108d_device {
+	uint8_t config[ECC108D_CONFIG_SIZE];
+	uint8_t otp[ECC108D_OTP_SIZE];
+	uint8_t data[ECC108D_DATA_SIZE];
+	struct ecc108h_temp_key temp_key;
+	uint8_t seed[ECC108_KEY_SIZE];
+	uint32_t random_count;
+	uint8_t state;
+	uint8_t response[ECC108_RESPONSE_SIZE_MAX];
+	uint32_t commands;
+	uint8_t timing;
+	uint32_t awake_since;
+	uint32_t busy_until;
+	uint32_t watchdog_expirations;
+};
+
+
+void ecc108d_device_init(struct ecc108d_device *device, const uint8_t *sn, const uint8_t *seed);
+uint8_t ecc108d_attach(uint8_t id, struct ecc108d_device *device);
+struct ecc108d_device *ecc108d_get_device(uint8_t id);
+uint16_t ecc108d_get_slot_config(const struct ecc108d_device *device, uint8_t key_id);
+void ecc108d_set_slot_config(struct ecc108d_device *device, uint8_t key_id, uint16_t slot_config);
+uint16_t ecc108d_get_key_config(const struct ecc108d_device *device, uint8_t key_id);
+void ecc108d_set_key_config(struct ecc108d_device *device, uint8_t key_id, uint16_t key_config);
+uint8_t *ecc108d_slot(struct ecc108d_device *device, uint8_t key_id, uint16_t *size);
+void ecc108d_execute(struct ecc108d_device *device, uint8_t count, const uint8_t *command);
+
+/** @} */
+
+#endif
@@ -0,0 +1,483 @@
+/** \file
+ *  \brief  AES-128 Block Cipher and CCM Mode
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdint.h>                    // data type definitions
+
+#include "aes128.h"                    // header module for this C module
+
+#if defined(AES128_PORTABLE)
+// Only the portable cipher is built.
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+//! The AES-NI cipher is built.
+#   define AES128_AES_NI
+#   include <immintrin.h>              // SSE2 and AES intrinsics
+#elif defined(__GNUC__) && !defined(__clang__) && defined(__aarch64__) && defined(__linux__)
+//! The ARMv8 Cryptography Extensions cipher is built.
+#   define AES128_ARMV8_CE
+#   include <arm_neon.h>               // NEON and AES intrinsics
+#   include <sys/auxv.h>               // needed for getauxval()
+#   ifndef HWCAP_AES
+#      define HWCAP_AES             (1 << 3)
+#   endif
+#endif
+
+
+//! substitution box
+static const uint8_t aes128_sbox[256] = {
+	0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+	0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+	0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+	0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+	0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+	0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+	0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+	0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+	0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+	0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+	0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+	0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+	0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+	0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+	0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+	0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+};
+
+/** \brief round table: SubBytes and MixColumns of one state byte
+ *
+ * Entry x holds the column {2, 1, 1, 3} * S(x), MSB first. The tables of the other
+ * three rows are rotations of this one.
+ */
+static const uint32_t aes128_te[256] = {
+	0xC66363A5, 0xF87C7C84, 0xEE777799, 0xF67B7B8D, 0xFFF2F20D, 0xD66B6BBD, 0xDE6F6FB1, 0x91C5C554,
+	0x60303050, 0x02010103, 0xCE6767A9, 0x562B2B7D, 0xE7FEFE19, 0xB5D7D762, 0x4DABABE6, 0xEC76769A,
+	0x8FCACA45, 0x1F82829D, 0x89C9C940, 0xFA7D7D87, 0xEFFAFA15, 0xB25959EB, 0x8E4747C9, 0xFBF0F00B,
+	0x41ADADEC, 0xB3D4D467, 0x5FA2A2FD, 0x45AFAFEA, 0x239C9CBF, 0x53A4A4F7, 0xE4727296, 0x9BC0C05B,
+	0x75B7B7C2, 0xE1FDFD1C, 0x3D9393AE, 0x4C26266A, 0x6C36365A, 0x7E3F3F41, 0xF5F7F702, 0x83CCCC4F,
+	0x6834345C, 0x51A5A5F4, 0xD1E5E534, 0xF9F1F108, 0xE2717193, 0xABD8D873, 0x62313153, 0x2A15153F,
+	0x0804040C, 0x95C7C752, 0x46232365, 0x9DC3C35E, 0x30181828, 0x379696A1, 0x0A05050F, 0x2F9A9AB5,
+	0x0E070709, 0x24121236, 0x1B80809B, 0xDFE2E23D, 0xCDEBEB26, 0x4E272769, 0x7FB2B2CD, 0xEA75759F,
+	0x1209091B, 0x1D83839E, 0x582C2C74, 0x341A1A2E, 0x361B1B2D, 0xDC6E6EB2, 0xB45A5AEE, 0x5BA0A0FB,
+	0xA45252F6, 0x763B3B4D, 0xB7D6D661, 0x7DB3B3CE, 0x5229297B, 0xDDE3E33E, 0x5E2F2F71, 0x13848497,
+	0xA65353F5, 0xB9D1D168, 0x00000000, 0xC1EDED2C, 0x40202060, 0xE3FCFC1F, 0x79B1B1C8, 0xB65B5BED,
+	0xD46A6ABE, 0x8DCBCB46, 0x67BEBED9, 0x7239394B, 0x944A4ADE, 0x984C4CD4, 0xB05858E8, 0x85CFCF4A,
+	0xBBD0D06B, 0xC5EFEF2A, 0x4FAAAAE5, 0xEDFBFB16, 0x864343C5, 0x9A4D4DD7, 0x66333355, 0x11858594,
+	0x8A4545CF, 0xE9F9F910, 0x04020206, 0xFE7F7F81, 0xA05050F0, 0x783C3C44, 0x259F9FBA, 0x4BA8A8E3,
+	0xA25151F3, 0x5DA3A3FE, 0x804040C0, 0x058F8F8A, 0x3F9292AD, 0x219D9DBC, 0x70383848, 0xF1F5F504,
+	0x63BCBCDF, 0x77B6B6C1, 0xAFDADA75, 0x42212163, 0x20101030, 0xE5FFFF1A, 0xFDF3F30E, 0xBFD2D26D,
+	0x81CDCD4C, 0x180C0C14, 0x26131335, 0xC3ECEC2F, 0xBE5F5FE1, 0x359797A2, 0x884444CC, 0x2E171739,
+	0x93C4C457, 0x55A7A7F2, 0xFC7E7E82, 0x7A3D3D47, 0xC86464AC, 0xBA5D5DE7, 0x3219192B, 0xE6737395,
+	0xC06060A0, 0x19818198, 0x9E4F4FD1, 0xA3DCDC7F, 0x44222266, 0x542A2A7E, 0x3B9090AB, 0x0B888883,
+	0x8C4646CA, 0xC7EEEE29, 0x6BB8B8D3, 0x2814143C, 0xA7DEDE79, 0xBC5E5EE2, 0x160B0B1D, 0xADDBDB76,
+	0xDBE0E03B, 0x64323256, 0x743A3A4E, 0x140A0A1E, 0x924949DB, 0x0C06060A, 0x4824246C, 0xB85C5CE4,
+	0x9FC2C25D, 0xBDD3D36E, 0x43ACACEF, 0xC46262A6, 0x399191A8, 0x319595A4, 0xD3E4E437, 0xF279798B,
+	0xD5E7E732, 0x8BC8C843, 0x6E373759, 0xDA6D6DB7, 0x018D8D8C, 0xB1D5D564, 0x9C4E4ED2, 0x49A9A9E0,
+	0xD86C6CB4, 0xAC5656FA, 0xF3F4F407, 0xCFEAEA25, 0xCA6565AF, 0xF47A7A8E, 0x47AEAEE9, 0x10080818,
+	0x6FBABAD5, 0xF0787888, 0x4A25256F, 0x5C2E2E72, 0x381C1C24, 0x57A6A6F1, 0x73B4B4C7, 0x97C6C651,
+	0xCBE8E823, 0xA1DDDD7C, 0xE874749C, 0x3E1F1F21, 0x964B4BDD, 0x61BDBDDC, 0x0D8B8B86, 0x0F8A8A85,
+	0xE0707090, 0x7C3E3E42, 0x71B5B5C4, 0xCC6666AA, 0x904848D8, 0x06030305, 0xF7F6F601, 0x1C0E0E12,
+	0xC26161A3, 0x6A35355F, 0xAE5757F9, 0x69B9B9D0, 0x17868691, 0x99C1C158, 0x3A1D1D27, 0x279E9EB9,
+	0xD9E1E138, 0xEBF8F813, 0x2B9898B3, 0x22111133, 0xD26969BB, 0xA9D9D970, 0x078E8E89, 0x339494A7,
+	0x2D9B9BB6, 0x3C1E1E22, 0x15878792, 0xC9E9E920, 0x87CECE49, 0xAA5555FF, 0x50282878, 0xA5DFDF7A,
+	0x038C8C8F, 0x59A1A1F8, 0x09898980, 0x1A0D0D17, 0x65BFBFDA, 0xD7E6E631, 0x844242C6, 0xD06868B8,
+	0x824141C3, 0x299999B0, 0x5A2D2D77, 0x1E0F0F11, 0x7BB0B0CB, 0xA85454FC, 0x6DBBBBD6, 0x2C16163A
+};
+
+//! round constants of the key expansion
+static const uint8_t aes128_rcon[AES128_ROUNDS] = {
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36
+};
+
+#define rotate_right(value, places) (((value) >> (places)) | ((value) << (32 - (places))))
+
+//! reads a big-endian word
+#define aes128_load(p)          (((uint32_t) (p)[0] << 24) | ((uint32_t) (p)[1] << 16) | ((uint32_t) (p)[2] << 8) | (p)[3])
+
+
+/** \brief This function encrypts one block with the portable table-driven cipher.
+ *
+ * \param[in] key expanded key
+ * \param[in] in 16-byte plaintext block
+ * \param[out] out 16-byte ciphertext block, may be the same as in
+ */
+static void aes128_encrypt_block_portable(const struct aes128_key *key, const uint8_t *in, uint8_t *out)
+{
+	uint8_t round, i;
+	uint32_t s[4], t[4];
+	const uint8_t *rk = key->round_key[0];
+
+	for (i = 0; i < 4; i++)
+		s[i] = aes128_load(&in[i << 2]) ^ aes128_load(&rk[i << 2]);
+
+	for (round = 1; round < AES128_ROUNDS; round++) {
+		rk = key->round_key[round];
+		for (i = 0; i < 4; i++)
+			t[i] = aes128_te[s[i] >> 24]
+				^ rotate_right(aes128_te[(s[(i + 1) & 3] >> 16) & 0xFF], 8)
+				^ rotate_right(aes128_te[(s[(i + 2) & 3] >> 8) & 0xFF], 16)
+				^ rotate_right(aes128_te[s[(i + 3) & 3] & 0xFF], 24)
+				^ aes128_load(&rk[i << 2]);
+		memcpy(s, t, sizeof(s));
+	}
+
+	// The last round has no MixColumns.
+	rk = key->round_key[AES128_ROUNDS];
+	for (i = 0; i < 4; i++) {
+		out[(i << 2) + 0] = aes128_sbox[s[i] >> 24] ^ rk[(i << 2) + 0];
+		out[(i << 2) + 1] = aes128_sbox[(s[(i + 1) & 3] >> 16) & 0xFF] ^ rk[(i << 2) + 1];
+		out[(i << 2) + 2] = aes128_sbox[(s[(i + 2) & 3] >> 8) & 0xFF] ^ rk[(i << 2) + 2];
+		out[(i << 2) + 3] = aes128_sbox[s[(i + 3) & 3] & 0xFF] ^ rk[(i << 2) + 3];
+	}
+}
+
+
+/** \brief This function encrypts blocks with the portable cipher, one after the other.
+ *
+ * \param[in] count number of blocks
+ * \param[in] keys expanded key of every block
+ * \param[in] in consecutive 16-byte plaintext blocks
+ * \param[out] out consecutive 16-byte ciphertext blocks, may be the same as in
+ */
+static void aes128_encrypt_lanes_portable(uint8_t count, const struct aes128_key *const *keys, const uint8_t *in, uint8_t *out)
+{
+	uint8_t i;
+
+	for (i = 0; i < count; i++)
+		aes128_encrypt_block_portable(keys[i], &in[i * AES128_BLOCK_SIZE], &out[i * AES128_BLOCK_SIZE]);
+}
+
+
+#ifdef AES128_AES_NI
+/** \brief This function encrypts blocks using the x86 AES instructions.
+ *
+ * The rounds of all blocks are interleaved, so the next AESENC can issue
+ * before the previous one has finished.
+ *
+ * \param[in] count number of blocks, at most #AES128_LANES_MAX
+ * \param[in] keys expanded key of every block
+ * \param[in] in consecutive 16-byte plaintext blocks
+ * \param[out] out consecutive 16-byte ciphertext blocks, may be the same as in
+ */
+__attribute__((target("aes,sse2")))
+static void aes128_encrypt_lanes_aes_ni(uint8_t count, const struct aes128_key *const *keys, const uint8_t *in, uint8_t *out)
+{
+	uint8_t round, i;
+	__m128i state[AES128_LANES_MAX];
+
+	for (i = 0; i < count; i++)
+		state[i] = _mm_xor_si128(_mm_loadu_si128((const __m128i *) &in[i * AES128_BLOCK_SIZE]),
+				_mm_loadu_si128((const __m128i *) keys[i]->round_key[0]));
+
+	for (round = 1; round < AES128_ROUNDS; round++)
+		for (i = 0; i < count; i++)
+			state[i] = _mm_aesenc_si128(state[i], _mm_loadu_si128((const __m128i *) keys[i]->round_key[round]));
+
+	for (i = 0; i < count; i++)
+		_mm_storeu_si128((__m128i *) &out[i * AES128_BLOCK_SIZE],
+				_mm_aesenclast_si128(state[i], _mm_loadu_si128((const __m128i *) keys[i]->round_key[AES128_ROUNDS])));
+}
+#endif
+
+
+#ifdef AES128_ARMV8_CE
+/** \brief This function encrypts blocks using the ARMv8 Cryptography Extensions.
+ *
+ * AESE adds the round key before SubBytes and ShiftRows, so the last round key is
+ * added with a plain exclusive-or. The rounds of all blocks are interleaved.
+ *
+ * \param[in] count number of blocks, at most #AES128_LANES_MAX
+ * \param[in] keys expanded key of every block
+ * \param[in] in consecutive 16-byte plaintext blocks
+ * \param[out] out consecutive 16-byte ciphertext blocks, may be the same as in
+ */
+__attribute__((target("+crypto")))
+static void aes128_encrypt_lanes_armv8(uint8_t count, const struct aes128_key *const *keys, const uint8_t *in, uint8_t *out)
+{
+	uint8_t round, i;
+	uint8x16_t state[AES128_LANES_MAX];
+
+	for (i = 0; i < count; i++)
+		state[i] = vld1q_u8(&in[i * AES128_BLOCK_SIZE]);
+
+	for (round = 0; round < AES128_ROUNDS - 1; round++)
+		for (i = 0; i < count; i++)
+			state[i] = vaesmcq_u8(vaeseq_u8(state[i], vld1q_u8(keys[i]->round_key[round])));
+
+	for (i = 0; i < count; i++)
+		vst1q_u8(&out[i * AES128_BLOCK_SIZE],
+				veorq_u8(vaeseq_u8(state[i], vld1q_u8(keys[i]->round_key[AES128_ROUNDS - 1])),
+				vld1q_u8(keys[i]->round_key[AES128_ROUNDS])));
+}
+#endif
+
+
+//! type of a cipher function that encrypts up to #AES128_LANES_MAX blocks
+typedef void (*aes128_encrypt_lanes_t)(uint8_t count, const struct aes128_key *const *keys, const uint8_t *in, uint8_t *out);
+
+#if defined(AES128_AES_NI) || defined(AES128_ARMV8_CE)
+//! cipher function, replaced by aes128_select() if the CPU supports a faster one
+static aes128_encrypt_lanes_t aes128_encrypt_lanes_function = aes128_encrypt_lanes_portable;
+
+
+/** \brief This function selects the fastest cipher function the CPU supports.
+ *
+ * It runs as a constructor before main(), so the cipher function is selected before
+ * any thread can use it.
+ */
+__attribute__((constructor)) static void aes128_select(void)
+{
+#   if defined(AES128_AES_NI)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("aes") && __builtin_cpu_supports("sse2"))
+		aes128_encrypt_lanes_function = aes128_encrypt_lanes_aes_ni;
+#   else
+	if (getauxval(AT_HWCAP) & HWCAP_AES)
+		aes128_encrypt_lanes_function = aes128_encrypt_lanes_armv8;
+#   endif
+}
+
+#else
+//! cipher function, fixed at compile time
+static const aes128_encrypt_lanes_t aes128_encrypt_lanes_function = aes128_encrypt_lanes_portable;
+#endif
+
+
+/** \brief This function expands a cipher key into the round keys.
+ *
+ * \param[out] key expanded key
+ * \param[in] key_bytes 16-byte cipher key
+ */
+void aes128_key_init(struct aes128_key *key, const uint8_t *key_bytes)
+{
+	uint8_t round, i;
+	uint8_t *rk;
+	const uint8_t *previous;
+
+	memcpy(key->round_key[0], key_bytes, AES128_KEY_SIZE);
+
+	for (round = 1; round <= AES128_ROUNDS; round++) {
+		rk = key->round_key[round];
+		previous = key->round_key[round - 1];
+
+		// RotWord, SubWord and Rcon of the last word of the previous round key.
+		rk[0] = previous[0] ^ aes128_sbox[previous[13]] ^ aes128_rcon[round - 1];
+		rk[1] = previous[1] ^ aes128_sbox[previous[14]];
+		rk[2] = previous[2] ^ aes128_sbox[previous[15]];
+		rk[3] = previous[3] ^ aes128_sbox[previous[12]];
+		for (i = 4; i < AES128_KEY_SIZE; i++)
+			rk[i] = previous[i] ^ rk[i - 4];
+	}
+}
+
+
+/** \brief This function encrypts one block.
+ *
+ * \param[in] key key expanded by aes128_key_init()
+ * \param[in] in 16-byte plaintext block
+ * \param[out] out 16-byte ciphertext block, may be the same as in
+ */
+void aes128_encrypt(const struct aes128_key *key, const uint8_t *in, uint8_t *out)
+{
+	aes128_encrypt_lanes_function(1, &key, in, out);
+}
+
+
+/** \brief This function encrypts independent blocks, each under its own key.
+ *
+ * \param[in] count number of blocks, at most #AES128_LANES_MAX
+ * \param[in] keys keys expanded by aes128_key_init(), one per block; entries may repeat
+ * \param[in] in consecutive 16-byte plaintext blocks
+ * \param[out] out consecutive 16-byte ciphertext blocks, may be the same as in
+ */
+void aes128_encrypt_lanes(uint8_t count, const struct aes128_key *const *keys, const uint8_t *in, uint8_t *out)
+{
+	aes128_encrypt_lanes_function(count, keys, in, out);
+}
+
+
+/** \brief This function formats counter block A(i) of CCM.
+ *
+ * \param[out] block 16-byte counter block
+ * \param[in] nonce_len nonce size in bytes, 7 to 13
+ * \param[in] nonce nonce
+ * \param[in] index counter value
+ */
+static void aes128_ccm_counter(uint8_t *block, uint8_t nonce_len, const uint8_t *nonce, uint16_t index)
+{
+	memset(block, 0, AES128_BLOCK_SIZE);
+	block[0] = (uint8_t) (AES128_BLOCK_SIZE - 2 - nonce_len);     // L - 1
+	memcpy(&block[1], nonce, nonce_len);
+	block[AES128_BLOCK_SIZE - 2] = (uint8_t) (index >> 8);
+	block[AES128_BLOCK_SIZE - 1] = (uint8_t) index;
+}
+
+
+/** \brief This function runs CCM over a message in either direction.
+ *
+ * Every payload block takes one counter block and one CBC-MAC block. Both are
+ * encrypted by one aes128_encrypt_lanes() call.
+ *
+ * \param[in] key expanded key
+ * \param[in] nonce_len nonce size in bytes, 7 to 13
+ * \param[in] nonce nonce
+ * \param[in] aad_len size of the associated data, less than 0xFF00
+ * \param[in] aad associated data, authenticated but not encrypted
+ * \param[in] len payload size, must fit into 15 - nonce_len bytes
+ * \param[in] in payload to encrypt or decrypt
+ * \param[out] out encrypted or decrypted payload, may be the same as in
+ * \param[in] tag_len tag size, 4 to 16, even
+ * \param[out] tag tag calculated over the plaintext
+ * \param[in] decrypt 0: in is plaintext, 1: in is ciphertext
+ */
+static void aes128_ccm(const struct aes128_key *key, uint8_t nonce_len, const uint8_t *nonce,
+			uint16_t aad_len, const uint8_t *aad, uint16_t len, const uint8_t *in, uint8_t *out,
+			uint8_t tag_len, uint8_t *tag, uint8_t decrypt)
+{
+	uint8_t i, fill, lane;
+	uint8_t pending = 0;
+	uint16_t block_index, block_len;
+	uint8_t mac[AES128_BLOCK_SIZE];
+	uint8_t s0[AES128_BLOCK_SIZE];
+	uint8_t lanes[2 * AES128_BLOCK_SIZE];
+	const struct aes128_key *keys[2] = {key, key};
+
+	// B0 and A0
+	aes128_ccm_counter(mac, nonce_len, nonce, 0);
+	mac[0] |= (aad_len ? 0x40 : 0x00) | (uint8_t) (((tag_len - 2) / 2) << 3);
+	mac[AES128_BLOCK_SIZE - 2] = (uint8_t) (len >> 8);
+	mac[AES128_BLOCK_SIZE - 1] = (uint8_t) len;
+	aes128_ccm_counter(s0, nonce_len, nonce, 0);
+	memcpy(&lanes[0], mac, AES128_BLOCK_SIZE);
+	memcpy(&lanes[AES128_BLOCK_SIZE], s0, AES128_BLOCK_SIZE);
+	aes128_encrypt_lanes(2, keys, lanes, lanes);
+	memcpy(mac, &lanes[0], AES128_BLOCK_SIZE);
+	memcpy(s0, &lanes[AES128_BLOCK_SIZE], AES128_BLOCK_SIZE);
+
+	// Associated data, preceded by its two-byte length and padded with zeros.
+	if (aad_len) {
+		mac[0] ^= (uint8_t) (aad_len >> 8);
+		mac[1] ^= (uint8_t) aad_len;
+		fill = 2;
+		while (aad_len) {
+			for (; fill < AES128_BLOCK_SIZE && aad_len; fill++, aad_len--)
+				mac[fill] ^= *aad++;
+			aes128_encrypt(key, mac, mac);
+			fill = 0;
+		}
+	}
+
+	/* Payload: the CBC-MAC block and the next key stream block are encrypted side by side.
+	 * Decryption needs the key stream before the plaintext enters the CBC-MAC, so its
+	 * CBC-MAC runs one block behind. */
+	for (block_index = 1; len; block_index++, len -= block_len, in += block_len, out += block_len) {
+		block_len = len < AES128_BLOCK_SIZE ? len : AES128_BLOCK_SIZE;
+		if (!decrypt) {
+			for (i = 0; i < block_len; i++)
+				mac[i] ^= in[i];
+			pending = 1;
+		}
+		lane = 0;
+		if (pending)
+			memcpy(&lanes[lane++ * AES128_BLOCK_SIZE], mac, AES128_BLOCK_SIZE);
+		aes128_ccm_counter(&lanes[lane * AES128_BLOCK_SIZE], nonce_len, nonce, block_index);
+		aes128_encrypt_lanes(lane + 1, keys, lanes, lanes);
+		if (pending)
+			memcpy(mac, &lanes[0], AES128_BLOCK_SIZE);
+
+		for (i = 0; i < block_len; i++)
+			out[i] = in[i] ^ lanes[lane * AES128_BLOCK_SIZE + i];
+		if (decrypt)
+			for (i = 0; i < block_len; i++)
+				mac[i] ^= out[i];
+		pending = decrypt;
+	}
+	if (pending)
+		aes128_encrypt(key, mac, mac);
+
+	for (i = 0; i < tag_len; i++)
+		tag[i] = mac[i] ^ s0[i];
+}
+
+
+/** \brief This function encrypts a payload and calculates its tag with CCM.
+ *
+ * The tag length field of block B0 is (tag_len - 2) / 2 and the length field is
+ * 15 - nonce_len bytes long, as defined by NIST SP 800-38C.
+ *
+ * \param[in] key key expanded by aes128_key_init()
+ * \param[in] nonce_len nonce size in bytes, 7 to 13
+ * \param[in] nonce nonce
+ * \param[in] aad_len size of the associated data, less than 0xFF00
+ * \param[in] aad associated data, authenticated but not encrypted
+ * \param[in] len payload size
+ * \param[in] in plaintext
+ * \param[out] out ciphertext, may be the same as in
+ * \param[in] tag_len tag size, 4 to 16, even
+ * \param[out] tag tag
+ */
+void aes128_ccm_encrypt(const struct aes128_key *key, uint8_t nonce_len, const uint8_t *nonce,
+			uint16_t aad_len, const uint8_t *aad, uint16_t len, const uint8_t *in, uint8_t *out,
+			uint8_t tag_len, uint8_t *tag)
+{
+	aes128_ccm(key, nonce_len, nonce, aad_len, aad, len, in, out, tag_len, tag, 0);
+}
+
+
+/** \brief This function decrypts a payload with CCM and calculates the tag it should carry.
+ *
+ * The caller compares the tag with the received one, and discards the plaintext if
+ * they differ.
+ *
+ * \param[in] key key expanded by aes128_key_init()
+ * \param[in] nonce_len nonce size in bytes, 7 to 13
+ * \param[in] nonce nonce
+ * \param[in] aad_len size of the associated data, less than 0xFF00
+ * \param[in] aad associated data, authenticated but not encrypted
+ * \param[in] len payload size
+ * \param[in] in ciphertext
+ * \param[out] out plaintext, may be the same as in
+ * \param[in] tag_len tag size, 4 to 16, even
+ * \param[out] tag expected tag
+ */
+void aes128_ccm_decrypt(const struct aes128_key *key, uint8_t nonce_len, const uint8_t *nonce,
+			uint16_t aad_len, const uint8_t *aad, uint16_t len, const uint8_t *in, uint8_t *out,
+			uint8_t tag_len, uint8_t *tag)
+{
+	aes128_ccm(key, nonce_len, nonce, aad_len, aad, len, in, out, tag_len, tag, 1);
+}
@@ -0,0 +1,95 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the AES-128 Block Cipher Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef AES128_H
+#   define AES128_H
+
+#include <stdint.h>                    // data type definitions
+
+
+/** \defgroup aes128 AES-128 Block Cipher
+ *
+ * \brief
+ * This module implements the AES-128 forward cipher (FIPS 197) and the CCM mode
+ * (NIST SP 800-38C) built on it. CCM only needs the forward cipher, so there is no
+ * inverse cipher. The host-side helper functions of the AES132 library calculate
+ * the nonces, MACs and encrypted data of the device with this module.
+ *
+ * On x86 hosts with the AES instructions (AES-NI) and on ARMv8 Linux hosts with the
+ * Cryptography Extensions, the rounds run on these instructions. The CPU features are
+ * checked once, before main() runs. All other targets use a
+ * portable table-driven cipher.
+ * Define AES128_PORTABLE to build only the portable code, e.g. to compare speed.
+ *
+ * CBC-MAC chains cannot be parallelized within one message, but the AES rounds of
+ * independent blocks can. aes128_encrypt_lanes() encrypts up to #AES128_LANES_MAX
+ * blocks, each under its own key, with their rounds interleaved, so the pipelined
+ * AES units stay busy. The CCM functions use it to run the counter and CBC-MAC
+ * blocks of a message side by side.
+@{ */
+
+#define AES128_KEY_SIZE         (16)   //!< size of an AES-128 key in bytes
+#define AES128_BLOCK_SIZE       (16)   //!< size of an AES block in bytes
+#define AES128_ROUNDS           (10)   //!< number of AES-128 rounds
+#define AES128_LANES_MAX         (8)   //!< maximum number of blocks per aes128_encrypt_lanes() call
+
+
+/** \struct aes128_key
+ *  \brief Structure to hold an expanded AES-128 key
+ *  \var aes128_key::round_key
+ *       \brief Round keys in the byte order of the state, first round key = cipher key.
+ */
+struct aes128_key {
+	uint8_t round_key[AES128_ROUNDS + 1][AES128_BLOCK_SIZE];
+};
+
+
+void aes128_key_init(struct aes128_key *key, const uint8_t *key_bytes);
+void aes128_encrypt(const struct aes128_key *key, const uint8_t *in, uint8_t *out);
+void aes128_encrypt_lanes(uint8_t count, const struct aes128_key *const *keys, const uint8_t *in, uint8_t *out);
+void aes128_ccm_encrypt(const struct aes128_key *key, uint8_t nonce_len, const uint8_t *nonce,
+			uint16_t aad_len, const uint8_t *aad, uint16_t len, const uint8_t *in, uint8_t *out,
+			uint8_t tag_len, uint8_t *tag);
+void aes128_ccm_decrypt(const struct aes128_key *key, uint8_t nonce_len, const uint8_t *nonce,
+			uint16_t aad_len, const uint8_t *aad, uint16_t len, const uint8_t *in, uint8_t *out,
+			uint8_t tag_len, uint8_t *tag);
+
+/** @} */
+
+#endif //AES128_H
@@ -0,0 +1,561 @@
+/** \file
+ *  \brief  Digest Calculations Shared by the SHA204 and ECC108 Libraries
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdint.h>
+
+#include "cryptoauth_core.h"           // header module for this C module
+
+
+/** \brief This function creates a SHA-256 digest.
+ *
+ * The message sizes of the CryptoAuth commands are hashed by the fixed-length functions
+ * of the SHA-256 module, whose padding is resolved at compile time.
+ *
+ * \param[in] len byte length of message
+ * \param[in] message pointer to message
+ * \param[out] digest SHA-256 of message
+ */
+void cryptoauth_sha256(uint32_t len, const uint8_t *message, uint8_t *digest)
+{
+	switch (len) {
+	case CRYPTOAUTH_MSG_SIZE_KEY_SHORT:
+		sha256_39(message, digest);
+		break;
+
+	case CRYPTOAUTH_MSG_SIZE_NONCE:
+		sha256_55(message, digest);
+		break;
+
+	case CRYPTOAUTH_MSG_SIZE_MAC:
+		sha256_88(message, digest);
+		break;
+
+	case CRYPTOAUTH_MSG_SIZE_KEY:        // also outer HMAC message
+		sha256_96(message, digest);
+		break;
+
+	case CRYPTOAUTH_MSG_SIZE_HMAC_INNER:
+		sha256_152(message, digest);
+		break;
+
+	default:
+		sha256(len, message, digest);
+		break;
+	}
+}
+
+
+/** \brief This function copies OTP and SN data into a message buffer.
+ *
+ * These are the last 21 bytes of a MAC or HMAC message.
+ *
+ * \param[in] mode mode parameter of the MAC or HMAC command
+ * \param[in] otp pointer to 11 bytes of OTP, can be NULL if not included by mode
+ * \param[in] sn pointer to 9 bytes of SN, can be NULL if not included by mode
+ * \param[out] p_temp pointer to message buffer
+ * \return pointer to the message byte after the included data
+ */
+uint8_t *cryptoauth_include_data(uint8_t mode, const uint8_t *otp, const uint8_t *sn, uint8_t *p_temp)
+{
+	// (6) 8 bytes OTP[0:7] or zeros, (7) 3 bytes OTP[8:10] or zeros
+	if (mode & CRYPTOAUTH_MODE_INCLUDE_OTP_88) {
+		memcpy(p_temp, otp, CRYPTOAUTH_OTP_SIZE_8 + CRYPTOAUTH_OTP_SIZE_3);     // use OTP[0:10], Mode:5 is overridden
+		p_temp += CRYPTOAUTH_OTP_SIZE_8 + CRYPTOAUTH_OTP_SIZE_3;
+	}
+	else {
+		if (mode & CRYPTOAUTH_MODE_INCLUDE_OTP_64)
+			memcpy(p_temp, otp, CRYPTOAUTH_OTP_SIZE_8);
+		else
+			memset(p_temp, 0, CRYPTOAUTH_OTP_SIZE_8);
+		p_temp += CRYPTOAUTH_OTP_SIZE_8;
+
+		memset(p_temp, 0, CRYPTOAUTH_OTP_SIZE_3);
+		p_temp += CRYPTOAUTH_OTP_SIZE_3;
+	}
+
+	// (8) 1 byte SN[8] = 0xEE
+	*p_temp++ = CRYPTOAUTH_SN_8;
+
+	// (9) 4 bytes SN[4:7] or zeros
+	if (mode & CRYPTOAUTH_MODE_INCLUDE_SN)
+		memcpy(p_temp, &sn[4], CRYPTOAUTH_SN_SIZE_4);
+	else
+		memset(p_temp, 0, CRYPTOAUTH_SN_SIZE_4);
+	p_temp += CRYPTOAUTH_SN_SIZE_4;
+
+	// (10) 2 bytes SN[0:1] = 0x0123
+	*p_temp++ = CRYPTOAUTH_SN_0;
+	*p_temp++ = CRYPTOAUTH_SN_1;
+
+	// (11) 2 bytes SN[2:3] or zeros
+	if (mode & CRYPTOAUTH_MODE_INCLUDE_SN)
+		memcpy(p_temp, &sn[2], CRYPTOAUTH_SN_SIZE_2);
+	else
+		memset(p_temp, 0, CRYPTOAUTH_SN_SIZE_2);
+	p_temp += CRYPTOAUTH_SN_SIZE_2;
+
+	return p_temp;
+}
+
+
+//! zeros hashed in place of data that is not included
+static const uint8_t cryptoauth_zeros[CRYPTOAUTH_KEY_SIZE] = {0};
+
+//! SN[8], SN[0], SN[1]: the serial number bytes that are the same in all devices
+static const uint8_t cryptoauth_sn_fixed[3] = {CRYPTOAUTH_SN_8, CRYPTOAUTH_SN_0, CRYPTOAUTH_SN_1};
+
+
+/** \brief This function describes the OTP and SN data of a MAC or HMAC message as segments.
+ *
+ * The segments hash the same 21 bytes cryptoauth_include_data() copies.
+ *
+ * \param[in] mode mode parameter of the MAC or HMAC command
+ * \param[in] otp pointer to 11 bytes of OTP, can be NULL if not included by mode
+ * \param[in] sn pointer to 9 bytes of SN, can be NULL if not included by mode
+ * \param[out] segments pointer to array of at least CRYPTOAUTH_INCLUDE_SEGMENTS_MAX segments
+ * \return number of segments
+ */
+static uint8_t cryptoauth_include_segments(uint8_t mode, const uint8_t *otp, const uint8_t *sn,
+		struct sha256_segment *segments)
+{
+	struct sha256_segment *segment = segments;
+
+	// (6) 8 bytes OTP[0:7] or zeros, (7) 3 bytes OTP[8:10] or zeros
+	if (mode & CRYPTOAUTH_MODE_INCLUDE_OTP_88) {
+		segment->data = otp;
+		segment->len = CRYPTOAUTH_OTP_SIZE_8 + CRYPTOAUTH_OTP_SIZE_3;
+	}
+	else if (mode & CRYPTOAUTH_MODE_INCLUDE_OTP_64) {
+		segment->data = otp;
+		segment->len = CRYPTOAUTH_OTP_SIZE_8;
+		segment++;
+		segment->data = cryptoauth_zeros;
+		segment->len = CRYPTOAUTH_OTP_SIZE_3;
+	}
+	else {
+		segment->data = cryptoauth_zeros;
+		segment->len = CRYPTOAUTH_OTP_SIZE_8 + CRYPTOAUTH_OTP_SIZE_3;
+	}
+	segment++;
+
+	// (8) 1 byte SN[8] = 0xEE
+	segment->data = &cryptoauth_sn_fixed[0];
+	segment->len = 1;
+	segment++;
+
+	// (9) 4 bytes SN[4:7] or zeros
+	segment->data = (mode & CRYPTOAUTH_MODE_INCLUDE_SN) ? &sn[4] : cryptoauth_zeros;
+	segment->len = CRYPTOAUTH_SN_SIZE_4;
+	segment++;
+
+	// (10) 2 bytes SN[0:1] = 0x0123
+	segment->data = &cryptoauth_sn_fixed[1];
+	segment->len = 2;
+	segment++;
+
+	// (11) 2 bytes SN[2:3] or zeros
+	segment->data = (mode & CRYPTOAUTH_MODE_INCLUDE_SN) ? &sn[2] : cryptoauth_zeros;
+	segment->len = CRYPTOAUTH_SN_SIZE_2;
+	segment++;
+
+	return (uint8_t) (segment - segments);
+}
+
+
+//! maximum number of segments of a message, reached by an HMAC message
+#define CRYPTOAUTH_MESSAGE_SEGMENTS_MAX      (4 + CRYPTOAUTH_INCLUDE_SEGMENTS_MAX)
+
+//! maximum number of command parameter bytes in a message, reached by a key message
+#define CRYPTOAUTH_MESSAGE_PARAMS_MAX        (7)
+
+
+/** \brief This function describes a message as segments.
+ *
+ * These are the segments the digest functions of this module hash.
+ *
+ * \param[in] fields pointer to the fields of the message
+ * \param[out] params pointer to CRYPTOAUTH_MESSAGE_PARAMS_MAX bytes for the command parameters
+ * \param[out] segments pointer to array of CRYPTOAUTH_MESSAGE_SEGMENTS_MAX segments
+ * \return number of segments
+ */
+static uint8_t cryptoauth_message_segments(const struct cryptoauth_message_fields *fields, uint8_t *params,
+		struct sha256_segment *segments)
+{
+	struct sha256_segment *segment = segments;
+	const uint8_t *other_data = fields->other_data;
+
+	// (1) RandOut, key, password, or (K0 ^ ipad) / (K0 ^ opad)
+	segment->data = fields->block1;
+	segment->len = (fields->layout == CRYPTOAUTH_LAYOUT_HMAC_INNER) || (fields->layout == CRYPTOAUTH_LAYOUT_HMAC_OUTER)
+			? CRYPTOAUTH_HMAC_BLOCK_SIZE : CRYPTOAUTH_KEY_SIZE;
+	segment++;
+
+	params[0] = fields->opcode;
+	params[1] = fields->param1;
+	params[2] = fields->param2 & 0xFF;
+	params[3] = (fields->param2 >> 8) & 0xFF;
+
+	switch (fields->layout) {
+	case CRYPTOAUTH_LAYOUT_NONCE:
+		// (2) 20 bytes NumIn, (3) 1 byte opcode, (4) 1 byte mode, (5) 1 byte 0
+		params[2] = 0;
+		segment->data = fields->block2;
+		segment->len = CRYPTOAUTH_NUM_IN_SIZE;
+		segment++;
+		segment->data = params;
+		segment->len = 3;
+		segment++;
+		break;
+
+	case CRYPTOAUTH_LAYOUT_HMAC_INNER:
+		// (1) 32 zeros after the (K0 ^ ipad) block
+		segment->data = cryptoauth_zeros;
+		segment->len = CRYPTOAUTH_HMAC_BLOCK_SIZE - CRYPTOAUTH_KEY_SIZE;
+		segment++;
+		// fall through - the rest is a MAC message with TempKey as the second block
+
+	case CRYPTOAUTH_LAYOUT_MAC:
+		// (2) challenge or TempKey, (3) 1 byte opcode, (4) 1 byte mode, (5) 2 bytes key id
+		segment->data = fields->block2;
+		segment->len = CRYPTOAUTH_KEY_SIZE;
+		segment++;
+		segment->data = params;
+		segment->len = 4;
+		segment++;
+		// (6 - 11) OTP and SN data
+		segment += cryptoauth_include_segments(fields->param1, fields->otp, fields->sn, segment);
+		break;
+
+	case CRYPTOAUTH_LAYOUT_CHECK_MAC:
+		{
+			const struct sha256_segment check_mac_segments[] = {
+				{fields->block2, CRYPTOAUTH_KEY_SIZE},                                  // (2) 32 bytes TempKey
+				{&other_data[0], 4},                                                    // (3, 4, 5) OtherData[0:3]
+				{fields->otp ? fields->otp : cryptoauth_zeros, CRYPTOAUTH_OTP_SIZE_8},  // (6) OTP[0:7] or zeros
+				{&other_data[4], 3},                                                    // (7) OtherData[4:6]
+				{&cryptoauth_sn_fixed[0], 1},                                           // (8) SN[8] = 0xEE
+				{&other_data[7], 4},                                                    // (9) OtherData[7:10]
+				{&cryptoauth_sn_fixed[1], 2},                                           // (10) SN[0:1] = 0x0123
+				{&other_data[11], 2}                                                    // (11) OtherData[11:12]
+			};
+			memcpy(segment, check_mac_segments, sizeof(check_mac_segments));
+			segment += sizeof(check_mac_segments) / sizeof(check_mac_segments[0]);
+		}
+		break;
+
+	case CRYPTOAUTH_LAYOUT_HMAC_OUTER:
+		// inner digest
+		segment->data = fields->block2;
+		segment->len = SHA256_DIGEST_SIZE;
+		segment++;
+		break;
+
+	case CRYPTOAUTH_LAYOUT_KEY:
+		// (2) 1 byte opcode, (3) 1 byte Param1, (4) 2 bytes Param2, (5) SN[8] = 0xEE, (6) SN[0:1] = 0x0123
+		memcpy(&params[4], cryptoauth_sn_fixed, sizeof(cryptoauth_sn_fixed));
+		segment->data = params;
+		segment->len = 4 + sizeof(cryptoauth_sn_fixed);
+		segment++;
+		if (!fields->block2)
+			break;
+		// (7) 25 zeros, (8) 32 bytes data
+		segment->data = cryptoauth_zeros;
+		segment->len = CRYPTOAUTH_ZEROS_SIZE;
+		segment++;
+		segment->data = fields->block2;
+		segment->len = CRYPTOAUTH_KEY_SIZE;
+		segment++;
+		break;
+	}
+
+	return (uint8_t) (segment - segments);
+}
+
+
+/** \brief This function assembles a message in one buffer.
+ *
+ * The message holds the same bytes the digest functions of this module hash,
+ * e.g. for a lane of a sha256_batch() call.
+ *
+ * \param[in] fields pointer to the fields of the message
+ * \param[out] message pointer to message buffer, CRYPTOAUTH_MSG_SIZE_HMAC_INNER bytes are enough for every layout
+ * \return size of the message
+ */
+uint8_t cryptoauth_message(const struct cryptoauth_message_fields *fields, uint8_t *message)
+{
+	uint8_t params[CRYPTOAUTH_MESSAGE_PARAMS_MAX];
+	struct sha256_segment segments[CRYPTOAUTH_MESSAGE_SEGMENTS_MAX];
+	uint8_t count = cryptoauth_message_segments(fields, params, segments);
+	uint8_t *p_temp = message;
+	uint8_t i;
+
+	for (i = 0; i < count; i++) {
+		memcpy(p_temp, segments[i].data, segments[i].len);
+		p_temp += segments[i].len;
+	}
+
+	return (uint8_t) (p_temp - message);
+}
+
+
+/** \brief This function calculates the nonce a device stores in TempKey when it executes
+ *         a Nonce command in one of the random modes.
+ *
+ * \param[in] opcode Nonce opcode
+ * \param[in] mode mode parameter of the Nonce command
+ * \param[in] rand_out pointer to the 32-byte random number the device returned
+ * \param[in] num_in pointer to the 20-byte input value sent to the device
+ * \param[out] digest pointer to 32-byte nonce
+ */
+void cryptoauth_nonce(uint8_t opcode, uint8_t mode, const uint8_t *rand_out, const uint8_t *num_in, uint8_t *digest)
+{
+	const uint8_t params[] = {opcode, mode, 0x00};
+	const struct sha256_segment segments[] = {
+		{rand_out, CRYPTOAUTH_KEY_SIZE},
+		{num_in, CRYPTOAUTH_NUM_IN_SIZE},
+		{params, sizeof(params)}
+	};
+
+	sha256_55_segments(sizeof(segments) / sizeof(segments[0]), segments, digest);
+}
+
+
+/** \brief This function calculates the digest of a MAC command.
+ *
+ * \param[in] opcode MAC opcode
+ * \param[in] mode mode parameter of the MAC command
+ * \param[in] key_id key id parameter of the MAC command
+ * \param[in] block1 pointer to the first 32 bytes of the message (key or TempKey)
+ * \param[in] block2 pointer to the second 32 bytes of the message (challenge or TempKey)
+ * \param[in] otp pointer to OTP, can be NULL if not included by mode
+ * \param[in] sn pointer to SN, can be NULL if not included by mode
+ * \param[out] digest pointer to 32-byte MAC
+ */
+void cryptoauth_mac(uint8_t opcode, uint8_t mode, uint16_t key_id, const uint8_t *block1, const uint8_t *block2,
+		const uint8_t *otp, const uint8_t *sn, uint8_t *digest)
+{
+	// (3) 1 byte opcode, (4) 1 byte mode, (5) 2 bytes key id
+	const uint8_t params[] = {opcode, mode, key_id & 0xFF, (key_id >> 8) & 0xFF};
+	struct sha256_segment segments[3 + CRYPTOAUTH_INCLUDE_SEGMENTS_MAX] = {
+		{block1, CRYPTOAUTH_KEY_SIZE},
+		{block2, CRYPTOAUTH_KEY_SIZE},
+		{params, sizeof(params)}
+	};
+	uint8_t count = 3;
+
+	// (6 - 11) OTP and SN data
+	count += cryptoauth_include_segments(mode, otp, sn, &segments[count]);
+
+	sha256_88_segments(count, segments, digest);
+}
+
+
+/** \brief This function calculates the client response of a CheckMac command used for password checking.
+ *
+ * \param[in] password pointer to the 32-byte password
+ * \param[in] temp_key pointer to the 32-byte TempKey value
+ * \param[in] other_data pointer to the 13 bytes of OtherData
+ * \param[in] otp pointer to OTP[0:7], NULL to hash zeros instead
+ * \param[out] digest pointer to 32-byte client response
+ */
+void cryptoauth_check_mac(const uint8_t *password, const uint8_t *temp_key, const uint8_t *other_data,
+		const uint8_t *otp, uint8_t *digest)
+{
+	const struct sha256_segment segments[] = {
+		{password, CRYPTOAUTH_KEY_SIZE},                        // (1) 32 bytes password
+		{temp_key, CRYPTOAUTH_KEY_SIZE},                        // (2) 32 bytes TempKey
+		{&other_data[0], 4},                                    // (3, 4, 5) OtherData[0:3]
+		{otp ? otp : cryptoauth_zeros, CRYPTOAUTH_OTP_SIZE_8},  // (6) OTP[0:7] or zeros
+		{&other_data[4], 3},                                    // (7) OtherData[4:6]
+		{&cryptoauth_sn_fixed[0], 1},                           // (8) SN[8] = 0xEE
+		{&other_data[7], 4},                                    // (9) OtherData[7:10]
+		{&cryptoauth_sn_fixed[1], 2},                           // (10) SN[0:1] = 0x0123
+		{&other_data[11], 2}                                    // (11) OtherData[11:12]
+	};
+
+	sha256_88_segments(sizeof(segments) / sizeof(segments[0]), segments, digest);
+}
+
+
+/** \brief This function hashes the (K0 ^ ipad) and (K0 ^ opad) blocks of a 32-byte HMAC key.
+ *
+ * Refer to fips-198a.pdf, length Key = 32 bytes, Block size = 512 bits = 64 bytes.
+ * So the key is padded with zeros.
+ *
+ * \param[in] key pointer to 32-byte key
+ * \param[out] inner pointer to the eight words of the inner midstate
+ * \param[out] outer pointer to the eight words of the outer midstate
+ */
+void cryptoauth_hmac_key_init(const uint8_t *key, uint32_t *inner, uint32_t *outer)
+{
+	uint8_t pad[CRYPTOAUTH_HMAC_BLOCK_SIZE];
+	struct sha256_ctx ctx;
+	uint8_t i;
+
+	for (i = 0; i < CRYPTOAUTH_HMAC_BLOCK_SIZE; i++)
+		pad[i] = (i < CRYPTOAUTH_KEY_SIZE ? key[i] : 0) ^ 0x36;
+	sha256_init(&ctx);
+	sha256_update(&ctx, CRYPTOAUTH_HMAC_BLOCK_SIZE, pad);
+	memcpy(inner, ctx.hash, sizeof(ctx.hash));
+
+	for (i = 0; i < CRYPTOAUTH_HMAC_BLOCK_SIZE; i++)
+		pad[i] = (i < CRYPTOAUTH_KEY_SIZE ? key[i] : 0) ^ 0x5C;
+	sha256_init(&ctx);
+	sha256_update(&ctx, CRYPTOAUTH_HMAC_BLOCK_SIZE, pad);
+	memcpy(outer, ctx.hash, sizeof(ctx.hash));
+}
+
+
+/** \brief This function calculates the digest of an HMAC command from precomputed key midstates.
+ *
+ * \param[in] opcode HMAC opcode
+ * \param[in] mode mode parameter of the HMAC command
+ * \param[in] key_id key id parameter of the HMAC command
+ * \param[in] inner pointer to the inner midstate from cryptoauth_hmac_key_init()
+ * \param[in] outer pointer to the outer midstate from cryptoauth_hmac_key_init()
+ * \param[in] temp_key pointer to the 32-byte TempKey value
+ * \param[in] otp pointer to OTP, can be NULL if not included by mode
+ * \param[in] sn pointer to SN, can be NULL if not included by mode
+ * \param[out] digest pointer to 32-byte HMAC
+ */
+void cryptoauth_hmac(uint8_t opcode, uint8_t mode, uint16_t key_id, const uint32_t *inner, const uint32_t *outer,
+		const uint8_t *temp_key, const uint8_t *otp, const uint8_t *sn, uint8_t *digest)
+{
+	// (3) 1 byte opcode, (4) 1 byte mode, (5) 2 bytes key id
+	const uint8_t params[] = {opcode, mode, key_id & 0xFF, (key_id >> 8) & 0xFF};
+	// (K0 ^ ipad) is already hashed into the inner midstate, so only the stream of data 'text' is hashed.
+	struct sha256_segment segments[3 + CRYPTOAUTH_INCLUDE_SEGMENTS_MAX] = {
+		{cryptoauth_zeros, CRYPTOAUTH_HMAC_BLOCK_SIZE - CRYPTOAUTH_KEY_SIZE},   // (1) 32 zeros
+		{temp_key, CRYPTOAUTH_KEY_SIZE},                                        // (2) 32 bytes TempKey
+		{params, sizeof(params)}
+	};
+	uint8_t count = 3;
+
+	// (6 - 11) OTP and SN data
+	count += cryptoauth_include_segments(mode, otp, sn, &segments[count]);
+
+	// H((K0 ^ ipad) : text), use digest for temporary storage
+	sha256_152_midstate(inner, count, segments, digest);
+
+	// H((K0 ^ opad) : H((K0 ^ ipad) : text))
+	segments[0].data = digest;
+	segments[0].len = SHA256_DIGEST_SIZE;
+	sha256_96_midstate(outer, 1, segments, digest);
+}
+
+
+/** \brief This function calculates the digest that combines a key with the parameters of a command.
+ *
+ * With data this is the GenDig, DeriveKey and Write MAC message:
+ * Key{32} || OpCode || Param1 || Param2{2} || SN[8] || SN[0:1] || 0{25} || Data{32}.
+ * Without data the message ends after SN[0:1], as the input MAC of a DeriveKey command does.
+ * Digest can point to key or data, e.g. to TempKey for GenDig.
+ *
+ * \param[in] opcode command opcode
+ * \param[in] param1 first command parameter (zone, mode or random flag)
+ * \param[in] param2 second command parameter (key id or address)
+ * \param[in] key pointer to the 32-byte key
+ * \param[in] data pointer to 32 bytes of data (TempKey or plain text), NULL for the short message
+ * \param[out] digest pointer to 32-byte digest
+ */
+void cryptoauth_key_digest(uint8_t opcode, uint8_t param1, uint16_t param2, const uint8_t *key,
+		const uint8_t *data, uint8_t *digest)
+{
+	// (2) 1 byte opcode, (3) 1 byte Param1, (4) 2 bytes Param2, (5) SN[8] = 0xEE, (6) SN[0:1] = 0x0123
+	const uint8_t params[] = {opcode, param1, param2 & 0xFF, (param2 >> 8) & 0xFF,
+			CRYPTOAUTH_SN_8, CRYPTOAUTH_SN_0, CRYPTOAUTH_SN_1};
+	const struct sha256_segment segments[] = {
+		{key, CRYPTOAUTH_KEY_SIZE},                 // (1) 32 bytes key
+		{params, sizeof(params)},
+		{cryptoauth_zeros, CRYPTOAUTH_ZEROS_SIZE},  // (7) 25 zeros
+		{data, CRYPTOAUTH_KEY_SIZE}                 // (8) 32 bytes data
+	};
+
+	if (data)
+		sha256_96_segments(sizeof(segments) / sizeof(segments[0]), segments, digest);
+	else
+		sha256_39_segments(2, segments, digest);
+}
+
+
+/** \brief This function hashes the first block of a key digest message.
+ *
+ * The first block holds the key, the command parameters, the fixed serial number
+ * bytes and the zeros, so it is the same for every GenDig or Write MAC with the
+ * same key and parameters. The midstate it returns is as secret as the key.
+ *
+ * \param[in] opcode command op-code
+ * \param[in] param1 Param1 of the command
+ * \param[in] param2 Param2 of the command
+ * \param[in] key pointer to 32-byte key
+ * \param[out] midstate pointer to the eight words of the midstate
+ */
+void cryptoauth_key_digest_init(uint8_t opcode, uint8_t param1, uint16_t param2, const uint8_t *key, uint32_t *midstate)
+{
+	const uint8_t params[] = {opcode, param1, param2 & 0xFF, (param2 >> 8) & 0xFF,
+			CRYPTOAUTH_SN_8, CRYPTOAUTH_SN_0, CRYPTOAUTH_SN_1};
+	const struct sha256_segment segments[] = {
+		{key, CRYPTOAUTH_KEY_SIZE},
+		{params, sizeof(params)},
+		{cryptoauth_zeros, CRYPTOAUTH_ZEROS_SIZE}
+	};
+	struct sha256_ctx ctx;
+
+	sha256_init(&ctx);
+	sha256_update_segments(&ctx, sizeof(segments) / sizeof(segments[0]), segments);
+	memcpy(midstate, ctx.hash, sizeof(ctx.hash));
+}
+
+
+/** \brief This function finishes a key digest from the midstate of its first block.
+ *
+ * The digest is the one cryptoauth_key_digest() calculates with the same parameters
+ * and data, but only the block with the data is hashed. Digest can point to data.
+ *
+ * \param[in] midstate pointer to the midstate from cryptoauth_key_digest_init()
+ * \param[in] data pointer to 32-byte data
+ * \param[out] digest pointer to 32-byte digest
+ */
+void cryptoauth_key_digest_final(const uint32_t *midstate, const uint8_t *data, uint8_t *digest)
+{
+	const struct sha256_segment segment = {data, CRYPTOAUTH_KEY_SIZE};
+
+	sha256_96_midstate(midstate, 1, &segment, digest);
+}
@@ -0,0 +1,164 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Digest Calculations Shared by the SHA204 and ECC108 Libraries
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef CRYPTOAUTH_CORE_H
+#   define CRYPTOAUTH_CORE_H
+
+#include <stdint.h>                    // data type definitions
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+
+
+/** \defgroup cryptoauth_core Digest Calculations of the SHA204 and ECC108 Devices
+ *
+ * \brief
+ * The ATSHA204 and ATECC108 devices hash the same messages when they execute
+ * the Nonce, MAC, CheckMac, HMAC, GenDig, DeriveKey and Write commands.
+ * This module assembles and hashes these messages. The Helper modules of both
+ * libraries check their parameters and maintain their TempKey structure,
+ * and call this module for the digest.
+ *
+ * The messages are hashed as lists of segments that point to the command fields,
+ * so they are never copied into a message buffer. The batch lanes of the
+ * Multi-Buffer SHA-256 module need a message in one buffer, which
+ * cryptoauth_message() assembles from the same segments.
+ *
+ * Opcodes are passed by the caller, so this module does not depend on
+ * either library.
+@{ */
+
+/** \name Field Sizes and Fixed Values of the Hashed Messages
+@{ */
+#define CRYPTOAUTH_KEY_SIZE             (32)   //!< size of a key, TempKey, challenge or digest
+#define CRYPTOAUTH_NUM_IN_SIZE          (20)   //!< size of NumIn in a Nonce message
+#define CRYPTOAUTH_OTHER_DATA_SIZE      (13)   //!< size of OtherData in a CheckMac message
+#define CRYPTOAUTH_OTP_SIZE_8           ( 8)   //!< size of OTP[0:7]
+#define CRYPTOAUTH_OTP_SIZE_3           ( 3)   //!< size of OTP[8:10]
+#define CRYPTOAUTH_SN_SIZE_4            ( 4)   //!< size of SN[4:7]
+#define CRYPTOAUTH_SN_SIZE_2            ( 2)   //!< size of SN[2:3]
+#define CRYPTOAUTH_ZEROS_SIZE           (25)   //!< number of zeros in GenDig, DeriveKey and Write MAC messages
+#define CRYPTOAUTH_HMAC_BLOCK_SIZE      (64)   //!< HMAC block size, the key is padded with zeros to this size
+#define CRYPTOAUTH_SN_0               (0x01)   //!< fixed value of SN[0]
+#define CRYPTOAUTH_SN_1               (0x23)   //!< fixed value of SN[1]
+#define CRYPTOAUTH_SN_8               (0xEE)   //!< fixed value of SN[8]
+/** @} */
+
+/** \name Mode Bits that Include OTP and SN in MAC and HMAC Messages
+@{ */
+#define CRYPTOAUTH_MODE_INCLUDE_OTP_88  ((uint8_t) 0x10)   //!< include OTP[0:10]
+#define CRYPTOAUTH_MODE_INCLUDE_OTP_64  ((uint8_t) 0x20)   //!< include OTP[0:7]
+#define CRYPTOAUTH_MODE_INCLUDE_SN      ((uint8_t) 0x40)   //!< include SN[2:3] and SN[4:7]
+/** @} */
+
+/** \name Message Sizes
+@{ */
+#define CRYPTOAUTH_MSG_SIZE_NONCE           (55)   //!< RandOut{32} || NumIn{20} || OpCode{1} || Mode{1} || 0{1}
+#define CRYPTOAUTH_MSG_SIZE_MAC             (88)   //!< Block1{32} || Block2{32} || OpCode{1} || Mode{1} || KeyId{2} || included data{21}
+#define CRYPTOAUTH_MSG_SIZE_HMAC_INNER     (152)   //!< (K0 ^ ipad){64} || 0{32} || TempKey{32} || OpCode{1} || Mode{1} || KeyId{2} || included data{21}
+#define CRYPTOAUTH_MSG_SIZE_HMAC_OUTER      (96)   //!< (K0 ^ opad){64} || inner digest{32}
+#define CRYPTOAUTH_MSG_SIZE_KEY_SHORT       (39)   //!< Key{32} || OpCode{1} || Param1{1} || Param2{2} || SN8{1} || SN0_1{2}
+#define CRYPTOAUTH_MSG_SIZE_KEY             (96)   //!< Key{32} || OpCode{1} || Param1{1} || Param2{2} || SN8{1} || SN0_1{2} || 0{25} || Data{32}
+/** @} */
+
+//! maximum number of segments of the OTP and SN data in a MAC or HMAC message
+#define CRYPTOAUTH_INCLUDE_SEGMENTS_MAX      (6)
+
+/** \name Layouts of the Messages that cryptoauth_message() Assembles
+@{ */
+#define CRYPTOAUTH_LAYOUT_NONCE         (0)   //!< Block1 (RandOut){32} || Block2 (NumIn){20} || OpCode{1} || Param1{1} || 0{1}
+#define CRYPTOAUTH_LAYOUT_MAC           (1)   //!< Block1{32} || Block2{32} || OpCode{1} || Param1{1} || Param2{2} || included data{21}
+#define CRYPTOAUTH_LAYOUT_CHECK_MAC     (2)   //!< Block1 (password){32} || Block2 (TempKey){32} || OtherData{13} and OTP[0:7]{8} interleaved with SN
+#define CRYPTOAUTH_LAYOUT_HMAC_INNER    (3)   //!< Block1 (K0 ^ ipad){64} || 0{32} || Block2 (TempKey){32} || OpCode{1} || Param1{1} || Param2{2} || included data{21}
+#define CRYPTOAUTH_LAYOUT_HMAC_OUTER    (4)   //!< Block1 (K0 ^ opad){64} || Block2 (inner digest){32}
+#define CRYPTOAUTH_LAYOUT_KEY           (5)   //!< Block1 (key){32} || OpCode{1} || Param1{1} || Param2{2} || SN8{1} || SN0_1{2} || 0{25} || Block2 (data){32}
+/** @} */
+
+
+/** \struct cryptoauth_message_fields
+ *  \brief Fields of a message that cryptoauth_message() assembles. Fields a layout does not use are ignored.
+ *  \var cryptoauth_message_fields::layout
+ *       \brief One of the CRYPTOAUTH_LAYOUT values.
+ *  \var cryptoauth_message_fields::opcode
+ *       \brief Command opcode.
+ *  \var cryptoauth_message_fields::param1
+ *       \brief Mode, zone or random flag of the command.
+ *  \var cryptoauth_message_fields::param2
+ *       \brief Key id or address of the command.
+ *  \var cryptoauth_message_fields::block1
+ *       \brief Pointer to the first block of the message.
+ *  \var cryptoauth_message_fields::block2
+ *       \brief Pointer to the second block of the message. A key message without it ends after SN[0:1].
+ *  \var cryptoauth_message_fields::otp
+ *       \brief Pointer to OTP, can be NULL if not included by Param1. A CheckMac message hashes zeros if it is NULL.
+ *  \var cryptoauth_message_fields::sn
+ *       \brief Pointer to SN, can be NULL if not included by Param1.
+ *  \var cryptoauth_message_fields::other_data
+ *       \brief Pointer to the 13 bytes of OtherData of a CheckMac message.
+ */
+struct cryptoauth_message_fields {
+	uint8_t layout;
+	uint8_t opcode;
+	uint8_t param1;
+	uint16_t param2;
+	const uint8_t *block1;
+	const uint8_t *block2;
+	const uint8_t *otp;
+	const uint8_t *sn;
+	const uint8_t *other_data;
+};
+
+
+void cryptoauth_sha256(uint32_t len, const uint8_t *message, uint8_t *digest);
+uint8_t *cryptoauth_include_data(uint8_t mode, const uint8_t *otp, const uint8_t *sn, uint8_t *p_temp);
+uint8_t cryptoauth_message(const struct cryptoauth_message_fields *fields, uint8_t *message);
+void cryptoauth_nonce(uint8_t opcode, uint8_t mode, const uint8_t *rand_out, const uint8_t *num_in, uint8_t *digest);
+void cryptoauth_mac(uint8_t opcode, uint8_t mode, uint16_t key_id, const uint8_t *block1, const uint8_t *block2,
+		const uint8_t *otp, const uint8_t *sn, uint8_t *digest);
+void cryptoauth_check_mac(const uint8_t *password, const uint8_t *temp_key, const uint8_t *other_data,
+		const uint8_t *otp, uint8_t *digest);
+void cryptoauth_hmac_key_init(const uint8_t *key, uint32_t *inner, uint32_t *outer);
+void cryptoauth_hmac(uint8_t opcode, uint8_t mode, uint16_t key_id, const uint32_t *inner, const uint32_t *outer,
+		const uint8_t *temp_key, const uint8_t *otp, const uint8_t *sn, uint8_t *digest);
+void cryptoauth_key_digest(uint8_t opcode, uint8_t param1, uint16_t param2, const uint8_t *key,
+		const uint8_t *data, uint8_t *digest);
+void cryptoauth_key_digest_init(uint8_t opcode, uint8_t param1, uint16_t param2, const uint8_t *key, uint32_t *midstate);
+void cryptoauth_key_digest_final(const uint32_t *midstate, const uint8_t *data, uint8_t *digest);
+
+/** @} */
+
+#endif //CRYPTOAUTH_CORE_H
@@ -0,0 +1,125 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the CRC Module Shared by the SHA204 and ECC108 Libraries
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef CRYPTOAUTH_CRC_H
+#   define CRYPTOAUTH_CRC_H
+
+#include <stdint.h>                    // data type definitions
+
+
+/** \defgroup cryptoauth_crc CRC of the CryptoAuth Devices
+ *
+ * \brief
+ * This module calculates the 16-bit CRC (polynomial 0x8005) that protects the command and
+ * response packets of the ATSHA204, ATECC108 and AES132 devices. The SHA204 and ECC108 devices
+ * process the data bits LSB first, the AES132 device processes them MSB first.
+ * The Communication and Helper modules of all libraries call this one implementation.
+ *
+ * The CRC is calculated with look-up tables. Their size can be selected by defining one of
+ * the following macros. Without any of them, the engine is selected for the target:
+ * - CRYPTOAUTH_CRC_NIBBLE: 16-entry tables (64 bytes), two look-ups per byte.
+ *   Default for AVR devices with up to 8 KB of flash, like the ATtiny44 and ATtiny85.
+ * - CRYPTOAUTH_CRC_TABLE: 256-entry tables (1 KB), one look-up per byte.
+ *   Default for the other AVR devices, like the AT90USB1287.
+ * - CRYPTOAUTH_CRC_SLICE8: eight 256-entry tables per bit order (8 KB), one iteration
+ *   per eight bytes. Default for all other targets. It is not available for AVR devices.
+ *
+ * On AVR devices the tables are placed in flash.
+@{ */
+
+#if !defined(CRYPTOAUTH_CRC_NIBBLE) && !defined(CRYPTOAUTH_CRC_TABLE) && !defined(CRYPTOAUTH_CRC_SLICE8)
+#   if defined(__AVR__)
+#      include <avr/io.h>              // needed for FLASHEND
+#      if (FLASHEND <= 0x1FFF)
+#         define CRYPTOAUTH_CRC_NIBBLE
+#      else
+#         define CRYPTOAUTH_CRC_TABLE
+#      endif
+#   else
+#      define CRYPTOAUTH_CRC_SLICE8
+#   endif
+#endif
+
+#if defined(CRYPTOAUTH_CRC_SLICE8)
+#   if defined(__AVR__)
+#      error CRYPTOAUTH_CRC_SLICE8 is not available for AVR devices.
+#   endif
+#   define CRYPTOAUTH_CRC_TABLE_ROWS   (8)       //!< number of 256-entry tables per bit order
+#   define CRYPTOAUTH_CRC_ENGINE       "slicing-by-8"   //!< name of the selected engine
+#elif defined(CRYPTOAUTH_CRC_TABLE)
+#   define CRYPTOAUTH_CRC_TABLE_ROWS   (1)       //!< number of 256-entry tables per bit order
+#   define CRYPTOAUTH_CRC_ENGINE       "256-entry table"   //!< name of the selected engine
+#else
+#   define CRYPTOAUTH_CRC_ENGINE       "16-entry table"    //!< name of the selected engine
+#endif
+
+#define CRYPTOAUTH_CRC_SIZE     (2)    //!< number of bytes in a CRC
+
+//! value of cryptoauth_crc_rx::remaining before the count byte has been received
+#define CRYPTOAUTH_CRC_RX_COUNT_PENDING    ((uint8_t) 0xFF)
+
+
+/** \struct cryptoauth_crc_rx
+ *  \brief CRC of a response packet that is calculated while the packet is being received
+ *
+ * A Physical layer passes every received byte to cryptoauth_crc_rx_byte(). The count byte
+ * tells how many bytes precede the CRC, so the CRC is complete when the last byte arrives.
+ *  \var cryptoauth_crc_rx::crc_register
+ *       \brief CRC register over the bytes received so far, in the bit order of the engine.
+ *  \var cryptoauth_crc_rx::remaining
+ *       \brief Number of bytes still to be folded into the register.
+ *  \var cryptoauth_crc_rx::msb_first
+ *       \brief Non-zero for the AES132 bit order of cryptoauth_calculate_crc_msb_first().
+ */
+struct cryptoauth_crc_rx {
+	uint16_t crc_register;
+	uint8_t remaining;
+	uint8_t msb_first;
+};
+
+
+void cryptoauth_calculate_crc(uint8_t length, const uint8_t *data, uint8_t *crc);
+void cryptoauth_calculate_crc_msb_first(uint8_t length, const uint8_t *data, uint8_t *crc);
+void cryptoauth_crc_rx_init(struct cryptoauth_crc_rx *crc, uint8_t msb_first);
+void cryptoauth_crc_rx_byte(struct cryptoauth_crc_rx *crc, uint8_t data);
+void cryptoauth_crc_rx_final(const struct cryptoauth_crc_rx *crc, uint8_t *crc_bytes);
+
+/** @} */
+
+#endif //CRYPTOAUTH_CRC_H
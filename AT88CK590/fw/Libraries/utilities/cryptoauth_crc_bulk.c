@@ -0,0 +1,287 @@
+/** \file
+ *  \brief  Bulk CRC Check of CryptoAuth Packets
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <stdint.h>                    // data type definitions
+
+#include "cryptoauth_crc.h"            // definitions and declarations for the CRC module
+#include "cryptoauth_crc_bulk.h"       // header module for this C module
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+//! The PCLMULQDQ kernel is built.
+#   define CRYPTOAUTH_CRC_BULK_PCLMUL
+#   include <immintrin.h>              // SSSE3 and PCLMULQDQ intrinsics
+#elif defined(__GNUC__) && !defined(__clang__) && defined(__aarch64__) && defined(__linux__)
+//! The PMULL kernel is built.
+#   define CRYPTOAUTH_CRC_BULK_PMULL
+#   include <arm_neon.h>               // NEON and PMULL intrinsics
+#   include <sys/auxv.h>               // needed for getauxval()
+#   ifndef HWCAP_PMULL
+#      define HWCAP_PMULL           (1 << 4)
+#   endif
+#endif
+
+
+/** \name Constants of the Carry-Less Multiplication Kernels
+ *
+ * The kernels keep a 16-byte block of the packet in a 128-bit register, loaded LSB first,
+ * so that register bit i holds the coefficient of x^(127 - i). The folding constants
+ * x^n mod P are stored in the same bit order, with coefficient e at bit (63 - e).
+ * Multiplying two such operands yields the product shifted by one bit, which is why the
+ * exponents are one less than the distance they fold across.
+@{ */
+#define CRYPTOAUTH_CRC_BULK_X191    (0xCCD0000000000000ULL)    //!< x^191 mod P, folds the low half across 192 bits
+#define CRYPTOAUTH_CRC_BULK_X127    (0xC100000000000000ULL)    //!< x^127 mod P, folds the high half across 128 bits
+#define CRYPTOAUTH_CRC_BULK_X95     (0xC551000000000000ULL)    //!< x^95 mod P, folds bits 0..31 into the high half
+#define CRYPTOAUTH_CRC_BULK_X63     (0xD101000000000000ULL)    //!< x^63 mod P, folds bits 32..63 into the high half
+#define CRYPTOAUTH_CRC_BULK_MU      (0xFFFBFFE7FFAFFE1FULL)    //!< floor(x^80 / P) without its x^64 term
+#define CRYPTOAUTH_CRC_BULK_POLY    (0x8005)                   //!< P without its x^16 term
+/** @} */
+
+//! minimum number of bytes for which the carry-less multiplication kernel is used
+#define CRYPTOAUTH_CRC_BULK_BLOCK   (16)
+
+
+#if defined(CRYPTOAUTH_CRC_BULK_PCLMUL) || defined(CRYPTOAUTH_CRC_BULK_PMULL)
+/** \brief shuffle masks that shift the first block of a packet up by 0 to 15 bytes
+ *
+ * The mask for a shift of n bytes starts at index 16 - n. Out-of-range indexes produce
+ * zero bytes. Since the CRC register starts at zero, leading zeros do not change the CRC,
+ * so every packet can be processed in whole blocks.
+ */
+static const uint8_t cryptoauth_crc_bulk_shift[2 * CRYPTOAUTH_CRC_BULK_BLOCK] = {
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+#endif
+
+
+#ifdef CRYPTOAUTH_CRC_BULK_PCLMUL
+/** \brief This function calculates the packet CRC with PCLMULQDQ.
+ *
+ * The blocks are folded into one 128-bit remainder, which is folded to 64 bits. These are
+ * bit-reversed, so that the Barrett reduction yields the CRC register directly.
+ *
+ * \param[in] length number of bytes in buffer, at least CRYPTOAUTH_CRC_BULK_BLOCK
+ * \param[in] data pointer to data for which CRC should be calculated
+ * \param[out] crc pointer to 16-bit CRC, LSB first
+ */
+__attribute__((target("pclmul,ssse3")))
+static void cryptoauth_crc_bulk_calculate_pclmul(uint8_t length, const uint8_t *data, uint8_t *crc)
+{
+	const __m128i fold_128 = _mm_set_epi64x((long long) CRYPTOAUTH_CRC_BULK_X127, (long long) CRYPTOAUTH_CRC_BULK_X191);
+	const __m128i fold_64 = _mm_set_epi64x((long long) CRYPTOAUTH_CRC_BULK_X95, (long long) CRYPTOAUTH_CRC_BULK_X63);
+	const __m128i barrett = _mm_set_epi64x(CRYPTOAUTH_CRC_BULK_POLY, (long long) CRYPTOAUTH_CRC_BULK_MU);
+	const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+	const __m128i reverse_nibble = _mm_setr_epi8(0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+				0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF);
+	const __m128i reverse_high_qword = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+				-128, -128, -128, -128, -128, -128, -128, -128);
+	uint8_t shift = (uint8_t) (-length & (CRYPTOAUTH_CRC_BULK_BLOCK - 1));
+	__m128i remainder, value;
+	uint32_t crc_register;
+
+	remainder = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) data),
+				_mm_loadu_si128((const __m128i *) &cryptoauth_crc_bulk_shift[CRYPTOAUTH_CRC_BULK_BLOCK - shift]));
+	data += CRYPTOAUTH_CRC_BULK_BLOCK - shift;
+	length -= CRYPTOAUTH_CRC_BULK_BLOCK - shift;
+
+	for (; length > 0; length -= CRYPTOAUTH_CRC_BULK_BLOCK, data += CRYPTOAUTH_CRC_BULK_BLOCK)
+		remainder = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(remainder, fold_128, 0x00),
+					_mm_clmulepi64_si128(remainder, fold_128, 0x11)),
+					_mm_loadu_si128((const __m128i *) data));
+
+	// Fold the low half into the high half, 32 bits at a time.
+	value = _mm_unpacklo_epi64(_mm_and_si128(remainder, _mm_set_epi64x(0, (long long) 0xFFFFFFFF00000000ULL)),
+				_mm_slli_epi64(remainder, 32));
+	remainder = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value, fold_64, 0x00),
+				_mm_clmulepi64_si128(value, fold_64, 0x11)),
+				_mm_unpackhi_epi64(_mm_setzero_si128(), remainder));
+
+	// Reverse the 64 bits of the high half into the low half.
+	value = _mm_or_si128(_mm_shuffle_epi8(_mm_slli_epi16(reverse_nibble, 4), _mm_and_si128(remainder, nibble_mask)),
+				_mm_shuffle_epi8(reverse_nibble, _mm_and_si128(_mm_srli_epi16(remainder, 4), nibble_mask)));
+	value = _mm_shuffle_epi8(value, reverse_high_qword);
+
+	// Barrett reduction: quotient = value + floor(value * mu / x^64), CRC = quotient * P mod x^16
+	value = _mm_xor_si128(value, _mm_srli_si128(_mm_clmulepi64_si128(value, barrett, 0x00), 8));
+	crc_register = (uint32_t) _mm_cvtsi128_si32(_mm_clmulepi64_si128(value, barrett, 0x10));
+
+	crc[0] = (uint8_t) (crc_register & 0x00FF);
+	crc[1] = (uint8_t) ((crc_register >> 8) & 0x00FF);
+}
+#endif
+
+
+#ifdef CRYPTOAUTH_CRC_BULK_PMULL
+/** \brief This function calculates the packet CRC with PMULL.
+ *
+ * It is the ARMv8 counterpart of the PCLMULQDQ kernel.
+ *
+ * \param[in] length number of bytes in buffer, at least CRYPTOAUTH_CRC_BULK_BLOCK
+ * \param[in] data pointer to data for which CRC should be calculated
+ * \param[out] crc pointer to 16-bit CRC, LSB first
+ */
+__attribute__((target("+crypto")))
+static void cryptoauth_crc_bulk_calculate_pmull(uint8_t length, const uint8_t *data, uint8_t *crc)
+{
+	uint8_t shift = (uint8_t) (-length & (CRYPTOAUTH_CRC_BULK_BLOCK - 1));
+	uint8x16_t remainder;
+	uint64_t low, high, value;
+	uint32_t crc_register;
+
+	remainder = vqtbl1q_u8(vld1q_u8(data), vld1q_u8(&cryptoauth_crc_bulk_shift[CRYPTOAUTH_CRC_BULK_BLOCK - shift]));
+	data += CRYPTOAUTH_CRC_BULK_BLOCK - shift;
+	length -= CRYPTOAUTH_CRC_BULK_BLOCK - shift;
+
+	for (; length > 0; length -= CRYPTOAUTH_CRC_BULK_BLOCK, data += CRYPTOAUTH_CRC_BULK_BLOCK) {
+		low = vgetq_lane_u64(vreinterpretq_u64_u8(remainder), 0);
+		high = vgetq_lane_u64(vreinterpretq_u64_u8(remainder), 1);
+		remainder = veorq_u8(veorq_u8(vreinterpretq_u8_p128(vmull_p64((poly64_t) low, (poly64_t) CRYPTOAUTH_CRC_BULK_X191)),
+					vreinterpretq_u8_p128(vmull_p64((poly64_t) high, (poly64_t) CRYPTOAUTH_CRC_BULK_X127))),
+					vld1q_u8(data));
+	}
+
+	// Fold the low half into the high half, 32 bits at a time.
+	low = vgetq_lane_u64(vreinterpretq_u64_u8(remainder), 0);
+	high = vgetq_lane_u64(vreinterpretq_u64_u8(remainder), 1);
+	remainder = veorq_u8(vreinterpretq_u8_p128(vmull_p64((poly64_t) (low & 0xFFFFFFFF00000000ULL), (poly64_t) CRYPTOAUTH_CRC_BULK_X63)),
+				vreinterpretq_u8_p128(vmull_p64((poly64_t) (low << 32), (poly64_t) CRYPTOAUTH_CRC_BULK_X95)));
+	high ^= vgetq_lane_u64(vreinterpretq_u64_u8(remainder), 1);
+
+	// Reverse the 64 bits.
+	value = vget_lane_u64(vreinterpret_u64_u8(vrev64_u8(vrbit_u8(vcreate_u8(high)))), 0);
+
+	// Barrett reduction: quotient = value + floor(value * mu / x^64), CRC = quotient * P mod x^16
+	value ^= vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t) value, (poly64_t) CRYPTOAUTH_CRC_BULK_MU)), 1);
+	crc_register = (uint32_t) vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t) value, (poly64_t) CRYPTOAUTH_CRC_BULK_POLY)), 0);
+
+	crc[0] = (uint8_t) (crc_register & 0x00FF);
+	crc[1] = (uint8_t) ((crc_register >> 8) & 0x00FF);
+}
+#endif
+
+
+//! type of a function that calculates a packet CRC
+typedef void (*cryptoauth_crc_bulk_calculate_t)(uint8_t length, const uint8_t *data, uint8_t *crc);
+
+//! kernel selected by cryptoauth_crc_bulk_select(), NULL if none is supported
+static cryptoauth_crc_bulk_calculate_t cryptoauth_crc_bulk_kernel;
+
+
+#if defined(CRYPTOAUTH_CRC_BULK_PCLMUL) || defined(CRYPTOAUTH_CRC_BULK_PMULL)
+/** \brief This function selects the carry-less multiplication kernel if the CPU supports it.
+ *
+ * It runs as a constructor before main(), so the kernel is selected before any
+ * thread can calculate a CRC.
+ */
+__attribute__((constructor)) static void cryptoauth_crc_bulk_select(void)
+{
+#   if defined(CRYPTOAUTH_CRC_BULK_PCLMUL)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3"))
+		cryptoauth_crc_bulk_kernel = cryptoauth_crc_bulk_calculate_pclmul;
+#   else
+	if (getauxval(AT_HWCAP) & HWCAP_PMULL)
+		cryptoauth_crc_bulk_kernel = cryptoauth_crc_bulk_calculate_pmull;
+#   endif
+}
+#endif
+
+
+/** \brief This function tells whether packets are calculated with carry-less multiplication.
+ * \return 1 if the CPU supports the PCLMULQDQ or PMULL kernel, 0 otherwise
+ */
+uint8_t cryptoauth_crc_bulk_clmul(void)
+{
+	return cryptoauth_crc_bulk_kernel ? 1 : 0;
+}
+
+
+/** \brief This function calculates the packet CRC of the SHA204 and ECC108 devices.
+ *
+ * It returns the same CRC as sha204c_calculate_crc(), using the carry-less multiplication
+ * kernel if the CPU supports it.
+ *
+ * \param[in] length number of bytes in buffer
+ * \param[in] data pointer to data for which CRC should be calculated
+ * \param[out] crc pointer to 16-bit CRC, LSB first
+ */
+void cryptoauth_crc_bulk_calculate(uint8_t length, const uint8_t *data, uint8_t *crc)
+{
+	if (cryptoauth_crc_bulk_kernel && length >= CRYPTOAUTH_CRC_BULK_BLOCK) {
+		cryptoauth_crc_bulk_kernel(length, data, crc);
+		return;
+	}
+	crc[0] = crc[1] = 0;
+	cryptoauth_calculate_crc(length, data, crc);
+}
+
+
+/** \brief This function checks the CRC of many packets.
+ *
+ * The count byte of every packet gives its length, including the count byte and the CRC.
+ * A packet with a count of less than three bytes fails. sha204c_check_crc() reads outside
+ * such a packet, but also cannot succeed for it.
+ *
+ * \param[in] count number of packets
+ * \param[in] packets pointers to the packets
+ * \param[out] status status of every packet, CRYPTOAUTH_CRC_BULK_SUCCESS or CRYPTOAUTH_CRC_BULK_BAD_CRC
+ * \return number of packets that failed
+ */
+uint32_t cryptoauth_crc_bulk_check(uint32_t count, const uint8_t *const *packets, uint8_t *status)
+{
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE];
+	uint8_t length;
+	uint32_t failed = 0;
+	uint32_t i;
+
+	for (i = 0; i < count; i++) {
+		length = packets[i][0];
+		status[i] = CRYPTOAUTH_CRC_BULK_BAD_CRC;
+		if (length > CRYPTOAUTH_CRC_SIZE) {
+			length -= CRYPTOAUTH_CRC_SIZE;
+			cryptoauth_crc_bulk_calculate(length, packets[i], crc);
+			if (crc[0] == packets[i][length] && crc[1] == packets[i][length + 1])
+				status[i] = CRYPTOAUTH_CRC_BULK_SUCCESS;
+		}
+		if (status[i] != CRYPTOAUTH_CRC_BULK_SUCCESS)
+			failed++;
+	}
+	return failed;
+}
@@ -0,0 +1,70 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Bulk CRC Check of CryptoAuth Packets
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef CRYPTOAUTH_CRC_BULK_H
+#   define CRYPTOAUTH_CRC_BULK_H
+
+#include <stdint.h>                    // data type definitions
+
+
+/** \defgroup cryptoauth_crc_bulk Bulk CRC Check of CryptoAuth Packets
+ *
+ * \brief
+ * This module checks the CRC of many SHA204 or ECC108 packets in one call, for instance
+ * to validate logged kit transactions and bus captures on a host. Every packet starts with
+ * its count byte and ends with its two CRC bytes, and the status of every packet is the one
+ * sha204c_check_crc() and ecc108c_check_crc() return for it.
+ *
+ * On x86 hosts that support PCLMULQDQ, and on ARMv8 Linux hosts that support PMULL, packets
+ * of 16 bytes or more are folded with carry-less multiplication and reduced with a Barrett
+ * reduction. The instruction set is detected at run-time. Shorter packets, and all packets
+ * on other targets, are calculated by the CRC module.
+@{ */
+
+#define CRYPTOAUTH_CRC_BULK_SUCCESS     ((uint8_t) 0x00)    //!< CRC matches, same value as SHA204_SUCCESS
+#define CRYPTOAUTH_CRC_BULK_BAD_CRC     ((uint8_t) 0xE5)    //!< CRC does not match, same value as SHA204_BAD_CRC
+
+
+uint8_t cryptoauth_crc_bulk_clmul(void);
+void cryptoauth_crc_bulk_calculate(uint8_t length, const uint8_t *data, uint8_t *crc);
+uint32_t cryptoauth_crc_bulk_check(uint32_t count, const uint8_t *const *packets, uint8_t *status);
+
+/** @} */
+
+#endif //CRYPTOAUTH_CRC_BULK_H
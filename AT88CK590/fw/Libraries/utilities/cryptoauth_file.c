@@ -0,0 +1,126 @@
+/** \file
+ *  \brief  Functions for Writing Mapped Host Files
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdlib.h>                    // needed for malloc()
+#include <stdio.h>                     // needed for rename()
+#include <fcntl.h>                     // needed for open()
+#include <unistd.h>                    // needed for ftruncate()
+#include <sys/mman.h>                  // needed for mmap()
+
+#include "cryptoauth_file.h"           // header module for this C module
+#include "cryptoauth_wipe.h"           // definitions and declarations for the Wipe module
+
+
+/** \brief This function creates and maps the temporary file of a new file.
+ *
+ * The mapping is filled with zeros. An existing temporary file of that name is overwritten.
+ *
+ * \param[in] file_name name of the final file, must stay valid until cryptoauth_file_commit()
+ * \param[in] size size of the file
+ * \param[out] file pointer to the file, its mapping is in cryptoauth_file::map
+ * \return status of the operation
+ */
+uint8_t cryptoauth_file_create(const char *file_name, size_t size, struct cryptoauth_file *file)
+{
+	size_t name_size = strlen(file_name);
+	int fd;
+
+	file->map = NULL;
+	file->size = size;
+	file->file_name = file_name;
+	file->temp_name = malloc(name_size + sizeof(".tmp"));
+	if (!file->temp_name)
+		return CRYPTOAUTH_FILE_FUNC_FAIL;
+	memcpy(file->temp_name, file_name, name_size);
+	memcpy(&file->temp_name[name_size], ".tmp", sizeof(".tmp"));
+
+	fd = open(file->temp_name, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if (fd < 0) {
+		free(file->temp_name);
+		return CRYPTOAUTH_FILE_FUNC_FAIL;
+	}
+	if (ftruncate(fd, (off_t) size)) {
+		close(fd);
+		unlink(file->temp_name);
+		free(file->temp_name);
+		return CRYPTOAUTH_FILE_FUNC_FAIL;
+	}
+	file->map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (file->map == MAP_FAILED) {
+		file->map = NULL;
+		unlink(file->temp_name);
+		free(file->temp_name);
+		return CRYPTOAUTH_FILE_FUNC_FAIL;
+	}
+
+	return CRYPTOAUTH_FILE_SUCCESS;
+}
+
+
+/** \brief This function finishes a file that cryptoauth_file_create() created.
+ *
+ * If status is success, the mapping is synchronized and the temporary file
+ * replaces the final file. Otherwise the mapping is wiped and the temporary
+ * file is removed. The mapping is released in both cases.
+ *
+ * \param[in] file pointer to the file
+ * \param[in] status status of the build, CRYPTOAUTH_FILE_SUCCESS if the file is complete
+ * \return status, or CRYPTOAUTH_FILE_FUNC_FAIL if a complete file could not be written
+ */
+uint8_t cryptoauth_file_commit(struct cryptoauth_file *file, uint8_t status)
+{
+	if ((status == CRYPTOAUTH_FILE_SUCCESS) && msync(file->map, file->size, MS_SYNC))
+		status = CRYPTOAUTH_FILE_FUNC_FAIL;
+
+	if (status != CRYPTOAUTH_FILE_SUCCESS)
+		cryptoauth_wipe(file->map, file->size);
+	munmap(file->map, file->size);
+	file->map = NULL;
+
+	if ((status == CRYPTOAUTH_FILE_SUCCESS) && rename(file->temp_name, file->file_name))
+		status = CRYPTOAUTH_FILE_FUNC_FAIL;
+	if (status != CRYPTOAUTH_FILE_SUCCESS)
+		unlink(file->temp_name);
+	free(file->temp_name);
+	file->temp_name = NULL;
+
+	return status;
+}
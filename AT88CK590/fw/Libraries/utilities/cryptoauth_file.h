@@ -0,0 +1,89 @@
+/** \file
+ *  \brief  Definitions and Prototypes for Writing Mapped Host Files
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef CRYPTOAUTH_FILE_H
+#   define CRYPTOAUTH_FILE_H
+
+#include <stdint.h>                    // data type definitions
+#include <stddef.h>                    // needed for size_t
+
+
+/** \defgroup cryptoauth_file Writing Mapped Host Files
+ *
+ * \brief
+ * The lot files, chain index files and response table files that the host
+ * modules of the SHA204 library build are written through a shared mapping
+ * of a temporary file named after the final file with ".tmp" appended. The
+ * caller fills the mapping and writes the file header last. The temporary
+ * file is then synchronized and renamed over the final file, so readers that
+ * still have the old file mapped keep a valid mapping, and a failed build
+ * leaves the old file in place.
+ *
+ * This module needs a POSIX host.
+@{ */
+
+#define CRYPTOAUTH_FILE_SUCCESS      ((uint8_t) 0x00)    //!< same value as SHA204_SUCCESS
+#define CRYPTOAUTH_FILE_FUNC_FAIL    ((uint8_t) 0xE0)    //!< file could not be written, same value as SHA204_FUNC_FAIL
+
+
+/** \struct cryptoauth_file
+ *  \brief A file that is being written.
+ *  \var cryptoauth_file::map
+ *       \brief Writable mapping of the temporary file.
+ *  \var cryptoauth_file::size
+ *       \brief Size of the file.
+ *  \var cryptoauth_file::file_name
+ *       \brief Name of the final file.
+ *  \var cryptoauth_file::temp_name
+ *       \brief Name of the temporary file.
+ */
+struct cryptoauth_file {
+	void *map;
+	size_t size;
+	const char *file_name;
+	char *temp_name;
+};
+
+
+uint8_t cryptoauth_file_create(const char *file_name, size_t size, struct cryptoauth_file *file);
+uint8_t cryptoauth_file_commit(struct cryptoauth_file *file, uint8_t status);
+
+/** @} */
+
+#endif //CRYPTOAUTH_FILE_H
@@ -0,0 +1,100 @@
+/** \file
+ *  \brief  Bus Fault Injector of the Virtual Devices
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memset()
+#include "fault_injection.h"           // definitions and declarations for the Fault Injection module
+
+
+/** \ingroup fault_injection
+@{ */
+
+/** \brief This function initializes a fault injector with all rates set to 0.
+ * \param[out] injector pointer to injector
+ * \param[in] seed seed of the random generator
+ */
+void fault_init(struct fault_injector *injector, uint32_t seed)
+{
+	uint8_t i;
+
+	memset(injector, 0, sizeof(*injector));
+
+	// Spread the bits of small seeds, and skip the first numbers, which still depend on them.
+	injector->state = (seed * 0x9E3779B9) | 1;
+	for (i = 0; i < 16; i++)
+		(void) fault_random(injector);
+}
+
+
+/** \brief This function returns the next number of the random generator (xorshift32).
+ * \param[in, out] injector pointer to injector
+ * \return random number
+ */
+uint32_t fault_random(struct fault_injector *injector)
+{
+	uint32_t x = injector->state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	injector->state = x;
+
+	return x;
+}
+
+
+/** \brief This function decides whether a fault is injected at an opportunity.
+ * \param[in, out] injector pointer to injector, NULL injects no faults
+ * \param[in] type fault type (#fault_type)
+ * \return 1 if the fault is injected, 0 otherwise
+ */
+uint8_t fault_inject(struct fault_injector *injector, uint8_t type)
+{
+	if (!injector || (type >= FAULT_TYPE_COUNT))
+		return 0;
+
+	injector->opportunities[type]++;
+	if (!injector->rate[type] || (fault_random(injector) % FAULT_RATE_SCALE >= injector->rate[type]))
+		return 0;
+
+	injector->injected[type]++;
+
+	return 1;
+}
+
+/** @} */
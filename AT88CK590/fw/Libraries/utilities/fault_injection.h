@@ -0,0 +1,96 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Bus Fault Injector of the Virtual Devices
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef FAULT_INJECTION_H
+#   define FAULT_INJECTION_H
+
+#include <stdint.h>                    // data type definitions
+
+
+/** \defgroup fault_injection Bus Fault Injector of the Virtual Devices
+ *
+ * \brief
+ * This module decides when the physical layer of a virtual device corrupts a transfer,
+ * so that the retry and resynchronization paths of the Communication layers can be
+ * exercised and timed on a host. A virtual device asks fault_inject() at every
+ * opportunity for a fault type, and the injector answers with the configured rate
+ * from a deterministic generator, so that runs can be reproduced. What a fault does
+ * on the bus is up to the virtual device.
+@{ */
+
+//! rates are given in parts of this value, which stands for every opportunity
+#define FAULT_RATE_SCALE               ((uint16_t) 10000)
+
+
+//! fault types
+enum fault_type {
+	FAULT_CRC,        //!< a bit of a CRC byte of a response flips
+	FAULT_ACK,        //!< the device does not acknowledge a transfer
+	FAULT_COUNT,      //!< the count byte of a response arrives truncated
+	FAULT_SYNC,       //!< the device loses synchronization and sends 0xFF until resynchronized
+	FAULT_TYPE_COUNT  //!< number of fault types
+};
+
+
+/** \struct fault_injector
+ *  \brief State of a fault injector.
+ *  \var fault_injector::rate
+ *       \brief Rate per fault type, in parts of #FAULT_RATE_SCALE.
+ *  \var fault_injector::state
+ *       \brief State of the random generator.
+ *  \var fault_injector::opportunities
+ *       \brief Number of opportunities per fault type.
+ *  \var fault_injector::injected
+ *       \brief Number of injected faults per fault type.
+ */
+struct fault_injector {
+	uint16_t rate[FAULT_TYPE_COUNT];
+	uint32_t state;
+	uint32_t opportunities[FAULT_TYPE_COUNT];
+	uint32_t injected[FAULT_TYPE_COUNT];
+};
+
+
+void fault_init(struct fault_injector *injector, uint32_t seed);
+uint8_t fault_inject(struct fault_injector *injector, uint8_t type);
+uint32_t fault_random(struct fault_injector *injector);
+
+/** @} */
+
+#endif //FAULT_INJECTION_H
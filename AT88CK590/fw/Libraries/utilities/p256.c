@@ -0,0 +1,1116 @@
+/** \file
+ *  \brief  P-256 Signature Verification with Fixed-Base Comb Tables
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdint.h>                    // data type definitions
+
+#include "p256.h"                      // header module for this C module
+
+
+//! unsigned 128-bit integer for the limb products
+typedef unsigned __int128 p256_uint128_t;
+
+//! number of signatures whose inversions p256_verify_batch() shares
+#define P256_BATCH_SIZE             (64)
+
+//! window width of the w-NAF multiplication with public keys without comb table
+#define P256_WNAF_WIDTH              (5)
+
+
+/** \brief Constants of a modulus for Montgomery arithmetic
+ *
+ *  All values are 256-bit integers, least significant limb first.
+ */
+struct p256_modulus {
+	uint64_t m[4];             //!< the modulus
+	uint64_t m0inv;            //!< -m^-1 mod 2^64
+	uint64_t r2[4];            //!< 2^512 mod m, converts into Montgomery form
+	uint64_t one[4];           //!< 2^256 mod m, 1 in Montgomery form
+	uint64_t m_minus_2[4];     //!< m - 2, the exponent of the inversion
+};
+
+
+//! field prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1
+static const struct p256_modulus p256_p = {
+	{0xFFFFFFFFFFFFFFFFULL, 0x00000000FFFFFFFFULL, 0x0000000000000000ULL, 0xFFFFFFFF00000001ULL},
+	0x0000000000000001ULL,
+	{0x0000000000000003ULL, 0xFFFFFFFBFFFFFFFFULL, 0xFFFFFFFFFFFFFFFEULL, 0x00000004FFFFFFFDULL},
+	{0x0000000000000001ULL, 0xFFFFFFFF00000000ULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000000FFFFFFFEULL},
+	{0xFFFFFFFFFFFFFFFDULL, 0x00000000FFFFFFFFULL, 0x0000000000000000ULL, 0xFFFFFFFF00000001ULL}
+};
+
+//! group order n
+static const struct p256_modulus p256_n = {
+	{0xF3B9CAC2FC632551ULL, 0xBCE6FAADA7179E84ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFF00000000ULL},
+	0xCCD1C8AAEE00BC4FULL,
+	{0x83244C95BE79EEA2ULL, 0x4699799C49BD6FA6ULL, 0x2845B2392B6BEC59ULL, 0x66E12D94F3D95620ULL},
+	{0x0C46353D039CDAAFULL, 0x4319055258E8617BULL, 0x0000000000000000ULL, 0x00000000FFFFFFFFULL},
+	{0xF3B9CAC2FC63254FULL, 0xBCE6FAADA7179E84ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFF00000000ULL}
+};
+
+//! curve coefficient b in Montgomery form (a = -3)
+static const uint64_t p256_b[4] = {
+	0xD89CDF6229C4BDDFULL, 0xACF005CD78843090ULL, 0xE5A220ABF7212ED6ULL, 0xDC30061D04874834ULL
+};
+
+//! base point G in Montgomery form
+static const struct p256_affine p256_g = {
+	{0x79E730D418A9143CULL, 0x75BA95FC5FEDB601ULL, 0x79FB732B77622510ULL, 0x18905F76A53755C6ULL},
+	{0xDDF25357CE95560AULL, 0x8B4AB8E4BA19E45CULL, 0xD2E88688DD21F325ULL, 0x8571FF1825885D85ULL}
+};
+
+
+/** \brief Point in Jacobian coordinates (X / Z^2, Y / Z^3) in Montgomery form. Z = 0 is the point at infinity.
+ */
+struct p256_point {
+	uint64_t x[4];
+	uint64_t y[4];
+	uint64_t z[4];
+};
+
+
+/** \name Multi-Precision Integers
+@{ */
+
+/** \brief This function converts a 32-byte big-endian number into limbs.
+ * \param[out] r pointer to result
+ * \param[in] bytes pointer to 32 bytes, most significant byte first
+ */
+static void p256_from_bytes(uint64_t *r, const uint8_t *bytes)
+{
+	uint8_t i, j;
+
+	for (i = 0; i < 4; i++) {
+		r[3 - i] = 0;
+		for (j = 0; j < 8; j++)
+			r[3 - i] = (r[3 - i] << 8) | bytes[i * 8 + j];
+	}
+}
+
+
+/** \brief This function converts limbs into a 32-byte big-endian number.
+ * \param[out] bytes pointer to 32 bytes, most significant byte first
+ * \param[in] a pointer to number
+ */
+static void p256_to_bytes(uint8_t *bytes, const uint64_t *a)
+{
+	uint8_t i, j;
+
+	for (i = 0; i < 4; i++)
+		for (j = 0; j < 8; j++)
+			bytes[i * 8 + j] = (uint8_t) (a[3 - i] >> (56 - 8 * j));
+}
+
+
+/** \brief This function checks whether a number is zero.
+ * \param[in] a pointer to number
+ * \return 1 if a = 0, otherwise 0
+ */
+static uint8_t p256_is_zero(const uint64_t *a)
+{
+	return (a[0] | a[1] | a[2] | a[3]) == 0;
+}
+
+
+/** \brief This function compares two numbers.
+ * \param[in] a pointer to first number
+ * \param[in] b pointer to second number
+ * \return 1 if a < b, otherwise 0
+ */
+static uint8_t p256_less(const uint64_t *a, const uint64_t *b)
+{
+	int8_t i;
+
+	for (i = 3; i >= 0; i--) {
+		if (a[i] != b[i])
+			return a[i] < b[i];
+	}
+
+	return 0;
+}
+
+
+/** \brief This function adds two numbers.
+ * \param[out] r pointer to result, can be equal to a or b
+ * \param[in] a pointer to first number
+ * \param[in] b pointer to second number
+ * \return carry
+ */
+static uint64_t p256_add(uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+	p256_uint128_t sum = 0;
+	uint8_t i;
+
+	for (i = 0; i < 4; i++) {
+		sum += (p256_uint128_t) a[i] + b[i];
+		r[i] = (uint64_t) sum;
+		sum >>= 64;
+	}
+
+	return (uint64_t) sum;
+}
+
+
+/** \brief This function subtracts two numbers.
+ * \param[out] r pointer to result, can be equal to a or b
+ * \param[in] a pointer to minuend
+ * \param[in] b pointer to subtrahend
+ * \return borrow
+ */
+static uint64_t p256_sub(uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+	p256_uint128_t diff;
+	uint64_t borrow = 0;
+	uint8_t i;
+
+	for (i = 0; i < 4; i++) {
+		diff = (p256_uint128_t) a[i] - b[i] - borrow;
+		r[i] = (uint64_t) diff;
+		borrow = (uint64_t) (diff >> 64) & 1;
+	}
+
+	return borrow;
+}
+
+/** @} */
+
+
+/** \name Modular Arithmetic
+ *
+ * Operands and results are reduced (less than the modulus). Products are
+ * Montgomery products a * b / 2^256 mod m.
+@{ */
+
+/** \brief This function adds modulo m.
+ * \param[out] r pointer to result
+ * \param[in] a pointer to first summand
+ * \param[in] b pointer to second summand
+ * \param[in] m pointer to modulus
+ */
+static void p256_mod_add(uint64_t *r, const uint64_t *a, const uint64_t *b, const struct p256_modulus *m)
+{
+	if (p256_add(r, a, b) || !p256_less(r, m->m))
+		p256_sub(r, r, m->m);
+}
+
+
+/** \brief This function subtracts modulo m.
+ * \param[out] r pointer to result
+ * \param[in] a pointer to minuend
+ * \param[in] b pointer to subtrahend
+ * \param[in] m pointer to modulus
+ */
+static void p256_mod_sub(uint64_t *r, const uint64_t *a, const uint64_t *b, const struct p256_modulus *m)
+{
+	if (p256_sub(r, a, b))
+		p256_add(r, r, m->m);
+}
+
+
+/** \brief This function multiplies in Montgomery form (coarsely integrated operand scanning).
+ * \param[out] r pointer to result, can be equal to a or b
+ * \param[in] a pointer to first factor
+ * \param[in] b pointer to second factor
+ * \param[in] m pointer to modulus
+ */
+static void p256_mod_mul(uint64_t *r, const uint64_t *a, const uint64_t *b, const struct p256_modulus *m)
+{
+	uint64_t t[6] = {0, 0, 0, 0, 0, 0};
+	p256_uint128_t product;
+	uint64_t carry, q;
+	uint8_t i, j;
+
+	for (i = 0; i < 4; i++) {
+		// t += a * b[i]
+		carry = 0;
+		for (j = 0; j < 4; j++) {
+			product = (p256_uint128_t) a[j] * b[i] + t[j] + carry;
+			t[j] = (uint64_t) product;
+			carry = (uint64_t) (product >> 64);
+		}
+		product = (p256_uint128_t) t[4] + carry;
+		t[4] = (uint64_t) product;
+		t[5] = (uint64_t) (product >> 64);
+
+		// t = (t + q * m) / 2^64
+		q = t[0] * m->m0inv;
+		product = (p256_uint128_t) q * m->m[0] + t[0];
+		carry = (uint64_t) (product >> 64);
+		for (j = 1; j < 4; j++) {
+			product = (p256_uint128_t) q * m->m[j] + t[j] + carry;
+			t[j - 1] = (uint64_t) product;
+			carry = (uint64_t) (product >> 64);
+		}
+		product = (p256_uint128_t) t[4] + carry;
+		t[3] = (uint64_t) product;
+		t[4] = t[5] + (uint64_t) (product >> 64);
+	}
+
+	if (t[4] || !p256_less(t, m->m))
+		p256_sub(t, t, m->m);
+	memcpy(r, t, 4 * sizeof(uint64_t));
+}
+
+
+/** \brief This function converts a number into Montgomery form.
+ * \param[out] r pointer to result
+ * \param[in] a pointer to number, less than m
+ * \param[in] m pointer to modulus
+ */
+static void p256_to_mont(uint64_t *r, const uint64_t *a, const struct p256_modulus *m)
+{
+	p256_mod_mul(r, a, m->r2, m);
+}
+
+
+/** \brief This function inverts in Montgomery form by raising to the power of m - 2 (m is prime).
+ * \param[out] r pointer to result, can be equal to a
+ * \param[in] a pointer to number, not zero
+ * \param[in] m pointer to modulus
+ */
+static void p256_mod_inv(uint64_t *r, const uint64_t *a, const struct p256_modulus *m)
+{
+	uint64_t base[4], result[4];
+	int16_t i;
+
+	memcpy(base, a, sizeof(base));
+	memcpy(result, m->one, sizeof(result));
+	for (i = 255; i >= 0; i--) {
+		p256_mod_mul(result, result, result, m);
+		if ((m->m_minus_2[i >> 6] >> (i & 63)) & 1)
+			p256_mod_mul(result, result, base, m);
+	}
+	memcpy(r, result, sizeof(result));
+}
+
+
+/** \brief This function inverts many numbers with one inversion (Montgomery's trick).
+ *
+ * It replaces a[i] by 1 / a[i], at the cost of one inversion and 3 * (count - 1) multiplications.
+ *
+ * \param[in] count number of numbers
+ * \param[in, out] a array of numbers in Montgomery form, none of them zero
+ * \param[out] scratch array of count numbers for the partial products
+ * \param[in] m pointer to modulus
+ */
+static void p256_mod_inv_batch(uint32_t count, uint64_t (*a)[4], uint64_t (*scratch)[4], const struct p256_modulus *m)
+{
+	uint64_t inverse[4], t[4];
+	uint32_t i;
+
+	if (!count)
+		return;
+
+	// scratch[i] = a[0] * ... * a[i]
+	memcpy(scratch[0], a[0], sizeof(scratch[0]));
+	for (i = 1; i < count; i++)
+		p256_mod_mul(scratch[i], scratch[i - 1], a[i], m);
+
+	p256_mod_inv(inverse, scratch[count - 1], m);
+
+	// Peel off one factor at a time: 1 / a[i] = (1 / (a[0] * ... * a[i])) * (a[0] * ... * a[i - 1])
+	for (i = count - 1; i > 0; i--) {
+		p256_mod_mul(t, inverse, scratch[i - 1], m);
+		p256_mod_mul(inverse, inverse, a[i], m);
+		memcpy(a[i], t, sizeof(t));
+	}
+	memcpy(a[0], inverse, sizeof(inverse));
+}
+
+/** @} */
+
+
+/** \name Point Arithmetic (a = -3)
+@{ */
+
+/** \brief This function doubles a point (dbl-2001-b).
+ * \param[out] r pointer to result, can be equal to p
+ * \param[in] p pointer to point
+ */
+static void p256_point_double(struct p256_point *r, const struct p256_point *p)
+{
+	uint64_t delta[4], gamma[4], beta[4], alpha[4], t[4], u[4];
+
+	p256_mod_mul(delta, p->z, p->z, &p256_p);
+	p256_mod_mul(gamma, p->y, p->y, &p256_p);
+	p256_mod_mul(beta, p->x, gamma, &p256_p);
+
+	// alpha = 3 * (X - delta) * (X + delta)
+	p256_mod_sub(t, p->x, delta, &p256_p);
+	p256_mod_add(u, p->x, delta, &p256_p);
+	p256_mod_mul(alpha, t, u, &p256_p);
+	p256_mod_add(t, alpha, alpha, &p256_p);
+	p256_mod_add(alpha, t, alpha, &p256_p);
+
+	// Z3 = (Y + Z)^2 - gamma - delta
+	p256_mod_add(t, p->y, p->z, &p256_p);
+	p256_mod_mul(t, t, t, &p256_p);
+	p256_mod_sub(t, t, gamma, &p256_p);
+	p256_mod_sub(r->z, t, delta, &p256_p);
+
+	// X3 = alpha^2 - 8 * beta
+	p256_mod_add(beta, beta, beta, &p256_p);
+	p256_mod_add(beta, beta, beta, &p256_p);
+	p256_mod_add(t, beta, beta, &p256_p);
+	p256_mod_mul(u, alpha, alpha, &p256_p);
+	p256_mod_sub(r->x, u, t, &p256_p);
+
+	// Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+	p256_mod_sub(t, beta, r->x, &p256_p);
+	p256_mod_mul(t, alpha, t, &p256_p);
+	p256_mod_mul(gamma, gamma, gamma, &p256_p);
+	p256_mod_add(gamma, gamma, gamma, &p256_p);
+	p256_mod_add(gamma, gamma, gamma, &p256_p);
+	p256_mod_add(gamma, gamma, gamma, &p256_p);
+	p256_mod_sub(r->y, t, gamma, &p256_p);
+}
+
+
+/** \brief This function adds a point in affine coordinates to a point in Jacobian coordinates (madd-2007-bl).
+ * \param[out] r pointer to result, can be equal to p
+ * \param[in] p pointer to point in Jacobian coordinates
+ * \param[in] q pointer to point in affine coordinates
+ */
+static void p256_point_add_affine(struct p256_point *r, const struct p256_point *p, const struct p256_affine *q)
+{
+	uint64_t z1z1[4], u2[4], s2[4], h[4], hh[4], i[4], j[4], rr[4], v[4], t[4];
+
+	if (p256_is_zero(p->z)) {
+		memcpy(r->x, q->x, sizeof(r->x));
+		memcpy(r->y, q->y, sizeof(r->y));
+		memcpy(r->z, p256_p.one, sizeof(r->z));
+		return;
+	}
+
+	p256_mod_mul(z1z1, p->z, p->z, &p256_p);
+	p256_mod_mul(u2, q->x, z1z1, &p256_p);
+	p256_mod_mul(s2, q->y, p->z, &p256_p);
+	p256_mod_mul(s2, s2, z1z1, &p256_p);
+	p256_mod_sub(h, u2, p->x, &p256_p);
+	p256_mod_sub(rr, s2, p->y, &p256_p);
+
+	if (p256_is_zero(h)) {
+		if (p256_is_zero(rr))
+			p256_point_double(r, p);
+		else
+			memset(r, 0, sizeof(*r));
+		return;
+	}
+
+	p256_mod_add(rr, rr, rr, &p256_p);
+	p256_mod_mul(hh, h, h, &p256_p);
+	p256_mod_add(i, hh, hh, &p256_p);
+	p256_mod_add(i, i, i, &p256_p);
+	p256_mod_mul(j, h, i, &p256_p);
+	p256_mod_mul(v, p->x, i, &p256_p);
+
+	// Z3 = (Z1 + H)^2 - Z1Z1 - HH
+	p256_mod_add(t, p->z, h, &p256_p);
+	p256_mod_mul(t, t, t, &p256_p);
+	p256_mod_sub(t, t, z1z1, &p256_p);
+	p256_mod_sub(r->z, t, hh, &p256_p);
+
+	// Y1 * J is needed before Y1 can be overwritten.
+	p256_mod_mul(j, j, p->y, &p256_p);
+	p256_mod_mul(hh, h, i, &p256_p);
+
+	// X3 = r^2 - J - 2 * V
+	p256_mod_mul(t, rr, rr, &p256_p);
+	p256_mod_sub(t, t, hh, &p256_p);
+	p256_mod_sub(t, t, v, &p256_p);
+	p256_mod_sub(r->x, t, v, &p256_p);
+
+	// Y3 = r * (V - X3) - 2 * Y1 * J
+	p256_mod_sub(t, v, r->x, &p256_p);
+	p256_mod_mul(t, rr, t, &p256_p);
+	p256_mod_add(j, j, j, &p256_p);
+	p256_mod_sub(r->y, t, j, &p256_p);
+}
+
+
+/** \brief This function adds two points in Jacobian coordinates (add-2007-bl).
+ * \param[out] r pointer to result, can be equal to p or q
+ * \param[in] p pointer to first point
+ * \param[in] q pointer to second point
+ */
+static void p256_point_add(struct p256_point *r, const struct p256_point *p, const struct p256_point *q)
+{
+	uint64_t z1z1[4], z2z2[4], u1[4], u2[4], s1[4], s2[4], h[4], i[4], j[4], rr[4], v[4], t[4];
+
+	if (p256_is_zero(p->z)) {
+		memmove(r, q, sizeof(*r));
+		return;
+	}
+	if (p256_is_zero(q->z)) {
+		memmove(r, p, sizeof(*r));
+		return;
+	}
+
+	p256_mod_mul(z1z1, p->z, p->z, &p256_p);
+	p256_mod_mul(z2z2, q->z, q->z, &p256_p);
+	p256_mod_mul(u1, p->x, z2z2, &p256_p);
+	p256_mod_mul(u2, q->x, z1z1, &p256_p);
+	p256_mod_mul(s1, p->y, q->z, &p256_p);
+	p256_mod_mul(s1, s1, z2z2, &p256_p);
+	p256_mod_mul(s2, q->y, p->z, &p256_p);
+	p256_mod_mul(s2, s2, z1z1, &p256_p);
+	p256_mod_sub(h, u2, u1, &p256_p);
+	p256_mod_sub(rr, s2, s1, &p256_p);
+
+	if (p256_is_zero(h)) {
+		if (p256_is_zero(rr))
+			p256_point_double(r, p);
+		else
+			memset(r, 0, sizeof(*r));
+		return;
+	}
+
+	p256_mod_add(rr, rr, rr, &p256_p);
+	p256_mod_add(i, h, h, &p256_p);
+	p256_mod_mul(i, i, i, &p256_p);
+	p256_mod_mul(j, h, i, &p256_p);
+	p256_mod_mul(v, u1, i, &p256_p);
+
+	// Z3 = ((Z1 + Z2)^2 - Z1Z1 - Z2Z2) * H
+	p256_mod_add(t, p->z, q->z, &p256_p);
+	p256_mod_mul(t, t, t, &p256_p);
+	p256_mod_sub(t, t, z1z1, &p256_p);
+	p256_mod_sub(t, t, z2z2, &p256_p);
+	p256_mod_mul(r->z, t, h, &p256_p);
+
+	// X3 = r^2 - J - 2 * V
+	p256_mod_mul(t, rr, rr, &p256_p);
+	p256_mod_sub(t, t, j, &p256_p);
+	p256_mod_sub(t, t, v, &p256_p);
+	p256_mod_sub(r->x, t, v, &p256_p);
+
+	// Y3 = r * (V - X3) - 2 * S1 * J
+	p256_mod_sub(t, v, r->x, &p256_p);
+	p256_mod_mul(t, rr, t, &p256_p);
+	p256_mod_mul(s1, s1, j, &p256_p);
+	p256_mod_add(s1, s1, s1, &p256_p);
+	p256_mod_sub(r->y, t, s1, &p256_p);
+}
+
+
+/** \brief This function converts points into affine coordinates with one shared inversion.
+ * \param[in] count number of points (1 to 256)
+ * \param[in] points array of points, none of them the point at infinity
+ * \param[out] affine array of count points in affine coordinates
+ */
+static void p256_normalize(uint32_t count, const struct p256_point *points, struct p256_affine *affine)
+{
+	uint64_t z_inv[256][4], scratch[256][4], zz[4];
+	uint32_t i;
+
+	for (i = 0; i < count; i++)
+		memcpy(z_inv[i], points[i].z, sizeof(z_inv[i]));
+	p256_mod_inv_batch(count, z_inv, scratch, &p256_p);
+
+	for (i = 0; i < count; i++) {
+		p256_mod_mul(zz, z_inv[i], z_inv[i], &p256_p);
+		p256_mod_mul(affine[i].x, points[i].x, zz, &p256_p);
+		p256_mod_mul(zz, zz, z_inv[i], &p256_p);
+		p256_mod_mul(affine[i].y, points[i].y, zz, &p256_p);
+	}
+}
+
+
+/** \brief This function checks whether a point in affine coordinates is on the curve y^2 = x^3 - 3x + b.
+ * \param[in] p pointer to point
+ * \return 1 if the point is on the curve, otherwise 0
+ */
+static uint8_t p256_on_curve(const struct p256_affine *p)
+{
+	uint64_t left[4], right[4], t[4];
+
+	p256_mod_mul(left, p->y, p->y, &p256_p);
+
+	p256_mod_mul(right, p->x, p->x, &p256_p);
+	p256_mod_mul(right, right, p->x, &p256_p);
+	p256_mod_add(t, p->x, p->x, &p256_p);
+	p256_mod_add(t, t, p->x, &p256_p);
+	p256_mod_sub(right, right, t, &p256_p);
+	p256_mod_add(right, right, p256_b, &p256_p);
+
+	return memcmp(left, right, sizeof(left)) == 0;
+}
+
+
+/** \brief This function decodes a public key and checks that it is on the curve.
+ * \param[out] q pointer to point in affine coordinates
+ * \param[in] public_key pointer to 64-byte public key
+ * \return P256_SUCCESS or P256_BAD_PARAM
+ */
+static uint8_t p256_decode_key(struct p256_affine *q, const uint8_t *public_key)
+{
+	uint64_t x[4], y[4];
+
+	p256_from_bytes(x, public_key);
+	p256_from_bytes(y, public_key + P256_INT_SIZE);
+	if (!p256_less(x, p256_p.m) || !p256_less(y, p256_p.m))
+		return P256_BAD_PARAM;
+
+	p256_to_mont(q->x, x, &p256_p);
+	p256_to_mont(q->y, y, &p256_p);
+
+	return p256_on_curve(q) ? P256_SUCCESS : P256_BAD_PARAM;
+}
+
+/** @} */
+
+
+/** \name Scalar Multiplication
+@{ */
+
+/** \brief This function builds the comb table of a point.
+ *
+ * The base points 2^(32i) * P are combined into the 255 entries of the first comb.
+ * Every further comb holds the entries of the previous one multiplied by 2^8.
+ * Every comb is converted to affine coordinates with one shared inversion.
+ *
+ * \param[out] comb pointer to comb table
+ * \param[in] p pointer to point
+ */
+static void p256_comb_build(struct p256_comb *comb, const struct p256_affine *p)
+{
+	struct p256_point points[1 << P256_COMB_TEETH];
+	struct p256_affine base[P256_COMB_TEETH];
+	uint16_t b, top;
+	uint8_t c, i, k;
+
+	// base[i] = 2^(32i) * P
+	memcpy(points[0].x, p->x, sizeof(points[0].x));
+	memcpy(points[0].y, p->y, sizeof(points[0].y));
+	memcpy(points[0].z, p256_p.one, sizeof(points[0].z));
+	for (i = 1; i < P256_COMB_TEETH; i++) {
+		points[i] = points[i - 1];
+		for (k = 0; k < 256 / P256_COMB_TEETH; k++)
+			p256_point_double(&points[i], &points[i]);
+	}
+	p256_normalize(P256_COMB_TEETH, points, base);
+
+	for (c = 0; c < P256_COMB_COUNT; c++) {
+		for (b = 1; b < (1 << P256_COMB_TEETH); b++) {
+			if (c) {
+				// 2^8 times the entry of the previous comb
+				memcpy(points[b].x, comb->point[c - 1][b].x, sizeof(points[b].x));
+				memcpy(points[b].y, comb->point[c - 1][b].y, sizeof(points[b].y));
+				memcpy(points[b].z, p256_p.one, sizeof(points[b].z));
+				for (k = 0; k < P256_COMB_TEETH; k++)
+					p256_point_double(&points[b], &points[b]);
+				continue;
+			}
+			// entry without its top bit plus the base point of the top bit
+			for (top = 0; (2 << top) <= b; top++)
+				;
+			if (b == (1 << top)) {
+				memcpy(points[b].x, base[top].x, sizeof(points[b].x));
+				memcpy(points[b].y, base[top].y, sizeof(points[b].y));
+				memcpy(points[b].z, p256_p.one, sizeof(points[b].z));
+			}
+			else
+				p256_point_add_affine(&points[b], &points[b ^ (1 << top)], &base[top]);
+		}
+		p256_normalize((1 << P256_COMB_TEETH) - 1, &points[1], &comb->point[c][1]);
+	}
+}
+
+
+/** \brief This function returns the comb table of the base point. The first call builds it.
+ * \return pointer to comb table of G
+ */
+static const struct p256_comb *p256_base_comb(void)
+{
+	static struct p256_comb comb;
+	// 0: not built, 1: being built, 2: built
+	static uint8_t state;
+	uint8_t expected = 0;
+
+	if (__atomic_load_n(&state, __ATOMIC_ACQUIRE) != 2) {
+		if (__atomic_compare_exchange_n(&state, &expected, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+			p256_comb_build(&comb, &p256_g);
+			__atomic_store_n(&state, 2, __ATOMIC_RELEASE);
+		}
+		else {
+			// Another thread builds the table.
+			while (__atomic_load_n(&state, __ATOMIC_ACQUIRE) != 2)
+				;
+		}
+	}
+
+	return &comb;
+}
+
+
+/** \brief This function multiplies the point of a comb table by a scalar.
+ * \param[out] r pointer to result
+ * \param[in] comb pointer to comb table
+ * \param[in] k pointer to scalar
+ */
+static void p256_comb_mul(struct p256_point *r, const struct p256_comb *comb, const uint64_t *k)
+{
+	uint32_t words[256 / 32];
+	uint16_t b;
+	int8_t j;
+	uint8_t c, i, column;
+
+	for (i = 0; i < 4; i++) {
+		words[2 * i] = (uint32_t) k[i];
+		words[2 * i + 1] = (uint32_t) (k[i] >> 32);
+	}
+
+	memset(r, 0, sizeof(*r));
+	for (j = 256 / P256_COMB_TEETH / P256_COMB_COUNT - 1; j >= 0; j--) {
+		if (!p256_is_zero(r->z))
+			p256_point_double(r, r);
+		for (c = 0; c < P256_COMB_COUNT; c++) {
+			// Tooth i of column j + 8c is bit (32i + j + 8c) of k.
+			column = (uint8_t) (j + 8 * c);
+			for (i = 0, b = 0; i < P256_COMB_TEETH; i++)
+				b |= (uint16_t) (((words[i] >> column) & 1) << i);
+			if (b)
+				p256_point_add_affine(r, r, &comb->point[c][b]);
+		}
+	}
+}
+
+
+/** \brief This function multiplies a point by a scalar with a width-5 NAF.
+ * \param[out] r pointer to result
+ * \param[in] q pointer to point in affine coordinates
+ * \param[in] k pointer to scalar
+ */
+static void p256_wnaf_mul(struct p256_point *r, const struct p256_affine *q, const uint64_t *k)
+{
+	// odd multiples Q, 3Q, ..., 15Q
+	struct p256_point odd[1 << (P256_WNAF_WIDTH - 2)];
+	struct p256_point twice, negative;
+	int8_t naf[257];
+	uint64_t scalar[5];
+	int16_t i, top = -1;
+	int8_t digit;
+	uint8_t n;
+
+	memcpy(scalar, k, 4 * sizeof(uint64_t));
+	scalar[4] = 0;
+	for (i = 0; i < 257; i++) {
+		digit = 0;
+		if (scalar[0] & 1) {
+			digit = (int8_t) (scalar[0] & ((1 << P256_WNAF_WIDTH) - 1));
+			if (digit >= (1 << (P256_WNAF_WIDTH - 1)))
+				digit -= 1 << P256_WNAF_WIDTH;
+			// scalar -= digit, the result is divisible by 2^WIDTH.
+			if (digit > 0)
+				scalar[0] -= (uint64_t) digit;
+			else {
+				uint64_t add = (uint64_t) -digit;
+				for (n = 0; n < 5 && add; n++) {
+					scalar[n] += add;
+					add = scalar[n] < add;
+				}
+			}
+			top = i;
+		}
+		naf[i] = digit;
+		for (n = 0; n < 4; n++)
+			scalar[n] = (scalar[n] >> 1) | (scalar[n + 1] << 63);
+		scalar[4] >>= 1;
+	}
+
+	memcpy(odd[0].x, q->x, sizeof(odd[0].x));
+	memcpy(odd[0].y, q->y, sizeof(odd[0].y));
+	memcpy(odd[0].z, p256_p.one, sizeof(odd[0].z));
+	p256_point_double(&twice, &odd[0]);
+	for (n = 1; n < (1 << (P256_WNAF_WIDTH - 2)); n++)
+		p256_point_add(&odd[n], &odd[n - 1], &twice);
+
+	memset(r, 0, sizeof(*r));
+	for (i = top; i >= 0; i--) {
+		p256_point_double(r, r);
+		digit = naf[i];
+		if (digit > 0)
+			p256_point_add(r, r, &odd[digit >> 1]);
+		else if (digit < 0) {
+			negative = odd[(-digit) >> 1];
+			p256_mod_sub(negative.y, p256_p.m, negative.y, &p256_p);
+			p256_point_add(r, r, &negative);
+		}
+	}
+}
+
+/** @} */
+
+
+/** \brief This function decodes a private key or nonce and checks that it is in [1, n - 1].
+ * \param[out] k pointer to scalar
+ * \param[in] bytes pointer to 32-byte scalar
+ * \return 1 if the scalar is in range, otherwise 0
+ */
+static uint8_t p256_decode_scalar(uint64_t *k, const uint8_t *bytes)
+{
+	p256_from_bytes(k, bytes);
+
+	return !p256_is_zero(k) && p256_less(k, p256_n.m);
+}
+
+
+/** \brief This function multiplies the base point by a scalar and converts the result to affine coordinates.
+ * \param[out] x pointer to x coordinate, not in Montgomery form
+ * \param[out] y pointer to y coordinate, not in Montgomery form
+ * \param[in] k pointer to scalar in [1, n - 1]
+ */
+static void p256_base_mul(uint64_t *x, uint64_t *y, const uint64_t *k)
+{
+	struct p256_point point;
+	uint64_t z_inv[4], zz[4];
+	const uint64_t one[4] = {1, 0, 0, 0};
+
+	p256_comb_mul(&point, p256_base_comb(), k);
+
+	// A Montgomery product with 1 converts out of Montgomery form.
+	p256_mod_inv(z_inv, point.z, &p256_p);
+	p256_mod_mul(zz, z_inv, z_inv, &p256_p);
+	p256_mod_mul(x, point.x, zz, &p256_p);
+	p256_mod_mul(x, x, one, &p256_p);
+	p256_mod_mul(zz, zz, z_inv, &p256_p);
+	p256_mod_mul(y, point.y, zz, &p256_p);
+	p256_mod_mul(y, y, one, &p256_p);
+}
+
+
+/** \brief This function decodes a signature and the digest, and checks that r and s are in [1, n - 1].
+ * \param[out] e pointer to digest as integer modulo n
+ * \param[out] r pointer to r
+ * \param[out] s pointer to s in Montgomery form modulo n
+ * \param[in] digest pointer to 32-byte digest
+ * \param[in] signature pointer to 64-byte signature
+ * \return 1 if r and s are in range, otherwise 0
+ */
+static uint8_t p256_decode_signature(uint64_t *e, uint64_t *r, uint64_t *s, const uint8_t *digest, const uint8_t *signature)
+{
+	uint64_t t[4];
+
+	p256_from_bytes(r, signature);
+	p256_from_bytes(t, signature + P256_INT_SIZE);
+	if (p256_is_zero(r) || p256_is_zero(t) || !p256_less(r, p256_n.m) || !p256_less(t, p256_n.m))
+		return 0;
+	p256_to_mont(s, t, &p256_n);
+
+	// The digest has 256 bits, so it is less than 2n.
+	p256_from_bytes(e, digest);
+	if (!p256_less(e, p256_n.m))
+		p256_sub(e, e, p256_n.m);
+
+	return 1;
+}
+
+
+/** \brief This function calculates u1 * G + u2 * Q and compares its x coordinate with r.
+ *
+ * x = X / Z^2 mod n equals r if X = r * Z^2 or, if r + n < p, X = (r + n) * Z^2 (mod p).
+ * So the result is not converted to affine coordinates.
+ *
+ * \param[in] e pointer to digest modulo n
+ * \param[in] r pointer to r
+ * \param[in] s_inv pointer to 1 / s in Montgomery form modulo n
+ * \param[in] q pointer to public key, not used if comb is not NULL
+ * \param[in] comb pointer to comb table of the public key, or NULL
+ * \return P256_SUCCESS or P256_VERIFY_FAILED
+ */
+static uint8_t p256_verify_point(const uint64_t *e, const uint64_t *r, const uint64_t *s_inv,
+		const struct p256_affine *q, const struct p256_comb *comb)
+{
+	struct p256_point sum, part;
+	uint64_t u1[4], u2[4], zz[4], x[4], t[4];
+
+	// A Montgomery product with one factor in Montgomery form is the plain product.
+	p256_mod_mul(u1, e, s_inv, &p256_n);
+	p256_mod_mul(u2, r, s_inv, &p256_n);
+
+	p256_comb_mul(&sum, p256_base_comb(), u1);
+	if (comb)
+		p256_comb_mul(&part, comb, u2);
+	else
+		p256_wnaf_mul(&part, q, u2);
+	p256_point_add(&sum, &sum, &part);
+
+	if (p256_is_zero(sum.z))
+		return P256_VERIFY_FAILED;
+
+	p256_mod_mul(zz, sum.z, sum.z, &p256_p);
+	p256_to_mont(x, r, &p256_p);
+	p256_mod_mul(x, x, zz, &p256_p);
+	if (!memcmp(x, sum.x, sizeof(x)))
+		return P256_SUCCESS;
+
+	if (!p256_add(t, r, p256_n.m) && p256_less(t, p256_p.m)) {
+		p256_to_mont(x, t, &p256_p);
+		p256_mod_mul(x, x, zz, &p256_p);
+		if (!memcmp(x, sum.x, sizeof(x)))
+			return P256_SUCCESS;
+	}
+
+	return P256_VERIFY_FAILED;
+}
+
+
+/** \brief This function checks whether a public key is a point on the curve.
+ *
+ * \param[in] public_key pointer to 64-byte public key X || Y
+ * \return P256_SUCCESS or P256_BAD_PARAM
+ */
+uint8_t p256_public_key_check(const uint8_t *public_key)
+{
+	struct p256_affine q;
+
+	return p256_decode_key(&q, public_key);
+}
+
+
+/** \brief This function builds the comb table of a public key.
+ *
+ * Build it for public keys that verify many signatures, e.g. the root and signer keys
+ * of a certificate chain. Building takes about as long as 40 verifications.
+ *
+ * \param[out] comb pointer to comb table
+ * \param[in] public_key pointer to 64-byte public key X || Y
+ * \return P256_SUCCESS or P256_BAD_PARAM
+ */
+uint8_t p256_comb_init(struct p256_comb *comb, const uint8_t *public_key)
+{
+	struct p256_affine q;
+	uint8_t ret_code = p256_decode_key(&q, public_key);
+
+	if (ret_code == P256_SUCCESS)
+		p256_comb_build(comb, &q);
+
+	return ret_code;
+}
+
+
+/** \brief This function verifies a signature.
+ *
+ * \param[in] digest pointer to 32-byte message digest
+ * \param[in] signature pointer to 64-byte signature R || S
+ * \param[in] public_key pointer to 64-byte public key X || Y, not used if comb is not NULL
+ * \param[in] comb pointer to comb table of the public key, or NULL
+ * \return P256_SUCCESS, P256_VERIFY_FAILED, or P256_BAD_PARAM if the public key is not on the curve
+ */
+uint8_t p256_verify(const uint8_t *digest, const uint8_t *signature, const uint8_t *public_key,
+		const struct p256_comb *comb)
+{
+	struct p256_affine q;
+	uint64_t e[4], r[4], s[4];
+
+	if (!comb && (p256_decode_key(&q, public_key) != P256_SUCCESS))
+		return P256_BAD_PARAM;
+
+	if (!p256_decode_signature(e, r, s, digest, signature))
+		return P256_VERIFY_FAILED;
+
+	p256_mod_inv(s, s, &p256_n);
+
+	return p256_verify_point(e, r, s, &q, comb);
+}
+
+
+/** \brief This function verifies many signatures.
+ *
+ * The signatures are processed in groups of 64 that share one inversion modulo n.
+ *
+ * \param[in] count number of signatures
+ * \param[in] items array of count signatures
+ * \param[out] status array of count results, as p256_verify() returns them
+ */
+void p256_verify_batch(uint32_t count, const struct p256_verify_item *items, uint8_t *status)
+{
+	uint64_t e[P256_BATCH_SIZE][4], r[P256_BATCH_SIZE][4], s[P256_BATCH_SIZE][4], scratch[P256_BATCH_SIZE][4];
+	struct p256_affine q[P256_BATCH_SIZE];
+	uint16_t index[P256_BATCH_SIZE];
+	uint32_t first, i;
+	uint16_t valid, k;
+
+	p256_base_comb();
+
+	for (first = 0; first < count; first += P256_BATCH_SIZE) {
+		// Decode the group and collect the s values of the well-formed signatures.
+		for (i = first, valid = 0; i < count && i < first + P256_BATCH_SIZE; i++) {
+			if (!items[i].comb && (p256_decode_key(&q[valid], items[i].public_key) != P256_SUCCESS)) {
+				status[i] = P256_BAD_PARAM;
+				continue;
+			}
+			if (!p256_decode_signature(e[valid], r[valid], s[valid], items[i].digest, items[i].signature)) {
+				status[i] = P256_VERIFY_FAILED;
+				continue;
+			}
+			index[valid++] = (uint16_t) (i - first);
+		}
+
+		p256_mod_inv_batch(valid, s, scratch, &p256_n);
+
+		for (k = 0; k < valid; k++) {
+			i = first + index[k];
+			status[i] = p256_verify_point(e[k], r[k], s[k], &q[k], items[i].comb);
+		}
+	}
+}
+
+
+/** \brief This function verifies a signature without any precomputation.
+ *
+ * This is the textbook algorithm: two binary double-and-add multiplications, one inversion
+ * of s modulo n and one of Z modulo p per signature. It is the baseline the other
+ * functions of this module are measured against.
+ *
+ * \param[in] digest pointer to 32-byte message digest
+ * \param[in] signature pointer to 64-byte signature R || S
+ * \param[in] public_key pointer to 64-byte public key X || Y
+ * \return P256_SUCCESS, P256_VERIFY_FAILED, or P256_BAD_PARAM if the public key is not on the curve
+ */
+uint8_t p256_verify_basic(const uint8_t *digest, const uint8_t *signature, const uint8_t *public_key)
+{
+	struct p256_affine q;
+	struct p256_point sum, part;
+	uint64_t e[4], r[4], s[4], u1[4], u2[4], x[4], z_inv[4];
+	const uint64_t one[4] = {1, 0, 0, 0};
+	int16_t i;
+
+	if (p256_decode_key(&q, public_key) != P256_SUCCESS)
+		return P256_BAD_PARAM;
+
+	if (!p256_decode_signature(e, r, s, digest, signature))
+		return P256_VERIFY_FAILED;
+
+	p256_mod_inv(s, s, &p256_n);
+	p256_mod_mul(u1, e, s, &p256_n);
+	p256_mod_mul(u2, r, s, &p256_n);
+
+	memset(&sum, 0, sizeof(sum));
+	memset(&part, 0, sizeof(part));
+	for (i = 255; i >= 0; i--) {
+		p256_point_double(&sum, &sum);
+		p256_point_double(&part, &part);
+		if ((u1[i >> 6] >> (i & 63)) & 1)
+			p256_point_add_affine(&sum, &sum, &p256_g);
+		if ((u2[i >> 6] >> (i & 63)) & 1)
+			p256_point_add_affine(&part, &part, &q);
+	}
+	p256_point_add(&sum, &sum, &part);
+	if (p256_is_zero(sum.z))
+		return P256_VERIFY_FAILED;
+
+	// x = X / Z^2, converted out of Montgomery form, modulo n
+	p256_mod_inv(z_inv, sum.z, &p256_p);
+	p256_mod_mul(z_inv, z_inv, z_inv, &p256_p);
+	p256_mod_mul(x, sum.x, z_inv, &p256_p);
+	p256_mod_mul(x, x, one, &p256_p);
+	if (!p256_less(x, p256_n.m))
+		p256_sub(x, x, p256_n.m);
+
+	return memcmp(x, r, sizeof(x)) ? P256_VERIFY_FAILED : P256_SUCCESS;
+}
+
+
+/** \brief This function calculates the public key of a private key, as the GenKey command does.
+ *
+ * \param[out] public_key pointer to 64-byte public key X || Y
+ * \param[in] private_key pointer to 32-byte private key
+ * \return P256_SUCCESS, or P256_BAD_PARAM if the private key is not in [1, n - 1]
+ */
+uint8_t p256_public_key(uint8_t *public_key, const uint8_t *private_key)
+{
+	uint64_t d[4], x[4], y[4];
+
+	if (!p256_decode_scalar(d, private_key))
+		return P256_BAD_PARAM;
+
+	p256_base_mul(x, y, d);
+	p256_to_bytes(public_key, x);
+	p256_to_bytes(public_key + P256_INT_SIZE, y);
+
+	return P256_SUCCESS;
+}
+
+
+/** \brief This function signs a digest, as the Sign command does.
+ *
+ * The caller supplies the per-signature nonce k. It has to be random, secret,
+ * and never used twice with the same private key. If the function returns
+ * P256_BAD_PARAM for a valid private key, k has to be replaced by a new one.
+ *
+ * \param[out] signature pointer to 64-byte signature R || S
+ * \param[in] digest pointer to 32-byte message digest
+ * \param[in] private_key pointer to 32-byte private key
+ * \param[in] nonce pointer to 32-byte nonce k
+ * \return P256_SUCCESS, or P256_BAD_PARAM if the private key or k is not in [1, n - 1], or r or s is 0
+ */
+uint8_t p256_sign(uint8_t *signature, const uint8_t *digest, const uint8_t *private_key, const uint8_t *nonce)
+{
+	uint64_t d[4], k[4], e[4], r[4], s[4], y[4];
+
+	if (!p256_decode_scalar(d, private_key) || !p256_decode_scalar(k, nonce))
+		return P256_BAD_PARAM;
+
+	// r = x(k * G) mod n. x is less than p < 2n.
+	p256_base_mul(r, y, k);
+	if (!p256_less(r, p256_n.m))
+		p256_sub(r, r, p256_n.m);
+	if (p256_is_zero(r))
+		return P256_BAD_PARAM;
+
+	p256_from_bytes(e, digest);
+	if (!p256_less(e, p256_n.m))
+		p256_sub(e, e, p256_n.m);
+
+	// s = (e + r * d) / k mod n. A Montgomery product with one factor in Montgomery form is the plain product.
+	p256_to_mont(d, d, &p256_n);
+	p256_mod_mul(s, r, d, &p256_n);
+	p256_mod_add(s, s, e, &p256_n);
+	p256_to_mont(k, k, &p256_n);
+	p256_mod_inv(k, k, &p256_n);
+	p256_mod_mul(s, s, k, &p256_n);
+	if (p256_is_zero(s))
+		return P256_BAD_PARAM;
+
+	p256_to_bytes(signature, r);
+	p256_to_bytes(signature + P256_INT_SIZE, s);
+
+	return P256_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the P-256 Signature Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef P256_H
+#   define P256_H
+
+#include <stdint.h>                    // data type definitions
+
+
+/** \defgroup p256 P-256 Signature Verification
+ *
+ * \brief
+ * This module verifies ECDSA signatures on the NIST P-256 curve, the signatures
+ * an ATECC108 generates with its Sign command and checks with its Verify command.
+ * It is meant for hosts that verify many device signatures: the field elements
+ * are held in 64-bit limbs and multiplied with 128-bit products, which GCC and
+ * Clang provide on 64-bit targets.
+ *
+ * The scalar multiplications with the base point, and with public keys that are
+ * used for many signatures (e.g. root and signer keys), use fixed-base comb
+ * tables: four combs of eight teeth, so that a multiplication takes 8 point
+ * doublings and 32 additions. The table of the base point is built by the first
+ * verification; tables of public keys are built with p256_comb_init().
+ * p256_verify_batch() also shares the modular inversions of all signatures of a
+ * batch (Montgomery's trick).
+ *
+ * Signatures are checked without converting the result point to affine
+ * coordinates, so a verification does not invert in the prime field.
+ * Signatures and keys are public data, so the code does not run in constant time.
+ *
+ * p256_public_key() and p256_sign() calculate what the GenKey and Sign commands
+ * return, for device models and test vectors. They do not run in constant time
+ * either, so they must not handle private keys of production devices.
+@{ */
+
+#define P256_INT_SIZE               (32)   //!< size of a coordinate, scalar or digest in bytes
+#define P256_KEY_SIZE               (64)   //!< size of a public key in bytes: X{32} || Y{32}
+#define P256_SIGNATURE_SIZE         (64)   //!< size of a signature in bytes: R{32} || S{32}
+
+#define P256_COMB_TEETH              (8)   //!< number of bits a comb table entry combines
+#define P256_COMB_COUNT              (4)   //!< number of combs
+
+#define P256_SUCCESS                ((uint8_t) 0x00)   //!< signature is valid, same value as ECC108_SUCCESS
+#define P256_VERIFY_FAILED          ((uint8_t) 0xD1)   //!< signature is invalid, same value as ECC108_CHECKMAC_FAILED
+#define P256_BAD_PARAM              ((uint8_t) 0xE2)   //!< public key is not on the curve or scalar is out of range, same value as ECC108_BAD_PARAM
+
+
+/** \struct p256_affine
+ *  \brief Point in affine coordinates
+ *  \var p256_affine::x
+ *       \brief X coordinate in Montgomery form, least significant limb first.
+ *  \var p256_affine::y
+ *       \brief Y coordinate in Montgomery form, least significant limb first.
+ */
+struct p256_affine {
+	uint64_t x[4];
+	uint64_t y[4];
+};
+
+
+/** \struct p256_comb
+ *  \brief Fixed-base comb table of a point P (64 KB)
+ *  \var p256_comb::point
+ *       \brief Entry [c][b] is the sum of 2^(8c + 32i) * P over all bits i set in b. Entry [c][0] is not used.
+ */
+struct p256_comb {
+	struct p256_affine point[P256_COMB_COUNT][1 << P256_COMB_TEETH];
+};
+
+
+/** \struct p256_verify_item
+ *  \brief One signature of a batch
+ *  \var p256_verify_item::digest
+ *       \brief [in] Pointer to the 32-byte message digest that was signed.
+ *  \var p256_verify_item::signature
+ *       \brief [in] Pointer to the 64-byte signature.
+ *  \var p256_verify_item::public_key
+ *       \brief [in] Pointer to the 64-byte public key. Not used if comb is not NULL.
+ *  \var p256_verify_item::comb
+ *       \brief [in] Pointer to the comb table of the public key, or NULL.
+ */
+struct p256_verify_item {
+	const uint8_t *digest;
+	const uint8_t *signature;
+	const uint8_t *public_key;
+	const struct p256_comb *comb;
+};
+
+
+uint8_t p256_public_key_check(const uint8_t *public_key);
+uint8_t p256_comb_init(struct p256_comb *comb, const uint8_t *public_key);
+uint8_t p256_verify(const uint8_t *digest, const uint8_t *signature, const uint8_t *public_key,
+		const struct p256_comb *comb);
+void p256_verify_batch(uint32_t count, const struct p256_verify_item *items, uint8_t *status);
+uint8_t p256_verify_basic(const uint8_t *digest, const uint8_t *signature, const uint8_t *public_key);
+uint8_t p256_public_key(uint8_t *public_key, const uint8_t *private_key);
+uint8_t p256_sign(uint8_t *signature, const uint8_t *digest, const uint8_t *private_key, const uint8_t *nonce);
+
+/** @} */
+
+#endif //P256_H
@@ -0,0 +1,728 @@
+/** \file
+ *  \brief  SHA-256 Hash Functions
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdint.h>                    // data type definitions
+
+#include "sha256.h"                    // header module for this C module
+
+#if defined(SHA256_PORTABLE)
+// Only the portable compression function is built.
+#elif defined(__AVR__)
+//! The compression function for the 8-bit AVR is built.
+#   define SHA256_AVR
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+//! The SHA-NI compression function is built.
+#   define SHA256_SHA_NI
+#   include <immintrin.h>              // SSE4.1 and SHA intrinsics
+#elif defined(__GNUC__) && !defined(__clang__) && defined(__aarch64__) && defined(__linux__)
+//! The ARMv8 Cryptography Extensions compression function is built.
+#   define SHA256_ARMV8_CE
+#   include <arm_neon.h>               // NEON and SHA-256 intrinsics
+#   include <sys/auxv.h>               // needed for getauxval()
+#   ifndef HWCAP_SHA2
+#      define HWCAP_SHA2            (1 << 6)
+#   endif
+#endif
+
+
+#define rotate_right(value, places) (((value) >> (places)) | ((value) << (32 - (places))))
+
+#define sha256_ch(x, y, z)      (((x) & (y)) ^ (~(x) & (z)))
+#define sha256_maj(x, y, z)     (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define sha256_sum0(x)          (rotate_right(x, 2) ^ rotate_right(x, 13) ^ rotate_right(x, 22))
+#define sha256_sum1(x)          (rotate_right(x, 6) ^ rotate_right(x, 11) ^ rotate_right(x, 25))
+#define sha256_sigma0(x)        (rotate_right(x, 7) ^ rotate_right(x, 18) ^ ((x) >> 3))
+#define sha256_sigma1(x)        (rotate_right(x, 17) ^ rotate_right(x, 19) ^ ((x) >> 10))
+
+#ifdef __AVR__
+#   define sha256_load_init_hash(hash)  memcpy_P(hash, sha256_init_hash, sizeof(sha256_init_hash))
+#else
+#   define sha256_load_init_hash(hash)  memcpy(hash, sha256_init_hash, sizeof(sha256_init_hash))
+#endif
+
+//! offset in the last block where the 64-bit message bit length is stored
+#define SHA256_LENGTH_POS       (SHA256_BLOCK_SIZE - sizeof(uint64_t))
+
+
+//! initial hash value
+const uint32_t sha256_init_hash[SHA256_DIGEST_SIZE / sizeof(uint32_t)] SHA256_FLASH = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+	0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+//! round constants
+const uint32_t sha256_k[SHA256_BLOCK_SIZE] SHA256_FLASH = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+
+/** \brief This function runs the portable SHA-256 compression function over message blocks.
+ *
+ * \param[in, out] hash intermediate hash value, updated with the blocks
+ * \param[in] blocks pointer to consecutive 64-byte message blocks
+ * \param[in] count number of blocks
+ */
+#ifndef SHA256_AVR
+static void sha256_process_blocks_portable(uint32_t *hash, const uint8_t *blocks, uint32_t count)
+{
+	uint8_t i;
+	uint32_t w[SHA256_BLOCK_SIZE];
+	uint32_t a, b, c, d, e, f, g, h;
+	uint32_t t1, t2;
+
+	for (; count; count--) {
+		// Load the block as big-endian words.
+		for (i = 0; i < 16; i++, blocks += sizeof(uint32_t))
+			w[i] = ((uint32_t) blocks[0] << 24) | ((uint32_t) blocks[1] << 16)
+				| ((uint32_t) blocks[2] << 8) | (uint32_t) blocks[3];
+
+		// Expand the message schedule.
+		for (; i < SHA256_BLOCK_SIZE; i++)
+			w[i] = sha256_sigma1(w[i - 2]) + w[i - 7] + sha256_sigma0(w[i - 15]) + w[i - 16];
+
+		a = hash[0]; b = hash[1]; c = hash[2]; d = hash[3];
+		e = hash[4]; f = hash[5]; g = hash[6]; h = hash[7];
+
+		for (i = 0; i < SHA256_BLOCK_SIZE; i++) {
+			t1 = h + sha256_sum1(e) + sha256_ch(e, f, g) + sha256_k[i] + w[i];
+			t2 = sha256_sum0(a) + sha256_maj(a, b, c);
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+
+		hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+		hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+	}
+}
+#endif
+
+
+#ifdef SHA256_AVR
+/** \brief 32-bit word with access to its bytes. The AVR is little-endian, so b[0] is the LSB.
+ *
+ * avr-gcc builds a 32-bit rotate by n places from n single-bit rotates, or from a shift
+ * loop. The rotates below are split instead into a byte rotate, which only moves
+ * registers, and at most three single-bit rotates.
+ */
+union sha256_avr_word {
+	uint32_t w;
+	uint8_t b[4];
+};
+
+//! rotates right by 8 bits
+static inline uint32_t sha256_avr_rotr8(uint32_t x)
+{
+	union sha256_avr_word in = {.w = x}, out;
+
+	out.b[0] = in.b[1]; out.b[1] = in.b[2]; out.b[2] = in.b[3]; out.b[3] = in.b[0];
+	return out.w;
+}
+
+//! rotates right by 16 bits
+static inline uint32_t sha256_avr_rotr16(uint32_t x)
+{
+	union sha256_avr_word in = {.w = x}, out;
+
+	out.b[0] = in.b[2]; out.b[1] = in.b[3]; out.b[2] = in.b[0]; out.b[3] = in.b[1];
+	return out.w;
+}
+
+//! rotates right by 24 bits, i.e. left by 8 bits
+static inline uint32_t sha256_avr_rotr24(uint32_t x)
+{
+	union sha256_avr_word in = {.w = x}, out;
+
+	out.b[0] = in.b[3]; out.b[1] = in.b[0]; out.b[2] = in.b[1]; out.b[3] = in.b[2];
+	return out.w;
+}
+
+#define sha256_avr_rotr1(x)     (((x) >> 1) | ((x) << 31))
+#define sha256_avr_rotl1(x)     (((x) << 1) | ((x) >> 31))
+#define sha256_avr_rotr2(x)     sha256_avr_rotr1(sha256_avr_rotr1(x))
+#define sha256_avr_rotl2(x)     sha256_avr_rotl1(sha256_avr_rotl1(x))
+#define sha256_avr_rotr3(x)     sha256_avr_rotr1(sha256_avr_rotr2(x))
+#define sha256_avr_rotl3(x)     sha256_avr_rotl1(sha256_avr_rotl2(x))
+
+//! (x & y) ^ (~x & z) with one operation less
+#define sha256_avr_ch(x, y, z)  ((((y) ^ (z)) & (x)) ^ (z))
+//! (x & y) ^ (x & z) ^ (y & z) with one operation less
+#define sha256_avr_maj(x, y, z) (((x) & (y)) | (((x) | (y)) & (z)))
+
+//! ROTR 2 ^ ROTR 13 (16 - 3) ^ ROTR 22 (24 - 2)
+static inline uint32_t sha256_avr_sum0(uint32_t x)
+{
+	uint32_t r16 = sha256_avr_rotr16(x);
+	uint32_t r24 = sha256_avr_rotr24(x);
+
+	return sha256_avr_rotr2(x) ^ sha256_avr_rotl3(r16) ^ sha256_avr_rotl2(r24);
+}
+
+//! ROTR 6 (8 - 2) ^ ROTR 11 (8 + 3) ^ ROTR 25 (24 + 1)
+static inline uint32_t sha256_avr_sum1(uint32_t x)
+{
+	uint32_t r8 = sha256_avr_rotr8(x);
+	uint32_t r24 = sha256_avr_rotr24(x);
+
+	return sha256_avr_rotl2(r8) ^ sha256_avr_rotr3(r8) ^ sha256_avr_rotr1(r24);
+}
+
+//! ROTR 7 (8 - 1) ^ ROTR 18 (16 + 2) ^ SHR 3
+static inline uint32_t sha256_avr_sigma0(uint32_t x)
+{
+	uint32_t r8 = sha256_avr_rotr8(x);
+	uint32_t r16 = sha256_avr_rotr16(x);
+
+	return sha256_avr_rotl1(r8) ^ sha256_avr_rotr2(r16) ^ (x >> 3);
+}
+
+//! ROTR 17 (16 + 1) ^ ROTR 19 (16 + 3) ^ SHR 10 (8 + 2)
+static inline uint32_t sha256_avr_sigma1(uint32_t x)
+{
+	uint32_t r16 = sha256_avr_rotr16(x);
+
+	return sha256_avr_rotr1(r16) ^ sha256_avr_rotr3(r16) ^ ((x >> 8) >> 2);
+}
+
+/** \brief One SHA-256 round for round index i.
+ *
+ * The working variables are not shifted after a round. Instead, the caller passes them
+ * in rotated order, so only d and h are written. From round 16 on, w[] is used as a
+ * ring of the last 16 schedule words, and the word of this round is expanded in place.
+ */
+#define SHA256_AVR_ROUND(a, b, c, d, e, f, g, h, i) \
+	do { \
+		if ((i) >= 16) \
+			w[(i) & 15] += sha256_avr_sigma1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] \
+					+ sha256_avr_sigma0(w[((i) - 15) & 15]); \
+		t1 = h + sha256_avr_sum1(e) + sha256_avr_ch(e, f, g) + pgm_read_dword(&sha256_k[i]) + w[(i) & 15]; \
+		d += t1; \
+		h = t1 + sha256_avr_sum0(a) + sha256_avr_maj(a, b, c); \
+	} while (0)
+
+/** \brief This function runs the SHA-256 compression function over message blocks
+ *         on the 8-bit AVR.
+ *
+ * Compared to the portable code, the round constants are read from flash, the message
+ * schedule takes 64 bytes of stack instead of 256, and eight rounds are unrolled,
+ * so the working variables are never moved.
+ *
+ * \param[in, out] hash intermediate hash value, updated with the blocks
+ * \param[in] blocks pointer to consecutive 64-byte message blocks
+ * \param[in] count number of blocks
+ */
+static void sha256_process_blocks_avr(uint32_t *hash, const uint8_t *blocks, uint32_t count)
+{
+	uint8_t i;
+	union sha256_avr_word word;
+	uint32_t w[16];
+	uint32_t a, b, c, d, e, f, g, h;
+	uint32_t t1;
+
+	for (; count; count--) {
+		// Load the block as big-endian words, byte by byte.
+		for (i = 0; i < 16; i++, blocks += sizeof(uint32_t)) {
+			word.b[3] = blocks[0];
+			word.b[2] = blocks[1];
+			word.b[1] = blocks[2];
+			word.b[0] = blocks[3];
+			w[i] = word.w;
+		}
+
+		a = hash[0]; b = hash[1]; c = hash[2]; d = hash[3];
+		e = hash[4]; f = hash[5]; g = hash[6]; h = hash[7];
+
+		for (i = 0; i < SHA256_BLOCK_SIZE; i += 8) {
+			SHA256_AVR_ROUND(a, b, c, d, e, f, g, h, i + 0);
+			SHA256_AVR_ROUND(h, a, b, c, d, e, f, g, i + 1);
+			SHA256_AVR_ROUND(g, h, a, b, c, d, e, f, i + 2);
+			SHA256_AVR_ROUND(f, g, h, a, b, c, d, e, i + 3);
+			SHA256_AVR_ROUND(e, f, g, h, a, b, c, d, i + 4);
+			SHA256_AVR_ROUND(d, e, f, g, h, a, b, c, i + 5);
+			SHA256_AVR_ROUND(c, d, e, f, g, h, a, b, i + 6);
+			SHA256_AVR_ROUND(b, c, d, e, f, g, h, a, i + 7);
+		}
+
+		hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+		hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+	}
+}
+#endif
+
+
+#ifdef SHA256_SHA_NI
+/** \brief This function runs the SHA-256 compression function over message blocks
+ *         using the x86 SHA extensions.
+ *
+ * The SHA instructions keep the working variables in the register pair ABEF / CDGH,
+ * and they take four rounds worth of message schedule at a time.
+ *
+ * \param[in, out] hash intermediate hash value, updated with the blocks
+ * \param[in] blocks pointer to consecutive 64-byte message blocks
+ * \param[in] count number of blocks
+ */
+__attribute__((target("sha,sse4.1")))
+static void sha256_process_blocks_sha_ni(uint32_t *hash, const uint8_t *blocks, uint32_t count)
+{
+	uint8_t i;
+	__m128i abef, cdgh, abef_save, cdgh_save;
+	__m128i w[4], wk, tmp;
+	const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	// Rearrange A..H into ABEF and CDGH.
+	tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &hash[0]), 0xB1);   // CDAB
+	cdgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &hash[4]), 0x1B);  // EFGH
+	abef = _mm_alignr_epi8(tmp, cdgh, 8);
+	cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+	for (; count; count--, blocks += SHA256_BLOCK_SIZE) {
+		abef_save = abef;
+		cdgh_save = cdgh;
+
+		for (i = 0; i < 4; i++)
+			w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) &blocks[i << 4]), byte_swap);
+
+		// 16 x 4 rounds. w[] holds the schedule words of the next four groups of rounds.
+		for (i = 0; i < 16; i++) {
+			wk = _mm_add_epi32(w[i & 3], _mm_loadu_si128((const __m128i *) &sha256_k[i << 2]));
+			cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+			abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0E));
+
+			if (i < 12) {
+				tmp = _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4);
+				w[i & 3] = _mm_sha256msg2_epu32(
+						_mm_add_epi32(_mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]), tmp),
+						w[(i + 3) & 3]);
+			}
+		}
+
+		abef = _mm_add_epi32(abef, abef_save);
+		cdgh = _mm_add_epi32(cdgh, cdgh_save);
+	}
+
+	// Rearrange ABEF and CDGH back into A..H.
+	tmp = _mm_shuffle_epi32(abef, 0x1B);       // FEBA
+	cdgh = _mm_shuffle_epi32(cdgh, 0xB1);      // DCHG
+	_mm_storeu_si128((__m128i *) &hash[0], _mm_blend_epi16(tmp, cdgh, 0xF0));
+	_mm_storeu_si128((__m128i *) &hash[4], _mm_alignr_epi8(cdgh, tmp, 8));
+}
+#endif
+
+
+#ifdef SHA256_ARMV8_CE
+/** \brief This function runs the SHA-256 compression function over message blocks
+ *         using the ARMv8 Cryptography Extensions.
+ *
+ * \param[in, out] hash intermediate hash value, updated with the blocks
+ * \param[in] blocks pointer to consecutive 64-byte message blocks
+ * \param[in] count number of blocks
+ */
+__attribute__((target("+crypto")))
+static void sha256_process_blocks_armv8(uint32_t *hash, const uint8_t *blocks, uint32_t count)
+{
+	uint8_t i;
+	uint32x4_t abcd, efgh, abcd_in, abcd_save, efgh_save;
+	uint32x4_t w[4], wk;
+
+	abcd = vld1q_u32(&hash[0]);
+	efgh = vld1q_u32(&hash[4]);
+
+	for (; count; count--, blocks += SHA256_BLOCK_SIZE) {
+		abcd_save = abcd;
+		efgh_save = efgh;
+
+		for (i = 0; i < 4; i++)
+			w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&blocks[i << 4])));
+
+		// 16 x 4 rounds. w[] holds the schedule words of the next four groups of rounds.
+		for (i = 0; i < 16; i++) {
+			wk = vaddq_u32(w[i & 3], vld1q_u32(&sha256_k[i << 2]));
+			if (i < 12)
+				w[i & 3] = vsha256su1q_u32(vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]),
+						w[(i + 2) & 3], w[(i + 3) & 3]);
+
+			abcd_in = abcd;
+			abcd = vsha256hq_u32(abcd, efgh, wk);
+			efgh = vsha256h2q_u32(efgh, abcd_in, wk);
+		}
+
+		abcd = vaddq_u32(abcd, abcd_save);
+		efgh = vaddq_u32(efgh, efgh_save);
+	}
+
+	vst1q_u32(&hash[0], abcd);
+	vst1q_u32(&hash[4], efgh);
+}
+#endif
+
+
+//! type of a compression function that processes consecutive message blocks
+typedef void (*sha256_process_blocks_t)(uint32_t *hash, const uint8_t *blocks, uint32_t count);
+
+#if defined(SHA256_SHA_NI) || defined(SHA256_ARMV8_CE)
+//! compression function, replaced by sha256_select() if the CPU supports a faster one
+static sha256_process_blocks_t sha256_process_blocks = sha256_process_blocks_portable;
+
+
+/** \brief This function selects the fastest compression function the CPU supports.
+ *
+ * It runs as a constructor before main(), so the function pointer is written before
+ * any thread can read it, and the hashing functions do not need to check it.
+ */
+__attribute__((constructor)) static void sha256_select(void)
+{
+#   if defined(SHA256_SHA_NI)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1"))
+		sha256_process_blocks = sha256_process_blocks_sha_ni;
+#   else
+	if (getauxval(AT_HWCAP) & HWCAP_SHA2)
+		sha256_process_blocks = sha256_process_blocks_armv8;
+#   endif
+}
+
+#elif defined(SHA256_AVR)
+//! compression function, fixed at compile time
+static const sha256_process_blocks_t sha256_process_blocks = sha256_process_blocks_avr;
+#else
+//! compression function, fixed at compile time
+static const sha256_process_blocks_t sha256_process_blocks = sha256_process_blocks_portable;
+#endif
+
+
+/** \brief This function outputs the hash value as digest, MSB of every word first.
+ *
+ * \param[in] hash final hash value
+ * \param[out] digest pointer to 32-byte SHA-256 digest
+ */
+static void sha256_output_digest(const uint32_t *hash, uint8_t *digest)
+{
+	uint8_t i;
+
+	for (i = 0; i < SHA256_DIGEST_SIZE; i++)
+		digest[i] = (uint8_t) (hash[i >> 2] >> (24 - ((i & 3) << 3)));
+}
+
+
+/** \brief This function initializes a SHA-256 context.
+ *
+ * \param[out] ctx pointer to context
+ */
+void sha256_init(struct sha256_ctx *ctx)
+{
+	sha256_load_init_hash(ctx->hash);
+	ctx->total_len = 0;
+	ctx->block_len = 0;
+}
+
+
+/** \brief This function initializes a SHA-256 context with the intermediate hash value
+ *         of a message prefix that has already been hashed.
+ *
+ * The midstate is the sha256_ctx::hash value after sha256_update() has processed
+ * exactly block_count complete blocks. Callers that hash many messages starting with
+ * the same prefix block, like the ipad / opad blocks of HMAC, can store the midstate
+ * and skip compressing the prefix again.
+ *
+ * \param[out] ctx pointer to context
+ * \param[in] midstate pointer to intermediate hash value (eight 32-bit words)
+ * \param[in] block_count number of 64-byte blocks hashed into midstate
+ */
+void sha256_init_midstate(struct sha256_ctx *ctx, const uint32_t *midstate, uint32_t block_count)
+{
+	memcpy(ctx->hash, midstate, sizeof(ctx->hash));
+	ctx->total_len = (uint64_t) block_count * SHA256_BLOCK_SIZE;
+	ctx->block_len = 0;
+}
+
+
+/** \brief This function adds message bytes to a running SHA-256 calculation.
+ *
+ * It can be called any number of times between sha256_init() and sha256_final().
+ * Complete blocks are hashed straight from the message buffer.
+ *
+ * \param[in, out] ctx pointer to context
+ * \param[in] len number of bytes in message
+ * \param[in] message pointer to message bytes
+ */
+void sha256_update(struct sha256_ctx *ctx, uint32_t len, const uint8_t *message)
+{
+	uint8_t copy_len;
+	uint32_t block_count;
+
+	ctx->total_len += len;
+
+	// Complete a block left over from a previous call.
+	if (ctx->block_len) {
+		copy_len = SHA256_BLOCK_SIZE - ctx->block_len;
+		if (len < copy_len)
+			copy_len = (uint8_t) len;
+		memcpy(&ctx->block[ctx->block_len], message, copy_len);
+		ctx->block_len += copy_len;
+		message += copy_len;
+		len -= copy_len;
+		if (ctx->block_len < SHA256_BLOCK_SIZE)
+			return;
+		sha256_process_blocks(ctx->hash, ctx->block, 1);
+		ctx->block_len = 0;
+	}
+
+	block_count = len / SHA256_BLOCK_SIZE;
+	if (block_count) {
+		sha256_process_blocks(ctx->hash, message, block_count);
+		message += block_count * SHA256_BLOCK_SIZE;
+		len -= block_count * SHA256_BLOCK_SIZE;
+	}
+
+	// Keep the rest for the next call.
+	memcpy(ctx->block, message, len);
+	ctx->block_len = (uint8_t) len;
+}
+
+
+/** \brief This function pads the message, processes the last block(s), and outputs the digest.
+ *
+ * The context has to be initialized again with sha256_init() before it can be reused.
+ *
+ * \param[in, out] ctx pointer to context
+ * \param[out] digest pointer to 32-byte SHA-256 digest
+ */
+void sha256_final(struct sha256_ctx *ctx, uint8_t *digest)
+{
+	uint8_t i;
+	uint64_t bit_len = ctx->total_len << 3;
+
+	// Append the '1' bit.
+	ctx->block[ctx->block_len++] = 0x80;
+
+	// If there is no room left for the length, pad and process this block first.
+	if (ctx->block_len > SHA256_LENGTH_POS) {
+		memset(&ctx->block[ctx->block_len], 0, SHA256_BLOCK_SIZE - ctx->block_len);
+		sha256_process_blocks(ctx->hash, ctx->block, 1);
+		ctx->block_len = 0;
+	}
+	memset(&ctx->block[ctx->block_len], 0, SHA256_LENGTH_POS - ctx->block_len);
+
+	// Append the message length in bits as 64-bit big-endian integer.
+	for (i = SHA256_BLOCK_SIZE - 1; i >= SHA256_LENGTH_POS; i--, bit_len >>= 8)
+		ctx->block[i] = (uint8_t) bit_len;
+	sha256_process_blocks(ctx->hash, ctx->block, 1);
+
+	sha256_output_digest(ctx->hash, digest);
+}
+
+
+/** \brief This function calculates the SHA-256 digest of a message in one call.
+ *
+ * \param[in] len byte length of message
+ * \param[in] message pointer to message
+ * \param[out] digest pointer to 32-byte SHA-256 digest
+ */
+void sha256(uint32_t len, const uint8_t *message, uint8_t *digest)
+{
+	struct sha256_ctx ctx;
+
+	sha256_init(&ctx);
+	sha256_update(&ctx, len, message);
+	sha256_final(&ctx, digest);
+}
+
+
+/** \brief This function adds a message that is scattered over several buffers
+ *         to a running SHA-256 calculation.
+ *
+ * The segments are hashed in order, as if they had been copied into one buffer.
+ *
+ * \param[in, out] ctx pointer to context
+ * \param[in] count number of segments
+ * \param[in] segments pointer to array of segments
+ */
+void sha256_update_segments(struct sha256_ctx *ctx, uint8_t count, const struct sha256_segment *segments)
+{
+	for (; count; count--, segments++)
+		sha256_update(ctx, segments->len, segments->data);
+}
+
+
+/** \brief This function calculates the SHA-256 digest of a message that is scattered
+ *         over several buffers.
+ *
+ * A message assembled from fields, like the CryptoAuth command messages, can be hashed
+ * without copying the fields into a message buffer first.
+ *
+ * \param[in] count number of segments
+ * \param[in] segments pointer to array of segments
+ * \param[out] digest pointer to 32-byte SHA-256 digest
+ */
+void sha256_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest)
+{
+	struct sha256_ctx ctx;
+
+	sha256_init(&ctx);
+	sha256_update_segments(&ctx, count, segments);
+	sha256_final(&ctx, digest);
+}
+
+
+#if defined(__GNUC__) && !defined(__AVR__) && !defined(__OPTIMIZE_SIZE__)
+//! On hosts optimized for speed, inline the fixed-length core into every wrapper, so the compiler
+//! folds its length constant.
+#   define SHA256_FIXED_INLINE  static inline __attribute__((always_inline))
+#elif defined(__GNUC__)
+//! On the AVR and in size-optimized builds, the twelve wrappers share one copy of the core.
+#   define SHA256_FIXED_INLINE  static __attribute__((noinline))
+#else
+#   define SHA256_FIXED_INLINE  static
+#endif
+
+/** \brief This function calculates the SHA-256 digest of a message whose length is a constant.
+ *
+ * It is only called with literal lengths, so where it is inlined, the number of blocks,
+ * the position of the '1' bit, the zero padding and the length bytes are all constants,
+ * and none of the branches of sha256_final() remain. Where it is not inlined, one
+ * copy serves all lengths. The message can be scattered over
+ * several segments. Complete blocks of a segment are hashed in place; only the blocks that
+ * span segments and the last block are gathered in a block buffer.
+ *
+ * \param[in] midstate pointer to intermediate hash value, NULL to start a new message
+ * \param[in] prefix_len byte length of the message prefix hashed into midstate, 0 or a multiple of 64
+ * \param[in] len byte length of the rest of the message, the sum of the segment lengths
+ * \param[in] count number of segments
+ * \param[in] segments pointer to array of segments
+ * \param[out] digest pointer to 32-byte SHA-256 digest
+ */
+SHA256_FIXED_INLINE void sha256_fixed(const uint32_t *midstate, const uint32_t prefix_len, const uint32_t len,
+		uint8_t count, const struct sha256_segment *segments, uint8_t *digest)
+{
+	const uint8_t tail_len = (uint8_t) (len % SHA256_BLOCK_SIZE);
+	const uint64_t bit_len = (uint64_t) (prefix_len + len) << 3;
+	uint32_t hash[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+	uint8_t block[SHA256_BLOCK_SIZE];
+	uint8_t block_len = 0;
+	uint8_t copy_len;
+	const uint8_t *data;
+	uint16_t remaining;
+	uint8_t i;
+
+	if (midstate)
+		memcpy(hash, midstate, sizeof(hash));
+	else
+		sha256_load_init_hash(hash);
+
+	for (; count; count--, segments++) {
+		data = segments->data;
+		remaining = segments->len;
+		if (!block_len && remaining >= SHA256_BLOCK_SIZE) {
+			sha256_process_blocks(hash, data, remaining / SHA256_BLOCK_SIZE);
+			data += remaining - remaining % SHA256_BLOCK_SIZE;
+			remaining %= SHA256_BLOCK_SIZE;
+		}
+		while (remaining) {
+			copy_len = SHA256_BLOCK_SIZE - block_len;
+			if (remaining < copy_len)
+				copy_len = (uint8_t) remaining;
+			memcpy(&block[block_len], data, copy_len);
+			block_len += copy_len;
+			data += copy_len;
+			remaining -= copy_len;
+			if (block_len == SHA256_BLOCK_SIZE) {
+				sha256_process_blocks(hash, block, 1);
+				block_len = 0;
+			}
+		}
+	}
+
+	// The block buffer holds the last tail_len bytes of the message now.
+	block[tail_len] = 0x80;
+	if (tail_len >= SHA256_LENGTH_POS) {
+		memset(&block[tail_len + 1], 0, SHA256_BLOCK_SIZE - tail_len - 1);
+		sha256_process_blocks(hash, block, 1);
+		memset(block, 0, SHA256_LENGTH_POS);
+	}
+	else
+		memset(&block[tail_len + 1], 0, SHA256_LENGTH_POS - tail_len - 1);
+	for (i = 0; i < sizeof(uint64_t); i++)
+		block[SHA256_BLOCK_SIZE - 1 - i] = (uint8_t) (bit_len >> (i << 3));
+	sha256_process_blocks(hash, block, 1);
+
+	sha256_output_digest(hash, digest);
+}
+
+
+//! Defines functions sha256_<len>() and sha256_<len>_segments(), which hash messages of exactly len bytes.
+#define SHA256_FIXED_FUNCTION(len) \
+	void sha256_##len(const uint8_t *message, uint8_t *digest) \
+	{ \
+		const struct sha256_segment segment = {message, len}; \
+		sha256_fixed(NULL, 0, len, 1, &segment, digest); \
+	} \
+	void sha256_##len##_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest) \
+	{ \
+		sha256_fixed(NULL, 0, len, count, segments, digest); \
+	}
+
+//! Defines function sha256_<len>_midstate(), which hashes the rest of a message of exactly
+//! len bytes whose first block is hashed into a midstate.
+#define SHA256_FIXED_MIDSTATE_FUNCTION(len) \
+	void sha256_##len##_midstate(const uint32_t *midstate, uint8_t count, const struct sha256_segment *segments, \
+			uint8_t *digest) \
+	{ \
+		sha256_fixed(midstate, SHA256_BLOCK_SIZE, len - SHA256_BLOCK_SIZE, count, segments, digest); \
+	}
+
+SHA256_FIXED_FUNCTION(39)
+SHA256_FIXED_FUNCTION(55)
+SHA256_FIXED_FUNCTION(88)
+SHA256_FIXED_FUNCTION(96)
+SHA256_FIXED_FUNCTION(152)
+SHA256_FIXED_MIDSTATE_FUNCTION(96)
+SHA256_FIXED_MIDSTATE_FUNCTION(152)
@@ -0,0 +1,144 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the SHA-256 Hash Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef SHA256_H
+#   define SHA256_H
+
+#include <stdint.h>                    // data type definitions
+
+
+/** \defgroup sha256 SHA-256 Hash
+ *
+ * \brief
+ * This module implements SHA-256 (FIPS 180-4) as an init / update / final sequence.
+ * Messages of any length can be hashed, and they do not have to be held in one
+ * contiguous buffer. The host-side helper functions of the SHA204 and ECC108
+ * libraries calculate all their digests with this module.
+ *
+ * On x86 hosts with the SHA extensions (SHA-NI) and on ARMv8 Linux hosts with the
+ * Cryptography Extensions, the compression function runs on these instructions.
+ * The CPU features are checked once, before main() runs. 8-bit AVR
+ * targets use a compression function written for their register file, and keep the
+ * constant tables in flash. All other targets use the portable code.
+ * Define SHA256_PORTABLE to build only the portable code, e.g. to compare speed.
+@{ */
+
+#define SHA256_DIGEST_SIZE      (32)   //!< size of a SHA-256 digest in bytes
+#define SHA256_BLOCK_SIZE       (64)   //!< size of a SHA-256 message block in bytes
+
+#if defined(__AVR__)
+#   include <avr/pgmspace.h>           // needed for PROGMEM
+//! The constant tables are stored in flash. Read them with pgm_read_dword() or memcpy_P().
+#   define SHA256_FLASH         PROGMEM
+#else
+#   define SHA256_FLASH
+#endif
+
+
+/** \struct sha256_ctx
+ *  \brief Structure to hold the state of a running SHA-256 calculation
+ *  \var sha256_ctx::hash
+ *       \brief Intermediate hash value of all complete blocks processed so far.
+ *  \var sha256_ctx::total_len
+ *       \brief Number of message bytes passed to sha256_update() so far.
+ *  \var sha256_ctx::block
+ *       \brief Message bytes that do not yet fill a complete block.
+ *  \var sha256_ctx::block_len
+ *       \brief Number of valid bytes in sha256_ctx::block.
+ */
+struct sha256_ctx {
+	uint32_t hash[SHA256_DIGEST_SIZE / sizeof(uint32_t)];
+	uint64_t total_len;
+	uint8_t block[SHA256_BLOCK_SIZE];
+	uint8_t block_len;
+};
+
+
+/** \struct sha256_segment
+ *  \brief Part of a message that is scattered over several buffers
+ *  \var sha256_segment::data
+ *       \brief Pointer to the bytes of this part.
+ *  \var sha256_segment::len
+ *       \brief Number of bytes in this part.
+ */
+struct sha256_segment {
+	const uint8_t *data;
+	uint16_t len;
+};
+
+
+//! initial hash value, also used by the multi-buffer and accelerated kernels
+extern const uint32_t sha256_init_hash[SHA256_DIGEST_SIZE / sizeof(uint32_t)] SHA256_FLASH;
+//! round constants, also used by the multi-buffer and accelerated kernels
+extern const uint32_t sha256_k[SHA256_BLOCK_SIZE] SHA256_FLASH;
+
+
+void sha256_init(struct sha256_ctx *ctx);
+void sha256_init_midstate(struct sha256_ctx *ctx, const uint32_t *midstate, uint32_t block_count);
+void sha256_update(struct sha256_ctx *ctx, uint32_t len, const uint8_t *message);
+void sha256_final(struct sha256_ctx *ctx, uint8_t *digest);
+void sha256(uint32_t len, const uint8_t *message, uint8_t *digest);
+void sha256_update_segments(struct sha256_ctx *ctx, uint8_t count, const struct sha256_segment *segments);
+void sha256_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+
+/** \name Fixed-Length SHA-256
+ *
+ * These functions hash messages of one constant length each, the sizes of the
+ * CryptoAuth command messages. Their padding is resolved at compile time.
+ * The _segments variants hash a message that is scattered over several buffers,
+ * and the _midstate variants hash the rest of a message whose first 64-byte block
+ * is already hashed into a midstate, like the ipad / opad block of HMAC.
+@{ */
+void sha256_39(const uint8_t *message, uint8_t *digest);   //!< DeriveKey MAC message
+void sha256_55(const uint8_t *message, uint8_t *digest);   //!< Nonce message
+void sha256_88(const uint8_t *message, uint8_t *digest);   //!< MAC and CheckMac message
+void sha256_96(const uint8_t *message, uint8_t *digest);   //!< GenDig, DeriveKey, encryption MAC and outer HMAC messages
+void sha256_152(const uint8_t *message, uint8_t *digest);  //!< inner HMAC message
+void sha256_39_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+void sha256_55_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+void sha256_88_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+void sha256_96_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+void sha256_152_segments(uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+void sha256_96_midstate(const uint32_t *midstate, uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+void sha256_152_midstate(const uint32_t *midstate, uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+/** @} */
+
+/** @} */
+
+#endif //SHA256_H
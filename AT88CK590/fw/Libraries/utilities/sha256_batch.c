@@ -0,0 +1,151 @@
+/** \file
+ *  \brief  Multi-Buffer SHA-256 Hash Functions
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#include <string.h>                    // needed for memcpy()
+#include <stdint.h>                    // data type definitions
+
+#include "sha256_batch.h"              // header module for this C module
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+
+
+#ifdef SHA256_BATCH_X86
+
+#define SHA256_BATCH_NAME       sha256_batch_sse4
+#define SHA256_BATCH_TARGET     __attribute__((target("sse4.1")))
+#define SHA256_BATCH_LANES      (4)
+#include "sha256_batch_kernel.h"
+#undef SHA256_BATCH_NAME
+#undef SHA256_BATCH_TARGET
+#undef SHA256_BATCH_LANES
+
+#define SHA256_BATCH_NAME       sha256_batch_avx2
+#define SHA256_BATCH_TARGET     __attribute__((target("avx2")))
+#define SHA256_BATCH_LANES      (8)
+#include "sha256_batch_kernel.h"
+#undef SHA256_BATCH_NAME
+#undef SHA256_BATCH_TARGET
+#undef SHA256_BATCH_LANES
+
+#define SHA256_BATCH_NAME       sha256_batch_avx512
+#define SHA256_BATCH_TARGET     __attribute__((target("avx512f")))
+#define SHA256_BATCH_LANES      (16)
+#include "sha256_batch_kernel.h"
+#undef SHA256_BATCH_NAME
+#undef SHA256_BATCH_TARGET
+#undef SHA256_BATCH_LANES
+
+
+//! type of a multi-buffer kernel function
+typedef void (*sha256_batch_kernel_t)(uint8_t lanes_used, uint32_t len,
+		const uint8_t *const *messages, uint8_t *const *digests);
+
+//! kernel selected by sha256_batch_select(), NULL to hash the messages one at a time
+static sha256_batch_kernel_t sha256_batch_kernel;
+
+//! number of lanes of the selected kernel
+static uint8_t sha256_batch_kernel_lanes = 1;
+
+
+/** \brief This function selects the widest kernel the CPU supports.
+ *
+ * It runs as a constructor before main(), so the kernel is selected before any
+ * thread can call sha256_batch().
+ */
+__attribute__((constructor)) static void sha256_batch_select(void)
+{
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f")) {
+		sha256_batch_kernel = sha256_batch_avx512;
+		sha256_batch_kernel_lanes = 16;
+	}
+	else if (__builtin_cpu_supports("avx2")) {
+		sha256_batch_kernel = sha256_batch_avx2;
+		sha256_batch_kernel_lanes = 8;
+	}
+	else if (__builtin_cpu_supports("sse4.1")) {
+		sha256_batch_kernel = sha256_batch_sse4;
+		sha256_batch_kernel_lanes = 4;
+	}
+}
+
+#endif
+
+
+/** \brief This function returns the number of messages that are hashed in parallel.
+ *
+ * Callers that stage messages in a buffer can use this value as the group size.
+ *
+ * \return number of lanes of the selected kernel, 1 if messages are hashed one at a time
+ */
+uint8_t sha256_batch_lanes(void)
+{
+#ifdef SHA256_BATCH_X86
+	return sha256_batch_kernel_lanes;
+#else
+	return 1;
+#endif
+}
+
+
+/** \brief This function calculates the SHA-256 digests of many messages of the same length.
+ *
+ * \param[in] count number of messages
+ * \param[in] len byte length of every message
+ * \param[in] messages array of count pointers to the messages
+ * \param[out] digests array of count pointers to 32-byte digests
+ */
+void sha256_batch(uint16_t count, uint32_t len, const uint8_t *const *messages, uint8_t *const *digests)
+{
+	uint8_t lanes = sha256_batch_lanes();
+	uint8_t group;
+
+	for (; count; count -= group, messages += group, digests += group) {
+		group = count < lanes ? (uint8_t) count : lanes;
+#ifdef SHA256_BATCH_X86
+		// A single message is hashed faster by the scalar code.
+		if (sha256_batch_kernel && group > 1) {
+			sha256_batch_kernel(group, len, messages, digests);
+			continue;
+		}
+#endif
+		sha256(len, messages[0], digests[0]);
+		group = 1;
+	}
+}
@@ -0,0 +1,72 @@
+/** \file
+ *  \brief  Definitions and Prototypes for the Multi-Buffer SHA-256 Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#ifndef SHA256_BATCH_H
+#   define SHA256_BATCH_H
+
+#include <stdint.h>                    // data type definitions
+
+
+/** \defgroup sha256_batch Multi-Buffer SHA-256 Hash
+ *
+ * \brief
+ * This module hashes many independent messages of the same length at once.
+ * On x86 hosts the messages are processed in parallel SIMD lanes
+ * (4 lanes with SSE4.1, 8 lanes with AVX2, 16 lanes with AVX-512). The widest
+ * kernel the CPU supports is selected at run-time. On all other targets,
+ * or if the CPU supports none of these instruction sets, the messages are
+ * hashed one after the other by the SHA-256 module.
+@{ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+//! The x86 SIMD kernels are built.
+#   define SHA256_BATCH_X86
+//! maximum number of messages hashed in parallel
+#   define SHA256_BATCH_LANES_MAX     (16)
+#else
+#   define SHA256_BATCH_LANES_MAX      (1)
+#endif
+
+
+uint8_t sha256_batch_lanes(void);
+void sha256_batch(uint16_t count, uint32_t len, const uint8_t *const *messages, uint8_t *const *digests);
+
+/** @} */
+
+#endif //SHA256_BATCH_H
@@ -0,0 +1,150 @@
+/** \file
+ *  \brief  Multi-Buffer SHA-256 Kernel Template
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/* This file is included by sha256_batch.c once for every SIMD width. Before
+ * including it, define:
+ *   SHA256_BATCH_NAME    name of the kernel function
+ *   SHA256_BATCH_TARGET  function attribute that enables the instruction set
+ *   SHA256_BATCH_LANES   number of 32-bit lanes in a vector
+ * The kernel uses GCC vector extensions, so the compiler emits the
+ * instructions of the enabled instruction set for all vector operations.
+ */
+
+#define sha256v_rotr(x, n)       (((x) >> (n)) | ((x) << (32 - (n))))
+#define sha256v_ch(x, y, z)      (((x) & (y)) ^ (~(x) & (z)))
+#define sha256v_maj(x, y, z)     (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define sha256v_sum0(x)          (sha256v_rotr(x, 2) ^ sha256v_rotr(x, 13) ^ sha256v_rotr(x, 22))
+#define sha256v_sum1(x)          (sha256v_rotr(x, 6) ^ sha256v_rotr(x, 11) ^ sha256v_rotr(x, 25))
+#define sha256v_sigma0(x)        (sha256v_rotr(x, 7) ^ sha256v_rotr(x, 18) ^ ((x) >> 3))
+#define sha256v_sigma1(x)        (sha256v_rotr(x, 17) ^ sha256v_rotr(x, 19) ^ ((x) >> 10))
+
+
+/** \brief This function hashes up to SHA256_BATCH_LANES messages of the same length in parallel.
+ *
+ * Unused lanes hash a copy of the first message. Their results are discarded.
+ *
+ * \param[in] lanes_used number of messages (1 to SHA256_BATCH_LANES)
+ * \param[in] len byte length of every message
+ * \param[in] messages array of pointers to the messages
+ * \param[out] digests array of pointers to 32-byte digests
+ */
+static SHA256_BATCH_TARGET void SHA256_BATCH_NAME(uint8_t lanes_used, uint32_t len,
+		const uint8_t *const *messages, uint8_t *const *digests)
+{
+	typedef uint32_t vector_t __attribute__((vector_size(SHA256_BATCH_LANES * sizeof(uint32_t))));
+
+	const uint8_t *message[SHA256_BATCH_LANES];
+	uint8_t tail[SHA256_BATCH_LANES][2 * SHA256_BLOCK_SIZE];
+	uint32_t words[16][SHA256_BATCH_LANES];
+	vector_t state[8], w[16];
+	vector_t a, b, c, d, e, f, g, h, t1, t2;
+	uint32_t full_blocks = len / SHA256_BLOCK_SIZE;
+	uint32_t tail_len = len % SHA256_BLOCK_SIZE;
+	uint32_t block_count = full_blocks + (tail_len < SHA256_BLOCK_SIZE - sizeof(uint64_t) ? 1 : 2);
+	uint64_t bit_len = (uint64_t) len << 3;
+	uint32_t block, i;
+	const uint8_t *p;
+	uint8_t lane, j;
+
+	// Pad the last partial block of every lane. Complete blocks are read from the messages.
+	for (lane = 0; lane < SHA256_BATCH_LANES; lane++) {
+		message[lane] = messages[lane < lanes_used ? lane : 0];
+		memset(tail[lane], 0, sizeof(tail[lane]));
+		memcpy(tail[lane], message[lane] + full_blocks * SHA256_BLOCK_SIZE, tail_len);
+		tail[lane][tail_len] = 0x80;
+		for (i = (block_count - full_blocks) * SHA256_BLOCK_SIZE - 1, j = 0; j < sizeof(uint64_t); i--, j++)
+			tail[lane][i] = (uint8_t) (bit_len >> (j << 3));
+	}
+
+	for (i = 0; i < 8; i++)
+		state[i] = (vector_t) {} + sha256_init_hash[i];
+
+	for (block = 0; block < block_count; block++) {
+		// Transpose one block of every lane into the vector words.
+		for (lane = 0; lane < SHA256_BATCH_LANES; lane++) {
+			p = block < full_blocks
+				? message[lane] + block * SHA256_BLOCK_SIZE
+				: tail[lane] + (block - full_blocks) * SHA256_BLOCK_SIZE;
+			for (j = 0; j < 16; j++, p += sizeof(uint32_t))
+				words[j][lane] = ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16)
+					| ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+		}
+		for (j = 0; j < 16; j++)
+			memcpy(&w[j], words[j], sizeof(w[j]));
+
+		a = state[0]; b = state[1]; c = state[2]; d = state[3];
+		e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+		for (i = 0; i < SHA256_BLOCK_SIZE; i++) {
+			// Expand the message schedule in a 16-word ring.
+			if (i >= 16)
+				w[i & 15] += sha256v_sigma1(w[(i - 2) & 15]) + w[(i - 7) & 15] + sha256v_sigma0(w[(i - 15) & 15]);
+
+			t1 = h + sha256v_sum1(e) + sha256v_ch(e, f, g) + sha256_k[i] + w[i & 15];
+			t2 = sha256v_sum0(a) + sha256v_maj(a, b, c);
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+
+		state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+		state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+	}
+
+	// Output the hash of every used lane, MSB of every word first.
+	for (i = 0; i < 8; i++)
+		memcpy(words[i], &state[i], sizeof(state[i]));
+	for (lane = 0; lane < lanes_used; lane++) {
+		for (j = 0; j < SHA256_DIGEST_SIZE; j++)
+			digests[lane][j] = (uint8_t) (words[j >> 2][lane] >> (24 - ((j & 3) << 3)));
+	}
+}
+
+#undef sha256v_rotr
+#undef sha256v_ch
+#undef sha256v_maj
+#undef sha256v_sum0
+#undef sha256v_sum1
+#undef sha256v_sigma0
+#undef sha256v_sigma1
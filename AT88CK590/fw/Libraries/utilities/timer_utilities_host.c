@@ -0,0 +1,140 @@
+/** \file
+ *  \brief  Timer Utility Functions for Hosts
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+#define _POSIX_C_SOURCE 200112L               // needed for clock_nanosleep()
+
+#include <errno.h>                            // needed for EINTR
+#include <stdint.h>                           // data type definitions
+#include <time.h>                             // needed for clock_gettime() and clock_nanosleep()
+#include "timer_utilities_host.h"             // declarations of delay and virtual clock functions
+
+
+/** \ingroup sha204_timer_utilities
+ *
+ * Link this file instead of timer_utilities.c when the libraries run on a host
+ * against a virtual device (see \ref atsha204_virtual_device). The delays advance
+ * a virtual clock in microseconds. Virtual devices in timing-accurate mode advance
+ * it too, by the time their transfers take, and run their execution, wake-up, and
+ * watchdog times on it. timer_host_get_time() reads it, so a host application can
+ * measure the time a command schedule would take on hardware.
+ *
+ * By default the clock is not tied to real time, and the delays return immediately.
+ * timer_host_set_acceleration() ties it to real time, sped up by a factor: the delays
+ * then wait until real time has caught up with virtual time divided by the factor.
+ * The clock wraps around after about 71 minutes.
+@{ */
+
+//! virtual time in us
+static uint32_t timer_host_time;
+
+//! acceleration factor, 0 if virtual time is not tied to real time
+static uint32_t timer_host_acceleration;
+
+//! real time at which virtual time was timer_host_time_start
+static struct timespec timer_host_real_start;
+
+//! virtual time when the acceleration factor was set
+static uint32_t timer_host_time_start;
+
+
+/** \brief This function advances the virtual clock.
+ *
+ * If the clock is tied to real time, the function waits until real time has
+ * caught up.
+ * \param[in] time number of microseconds to advance
+ */
+void timer_host_advance(uint32_t time)
+{
+	struct timespec until;
+	uint64_t elapsed_ns;
+
+	timer_host_time += time;
+	if (!timer_host_acceleration)
+		return;
+
+	elapsed_ns = (uint64_t) (timer_host_time - timer_host_time_start) * 1000 / timer_host_acceleration;
+	until.tv_sec = timer_host_real_start.tv_sec + (time_t) (elapsed_ns / 1000000000);
+	until.tv_nsec = timer_host_real_start.tv_nsec + (long) (elapsed_ns % 1000000000);
+	if (until.tv_nsec >= 1000000000) {
+		until.tv_sec++;
+		until.tv_nsec -= 1000000000;
+	}
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, NULL) == EINTR)
+		;
+}
+
+
+/** \brief This function reads the virtual clock.
+ * \return virtual time in microseconds
+ */
+uint32_t timer_host_get_time(void)
+{
+	return timer_host_time;
+}
+
+
+/** \brief This function ties the virtual clock to real time, or unties it.
+ * \param[in] factor number of virtual microseconds per real microsecond, 0 to untie
+ */
+void timer_host_set_acceleration(uint32_t factor)
+{
+	timer_host_acceleration = factor;
+	timer_host_time_start = timer_host_time;
+	clock_gettime(CLOCK_MONOTONIC, &timer_host_real_start);
+}
+
+
+/** \brief This function advances the virtual clock.
+ * \param[in] delay number of 0.01 milliseconds to delay
+ */
+void delay_10us(uint8_t delay)
+{
+	timer_host_advance((uint32_t) delay * 10);
+}
+
+
+/** \brief This function advances the virtual clock.
+ * \param[in] delay number of milliseconds to delay
+ */
+void delay_ms(uint8_t delay)
+{
+	timer_host_advance((uint32_t) delay * 1000);
+}
+
+/** @} */
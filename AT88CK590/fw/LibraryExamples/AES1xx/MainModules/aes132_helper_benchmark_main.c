@@ -0,0 +1,337 @@
+// ----------------------------------------------------------------------------
+//         ATMEL Crypto-Devices Software Support  -  Colorado Springs, CO -
+// ----------------------------------------------------------------------------
+// DISCLAIMER:  THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+// DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+// OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+/** \file
+ *  \brief  Known-answer tests and benchmark of the AES132 helper functions
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ */
+
+/*
+ * This is a host application, not firmware. It checks the AES-128 module against the
+ * FIPS 197, NIST SP 800-38C and RFC 3610 vectors. Then it lets a set of simulated
+ * devices answer Auth and EncRead commands, formatting their CCM blocks as given in
+ * aes132_helper.h, and checks the responses with aes132h_mac_check() one by one and
+ * with aes132h_mac_check_batch(). It reports the responses per second of both.
+ * Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -ILibraries/aes132_library -ILibraries/utilities
+ *       LibraryExamples/AES1xx/MainModules/aes132_helper_benchmark_main.c
+ *       Libraries/aes132_library/aes132_helper.c Libraries/utilities/aes128.c
+ *       Libraries/utilities/cryptoauth_wipe.c
+ *       -o aes132_helper_benchmark
+ *   ./aes132_helper_benchmark
+ *
+ * Add -DAES128_PORTABLE to measure the portable cipher instead of the AES instructions.
+ * The application returns 1 if a result differs from the expected one.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+
+#include "aes132_helper.h"             // definitions and declarations for the Helper module
+
+
+//! number of simulated devices
+#define AES132_HELPER_BENCHMARK_DEVICES  (4096UL)
+
+//! number of times every device answers
+#define AES132_HELPER_BENCHMARK_ROUNDS   (16)
+
+
+//! one CCM vector
+struct aes132_helper_benchmark_vector {
+	const char *name;
+	uint8_t key[AES128_KEY_SIZE];
+	uint8_t nonce_len;
+	uint8_t nonce[13];
+	uint8_t aad_len;
+	uint8_t aad[16];
+	uint8_t len;
+	uint8_t plain[32];
+	uint8_t tag_len;
+	uint8_t cipher[48];            //!< ciphertext followed by tag
+};
+
+//! CCM vectors of NIST SP 800-38C, appendix C, and of RFC 3610, packet vector 1
+static const struct aes132_helper_benchmark_vector aes132_helper_benchmark_vectors[] = {
+	{
+		"SP 800-38C C.1",
+		{0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F},
+		7, {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16},
+		8, {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07},
+		4, {0x20, 0x21, 0x22, 0x23},
+		4, {0x71, 0x62, 0x01, 0x5B, 0x4D, 0xAC, 0x25, 0x5D}
+	},
+	{
+		"SP 800-38C C.2",
+		{0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F},
+		8, {0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17},
+		16, {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F},
+		16, {0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F},
+		6, {0xD2, 0xA1, 0xF0, 0xE0, 0x51, 0xEA, 0x5F, 0x62, 0x08, 0x1A, 0x77, 0x92, 0x07, 0x3D, 0x59, 0x3D,
+			0x1F, 0xC6, 0x4F, 0xBF, 0xAC, 0xCD}
+	},
+	{
+		"RFC 3610 #1",
+		{0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF},
+		13, {0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5},
+		8, {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07},
+		23, {0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+			0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E},
+		8, {0x58, 0x8C, 0x97, 0x9A, 0x61, 0xC6, 0x63, 0xD2, 0xF0, 0x66, 0xD0, 0xC2, 0xC0, 0xF9, 0x89, 0x80,
+			0x6D, 0x5F, 0x6B, 0x61, 0xDA, 0xC3, 0x84, 0x17, 0xE8, 0xD1, 0x2C, 0xFD, 0xF9, 0x26, 0xE0}
+	}
+};
+
+
+//! state of a simulated device
+struct aes132_helper_benchmark_device {
+	struct aes128_key key;
+	struct aes132h_nonce nonce;    //!< nonce register of the device
+	struct aes132h_nonce host;     //!< host copy of the nonce register
+	uint8_t memory[AES132H_DATA_SIZE_MAX];
+};
+
+//! ManufacturingID of the simulated devices
+static const uint8_t aes132_helper_benchmark_manufacturing_id[AES132H_MANUFACTURING_ID_SIZE] = {0x00, 0xEE};
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double aes132_helper_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function checks the cipher and CCM against the published vectors.
+ * \return 0 if all vectors pass, 1 otherwise
+ */
+static int aes132_helper_benchmark_known_answers(void)
+{
+	static const uint8_t fips_key[AES128_KEY_SIZE] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+	};
+	static const uint8_t fips_plain[AES128_BLOCK_SIZE] = {
+		0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+	};
+	static const uint8_t fips_cipher[AES128_BLOCK_SIZE] = {
+		0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A
+	};
+	const struct aes132_helper_benchmark_vector *vector;
+	struct aes128_key key;
+	uint8_t out[48], tag[16];
+	uint8_t i;
+	int ret_code = 0;
+
+	aes128_key_init(&key, fips_key);
+	aes128_encrypt(&key, fips_plain, out);
+	printf("%-16s %s\n", "FIPS 197 C.1", memcmp(out, fips_cipher, AES128_BLOCK_SIZE) ? "FAILED" : "passed");
+	if (memcmp(out, fips_cipher, AES128_BLOCK_SIZE))
+		ret_code = 1;
+
+	for (i = 0; i < sizeof(aes132_helper_benchmark_vectors) / sizeof(aes132_helper_benchmark_vectors[0]); i++) {
+		vector = &aes132_helper_benchmark_vectors[i];
+		aes128_key_init(&key, vector->key);
+
+		aes128_ccm_encrypt(&key, vector->nonce_len, vector->nonce, vector->aad_len, vector->aad,
+					vector->len, vector->plain, out, vector->tag_len, tag);
+		if (memcmp(out, vector->cipher, vector->len) || memcmp(tag, &vector->cipher[vector->len], vector->tag_len)) {
+			printf("%-16s encryption FAILED\n", vector->name);
+			ret_code = 1;
+			continue;
+		}
+
+		aes128_ccm_decrypt(&key, vector->nonce_len, vector->nonce, vector->aad_len, vector->aad,
+					vector->len, vector->cipher, out, vector->tag_len, tag);
+		if (memcmp(out, vector->plain, vector->len) || memcmp(tag, &vector->cipher[vector->len], vector->tag_len)) {
+			printf("%-16s decryption FAILED\n", vector->name);
+			ret_code = 1;
+			continue;
+		}
+		printf("%-16s passed\n", vector->name);
+	}
+
+	return ret_code;
+}
+
+
+/** \brief This function lets a simulated device answer an Auth or EncRead command.
+ *
+ * It formats the CCM blocks on its own, as given in aes132_helper.h, instead of
+ * calling the helper functions.
+ *
+ * \param[in,out] device simulated device
+ * \param[in] encrypted_read 1: EncRead of 32 bytes, 0: Auth with output MAC
+ * \param[out] data encrypted memory contents (EncRead only)
+ * \param[out] mac output MAC
+ */
+static void aes132_helper_benchmark_respond(struct aes132_helper_benchmark_device *device, uint8_t encrypted_read,
+			uint8_t *data, uint8_t *mac)
+{
+	uint8_t ccm_nonce[AES132H_NONCE_SIZE + 1];
+	uint8_t aad[14] = {0};
+
+	memcpy(ccm_nonce, device->nonce.value, AES132H_NONCE_SIZE);
+	ccm_nonce[AES132H_NONCE_SIZE] = device->nonce.mac_count++;
+
+	aad[0] = aes132_helper_benchmark_manufacturing_id[0];
+	aad[1] = aes132_helper_benchmark_manufacturing_id[1];
+	aad[2] = encrypted_read ? 0x04 : 0x03;       // EncRead or Auth op-code
+	aad[3] = encrypted_read ? 0x00 : 0x02;       // Auth mode: output MAC
+	aad[5] = encrypted_read ? 0x40 : 0x01;       // memory address or key ID
+	aad[7] = encrypted_read ? AES132H_DATA_SIZE_MAX : 0x00;
+	aad[8] = AES132H_MAC_FLAG_DEVICE | AES132H_MAC_FLAG_RANDOM;
+
+	aes128_ccm_encrypt(&device->key, sizeof(ccm_nonce), ccm_nonce, sizeof(aad), aad,
+				encrypted_read ? AES132H_DATA_SIZE_MAX : 0, device->memory, data, AES132H_MAC_SIZE, mac);
+}
+
+
+/** \brief This function checks the helper functions against simulated devices and measures them.
+ * @return exit status of application, 1 if a result differs
+ */
+int main(void)
+{
+	struct aes132_helper_benchmark_device *devices = malloc(AES132_HELPER_BENCHMARK_DEVICES * sizeof(*devices));
+	struct aes132h_mac_in_out *params = malloc(AES132_HELPER_BENCHMARK_DEVICES * sizeof(*params));
+	uint8_t (*data)[AES132H_DATA_SIZE_MAX] = malloc(AES132_HELPER_BENCHMARK_DEVICES * sizeof(*data));
+	uint8_t (*clear)[AES132H_DATA_SIZE_MAX] = malloc(AES132_HELPER_BENCHMARK_DEVICES * sizeof(*clear));
+	uint8_t (*macs)[AES132H_MAC_SIZE] = malloc(AES132_HELPER_BENCHMARK_DEVICES * sizeof(*macs));
+	uint8_t *results = malloc(AES132_HELPER_BENCHMARK_DEVICES);
+	struct aes132h_nonce_in_out nonce_param;
+	uint8_t key[AES128_KEY_SIZE], in_seed[AES132H_IN_SEED_SIZE], rand_out[AES132H_RAND_OUT_SIZE];
+	uint8_t mac[AES132H_MAC_SIZE];
+	uint32_t i, j, failed;
+	uint8_t round, batch, expected;
+	double elapsed[2] = {0, 0}, start;
+	int ret_code;
+
+	if (!devices || !params || !data || !clear || !macs || !results) {
+		printf("out of memory\n");
+		return 1;
+	}
+
+	ret_code = aes132_helper_benchmark_known_answers();
+
+	// Every device gets its own key, memory contents and random nonce.
+	for (i = 0; i < AES132_HELPER_BENCHMARK_DEVICES; i++) {
+		for (j = 0; j < AES128_KEY_SIZE; j++) {
+			key[j] = (uint8_t) (i * 29 + j * 7 + 1);
+			rand_out[j] = (uint8_t) (i * 13 + j * 3 + 5);
+		}
+		for (j = 0; j < AES132H_IN_SEED_SIZE; j++)
+			in_seed[j] = (uint8_t) (i + j * 11);
+		for (j = 0; j < AES132H_DATA_SIZE_MAX; j++)
+			devices[i].memory[j] = (uint8_t) (i * 3 + j);
+		aes128_key_init(&devices[i].key, key);
+
+		nonce_param.mode = AES132H_NONCE_MODE_RANDOM;
+		nonce_param.in_seed = in_seed;
+		nonce_param.rand_out = rand_out;
+		nonce_param.nonce = &devices[i].host;
+		if (aes132h_nonce(&nonce_param) != AES132_FUNCTION_RETCODE_SUCCESS) {
+			printf("nonce FAILED\n");
+			return 1;
+		}
+		devices[i].nonce = devices[i].host;
+	}
+
+	/* Every round, all devices answer one command, alternately Auth and EncRead.
+	 * Every 16th response is corrupted. Odd rounds are checked in a batch. */
+	for (round = 0, failed = 0; round < AES132_HELPER_BENCHMARK_ROUNDS; round++) {
+		batch = round & 1;
+		for (i = 0; i < AES132_HELPER_BENCHMARK_DEVICES; i++) {
+			aes132_helper_benchmark_respond(&devices[i], (uint8_t) ((i + round) & 1), data[i], macs[i]);
+			if (((i + round) & 0x0F) == 0x0F)
+				macs[i][i % AES132H_MAC_SIZE] ^= 0x10;
+
+			params[i].key = &devices[i].key;
+			params[i].nonce = &devices[i].host;
+			params[i].manufacturing_id = aes132_helper_benchmark_manufacturing_id;
+			params[i].opcode = ((i + round) & 1) ? 0x04 : 0x03;
+			params[i].mode = ((i + round) & 1) ? 0x00 : 0x02;
+			params[i].param1 = ((i + round) & 1) ? 0x0040 : 0x0001;
+			params[i].param2 = ((i + round) & 1) ? AES132H_DATA_SIZE_MAX : 0x0000;
+			params[i].data_len = ((i + round) & 1) ? AES132H_DATA_SIZE_MAX : 0;
+			params[i].in_data = data[i];
+			params[i].out_data = clear[i];
+			params[i].mac = macs[i];
+		}
+
+		start = aes132_helper_benchmark_now();
+		if (batch)
+			aes132h_mac_check_batch(AES132_HELPER_BENCHMARK_DEVICES, params, results);
+		else
+			for (i = 0; i < AES132_HELPER_BENCHMARK_DEVICES; i++)
+				results[i] = aes132h_mac_check(&params[i]);
+		elapsed[batch] += aes132_helper_benchmark_now() - start;
+
+		for (i = 0; i < AES132_HELPER_BENCHMARK_DEVICES; i++) {
+			expected = (((i + round) & 0x0F) == 0x0F)
+					? AES132_FUNCTION_RETCODE_MAC_MISMATCH : AES132_FUNCTION_RETCODE_SUCCESS;
+			if (results[i] != expected || devices[i].host.mac_count != devices[i].nonce.mac_count
+						|| (expected == AES132_FUNCTION_RETCODE_SUCCESS && params[i].data_len
+						&& memcmp(clear[i], devices[i].memory, AES132H_DATA_SIZE_MAX)))
+				failed++;
+		}
+	}
+
+	// The batch of inbound MACs has to match the single calls.
+	for (i = 0; i < AES132_HELPER_BENCHMARK_DEVICES; i++) {
+		params[i].in_data = devices[i].memory;
+		params[i].out_data = data[i];
+		params[i].opcode = 0x05;             // EncWrite
+	}
+	aes132h_mac_compute_batch(AES132_HELPER_BENCHMARK_DEVICES, params, results);
+	for (i = 0; i < AES132_HELPER_BENCHMARK_DEVICES; i++) {
+		devices[i].host.mac_count--;
+		params[i].out_data = clear[i];
+		params[i].mac = mac;
+		if (results[i] != AES132_FUNCTION_RETCODE_SUCCESS
+					|| aes132h_mac_compute(&params[i]) != AES132_FUNCTION_RETCODE_SUCCESS
+					|| memcmp(mac, macs[i], AES132H_MAC_SIZE)
+					|| (params[i].data_len && memcmp(clear[i], data[i], params[i].data_len)))
+			failed++;
+	}
+
+	if (failed) {
+		printf("%lu responses FAILED\n", (unsigned long) failed);
+		ret_code = 1;
+	}
+	else {
+		printf("%-16s %12s %10s\n", "method", "responses/s", "speedup");
+		printf("%-16s %12.0f %10.2f\n", "single", AES132_HELPER_BENCHMARK_DEVICES * AES132_HELPER_BENCHMARK_ROUNDS / 2 / elapsed[0], 1.0);
+		printf("%-16s %12.0f %10.2f\n", "batch", AES132_HELPER_BENCHMARK_DEVICES * AES132_HELPER_BENCHMARK_ROUNDS / 2 / elapsed[1],
+				elapsed[0] / elapsed[1]);
+	}
+
+	free(results);
+	free(macs);
+	free(clear);
+	free(data);
+	free(params);
+	free(devices);
+
+	return ret_code;
+}
@@ -0,0 +1,407 @@
+// ----------------------------------------------------------------------------
+//         ATMEL Crypto-Devices Software Support  -  Colorado Springs, CO -
+// ----------------------------------------------------------------------------
+// DISCLAIMER:  THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+// DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+// OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+// EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+/** \file
+ *  \brief  Host application that profiles the polling and retry logic of the AES132 library
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ */
+
+/*
+ * This is a host application, not firmware. It attaches a virtual AES132 device and
+ * runs the unmodified Communication layer (aes132.c) and Command module against it.
+ * It checks memory writes and reads, the commands the model executes, device errors,
+ * CRC errors, Sleep / Standby wake-up, and timeouts. Then it reports, for every kind
+ * of access, how many commands per second the host executes, the bus time a command
+ * takes, and how often the library polls the device status register and gets nacked.
+ * Last, it injects every kind of bus fault at increasing rates and reports how the bus
+ * time and throughput of BlockRead degrade while aes132c_receive_response() and
+ * aes132c_access_memory() retry and resynchronize.
+ * Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -DAES132_VIRTUAL -ILibraries/aes132_library -ILibraries/utilities
+ *       LibraryExamples/AES1xx/MainModules/aes132_virtual_device_benchmark_main.c
+ *       Libraries/aes132_library/aes132_virtual_device.c Libraries/aes132_library/aes132.c
+ *       Libraries/aes132_library/aes132_commands.c Libraries/aes132_library/aes132_helper.c
+ *       Libraries/utilities/aes128.c Libraries/utilities/fault_injection.c
+ *       Libraries/utilities/cryptoauth_wipe.c
+ *       -o aes132_virtual_device_benchmark
+ *   ./aes132_virtual_device_benchmark
+ *
+ * The application returns 1 if a result differs from the expected one.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+
+#include "aes132_commands.h"           // definitions and declarations for the Command module
+
+
+//! ID of the device
+#define AES132_VIRTUAL_BENCHMARK_ID         (AES132D_DEFAULT_ID)
+
+//! ID no device is attached under
+#define AES132_VIRTUAL_BENCHMARK_ID_MISSING ((uint8_t) 0xB0)
+
+//! number of commands per measurement
+#define AES132_VIRTUAL_BENCHMARK_COMMANDS   (20000)
+
+//! number of commands per fault type and rate
+#define AES132_VIRTUAL_BENCHMARK_FAULT_COMMANDS (2000)
+
+//! fault rates in parts of FAULT_RATE_SCALE
+static const uint16_t aes132_virtual_benchmark_fault_rates[] = {0, 50, 100, 200, 500, 1000, 2000};
+
+//! names of the fault types
+static const char *aes132_virtual_benchmark_fault_names[FAULT_TYPE_COUNT] = {
+	"CRC flip", "ACK drop", "count cut", "0xFF sync"
+};
+
+
+//! kinds of accesses that are measured
+enum aes132_virtual_benchmark_access {
+	AES132_VIRTUAL_BENCHMARK_INFO,
+	AES132_VIRTUAL_BENCHMARK_BLOCK_READ,
+	AES132_VIRTUAL_BENCHMARK_RANDOM,
+	AES132_VIRTUAL_BENCHMARK_NONCE,
+	AES132_VIRTUAL_BENCHMARK_TEMP_SENSE,
+	AES132_VIRTUAL_BENCHMARK_MEMORY_READ,
+	AES132_VIRTUAL_BENCHMARK_MEMORY_WRITE,
+	AES132_VIRTUAL_BENCHMARK_ACCESS_COUNT
+};
+
+//! names of the accesses
+static const char *aes132_virtual_benchmark_names[AES132_VIRTUAL_BENCHMARK_ACCESS_COUNT] = {
+	"Info", "BlockRead 32", "Random", "Nonce random", "TempSense", "memory read 32", "memory write 32"
+};
+
+//! the virtual device
+static struct aes132d_device aes132_virtual_benchmark_device;
+
+//! number of failed checks
+static int aes132_virtual_benchmark_failures;
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double aes132_virtual_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function records the result of a check.
+ * \param[in] name name of the check
+ * \param[in] passed whether the check passed
+ */
+static void aes132_virtual_benchmark_check(const char *name, int passed)
+{
+	printf("%-44s %s\n", name, passed ? "ok" : "FAILED");
+	if (!passed)
+		aes132_virtual_benchmark_failures++;
+}
+
+
+/** \brief This function runs one access.
+ * \param[in] access one of #aes132_virtual_benchmark_access
+ * \param[in] index number of the access, varies the address and data
+ * \return status of the operation
+ */
+static uint8_t aes132_virtual_benchmark_access(uint8_t access, uint32_t index)
+{
+	uint8_t in_seed[AES132H_IN_SEED_SIZE];
+	uint8_t data[AES132_MEM_ACCESS_MAX];
+	uint8_t command[AES132_COMMAND_SIZE_MAX];
+	uint8_t response[AES132_RESPONSE_SIZE_MAX];
+	uint16_t word_address = (uint16_t) ((index * AES132_MEM_ACCESS_MAX) % AES132D_USER_MEMORY_SIZE);
+	uint16_t temp_diff;
+
+	switch (access) {
+	case AES132_VIRTUAL_BENCHMARK_INFO:
+		return aes132m_info(AES132_INFO_MAC_COUNT, response);
+
+	case AES132_VIRTUAL_BENCHMARK_BLOCK_READ:
+		return aes132m_block_read(word_address, AES132_MEM_ACCESS_MAX, response);
+
+	case AES132_VIRTUAL_BENCHMARK_RANDOM:
+		return aes132m_execute(AES132_OPCODE_RANDOM, 0, 0, 0, 0, NULL, 0, NULL, 0, NULL, 0, NULL, command, response);
+
+	case AES132_VIRTUAL_BENCHMARK_NONCE:
+		memset(in_seed, (uint8_t) index, sizeof(in_seed));
+		return aes132m_execute(AES132_OPCODE_NONCE, AES132H_NONCE_MODE_RANDOM, 0, 0,
+					sizeof(in_seed), in_seed, 0, NULL, 0, NULL, 0, NULL, command, response);
+
+	case AES132_VIRTUAL_BENCHMARK_TEMP_SENSE:
+		return aes132m_temp_sense(&temp_diff);
+
+	case AES132_VIRTUAL_BENCHMARK_MEMORY_READ:
+		return aes132c_read_memory(AES132_MEM_ACCESS_MAX, word_address, data);
+
+	default:
+		memset(data, (uint8_t) index, sizeof(data));
+		return aes132c_write_memory(AES132_MEM_ACCESS_MAX, word_address, data);
+	}
+}
+
+
+/** \brief This function measures the accesses and prints the results.
+ *
+ * The bus time, polls, and nacks are those of the virtual bus. They are the time and
+ * status register accesses a command would take on a 400 kHz I2C bus.
+ */
+static void aes132_virtual_benchmark_profile(void)
+{
+	struct aes132d_device *device = &aes132_virtual_benchmark_device;
+	struct aes132d_statistics *statistics = &device->statistics;
+	uint32_t bus_time;
+	uint32_t count;
+	uint32_t n;
+	uint8_t access;
+	uint8_t ret_code;
+	double start;
+	double seconds;
+
+	printf("\n%-16s %12s %12s %10s %10s %10s\n", "access", "commands/s", "bus us/cmd",
+				"polls/cmd", "nacks/cmd", "resyncs");
+	for (access = 0; access < AES132_VIRTUAL_BENCHMARK_ACCESS_COUNT; access++) {
+		// TempSense takes long on the virtual bus. It is repeated less often.
+		count = (access == AES132_VIRTUAL_BENCHMARK_TEMP_SENSE
+					? AES132_VIRTUAL_BENCHMARK_COMMANDS / 10 : AES132_VIRTUAL_BENCHMARK_COMMANDS);
+		memset(statistics, 0, sizeof(*statistics));
+		bus_time = aes132d_get_time();
+		ret_code = AES132_FUNCTION_RETCODE_SUCCESS;
+
+		start = aes132_virtual_benchmark_now();
+		for (n = 0; n < count && ret_code == AES132_FUNCTION_RETCODE_SUCCESS; n++)
+			ret_code = aes132_virtual_benchmark_access(access, n);
+		seconds = aes132_virtual_benchmark_now() - start;
+		bus_time = aes132d_get_time() - bus_time;
+
+		if (ret_code != AES132_FUNCTION_RETCODE_SUCCESS) {
+			printf("%-16s failed with 0x%02X\n", aes132_virtual_benchmark_names[access], ret_code);
+			aes132_virtual_benchmark_failures++;
+			continue;
+		}
+		printf("%-16s %12.0f %12.0f %10.1f %10.1f %10lu\n", aes132_virtual_benchmark_names[access],
+					count / seconds, (double) bus_time / count,
+					(double) (statistics->status_reads + statistics->nacks) / count,
+					(double) statistics->nacks / count, (unsigned long) statistics->resyncs);
+	}
+}
+
+
+/** \brief This function measures BlockRead with bus faults and prints the results.
+ *
+ * A command fails if the Communication layer gives up. Bus time and throughput are
+ * those of the commands that succeed. Data that differ from user memory count as
+ * a check failure.
+ */
+static void aes132_virtual_benchmark_faults(void)
+{
+	struct aes132d_device *device = &aes132_virtual_benchmark_device;
+	struct aes132d_statistics *statistics = &device->statistics;
+	struct fault_injector injector;
+	uint8_t response[AES132_RESPONSE_SIZE_MAX];
+	uint16_t word_address;
+	uint32_t bus_time, command_start, total_start;
+	uint32_t n, failed, wrong;
+	uint8_t type, rate;
+	uint8_t ret_code;
+
+	printf("\n%-10s %7s %12s %12s %12s %10s %8s\n", "fault", "rate", "bus us/cmd", "commands/s",
+				"resyncs/cmd", "faults", "failed");
+	for (type = 0; type < FAULT_TYPE_COUNT; type++) {
+		for (rate = 0; rate < sizeof(aes132_virtual_benchmark_fault_rates) / sizeof(aes132_virtual_benchmark_fault_rates[0]); rate++) {
+			fault_init(&injector, 0x5EED + type);
+			injector.rate[type] = aes132_virtual_benchmark_fault_rates[rate];
+			aes132d_set_fault_injector(&injector);
+			memset(statistics, 0, sizeof(*statistics));
+			failed = wrong = 0;
+			bus_time = 0;
+			total_start = aes132d_get_time();
+			for (n = 0; n < AES132_VIRTUAL_BENCHMARK_FAULT_COMMANDS; n++) {
+				word_address = (uint16_t) ((n * AES132_MEM_ACCESS_MAX) % AES132D_USER_MEMORY_SIZE);
+				command_start = aes132d_get_time();
+				ret_code = aes132m_block_read(word_address, AES132_MEM_ACCESS_MAX, response);
+				if (ret_code != AES132_FUNCTION_RETCODE_SUCCESS) {
+					failed++;
+					continue;
+				}
+				bus_time += aes132d_get_time() - command_start;
+				if (memcmp(&response[AES132_RESPONSE_INDEX_DATA], &device->memory[word_address], AES132_MEM_ACCESS_MAX))
+					wrong++;
+			}
+			aes132d_set_fault_injector(NULL);
+			if (!rate)
+				aes132_virtual_benchmark_check("BlockRead without faults", !failed && !wrong);
+			else if (wrong)
+				aes132_virtual_benchmark_check("corrupted BlockRead is not accepted", 0);
+			n = AES132_VIRTUAL_BENCHMARK_FAULT_COMMANDS - failed;
+			printf("%-10s %6.1f%% %12.0f %12.0f %12.2f %10lu %8lu\n", aes132_virtual_benchmark_fault_names[type],
+						aes132_virtual_benchmark_fault_rates[rate] * 100.0 / FAULT_RATE_SCALE,
+						n ? (double) bus_time / n : 0, n * 1e6 / (aes132d_get_time() - total_start),
+						(double) statistics->resyncs / AES132_VIRTUAL_BENCHMARK_FAULT_COMMANDS,
+						(unsigned long) injector.injected[type], (unsigned long) failed);
+		}
+	}
+}
+
+
+/** \brief This function is the entry function of the application.
+ * \return 0 if all checks passed, 1 otherwise
+ */
+int main(void)
+{
+	struct aes132d_device *device = &aes132_virtual_benchmark_device;
+	const uint8_t seed[AES128_KEY_SIZE] = {0x5E, 0xED};
+	uint8_t tx_buffer_write[] = {0x55, 0xAA, 0xBC, 0xDE};
+	uint8_t in_seed[AES132H_IN_SEED_SIZE] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C};
+	uint8_t command[AES132_COMMAND_SIZE_MAX];
+	uint8_t response[AES132_RESPONSE_SIZE_MAX];
+	uint8_t random[AES132D_RANDOM_SIZE];
+	struct aes132h_nonce nonce;
+	struct aes132h_nonce_in_out nonce_param;
+	uint16_t temp_diff;
+	uint32_t bus_time;
+	uint8_t ret_code;
+
+	aes132d_device_init(device, seed);
+	aes132d_attach(AES132_VIRTUAL_BENCHMARK_ID, device);
+	aes132p_enable_interface();
+	aes132p_select_device(AES132_VIRTUAL_BENCHMARK_ID);
+
+	// ----------------------- commands and memory map -----------------------
+	ret_code = aes132m_info(AES132_INFO_CHIP_STATE, response);
+	aes132_virtual_benchmark_check("Info reports power-up state",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS
+				&& response[AES132_RESPONSE_INDEX_DATA] == 0xFF && response[AES132_RESPONSE_INDEX_DATA + 1] == 0xFF);
+
+	ret_code = aes132m_info(AES132_INFO_DEV_NUM, response);
+	aes132_virtual_benchmark_check("Info reports device number",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS
+				&& response[AES132_RESPONSE_INDEX_DATA] == (AES132D_DEV_NUM >> 8)
+				&& response[AES132_RESPONSE_INDEX_DATA + 1] == (AES132D_DEV_NUM & 0xFF));
+
+	memset(&device->statistics, 0, sizeof(device->statistics));
+	ret_code = aes132c_write_memory(sizeof(tx_buffer_write), 0x0000, tx_buffer_write);
+	aes132_virtual_benchmark_check("memory write is nacked while writing",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS && device->statistics.nacks > 0
+				&& device->statistics.memory_writes == 1);
+
+	ret_code = aes132c_read_memory(sizeof(tx_buffer_write), 0x0000, response);
+	aes132_virtual_benchmark_check("memory read returns written data",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS && !memcmp(response, tx_buffer_write, sizeof(tx_buffer_write)));
+
+	ret_code = aes132m_block_read(0x0000, sizeof(tx_buffer_write), response);
+	aes132_virtual_benchmark_check("BlockRead returns written data",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS
+				&& !memcmp(&response[AES132_RESPONSE_INDEX_DATA], tx_buffer_write, sizeof(tx_buffer_write)));
+
+	ret_code = aes132c_write_memory(sizeof(tx_buffer_write), AES132D_PAGE_SIZE - 2, tx_buffer_write);
+	aes132_virtual_benchmark_check("write across page returns boundary error",
+				ret_code == AES132_DEVICE_RETCODE_BOUNDARY_ERROR);
+
+	ret_code = aes132m_block_read(AES132D_USER_MEMORY_SIZE, 4, response);
+	aes132_virtual_benchmark_check("BlockRead past user memory is bad address",
+				ret_code == AES132_DEVICE_RETCODE_BAD_ADDR);
+
+	ret_code = aes132m_execute(AES132_OPCODE_AUTH, 0, 0, 0, 0, NULL, 0, NULL, 0, NULL, 0, NULL, command, response);
+	aes132_virtual_benchmark_check("unmodeled op-code returns parse error",
+				ret_code == AES132_DEVICE_RETCODE_PARSE_ERROR);
+
+	ret_code = aes132m_execute(AES132_OPCODE_RANDOM, 0, 0, 0, 0, NULL, 0, NULL, 0, NULL, 0, NULL, command, response);
+	memcpy(random, &response[AES132_RESPONSE_INDEX_DATA], sizeof(random));
+	ret_code |= aes132m_execute(AES132_OPCODE_RANDOM, 0, 0, 0, 0, NULL, 0, NULL, 0, NULL, 0, NULL, command, response);
+	aes132_virtual_benchmark_check("Random returns new numbers",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS
+				&& response[AES132_RESPONSE_INDEX_COUNT] == AES132_RESPONSE_SIZE_MIN + AES132D_RANDOM_SIZE
+				&& memcmp(random, &response[AES132_RESPONSE_INDEX_DATA], sizeof(random)));
+
+	ret_code = aes132m_execute(AES132_OPCODE_NONCE, AES132H_NONCE_MODE_RANDOM, 0, 0,
+				sizeof(in_seed), in_seed, 0, NULL, 0, NULL, 0, NULL, command, response);
+	nonce_param.mode = AES132H_NONCE_MODE_RANDOM;
+	nonce_param.in_seed = in_seed;
+	nonce_param.rand_out = &response[AES132_RESPONSE_INDEX_DATA];
+	nonce_param.nonce = &nonce;
+	(void) aes132h_nonce(&nonce_param);
+	aes132_virtual_benchmark_check("Nonce matches host calculation",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS && device->nonce.valid && device->nonce.random
+				&& !memcmp(device->nonce.value, nonce.value, sizeof(nonce.value)));
+
+	ret_code = aes132m_temp_sense(&temp_diff);
+	aes132_virtual_benchmark_check("TempSense returns temperature codes",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS && temp_diff == AES132D_TEMP_CODE_HIGH - AES132D_TEMP_CODE_LOW);
+
+	// ----------------------- CRC errors -----------------------
+	memset(&device->statistics, 0, sizeof(device->statistics));
+	aes132m_execute(AES132_OPCODE_INFO, 0, AES132_INFO_MAC_COUNT, 0, 0, NULL, 0, NULL, 0, NULL, 0, NULL, command, response);
+	command[AES132_COMMAND_SIZE_MIN - 1] ^= 0x01;
+	ret_code = aes132c_send_command(command, AES132_OPTION_NO_APPEND_CRC);
+	aes132_virtual_benchmark_check("bad CRC is retried and reported",
+				ret_code == AES132_FUNCTION_RETCODE_BAD_CRC_TX
+				&& device->statistics.crc_errors == AES132_RETRY_COUNT_ERROR);
+
+	ret_code = aes132m_info(AES132_INFO_MAC_COUNT, response);
+	aes132_virtual_benchmark_check("next command clears CRC bit",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS && !(device->status & AES132_CRC_ERROR_BIT));
+
+	// ----------------------- Sleep and Standby -----------------------
+	memset(&device->statistics, 0, sizeof(device->statistics));
+	ret_code = aes132c_standby();
+	ret_code |= aes132c_wakeup();
+	aes132_virtual_benchmark_check("Standby keeps nonce",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS && device->statistics.wakeups == 1 && device->nonce.valid);
+
+	ret_code = aes132c_sleep();
+	ret_code |= aes132c_wakeup();
+	ret_code |= aes132m_info(AES132_INFO_CHIP_STATE, response);
+	aes132_virtual_benchmark_check("Sleep loses nonce, Info reports wake-up",
+				ret_code == AES132_FUNCTION_RETCODE_SUCCESS && device->statistics.wakeups == 2 && !device->nonce.valid
+				&& response[AES132_RESPONSE_INDEX_DATA] == 0x55 && response[AES132_RESPONSE_INDEX_DATA + 1] == 0x55);
+
+	// ----------------------- timeouts -----------------------
+	memset(&device->statistics, 0, sizeof(device->statistics));
+	device->execution_time[AES132_OPCODE_TEMP_SENSE] = 1000000;
+	bus_time = aes132d_get_time();
+	ret_code = aes132m_temp_sense(&temp_diff);
+	bus_time = aes132d_get_time() - bus_time;
+	aes132_virtual_benchmark_check("too slow TempSense times out",
+				ret_code == AES132_FUNCTION_RETCODE_TIMEOUT && device->statistics.resyncs > 0);
+	printf("  gave up after %lu ms of polling and %lu resyncs\n",
+				(unsigned long) (bus_time / 1000), (unsigned long) device->statistics.resyncs);
+
+	aes132p_select_device(AES132_VIRTUAL_BENCHMARK_ID_MISSING);
+	bus_time = aes132d_get_time();
+	ret_code = aes132m_info(AES132_INFO_MAC_COUNT, response);
+	bus_time = aes132d_get_time() - bus_time;
+	aes132_virtual_benchmark_check("missing device times out", ret_code == AES132_FUNCTION_RETCODE_TIMEOUT);
+	printf("  gave up after %lu ms of polling\n", (unsigned long) (bus_time / 1000));
+	aes132p_select_device(AES132_VIRTUAL_BENCHMARK_ID);
+
+	// Start the profile with default execution times and an idle device.
+	aes132d_device_init(device, seed);
+	aes132_virtual_benchmark_profile();
+	aes132_virtual_benchmark_faults();
+
+	aes132p_disable_interface();
+
+	return aes132_virtual_benchmark_failures ? 1 : 0;
+}
@@ -39,6 +39,7 @@
  */
 
 #include <stdint.h>          // data type definitions
+#include <stddef.h>          // NULL definition
 
 #include "swi_phys.h"        // hardware dependent declarations for SWI
 #include "bitbang_config.h"  // non-portable macro definitions
@@ -163,6 +164,22 @@ uint8_t swi_send_byte(uint8_t value)
  * \return status of the operation
  */
 uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
+	return swi_receive_bytes_crc(count, buffer, NULL);
+}
+
+
+/** \brief This GPIO function receives bytes from an SWI device
+ *         and calculates their CRC.
+ *
+ * Every byte is folded into the CRC after its last bit has been sampled.
+ * This fits into the idle time before the start pulse of the next bit,
+ * so the CRC is complete when the last byte has arrived.
+ *  \param[in] count number of bytes to receive
+ *  \param[out] buffer pointer to rx buffer
+ *  \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t swi_receive_bytes_crc(uint8_t count, uint8_t *buffer, struct cryptoauth_crc_rx *crc) {
 	uint8_t status = SWI_FUNCTION_RETCODE_SUCCESS;
 	uint8_t i;
 	uint8_t bit_mask;
@@ -253,6 +270,9 @@ uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
 
 		if (status != SWI_FUNCTION_RETCODE_SUCCESS)
 			break;
+
+		if (crc)
+			cryptoauth_crc_rx_byte(crc, buffer[i]);
 	}
 	swi_enable_interrupts();
 
@@ -368,6 +388,8 @@ uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
 
 			DEBUG_LOW;
 		}
+		if (crc && (status == SWI_FUNCTION_RETCODE_SUCCESS))
+			cryptoauth_crc_rx_byte(crc, buffer[i]);
 	}
 	swi_enable_interrupts();
 
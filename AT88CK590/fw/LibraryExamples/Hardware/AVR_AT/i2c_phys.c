@@ -42,6 +42,7 @@
 #include <avr\io.h>       // GPIO definitions
 #include <util\twi.h>     // I2C definitions
 #include <avr\power.h>    // definitions for power saving register
+#include <stddef.h>       // NULL definition
 #include "i2c_phys.h"     // definitions and declarations for the hardware dependent I2C module
 
 
@@ -178,42 +179,58 @@ uint8_t i2c_receive_byte(uint8_t *data)
  * \return status of the operation
  */
 uint8_t i2c_receive_bytes(uint8_t count, uint8_t *data)
+{
+	return i2c_receive_bytes_crc(count, data, NULL);
+}
+
+
+/** \brief This function receives bytes from an I<SUP>2</SUP>C device,
+ *         calculates their CRC, and sends a Stop.
+ *
+ * Every byte is folded into the CRC while the TWI module clocks in the next one,
+ * so the CRC is complete shortly after the last byte has arrived.
+ *
+ * \param[in] count number of bytes to receive
+ * \param[out] data pointer to rx buffer
+ * \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t i2c_receive_bytes_crc(uint8_t count, uint8_t *data, struct cryptoauth_crc_rx *crc)
 {
 	uint8_t i;
 	uint8_t timeout_counter;
+	uint8_t twi_status = TW_MR_DATA_ACK;
+
+	for (i = 0; i < count; i++) {
+		if (i < count - 1)
+			// Enable acknowledging data.
+			TWCR = (_BV(TWEN) | _BV(TWINT) | _BV(TWEA));
+		else {
+			// Disable acknowledging data for the last byte.
+			TWCR = (_BV(TWEN) | _BV(TWINT));
+			twi_status = TW_MR_DATA_NACK;
+		}
+
+		// Use the time it takes to receive this byte for the CRC of the previous one.
+		if (crc && (i > 0))
+			cryptoauth_crc_rx_byte(crc, data[i - 1]);
 
-	// Acknowledge all bytes except the last one.
-	for (i = 0; i < count - 1; i++) {
-		// Enable acknowledging data.
-		TWCR = (_BV(TWEN) | _BV(TWINT) | _BV(TWEA));
 		timeout_counter = I2C_BYTE_TIMEOUT;
 		do {
 			if (timeout_counter-- == 0)
 				return I2C_FUNCTION_RETCODE_TIMEOUT;
 		} while ((TWCR & (_BV(TWINT))) == 0);
 
-		if (TW_STATUS != TW_MR_DATA_ACK) {
+		if (TW_STATUS != twi_status) {
 			// Do not override original error.
 			(void) i2c_send_stop();
 			return I2C_FUNCTION_RETCODE_COMM_FAIL;
 		}
-		*data++ = TWDR;
+		data[i] = TWDR;
 	}
 
-	// Disable acknowledging data for the last byte.
-	TWCR = (_BV(TWEN) | _BV(TWINT));
-	timeout_counter = I2C_BYTE_TIMEOUT;
-	do {
-		if (timeout_counter-- == 0)
-			return I2C_FUNCTION_RETCODE_TIMEOUT;
-	} while ((TWCR & (_BV(TWINT))) == 0);
-
-	if (TW_STATUS != TW_MR_DATA_NACK) {
-		// Do not override original error.
-		(void) i2c_send_stop();
-		return I2C_FUNCTION_RETCODE_COMM_FAIL;
-	}
-	*data = TWDR;
+	if (crc && (count > 0))
+		cryptoauth_crc_rx_byte(crc, data[count - 1]);
 
 	return i2c_send_stop();
 }
@@ -42,6 +42,7 @@
 #   define I2C_PHYS_H_
 
 #include <stdint.h>                       // data type definitions
+#include "cryptoauth_crc.h"               // CRC of a packet that is being received
 
 /** \defgroup atsha204_i2c_hardware Module 18: I2C Interface
  * Definitions are supplied for various I<SUP>2</SUP>C configuration values
@@ -98,6 +99,7 @@ uint8_t i2c_send_stop(void);
 uint8_t i2c_send_bytes(uint8_t count, uint8_t *data);
 uint8_t i2c_receive_byte(uint8_t *data);
 uint8_t i2c_receive_bytes(uint8_t count, uint8_t *data);
+uint8_t i2c_receive_bytes_crc(uint8_t count, uint8_t *data, struct cryptoauth_crc_rx *crc);
 
 
 /** @} */
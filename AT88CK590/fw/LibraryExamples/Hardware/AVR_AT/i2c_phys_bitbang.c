@@ -5,6 +5,7 @@
  *  microcontroller. The pin and port definitions are in the file
  *  i2c_phys_bitbang.h
  */
+#include <stddef.h>
 #include "i2c_phys_bitbang.h"
 
 
@@ -179,10 +180,28 @@ uint8_t i2c_receive_byte(uint8_t *i2c_byte) {
  * \return success
  */
 uint8_t i2c_receive_bytes(uint8_t count, uint8_t *buffer) {
-    while (--count) {
-      *buffer++ = i2c_receive_one_byte(1);
-    }
-    *buffer = i2c_receive_one_byte(0);
+	return i2c_receive_bytes_crc(count, buffer, NULL);
+}
+
+
+/** \brief This function receives bytes and calculates their CRC.
+ *
+ * Every byte is folded into the CRC right after it has been clocked in,
+ * so the CRC is complete when the last byte has arrived.
+ *
+ * \param[out] buffer - pointer to receive buffer
+ * \param[in] count - number of bytes to receive
+ * \param[in, out] crc - pointer to CRC state, or NULL if no CRC is needed
+ * \return success
+ */
+uint8_t i2c_receive_bytes_crc(uint8_t count, uint8_t *buffer, struct cryptoauth_crc_rx *crc) {
+	while (count--) {
+		// Acknowledge all bytes except the last one.
+		*buffer = i2c_receive_one_byte(count > 0);
+		if (crc)
+			cryptoauth_crc_rx_byte(crc, *buffer);
+		buffer++;
+	}
 
 	return i2c_send_stop();
 }
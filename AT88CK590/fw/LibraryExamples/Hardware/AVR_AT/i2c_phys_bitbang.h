@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <avr/io.h>
 #include "config.h"
+#include "cryptoauth_crc.h"
 
 #if TARGET_BOARD == NO_TARGET_BOARD
 #   error You have to define a target board in config.h.
@@ -88,6 +89,7 @@ uint8_t i2c_send_stop(void);
 uint8_t i2c_send_bytes(uint8_t count, uint8_t *data);
 uint8_t i2c_receive_byte(uint8_t *data);
 uint8_t i2c_receive_bytes(uint8_t count, uint8_t *data);
+uint8_t i2c_receive_bytes_crc(uint8_t count, uint8_t *data, struct cryptoauth_crc_rx *crc);
 
 #endif
 
@@ -19,6 +19,7 @@
  *  \author Atmel Crypto Products
  *  \date  October 30, 2012
  */
+#include <stddef.h>
 #include <avr\io.h>
 #include "spi_phys.h"
 #include "aes132_lib_return_codes.h"
@@ -207,14 +208,36 @@ uint8_t spi_send_bytes(uint8_t count, uint8_t *data)
  * \return status of the operation
  */
 uint8_t spi_receive_bytes(uint8_t count, uint8_t *data)
+{
+	return spi_receive_bytes_crc(count, data, NULL);
+}
+
+
+/** \brief This function receives bytes from an SPI device and calculates their CRC.
+ *
+ * Every byte is folded into the CRC while the SPI module clocks in the next one,
+ * so the CRC is complete shortly after the last byte has arrived.
+ *
+ * \param[in] count number of bytes to receive
+ * \param[in] data pointer to rx buffer
+ * \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t spi_receive_bytes_crc(uint8_t count, uint8_t *data, struct cryptoauth_crc_rx *crc)
 {
 	uint8_t timeout;
 	uint8_t writeDummy = 0;
+	uint8_t *previous = NULL;
 
 	while (count-- > 0) {
 		SPDR = writeDummy;
 		timeout = SPI_RX_TIMEOUT;
 
+		// Use the time it takes to receive this byte for the CRC of the previous one.
+		if (crc && previous)
+			cryptoauth_crc_rx_byte(crc, *previous);
+		previous = data;
+
 		// Wait for byte.
 		while ((SPSR & (1 << SPIF)) == 0) {
 			if (--timeout == 0) {
@@ -227,5 +250,8 @@ uint8_t spi_receive_bytes(uint8_t count, uint8_t *data)
 		*data++ = SPDR;
 	}
 
+	if (crc && previous)
+		cryptoauth_crc_rx_byte(crc, *previous);
+
 	return SPI_FUNCTION_RETCODE_SUCCESS;
 }
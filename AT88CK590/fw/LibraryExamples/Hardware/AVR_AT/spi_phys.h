@@ -23,6 +23,7 @@
 #   define SPI_PHYS_H_
 
 #include <stdint.h>
+#include "cryptoauth_crc.h"
 
 // error codes for physical hardware dependent module
 // Codes in the range 0x00 to 0xF7 are shared between physical interfaces (SWI, I2C, SPI).
@@ -39,5 +40,6 @@ void    spi_deselect_slave(void);
 uint8_t spi_select_device(uint8_t index);
 uint8_t spi_send_bytes(uint8_t count, uint8_t *data);
 uint8_t spi_receive_bytes(uint8_t count, uint8_t *data);
+uint8_t spi_receive_bytes_crc(uint8_t count, uint8_t *data, struct cryptoauth_crc_rx *crc);
 
 #endif
@@ -42,6 +42,7 @@
 #   define SWI_PHYS_H
 
 #include <stdint.h>                                       // data type definitions
+#include "cryptoauth_crc.h"                               // CRC of a packet that is being received
 
 /** \ingroup sha204_swi
  *
@@ -63,6 +64,7 @@ void    swi_set_signal_pin(uint8_t end);
 uint8_t swi_send_bytes(uint8_t count, uint8_t *buffer);
 uint8_t swi_send_byte(uint8_t value);
 uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer);
+uint8_t swi_receive_bytes_crc(uint8_t count, uint8_t *buffer, struct cryptoauth_crc_rx *crc);
 
 
 #endif
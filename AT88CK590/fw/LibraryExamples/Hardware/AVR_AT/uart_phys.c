@@ -41,6 +41,7 @@
  * \atsha204_library_license_stop
  */
 
+#include <stddef.h>          // NULL definition
 #include "swi_phys.h"        // hardware dependent declarations for SWI
 #include "uart_config.h"     // UART definitions
 #include "avr_compatible.h"  // translates generic AVR UART macros into specific ones
@@ -197,6 +198,22 @@ uint8_t swi_send_byte(uint8_t value)
  * \return status of the operation
  */
 uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
+	return swi_receive_bytes_crc(count, buffer, NULL);
+}
+
+
+/** \brief This UART function receives bytes from an SWI device
+ *         and calculates their CRC.
+ *
+ * Every byte is folded into the CRC after its last bit has been read from the UART.
+ * The UART receives the first bit of the next byte in the meantime,
+ * so the CRC is complete when the last byte has arrived.
+ *  \param[in] count number of bytes to receive
+ *  \param[out] buffer pointer to receive buffer
+ *  \param[in, out] crc pointer to CRC state, or NULL if no CRC is needed
+ * \return status of the operation
+ */
+uint8_t swi_receive_bytes_crc(uint8_t count, uint8_t *buffer, struct cryptoauth_crc_rx *crc) {
 	uint8_t i, bit_mask, bit_data, timeout;
 
 	// Turn off transmit. The transmitter will not turn off until transmit is complete.
@@ -226,6 +243,8 @@ uint8_t swi_receive_bytes(uint8_t count, uint8_t *buffer) {
 				// Received "one" bit.
 				buffer[i] |= bit_mask;
 		}
+		if (crc)
+			cryptoauth_crc_rx_byte(crc, buffer[i]);
 	}
 	DEBUG_LOW;
 
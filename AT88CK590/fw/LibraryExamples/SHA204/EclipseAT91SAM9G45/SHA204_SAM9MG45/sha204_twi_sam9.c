@@ -27,6 +27,7 @@
 
 #include "sha204_physical.h"            // SHA204 TWI implementations
 #include "sha204_lib_return_codes.h"    // declarations of SHA204 library function return codes
+#include "cryptoauth_crc.h"             // definitions and declarations for the shared CRC calculation
 
 //!brief TWI address used at SHA204 library startup.
 #define SHA204_TWI_DEFAULT_ADDRESS      (0xC8)
@@ -224,6 +225,9 @@ uint8_t sha204p_read_byte(uint8_t *byte)
 
 
 /** \brief This TWI function receives a response from the SHA204 device.
+ *
+ * The CRC of the response is calculated while the response is being received.
+ * The function returns #SHA204_BAD_CRC if it does not match the received one.
  *
  * \param[in] size size of rx buffer
  * \param[out] response pointer to rx buffer
@@ -232,7 +236,10 @@ uint8_t sha204p_read_byte(uint8_t *byte)
 uint8_t sha204p_receive_response(uint8_t size, uint8_t *response)
 {
 	uint8_t count;
+	uint8_t i;
 	uint8_t ret_code;
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE];
+	struct cryptoauth_crc_rx crc_rx;
 
     // Set slave address and number of internal address bytes.
     pTwi->TWI_MMR = 0;
@@ -245,17 +252,25 @@ uint8_t sha204p_receive_response(uint8_t size, uint8_t *response)
 	if (ret_code != SHA204_SUCCESS)
 		return ret_code;
 
-	*response++ = count;
+	response[SHA204_BUFFER_POS_COUNT] = count;
 
 	if ((count < SHA204_RSP_SIZE_MIN) || (count > size))
 		return SHA204_INVALID_SIZE;
 
-	while (--count > 0) {
-		ret_code = sha204p_read_byte(response++);
+	// Calculate the CRC while the remaining bytes arrive.
+	cryptoauth_crc_rx_init(&crc_rx, 0);
+	cryptoauth_crc_rx_byte(&crc_rx, count);
+	for (i = SHA204_BUFFER_POS_DATA; i < count; i++) {
+		ret_code = sha204p_read_byte(&response[i]);
 		if (ret_code != SHA204_SUCCESS)
 			return ret_code;
+		cryptoauth_crc_rx_byte(&crc_rx, response[i]);
 	}
 
+	cryptoauth_crc_rx_final(&crc_rx, crc);
+	if ((crc[0] != response[count - CRYPTOAUTH_CRC_SIZE]) || (crc[1] != response[count - 1]))
+		return SHA204_BAD_CRC;
+
 	return SHA204_SUCCESS;
 }
 
@@ -25,6 +25,7 @@
 #include "SHA_Tests.h"
 #include "sha204_comm_marshaling.h"
 #include "sha204_physical.h"
+#include "cryptoauth_crc.h"
 
 
 static uint8_t tx_buffer[SHA204_CMD_SIZE_MAX];      //!< command buffer
@@ -38,31 +39,8 @@ static uint8_t rx_buffer[SHA204_RSP_SIZE_MAX];   //!< response buffer
  * \param[out] crc pointer to 16-bit CRC
  */
 void sha204t_calculate_crc(uint8_t length, uint8_t *data, uint8_t *crc) {
-	uint8_t counter;
-	uint8_t crcLow = 0, crcHigh = 0, crcCarry;
-	uint8_t polyLow = 0x05, polyHigh = 0x80;
-	uint8_t shiftRegister;
-	uint8_t dataBit, crcBit;
-
-	for (counter = 0; counter < length; counter++) {
-	  for (shiftRegister = 0x01; shiftRegister > 0x00; shiftRegister <<= 1) {
-		 dataBit = (data[counter] & shiftRegister) ? 1 : 0;
-		 crcBit = crcHigh >> 7;
-
-		 // Shift CRC to the left by 1.
-		 crcCarry = crcLow >> 7;
-		 crcLow <<= 1;
-		 crcHigh <<= 1;
-		 crcHigh |= crcCarry;
-
-		 if ((dataBit ^ crcBit) != 0) {
-			crcLow ^= polyLow;
-			crcHigh ^= polyHigh;
-		 }
-	  }
-	}
-	crc[0] = crcLow;
-	crc[1] = crcHigh;
+	crc[0] = crc[1] = 0;
+	cryptoauth_calculate_crc(length, data, crc);
 }
 
 
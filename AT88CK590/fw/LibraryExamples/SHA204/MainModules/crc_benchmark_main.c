@@ -0,0 +1,346 @@
+/** \file
+ *  \brief  Benchmark of the Table-Driven CRC Engine Against the Bitwise CRC
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This application checks the CRC engine of the utilities against the bitwise CRC the
+ * libraries used before, for both bit orders and every packet length, and measures both
+ * for typical packet sizes. It runs on a host, or on the AT90USB1287 of the AT88CK590 kit in
+ * the simavr simulator, which reports exact CPU cycles. Build and run it from the fw
+ * directory with:
+ *
+ *   gcc -O2 -ILibraries/utilities LibraryExamples/SHA204/MainModules/crc_benchmark_main.c
+ *       Libraries/utilities/cryptoauth_crc.c -o crc_benchmark
+ *   ./crc_benchmark
+ *
+ *   avr-gcc -mmcu=at90usb1287 -Os -DF_CPU=16000000UL -ILibraries/utilities -I<simavr>/simavr/sim/avr
+ *       LibraryExamples/SHA204/MainModules/crc_benchmark_main.c Libraries/utilities/cryptoauth_crc.c
+ *       -o crc_benchmark.elf
+ *   simavr crc_benchmark.elf
+ *
+ * Add -DCRYPTOAUTH_CRC_NIBBLE or -DCRYPTOAUTH_CRC_TABLE to the command line to measure
+ * another engine than the default one of the target. The nibble engine is the default for
+ * the ATtiny devices; use -mmcu=attiny44 with simavr to measure it on that core.
+ * The application returns 1 if the engine does not match the bitwise CRC.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+
+#if defined(__AVR__)
+#   include <avr/io.h>                 // register definitions
+#   include <avr/interrupt.h>          // needed for ISR() and sei()
+#   include <avr/sleep.h>              // needed for sleep_cpu()
+#   include <avr/pgmspace.h>           // needed for PSTR()
+#   include "avr_mcu_section.h"        // simavr firmware section, from simavr/sim/avr
+#else
+#   include <time.h>                   // needed for clock()
+#   define PSTR(s)                  (s)
+#   define printf_P                 printf
+#endif
+
+#include "cryptoauth_crc.h"            // definitions and declarations for the CRC module
+
+
+#if defined(__AVR__)
+// Tell simavr which MCU and clock to simulate, and to print bytes written to GPIOR0.
+AVR_MCU(F_CPU, "at90usb1287");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+//! number of calls per measurement, one is enough because the cycle count is exact
+#   define CRC_BENCHMARK_LOOPS      (1)
+//! unit of a measurement
+#   define CRC_BENCHMARK_UNIT       "cycles"
+//! type of a measurement
+typedef uint32_t crc_benchmark_cost_t;
+#else
+//! number of calls per measurement
+#   define CRC_BENCHMARK_LOOPS      (1000000UL)
+//! unit of a measurement
+#   define CRC_BENCHMARK_UNIT       "ns"
+//! type of a measurement
+typedef double crc_benchmark_cost_t;
+#endif
+
+
+//! type of a CRC function
+typedef void (*crc_benchmark_function_t)(uint8_t length, const uint8_t *data, uint8_t *crc);
+
+//! packet sizes to measure, and what they are
+struct crc_benchmark_case {
+	uint8_t len;
+	const char *name;
+};
+
+static const struct crc_benchmark_case crc_benchmark_cases[] = {
+	{ 2, "wake-up response" },
+	{ 5, "command, no data" },
+	{ 33, "32-byte response" },
+	{ 82, "CheckMac command" },
+	{ 255, "maximum length" }
+};
+
+//! input of all calculations: 0x00 .. 0xFF
+static uint8_t crc_benchmark_data[256];
+
+
+/** \brief This function calculates the CRC one bit at a time, LSB first, like the libraries did.
+ * \param[in] length number of bytes in buffer
+ * \param[in] data pointer to data for which CRC should be calculated
+ * \param[in, out] crc pointer to 16-bit CRC, LSB first
+ */
+static void crc_benchmark_bitwise(uint8_t length, const uint8_t *data, uint8_t *crc)
+{
+	uint8_t counter;
+	uint16_t crc_register = (((uint16_t) crc[0]) & 0x00FF) | (((uint16_t) crc[1]) << 8);
+	uint8_t shift_register;
+	uint8_t data_bit, crc_bit;
+
+	for (counter = 0; counter < length; counter++) {
+		for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1) {
+			data_bit = (data[counter] & shift_register) ? 1 : 0;
+			crc_bit = crc_register >> 15;
+			crc_register <<= 1;
+			if ((data_bit ^ crc_bit) != 0)
+				crc_register ^= 0x8005;
+		}
+	}
+	crc[0] = (uint8_t) (crc_register & 0x00FF);
+	crc[1] = (uint8_t) (crc_register >> 8);
+}
+
+
+/** \brief This function calculates the CRC one bit at a time, MSB first, like the AES132 library did.
+ * \param[in] length number of bytes in buffer
+ * \param[in] data pointer to data for which CRC should be calculated
+ * \param[in, out] crc pointer to 16-bit CRC, MSB first
+ */
+static void crc_benchmark_bitwise_msb_first(uint8_t length, const uint8_t *data, uint8_t *crc)
+{
+	uint8_t counter;
+	uint16_t crc_register = (((uint16_t) crc[0]) << 8) | (((uint16_t) crc[1]) & 0x00FF);
+	uint8_t shift_register;
+	uint8_t data_bit, crc_bit;
+
+	for (counter = 0; counter < length; counter++) {
+		for (shift_register = 0x80; shift_register > 0x00; shift_register >>= 1) {
+			data_bit = (data[counter] & shift_register) ? 1 : 0;
+			crc_bit = crc_register >> 15;
+			crc_register <<= 1;
+			if ((data_bit ^ crc_bit) != 0)
+				crc_register ^= 0x8005;
+		}
+	}
+	crc[0] = (uint8_t) (crc_register >> 8);
+	crc[1] = (uint8_t) (crc_register & 0x00FF);
+}
+
+
+#if defined(__AVR__)
+//! upper 16 bits of the cycle counter, incremented on every Timer1 overflow
+static volatile uint16_t crc_benchmark_overflows;
+
+
+/** \brief Timer1 overflow interrupt, extends the cycle counter to 32 bits.
+ */
+ISR(TIMER1_OVF_vect)
+{
+	crc_benchmark_overflows++;
+}
+
+
+/** \brief This function writes a character to the simavr console.
+ * \param[in] c character
+ * \param[in] stream not used
+ * \return 0
+ */
+static int crc_benchmark_putchar(char c, FILE *stream)
+{
+	(void) stream;
+	GPIOR0 = c;
+	return 0;
+}
+
+static FILE crc_benchmark_stdout = FDEV_SETUP_STREAM(crc_benchmark_putchar, NULL, _FDEV_SETUP_WRITE);
+
+
+/** \brief This function counts the cycles of one CRC calculation.
+ * \param[in] function CRC function
+ * \param[in] length number of bytes
+ * \param[in, out] crc CRC register, chained from call to call
+ * \return number of CPU cycles, including the overhead of starting and stopping Timer1
+ */
+static crc_benchmark_cost_t crc_benchmark_measure(crc_benchmark_function_t function, uint8_t length, uint8_t *crc)
+{
+	TCCR1B = 0;
+	TCNT1 = 0;
+	crc_benchmark_overflows = 0;
+	TIFR1 = _BV(TOV1);
+	TCCR1B = _BV(CS10);
+
+	function(length, crc_benchmark_data, crc);
+
+	TCCR1B = 0;
+	// Account for an overflow that happened after the last interrupt was served.
+	if (TIFR1 & _BV(TOV1)) {
+		TIFR1 = _BV(TOV1);
+		crc_benchmark_overflows++;
+	}
+	return ((uint32_t) crc_benchmark_overflows << 16) | TCNT1;
+}
+#else
+/** \brief This function measures the time of one CRC calculation.
+ * \param[in] function CRC function
+ * \param[in] length number of bytes
+ * \param[in, out] crc CRC register, chained from call to call so the calls cannot be optimized away
+ * \return nanoseconds per call
+ */
+static crc_benchmark_cost_t crc_benchmark_measure(crc_benchmark_function_t function, uint8_t length, uint8_t *crc)
+{
+	unsigned long loop;
+	clock_t start = clock();
+
+	for (loop = 0; loop < CRC_BENCHMARK_LOOPS; loop++)
+		function(length, crc_benchmark_data, crc);
+
+	return (double) (clock() - start) * 1e9 / CLOCKS_PER_SEC / CRC_BENCHMARK_LOOPS;
+}
+#endif
+
+
+/** \brief This function compares a CRC function with its bitwise counterpart for every length.
+ * \param[in] function CRC function
+ * \param[in] reference bitwise CRC function
+ * \return 0 if all results match, 1 otherwise
+ */
+static uint8_t crc_benchmark_check(crc_benchmark_function_t function, crc_benchmark_function_t reference)
+{
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE] = {0x5A, 0xA5};
+	uint8_t expected[CRYPTOAUTH_CRC_SIZE] = {0x5A, 0xA5};
+	uint16_t length;
+
+	// Chain every result into the next calculation, so that the initial register is tested too.
+	for (length = 0; length < sizeof(crc_benchmark_data); length++) {
+		function((uint8_t) length, crc_benchmark_data, crc);
+		reference((uint8_t) length, crc_benchmark_data, expected);
+		if (memcmp(crc, expected, sizeof(crc)))
+			return 1;
+	}
+	return 0;
+}
+
+
+/** \brief This function prints the measurements of one bit order.
+ * \param[in] order name of the bit order
+ * \param[in] function CRC function
+ * \param[in] reference bitwise CRC function
+ */
+static void crc_benchmark_run(const char *order, crc_benchmark_function_t function, crc_benchmark_function_t reference)
+{
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE] = {0, 0};
+	crc_benchmark_cost_t overhead, bitwise, table;
+	uint8_t i;
+
+	overhead = crc_benchmark_measure(function, 0, crc);
+
+	for (i = 0; i < sizeof(crc_benchmark_cases) / sizeof(crc_benchmark_cases[0]); i++) {
+		const struct crc_benchmark_case *test = &crc_benchmark_cases[i];
+
+		bitwise = crc_benchmark_measure(reference, test->len, crc) - overhead;
+		table = crc_benchmark_measure(function, test->len, crc) - overhead;
+
+#if defined(__AVR__)
+		printf_P(PSTR("%-9s %-18s %5u %10lu %10lu %5lu.%lu\n"), order, test->name, test->len,
+				(unsigned long) bitwise, (unsigned long) table,
+				(unsigned long) (bitwise / table), (unsigned long) (bitwise * 10 / table % 10));
+#else
+		printf("%-9s %-18s %5u %10.1f %10.1f %7.1f\n", order, test->name, test->len,
+				bitwise, table, bitwise / table);
+#endif
+	}
+}
+
+
+/** \brief This function checks the CRC engine and measures it against the bitwise CRC.
+ * @return exit status of application, 1 if the engine does not match the bitwise CRC
+ */
+int main(void)
+{
+	uint8_t wake_up_response[] = {0x04, 0x11, 0x33, 0x43};
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE] = {0, 0};
+	uint16_t i;
+	int ret_code = 0;
+
+#if defined(__AVR__)
+	stdout = &crc_benchmark_stdout;
+	TIMSK1 = _BV(TOIE1);
+	sei();
+#endif
+
+	for (i = 0; i < sizeof(crc_benchmark_data); i++)
+		crc_benchmark_data[i] = (uint8_t) i;
+
+	cryptoauth_calculate_crc(2, wake_up_response, crc);
+	if (memcmp(crc, &wake_up_response[2], sizeof(crc))) {
+		printf_P(PSTR("CRC of the wake-up response failed\n"));
+		ret_code = 1;
+	}
+	if (crc_benchmark_check(cryptoauth_calculate_crc, crc_benchmark_bitwise)) {
+		printf_P(PSTR("LSB-first CRC does not match the bitwise CRC\n"));
+		ret_code = 1;
+	}
+	if (crc_benchmark_check(cryptoauth_calculate_crc_msb_first, crc_benchmark_bitwise_msb_first)) {
+		printf_P(PSTR("MSB-first CRC does not match the bitwise CRC\n"));
+		ret_code = 1;
+	}
+
+	printf_P(PSTR("CRC engine: %s, " CRC_BENCHMARK_UNIT " per call\n"), CRYPTOAUTH_CRC_ENGINE);
+	printf_P(PSTR("%-9s %-18s %5s %10s %10s %7s\n"), "bit order", "packet", "bytes", "bitwise", "table", "speedup");
+	crc_benchmark_run("LSB first", cryptoauth_calculate_crc, crc_benchmark_bitwise);
+	crc_benchmark_run("MSB first", cryptoauth_calculate_crc_msb_first, crc_benchmark_bitwise_msb_first);
+
+#if defined(__AVR__)
+	// simavr stops when the CPU sleeps with interrupts disabled.
+	cli();
+	sleep_enable();
+	sleep_cpu();
+#endif
+
+	return ret_code;
+}
@@ -0,0 +1,183 @@
+/** \file
+ *  \brief  Benchmark of the Bulk CRC Check Against Checking Packets One by One
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It builds a log of SHA204 packets, corrupts
+ * every 16th of them, and checks their CRC with cryptoauth_crc_bulk_check() and, one by one,
+ * the way sha204c_check_crc() does. It compares the statuses and reports the throughput of
+ * both for a few packet mixes. Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -ILibraries/utilities LibraryExamples/SHA204/MainModules/crc_bulk_benchmark_main.c
+ *       Libraries/utilities/cryptoauth_crc_bulk.c Libraries/utilities/cryptoauth_crc.c
+ *       -o crc_bulk_benchmark
+ *   ./crc_bulk_benchmark
+ *
+ * The application returns 1 if a status differs.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock()
+
+#include "cryptoauth_crc.h"            // definitions and declarations for the CRC module
+#include "cryptoauth_crc_bulk.h"       // definitions and declarations for the Bulk CRC module
+
+
+//! number of packets in the log
+#define CRC_BULK_BENCHMARK_PACKETS  (1UL << 20)
+
+//! number of times the log is checked per measurement
+#define CRC_BULK_BENCHMARK_LOOPS    (10)
+
+//! packet sizes of a mix, and its name
+struct crc_bulk_benchmark_mix {
+	const char *name;
+	uint8_t sizes[4];
+};
+
+static const struct crc_bulk_benchmark_mix crc_bulk_benchmark_mixes[] = {
+	{ "status responses", { 4, 4, 4, 4 } },
+	{ "kit transactions", { 7, 35, 39, 84 } },
+	{ "32-byte responses", { 35, 35, 35, 35 } },
+	{ "CheckMac commands", { 84, 84, 84, 84 } },
+	{ "maximum length", { 255, 255, 255, 255 } }
+};
+
+
+/** \brief This function checks the CRC of a packet like sha204c_check_crc() does.
+ * \param[in] response pointer to packet, starting with its count byte
+ * \return CRYPTOAUTH_CRC_BULK_SUCCESS or CRYPTOAUTH_CRC_BULK_BAD_CRC
+ */
+static uint8_t crc_bulk_benchmark_check_crc(const uint8_t *response)
+{
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE] = {0, 0};
+	uint8_t count = response[0];
+
+	count -= CRYPTOAUTH_CRC_SIZE;
+	cryptoauth_calculate_crc(count, response, crc);
+
+	return (crc[0] == response[count] && crc[1] == response[count + 1])
+		? CRYPTOAUTH_CRC_BULK_SUCCESS : CRYPTOAUTH_CRC_BULK_BAD_CRC;
+}
+
+
+/** \brief This function builds a log of packets with a valid CRC, except every 16th packet.
+ * \param[in] mix packet sizes
+ * \param[out] log buffer for the packets, 255 bytes per packet
+ * \param[out] packets pointers to the packets
+ */
+static void crc_bulk_benchmark_build(const struct crc_bulk_benchmark_mix *mix, uint8_t *log, const uint8_t **packets)
+{
+	uint8_t crc[CRYPTOAUTH_CRC_SIZE];
+	uint8_t count;
+	uint32_t i, j;
+
+	for (i = 0; i < CRC_BULK_BENCHMARK_PACKETS; i++) {
+		count = mix->sizes[i & 0x03];
+		log[0] = count;
+		for (j = 1; j < (uint32_t) (count - CRYPTOAUTH_CRC_SIZE); j++)
+			log[j] = (uint8_t) (i * 31 + j * 7);
+		crc[0] = crc[1] = 0;
+		cryptoauth_calculate_crc(count - CRYPTOAUTH_CRC_SIZE, log, crc);
+		log[count - 2] = crc[0];
+		log[count - 1] = crc[1];
+		if ((i & 0x0F) == 0x0F)
+			log[1 + i % (count - 1)] ^= 0x10;
+		packets[i] = log;
+		log += count;
+	}
+}
+
+
+/** \brief This function checks the bulk CRC check against checking packets one by one, and measures both.
+ * @return exit status of application, 1 if a status differs
+ */
+int main(void)
+{
+	uint8_t *log = malloc(CRC_BULK_BENCHMARK_PACKETS * 255);
+	const uint8_t **packets = malloc(CRC_BULK_BENCHMARK_PACKETS * sizeof(*packets));
+	uint8_t *status = malloc(CRC_BULK_BENCHMARK_PACKETS);
+	uint8_t *expected = malloc(CRC_BULK_BENCHMARK_PACKETS);
+	uint32_t i, loop, failed;
+	clock_t start;
+	double single, bulk;
+	uint8_t m;
+	int ret_code = 0;
+
+	if (!log || !packets || !status || !expected) {
+		printf("out of memory\n");
+		return 1;
+	}
+
+	printf("bulk kernel: %s\n", cryptoauth_crc_bulk_clmul() ? "carry-less multiplication" : CRYPTOAUTH_CRC_ENGINE);
+	printf("%-18s %12s %12s %8s\n", "packets", "single Mp/s", "bulk Mp/s", "speedup");
+
+	for (m = 0; m < sizeof(crc_bulk_benchmark_mixes) / sizeof(crc_bulk_benchmark_mixes[0]); m++) {
+		crc_bulk_benchmark_build(&crc_bulk_benchmark_mixes[m], log, packets);
+
+		start = clock();
+		for (loop = 0; loop < CRC_BULK_BENCHMARK_LOOPS; loop++)
+			for (i = 0; i < CRC_BULK_BENCHMARK_PACKETS; i++)
+				expected[i] = crc_bulk_benchmark_check_crc(packets[i]);
+		single = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		start = clock();
+		for (loop = 0; loop < CRC_BULK_BENCHMARK_LOOPS; loop++)
+			failed = cryptoauth_crc_bulk_check(CRC_BULK_BENCHMARK_PACKETS, packets, status);
+		bulk = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		if (memcmp(status, expected, CRC_BULK_BENCHMARK_PACKETS) || failed != CRC_BULK_BENCHMARK_PACKETS / 16) {
+			printf("%-18s FAILED\n", crc_bulk_benchmark_mixes[m].name);
+			ret_code = 1;
+			continue;
+		}
+		printf("%-18s %12.1f %12.1f %8.1f\n", crc_bulk_benchmark_mixes[m].name,
+				CRC_BULK_BENCHMARK_PACKETS * CRC_BULK_BENCHMARK_LOOPS / single / 1e6,
+				CRC_BULK_BENCHMARK_PACKETS * CRC_BULK_BENCHMARK_LOOPS / bulk / 1e6, single / bulk);
+	}
+
+	free(expected);
+	free(status);
+	free(packets);
+	free(log);
+
+	return ret_code;
+}
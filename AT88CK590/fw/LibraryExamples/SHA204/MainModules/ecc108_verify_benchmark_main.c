@@ -0,0 +1,311 @@
+/** \file
+ *  \brief  Benchmark of the ECC108 Batch Signature Verification Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It verifies a batch of ECC108 signatures:
+ * half of them signed by a root key that is loaded into the key table, half by device
+ * keys that the records carry. It compares the results of the basic verification, of
+ * p256_verify() with and without the comb table of the root key, and of ecc108v_verify()
+ * with 1 up to N threads, and reports the signatures per second of each.
+ * The vectors were calculated independently of the P-256 module. Vector 3 signs a digest
+ * that is greater than the group order. Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -pthread -ILibraries/ecc108_library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/ecc108_verify_benchmark_main.c
+ *       Libraries/ecc108_library/ecc108_verify.c Libraries/utilities/p256.c
+ *       -o ecc108_verify_benchmark
+ *   ./ecc108_verify_benchmark [maximum number of threads]
+ *
+ * The application returns 1 if a result differs from the expected one.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+#include <unistd.h>                    // needed for sysconf()
+
+#include "ecc108_verify.h"             // definitions and declarations for the Batch Verification module
+#include "ecc108_lib_return_codes.h"   // declarations of function return codes
+
+
+//! number of records in the batch
+#define ECC108_VERIFY_BENCHMARK_RECORDS  (4096UL)
+
+//! number of vectors
+#define ECC108_VERIFY_BENCHMARK_VECTORS  (16)
+
+//! vectors below this index are signed by the root key
+#define ECC108_VERIFY_BENCHMARK_ROOT      (8)
+
+
+//! digest, signature and public key of a signature
+struct ecc108_verify_benchmark_vector {
+	uint8_t digest[P256_INT_SIZE];
+	uint8_t signature[P256_SIGNATURE_SIZE];
+	uint8_t public_key[P256_KEY_SIZE];
+};
+
+//! known-answer vectors
+static const struct ecc108_verify_benchmark_vector ecc108_verify_benchmark_vectors[ECC108_VERIFY_BENCHMARK_VECTORS] = {
+	{
+		{0xD9, 0x8D, 0x70, 0x92, 0x4E, 0xE7, 0x05, 0x6A, 0xD7, 0x90, 0x57, 0xEA, 0xC5, 0xB6, 0xB4, 0xB4, 0x16, 0x57, 0x0B, 0x1B, 0x67, 0xAB, 0x45, 0xFA, 0xB9, 0x0A, 0x35, 0x65, 0xC5, 0x8B, 0x42, 0x83},
+		{0x47, 0x6B, 0xA7, 0x28, 0x54, 0x3D, 0xBB, 0x08, 0xC3, 0x41, 0x85, 0x27, 0xB5, 0xD8, 0xE6, 0xAF, 0xA3, 0x8A, 0xC3, 0xC8, 0xCF, 0x52, 0xF0, 0x25, 0x75, 0x90, 0x50, 0xBE, 0x89, 0x0E, 0x11, 0x68, 0xCA, 0x3F, 0x34, 0xDA, 0xAB, 0xED, 0xE6, 0x13, 0x3B, 0xC0, 0xE7, 0x4F, 0x0C, 0x64, 0xB2, 0xCE, 0x30, 0x33, 0x42, 0xF8, 0xB1, 0xD6, 0x41, 0x8F, 0x9E, 0x68, 0xA4, 0xED, 0x05, 0xF1, 0xC0, 0x1A},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0x2C, 0xC5, 0x12, 0x2D, 0x21, 0x62, 0x68, 0xC3, 0x1B, 0xF3, 0x23, 0xD2, 0xC8, 0x20, 0xAE, 0xBB, 0xC9, 0x82, 0xE0, 0x1A, 0x17, 0xD1, 0xAA, 0x46, 0xD6, 0x44, 0xFD, 0xA8, 0xD8, 0x6A, 0xFA, 0x92},
+		{0xAA, 0x8F, 0x40, 0x95, 0x4B, 0x96, 0xB3, 0xF5, 0x0B, 0x6B, 0x7F, 0xD9, 0x25, 0xFE, 0x11, 0xB8, 0x68, 0xA0, 0xF5, 0x29, 0x31, 0x61, 0xDB, 0xDC, 0x22, 0x00, 0x8E, 0xC2, 0x76, 0xF9, 0x98, 0x63, 0x61, 0x2C, 0x77, 0x0C, 0x91, 0x01, 0x82, 0x9C, 0x94, 0xD9, 0x2C, 0xCD, 0x28, 0xD0, 0xF7, 0x8E, 0xC7, 0x35, 0x7F, 0x4F, 0xA9, 0x42, 0x8D, 0x7A, 0x09, 0x05, 0xA9, 0x70, 0xB6, 0x8E, 0xEB, 0xE4},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0x04, 0x66, 0x83, 0x03, 0x0C, 0x70, 0x39, 0x2F, 0x26, 0xC7, 0xE7, 0x73, 0x7B, 0xCA, 0xEE, 0xC8, 0x76, 0x2A, 0x63, 0xDE, 0x4E, 0x4A, 0x22, 0x74, 0x61, 0x76, 0x9B, 0xED, 0x90, 0xA5, 0x75, 0xB0},
+		{0xF3, 0x70, 0xF4, 0x38, 0x50, 0x55, 0xCE, 0xB5, 0x47, 0x86, 0x3B, 0x74, 0xEB, 0x7C, 0x8B, 0xD6, 0x42, 0xF7, 0xBD, 0xDA, 0x3F, 0x53, 0x40, 0x14, 0x5C, 0x30, 0x38, 0x24, 0x68, 0x8C, 0x9B, 0xBC, 0x5A, 0x87, 0x0C, 0xBF, 0xC1, 0xC1, 0x26, 0x60, 0xEB, 0x60, 0xA5, 0x5B, 0x9A, 0x99, 0x6D, 0xF1, 0xC4, 0x71, 0xD0, 0x24, 0x0A, 0xB9, 0x70, 0xDC, 0x34, 0x5D, 0xA0, 0xB1, 0x05, 0x9B, 0xF6, 0x8D},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+		{0x26, 0xE1, 0x15, 0x7E, 0x97, 0x63, 0xA8, 0x75, 0xEB, 0x73, 0xEC, 0xD9, 0xE4, 0x9A, 0x94, 0x7D, 0x9C, 0xA0, 0x8E, 0x87, 0x6F, 0xC4, 0x32, 0xA4, 0x91, 0x5A, 0xDC, 0x73, 0x71, 0xA5, 0xDC, 0xCD, 0x76, 0x01, 0x5D, 0x88, 0x56, 0xCB, 0x28, 0x29, 0x09, 0xE8, 0x9F, 0x6B, 0xE3, 0x05, 0x33, 0x2A, 0x2B, 0xBE, 0x3F, 0xB5, 0x2B, 0x42, 0x14, 0x8D, 0x24, 0x48, 0xFE, 0x78, 0x30, 0xFA, 0xF3, 0x1F},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0xFB, 0x2C, 0x9C, 0xBB, 0xB6, 0xB7, 0xCE, 0xBF, 0x50, 0x4D, 0xD3, 0x9A, 0x72, 0xEF, 0xEB, 0xB8, 0xDD, 0x18, 0x2B, 0xD5, 0xBB, 0x2E, 0x23, 0x4E, 0x9F, 0xC8, 0x4F, 0xC2, 0xDC, 0x85, 0x6D, 0x1E},
+		{0xBB, 0xBA, 0xFA, 0x54, 0x54, 0x3F, 0x1C, 0x8A, 0x80, 0xBF, 0x05, 0xBF, 0x93, 0xFB, 0x46, 0xFD, 0xA9, 0x8A, 0x05, 0xA9, 0x09, 0x35, 0xFE, 0xF0, 0xA5, 0x0D, 0x2A, 0x55, 0x73, 0xCE, 0xA3, 0x9A, 0x26, 0x42, 0x10, 0x39, 0x26, 0xFF, 0x37, 0x85, 0x6F, 0xAF, 0x0C, 0x2D, 0x1C, 0x0B, 0xCB, 0x38, 0xCE, 0xA0, 0x45, 0xFE, 0x28, 0xE6, 0x31, 0x61, 0x64, 0x54, 0x2E, 0x63, 0xB5, 0x3B, 0x74, 0xB9},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0x4F, 0xD0, 0x47, 0x1C, 0x89, 0x77, 0xAD, 0xA9, 0x9A, 0xCC, 0x4E, 0xBB, 0x8E, 0xBB, 0xB9, 0x4A, 0x3D, 0x12, 0x55, 0xF4, 0x7F, 0x7E, 0xDB, 0x76, 0xF1, 0x7E, 0x4A, 0x6B, 0x7E, 0xE0, 0x9D, 0x76},
+		{0x2A, 0xD9, 0xCC, 0x8B, 0xFD, 0x11, 0x43, 0x69, 0x8F, 0xB6, 0xD2, 0x86, 0x30, 0xA7, 0x10, 0xDB, 0xFB, 0x6D, 0xB8, 0x50, 0xAA, 0xD9, 0xF2, 0x5F, 0xA2, 0xCB, 0xF4, 0x4A, 0x79, 0x6A, 0xCD, 0x5B, 0x20, 0xC0, 0x91, 0x29, 0xEF, 0x49, 0x6C, 0x5C, 0x48, 0xCE, 0xE9, 0x20, 0x8B, 0x41, 0x7C, 0x4C, 0xC6, 0x79, 0xA1, 0x95, 0xB3, 0x5A, 0x62, 0x7F, 0x11, 0x59, 0x40, 0xE4, 0x7F, 0x92, 0xBC, 0x00},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0x06, 0xBC, 0x44, 0x73, 0x0F, 0xA1, 0x99, 0x51, 0x28, 0xC7, 0x21, 0xE8, 0x25, 0x99, 0x2B, 0xB7, 0xAF, 0x7A, 0x27, 0x3D, 0x21, 0x4F, 0x19, 0x4E, 0xC7, 0x63, 0x72, 0xBF, 0xA9, 0xF0, 0x80, 0xC0},
+		{0xDE, 0x72, 0x87, 0xD9, 0xCF, 0x13, 0x70, 0x37, 0x64, 0x24, 0x99, 0x53, 0xE7, 0xDC, 0x96, 0xE7, 0x77, 0xF1, 0x58, 0x9F, 0xE2, 0x9F, 0xA1, 0x21, 0x79, 0x1B, 0x40, 0x91, 0xE0, 0x6B, 0x50, 0xA9, 0x1A, 0xEA, 0xFB, 0xE1, 0x3D, 0xCE, 0x9F, 0xF8, 0x5C, 0xBC, 0x09, 0x41, 0xD4, 0x2D, 0x58, 0xE8, 0x1B, 0xDB, 0xA3, 0xD9, 0xAF, 0xF8, 0x15, 0x72, 0xF4, 0x34, 0xCF, 0x19, 0x64, 0x62, 0x01, 0x5B},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0xBD, 0xD5, 0x2E, 0x2E, 0xD0, 0x7B, 0x5E, 0x99, 0x20, 0x57, 0xCC, 0x99, 0x76, 0x5A, 0x97, 0x6B, 0xF3, 0x1F, 0xBB, 0xBD, 0x53, 0xE7, 0xBA, 0x77, 0xAB, 0x8F, 0x20, 0xC0, 0xBC, 0xB9, 0x68, 0xCA},
+		{0xF1, 0x28, 0xAC, 0x68, 0x0C, 0x61, 0xC4, 0xDE, 0x5A, 0xB4, 0xAC, 0x6C, 0xFD, 0xBF, 0x8D, 0xCF, 0x2E, 0xA7, 0x7C, 0xF8, 0x74, 0x9F, 0xB8, 0x81, 0xAA, 0x69, 0xB2, 0x4C, 0xA1, 0xC9, 0x47, 0x38, 0xE2, 0x54, 0x8D, 0xAD, 0x55, 0x30, 0xDF, 0xE9, 0xED, 0x62, 0x76, 0x41, 0x77, 0x24, 0x95, 0xB4, 0x00, 0xFC, 0x8B, 0xAE, 0x16, 0x8B, 0x08, 0x64, 0xCE, 0x4F, 0x61, 0xCD, 0xD5, 0xEB, 0xE9, 0x6D},
+		{0xD4, 0xA7, 0x8C, 0xD8, 0x0E, 0x9D, 0xD3, 0x84, 0x4D, 0xBC, 0x84, 0x0E, 0x94, 0x6A, 0xE2, 0x38, 0x37, 0x3E, 0xCF, 0xCE, 0x81, 0x43, 0x28, 0x50, 0xAC, 0xF2, 0x0A, 0x71, 0xDF, 0xD3, 0x9C, 0xB8, 0xCB, 0xFD, 0x50, 0xE3, 0x47, 0xC2, 0xE5, 0x47, 0xEE, 0x43, 0x8D, 0x74, 0xBB, 0x38, 0x9F, 0x0C, 0x22, 0xB4, 0x1F, 0xFC, 0x4D, 0x9E, 0x23, 0xCE, 0xFB, 0xE3, 0xE9, 0x68, 0x5D, 0x13, 0x2A, 0x9B}
+	},
+	{
+		{0x80, 0x65, 0x0A, 0x7D, 0xAF, 0x48, 0xB9, 0xC1, 0xF4, 0xA5, 0x76, 0x13, 0x1A, 0x7A, 0xCD, 0xC0, 0xC9, 0xC0, 0x10, 0x00, 0x9B, 0xF8, 0xD5, 0xC7, 0x6A, 0xD2, 0x81, 0xD4, 0x66, 0xA5, 0xD5, 0x17},
+		{0x71, 0xA5, 0x80, 0xF8, 0xC5, 0x45, 0xF3, 0x0A, 0x73, 0x03, 0x37, 0xA6, 0xCC, 0xBE, 0x50, 0x54, 0x47, 0x18, 0x69, 0x03, 0xFF, 0x0B, 0x39, 0x32, 0xF0, 0x8A, 0x35, 0xBD, 0x87, 0x7D, 0xE7, 0xF6, 0xAC, 0xC5, 0xB1, 0xC9, 0x3A, 0xB3, 0x37, 0x21, 0xEB, 0xAE, 0x3E, 0x32, 0x6D, 0x11, 0x07, 0x1C, 0x26, 0x7C, 0xFF, 0x7F, 0xB0, 0xDD, 0xA6, 0x26, 0xD3, 0x65, 0xC6, 0x61, 0xE5, 0x0C, 0x13, 0xF5},
+		{0x51, 0x3D, 0x85, 0xF1, 0x74, 0xF5, 0x9D, 0x3B, 0x35, 0x9A, 0xFA, 0x63, 0x83, 0xEE, 0x6E, 0x1E, 0x99, 0x52, 0xF6, 0x11, 0x00, 0xE6, 0x5D, 0x1C, 0x00, 0x61, 0x2F, 0x7B, 0x80, 0xEB, 0xBC, 0x4D, 0xE6, 0x09, 0xE3, 0x66, 0x2D, 0x3E, 0x1C, 0xB4, 0xD5, 0x64, 0x16, 0x87, 0x60, 0xEB, 0xEB, 0x45, 0x24, 0x1E, 0xE3, 0x58, 0xF2, 0x11, 0xDF, 0x1C, 0x08, 0xFB, 0x60, 0x81, 0xBC, 0xE4, 0x66, 0xAB}
+	},
+	{
+		{0x08, 0xB8, 0xA3, 0xE5, 0x36, 0xF6, 0xB3, 0x9D, 0x16, 0xAD, 0xB5, 0x8E, 0x38, 0xD3, 0x2B, 0x6A, 0x53, 0x62, 0xA3, 0xB9, 0xC7, 0x1E, 0xB3, 0x26, 0xA1, 0xCB, 0xB5, 0x04, 0xC2, 0xA2, 0x98, 0xF3},
+		{0x7F, 0x34, 0x71, 0x3B, 0xD9, 0x5B, 0x33, 0xA9, 0x36, 0xD9, 0x94, 0xA1, 0x50, 0x16, 0xBE, 0xFB, 0xD5, 0x7D, 0xB3, 0xAD, 0x8B, 0xF4, 0x37, 0xD5, 0x1D, 0x04, 0x90, 0x91, 0x92, 0x5B, 0x6D, 0x36, 0x6E, 0x7B, 0xF1, 0x3D, 0x19, 0xA7, 0xAD, 0xF6, 0x14, 0x21, 0x14, 0xC7, 0x7D, 0x60, 0x13, 0x16, 0xE5, 0xE1, 0xF1, 0x1C, 0x02, 0x6B, 0x4E, 0xE1, 0x14, 0xC9, 0xA5, 0xDE, 0x47, 0xFC, 0x1B, 0x30},
+		{0xFF, 0x20, 0x25, 0x42, 0x24, 0xC6, 0x28, 0xB1, 0xE3, 0xF1, 0x15, 0x71, 0x66, 0x93, 0x4C, 0xEE, 0x22, 0xE5, 0xE6, 0xFD, 0x3B, 0xC6, 0x0F, 0x3F, 0xF9, 0x07, 0x86, 0x65, 0xE7, 0x44, 0xC6, 0x64, 0x3F, 0xD9, 0x62, 0x87, 0x2D, 0x86, 0xC9, 0x9B, 0x18, 0xDE, 0x27, 0x17, 0x5F, 0x39, 0x29, 0x35, 0x8C, 0xCC, 0xA1, 0x3B, 0x5D, 0x5C, 0x72, 0x8B, 0x33, 0x27, 0x85, 0x19, 0xD0, 0x9B, 0xA2, 0x81}
+	},
+	{
+		{0x35, 0xC9, 0x29, 0x8B, 0x37, 0x82, 0xFD, 0x32, 0x51, 0x48, 0x10, 0x73, 0xEF, 0x14, 0xF5, 0x11, 0xE3, 0x81, 0x3C, 0x0B, 0x7A, 0x2A, 0x1C, 0x58, 0xDA, 0x1B, 0x34, 0xF0, 0xEB, 0xEE, 0x7C, 0x4A},
+		{0xC0, 0x65, 0x65, 0x4A, 0xE5, 0xDA, 0xA6, 0x2E, 0xA0, 0x9F, 0x74, 0xF3, 0xED, 0x6C, 0x38, 0x11, 0x4B, 0x9E, 0xCE, 0x0A, 0x87, 0xFA, 0xEF, 0xC6, 0x5B, 0x6C, 0x17, 0x48, 0xB0, 0x50, 0xF8, 0x34, 0x3D, 0xE8, 0xE7, 0x71, 0x46, 0x44, 0xF9, 0x53, 0xD4, 0x25, 0x5B, 0xBB, 0x8C, 0x7C, 0xA4, 0x9E, 0x13, 0x4A, 0xF5, 0x16, 0x98, 0xCC, 0xC5, 0xFE, 0x91, 0x5C, 0xC1, 0x43, 0x26, 0x8C, 0x0F, 0x93},
+		{0x5D, 0x15, 0x4D, 0xB3, 0xFC, 0x56, 0xA1, 0x4B, 0xE3, 0x85, 0xE8, 0x5B, 0x1B, 0xA3, 0x0D, 0x7C, 0xB7, 0x99, 0x93, 0x7E, 0x57, 0xEF, 0x04, 0xD9, 0xD5, 0x3C, 0x5A, 0xF7, 0x75, 0x3D, 0x0A, 0xE3, 0x52, 0x34, 0xB5, 0xF3, 0x8C, 0xFC, 0xCD, 0x5C, 0x8C, 0xFE, 0xF7, 0xC0, 0x9C, 0x2D, 0x69, 0x2B, 0x40, 0x96, 0x49, 0xB0, 0xDC, 0x21, 0xDE, 0x4B, 0x7E, 0x78, 0x3E, 0x16, 0x56, 0x01, 0xC6, 0xF3}
+	},
+	{
+		{0xF5, 0xDE, 0xA4, 0x03, 0x6A, 0x84, 0x3F, 0x15, 0xC4, 0x08, 0x51, 0xF3, 0xF7, 0xAD, 0x3A, 0xB8, 0xA6, 0x18, 0x16, 0x7C, 0x37, 0xC9, 0x38, 0xFE, 0x4B, 0x1B, 0x3E, 0x3D, 0x83, 0x71, 0x7A, 0xC7},
+		{0x53, 0xAC, 0x1E, 0x2F, 0x3C, 0x39, 0x2C, 0x8D, 0x2C, 0x1F, 0x14, 0xA2, 0x59, 0x18, 0x53, 0x39, 0xA5, 0x38, 0xF4, 0xE8, 0xB3, 0x53, 0x86, 0x14, 0x89, 0x6D, 0x7D, 0x70, 0x33, 0x8E, 0x5A, 0x42, 0x8D, 0x04, 0x4E, 0x80, 0x7A, 0x5D, 0x53, 0x07, 0xF2, 0x71, 0xE4, 0xA8, 0x39, 0x81, 0xDB, 0x93, 0x41, 0x5E, 0xFC, 0x10, 0x9B, 0x70, 0xBB, 0xA1, 0x8E, 0x3B, 0x69, 0x79, 0x3B, 0xE2, 0xF2, 0xEC},
+		{0x98, 0x20, 0x13, 0xEF, 0x11, 0x0A, 0xB4, 0x01, 0xA2, 0x97, 0xA9, 0xED, 0x75, 0x63, 0x09, 0xD8, 0x1E, 0x98, 0x1F, 0x83, 0x8E, 0x68, 0xD3, 0x2E, 0x58, 0x74, 0x3C, 0xF9, 0xE6, 0x40, 0x94, 0x0D, 0xC7, 0x16, 0x0C, 0xF3, 0x86, 0xCC, 0x16, 0xC1, 0xF0, 0x23, 0x42, 0xA7, 0x2E, 0xE4, 0x88, 0x01, 0xC0, 0xA4, 0x48, 0xC5, 0x4D, 0x8F, 0xBB, 0x5E, 0x06, 0x74, 0x5A, 0x8C, 0xF6, 0x8D, 0xCD, 0x48}
+	},
+	{
+		{0x62, 0x24, 0xB1, 0xD6, 0x66, 0xCC, 0x1E, 0x57, 0x50, 0x30, 0x55, 0x5A, 0x18, 0x05, 0x3B, 0x42, 0x50, 0xFE, 0xB4, 0xD9, 0xBD, 0x52, 0x9B, 0x10, 0x05, 0xFD, 0x1E, 0x78, 0x6F, 0xA9, 0x95, 0xAB},
+		{0xCF, 0x86, 0xD5, 0x62, 0x43, 0x66, 0x74, 0xBA, 0x8F, 0x47, 0xE8, 0x3E, 0xC5, 0x31, 0x40, 0x08, 0xA7, 0x08, 0x3A, 0x41, 0xC8, 0xAD, 0x25, 0xB9, 0xD6, 0x23, 0xC8, 0xFE, 0xFC, 0x1B, 0x0D, 0xFC, 0x10, 0xF5, 0xBD, 0x8A, 0x0F, 0x36, 0x30, 0xE3, 0xE0, 0x47, 0x4B, 0x40, 0x78, 0x1D, 0xC7, 0xC5, 0x5F, 0x09, 0x33, 0x6E, 0x91, 0x5A, 0x20, 0xF0, 0x15, 0x98, 0x13, 0xD5, 0xF2, 0x8F, 0xB8, 0x28},
+		{0x91, 0xA3, 0xBF, 0x54, 0xAE, 0x66, 0xF8, 0xFE, 0x99, 0x6B, 0xF6, 0x5A, 0xA7, 0x37, 0xFF, 0xD6, 0x0D, 0x10, 0xE3, 0x5C, 0x75, 0x2B, 0x29, 0x9B, 0xB9, 0xE7, 0x15, 0xB8, 0xC9, 0xDF, 0xC0, 0xFA, 0x72, 0x74, 0x53, 0x6C, 0xF8, 0x7B, 0xF6, 0xB8, 0x8C, 0x31, 0xA5, 0xEE, 0x94, 0x0E, 0x03, 0xA0, 0x7D, 0x7D, 0x38, 0xB4, 0xCB, 0x58, 0x5B, 0xDD, 0xA6, 0x5E, 0x87, 0xCF, 0xB9, 0x5F, 0x8D, 0xCE}
+	},
+	{
+		{0x78, 0xC5, 0x39, 0xEF, 0xFC, 0xE0, 0x8F, 0x36, 0x81, 0x2F, 0x1A, 0x33, 0xB7, 0x4B, 0x79, 0x6B, 0x88, 0x11, 0xE2, 0x62, 0x25, 0x18, 0x92, 0xEA, 0x61, 0xF1, 0xCC, 0xEE, 0x23, 0xC1, 0xCA, 0x1F},
+		{0x28, 0xC6, 0x7B, 0xA5, 0x4E, 0xB4, 0xE8, 0x5C, 0x4E, 0xE4, 0xDE, 0x5F, 0x49, 0x0A, 0x6D, 0xB3, 0x7A, 0xBE, 0x8C, 0x2F, 0xD2, 0x30, 0x91, 0x05, 0x2F, 0xB4, 0x8D, 0xA6, 0x5D, 0x11, 0xA7, 0xB3, 0xBF, 0x4E, 0x4E, 0x86, 0x0E, 0x3A, 0x14, 0xFE, 0xB2, 0x1D, 0xB1, 0x61, 0x81, 0x95, 0xDA, 0x25, 0xFF, 0xBF, 0x3A, 0xAD, 0xBB, 0xBA, 0x40, 0x04, 0x00, 0xE6, 0xA9, 0x73, 0x99, 0xB1, 0x43, 0x20},
+		{0x00, 0xCC, 0x50, 0xCF, 0x41, 0x3B, 0xD2, 0x3C, 0xA1, 0x71, 0x3A, 0xD7, 0xDD, 0xDC, 0xDA, 0x66, 0xFA, 0xA1, 0x0A, 0x25, 0x0D, 0xF9, 0xBF, 0xE2, 0xC3, 0xEF, 0xF2, 0x6B, 0x63, 0xB1, 0x16, 0x20, 0x04, 0x29, 0x2E, 0x5D, 0xA7, 0x98, 0x70, 0xEA, 0xAE, 0x2E, 0xEF, 0x5F, 0xD4, 0xF1, 0x4D, 0x3B, 0xFB, 0x23, 0x46, 0x2F, 0x0F, 0xBE, 0xE1, 0xC8, 0xF2, 0xBD, 0x1F, 0xF5, 0x3B, 0xE5, 0x80, 0x5D}
+	},
+	{
+		{0xFF, 0x4A, 0x92, 0xD6, 0x20, 0x9C, 0x69, 0x5D, 0xB3, 0xFD, 0xA1, 0x1A, 0x90, 0x03, 0x3C, 0x57, 0x95, 0x8B, 0xD3, 0xFA, 0x19, 0x69, 0x79, 0x7F, 0xB7, 0x5D, 0x3E, 0x47, 0x95, 0x59, 0x2C, 0x20},
+		{0x22, 0xC4, 0x45, 0x5D, 0xAF, 0xCD, 0x1D, 0x59, 0x6E, 0x7A, 0x1B, 0x9D, 0x87, 0x5E, 0xE2, 0x30, 0x25, 0x72, 0x42, 0x14, 0x4C, 0xD1, 0xFC, 0xF2, 0xB9, 0x45, 0x0D, 0xF9, 0xF7, 0xC9, 0x59, 0xE5, 0x42, 0x46, 0x42, 0x9C, 0xDE, 0xC2, 0x96, 0x40, 0x16, 0x30, 0x0C, 0x08, 0x72, 0xFE, 0x07, 0x8E, 0x7F, 0xB4, 0x01, 0xBC, 0x34, 0x78, 0x3B, 0xD3, 0xA6, 0x58, 0x48, 0x49, 0x9D, 0x49, 0xD5, 0xA9},
+		{0xBD, 0xCC, 0xCC, 0x00, 0x61, 0xE1, 0xFE, 0x12, 0x31, 0x52, 0x63, 0x48, 0xA0, 0x62, 0xBA, 0x7C, 0x7D, 0x01, 0xBA, 0x00, 0x8F, 0x7E, 0x74, 0x20, 0x20, 0xE0, 0xA8, 0x0C, 0x44, 0x99, 0xCB, 0x2D, 0xD5, 0x2A, 0xAF, 0xF7, 0x49, 0x19, 0xA5, 0xB3, 0x42, 0x21, 0x89, 0x1B, 0x65, 0x39, 0xCC, 0xF2, 0xE2, 0x85, 0xA2, 0xB1, 0x7A, 0x1A, 0x13, 0x83, 0x1E, 0xBA, 0xB6, 0x33, 0xF5, 0x27, 0x93, 0xF4}
+	},
+	{
+		{0xA2, 0xBD, 0xEE, 0x3C, 0xF4, 0x88, 0xAD, 0x2E, 0xE9, 0xC5, 0xC8, 0xDC, 0xBA, 0x8E, 0xE8, 0x89, 0x98, 0xD7, 0x10, 0xF2, 0x72, 0x10, 0xFC, 0x9A, 0xA6, 0x61, 0x9B, 0x79, 0x8F, 0xAA, 0xBE, 0x85},
+		{0x0A, 0x0C, 0x57, 0x3D, 0x69, 0x01, 0x59, 0x4F, 0xDD, 0xBB, 0xC7, 0x03, 0xDB, 0x4C, 0xCD, 0x48, 0x87, 0x7B, 0x97, 0x6D, 0xAB, 0x2A, 0x96, 0xD0, 0x3F, 0x6A, 0xF5, 0x8C, 0x3D, 0xD8, 0x03, 0xD2, 0x8F, 0x82, 0xC3, 0xEA, 0x28, 0x42, 0x2E, 0x3E, 0x48, 0x22, 0x98, 0x88, 0x7F, 0xA1, 0xC9, 0x71, 0x14, 0xAA, 0xD3, 0xA9, 0x1B, 0xFD, 0x15, 0x0B, 0xF1, 0xC8, 0xB6, 0x16, 0x7C, 0x97, 0xD5, 0x3C},
+		{0xE5, 0xB3, 0x07, 0x6D, 0xB7, 0x8F, 0x90, 0x38, 0xE0, 0x2E, 0x73, 0xE2, 0x74, 0xC7, 0x95, 0xAB, 0x09, 0x2F, 0x10, 0x5D, 0x2F, 0xB8, 0xB0, 0xB4, 0x43, 0xFA, 0x8C, 0x37, 0x80, 0xFB, 0xD8, 0x25, 0x26, 0xCA, 0x9B, 0x34, 0x99, 0xDF, 0xB8, 0x68, 0x99, 0xA3, 0x6C, 0xEE, 0x15, 0x4E, 0x35, 0x97, 0x5C, 0x2C, 0x8A, 0xEC, 0x72, 0x0D, 0x20, 0x2E, 0xB9, 0xEC, 0x01, 0x7C, 0xCB, 0xE6, 0x74, 0x85}
+	}
+};
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double ecc108_verify_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function prints a result line.
+ * \param[in] name name of the method
+ * \param[in] elapsed time to verify the batch
+ * \param[in] baseline time of the basic verification
+ */
+static void ecc108_verify_benchmark_print(const char *name, double elapsed, double baseline)
+{
+	printf("%-22s %12.0f %10.2f\n", name, ECC108_VERIFY_BENCHMARK_RECORDS / elapsed, baseline / elapsed);
+}
+
+
+/** \brief This function checks the verification functions against each other and measures them.
+ * \param[in] argc number of arguments
+ * \param[in] argv optional maximum number of threads
+ * @return exit status of application, 1 if a result differs
+ */
+int main(int argc, char *argv[])
+{
+	static struct ecc108v_key_table table;
+	struct ecc108v_record *records = malloc(ECC108_VERIFY_BENCHMARK_RECORDS * sizeof(*records));
+	uint8_t *passed = malloc(ECC108_VERIFY_BENCHMARK_RECORDS / 8);
+	uint8_t *expected = malloc(ECC108_VERIFY_BENCHMARK_RECORDS / 8);
+	const struct ecc108_verify_benchmark_vector *vector;
+	long threads_max = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+	uint32_t i, failed;
+	double start, baseline, elapsed;
+	uint8_t threads;
+	char name[32];
+	int ret_code = 0;
+
+	if (!records || !passed || !expected) {
+		printf("out of memory\n");
+		return 1;
+	}
+	if (threads_max < 1)
+		threads_max = 1;
+	if (threads_max > ECC108V_THREADS_MAX)
+		threads_max = ECC108V_THREADS_MAX;
+
+	// Load the root key and time its comb table.
+	ecc108v_key_table_init(&table);
+	start = ecc108_verify_benchmark_now();
+	if (ecc108v_key_table_load(&table, 0, ecc108_verify_benchmark_vectors[0].public_key) != ECC108_SUCCESS) {
+		printf("root key rejected\n");
+		return 1;
+	}
+	printf("comb table of the root key built in %.2f ms\n", (ecc108_verify_benchmark_now() - start) * 1e3);
+
+	// Every 16th signature is corrupted.
+	memset(expected, 0, ECC108_VERIFY_BENCHMARK_RECORDS / 8);
+	for (i = 0; i < ECC108_VERIFY_BENCHMARK_RECORDS; i++) {
+		vector = &ecc108_verify_benchmark_vectors[(i * 7) % ECC108_VERIFY_BENCHMARK_VECTORS];
+		memcpy(records[i].digest, vector->digest, P256_INT_SIZE);
+		memcpy(records[i].signature, vector->signature, P256_SIGNATURE_SIZE);
+		memcpy(records[i].public_key, vector->public_key, P256_KEY_SIZE);
+		records[i].key_index = (vector < &ecc108_verify_benchmark_vectors[ECC108_VERIFY_BENCHMARK_ROOT])
+				? 0 : ECC108V_KEY_NONE;
+		if ((i & 0x0F) == 0x0F)
+			records[i].signature[i % P256_SIGNATURE_SIZE] ^= 0x04;
+		else
+			expected[i >> 3] |= (uint8_t) (1 << (i & 7));
+	}
+
+	printf("%-22s %12s %10s\n", "method", "signatures/s", "speedup");
+
+	start = ecc108_verify_benchmark_now();
+	for (i = 0, failed = 0; i < ECC108_VERIFY_BENCHMARK_RECORDS; i++) {
+		if ((p256_verify_basic(records[i].digest, records[i].signature, records[i].public_key) == P256_SUCCESS)
+				!= ((expected[i >> 3] >> (i & 7)) & 1))
+			failed++;
+	}
+	baseline = ecc108_verify_benchmark_now() - start;
+	if (failed) {
+		printf("%-22s FAILED\n", "basic");
+		ret_code = 1;
+	}
+	else
+		ecc108_verify_benchmark_print("basic", baseline, baseline);
+
+	start = ecc108_verify_benchmark_now();
+	for (i = 0, failed = 0; i < ECC108_VERIFY_BENCHMARK_RECORDS; i++) {
+		if ((p256_verify(records[i].digest, records[i].signature, records[i].public_key, NULL) == P256_SUCCESS)
+				!= ((expected[i >> 3] >> (i & 7)) & 1))
+			failed++;
+	}
+	elapsed = ecc108_verify_benchmark_now() - start;
+	if (failed) {
+		printf("%-22s FAILED\n", "base comb");
+		ret_code = 1;
+	}
+	else
+		ecc108_verify_benchmark_print("base comb", elapsed, baseline);
+
+	start = ecc108_verify_benchmark_now();
+	for (i = 0, failed = 0; i < ECC108_VERIFY_BENCHMARK_RECORDS; i++) {
+		if ((p256_verify(records[i].digest, records[i].signature, records[i].public_key,
+				records[i].key_index ? NULL : &table.comb[0]) == P256_SUCCESS)
+				!= ((expected[i >> 3] >> (i & 7)) & 1))
+			failed++;
+	}
+	elapsed = ecc108_verify_benchmark_now() - start;
+	if (failed) {
+		printf("%-22s FAILED\n", "base and root comb");
+		ret_code = 1;
+	}
+	else
+		ecc108_verify_benchmark_print("base and root comb", elapsed, baseline);
+
+	for (threads = 1; threads <= threads_max; threads++) {
+		memset(passed, 0xA5, ECC108_VERIFY_BENCHMARK_RECORDS / 8);
+		start = ecc108_verify_benchmark_now();
+		ecc108v_verify(threads, &table, ECC108_VERIFY_BENCHMARK_RECORDS, records, passed);
+		elapsed = ecc108_verify_benchmark_now() - start;
+
+		sprintf(name, "batch, %u thread%s", threads, threads > 1 ? "s" : "");
+		if (memcmp(passed, expected, ECC108_VERIFY_BENCHMARK_RECORDS / 8)) {
+			printf("%-22s FAILED\n", name);
+			ret_code = 1;
+			continue;
+		}
+		ecc108_verify_benchmark_print(name, elapsed, baseline);
+	}
+
+	free(expected);
+	free(passed);
+	free(records);
+
+	return ret_code;
+}
@@ -0,0 +1,601 @@
+/** \file
+ *  \brief  Host Application That Runs ECC108 Flows against Virtual Devices
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It runs the lock, personalize, and
+ * authentication flows of the ECC108 training (Sign_Verify) and the DeriveKey example
+ * of ecc108_examples.c against virtual ATECC108 devices, through the unmodified
+ * Communication and Command Marshaling layers. Every signature a device returns is
+ * also verified with p256_verify() on the host. Then it measures how many Sign and
+ * Verify flows per second the stack executes, at memory speed and, in the timing-accurate
+ * mode of the virtual device, in virtual time. Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -DECC108_VIRTUAL -ILibraries/ecc108_library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/ecc108_virtual_device_benchmark_main.c
+ *       Libraries/ecc108_library/ecc108_virtual_device.c Libraries/ecc108_library/ecc108_comm.c
+ *       Libraries/ecc108_library/ecc108_comm_marshaling.c Libraries/ecc108_library/ecc108_helper.c
+ *       Libraries/ecc108_library/ecc108_examples.c Libraries/utilities/p256.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/cryptoauth_core.c
+ *       Libraries/utilities/cryptoauth_crc.c Libraries/utilities/timer_utilities_host.c
+ *       -o ecc108_virtual_device_benchmark
+ *   ./ecc108_virtual_device_benchmark
+ *
+ * The application returns 1 if a result differs.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+
+#include "ecc108_virtual_device.h"     // definitions and declarations for the Virtual Device module
+#include "ecc108_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+#include "ecc108_helper.h"             // definitions and declarations for the Helper module
+#include "ecc108_physical.h"           // declarations that are common to all interface implementations
+#include "ecc108_lib_return_codes.h"   // declarations of function return codes
+#include "ecc108_examples.h"           // definitions and declarations for example functions
+#include "p256.h"                      // definitions and declarations for the P-256 module
+#include "timer_utilities_host.h"      // declarations of the virtual clock
+
+
+//! ID of the device that runs the training flows
+#define VIRTUAL_BENCHMARK_DEVICE       ECC108D_DEFAULT_ID
+
+//! number of Sign and Verify flows per measurement
+#define VIRTUAL_BENCHMARK_FLOWS        (200)
+
+//! number of Auth flows per measurement in timing-accurate mode
+#define VIRTUAL_BENCHMARK_TIMED_FLOWS  (20)
+
+//! acceleration factor of the real-time check
+#define VIRTUAL_BENCHMARK_ACCELERATION (100)
+
+//! size of a public key or signature slot as the training writes it: eight zeros, then 64 bytes
+#define VIRTUAL_BENCHMARK_SLOT_SIZE    (ECC108D_SLOT_SIZE_PUBLIC)
+
+//! offset of the key or signature in such a slot
+#define VIRTUAL_BENCHMARK_SLOT_OFFSET  (8)
+
+/** \name Slots of the Training Configuration
+@{ */
+#define VIRTUAL_BENCHMARK_KEY_ROOT_PRIVATE  (0)   //!< root private key, written with PrivWrite
+#define VIRTUAL_BENCHMARK_KEY_PRIVATE       (1)   //!< device private key, generated with GenKey
+#define VIRTUAL_BENCHMARK_KEY_ROOT_PUBLIC   (8)   //!< root public key
+#define VIRTUAL_BENCHMARK_KEY_PUBLIC        (9)   //!< device public key
+#define VIRTUAL_BENCHMARK_KEY_SIGNATURE     (10)  //!< signature of the device public key by the root key
+#define VIRTUAL_BENCHMARK_KEY_STORED        (11)  //!< device public key in the layout stored Verify reads
+/** @} */
+
+//! configuration words the training lock() writes, byte address followed by four bytes
+static const uint8_t virtual_benchmark_config[][1 + ECC108_ZONE_ACCESS_4] = {
+	{0x14, 0xC3, 0x0F, 0xC3, 0x2F},   // SlotConfig 0, 1: private keys, external signatures, GenKey for slot 1
+	{0x60, 0x33, 0x0F, 0x33, 0x0F},   // KeyConfig 0, 1: P-256 private keys
+	{0x24, 0x0F, 0x0F, 0x0F, 0x0F},   // SlotConfig 8, 9: readable, writable in the clear
+	{0x70, 0x32, 0x0F, 0x32, 0x0F},   // KeyConfig 8, 9: P-256 public keys
+	{0x28, 0x0F, 0x0F, 0x0F, 0x0F},   // SlotConfig 10, 11
+	{0x74, 0x32, 0x0F, 0x32, 0x0F},   // KeyConfig 10, 11
+	{0x2C, 0x0F, 0x0F, 0x0F, 0x0F},   // SlotConfig 12, 13
+	{0x78, 0x32, 0x0F, 0x32, 0x0F},   // KeyConfig 12, 13
+	{0x30, 0x0F, 0x4F, 0x0F, 0x8F},   // SlotConfig 14, 15
+	{0x7C, 0x3E, 0x0F, 0x3E, 0x0F}    // KeyConfig 14, 15: no ECC keys
+};
+
+//! root private key of the training, preceded by four pad bytes
+static const uint8_t virtual_benchmark_root_key[PRIVWRITE_VALUE_SIZE] = {
+	0x00, 0x00, 0x00, 0x00,
+	0xEC, 0x77, 0x3D, 0xC3, 0xF1, 0x13, 0x5E, 0xC0,
+	0x87, 0x99, 0x17, 0xEE, 0x15, 0x30, 0xA5, 0x12,
+	0xAC, 0xEE, 0xEB, 0x87, 0x3E, 0x7C, 0xB3, 0x73,
+	0x80, 0x74, 0x0A, 0xCE, 0x1B, 0x35, 0x68, 0x77
+};
+
+//! number of failed checks
+static unsigned int virtual_benchmark_failures;
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double virtual_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function records the result of a check.
+ * \param[in] name name of the check
+ * \param[in] passed whether the check passed
+ */
+static void virtual_benchmark_check(const char *name, int passed)
+{
+	printf("%-44s %s\n", name, passed ? "ok" : "FAILED");
+	if (!passed)
+		virtual_benchmark_failures++;
+}
+
+
+/** \brief This function writes a 72-byte slot in three 32-byte blocks.
+ *
+ * The Write wrapper of the Command Marshaling layer cannot address blocks
+ * above 0, so the function uses ecc108m_execute().
+ * \param[in] key_id slot
+ * \param[in] value pointer to 72 bytes
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_write_slot(uint8_t key_id, const uint8_t *value)
+{
+	uint8_t command[WRITE_COUNT_LONG];
+	uint8_t response[WRITE_RSP_SIZE];
+	uint8_t block[ECC108_ZONE_ACCESS_32];
+	uint8_t i;
+	uint8_t ret_code = ECC108_SUCCESS;
+
+	for (i = 0; (i * ECC108_ZONE_ACCESS_32 < VIRTUAL_BENCHMARK_SLOT_SIZE) && (ret_code == ECC108_SUCCESS); i++) {
+		memset(block, 0, sizeof(block));
+		memcpy(block, &value[i * ECC108_ZONE_ACCESS_32],
+				VIRTUAL_BENCHMARK_SLOT_SIZE - i * ECC108_ZONE_ACCESS_32 < ECC108_ZONE_ACCESS_32
+				? VIRTUAL_BENCHMARK_SLOT_SIZE - i * ECC108_ZONE_ACCESS_32 : ECC108_ZONE_ACCESS_32);
+		ret_code = ecc108m_execute(ECC108_WRITE, ECC108_ZONE_COUNT_FLAG | ECC108_ZONE_DATA, (i << 8) | (key_id << 3),
+				sizeof(block), block, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+	}
+
+	return ret_code;
+}
+
+
+/** \brief This function reads a 72-byte slot in three 32-byte blocks.
+ * \param[in] key_id slot
+ * \param[out] value pointer to 72-byte buffer
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_read_slot(uint8_t key_id, uint8_t *value)
+{
+	uint8_t command[READ_COUNT];
+	uint8_t response[READ_32_RSP_SIZE];
+	uint8_t i;
+	uint8_t ret_code = ECC108_SUCCESS;
+
+	for (i = 0; (i * ECC108_ZONE_ACCESS_32 < VIRTUAL_BENCHMARK_SLOT_SIZE) && (ret_code == ECC108_SUCCESS); i++) {
+		ret_code = ecc108m_execute(ECC108_READ, ECC108_ZONE_COUNT_FLAG | ECC108_ZONE_DATA, (i << 8) | (key_id << 3),
+				0, NULL, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+		memcpy(&value[i * ECC108_ZONE_ACCESS_32], &response[ECC108_BUFFER_POS_DATA],
+				VIRTUAL_BENCHMARK_SLOT_SIZE - i * ECC108_ZONE_ACCESS_32 < ECC108_ZONE_ACCESS_32
+				? VIRTUAL_BENCHMARK_SLOT_SIZE - i * ECC108_ZONE_ACCESS_32 : ECC108_ZONE_ACCESS_32);
+	}
+
+	return ret_code;
+}
+
+
+/** \brief This function loads a digest into TempKey with a pass-through Nonce.
+ * \param[in] digest pointer to 32-byte digest
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_nonce(uint8_t *digest)
+{
+	uint8_t command[NONCE_COUNT_LONG];
+	uint8_t response[NONCE_RSP_SIZE_SHORT];
+
+	return ecc108m_nonce(command, response, NONCE_MODE_PASSTHROUGH, digest);
+}
+
+
+/** \brief This function signs the digest in TempKey.
+ * \param[in] key_id slot of the private key
+ * \param[out] signature pointer to 64-byte buffer
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_sign(uint8_t key_id, uint8_t *signature)
+{
+	uint8_t command[SIGN_COUNT];
+	uint8_t response[SIGN_RSP_SIZE];
+	uint8_t ret_code;
+
+	ret_code = ecc108m_execute(ECC108_SIGN, SIGN_MODE_TEMPKEY, key_id, 0, NULL, 0, NULL, 0, NULL,
+			sizeof(command), command, sizeof(response), response);
+	memcpy(signature, &response[ECC108_BUFFER_POS_DATA], SIGN_SIGNATURE_SIZE);
+
+	return ret_code;
+}
+
+
+/** \brief This function verifies a signature of the digest in TempKey with an external public key.
+ * \param[in] signature pointer to 64-byte signature
+ * \param[in] public_key pointer to 64-byte public key
+ * \return status of the operation, #ECC108_CHECKMAC_FAILED if the signature does not match
+ */
+static uint8_t virtual_benchmark_verify(uint8_t *signature, uint8_t *public_key)
+{
+	uint8_t command[VERIFY_COUNT_EXTERNAL];
+	uint8_t response[VERIFY_RSP_SIZE];
+	uint8_t ret_code;
+
+	ret_code = ecc108m_execute(ECC108_VERIFY, VERIFY_MODE_EXTERNAL, VERIFY_KEY_P256,
+			VERIFY_SIGNATURE_SIZE, signature, VERIFY_PUBLIC_KEY_SIZE, public_key, 0, NULL,
+			sizeof(command), command, sizeof(response), response);
+	if ((ret_code == ECC108_SUCCESS) && (response[ECC108_BUFFER_POS_STATUS] != ECC108D_STATUS_BYTE_SUCCESS))
+		ret_code = ECC108_CHECKMAC_FAILED;
+
+	return ret_code;
+}
+
+
+/** \brief This function configures and locks the device as the training lock() does.
+ *
+ * It writes the slot and key configuration, locks the configuration zone, writes
+ * the root private key with PrivWrite, stores the root public key, and locks the data zone.
+ * \param[out] root_public_key pointer to 64-byte buffer for the root public key
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_lock(uint8_t *root_public_key)
+{
+	uint8_t command[PRIVWRITE_COUNT];
+	uint8_t response[GENKEY_RSP_SIZE];
+	uint8_t mac[PRIVWRITE_MAC_SIZE];
+	uint8_t slot[VIRTUAL_BENCHMARK_SLOT_SIZE];
+	uint8_t i;
+	uint8_t ret_code;
+
+	ret_code = ecc108c_wakeup(response);
+	for (i = 0; (i < sizeof(virtual_benchmark_config) / sizeof(virtual_benchmark_config[0]))
+			&& (ret_code == ECC108_SUCCESS); i++)
+		ret_code = ecc108m_write(command, response, ECC108_ZONE_CONFIG, virtual_benchmark_config[i][0],
+				(uint8_t *) &virtual_benchmark_config[i][1], NULL);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_lock(command, response, ECC108_ZONE_CONFIG | LOCK_ZONE_NO_CRC, 0);
+
+	// PrivWrite in the clear ignores the MAC.
+	memset(mac, 0, sizeof(mac));
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_execute(ECC108_PRIVWRITE, 0, VIRTUAL_BENCHMARK_KEY_ROOT_PRIVATE,
+				sizeof(virtual_benchmark_root_key), (uint8_t *) virtual_benchmark_root_key, sizeof(mac), mac, 0, NULL,
+				sizeof(command), command, sizeof(response), response);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_execute(ECC108_GENKEY, GENKEY_MODE_PUBLIC, VIRTUAL_BENCHMARK_KEY_ROOT_PRIVATE,
+				0, NULL, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+	memcpy(root_public_key, &response[ECC108_BUFFER_POS_DATA], GENKEY_PUBLIC_KEY_SIZE);
+
+	memset(slot, 0, sizeof(slot));
+	memcpy(&slot[VIRTUAL_BENCHMARK_SLOT_OFFSET], root_public_key, GENKEY_PUBLIC_KEY_SIZE);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_write_slot(VIRTUAL_BENCHMARK_KEY_ROOT_PUBLIC, slot);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_lock(command, response, LOCK_ZONE_NO_CONFIG | LOCK_ZONE_NO_CRC, 0);
+
+	ecc108p_sleep();
+
+	return ret_code;
+}
+
+
+/** \brief This function personalizes the device as the training personalize() does.
+ *
+ * It generates the device key pair, stores the public key, and signs its digest
+ * with the root key. The signature is stored in the signature slot.
+ * \param[out] public_key pointer to 64-byte buffer for the device public key
+ * \param[out] signature pointer to 64-byte buffer for the signature
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_personalize(uint8_t *public_key, uint8_t *signature)
+{
+	uint8_t command[GENKEY_COUNT];
+	uint8_t response[GENKEY_RSP_SIZE];
+	uint8_t slot[VIRTUAL_BENCHMARK_SLOT_SIZE];
+	uint8_t digest[ECC108_KEY_SIZE];
+	uint8_t ret_code;
+
+	ret_code = ecc108c_wakeup(response);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_random(command, response, RANDOM_SEED_UPDATE);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_execute(ECC108_GENKEY, GENKEY_MODE_PRIVATE, VIRTUAL_BENCHMARK_KEY_PRIVATE,
+				0, NULL, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+	memcpy(public_key, &response[ECC108_BUFFER_POS_DATA], GENKEY_PUBLIC_KEY_SIZE);
+
+	memset(slot, 0, sizeof(slot));
+	memcpy(&slot[VIRTUAL_BENCHMARK_SLOT_OFFSET], public_key, GENKEY_PUBLIC_KEY_SIZE);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_write_slot(VIRTUAL_BENCHMARK_KEY_PUBLIC, slot);
+
+	ecc108h_calculate_sha256(GENKEY_PUBLIC_KEY_SIZE, public_key, digest);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_nonce(digest);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_sign(VIRTUAL_BENCHMARK_KEY_ROOT_PRIVATE, signature);
+
+	memcpy(&slot[VIRTUAL_BENCHMARK_SLOT_OFFSET], signature, SIGN_SIGNATURE_SIZE);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_write_slot(VIRTUAL_BENCHMARK_KEY_SIGNATURE, slot);
+
+	ecc108p_sleep();
+
+	return ret_code;
+}
+
+
+/** \brief This function authenticates the device as the training Auth() does.
+ *
+ * It reads the root public key, the device public key, and its signature, and
+ * verifies the signature with the device. Then it has the device sign a random
+ * challenge and verifies that signature with the device public key.
+ * \param[out] challenge pointer to 32-byte buffer for the challenge
+ * \param[out] signature pointer to 64-byte buffer for the signature of the challenge
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_auth(uint8_t *challenge, uint8_t *signature)
+{
+	uint8_t command[RANDOM_COUNT];
+	uint8_t response[RANDOM_RSP_SIZE];
+	uint8_t root_public_key[VIRTUAL_BENCHMARK_SLOT_SIZE];
+	uint8_t public_key[VIRTUAL_BENCHMARK_SLOT_SIZE];
+	uint8_t certificate[VIRTUAL_BENCHMARK_SLOT_SIZE];
+	uint8_t digest[ECC108_KEY_SIZE];
+	uint8_t ret_code;
+
+	ret_code = ecc108c_wakeup(response);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_read_slot(VIRTUAL_BENCHMARK_KEY_ROOT_PUBLIC, root_public_key);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_read_slot(VIRTUAL_BENCHMARK_KEY_PUBLIC, public_key);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_read_slot(VIRTUAL_BENCHMARK_KEY_SIGNATURE, certificate);
+
+	ecc108h_calculate_sha256(VERIFY_PUBLIC_KEY_SIZE, &public_key[VIRTUAL_BENCHMARK_SLOT_OFFSET], digest);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_nonce(digest);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_verify(&certificate[VIRTUAL_BENCHMARK_SLOT_OFFSET],
+				&root_public_key[VIRTUAL_BENCHMARK_SLOT_OFFSET]);
+
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_random(command, response, RANDOM_SEED_UPDATE);
+	memcpy(challenge, &response[ECC108_BUFFER_POS_DATA], ECC108_KEY_SIZE);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_nonce(challenge);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_sign(VIRTUAL_BENCHMARK_KEY_PRIVATE, signature);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_nonce(challenge);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_verify(signature, &public_key[VIRTUAL_BENCHMARK_SLOT_OFFSET]);
+
+	ecc108p_sleep();
+
+	return ret_code;
+}
+
+
+/** \brief This function runs the flows and measures them.
+ * @return exit status of application, 1 if a result differs
+ */
+int main(void)
+{
+	static struct ecc108d_device device, client, host;
+	static const uint8_t sn[ECC108D_SN_SIZE] = {0x01, 0x23, 0x6C, 0x10, 0x00, 0x00, 0x51, 0x07, 0xEE};
+	uint8_t command[VERIFY_COUNT_EXTERNAL];
+	uint8_t response[ECC108_RSP_SIZE_MAX];
+	uint8_t seed[ECC108_KEY_SIZE];
+	uint8_t root_public_key[GENKEY_PUBLIC_KEY_SIZE];
+	uint8_t public_key[GENKEY_PUBLIC_KEY_SIZE];
+	uint8_t expected[GENKEY_PUBLIC_KEY_SIZE];
+	uint8_t signature[SIGN_SIGNATURE_SIZE];
+	uint8_t challenge[ECC108_KEY_SIZE];
+	uint8_t digest[ECC108_KEY_SIZE];
+	uint8_t slot[VIRTUAL_BENCHMARK_SLOT_SIZE];
+	uint8_t mac[PRIVWRITE_MAC_SIZE];
+	uint32_t i, commands, virtual_start;
+	double start, elapsed;
+	uint8_t timing;
+	uint8_t ret_code;
+
+	for (i = 0; i < sizeof(seed); i++)
+		seed[i] = (uint8_t) (i * 29 + 1);
+	ecc108d_device_init(&device, sn, seed);
+	ecc108d_attach(VIRTUAL_BENCHMARK_DEVICE, &device);
+	ecc108p_init();
+	ecc108p_set_device_id(VIRTUAL_BENCHMARK_DEVICE);
+
+	// Training flows.
+	ret_code = virtual_benchmark_lock(root_public_key);
+	p256_public_key(expected, &virtual_benchmark_root_key[ECC108D_KEY_PAD_SIZE]);
+	virtual_benchmark_check("lock: configure, PrivWrite, GenKey, lock",
+			(ret_code == ECC108_SUCCESS) && !memcmp(root_public_key, expected, sizeof(expected)));
+
+	ret_code = virtual_benchmark_personalize(public_key, signature);
+	virtual_benchmark_check("personalize: GenKey, Write, Nonce, Sign", ret_code == ECC108_SUCCESS);
+	p256_public_key(expected, ecc108d_slot(&device, VIRTUAL_BENCHMARK_KEY_PRIVATE, NULL) + ECC108D_KEY_PAD_SIZE);
+	ecc108h_calculate_sha256(sizeof(public_key), public_key, digest);
+	virtual_benchmark_check("personalize: key pair and signature on host",
+			!memcmp(public_key, expected, sizeof(expected))
+			&& (p256_verify(digest, signature, root_public_key, NULL) == P256_SUCCESS));
+
+	ret_code = virtual_benchmark_auth(challenge, signature);
+	virtual_benchmark_check("Auth: Read, Nonce, Verify, Random, Sign", ret_code == ECC108_SUCCESS);
+	virtual_benchmark_check("Auth: signature of challenge on host",
+			p256_verify(challenge, signature, public_key, NULL) == P256_SUCCESS);
+
+	// Info, stored Verify, and access rules.
+	ecc108c_wakeup(response);
+	ret_code = ecc108m_info(command, response, INFO_MODE_REVISION, 0);
+	virtual_benchmark_check("Info: revision",
+			(ret_code == ECC108_SUCCESS) && !memcmp(&response[ECC108_BUFFER_POS_DATA], &device.config[ECC108D_CONFIG_REVISION], 4));
+	ret_code = ecc108m_execute(ECC108_INFO, INFO_MODE_KEY_VALID, VIRTUAL_BENCHMARK_KEY_PRIVATE, 0, NULL, 0, NULL, 0, NULL,
+			sizeof(command), command, sizeof(response), response);
+	virtual_benchmark_check("Info: private key is valid", (ret_code == ECC108_SUCCESS) && (response[ECC108_BUFFER_POS_DATA] == 1));
+
+	memset(slot, 0, sizeof(slot));
+	memcpy(&slot[ECC108D_KEY_PAD_SIZE], public_key, ECC108_KEY_SIZE);
+	memcpy(&slot[2 * ECC108D_KEY_PAD_SIZE + ECC108_KEY_SIZE], &public_key[ECC108_KEY_SIZE], ECC108_KEY_SIZE);
+	ret_code = virtual_benchmark_write_slot(VIRTUAL_BENCHMARK_KEY_STORED, slot);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_nonce(challenge);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = ecc108m_execute(ECC108_VERIFY, VERIFY_MODE_STORED, VIRTUAL_BENCHMARK_KEY_STORED,
+				VERIFY_SIGNATURE_SIZE, signature, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+	virtual_benchmark_check("Nonce, Verify with stored public key",
+			(ret_code == ECC108_SUCCESS) && (response[ECC108_BUFFER_POS_STATUS] == ECC108D_STATUS_BYTE_SUCCESS));
+
+	signature[SIGN_SIGNATURE_SIZE - 1] ^= 1;
+	ret_code = virtual_benchmark_nonce(challenge);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_verify(signature, public_key);
+	virtual_benchmark_check("Verify of a wrong signature is rejected", ret_code == ECC108_CHECKMAC_FAILED);
+	ret_code = virtual_benchmark_verify(signature, public_key);
+	virtual_benchmark_check("Verify invalidates TempKey", ret_code == ECC108_CMD_FAIL);
+	ret_code = virtual_benchmark_sign(VIRTUAL_BENCHMARK_KEY_PRIVATE, signature);
+	virtual_benchmark_check("Sign without pass-through Nonce is rejected", ret_code == ECC108_CMD_FAIL);
+
+	ret_code = ecc108m_execute(ECC108_READ, ECC108_ZONE_COUNT_FLAG | ECC108_ZONE_DATA, VIRTUAL_BENCHMARK_KEY_PRIVATE << 3,
+			0, NULL, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+	virtual_benchmark_check("Read of a private key is rejected", ret_code == ECC108_CMD_FAIL);
+	memset(mac, 0, sizeof(mac));
+	ret_code = ecc108m_execute(ECC108_PRIVWRITE, 0, VIRTUAL_BENCHMARK_KEY_PRIVATE,
+			sizeof(virtual_benchmark_root_key), (uint8_t *) virtual_benchmark_root_key, sizeof(mac), mac, 0, NULL,
+			sizeof(command), command, sizeof(response), response);
+	virtual_benchmark_check("Clear PrivWrite after data lock is rejected", ret_code == ECC108_CMD_FAIL);
+	ret_code = ecc108m_execute(ECC108_GENKEY, GENKEY_MODE_PRIVATE, VIRTUAL_BENCHMARK_KEY_ROOT_PRIVATE,
+			0, NULL, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+	virtual_benchmark_check("GenKey without GenKey permission is rejected", ret_code == ECC108_CMD_FAIL);
+	ecc108p_sleep();
+
+	// DeriveKey example of the library, with a client and a host device that share the parent key.
+	ecc108d_device_init(&client, NULL, NULL);
+	ecc108d_device_init(&host, NULL, NULL);
+	for (i = 0; i < ECC108_KEY_SIZE; i++)
+		ecc108d_slot(&client, 0, NULL)[i] = ecc108d_slot(&host, 0, NULL)[i] = (uint8_t) (0x80 + i);
+	ecc108d_set_slot_config(&client, 3, ECC108D_SLOT_DERIVE_KEY | ECC108D_SLOT_DERIVE_CREATE);
+	ecc108d_attach(ECC108_CLIENT_ADDRESS, &client);
+	ecc108d_attach(ECC108_HOST_ADDRESS, &host);
+	ret_code = ecc108e_derive_key();
+	virtual_benchmark_check("ecc108e_derive_key()", ret_code == ECC108_SUCCESS);
+	ecc108p_set_device_id(VIRTUAL_BENCHMARK_DEVICE);
+
+	// Measure Nonce / Sign and Nonce / Verify flows in one wake period.
+	ecc108c_wakeup(response);
+	commands = device.commands;
+	start = virtual_benchmark_now();
+	for (i = 0, ret_code = ECC108_SUCCESS; (i < VIRTUAL_BENCHMARK_FLOWS) && (ret_code == ECC108_SUCCESS); i++) {
+		challenge[0] = (uint8_t) i;
+		ret_code = virtual_benchmark_nonce(challenge);
+		if (ret_code == ECC108_SUCCESS)
+			ret_code = virtual_benchmark_sign(VIRTUAL_BENCHMARK_KEY_PRIVATE, signature);
+	}
+	elapsed = virtual_benchmark_now() - start;
+	commands = device.commands - commands;
+	virtual_benchmark_check("Nonce / Sign flows", (ret_code == ECC108_SUCCESS)
+			&& (p256_verify(challenge, signature, public_key, NULL) == P256_SUCCESS));
+	printf("%-44s %10.0f commands/s %10.0f flows/s\n", "Nonce / Sign in one wake period",
+			commands / elapsed, VIRTUAL_BENCHMARK_FLOWS / elapsed);
+
+	commands = device.commands;
+	start = virtual_benchmark_now();
+	for (i = 0, ret_code = ECC108_SUCCESS; (i < VIRTUAL_BENCHMARK_FLOWS) && (ret_code == ECC108_SUCCESS); i++) {
+		ret_code = virtual_benchmark_nonce(challenge);
+		if (ret_code == ECC108_SUCCESS)
+			ret_code = virtual_benchmark_verify(signature, public_key);
+	}
+	elapsed = virtual_benchmark_now() - start;
+	commands = device.commands - commands;
+	ecc108p_sleep();
+	virtual_benchmark_check("Nonce / Verify flows", ret_code == ECC108_SUCCESS);
+	printf("%-44s %10.0f commands/s %10.0f flows/s\n", "Nonce / Verify in one wake period",
+			commands / elapsed, VIRTUAL_BENCHMARK_FLOWS / elapsed);
+
+	commands = device.commands;
+	start = virtual_benchmark_now();
+	for (i = 0, ret_code = ECC108_SUCCESS; (i < VIRTUAL_BENCHMARK_FLOWS / 10) && (ret_code == ECC108_SUCCESS); i++)
+		ret_code = virtual_benchmark_auth(challenge, signature);
+	elapsed = virtual_benchmark_now() - start;
+	commands = device.commands - commands;
+	virtual_benchmark_check("Auth flows", ret_code == ECC108_SUCCESS);
+	printf("%-44s %10.0f commands/s %10.0f flows/s\n", "Wake, Auth, Sleep",
+			commands / elapsed, VIRTUAL_BENCHMARK_FLOWS / 10 / elapsed);
+
+	// Measure the same flows in virtual time, with typical and with maximum execution times.
+	// The library waits and polls as it would on hardware.
+	for (timing = ECC108D_TIMING_TYPICAL; timing <= ECC108D_TIMING_MAX; timing++) {
+		device.timing = timing;
+		commands = device.commands;
+		virtual_start = timer_host_get_time();
+		for (i = 0, ret_code = ECC108_SUCCESS; (i < VIRTUAL_BENCHMARK_TIMED_FLOWS) && (ret_code == ECC108_SUCCESS); i++)
+			ret_code = virtual_benchmark_auth(challenge, signature);
+		elapsed = (timer_host_get_time() - virtual_start) / 1e6;
+		commands = device.commands - commands;
+		virtual_benchmark_check(timing == ECC108D_TIMING_TYPICAL ? "Timed flows, typical execution times"
+				: "Timed flows, maximum execution times", ret_code == ECC108_SUCCESS);
+		printf("%-44s %10.0f commands/s %10.0f flows/s\n", timing == ECC108D_TIMING_TYPICAL
+				? "Wake, Auth, Sleep, typical (virtual)" : "Wake, Auth, Sleep, maximum (virtual)",
+				commands / elapsed, VIRTUAL_BENCHMARK_TIMED_FLOWS / elapsed);
+	}
+
+	// GenKey takes longer than a 16-bit polling countdown in us can cover.
+	ecc108c_wakeup(response);
+	ret_code = ecc108m_execute(ECC108_GENKEY, GENKEY_MODE_PUBLIC, VIRTUAL_BENCHMARK_KEY_PRIVATE,
+			0, NULL, 0, NULL, 0, NULL, sizeof(command), command, sizeof(response), response);
+	virtual_benchmark_check("GenKey with maximum execution time", (ret_code == ECC108_SUCCESS)
+			&& !memcmp(&response[ECC108_BUFFER_POS_DATA], public_key, GENKEY_PUBLIC_KEY_SIZE));
+	ecc108p_sleep();
+
+	// The watchdog puts the device to sleep, and TempKey is lost.
+	device.timing = ECC108D_TIMING_TYPICAL;
+	ecc108c_wakeup(response);
+	ret_code = virtual_benchmark_nonce(challenge);
+	timer_host_advance(ECC108D_WATCHDOG_TIME);
+	if (ret_code == ECC108_SUCCESS)
+		ret_code = virtual_benchmark_sign(VIRTUAL_BENCHMARK_KEY_PRIVATE, signature);
+	virtual_benchmark_check("TempKey is lost when the watchdog expires",
+			(ret_code == ECC108_CMD_FAIL) && (device.watchdog_expirations == 1));
+	ecc108p_sleep();
+
+	// With acceleration, delays take real time.
+	timer_host_set_acceleration(VIRTUAL_BENCHMARK_ACCELERATION);
+	virtual_start = timer_host_get_time();
+	start = virtual_benchmark_now();
+	ret_code = virtual_benchmark_auth(challenge, signature);
+	elapsed = virtual_benchmark_now() - start;
+	timer_host_set_acceleration(0);
+	device.timing = ECC108D_TIMING_OFF;
+	virtual_benchmark_check("Accelerated flow takes real time", (ret_code == ECC108_SUCCESS)
+			&& (elapsed * 1e6 * VIRTUAL_BENCHMARK_ACCELERATION >= timer_host_get_time() - virtual_start));
+
+	return virtual_benchmark_failures ? 1 : 0;
+}
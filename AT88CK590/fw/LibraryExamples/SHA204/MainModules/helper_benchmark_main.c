@@ -0,0 +1,416 @@
+/** \file
+ *  \brief  Known-Answer Tests and Benchmark of the SHA204 and ECC108 Helper Functions
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It checks every helper function of the
+ * SHA204 library, or of the ECC108 library, against known-answer vectors, and then
+ * measures how long each of them takes. The vectors were calculated independently of
+ * the libraries, and they are the same for both libraries, because both device
+ * families hash the same messages. Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/helper_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_helper.c Libraries/utilities/sha256.c
+ *       Libraries/utilities/sha256_batch.c Libraries/utilities/cryptoauth_core.c
+ *       Libraries/utilities/cryptoauth_crc.c -o sha204_helper_benchmark
+ *   ./sha204_helper_benchmark
+ *
+ * For the ECC108 library, define HELPER_BENCHMARK_ECC108:
+ *
+ *   gcc -O2 -DHELPER_BENCHMARK_ECC108 -ILibraries/ecc108_library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/helper_benchmark_main.c
+ *       Libraries/ecc108_library/ecc108_helper.c Libraries/utilities/sha256.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       -o ecc108_helper_benchmark
+ *   ./ecc108_helper_benchmark
+ *
+ * Most helpers invalidate TempKey, so every measured call restores the TempKey
+ * structure first. This copies 36 bytes and is included in the times.
+ * The application returns 1 if any result does not match its vector.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock()
+
+#ifdef HELPER_BENCHMARK_ECC108
+#   include "ecc108_helper.h"          // definitions and declarations for the Helper module
+#   include "ecc108_comm_marshaling.h" // definitions of the command mode parameters
+#   include "ecc108_lib_return_codes.h"   // declarations of function return codes
+#   define HELPER(name)             ecc108h_##name
+#   define HELPER_SUCCESS           ECC108_SUCCESS
+#   define HELPER_CRYPTO_DATA       data
+#   define HELPER_LIBRARY           "ECC108"
+#else
+#   include "sha204_helper.h"          // definitions and declarations for the Helper module
+#   include "sha204_comm_marshaling.h" // definitions of the command mode parameters
+#   include "sha204_lib_return_codes.h"   // declarations of function return codes
+#   define HELPER(name)             sha204h_##name
+#   define HELPER_SUCCESS           SHA204_SUCCESS
+#   define HELPER_CRYPTO_DATA       crypto_data
+#   define HELPER_LIBRARY           "SHA204"
+#endif
+
+
+//! number of calls per measurement
+#define HELPER_BENCHMARK_LOOPS  (200000UL)
+
+
+/** \name Inputs of All Known-Answer Vectors
+@{ */
+//! key, password and parent key: 0x00 .. 0x1F
+static uint8_t helper_key[32];
+//! challenge and plain text: 0x40 .. 0x5F
+static uint8_t helper_challenge[32];
+//! NumIn of the Nonce command: 0x20 .. 0x33
+static uint8_t helper_num_in[32];
+//! RandOut of the Nonce command: 0xA0 .. 0xBF
+static uint8_t helper_rand_out[32];
+//! OTP[0:10]: 0x60 .. 0x6A
+static uint8_t helper_otp[11];
+//! OtherData of the CheckMac command: 0x70 .. 0x7C
+static uint8_t helper_other_data[13];
+//! serial number
+static uint8_t helper_sn[9] = {0x01, 0x23, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0xEE};
+//! CRC input: 0x00 .. 0x3F
+static uint8_t helper_crc_data[64];
+/** @} */
+
+//! expected result of helper_benchmark_nonce()
+static const uint8_t helper_kat_nonce[] = {
+	0xD8, 0x04, 0x0A, 0xA9, 0x62, 0xA7, 0x9C, 0x6A, 0x71, 0x05, 0xA4, 0xE6, 0xCD, 0xFD, 0x00, 0x34,
+	0x06, 0x35, 0xCA, 0x63, 0x00, 0x1A, 0x1B, 0xDB, 0xA7, 0xD8, 0x95, 0x14, 0xB6, 0x66, 0xD3, 0x3A
+};
+
+//! expected result of helper_benchmark_mac()
+static const uint8_t helper_kat_mac[] = {
+	0x32, 0x60, 0xC4, 0x78, 0xBF, 0x54, 0x41, 0xC8, 0xB2, 0xE1, 0x5E, 0x03, 0xA2, 0x22, 0x00, 0x6A,
+	0x56, 0xAD, 0x12, 0x39, 0xC2, 0xF2, 0x05, 0xC4, 0xE9, 0x86, 0x3B, 0x9D, 0x3D, 0x28, 0x6B, 0x18
+};
+
+//! expected result of helper_benchmark_mac_otp_sn()
+static const uint8_t helper_kat_mac_otp_sn[] = {
+	0x85, 0x9F, 0x37, 0x5F, 0x94, 0xF2, 0xEB, 0x6F, 0x29, 0xEB, 0xF9, 0x22, 0xE4, 0xEE, 0xB1, 0x74,
+	0x10, 0x05, 0xC0, 0x2E, 0xFF, 0x8C, 0x20, 0x22, 0xC5, 0x6C, 0x63, 0xF1, 0x5C, 0x50, 0x6B, 0x46
+};
+
+//! expected result of helper_benchmark_mac_tempkey()
+static const uint8_t helper_kat_mac_tempkey[] = {
+	0x97, 0x1A, 0x75, 0xD9, 0x4C, 0x03, 0xED, 0x50, 0xDB, 0xDA, 0xDF, 0xFE, 0x63, 0x74, 0xAE, 0x73,
+	0x59, 0xD3, 0xC9, 0x1E, 0x74, 0x27, 0xCB, 0x95, 0xD5, 0x85, 0x30, 0x3B, 0x27, 0x62, 0x22, 0x7D
+};
+
+//! expected result of helper_benchmark_hmac()
+static const uint8_t helper_kat_hmac[] = {
+	0xD4, 0x02, 0xD1, 0x89, 0x7A, 0x87, 0xCA, 0xEB, 0x7C, 0xE4, 0x23, 0xC2, 0x8A, 0xF9, 0xF3, 0x15,
+	0xC1, 0x6C, 0x80, 0x54, 0x53, 0x83, 0x83, 0x00, 0x61, 0xAC, 0xE5, 0x61, 0xDE, 0x9A, 0x10, 0xDC
+};
+
+//! expected result of helper_benchmark_check_mac()
+static const uint8_t helper_kat_check_mac[] = {
+	0xFB, 0xD1, 0xF7, 0x27, 0xE3, 0x19, 0xCB, 0xD4, 0x4F, 0xC8, 0xDA, 0xB6, 0x95, 0x15, 0xBA, 0x2E,
+	0x2F, 0x23, 0xB9, 0xEE, 0xC3, 0x63, 0x22, 0x59, 0xC6, 0x02, 0x96, 0x3E, 0x9B, 0x08, 0xD4, 0xA3
+};
+
+//! expected result of helper_benchmark_gen_dig()
+static const uint8_t helper_kat_gen_dig[] = {
+	0x1B, 0x97, 0x5F, 0xFB, 0xAF, 0xFD, 0x75, 0xCC, 0x76, 0x49, 0x0A, 0x02, 0x4C, 0x07, 0x96, 0x4C,
+	0xCA, 0xB9, 0xBC, 0x3F, 0x78, 0xED, 0x2C, 0x4D, 0x27, 0x78, 0x84, 0x3B, 0xBA, 0x46, 0x08, 0x15
+};
+
+//! expected result of helper_benchmark_derive_key()
+static const uint8_t helper_kat_derive_key[] = {
+	0xF6, 0x7B, 0x3C, 0x6D, 0x34, 0x2A, 0x08, 0x55, 0x8F, 0xBD, 0x55, 0xB1, 0x4B, 0xD3, 0x47, 0x74,
+	0x6D, 0xFB, 0x90, 0x4D, 0x8A, 0x94, 0xE0, 0xD0, 0x42, 0x50, 0xF4, 0xB0, 0x18, 0xEE, 0xC3, 0xAD
+};
+
+//! expected result of helper_benchmark_derive_key_mac()
+static const uint8_t helper_kat_derive_key_mac[] = {
+	0x5C, 0xF0, 0xF3, 0x74, 0x80, 0xA4, 0xC3, 0x75, 0xB9, 0x68, 0xA5, 0xAB, 0x9B, 0x5E, 0x38, 0xA8,
+	0x14, 0x8E, 0x27, 0x53, 0x21, 0xF9, 0x15, 0xC1, 0x92, 0xA0, 0x49, 0x29, 0x19, 0xF6, 0x2A, 0x69
+};
+
+//! expected result of helper_benchmark_encrypt_mac()
+static const uint8_t helper_kat_encrypt_mac[] = {
+	0xAE, 0x88, 0xAC, 0x80, 0x72, 0x7F, 0x6D, 0xAA, 0xAE, 0x03, 0xE5, 0x1D, 0x0A, 0xE1, 0x51, 0x0A,
+	0xBE, 0x67, 0x1D, 0xF2, 0xFE, 0x22, 0xEC, 0x38, 0x9E, 0x34, 0xE8, 0xFC, 0x12, 0x60, 0x82, 0x5A
+};
+
+//! expected result of helper_benchmark_encrypt(), and input of helper_benchmark_decrypt()
+static const uint8_t helper_kat_encrypt[] = {
+	0x5B, 0xD6, 0x1D, 0xB8, 0xEB, 0xB8, 0x33, 0x8B, 0x3E, 0x00, 0x40, 0x49, 0x00, 0x4A, 0xD8, 0x03,
+	0x9A, 0xE8, 0xEE, 0x6C, 0x2C, 0xB8, 0x7A, 0x1A, 0x7F, 0x21, 0xDE, 0x60, 0xE6, 0x1B, 0x56, 0x4A
+};
+
+//! expected result of helper_benchmark_crc()
+static const uint8_t helper_kat_crc[] = {
+	0xE4, 0x99
+};
+
+
+//! TempKey after the Nonce command, used by all helpers that need a random TempKey
+static struct HELPER(temp_key) helper_temp_key_nonce;
+//! TempKey after the GenDig command, used by the encryption helpers
+static struct HELPER(temp_key) helper_temp_key_gen_dig;
+//! TempKey passed to the helper under test
+static struct HELPER(temp_key) helper_temp_key;
+
+
+static uint8_t helper_benchmark_nonce(uint8_t *result)
+{
+	struct HELPER(nonce_in_out) param = {.mode = NONCE_MODE_SEED_UPDATE, .num_in = helper_num_in,
+			.rand_out = helper_rand_out, .temp_key = &helper_temp_key};
+	uint8_t ret_code = HELPER(nonce)(&param);
+
+	memcpy(result, helper_temp_key.value, sizeof(helper_temp_key.value));
+	return ret_code;
+}
+
+static uint8_t helper_benchmark_mac(uint8_t *result)
+{
+	struct HELPER(mac_in_out) param = {.mode = 0x00, .key_id = 0, .key = helper_key,
+			.challenge = helper_challenge, .response = result};
+
+	return HELPER(mac)(&param);
+}
+
+static uint8_t helper_benchmark_mac_otp_sn(uint8_t *result)
+{
+	struct HELPER(mac_in_out) param = {.mode = MAC_MODE_INCLUDE_OTP_88 | MAC_MODE_INCLUDE_SN, .key_id = 1,
+			.key = helper_key, .challenge = helper_challenge, .otp = helper_otp, .sn = helper_sn,
+			.response = result};
+
+	return HELPER(mac)(&param);
+}
+
+static uint8_t helper_benchmark_mac_tempkey(uint8_t *result)
+{
+	struct HELPER(mac_in_out) param = {.mode = MAC_MODE_BLOCK2_TEMPKEY, .key_id = 2, .key = helper_key,
+			.response = result, .temp_key = &helper_temp_key};
+
+	helper_temp_key = helper_temp_key_nonce;
+	return HELPER(mac)(&param);
+}
+
+static uint8_t helper_benchmark_hmac(uint8_t *result)
+{
+	struct HELPER(hmac_in_out) param = {.mode = MAC_MODE_INCLUDE_SN, .key_id = 3, .key = helper_key,
+			.sn = helper_sn, .response = result, .temp_key = &helper_temp_key};
+
+	helper_temp_key = helper_temp_key_nonce;
+	return HELPER(hmac)(&param);
+}
+
+static uint8_t helper_benchmark_check_mac(uint8_t *result)
+{
+	struct HELPER(check_mac_in_out) param = {.mode = MAC_MODE_BLOCK2_TEMPKEY, .password = helper_key,
+			.other_data = helper_other_data, .target_key = helper_challenge, .client_resp = result,
+			.temp_key = &helper_temp_key};
+
+	helper_temp_key = helper_temp_key_nonce;
+	return HELPER(check_mac)(&param);
+}
+
+static uint8_t helper_benchmark_gen_dig(uint8_t *result)
+{
+	struct HELPER(gen_dig_in_out) param = {.zone = GENDIG_ZONE_DATA, .key_id = 4,
+			.stored_value = helper_key, .temp_key = &helper_temp_key};
+	uint8_t ret_code;
+
+	helper_temp_key = helper_temp_key_nonce;
+	ret_code = HELPER(gen_dig)(&param);
+	memcpy(result, helper_temp_key.value, sizeof(helper_temp_key.value));
+	return ret_code;
+}
+
+static uint8_t helper_benchmark_derive_key(uint8_t *result)
+{
+	struct HELPER(derive_key_in_out) param = {.random = 0, .target_key_id = 5, .parent_key = helper_key,
+			.target_key = result, .temp_key = &helper_temp_key};
+
+	helper_temp_key = helper_temp_key_nonce;
+	return HELPER(derive_key)(&param);
+}
+
+static uint8_t helper_benchmark_derive_key_mac(uint8_t *result)
+{
+	struct HELPER(derive_key_mac_in_out) param = {.random = 0, .target_key_id = 5,
+			.parent_key = helper_key, .mac = result};
+
+	return HELPER(derive_key_mac)(&param);
+}
+
+static uint8_t helper_benchmark_encrypt_mac(uint8_t *result)
+{
+	uint8_t data[32];
+	struct HELPER(encrypt_in_out) param = {.zone = 2, .address = 0x20, .HELPER_CRYPTO_DATA = data,
+			.mac = result, .temp_key = &helper_temp_key};
+
+	memcpy(data, helper_challenge, sizeof(data));
+	helper_temp_key = helper_temp_key_gen_dig;
+	return HELPER(encrypt)(&param);
+}
+
+static uint8_t helper_benchmark_encrypt(uint8_t *result)
+{
+	struct HELPER(encrypt_in_out) param = {.zone = 2, .address = 0x20, .HELPER_CRYPTO_DATA = result,
+			.temp_key = &helper_temp_key};
+
+	memcpy(result, helper_challenge, sizeof(helper_challenge));
+	helper_temp_key = helper_temp_key_gen_dig;
+	return HELPER(encrypt)(&param);
+}
+
+static uint8_t helper_benchmark_decrypt(uint8_t *result)
+{
+	struct HELPER(decrypt_in_out) param = {.HELPER_CRYPTO_DATA = result, .temp_key = &helper_temp_key};
+
+	memcpy(result, helper_kat_encrypt, sizeof(helper_kat_encrypt));
+	helper_temp_key = helper_temp_key_gen_dig;
+	return HELPER(decrypt)(&param);
+}
+
+static uint8_t helper_benchmark_crc(uint8_t *result)
+{
+	result[0] = result[1] = 0;
+	HELPER(calculate_crc_chain)(sizeof(helper_crc_data), helper_crc_data, result);
+	return HELPER_SUCCESS;
+}
+
+
+//! type of a function that calls one helper and returns its result
+typedef uint8_t (*helper_benchmark_t)(uint8_t *result);
+
+//! helper call and its known answer
+struct helper_benchmark_case {
+	const char *name;
+	helper_benchmark_t function;
+	const uint8_t *expected;
+	uint8_t expected_len;
+};
+
+static const struct helper_benchmark_case helper_benchmark_cases[] = {
+	{ "nonce", helper_benchmark_nonce, helper_kat_nonce, sizeof(helper_kat_nonce) },
+	{ "mac", helper_benchmark_mac, helper_kat_mac, sizeof(helper_kat_mac) },
+	{ "mac, OTP and SN", helper_benchmark_mac_otp_sn, helper_kat_mac_otp_sn, sizeof(helper_kat_mac_otp_sn) },
+	{ "mac, TempKey", helper_benchmark_mac_tempkey, helper_kat_mac_tempkey, sizeof(helper_kat_mac_tempkey) },
+	{ "hmac", helper_benchmark_hmac, helper_kat_hmac, sizeof(helper_kat_hmac) },
+	{ "check_mac", helper_benchmark_check_mac, helper_kat_check_mac, sizeof(helper_kat_check_mac) },
+	{ "gen_dig", helper_benchmark_gen_dig, helper_kat_gen_dig, sizeof(helper_kat_gen_dig) },
+	{ "derive_key", helper_benchmark_derive_key, helper_kat_derive_key, sizeof(helper_kat_derive_key) },
+	{ "derive_key_mac", helper_benchmark_derive_key_mac, helper_kat_derive_key_mac, sizeof(helper_kat_derive_key_mac) },
+	{ "encrypt, input MAC", helper_benchmark_encrypt_mac, helper_kat_encrypt_mac, sizeof(helper_kat_encrypt_mac) },
+	{ "encrypt", helper_benchmark_encrypt, helper_kat_encrypt, sizeof(helper_kat_encrypt) },
+	{ "decrypt", helper_benchmark_decrypt, helper_challenge, sizeof(helper_challenge) },
+	{ "calculate_crc_chain", helper_benchmark_crc, helper_kat_crc, sizeof(helper_kat_crc) }
+};
+
+
+/** \brief This function initializes the inputs and the two TempKey states all vectors start from.
+ */
+static void helper_benchmark_init(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < sizeof(helper_key); i++) {
+		helper_key[i] = i;
+		helper_challenge[i] = 0x40 + i;
+		helper_num_in[i] = 0x20 + i;
+		helper_rand_out[i] = 0xA0 + i;
+	}
+	for (i = 0; i < sizeof(helper_otp); i++)
+		helper_otp[i] = 0x60 + i;
+	for (i = 0; i < sizeof(helper_other_data); i++)
+		helper_other_data[i] = 0x70 + i;
+	for (i = 0; i < sizeof(helper_crc_data); i++)
+		helper_crc_data[i] = i;
+
+	memcpy(helper_temp_key_nonce.value, helper_kat_nonce, sizeof(helper_kat_nonce));
+	helper_temp_key_nonce.valid = 1;
+
+	memcpy(helper_temp_key_gen_dig.value, helper_kat_gen_dig, sizeof(helper_kat_gen_dig));
+	helper_temp_key_gen_dig.key_id = 4;
+	helper_temp_key_gen_dig.gen_data = 1;
+	helper_temp_key_gen_dig.valid = 1;
+}
+
+
+/** \brief This function checks and measures the helper functions.
+ * @return exit status of application, 1 if a result does not match its vector
+ */
+int main(void)
+{
+	uint8_t result[32];
+	uint8_t status;
+	unsigned long loop;
+	clock_t start;
+	double ns;
+	uint8_t i;
+	int ret_code = 0;
+
+	helper_benchmark_init();
+
+	printf(HELPER_LIBRARY " helpers\n%-22s %6s %12s %12s\n", "function", "result", "ns/op", "ops/s");
+
+	for (i = 0; i < sizeof(helper_benchmark_cases) / sizeof(helper_benchmark_cases[0]); i++) {
+		const struct helper_benchmark_case *test = &helper_benchmark_cases[i];
+
+		memset(result, 0, sizeof(result));
+		status = test->function(result);
+		if (status != HELPER_SUCCESS || memcmp(result, test->expected, test->expected_len)) {
+			printf("%-22s FAILED (status 0x%02X)\n", test->name, status);
+			ret_code = 1;
+			continue;
+		}
+
+		// Feed the result back as input, so the calls cannot be optimized away.
+		start = clock();
+		for (loop = 0; loop < HELPER_BENCHMARK_LOOPS; loop++) {
+			test->function(result);
+			helper_key[31] = result[0];
+		}
+		ns = (double) (clock() - start) * 1e9 / CLOCKS_PER_SEC / HELPER_BENCHMARK_LOOPS;
+		helper_key[31] = 31;
+
+		printf("%-22s %6s %12.1f %12.0f\n", test->name, "ok", ns, 1e9 / ns);
+	}
+
+	return ret_code;
+}
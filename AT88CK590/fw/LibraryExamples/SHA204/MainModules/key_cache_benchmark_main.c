@@ -0,0 +1,276 @@
+/** \file
+ *  \brief  Benchmark of the Diversified Key Cache
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It checks the child keys of the diversified
+ * key cache against sha204h_derive_key(), and then lets several threads authenticate a
+ * fleet of devices, of which a small part authenticates most of the time. It reports the
+ * look-up rate and the hit / miss counters of the cache, with and without a warm-up file.
+ * Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -pthread -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/key_cache_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_key_cache.c Libraries/SHA204Library/sha204_helper.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/sha256_batch.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       Libraries/utilities/cryptoauth_wipe.c
+ *       -o sha204_key_cache_benchmark
+ *   ./sha204_key_cache_benchmark
+ *
+ * The application returns 1 if a child key differs from the one sha204h_derive_key() calculates.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+#include <pthread.h>                   // needed for the authentication threads
+
+#include "sha204_key_cache.h"          // definitions and declarations for the Key Cache module
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+
+
+//! number of devices in the fleet
+#define KEY_CACHE_BENCHMARK_FLEET      (1UL << 20)
+
+//! number of child keys the cache holds
+#define KEY_CACHE_BENCHMARK_CAPACITY   (1UL << 16)
+
+//! number of shards of the cache
+#define KEY_CACHE_BENCHMARK_SHARDS     (64)
+
+//! number of authenticating threads
+#define KEY_CACHE_BENCHMARK_THREADS    (4)
+
+//! number of authentications per thread
+#define KEY_CACHE_BENCHMARK_LOOKUPS    (1UL << 19)
+
+//! number of devices that authenticate 90 % of the time
+#define KEY_CACHE_BENCHMARK_ACTIVE     (KEY_CACHE_BENCHMARK_CAPACITY / 2)
+
+//! name of the warm-up file
+#define KEY_CACHE_BENCHMARK_FILE       "key_cache_warm_up.bin"
+
+
+//! parent key of the fleet
+static uint8_t key_cache_benchmark_parent[SHA204_KEY_SIZE];
+
+//! cache shared by the threads
+static struct sha204k_cache *key_cache_benchmark_cache;
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double key_cache_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function creates the serial number of a device of the fleet.
+ * \param[in] device index of the device
+ * \param[out] sn pointer to 9-byte serial number
+ */
+static void key_cache_benchmark_sn(uint32_t device, uint8_t *sn)
+{
+	sn[0] = 0x01;
+	sn[1] = 0x23;
+	sn[2] = (uint8_t) (device >> 24);
+	sn[3] = (uint8_t) (device >> 16);
+	sn[4] = (uint8_t) (device >> 8);
+	sn[5] = (uint8_t) device;
+	sn[6] = 0x5A;
+	sn[7] = 0xC3;
+	sn[8] = 0xEE;
+}
+
+
+/** \brief This function authenticates devices, 90 % of them from the active part of the fleet.
+ * \param[in] arg seed of the thread
+ * \return NULL
+ */
+static void *key_cache_benchmark_thread(void *arg)
+{
+	uint32_t state = (uint32_t) (uintptr_t) arg * 2654435761UL + 1;
+	uint8_t sn[SHA204K_SN_SIZE];
+	uint8_t child_key[SHA204_KEY_SIZE];
+	uint32_t i, device;
+
+	for (i = 0; i < KEY_CACHE_BENCHMARK_LOOKUPS; i++) {
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		device = (state % 10) ? state % KEY_CACHE_BENCHMARK_ACTIVE : state % KEY_CACHE_BENCHMARK_FLEET;
+		key_cache_benchmark_sn(device, sn);
+		sha204k_cache_get(key_cache_benchmark_cache, sn, child_key);
+	}
+
+	return NULL;
+}
+
+
+/** \brief This function runs the authentication threads and prints the counters of the cache.
+ * \param[in] name name of the run
+ */
+static void key_cache_benchmark_run(const char *name)
+{
+	pthread_t threads[KEY_CACHE_BENCHMARK_THREADS];
+	struct sha204k_cache_stats stats;
+	double start, elapsed;
+	uintptr_t i;
+
+	start = key_cache_benchmark_now();
+	for (i = 0; i < KEY_CACHE_BENCHMARK_THREADS; i++)
+		pthread_create(&threads[i], NULL, key_cache_benchmark_thread, (void *) i);
+	for (i = 0; i < KEY_CACHE_BENCHMARK_THREADS; i++)
+		pthread_join(threads[i], NULL);
+	elapsed = key_cache_benchmark_now() - start;
+
+	sha204k_cache_get_stats(key_cache_benchmark_cache, &stats);
+	printf("%-14s %12.0f %10llu %10llu %10llu %8.1f %%\n", name,
+			KEY_CACHE_BENCHMARK_THREADS * KEY_CACHE_BENCHMARK_LOOKUPS / elapsed,
+			(unsigned long long) stats.hits, (unsigned long long) stats.misses,
+			(unsigned long long) stats.evictions, 100.0 * stats.hits / (stats.hits + stats.misses));
+}
+
+
+/** \brief This function checks the cache against sha204h_derive_key() and measures it.
+ * @return exit status of application, 1 if a child key differs
+ */
+int main(void)
+{
+	struct sha204h_temp_key temp_key;
+	struct sha204h_derive_key_in_out derive_key_param;
+	struct sha204k_cache_stats stats;
+	uint8_t sn[SHA204K_SN_SIZE];
+	uint8_t child_key[SHA204_KEY_SIZE];
+	uint8_t expected[SHA204_KEY_SIZE];
+	uint32_t i, loaded;
+	double start, elapsed;
+	FILE *file;
+
+	for (i = 0; i < SHA204_KEY_SIZE; i++)
+		key_cache_benchmark_parent[i] = (uint8_t) (0xA0 + i);
+
+	// A cache of 18 keys in 4 shards keeps evicting, which is checked as well.
+	// Its capacity does not divide evenly among the shards.
+	sha204k_cache_create(18, 4, key_cache_benchmark_parent, 10, &key_cache_benchmark_cache);
+	for (i = 0; i < 1000; i++) {
+		key_cache_benchmark_sn(i % 40, sn);
+
+		memset(&temp_key, 0, sizeof(temp_key));
+		memcpy(temp_key.value, sn, SHA204K_SN_SIZE);
+		temp_key.source_flag = 1;
+		temp_key.valid = 1;
+		derive_key_param.random = DERIVE_KEY_RANDOM_FLAG;
+		derive_key_param.target_key_id = 10;
+		derive_key_param.parent_key = key_cache_benchmark_parent;
+		derive_key_param.target_key = expected;
+		derive_key_param.temp_key = &temp_key;
+		memset(expected, 0, sizeof(expected));
+		sha204h_derive_key(&derive_key_param);
+
+		sha204k_cache_get(key_cache_benchmark_cache, sn, child_key);
+		if (memcmp(child_key, expected, SHA204_KEY_SIZE)) {
+			printf("child key of device %u differs\n", (unsigned) (i % 40));
+			return 1;
+		}
+	}
+	sha204k_cache_get_stats(key_cache_benchmark_cache, &stats);
+	if (stats.entries > 18) {
+		printf("cache of 18 keys holds %lu keys\n", (unsigned long) stats.entries);
+		return 1;
+	}
+	sha204k_cache_destroy(key_cache_benchmark_cache);
+
+	// The cost of a miss: deriving a child key without the cache.
+	start = key_cache_benchmark_now();
+	for (i = 0; i < KEY_CACHE_BENCHMARK_LOOKUPS; i++) {
+		key_cache_benchmark_sn(i, sn);
+		memset(&temp_key, 0, sizeof(temp_key));
+		memcpy(temp_key.value, sn, SHA204K_SN_SIZE);
+		temp_key.source_flag = 1;
+		temp_key.valid = 1;
+		derive_key_param.temp_key = &temp_key;
+		sha204h_derive_key(&derive_key_param);
+	}
+	elapsed = key_cache_benchmark_now() - start;
+
+	printf("fleet: %lu devices, cache: %lu keys in %u shards, %u threads\n", KEY_CACHE_BENCHMARK_FLEET,
+			KEY_CACHE_BENCHMARK_CAPACITY, KEY_CACHE_BENCHMARK_SHARDS, KEY_CACHE_BENCHMARK_THREADS);
+	printf("%-14s %12s %10s %10s %10s %10s\n", "run", "look-ups/s", "hits", "misses", "evictions", "hit rate");
+	printf("%-14s %12.0f\n", "no cache", KEY_CACHE_BENCHMARK_LOOKUPS / elapsed);
+
+	sha204k_cache_create(KEY_CACHE_BENCHMARK_CAPACITY, KEY_CACHE_BENCHMARK_SHARDS, key_cache_benchmark_parent,
+			10, &key_cache_benchmark_cache);
+	key_cache_benchmark_run("cold");
+	sha204k_cache_destroy(key_cache_benchmark_cache);
+
+	// List the active devices in a warm-up file, and start a new cache from it.
+	file = fopen(KEY_CACHE_BENCHMARK_FILE, "wb");
+	if (!file) {
+		printf("could not write %s\n", KEY_CACHE_BENCHMARK_FILE);
+		return 1;
+	}
+	for (i = 0; i < KEY_CACHE_BENCHMARK_ACTIVE; i++) {
+		key_cache_benchmark_sn(i, sn);
+		fwrite(sn, 1, sizeof(sn), file);
+	}
+	fclose(file);
+
+	sha204k_cache_create(KEY_CACHE_BENCHMARK_CAPACITY, KEY_CACHE_BENCHMARK_SHARDS, key_cache_benchmark_parent,
+			10, &key_cache_benchmark_cache);
+	if (sha204k_cache_warm_up(key_cache_benchmark_cache, KEY_CACHE_BENCHMARK_FILE, &loaded) != SHA204_SUCCESS
+			|| loaded != KEY_CACHE_BENCHMARK_ACTIVE) {
+		printf("warm-up failed\n");
+		return 1;
+	}
+	key_cache_benchmark_run("warmed up");
+	sha204k_cache_destroy(key_cache_benchmark_cache);
+	remove(KEY_CACHE_BENCHMARK_FILE);
+
+	return 0;
+}
@@ -0,0 +1,365 @@
+/** \file
+ *  \brief  Benchmark of the Challenge / Response Table Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It builds a challenge / response table for
+ * a random lot with 1 up to N threads, appends a second lot that also re-provisions some
+ * devices of the first, and checks sampled records against sha204h_mac(). Then it
+ * authenticates random devices through the hash index of the table, and, for
+ * comparison, through a binary search of the sorted records, and reports the rates.
+ * Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -pthread -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/response_table_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_response_table.c Libraries/SHA204Library/sha204_helper.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/sha256_batch.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       Libraries/utilities/cryptoauth_wipe.c Libraries/utilities/cryptoauth_file.c
+ *       -o sha204_response_table_benchmark
+ *   ./sha204_response_table_benchmark [maximum number of threads] [table file]
+ *
+ * The application returns 1 if a result differs from the expected one.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+#include <unistd.h>                    // needed for sysconf()
+
+#include "sha204_response_table.h"     // definitions and declarations for the Challenge / Response Table module
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+
+
+//! number of devices in the first lot
+#define RESPONSE_TABLE_BENCHMARK_DEVICES     (1UL << 16)
+
+//! number of new devices in the second lot
+#define RESPONSE_TABLE_BENCHMARK_APPENDED    (1UL << 14)
+
+//! number of devices of the first lot that the second lot re-provisions
+#define RESPONSE_TABLE_BENCHMARK_REPLACED    (256)
+
+//! number of challenges per device
+#define RESPONSE_TABLE_BENCHMARK_CHALLENGES  (8)
+
+//! number of sampled records checked against sha204h_mac()
+#define RESPONSE_TABLE_BENCHMARK_SAMPLES     (4096)
+
+//! number of timed authentications
+#define RESPONSE_TABLE_BENCHMARK_LOOKUPS     (1UL << 20)
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double response_table_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function returns pseudo-random numbers (xorshift64).
+ * \param[in,out] state pointer to generator state
+ * \return next number
+ */
+static uint64_t response_table_benchmark_random(uint64_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+
+/** \brief This function fills a buffer with pseudo-random bytes.
+ * \param[in,out] state pointer to generator state
+ * \param[in] size size of buffer
+ * \param[out] buffer pointer to buffer
+ */
+static void response_table_benchmark_fill(uint64_t *state, uint8_t size, uint8_t *buffer)
+{
+	while (size--)
+		*buffer++ = (uint8_t) response_table_benchmark_random(state);
+}
+
+
+/** \brief This function creates a random manifest entry.
+ * \param[in,out] state pointer to generator state
+ * \param[in] index device number, becomes part of the serial number
+ * \param[out] entry pointer to manifest entry
+ */
+static void response_table_benchmark_entry(uint64_t *state, uint32_t index, struct sha204t_manifest_entry *entry)
+{
+	static const uint8_t modes[] = {MAC_MODE_CHALLENGE, MAC_MODE_INCLUDE_SN, MAC_MODE_INCLUDE_OTP_88 | MAC_MODE_INCLUDE_SN};
+
+	entry->sn[0] = 0x01;
+	entry->sn[1] = 0x23;
+	entry->sn[2] = (uint8_t) (index >> 24);
+	entry->sn[3] = (uint8_t) (index >> 16);
+	entry->sn[4] = (uint8_t) (index >> 8);
+	entry->sn[5] = (uint8_t) index;
+	response_table_benchmark_fill(state, 2, &entry->sn[6]);
+	entry->sn[8] = 0xEE;
+	response_table_benchmark_fill(state, SHA204T_OTP_SIZE, entry->otp);
+	response_table_benchmark_fill(state, SHA204T_SEED_SIZE, entry->challenge_seed);
+	entry->mode = modes[index % sizeof(modes)];
+	entry->key_id = (uint8_t) (index & SHA204_KEY_ID_MAX);
+	response_table_benchmark_fill(state, SHA204_KEY_SIZE, entry->key);
+}
+
+
+/** \brief This function checks a record against the manifest entry it was calculated from.
+ * \param[in] entry pointer to manifest entry
+ * \param[in] challenge_id challenge ID
+ * \param[in] record pointer to record found in the table, can be NULL
+ * \return 0 if the record is correct, 1 otherwise
+ */
+static int response_table_benchmark_check(const struct sha204t_manifest_entry *entry, uint16_t challenge_id,
+		const struct sha204t_record *record)
+{
+	struct sha204h_mac_in_out mac_param;
+	struct sha204h_temp_key temp_key;
+	uint8_t message[SHA204T_SEED_SIZE + SHA204T_SN_SIZE + 2];
+	uint8_t challenge[MAC_CHALLENGE_SIZE];
+	uint8_t response[SHA204_KEY_SIZE];
+	struct sha204t_manifest_entry copy = *entry;
+
+	if (!record)
+		return 1;
+
+	memcpy(message, entry->challenge_seed, SHA204T_SEED_SIZE);
+	memcpy(&message[SHA204T_SEED_SIZE], entry->sn, SHA204T_SN_SIZE);
+	message[SHA204T_SEED_SIZE + SHA204T_SN_SIZE] = (uint8_t) challenge_id;
+	message[SHA204T_SEED_SIZE + SHA204T_SN_SIZE + 1] = (uint8_t) (challenge_id >> 8);
+	sha256(sizeof(message), message, challenge);
+
+	memset(&temp_key, 0, sizeof(temp_key));
+	mac_param.mode = entry->mode;
+	mac_param.key_id = entry->key_id;
+	mac_param.challenge = challenge;
+	mac_param.key = copy.key;
+	mac_param.otp = copy.otp;
+	mac_param.sn = copy.sn;
+	mac_param.response = response;
+	mac_param.temp_key = &temp_key;
+	if (sha204h_mac(&mac_param) != SHA204_SUCCESS)
+		return 1;
+
+	return memcmp(record->challenge, challenge, MAC_CHALLENGE_SIZE)
+			|| (record->mode != entry->mode) || (record->key_id[0] != entry->key_id)
+			|| (sha204t_verify(record, response) != SHA204_SUCCESS);
+}
+
+
+/** \brief This function finds a record by binary search of the sorted records.
+ * \param[in] table pointer to mapping
+ * \param[in] sn pointer to 9-byte serial number
+ * \param[in] challenge_id challenge ID
+ * \return pointer to record, NULL if not found
+ */
+static const struct sha204t_record *response_table_benchmark_bsearch(const struct sha204t_table *table,
+		const uint8_t *sn, uint16_t challenge_id)
+{
+	uint32_t low = 0, high = sha204t_table_count(table), middle;
+	const struct sha204t_record *record;
+	int difference;
+
+	while (low < high) {
+		middle = low + (high - low) / 2;
+		record = sha204t_table_record(table, middle);
+		difference = memcmp(sn, record->sn, SHA204T_SN_SIZE);
+		if (!difference)
+			difference = (int) challenge_id - (int) (record->challenge_id[0] | (record->challenge_id[1] << 8));
+		if (!difference)
+			return record;
+		if (difference < 0)
+			high = middle;
+		else
+			low = middle + 1;
+	}
+	return NULL;
+}
+
+
+/** \brief This function builds, appends, checks and measures challenge / response tables.
+ * \param[in] argc number of arguments
+ * \param[in] argv optional maximum number of threads and table file name
+ * @return exit status of application, 1 if a result differs
+ */
+int main(int argc, char *argv[])
+{
+	struct sha204t_manifest_entry *lot1 = malloc(RESPONSE_TABLE_BENCHMARK_DEVICES * sizeof(*lot1));
+	struct sha204t_manifest_entry *lot2 = malloc((RESPONSE_TABLE_BENCHMARK_APPENDED + RESPONSE_TABLE_BENCHMARK_REPLACED)
+			* sizeof(*lot2));
+	uint32_t *lookup_device = malloc(RESPONSE_TABLE_BENCHMARK_LOOKUPS * sizeof(*lookup_device));
+	long threads_max = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+	const char *file_name = argc > 2 ? argv[2] : "response_table.bin";
+	const uint32_t lot2_count = RESPONSE_TABLE_BENCHMARK_APPENDED + RESPONSE_TABLE_BENCHMARK_REPLACED;
+	const uint32_t total = RESPONSE_TABLE_BENCHMARK_DEVICES + RESPONSE_TABLE_BENCHMARK_APPENDED;
+	const struct sha204t_manifest_entry *entry;
+	const struct sha204t_record *record;
+	struct sha204t_table *table;
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	uint32_t i, failed = 0, found;
+	uint16_t challenge_id;
+	uint8_t threads, sn[SHA204T_SN_SIZE];
+	double start, elapsed, hashed;
+	int ret_code = 0;
+
+	if (!lot1 || !lot2 || !lookup_device) {
+		printf("out of memory\n");
+		return 1;
+	}
+	if (threads_max < 1)
+		threads_max = 1;
+	if (threads_max > SHA204T_THREADS_MAX)
+		threads_max = SHA204T_THREADS_MAX;
+
+	// The second lot starts with re-provisioned devices of the first lot, with new keys and seeds.
+	for (i = 0; i < RESPONSE_TABLE_BENCHMARK_DEVICES; i++)
+		response_table_benchmark_entry(&state, i, &lot1[i]);
+	for (i = 0; i < lot2_count; i++) {
+		response_table_benchmark_entry(&state, i < RESPONSE_TABLE_BENCHMARK_REPLACED
+				? i * 97 : RESPONSE_TABLE_BENCHMARK_DEVICES + i - RESPONSE_TABLE_BENCHMARK_REPLACED, &lot2[i]);
+		if (i < RESPONSE_TABLE_BENCHMARK_REPLACED)
+			memcpy(lot2[i].sn, lot1[i * 97].sn, SHA204T_SN_SIZE);
+	}
+
+	printf("%-22s %12s\n", "build", "records/s");
+	for (threads = 1; threads <= threads_max; threads++) {
+		start = response_table_benchmark_now();
+		if (sha204t_table_build(threads, RESPONSE_TABLE_BENCHMARK_DEVICES, lot1,
+				RESPONSE_TABLE_BENCHMARK_CHALLENGES, file_name) != SHA204_SUCCESS) {
+			printf("build with %u threads FAILED\n", threads);
+			return 1;
+		}
+		elapsed = response_table_benchmark_now() - start;
+		printf("%2u thread%-13s %12.0f\n", threads, threads > 1 ? "s" : "",
+				RESPONSE_TABLE_BENCHMARK_DEVICES * RESPONSE_TABLE_BENCHMARK_CHALLENGES / elapsed);
+	}
+
+	start = response_table_benchmark_now();
+	if (sha204t_table_append((uint8_t) threads_max, lot2_count, lot2, RESPONSE_TABLE_BENCHMARK_CHALLENGES,
+			file_name) != SHA204_SUCCESS) {
+		printf("append FAILED\n");
+		return 1;
+	}
+	printf("appended %lu devices in %.1f ms\n", (unsigned long) lot2_count, (response_table_benchmark_now() - start) * 1e3);
+
+	if (sha204t_table_open(file_name, &table) != SHA204_SUCCESS) {
+		printf("open FAILED\n");
+		return 1;
+	}
+	if (sha204t_table_count(table) != total * RESPONSE_TABLE_BENCHMARK_CHALLENGES) {
+		printf("table holds %lu records instead of %lu\n", (unsigned long) sha204t_table_count(table),
+				(unsigned long) total * RESPONSE_TABLE_BENCHMARK_CHALLENGES);
+		ret_code = 1;
+	}
+
+	// Sampled records of both lots, including all re-provisioned ones, have to match sha204h_mac().
+	for (i = 0; i < RESPONSE_TABLE_BENCHMARK_SAMPLES + RESPONSE_TABLE_BENCHMARK_REPLACED; i++) {
+		if (i < RESPONSE_TABLE_BENCHMARK_REPLACED)
+			entry = &lot2[i];
+		else if (i & 1)
+			entry = &lot2[RESPONSE_TABLE_BENCHMARK_REPLACED
+					+ response_table_benchmark_random(&state) % RESPONSE_TABLE_BENCHMARK_APPENDED];
+		else {
+			entry = &lot1[response_table_benchmark_random(&state) % RESPONSE_TABLE_BENCHMARK_DEVICES];
+			if (!((entry - lot1) % 97) && (entry - lot1) / 97 < RESPONSE_TABLE_BENCHMARK_REPLACED)
+				entry = &lot2[(entry - lot1) / 97];
+		}
+		challenge_id = (uint16_t) (i % RESPONSE_TABLE_BENCHMARK_CHALLENGES);
+		record = sha204t_table_find(table, entry->sn, challenge_id);
+		if (response_table_benchmark_check(entry, challenge_id, record)
+				|| (record != response_table_benchmark_bsearch(table, entry->sn, challenge_id)))
+			failed++;
+	}
+	// Unknown devices and challenge IDs are not found, and wrong responses are rejected.
+	memcpy(sn, lot1[0].sn, SHA204T_SN_SIZE);
+	sn[2] = 0xFF;
+	record = sha204t_table_find(table, lot1[1].sn, 1);
+	if (sha204t_table_find(table, sn, 0) || sha204t_table_find(table, lot1[1].sn, RESPONSE_TABLE_BENCHMARK_CHALLENGES)
+			|| !record || (sha204t_verify(record, record->challenge) != SHA204_FUNC_FAIL))
+		failed++;
+	if (failed) {
+		printf("%lu checks FAILED\n", (unsigned long) failed);
+		ret_code = 1;
+	}
+
+	// Authenticate random devices: find the challenge, then compare the response.
+	for (i = 0; i < RESPONSE_TABLE_BENCHMARK_LOOKUPS; i++)
+		lookup_device[i] = (uint32_t) (response_table_benchmark_random(&state) % RESPONSE_TABLE_BENCHMARK_DEVICES);
+
+	start = response_table_benchmark_now();
+	for (i = 0, found = 0; i < RESPONSE_TABLE_BENCHMARK_LOOKUPS; i++) {
+		record = sha204t_table_find(table, lot1[lookup_device[i]].sn, (uint16_t) (i % RESPONSE_TABLE_BENCHMARK_CHALLENGES));
+		found += record && sha204t_verify(record, record->response) == SHA204_SUCCESS;
+	}
+	hashed = response_table_benchmark_now() - start;
+
+	start = response_table_benchmark_now();
+	for (i = 0; i < RESPONSE_TABLE_BENCHMARK_LOOKUPS; i++) {
+		record = response_table_benchmark_bsearch(table, lot1[lookup_device[i]].sn,
+				(uint16_t) (i % RESPONSE_TABLE_BENCHMARK_CHALLENGES));
+		found -= record && sha204t_verify(record, record->response) == SHA204_SUCCESS;
+	}
+	elapsed = response_table_benchmark_now() - start;
+
+	if (found) {
+		printf("hash index and binary search DIFFER\n");
+		ret_code = 1;
+	}
+	printf("%-22s %12s %10s\n", "authentication", "lookups/s", "speedup");
+	printf("%-22s %12.0f %10.2f\n", "binary search", RESPONSE_TABLE_BENCHMARK_LOOKUPS / elapsed, 1.0);
+	printf("%-22s %12.0f %10.2f\n", "hash index", RESPONSE_TABLE_BENCHMARK_LOOKUPS / hashed, elapsed / hashed);
+
+	sha204t_table_close(table);
+	free(lookup_device);
+	free(lot2);
+	free(lot1);
+
+	return ret_code;
+}
@@ -0,0 +1,263 @@
+/** \file
+ *  \brief  Benchmark of the Rolled Key Chain Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It rolls the keys of a fleet of devices
+ * one roll at a time with sha204h_derive_key(), as a server replays a chain, and with
+ * sha204r_advance() using 1 up to N threads. Then it builds a checkpoint index and
+ * looks up the keys of random devices after random roll counts. All keys are checked
+ * against the replayed ones, and the rates are reported. Build and run it from the fw
+ * directory with:
+ *
+ *   gcc -O2 -pthread -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/roll_chain_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_roll_chain.c Libraries/SHA204Library/sha204_helper.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/sha256_batch.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       Libraries/utilities/cryptoauth_wipe.c Libraries/utilities/cryptoauth_file.c
+ *       -o sha204_roll_chain_benchmark
+ *   ./sha204_roll_chain_benchmark [maximum number of threads] [index file]
+ *
+ * The application returns 1 if a key differs from the replayed one.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+#include <unistd.h>                    // needed for sysconf()
+
+#include "sha204_roll_chain.h"         // definitions and declarations for the Rolled Key Chain module
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+
+
+//! number of devices in the fleet
+#define ROLL_CHAIN_BENCHMARK_DEVICES   (4096)
+
+//! number of rolls every chain is advanced by
+#define ROLL_CHAIN_BENCHMARK_ROLLS     (64)
+
+//! number of rolls between checkpoints
+#define ROLL_CHAIN_BENCHMARK_INTERVAL  (32)
+
+//! highest number of rolls covered by checkpoints
+#define ROLL_CHAIN_BENCHMARK_HORIZON   (1024)
+
+//! number of key look-ups
+#define ROLL_CHAIN_BENCHMARK_LOOKUPS   (4096)
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double roll_chain_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function returns pseudo-random numbers (xorshift64).
+ * \param[in,out] state pointer to generator state
+ * \return next number
+ */
+static uint64_t roll_chain_benchmark_random(uint64_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+
+/** \brief This function replays the rolls of a chain with sha204h_derive_key().
+ * \param[in] chain pointer to chain at 0 rolls
+ * \param[in] rolls number of rolls
+ * \param[out] key pointer to 32-byte key after the rolls
+ * \return status of the operation
+ */
+static uint8_t roll_chain_benchmark_replay(const struct sha204r_chain *chain, uint32_t rolls, uint8_t *key)
+{
+	struct sha204h_temp_key temp_key;
+	struct sha204h_nonce_in_out nonce_param;
+	struct sha204h_derive_key_in_out derive_key_param;
+	uint8_t nonce[SHA204_KEY_SIZE];
+	uint8_t ret_code;
+
+	memcpy(key, chain->key, SHA204_KEY_SIZE);
+	memcpy(nonce, chain->nonce, SHA204_KEY_SIZE);
+
+	nonce_param.num_in = nonce;
+	nonce_param.rand_out = NULL;
+	nonce_param.temp_key = &temp_key;
+	derive_key_param.random = chain->random;
+	derive_key_param.target_key_id = chain->target_key_id;
+	derive_key_param.parent_key = key;
+	derive_key_param.target_key = key;
+	derive_key_param.temp_key = &temp_key;
+
+	while (rolls--) {
+		// Every DeriveKey command invalidates TempKey, so the pass-through nonce is sent again.
+		nonce_param.mode = NONCE_MODE_PASSTHROUGH;
+		ret_code = sha204h_nonce(&nonce_param);
+		if (ret_code != SHA204_SUCCESS)
+			return ret_code;
+		ret_code = sha204h_derive_key(&derive_key_param);
+		if (ret_code != SHA204_SUCCESS)
+			return ret_code;
+	}
+
+	return SHA204_SUCCESS;
+}
+
+
+/** \brief This function checks the chain functions against replayed chains, and measures them.
+ * \param[in] argc number of arguments
+ * \param[in] argv optional maximum number of threads and name of the index file
+ * @return exit status of application, 1 if a key differs
+ */
+int main(int argc, char *argv[])
+{
+	static struct sha204r_chain chains[ROLL_CHAIN_BENCHMARK_DEVICES];
+	static struct sha204r_chain rolled[ROLL_CHAIN_BENCHMARK_DEVICES];
+	static uint8_t expected[ROLL_CHAIN_BENCHMARK_DEVICES][SHA204_KEY_SIZE];
+	static uint32_t lookup_device[ROLL_CHAIN_BENCHMARK_LOOKUPS];
+	static uint32_t lookup_rolls[ROLL_CHAIN_BENCHMARK_LOOKUPS];
+	static uint8_t lookup_key[ROLL_CHAIN_BENCHMARK_LOOKUPS][SHA204_KEY_SIZE];
+	uint8_t key[SHA204_KEY_SIZE];
+	long threads_max = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+	const char *file_name = argc > 2 ? argv[2] : "sha204_roll_chain_benchmark.idx";
+	struct sha204r_index *index;
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	uint32_t i, j, failed = 0;
+	double start, elapsed, replay;
+	uint8_t threads, ret_code;
+
+	if (threads_max < 1)
+		threads_max = 1;
+	if (threads_max > SHA204R_THREADS_MAX)
+		threads_max = SHA204R_THREADS_MAX;
+
+	// Every device rolls slot 1 with its padded serial number as pass-through nonce.
+	for (i = 0; i < ROLL_CHAIN_BENCHMARK_DEVICES; i++) {
+		memset(&chains[i], 0, sizeof(chains[i]));
+		chains[i].sn[0] = 0x01;
+		chains[i].sn[1] = 0x23;
+		for (j = 2; j < SHA204R_SN_SIZE - 1; j++)
+			chains[i].sn[j] = (uint8_t) roll_chain_benchmark_random(&state);
+		chains[i].sn[SHA204R_SN_SIZE - 1] = 0xEE;
+		memcpy(chains[i].nonce, chains[i].sn, SHA204R_SN_SIZE);
+		chains[i].target_key_id = 1;
+		chains[i].random = DERIVE_KEY_RANDOM_FLAG;
+		for (j = 0; j < SHA204_KEY_SIZE; j++)
+			chains[i].key[j] = (uint8_t) roll_chain_benchmark_random(&state);
+	}
+
+	printf("%-22s %14s\n", "method", "rolls/s");
+
+	start = roll_chain_benchmark_now();
+	for (i = 0; i < ROLL_CHAIN_BENCHMARK_DEVICES; i++) {
+		if (roll_chain_benchmark_replay(&chains[i], ROLL_CHAIN_BENCHMARK_ROLLS, expected[i]) != SHA204_SUCCESS)
+			failed++;
+	}
+	replay = roll_chain_benchmark_now() - start;
+	printf("%-22s %14.0f\n", "replay", ROLL_CHAIN_BENCHMARK_DEVICES * ROLL_CHAIN_BENCHMARK_ROLLS / replay);
+
+	for (threads = 1; threads <= threads_max; threads++) {
+		memcpy(rolled, chains, sizeof(rolled));
+		start = roll_chain_benchmark_now();
+		ret_code = sha204r_advance(threads, ROLL_CHAIN_BENCHMARK_DEVICES, rolled, ROLL_CHAIN_BENCHMARK_ROLLS);
+		elapsed = roll_chain_benchmark_now() - start;
+		for (i = 0; i < ROLL_CHAIN_BENCHMARK_DEVICES; i++) {
+			if ((ret_code != SHA204_SUCCESS) || (rolled[i].rolls != ROLL_CHAIN_BENCHMARK_ROLLS)
+					|| memcmp(rolled[i].key, expected[i], SHA204_KEY_SIZE))
+				failed++;
+		}
+		printf("advance, %2u thread%-5s %14.0f\n", threads, threads > 1 ? "s" : "",
+				ROLL_CHAIN_BENCHMARK_DEVICES * ROLL_CHAIN_BENCHMARK_ROLLS / elapsed);
+	}
+
+	start = roll_chain_benchmark_now();
+	ret_code = sha204r_index_build((uint8_t) threads_max, ROLL_CHAIN_BENCHMARK_DEVICES, chains,
+			ROLL_CHAIN_BENCHMARK_INTERVAL, ROLL_CHAIN_BENCHMARK_HORIZON, file_name);
+	elapsed = roll_chain_benchmark_now() - start;
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204r_index_open(file_name, &index);
+	if (ret_code != SHA204_SUCCESS) {
+		printf("building the index failed: 0x%02X\n", ret_code);
+		return 1;
+	}
+	printf("index of %u checkpoints per device built in %.2f s\n",
+			ROLL_CHAIN_BENCHMARK_HORIZON / ROLL_CHAIN_BENCHMARK_INTERVAL + 1, elapsed);
+
+	// Look up random devices after random roll counts, some of them beyond the horizon.
+	for (i = 0; i < ROLL_CHAIN_BENCHMARK_LOOKUPS; i++) {
+		lookup_device[i] = (uint32_t) (roll_chain_benchmark_random(&state) % ROLL_CHAIN_BENCHMARK_DEVICES);
+		lookup_rolls[i] = (uint32_t) (roll_chain_benchmark_random(&state) % (ROLL_CHAIN_BENCHMARK_HORIZON + 64));
+	}
+	printf("%-22s %14s\n", "key look-up", "keys/s");
+
+	start = roll_chain_benchmark_now();
+	for (i = 0; i < ROLL_CHAIN_BENCHMARK_LOOKUPS; i++) {
+		if (roll_chain_benchmark_replay(&chains[lookup_device[i]], lookup_rolls[i], lookup_key[i]) != SHA204_SUCCESS)
+			failed++;
+	}
+	replay = roll_chain_benchmark_now() - start;
+	printf("%-22s %14.0f\n", "replay", ROLL_CHAIN_BENCHMARK_LOOKUPS / replay);
+
+	start = roll_chain_benchmark_now();
+	for (i = 0; i < ROLL_CHAIN_BENCHMARK_LOOKUPS; i++) {
+		ret_code = sha204r_index_key(index, chains[lookup_device[i]].sn, lookup_rolls[i], key);
+		if ((ret_code != SHA204_SUCCESS) || memcmp(key, lookup_key[i], SHA204_KEY_SIZE))
+			failed++;
+	}
+	elapsed = roll_chain_benchmark_now() - start;
+	printf("%-22s %14.0f %8.1fx\n", "index", ROLL_CHAIN_BENCHMARK_LOOKUPS / elapsed, replay / elapsed);
+
+	printf("%u keys differ\n", failed);
+
+	sha204r_index_close(index);
+	remove(file_name);
+
+	return failed ? 1 : 0;
+}
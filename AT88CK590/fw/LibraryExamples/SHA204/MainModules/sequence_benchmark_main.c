@@ -0,0 +1,290 @@
+/** \file
+ *  \brief  Benchmark of the Command Sequence Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It calculates the expected results of a few
+ * authentication flows for a fleet of devices, once by calling sha204h_nonce(),
+ * sha204h_gen_dig(), sha204h_mac() and sha204h_hmac() for every device, and once with
+ * sha204s_evaluate(). It compares the results and reports the rates of both. Build and
+ * run it from the fw directory with:
+ *
+ *   gcc -O2 -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/sequence_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_sequence.c Libraries/SHA204Library/sha204_helper.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/sha256_batch.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       Libraries/utilities/cryptoauth_wipe.c
+ *       -o sha204_sequence_benchmark
+ *   ./sha204_sequence_benchmark
+ *
+ * The application returns 1 if a result differs.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+
+#include "sha204_sequence.h"           // definitions and declarations for the Command Sequence module
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+
+
+//! number of devices in the fleet
+#define SEQUENCE_BENCHMARK_DEVICES     (16384)
+
+//! number of times every flow is calculated per measurement
+#define SEQUENCE_BENCHMARK_LOOPS       (4)
+
+
+/** \brief inputs of a device, the slots 0 and 3 point to the shared root keys
+ */
+struct sequence_benchmark_inputs {
+	uint8_t num_in[SHA204_KEY_SIZE];
+	uint8_t rand_out[SHA204_KEY_SIZE];
+	uint8_t key1[SHA204_KEY_SIZE];
+	uint8_t key2[SHA204_KEY_SIZE];
+	uint8_t sn[9];
+	const uint8_t *slots[SHA204_KEY_COUNT];
+	uint8_t response[SHA204_KEY_SIZE];
+	uint8_t expected[SHA204_KEY_SIZE];
+};
+
+
+/** \brief a flow and its name
+ */
+struct sequence_benchmark_flow {
+	const char *name;
+	uint8_t count;
+	struct sha204s_step steps[SHA204S_STEPS_MAX];
+};
+
+static const struct sequence_benchmark_flow sequence_benchmark_flows[] = {
+	{ "Nonce GenDig(root) MAC", 3, {
+		{ SHA204_NONCE, NONCE_MODE_SEED_UPDATE, 0 },
+		{ SHA204_GENDIG, GENDIG_ZONE_DATA, 0 },
+		{ SHA204_MAC, MAC_MODE_BLOCK2_TEMPKEY | MAC_MODE_INCLUDE_SN, 1 } } },
+	{ "Nonce GenDig HMAC(root)", 3, {
+		{ SHA204_NONCE, NONCE_MODE_PASSTHROUGH, 0 },
+		{ SHA204_GENDIG, GENDIG_ZONE_DATA, 2 },
+		{ SHA204_HMAC, MAC_MODE_SOURCE_FLAG_MATCH | MAC_MODE_INCLUDE_SN, 3 } } },
+	{ "Nonce GenDig GenDig", 3, {
+		{ SHA204_NONCE, NONCE_MODE_SEED_UPDATE, 0 },
+		{ SHA204_GENDIG, GENDIG_ZONE_DATA, 0 },
+		{ SHA204_GENDIG, GENDIG_ZONE_DATA, 1 } } },
+	{ "Nonce MAC", 2, {
+		{ SHA204_NONCE, NONCE_MODE_NO_SEED_UPDATE, 0 },
+		{ SHA204_MAC, MAC_MODE_BLOCK2_TEMPKEY, 2 } } }
+};
+
+
+//! a MAC command that requires a random TempKey after a pass-through Nonce
+static const struct sha204s_step sequence_benchmark_mismatch[] = {
+	{ SHA204_NONCE, NONCE_MODE_PASSTHROUGH, 0 },
+	{ SHA204_MAC, MAC_MODE_BLOCK2_TEMPKEY, 1 }
+};
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double sequence_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function calculates the result of a flow with the helper functions.
+ * \param[in] flow pointer to flow
+ * \param[in,out] inputs pointer to inputs of the device, the result is written to expected
+ * \return status of the operation
+ */
+static uint8_t sequence_benchmark_helper(const struct sequence_benchmark_flow *flow,
+		struct sequence_benchmark_inputs *inputs)
+{
+	struct sha204h_temp_key temp_key;
+	struct sha204h_nonce_in_out nonce_param;
+	struct sha204h_gen_dig_in_out gen_dig_param;
+	struct sha204h_mac_in_out mac_param;
+	struct sha204h_hmac_in_out hmac_param;
+	const struct sha204s_step *step;
+	uint8_t ret_code = SHA204_SUCCESS;
+	uint8_t i;
+
+	nonce_param.mode = flow->steps[0].param1;
+	nonce_param.num_in = inputs->num_in;
+	nonce_param.rand_out = inputs->rand_out;
+	nonce_param.temp_key = &temp_key;
+	ret_code = sha204h_nonce(&nonce_param);
+
+	for (i = 1; (i < flow->count) && (ret_code == SHA204_SUCCESS); i++) {
+		step = &flow->steps[i];
+		switch (step->opcode) {
+		case SHA204_GENDIG:
+			gen_dig_param.zone = step->param1;
+			gen_dig_param.key_id = step->param2;
+			gen_dig_param.stored_value = (uint8_t *) inputs->slots[step->param2];
+			gen_dig_param.temp_key = &temp_key;
+			ret_code = sha204h_gen_dig(&gen_dig_param);
+			break;
+
+		case SHA204_MAC:
+			mac_param.mode = step->param1;
+			mac_param.key_id = step->param2;
+			mac_param.challenge = NULL;
+			mac_param.key = (uint8_t *) inputs->slots[step->param2];
+			mac_param.otp = NULL;
+			mac_param.sn = inputs->sn;
+			mac_param.response = inputs->expected;
+			mac_param.temp_key = &temp_key;
+			return sha204h_mac(&mac_param);
+
+		case SHA204_HMAC:
+			hmac_param.mode = step->param1;
+			hmac_param.key_id = step->param2;
+			hmac_param.key = (uint8_t *) inputs->slots[step->param2];
+			hmac_param.otp = NULL;
+			hmac_param.sn = inputs->sn;
+			hmac_param.response = inputs->expected;
+			hmac_param.temp_key = &temp_key;
+			return sha204h_hmac(&hmac_param);
+		}
+	}
+	memcpy(inputs->expected, temp_key.value, SHA204_KEY_SIZE);
+
+	return ret_code;
+}
+
+
+/** \brief This function checks the sequence results against the helper functions, and measures both.
+ * @return exit status of application, 1 if a result differs
+ */
+int main(void)
+{
+	struct sequence_benchmark_inputs *inputs = malloc(SEQUENCE_BENCHMARK_DEVICES * sizeof(*inputs));
+	struct sha204s_device *devices = malloc(SEQUENCE_BENCHMARK_DEVICES * sizeof(*devices));
+	static uint8_t root_keys[2][SHA204_KEY_SIZE];
+	const struct sequence_benchmark_flow *flow;
+	struct sha204s_sequence sequence;
+	uint32_t i, j, loop, failed;
+	double start, helper, fused;
+	uint8_t f, ret_code;
+	int ret = 0;
+
+	if (!inputs || !devices) {
+		printf("out of memory\n");
+		return 1;
+	}
+
+	for (j = 0; j < 2; j++)
+		for (i = 0; i < SHA204_KEY_SIZE; i++)
+			root_keys[j][i] = (uint8_t) (j * 0x40 + i * 3);
+
+	srand(1);
+	for (i = 0; i < SEQUENCE_BENCHMARK_DEVICES; i++) {
+		for (j = 0; j < SHA204_KEY_SIZE; j++) {
+			inputs[i].num_in[j] = (uint8_t) rand();
+			inputs[i].rand_out[j] = (uint8_t) rand();
+			inputs[i].key1[j] = (uint8_t) rand();
+			inputs[i].key2[j] = (uint8_t) rand();
+		}
+		for (j = 0; j < sizeof(inputs[i].sn); j++)
+			inputs[i].sn[j] = (uint8_t) rand();
+		memset(inputs[i].slots, 0, sizeof(inputs[i].slots));
+		inputs[i].slots[0] = root_keys[0];
+		inputs[i].slots[1] = inputs[i].key1;
+		inputs[i].slots[2] = inputs[i].key2;
+		inputs[i].slots[3] = root_keys[1];
+
+		memset(&devices[i], 0, sizeof(devices[i]));
+		devices[i].num_in = inputs[i].num_in;
+		devices[i].rand_out = inputs[i].rand_out;
+		devices[i].slots = inputs[i].slots;
+		devices[i].sn = inputs[i].sn;
+		devices[i].response = inputs[i].response;
+	}
+
+	printf("%-24s %14s %14s %8s\n", "flow", "helper dev/s", "fused dev/s", "speedup");
+
+	for (f = 0; f < sizeof(sequence_benchmark_flows) / sizeof(sequence_benchmark_flows[0]); f++) {
+		flow = &sequence_benchmark_flows[f];
+		failed = 0;
+
+		start = sequence_benchmark_now();
+		for (loop = 0; loop < SEQUENCE_BENCHMARK_LOOPS; loop++)
+			for (i = 0; i < SEQUENCE_BENCHMARK_DEVICES; i++)
+				if (sequence_benchmark_helper(flow, &inputs[i]) != SHA204_SUCCESS)
+					failed++;
+		helper = sequence_benchmark_now() - start;
+
+		ret_code = sha204s_sequence_init(&sequence, flow->count, flow->steps);
+		start = sequence_benchmark_now();
+		for (loop = 0; (loop < SEQUENCE_BENCHMARK_LOOPS) && (ret_code == SHA204_SUCCESS); loop++)
+			ret_code = sha204s_evaluate(&sequence, SEQUENCE_BENCHMARK_DEVICES, devices);
+		fused = sequence_benchmark_now() - start;
+
+		for (i = 0; i < SEQUENCE_BENCHMARK_DEVICES; i++)
+			if (memcmp(inputs[i].response, inputs[i].expected, SHA204_KEY_SIZE))
+				failed++;
+		if ((ret_code != SHA204_SUCCESS) || failed) {
+			printf("%-24s FAILED (0x%02X, %u)\n", flow->name, ret_code, failed);
+			ret = 1;
+			continue;
+		}
+		printf("%-24s %14.0f %14.0f %8.2f\n", flow->name,
+				SEQUENCE_BENCHMARK_DEVICES * SEQUENCE_BENCHMARK_LOOPS / helper,
+				SEQUENCE_BENCHMARK_DEVICES * SEQUENCE_BENCHMARK_LOOPS / fused, helper / fused);
+	}
+
+	// A MAC that requires a random TempKey after a pass-through Nonce is rejected once, for the whole sequence.
+	if (sha204s_sequence_init(&sequence, sizeof(sequence_benchmark_mismatch) / sizeof(sequence_benchmark_mismatch[0]),
+			sequence_benchmark_mismatch) != SHA204_CMD_FAIL) {
+		printf("source flag mismatch not detected\n");
+		ret = 1;
+	}
+
+	free(devices);
+	free(inputs);
+
+	return ret;
+}
@@ -24,6 +24,7 @@
 #include "i2c_phys.h"
 #include "soft_uart.h"
 #include "delay_x.h"
+#include "cryptoauth_crc.h"
 
 #define SECURITY_XPLAINED
 #ifdef SECURITY_XPLAINED
@@ -85,23 +86,8 @@ uint8_t sha204_comm_buffer[SHA204_CMD_SIZE_MAX + 2];
  * \param[out] crc pointer to 16-bit CRC
  */
 void sha204c_calculate_crc(uint8_t length, uint8_t *data, uint8_t *crc) {
-	uint8_t counter;
-	uint16_t crc_register = 0;
-	uint16_t polynom = 0x8005;
-	uint8_t shift_register;
-	uint8_t data_bit, crc_bit;
-
-	for (counter = 0; counter < length; counter++) {
-	  for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1) {
-		 data_bit = (data[counter] & shift_register) ? 1 : 0;
-		 crc_bit = crc_register >> 15;
-		 crc_register <<= 1;
-		 if (data_bit != crc_bit)
-			crc_register ^= polynom;
-	  }
-	}
-	crc[0] = (uint8_t) (crc_register & 0x00FF);
-	crc[1] = (uint8_t) (crc_register >> 8);
+	crc[0] = crc[1] = 0;
+	cryptoauth_calculate_crc(length, data, crc);
 }
 
 
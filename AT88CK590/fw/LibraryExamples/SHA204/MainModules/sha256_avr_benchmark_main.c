@@ -0,0 +1,200 @@
+/** \file
+ *  \brief  Cycle-Count Benchmark of the SHA-256 Module on the 8-bit AVR, Run under simavr
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is firmware for the AT90USB1287 of the AT88CK590 kit, meant to run in the simavr
+ * simulator, which reports exact CPU cycles. It counts the cycles of the fixed-length
+ * SHA-256 functions for the CryptoAuth message sizes, and checks the "abc" test vector
+ * of FIPS 180-4. The results are printed to the simavr console. Build and run it from
+ * the fw directory with:
+ *
+ *   avr-gcc -mmcu=at90usb1287 -Os -DF_CPU=16000000UL -ILibraries/utilities -I<simavr>/simavr/sim/avr
+ *       LibraryExamples/SHA204/MainModules/sha256_avr_benchmark_main.c Libraries/utilities/sha256.c
+ *       -o sha256_avr_benchmark.elf
+ *   simavr sha256_avr_benchmark.elf
+ *
+ * Add -DSHA256_PORTABLE to the avr-gcc command line to measure the portable compression
+ * function instead of the AVR one. The same binary also runs on the kit, where the
+ * console output is simply discarded.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <avr/io.h>                    // register definitions
+#include <avr/interrupt.h>             // needed for ISR() and sei()
+#include <avr/sleep.h>                 // needed for sleep_cpu()
+#include <avr/pgmspace.h>              // needed for PSTR()
+#include "avr_mcu_section.h"           // simavr firmware section, from simavr/sim/avr
+
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+
+
+// Tell simavr which MCU and clock to simulate, and to print bytes written to GPIOR0.
+AVR_MCU(F_CPU, "at90usb1287");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+
+//! type of a fixed-length SHA-256 function
+typedef void (*sha256_fixed_t)(const uint8_t *message, uint8_t *digest);
+
+//! fixed-length function and the message it is used for
+struct sha256_benchmark_case {
+	uint8_t len;
+	sha256_fixed_t function;
+	const char *name;
+};
+
+static const struct sha256_benchmark_case sha256_benchmark_cases[] = {
+	{ 39, sha256_39, "DeriveKey MAC" },
+	{ 55, sha256_55, "Nonce" },
+	{ 88, sha256_88, "MAC" },
+	{ 96, sha256_96, "GenDig / outer HMAC" },
+	{ 152, sha256_152, "inner HMAC" }
+};
+
+//! SHA-256("abc")
+static const uint8_t sha256_abc_digest[SHA256_DIGEST_SIZE] PROGMEM = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+};
+
+//! upper 16 bits of the cycle counter, incremented on every Timer1 overflow
+static volatile uint16_t sha256_benchmark_overflows;
+
+
+/** \brief Timer1 overflow interrupt, extends the cycle counter to 32 bits.
+ */
+ISR(TIMER1_OVF_vect)
+{
+	sha256_benchmark_overflows++;
+}
+
+
+/** \brief This function writes a character to the simavr console.
+ * \param[in] c character
+ * \param[in] stream not used
+ * \return 0
+ */
+static int sha256_benchmark_putchar(char c, FILE *stream)
+{
+	(void) stream;
+	GPIOR0 = c;
+	return 0;
+}
+
+static FILE sha256_benchmark_stdout = FDEV_SETUP_STREAM(sha256_benchmark_putchar, NULL, _FDEV_SETUP_WRITE);
+
+
+/** \brief This function resets the cycle counter and starts Timer1 at the CPU clock.
+ */
+static void sha256_benchmark_start(void)
+{
+	TCCR1B = 0;
+	TCNT1 = 0;
+	sha256_benchmark_overflows = 0;
+	TIFR1 = _BV(TOV1);
+	TCCR1B = _BV(CS10);
+}
+
+
+/** \brief This function stops Timer1 and returns the cycles counted since sha256_benchmark_start().
+ * \return number of CPU cycles
+ */
+static uint32_t sha256_benchmark_stop(void)
+{
+	TCCR1B = 0;
+	// Account for an overflow that happened after the last interrupt was served.
+	if (TIFR1 & _BV(TOV1)) {
+		TIFR1 = _BV(TOV1);
+		sha256_benchmark_overflows++;
+	}
+	return ((uint32_t) sha256_benchmark_overflows << 16) | TCNT1;
+}
+
+
+/** \brief This function counts the cycles of the fixed-length SHA-256 functions.
+ * @return exit status of application, 1 if the test vector failed
+ */
+int main(void)
+{
+	uint8_t message[152];
+	uint8_t digest[SHA256_DIGEST_SIZE];
+	uint32_t overhead, cycles;
+	uint8_t i;
+	int ret_code = 0;
+
+	stdout = &sha256_benchmark_stdout;
+	TIMSK1 = _BV(TOIE1);
+	sei();
+
+	for (i = 0; i < sizeof(message); i++)
+		message[i] = i;
+
+	sha256(3, (const uint8_t *) "abc", digest);
+	if (memcmp_P(digest, sha256_abc_digest, SHA256_DIGEST_SIZE)) {
+		printf_P(PSTR("SHA-256(\"abc\") failed\n"));
+		ret_code = 1;
+	}
+
+	sha256_benchmark_start();
+	overhead = sha256_benchmark_stop();
+
+	printf_P(PSTR("%-22s %5s %10s %10s\n"), "message", "bytes", "cycles", "per block");
+
+	for (i = 0; i < sizeof(sha256_benchmark_cases) / sizeof(sha256_benchmark_cases[0]); i++) {
+		const struct sha256_benchmark_case *test = &sha256_benchmark_cases[i];
+		// message bytes + '1' bit + 64-bit length, rounded up to whole blocks
+		uint8_t blocks = (test->len + 1 + 8 + SHA256_BLOCK_SIZE - 1) / SHA256_BLOCK_SIZE;
+
+		sha256_benchmark_start();
+		test->function(message, digest);
+		cycles = sha256_benchmark_stop() - overhead;
+
+		printf_P(PSTR("%-22s %5u %10lu %10lu\n"), test->name, test->len,
+				(unsigned long) cycles, (unsigned long) cycles / blocks);
+	}
+
+	// simavr stops when the CPU sleeps with interrupts disabled.
+	cli();
+	sleep_enable();
+	sleep_cpu();
+
+	return ret_code;
+}
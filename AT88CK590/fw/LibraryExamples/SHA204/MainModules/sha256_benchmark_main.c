@@ -0,0 +1,206 @@
+/** \file
+ *  \brief  Host Benchmark of the Fixed-Length SHA-256 Functions
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It times the generic sha256() against the
+ * fixed-length functions sha256_<len>() for every CryptoAuth message size, and checks
+ * that sha256_<len>(), sha256_<len>_segments() for every split of the message into three
+ * segments, and sha256_<len>_midstate() produce the same digest as sha256(). Build and
+ * run it from the fw directory with:
+ *
+ *   gcc -O2 -ILibraries/utilities LibraryExamples/SHA204/MainModules/sha256_benchmark_main.c
+ *       Libraries/utilities/sha256.c -o sha256_benchmark
+ *   ./sha256_benchmark
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock()
+
+#include "sha256.h"                    // definitions and declarations for the SHA-256 module
+
+
+//! number of digests calculated per measurement
+#define SHA256_BENCHMARK_LOOPS  (1000000UL)
+
+
+//! type of a fixed-length SHA-256 function
+typedef void (*sha256_fixed_t)(const uint8_t *message, uint8_t *digest);
+//! type of a fixed-length SHA-256 function for scattered messages
+typedef void (*sha256_fixed_segments_t)(uint8_t count, const struct sha256_segment *segments, uint8_t *digest);
+//! type of a fixed-length SHA-256 function that continues from a midstate
+typedef void (*sha256_fixed_midstate_t)(const uint32_t *midstate, uint8_t count,
+		const struct sha256_segment *segments, uint8_t *digest);
+
+//! fixed-length functions and the message they are used for
+struct sha256_benchmark_case {
+	uint32_t len;
+	sha256_fixed_t function;
+	sha256_fixed_segments_t segments_function;
+	sha256_fixed_midstate_t midstate_function;   //!< NULL for messages shorter than two blocks
+	const char *name;
+};
+
+static const struct sha256_benchmark_case sha256_benchmark_cases[] = {
+	{ 39, sha256_39, sha256_39_segments, NULL, "DeriveKey MAC" },
+	{ 55, sha256_55, sha256_55_segments, NULL, "Nonce" },
+	{ 88, sha256_88, sha256_88_segments, NULL, "MAC" },
+	{ 96, sha256_96, sha256_96_segments, sha256_96_midstate, "GenDig / outer HMAC" },
+	{ 152, sha256_152, sha256_152_segments, sha256_152_midstate, "inner HMAC" }
+};
+
+
+/** \brief This function returns the time in nanoseconds per digest since a start time.
+ * \param[in] start clock value at the start of the measurement
+ * \return nanoseconds per digest
+ */
+static double sha256_benchmark_ns(clock_t start)
+{
+	return (double) (clock() - start) * 1e9 / CLOCKS_PER_SEC / SHA256_BENCHMARK_LOOPS;
+}
+
+
+/** \brief This function compares every fixed-length variant for one message length with sha256().
+ * \param[in] test fixed-length functions to check
+ * \param[in] message message of at least test->len bytes
+ * \return number of mismatching digests
+ */
+static unsigned sha256_benchmark_check(const struct sha256_benchmark_case *test, const uint8_t *message)
+{
+	uint8_t digest_generic[SHA256_DIGEST_SIZE];
+	uint8_t digest_fixed[SHA256_DIGEST_SIZE];
+	struct sha256_segment segments[3];
+	struct sha256_ctx ctx;
+	uint16_t split1, split2;
+	unsigned mismatches = 0;
+
+	sha256(test->len, message, digest_generic);
+
+	test->function(message, digest_fixed);
+	if (memcmp(digest_generic, digest_fixed, SHA256_DIGEST_SIZE)) {
+		printf("%s: sha256_%lu() digest mismatch\n", test->name, (unsigned long) test->len);
+		mismatches++;
+	}
+
+	// Split the message at every pair of positions, including empty segments.
+	for (split1 = 0; split1 <= test->len; split1++) {
+		for (split2 = split1; split2 <= test->len; split2++) {
+			segments[0].data = message;
+			segments[0].len = split1;
+			segments[1].data = &message[split1];
+			segments[1].len = split2 - split1;
+			segments[2].data = &message[split2];
+			segments[2].len = (uint16_t) (test->len - split2);
+			test->segments_function(3, segments, digest_fixed);
+			if (memcmp(digest_generic, digest_fixed, SHA256_DIGEST_SIZE)) {
+				printf("%s: sha256_%lu_segments() digest mismatch at split %u / %u\n", test->name,
+						(unsigned long) test->len, split1, split2);
+				mismatches++;
+			}
+		}
+	}
+
+	if (test->midstate_function) {
+		sha256_init(&ctx);
+		sha256_update(&ctx, SHA256_BLOCK_SIZE, message);
+		for (split1 = 0; split1 <= test->len - SHA256_BLOCK_SIZE; split1++) {
+			segments[0].data = &message[SHA256_BLOCK_SIZE];
+			segments[0].len = split1;
+			segments[1].data = &message[SHA256_BLOCK_SIZE + split1];
+			segments[1].len = (uint16_t) (test->len - SHA256_BLOCK_SIZE - split1);
+			test->midstate_function(ctx.hash, 2, segments, digest_fixed);
+			if (memcmp(digest_generic, digest_fixed, SHA256_DIGEST_SIZE)) {
+				printf("%s: sha256_%lu_midstate() digest mismatch at split %u\n", test->name,
+						(unsigned long) test->len, split1);
+				mismatches++;
+			}
+		}
+	}
+
+	return mismatches;
+}
+
+
+/** \brief This function measures the generic and fixed-length SHA-256 functions.
+ * @return exit status of application, 1 if a digest mismatch was found
+ */
+int main(void)
+{
+	uint8_t message[160];
+	uint8_t digest_generic[SHA256_DIGEST_SIZE];
+	uint8_t digest_fixed[SHA256_DIGEST_SIZE];
+	double ns_generic, ns_fixed;
+	unsigned long loop;
+	clock_t start;
+	uint8_t i;
+	int ret_code = 0;
+
+	for (i = 0; i < sizeof(message); i++)
+		message[i] = i;
+
+	printf("%-22s %5s %12s %12s %8s\n", "message", "bytes", "generic ns", "fixed ns", "speedup");
+
+	for (i = 0; i < sizeof(sha256_benchmark_cases) / sizeof(sha256_benchmark_cases[0]); i++) {
+		const struct sha256_benchmark_case *test = &sha256_benchmark_cases[i];
+
+		// Chain the digests into the message, so the calls cannot be optimized away.
+		start = clock();
+		for (loop = 0; loop < SHA256_BENCHMARK_LOOPS; loop++) {
+			sha256(test->len, message, digest_generic);
+			message[0] = digest_generic[0];
+		}
+		ns_generic = sha256_benchmark_ns(start);
+
+		start = clock();
+		for (loop = 0; loop < SHA256_BENCHMARK_LOOPS; loop++) {
+			test->function(message, digest_fixed);
+			message[0] = digest_fixed[0];
+		}
+		ns_fixed = sha256_benchmark_ns(start);
+
+		if (sha256_benchmark_check(test, message))
+			ret_code = 1;
+
+		printf("%-22s %5lu %12.1f %12.1f %7.2fx\n", test->name, (unsigned long) test->len,
+				ns_generic, ns_fixed, ns_generic / ns_fixed);
+	}
+
+	return ret_code;
+}
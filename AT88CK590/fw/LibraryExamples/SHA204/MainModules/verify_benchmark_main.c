@@ -0,0 +1,245 @@
+/** \file
+ *  \brief  Benchmark of the Multi-Threaded Verification Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It builds a batch of MAC, HMAC and CheckMac
+ * records, corrupts the response of every 16th record, and verifies the batch with
+ * sha204v_verify() for 1 up to N threads, N being the number of online CPUs.
+ * The expected results are calculated one record at a time with sha204h_mac(),
+ * sha204h_hmac() and sha204h_check_mac(), which is also the baseline of the
+ * throughput figures. Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -pthread -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/verify_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_verify.c Libraries/SHA204Library/sha204_helper.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/sha256_batch.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       -o sha204_verify_benchmark
+ *   ./sha204_verify_benchmark [maximum number of threads]
+ *
+ * The application returns 1 if a result differs from the expected one.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+#include <unistd.h>                    // needed for sysconf()
+
+#include "sha204_verify.h"             // definitions and declarations for the Verification module
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "sha256_batch.h"              // definitions and declarations for the Multi-Buffer SHA-256 module
+
+
+//! number of records in the batch
+#define VERIFY_BENCHMARK_RECORDS  (1UL << 18)
+
+//! number of times the batch is verified per measurement
+#define VERIFY_BENCHMARK_LOOPS    (4)
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double verify_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function fills a record and calculates its response with the Helper module.
+ * \param[in] keys the 16 keys of the key table
+ * \param[in] n index of the record
+ * \param[out] record pointer to record
+ * \return status of the helper function
+ */
+static uint8_t verify_benchmark_record(uint8_t keys[SHA204_KEY_COUNT][SHA204_KEY_SIZE], uint32_t n,
+		struct sha204v_record *record)
+{
+	struct sha204h_temp_key temp_key;
+	struct sha204h_mac_in_out mac_param;
+	struct sha204h_hmac_in_out hmac_param;
+	struct sha204h_check_mac_in_out check_mac_param;
+	uint8_t i;
+
+	memset(record, 0, sizeof(*record));
+	record->key_id = n % SHA204_KEY_COUNT;
+	for (i = 0; i < SHA204_KEY_SIZE; i++)
+		record->challenge[i] = (uint8_t) (n * 13 + i);
+	for (i = 0; i < SHA204V_OTP_SIZE; i++)
+		record->otp[i] = (uint8_t) (n + 0x60 + i);
+	for (i = 0; i < SHA204V_SN_SIZE; i++)
+		record->sn[i] = (uint8_t) (n >> (i & 3) * 8) ^ i;
+	for (i = 0; i < CHECKMAC_OTHER_DATA_SIZE; i++)
+		record->other_data[i] = (uint8_t) (0x70 + i);
+
+	memset(&temp_key, 0, sizeof(temp_key));
+	memcpy(temp_key.value, record->challenge, SHA204_KEY_SIZE);
+	temp_key.valid = 1;
+
+	switch (n % 3) {
+	case 0:
+		record->opcode = SHA204_MAC;
+		record->mode = (n & 4) ? MAC_MODE_INCLUDE_SN | MAC_MODE_INCLUDE_OTP_88 : MAC_MODE_CHALLENGE;
+		mac_param.mode = record->mode;
+		mac_param.key_id = record->key_id;
+		mac_param.challenge = record->challenge;
+		mac_param.key = keys[record->key_id];
+		mac_param.otp = record->otp;
+		mac_param.sn = record->sn;
+		mac_param.response = record->response;
+		mac_param.temp_key = NULL;
+		return sha204h_mac(&mac_param);
+
+	case 1:
+		record->opcode = SHA204_HMAC;
+		record->mode = (n & 4) ? MAC_MODE_INCLUDE_SN | MAC_MODE_INCLUDE_OTP_64 : 0;
+		hmac_param.mode = record->mode;
+		hmac_param.key_id = record->key_id;
+		hmac_param.key = keys[record->key_id];
+		hmac_param.otp = record->otp;
+		hmac_param.sn = record->sn;
+		hmac_param.response = record->response;
+		hmac_param.temp_key = &temp_key;
+		return sha204h_hmac(&hmac_param);
+
+	default:
+		record->opcode = SHA204_CHECKMAC;
+		record->mode = (n & 4) ? CHECKMAC_MODE_BLOCK2_TEMPKEY | CHECKMAC_MODE_INCLUDE_OTP_64 : CHECKMAC_MODE_BLOCK2_TEMPKEY;
+		check_mac_param.mode = record->mode;
+		check_mac_param.password = keys[record->key_id];
+		check_mac_param.other_data = record->other_data;
+		check_mac_param.otp = record->otp;
+		check_mac_param.target_key = keys[record->key_id];
+		check_mac_param.client_resp = record->response;
+		check_mac_param.temp_key = &temp_key;
+		return sha204h_check_mac(&check_mac_param);
+	}
+}
+
+
+/** \brief This function checks sha204v_verify() against the Helper module and measures its scaling.
+ * \param[in] argc number of arguments
+ * \param[in] argv optional maximum number of threads
+ * @return exit status of application, 1 if a result differs
+ */
+int main(int argc, char *argv[])
+{
+	uint8_t keys[SHA204_KEY_COUNT][SHA204_KEY_SIZE];
+	struct sha204v_key_table table;
+	struct sha204v_record *records = malloc(VERIFY_BENCHMARK_RECORDS * sizeof(*records));
+	uint8_t *passed = malloc(VERIFY_BENCHMARK_RECORDS / 8);
+	uint8_t *expected = malloc(VERIFY_BENCHMARK_RECORDS / 8);
+	struct sha204v_pool *pool;
+	long threads_max = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+	uint32_t i, loop;
+	double start, single, elapsed, one_thread = 0;
+	uint8_t threads;
+	int ret_code = 0;
+
+	if (!records || !passed || !expected) {
+		printf("out of memory\n");
+		return 1;
+	}
+	if (threads_max < 1)
+		threads_max = 1;
+	if (threads_max > SHA204V_THREADS_MAX)
+		threads_max = SHA204V_THREADS_MAX;
+
+	sha204v_key_table_init(&table);
+	for (i = 0; i < SHA204_KEY_COUNT * SHA204_KEY_SIZE; i++)
+		keys[i / SHA204_KEY_SIZE][i % SHA204_KEY_SIZE] = (uint8_t) (i * 7 + 3);
+	for (i = 0; i < SHA204_KEY_COUNT; i++)
+		sha204v_key_table_load(&table, i, keys[i]);
+
+	// Build the batch. Its expected results are timed as the one-at-a-time baseline.
+	memset(expected, 0, VERIFY_BENCHMARK_RECORDS / 8);
+	start = verify_benchmark_now();
+	for (i = 0; i < VERIFY_BENCHMARK_RECORDS; i++) {
+		if (verify_benchmark_record(keys, i, &records[i]) != SHA204_SUCCESS) {
+			printf("helper failed for record %u\n", (unsigned) i);
+			return 1;
+		}
+		if ((i & 0x0F) == 0x0F)
+			records[i].response[i % SHA204_KEY_SIZE] ^= 0x01;
+		else
+			expected[i >> 3] |= (uint8_t) (1 << (i & 7));
+	}
+	single = verify_benchmark_now() - start;
+
+	printf("SHA-256 lanes: %u, records: %lu\n", sha256_batch_lanes(), VERIFY_BENCHMARK_RECORDS);
+	printf("%-10s %12s %10s %10s\n", "threads", "records/s", "speedup", "vs single");
+	printf("%-10s %12.0f %10s %10.2f\n", "helper", VERIFY_BENCHMARK_RECORDS / single, "", 1.0);
+
+	for (threads = 1; threads <= threads_max; threads++) {
+		if (sha204v_pool_create(threads, &pool) != SHA204_SUCCESS) {
+			printf("could not create %u threads\n", threads);
+			ret_code = 1;
+			break;
+		}
+
+		memset(passed, 0xA5, VERIFY_BENCHMARK_RECORDS / 8);
+		start = verify_benchmark_now();
+		for (loop = 0; loop < VERIFY_BENCHMARK_LOOPS; loop++)
+			sha204v_verify(pool, &table, VERIFY_BENCHMARK_RECORDS, records, passed);
+		elapsed = (verify_benchmark_now() - start) / VERIFY_BENCHMARK_LOOPS;
+		sha204v_pool_destroy(pool);
+
+		if (memcmp(passed, expected, VERIFY_BENCHMARK_RECORDS / 8)) {
+			printf("%-10u FAILED\n", threads);
+			ret_code = 1;
+			continue;
+		}
+		if (threads == 1)
+			one_thread = elapsed;
+		printf("%-10u %12.0f %10.2f %10.2f\n", threads, VERIFY_BENCHMARK_RECORDS / elapsed,
+				one_thread / elapsed, single / elapsed);
+	}
+
+	free(expected);
+	free(passed);
+	free(records);
+
+	return ret_code;
+}
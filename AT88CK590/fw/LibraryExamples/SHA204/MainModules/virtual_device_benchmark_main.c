@@ -0,0 +1,667 @@
+/** \file
+ *  \brief  Host Application That Runs the Command Marshaling Layer against Virtual Devices
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It attaches two virtual ATSHA204 devices,
+ * personalizes them with Write and Lock commands, and runs the authentication, encrypted
+ * read / write, and key derivation flows of the library against them through the
+ * unmodified Communication and Command Marshaling layers. Every result is compared
+ * with the sha204h_* calculation of the host. Then it measures how many commands
+ * per second the stack executes, at memory speed and, in the timing-accurate mode of
+ * the virtual device, in virtual time. Last, it injects every kind of bus fault at
+ * increasing rates and reports how latency and throughput degrade while the retry and
+ * resynchronization paths of the Communication layer recover. Build and run it from
+ * the fw directory with:
+ *
+ *   gcc -O2 -DSHA204_VIRTUAL -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/virtual_device_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_virtual_device.c Libraries/SHA204Library/sha204_comm.c
+ *       Libraries/SHA204Library/sha204_comm_marshaling.c Libraries/SHA204Library/sha204_helper.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/sha256_batch.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       Libraries/utilities/timer_utilities_host.c Libraries/utilities/fault_injection.c
+ *       -o sha204_virtual_device_benchmark
+ *   ./sha204_virtual_device_benchmark
+ *
+ * The application returns 1 if a result differs.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+
+#include "sha204_virtual_device.h"     // definitions and declarations for the Virtual Device module
+#include "sha204_comm_marshaling.h"    // definitions and declarations for the Command Marshaling module
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "sha204_physical.h"           // declarations that are common to all interface implementations
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+#include "timer_utilities_host.h"      // declarations of the virtual clock
+
+
+//! ID of the client device
+#define VIRTUAL_BENCHMARK_CLIENT       ((uint8_t) 0xC8)
+
+//! ID of the host device that checks the MACs of the client
+#define VIRTUAL_BENCHMARK_HOST         ((uint8_t) 0xCA)
+
+//! number of Nonce / MAC flows per measurement
+#define VIRTUAL_BENCHMARK_FLOWS        (20000)
+
+//! number of flows per measurement in timing-accurate mode
+#define VIRTUAL_BENCHMARK_TIMED_FLOWS  (1000)
+
+//! acceleration factor of the real-time check
+#define VIRTUAL_BENCHMARK_ACCELERATION (100)
+
+//! number of flows per fault type and rate
+#define VIRTUAL_BENCHMARK_FAULT_FLOWS  (500)
+
+//! fault rates in parts of FAULT_RATE_SCALE
+static const uint16_t virtual_benchmark_fault_rates[] = {0, 50, 100, 200, 500, 1000, 2000};
+
+//! names of the fault types
+static const char *virtual_benchmark_fault_names[FAULT_TYPE_COUNT] = {"CRC flip", "ACK drop", "count cut", "0xFF sync"};
+
+/** \name Slots of the Personalized Devices
+@{ */
+#define VIRTUAL_BENCHMARK_KEY_MAC       (0)   //!< secret MAC key, also the key of encrypted reads and writes
+#define VIRTUAL_BENCHMARK_KEY_ENCRYPTED (1)   //!< slot read and written encrypted
+#define VIRTUAL_BENCHMARK_KEY_ROLL      (2)   //!< key rolled by DeriveKey
+#define VIRTUAL_BENCHMARK_KEY_CREATE    (3)   //!< key created by DeriveKey from its parent, with input MAC
+#define VIRTUAL_BENCHMARK_KEY_PARENT    (4)   //!< parent key of VIRTUAL_BENCHMARK_KEY_CREATE
+#define VIRTUAL_BENCHMARK_KEY_PASSWORD  (5)   //!< check-only password
+#define VIRTUAL_BENCHMARK_KEY_CLEAR     (6)   //!< data readable and writable in the clear
+/** @} */
+
+//! SlotConfig of the slots above, the remaining slots keep 0
+static const uint16_t virtual_benchmark_slot_config[] = {
+	SHA204D_SLOT_IS_SECRET | SHA204D_SLOT_DERIVE_MAC,
+	SHA204D_SLOT_IS_SECRET | SHA204D_SLOT_ENCRYPT_READ | SHA204D_SLOT_WRITE_ENCRYPT,
+	SHA204D_SLOT_IS_SECRET | SHA204D_SLOT_DERIVE_KEY,
+	SHA204D_SLOT_IS_SECRET | SHA204D_SLOT_DERIVE_MAC | SHA204D_SLOT_DERIVE_KEY | SHA204D_SLOT_DERIVE_CREATE
+			| (VIRTUAL_BENCHMARK_KEY_PARENT << SHA204D_SLOT_WRITE_KEY_SHIFT),
+	SHA204D_SLOT_IS_SECRET | SHA204D_SLOT_DERIVE_MAC,
+	SHA204D_SLOT_IS_SECRET | SHA204D_SLOT_CHECK_ONLY | SHA204D_SLOT_DERIVE_MAC,
+	0
+};
+
+//! copy of the data zone, as the host expects it
+static uint8_t virtual_benchmark_data[SHA204_DATA_SIZE];
+
+//! copy of the OTP zone
+static uint8_t virtual_benchmark_otp[SHA204_OTP_SIZE];
+
+//! number of failed checks
+static unsigned int virtual_benchmark_failures;
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double virtual_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function records the result of a check.
+ * \param[in] name name of the check
+ * \param[in] passed whether the check passed
+ */
+static void virtual_benchmark_check(const char *name, int passed)
+{
+	printf("%-44s %s\n", name, passed ? "ok" : "FAILED");
+	if (!passed)
+		virtual_benchmark_failures++;
+}
+
+
+/** \brief This function personalizes the selected device with the slot configuration and zones above.
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_personalize(void)
+{
+	uint8_t command[WRITE_COUNT_LONG];
+	uint8_t response[READ_32_RSP_SIZE];
+	uint8_t config[SHA204_CONFIG_SIZE];
+	uint8_t crc[SHA204_CRC_SIZE] = {0, 0};
+	uint16_t address, key_id;
+	uint8_t ret_code;
+
+	ret_code = sha204c_wakeup(response);
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	// Read the configuration zone, change SlotConfig, and write it back.
+	for (address = 0; (address < SHA204_CONFIG_SIZE) && (ret_code == SHA204_SUCCESS); address += SHA204_ZONE_ACCESS_4) {
+		ret_code = sha204m_read(command, response, SHA204_ZONE_CONFIG, address);
+		memcpy(&config[address], &response[SHA204_BUFFER_POS_DATA], SHA204_ZONE_ACCESS_4);
+	}
+	for (key_id = 0; key_id < sizeof(virtual_benchmark_slot_config) / sizeof(virtual_benchmark_slot_config[0]); key_id++) {
+		config[SHA204D_CONFIG_SLOT_CONFIG + 2 * key_id] = virtual_benchmark_slot_config[key_id] & 0xFF;
+		config[SHA204D_CONFIG_SLOT_CONFIG + 2 * key_id + 1] = virtual_benchmark_slot_config[key_id] >> 8;
+	}
+	config[SHA204D_CONFIG_OTP_MODE] = SHA204D_OTP_MODE_CONSUMPTION;
+	for (address = SHA204D_CONFIG_WRITABLE; (address < SHA204D_CONFIG_USER_EXTRA) && (ret_code == SHA204_SUCCESS);
+			address += SHA204_ZONE_ACCESS_4)
+		ret_code = sha204m_write(command, response, SHA204_ZONE_CONFIG, address, &config[address], NULL);
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	sha204c_calculate_crc(sizeof(config), config, crc);
+	ret_code = sha204m_lock(command, response, SHA204_ZONE_CONFIG, crc[0] | ((uint16_t) crc[1] << 8));
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	// Write the data and OTP zones in the clear, then lock them.
+	for (address = 0; (address < SHA204_DATA_SIZE) && (ret_code == SHA204_SUCCESS); address += SHA204_ZONE_ACCESS_32)
+		ret_code = sha204m_write(command, response, SHA204_ZONE_COUNT_FLAG | SHA204_ZONE_DATA, address,
+				&virtual_benchmark_data[address], NULL);
+	for (address = 0; (address < SHA204_OTP_SIZE) && (ret_code == SHA204_SUCCESS); address += SHA204_ZONE_ACCESS_32)
+		ret_code = sha204m_write(command, response, SHA204_ZONE_COUNT_FLAG | SHA204_ZONE_OTP, address,
+				&virtual_benchmark_otp[address], NULL);
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	crc[0] = crc[1] = 0;
+	for (address = 0; address < SHA204_DATA_SIZE; address += SHA204_OTP_SIZE)
+		sha204h_calculate_crc_chain(SHA204_OTP_SIZE, &virtual_benchmark_data[address], crc);
+	sha204h_calculate_crc_chain(SHA204_OTP_SIZE, virtual_benchmark_otp, crc);
+	ret_code = sha204m_lock(command, response, LOCK_ZONE_NO_CONFIG, crc[0] | ((uint16_t) crc[1] << 8));
+
+	sha204p_sleep();
+
+	return ret_code;
+}
+
+
+/** \brief This function sends a random Nonce and calculates the same TempKey on the host.
+ * \param[out] temp_key pointer to TempKey of the host
+ * \param[in] num_in pointer to 20-byte input
+ * \return status of the operation
+ */
+static uint8_t virtual_benchmark_nonce(struct sha204h_temp_key *temp_key, uint8_t *num_in)
+{
+	struct sha204h_nonce_in_out nonce_param;
+	uint8_t command[NONCE_COUNT_LONG];
+	uint8_t response[NONCE_RSP_SIZE_LONG];
+	uint8_t ret_code;
+
+	ret_code = sha204m_nonce(command, response, NONCE_MODE_SEED_UPDATE, num_in);
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	nonce_param.mode = NONCE_MODE_SEED_UPDATE;
+	nonce_param.num_in = num_in;
+	nonce_param.rand_out = &response[SHA204_BUFFER_POS_DATA];
+	nonce_param.temp_key = temp_key;
+
+	return sha204h_nonce(&nonce_param);
+}
+
+
+/** \brief This function measures Wake, Nonce / MAC, Sleep flows with bus faults.
+ *
+ * The client runs with typical execution times, so latency and throughput are
+ * in virtual time. Faults are injected into the Nonce and MAC commands only,
+ * because sha204c_wakeup() does not retry. A flow fails if the Communication layer
+ * gives up, and the latency is the mean of the flows that succeed. A MAC that
+ * differs from the one of a flow without faults counts as a check failure.
+ * \param[in, out] client pointer to the selected device
+ * \param[in] num_in pointer to 32-byte input of the pass-through Nonce
+ */
+static void virtual_benchmark_faults(struct sha204d_device *client, uint8_t *num_in)
+{
+	struct fault_injector injector;
+	uint8_t command[NONCE_COUNT_LONG];
+	uint8_t response[MAC_RSP_SIZE];
+	uint8_t wakeup_response[SHA204_RSP_SIZE_MIN];
+	uint8_t expected[MAC_RSP_SIZE];
+	uint32_t i, commands, failed, wrong, virtual_start, flow_start;
+	uint8_t type, rate;
+	uint8_t ret_code;
+	double elapsed, latency;
+
+	client->timing = SHA204D_TIMING_TYPICAL;
+
+	printf("\n%-10s %7s %12s %10s %10s %10s %8s\n", "fault", "rate", "ms/flow", "flows/s",
+			"cmds/flow", "faults", "failed");
+	for (type = 0; type < FAULT_TYPE_COUNT; type++) {
+		for (rate = 0; rate < sizeof(virtual_benchmark_fault_rates) / sizeof(virtual_benchmark_fault_rates[0]); rate++) {
+			fault_init(&injector, 0x5EED + type);
+			injector.rate[type] = virtual_benchmark_fault_rates[rate];
+			commands = client->commands;
+			failed = wrong = 0;
+			latency = 0;
+			virtual_start = timer_host_get_time();
+			for (i = 0; i < VIRTUAL_BENCHMARK_FAULT_FLOWS; i++) {
+				flow_start = timer_host_get_time();
+				ret_code = sha204c_wakeup(wakeup_response);
+				sha204d_set_fault_injector(&injector);
+				if (ret_code == SHA204_SUCCESS)
+					ret_code = sha204m_nonce(command, response, NONCE_MODE_PASSTHROUGH, num_in);
+				if (ret_code == SHA204_SUCCESS)
+					ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY | MAC_MODE_SOURCE_FLAG_MATCH,
+							VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+				sha204d_set_fault_injector(NULL);
+				sha204p_sleep();
+				if (ret_code != SHA204_SUCCESS) {
+					failed++;
+					continue;
+				}
+				latency += timer_host_get_time() - flow_start;
+				if (!type && !rate && !i)
+					memcpy(expected, response, sizeof(expected));
+				else if (memcmp(response, expected, sizeof(expected)))
+					wrong++;
+			}
+			elapsed = (timer_host_get_time() - virtual_start) / 1e6;
+			commands = client->commands - commands;
+			if (!rate)
+				virtual_benchmark_check("Flows without faults", !failed && !wrong);
+			else if (wrong)
+				virtual_benchmark_check("Corrupted MAC is not accepted", 0);
+			printf("%-10s %6.1f%% %12.2f %10.1f %10.2f %10lu %8lu\n", virtual_benchmark_fault_names[type],
+					virtual_benchmark_fault_rates[rate] * 100.0 / FAULT_RATE_SCALE,
+					failed < VIRTUAL_BENCHMARK_FAULT_FLOWS ? latency / 1e3 / (VIRTUAL_BENCHMARK_FAULT_FLOWS - failed) : 0,
+					(VIRTUAL_BENCHMARK_FAULT_FLOWS - failed) / elapsed,
+					(double) commands / VIRTUAL_BENCHMARK_FAULT_FLOWS, (unsigned long) injector.injected[type],
+					(unsigned long) failed);
+		}
+	}
+
+	client->timing = SHA204D_TIMING_OFF;
+}
+
+
+/** \brief This function personalizes the devices, runs the flows, and measures them.
+ * @return exit status of application, 1 if a result differs
+ */
+int main(void)
+{
+	static struct sha204d_device client, host;
+	static const uint8_t client_sn[SHA204D_SN_SIZE] = {0x01, 0x23, 0x5A, 0x10, 0x00, 0x00, 0x41, 0x07, 0xEE};
+	static const uint8_t host_sn[SHA204D_SN_SIZE] = {0x01, 0x23, 0x5A, 0x11, 0x00, 0x00, 0x41, 0x08, 0xEE};
+	uint8_t command[CHECKMAC_COUNT];
+	uint8_t response[SHA204_RSP_SIZE_MAX];
+	uint8_t wakeup_response[SHA204_RSP_SIZE_MIN];
+	uint8_t challenge[MAC_CHALLENGE_SIZE];
+	uint8_t expected[SHA204_KEY_SIZE];
+	uint8_t plain[SHA204_KEY_SIZE];
+	uint8_t cipher[SHA204_KEY_SIZE];
+	uint8_t mac[WRITE_MAC_SIZE];
+	uint8_t num_in[NONCE_NUMIN_SIZE_PASSTHROUGH];
+	uint8_t other_data[CHECKMAC_OTHER_DATA_SIZE];
+	uint8_t sn[SHA204D_SN_SIZE];
+	struct sha204h_temp_key temp_key;
+	struct sha204h_mac_in_out mac_param;
+	struct sha204h_hmac_in_out hmac_param;
+	struct sha204h_gen_dig_in_out gen_dig_param;
+	struct sha204h_encrypt_in_out encrypt_param;
+	struct sha204h_decrypt_in_out decrypt_param;
+	struct sha204h_derive_key_in_out derive_param;
+	struct sha204h_derive_key_mac_in_out derive_mac_param;
+	struct sha204h_check_mac_in_out check_mac_param;
+	uint32_t i, commands, virtual_start;
+	double start, elapsed;
+	uint8_t timing;
+	uint8_t ret_code;
+
+	for (i = 0; i < sizeof(virtual_benchmark_data); i++)
+		virtual_benchmark_data[i] = (uint8_t) (i * 7 + 3);
+	for (i = 0; i < sizeof(virtual_benchmark_otp); i++)
+		virtual_benchmark_otp[i] = (uint8_t) ~i;
+	for (i = 0; i < sizeof(num_in); i++)
+		num_in[i] = (uint8_t) (0xA0 + i);
+	for (i = 0; i < sizeof(challenge); i++)
+		challenge[i] = (uint8_t) (i * 13);
+	memcpy(sn, client_sn, sizeof(sn));
+
+	sha204d_device_init(&client, client_sn, challenge);
+	sha204d_device_init(&host, host_sn, num_in);
+	sha204d_attach(VIRTUAL_BENCHMARK_CLIENT, &client);
+	sha204d_attach(VIRTUAL_BENCHMARK_HOST, &host);
+	sha204p_init();
+
+	sha204p_set_device_id(VIRTUAL_BENCHMARK_HOST);
+	ret_code = virtual_benchmark_personalize();
+	virtual_benchmark_check("personalize host device", ret_code == SHA204_SUCCESS);
+	sha204p_set_device_id(VIRTUAL_BENCHMARK_CLIENT);
+	ret_code = virtual_benchmark_personalize();
+	virtual_benchmark_check("personalize client device", ret_code == SHA204_SUCCESS);
+
+	// MAC on the client, checked by the host device with CheckMac.
+	mac_param.mode = MAC_MODE_CHALLENGE;
+	mac_param.key_id = VIRTUAL_BENCHMARK_KEY_MAC;
+	mac_param.challenge = challenge;
+	mac_param.key = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_MAC * SHA204_KEY_SIZE];
+	mac_param.otp = NULL;
+	mac_param.sn = NULL;
+	mac_param.response = expected;
+	mac_param.temp_key = NULL;
+	sha204h_mac(&mac_param);
+	sha204c_wakeup(wakeup_response);
+	ret_code = sha204m_mac(command, response, MAC_MODE_CHALLENGE, VIRTUAL_BENCHMARK_KEY_MAC, challenge);
+	sha204p_sleep();
+	virtual_benchmark_check("MAC with challenge",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], expected, sizeof(expected)));
+
+	memset(other_data, 0, sizeof(other_data));
+	other_data[0] = SHA204_MAC;
+	other_data[1] = MAC_MODE_CHALLENGE;
+	other_data[2] = VIRTUAL_BENCHMARK_KEY_MAC;
+	sha204p_set_device_id(VIRTUAL_BENCHMARK_HOST);
+	sha204c_wakeup(wakeup_response);
+	ret_code = sha204m_check_mac(command, response, CHECKMAC_MODE_CHALLENGE, VIRTUAL_BENCHMARK_KEY_MAC,
+			challenge, expected, other_data);
+	virtual_benchmark_check("CheckMac of the MAC on a second device",
+			(ret_code == SHA204_SUCCESS) && (response[SHA204_BUFFER_POS_STATUS] == SHA204D_STATUS_BYTE_SUCCESS));
+	expected[0] ^= 1;
+	ret_code = sha204m_check_mac(command, response, CHECKMAC_MODE_CHALLENGE, VIRTUAL_BENCHMARK_KEY_MAC,
+			challenge, expected, other_data);
+	virtual_benchmark_check("CheckMac of a wrong MAC is rejected",
+			(ret_code == SHA204_SUCCESS) && (response[SHA204_BUFFER_POS_STATUS] == SHA204D_STATUS_BYTE_CHECKMAC));
+	sha204p_sleep();
+	sha204p_set_device_id(VIRTUAL_BENCHMARK_CLIENT);
+
+	// Nonce and MAC over TempKey and serial number.
+	sha204c_wakeup(wakeup_response);
+	ret_code = virtual_benchmark_nonce(&temp_key, num_in);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY | MAC_MODE_INCLUDE_SN,
+				VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	mac_param.mode = MAC_MODE_BLOCK2_TEMPKEY | MAC_MODE_INCLUDE_SN;
+	mac_param.challenge = NULL;
+	mac_param.sn = sn;
+	mac_param.temp_key = &temp_key;
+	sha204h_mac(&mac_param);
+	virtual_benchmark_check("Nonce, MAC over TempKey",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], expected, sizeof(expected)));
+
+	// Nonce and HMAC.
+	ret_code = virtual_benchmark_nonce(&temp_key, num_in);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_hmac(command, response, MAC_MODE_INCLUDE_OTP_88, VIRTUAL_BENCHMARK_KEY_MAC);
+	hmac_param.mode = MAC_MODE_INCLUDE_OTP_88;
+	hmac_param.key_id = VIRTUAL_BENCHMARK_KEY_MAC;
+	hmac_param.key = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_MAC * SHA204_KEY_SIZE];
+	hmac_param.otp = virtual_benchmark_otp;
+	hmac_param.sn = NULL;
+	hmac_param.response = expected;
+	hmac_param.temp_key = &temp_key;
+	sha204h_hmac(&hmac_param);
+	virtual_benchmark_check("Nonce, HMAC including OTP",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], expected, sizeof(expected)));
+
+	// Encrypted write, then encrypted read of the same slot.
+	for (i = 0; i < sizeof(plain); i++)
+		plain[i] = (uint8_t) (0x5A ^ i);
+	gen_dig_param.zone = GENDIG_ZONE_DATA;
+	gen_dig_param.key_id = VIRTUAL_BENCHMARK_KEY_MAC;
+	gen_dig_param.stored_value = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_MAC * SHA204_KEY_SIZE];
+	gen_dig_param.temp_key = &temp_key;
+	ret_code = virtual_benchmark_nonce(&temp_key, num_in);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_gen_dig(command, response, GENDIG_ZONE_DATA, VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	sha204h_gen_dig(&gen_dig_param);
+	memcpy(cipher, plain, sizeof(cipher));
+	encrypt_param.zone = SHA204_ZONE_COUNT_FLAG | WRITE_ZONE_WITH_MAC | SHA204_ZONE_DATA;
+	encrypt_param.address = VIRTUAL_BENCHMARK_KEY_ENCRYPTED * SHA204_KEY_SIZE / SHA204_ZONE_ACCESS_4;
+	encrypt_param.crypto_data = cipher;
+	encrypt_param.mac = mac;
+	encrypt_param.temp_key = &temp_key;
+	sha204h_encrypt(&encrypt_param);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_write(command, response, encrypt_param.zone,
+				VIRTUAL_BENCHMARK_KEY_ENCRYPTED * SHA204_KEY_SIZE, cipher, mac);
+	virtual_benchmark_check("Nonce, GenDig, encrypted Write", ret_code == SHA204_SUCCESS);
+
+	ret_code = virtual_benchmark_nonce(&temp_key, num_in);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_gen_dig(command, response, GENDIG_ZONE_DATA, VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	sha204h_gen_dig(&gen_dig_param);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_read(command, response, SHA204_ZONE_COUNT_FLAG | SHA204_ZONE_DATA,
+				VIRTUAL_BENCHMARK_KEY_ENCRYPTED * SHA204_KEY_SIZE);
+	decrypt_param.crypto_data = &response[SHA204_BUFFER_POS_DATA];
+	decrypt_param.temp_key = &temp_key;
+	sha204h_decrypt(&decrypt_param);
+	virtual_benchmark_check("Nonce, GenDig, encrypted Read",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], plain, sizeof(plain)));
+
+	// Roll a key with a pass-through nonce, and create a key with an input MAC.
+	temp_key.valid = 0;
+	ret_code = sha204m_nonce(command, response, NONCE_MODE_PASSTHROUGH, num_in);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_derive_key(command, response, DERIVE_KEY_RANDOM_FLAG, VIRTUAL_BENCHMARK_KEY_ROLL, NULL);
+	memcpy(temp_key.value, num_in, sizeof(temp_key.value));
+	temp_key.source_flag = 1;
+	temp_key.check_flag = 0;
+	temp_key.valid = 1;
+	derive_param.random = DERIVE_KEY_RANDOM_FLAG;
+	derive_param.target_key_id = VIRTUAL_BENCHMARK_KEY_ROLL;
+	derive_param.parent_key = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_ROLL * SHA204_KEY_SIZE];
+	derive_param.target_key = derive_param.parent_key;
+	derive_param.temp_key = &temp_key;
+	sha204h_derive_key(&derive_param);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_CHALLENGE, VIRTUAL_BENCHMARK_KEY_ROLL, challenge);
+	mac_param.mode = MAC_MODE_CHALLENGE;
+	mac_param.key_id = VIRTUAL_BENCHMARK_KEY_ROLL;
+	mac_param.challenge = challenge;
+	mac_param.key = derive_param.target_key;
+	mac_param.sn = NULL;
+	mac_param.temp_key = NULL;
+	sha204h_mac(&mac_param);
+	virtual_benchmark_check("Nonce, DeriveKey (roll), MAC",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], expected, sizeof(expected)));
+
+	ret_code = virtual_benchmark_nonce(&temp_key, num_in);
+	derive_mac_param.random = 0;
+	derive_mac_param.target_key_id = VIRTUAL_BENCHMARK_KEY_CREATE;
+	derive_mac_param.parent_key = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_PARENT * SHA204_KEY_SIZE];
+	derive_mac_param.mac = mac;
+	sha204h_derive_key_mac(&derive_mac_param);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_derive_key(command, response, 0, VIRTUAL_BENCHMARK_KEY_CREATE, mac);
+	derive_param.random = 0;
+	derive_param.target_key_id = VIRTUAL_BENCHMARK_KEY_CREATE;
+	derive_param.parent_key = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_PARENT * SHA204_KEY_SIZE];
+	derive_param.target_key = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_CREATE * SHA204_KEY_SIZE];
+	sha204h_derive_key(&derive_param);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_CHALLENGE, VIRTUAL_BENCHMARK_KEY_CREATE, challenge);
+	mac_param.key_id = VIRTUAL_BENCHMARK_KEY_CREATE;
+	mac_param.key = derive_param.target_key;
+	sha204h_mac(&mac_param);
+	virtual_benchmark_check("Nonce, DeriveKey (create with MAC), MAC",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], expected, sizeof(expected)));
+
+	// Check a password, which copies the password slot into TempKey, and use it in a MAC.
+	ret_code = virtual_benchmark_nonce(&temp_key, num_in);
+	check_mac_param.mode = CHECKMAC_MODE_BLOCK2_TEMPKEY;
+	check_mac_param.password = &virtual_benchmark_data[VIRTUAL_BENCHMARK_KEY_PASSWORD * SHA204_KEY_SIZE];
+	check_mac_param.other_data = other_data;
+	check_mac_param.otp = NULL;
+	check_mac_param.target_key = check_mac_param.password;
+	check_mac_param.client_resp = expected;
+	check_mac_param.temp_key = &temp_key;
+	sha204h_check_mac(&check_mac_param);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_check_mac(command, response, CHECKMAC_MODE_BLOCK2_TEMPKEY, VIRTUAL_BENCHMARK_KEY_PASSWORD,
+				challenge, expected, other_data);
+	if ((ret_code == SHA204_SUCCESS) && (response[SHA204_BUFFER_POS_STATUS] != SHA204D_STATUS_BYTE_SUCCESS))
+		ret_code = SHA204_CHECKMAC_FAILED;
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK1_TEMPKEY | MAC_MODE_SOURCE_FLAG_MATCH,
+				VIRTUAL_BENCHMARK_KEY_MAC, challenge);
+	mac_param.mode = MAC_MODE_BLOCK1_TEMPKEY | MAC_MODE_SOURCE_FLAG_MATCH;
+	mac_param.key_id = VIRTUAL_BENCHMARK_KEY_MAC;
+	mac_param.temp_key = &temp_key;
+	sha204h_mac(&mac_param);
+	virtual_benchmark_check("Nonce, CheckMac (password), MAC over TempKey",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], expected, sizeof(expected)));
+
+	// Access rules.
+	ret_code = sha204m_read(command, response, SHA204_ZONE_COUNT_FLAG | SHA204_ZONE_DATA,
+			VIRTUAL_BENCHMARK_KEY_MAC * SHA204_KEY_SIZE);
+	virtual_benchmark_check("Read of a secret slot is rejected", ret_code == SHA204_CMD_FAIL);
+	ret_code = sha204m_write(command, response, SHA204_ZONE_COUNT_FLAG | SHA204_ZONE_DATA,
+			VIRTUAL_BENCHMARK_KEY_MAC * SHA204_KEY_SIZE, plain, NULL);
+	virtual_benchmark_check("Clear Write of a secret slot is rejected", ret_code == SHA204_CMD_FAIL);
+	ret_code = sha204m_mac(command, response, MAC_MODE_CHALLENGE, VIRTUAL_BENCHMARK_KEY_PASSWORD, challenge);
+	virtual_benchmark_check("MAC with a check-only key is rejected", ret_code == SHA204_CMD_FAIL);
+	ret_code = sha204m_write(command, response, SHA204_ZONE_COUNT_FLAG | SHA204_ZONE_DATA,
+			VIRTUAL_BENCHMARK_KEY_CLEAR * SHA204_KEY_SIZE, plain, NULL);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_read(command, response, SHA204_ZONE_COUNT_FLAG | SHA204_ZONE_DATA,
+				VIRTUAL_BENCHMARK_KEY_CLEAR * SHA204_KEY_SIZE);
+	virtual_benchmark_check("Write and Read in the clear",
+			(ret_code == SHA204_SUCCESS) && !memcmp(&response[SHA204_BUFFER_POS_DATA], plain, sizeof(plain)));
+
+	// Idle mode keeps TempKey, Sleep mode loses it.
+	ret_code = sha204m_nonce(command, response, NONCE_MODE_PASSTHROUGH, num_in);
+	sha204p_idle();
+	sha204c_wakeup(wakeup_response);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY | MAC_MODE_SOURCE_FLAG_MATCH,
+				VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	virtual_benchmark_check("TempKey is kept in Idle mode", ret_code == SHA204_SUCCESS);
+	ret_code = sha204m_nonce(command, response, NONCE_MODE_PASSTHROUGH, num_in);
+	sha204p_sleep();
+	sha204c_wakeup(wakeup_response);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY | MAC_MODE_SOURCE_FLAG_MATCH,
+				VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	virtual_benchmark_check("TempKey is lost in Sleep mode", ret_code == SHA204_CMD_FAIL);
+	sha204p_sleep();
+
+	// Measure Nonce / MAC flows, once in one wake period and once with Wake and Sleep for every flow.
+	mac_param.mode = MAC_MODE_BLOCK2_TEMPKEY;
+	mac_param.sn = NULL;
+	sha204c_wakeup(wakeup_response);
+	commands = client.commands;
+	start = virtual_benchmark_now();
+	for (i = 0, ret_code = SHA204_SUCCESS; (i < VIRTUAL_BENCHMARK_FLOWS) && (ret_code == SHA204_SUCCESS); i++) {
+		ret_code = sha204m_nonce(command, response, NONCE_MODE_NO_SEED_UPDATE, num_in);
+		if (ret_code == SHA204_SUCCESS)
+			ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY, VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	}
+	elapsed = virtual_benchmark_now() - start;
+	commands = client.commands - commands;
+	sha204p_sleep();
+	virtual_benchmark_check("Nonce / MAC flows", ret_code == SHA204_SUCCESS);
+	printf("%-44s %10.0f commands/s %10.0f flows/s\n", "Nonce / MAC in one wake period",
+			commands / elapsed, VIRTUAL_BENCHMARK_FLOWS / elapsed);
+
+	commands = client.commands;
+	start = virtual_benchmark_now();
+	for (i = 0, ret_code = SHA204_SUCCESS; (i < VIRTUAL_BENCHMARK_FLOWS) && (ret_code == SHA204_SUCCESS); i++) {
+		ret_code = sha204c_wakeup(wakeup_response);
+		if (ret_code == SHA204_SUCCESS)
+			ret_code = sha204m_nonce(command, response, NONCE_MODE_NO_SEED_UPDATE, num_in);
+		if (ret_code == SHA204_SUCCESS)
+			ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY, VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+		sha204p_sleep();
+	}
+	elapsed = virtual_benchmark_now() - start;
+	commands = client.commands - commands;
+	virtual_benchmark_check("Wake, Nonce / MAC, Sleep flows", ret_code == SHA204_SUCCESS);
+	printf("%-44s %10.0f commands/s %10.0f flows/s\n", "Wake, Nonce / MAC, Sleep",
+			commands / elapsed, VIRTUAL_BENCHMARK_FLOWS / elapsed);
+
+	// Measure the same flows in virtual time, with typical and with maximum execution times.
+	// The library waits and polls as it would on hardware.
+	for (timing = SHA204D_TIMING_TYPICAL; timing <= SHA204D_TIMING_MAX; timing++) {
+		client.timing = timing;
+		commands = client.commands;
+		virtual_start = timer_host_get_time();
+		for (i = 0, ret_code = SHA204_SUCCESS; (i < VIRTUAL_BENCHMARK_TIMED_FLOWS) && (ret_code == SHA204_SUCCESS); i++) {
+			ret_code = sha204c_wakeup(wakeup_response);
+			if (ret_code == SHA204_SUCCESS)
+				ret_code = sha204m_nonce(command, response, NONCE_MODE_NO_SEED_UPDATE, num_in);
+			if (ret_code == SHA204_SUCCESS)
+				ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY, VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+			sha204p_sleep();
+		}
+		elapsed = (timer_host_get_time() - virtual_start) / 1e6;
+		commands = client.commands - commands;
+		virtual_benchmark_check(timing == SHA204D_TIMING_TYPICAL ? "Timed flows, typical execution times"
+				: "Timed flows, maximum execution times", ret_code == SHA204_SUCCESS);
+		printf("%-44s %10.0f commands/s %10.0f flows/s\n", timing == SHA204D_TIMING_TYPICAL
+				? "Wake, Nonce / MAC, Sleep, typical (virtual)" : "Wake, Nonce / MAC, Sleep, maximum (virtual)",
+				commands / elapsed, VIRTUAL_BENCHMARK_TIMED_FLOWS / elapsed);
+	}
+
+	// The watchdog puts the device to sleep, and TempKey is lost.
+	client.timing = SHA204D_TIMING_TYPICAL;
+	sha204c_wakeup(wakeup_response);
+	ret_code = sha204m_nonce(command, response, NONCE_MODE_PASSTHROUGH, num_in);
+	timer_host_advance(SHA204D_WATCHDOG_TIME);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY | MAC_MODE_SOURCE_FLAG_MATCH,
+				VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	virtual_benchmark_check("TempKey is lost when the watchdog expires",
+			(ret_code == SHA204_CMD_FAIL) && (client.watchdog_expirations == 1));
+	sha204p_sleep();
+
+	// With acceleration, delays take real time.
+	timer_host_set_acceleration(VIRTUAL_BENCHMARK_ACCELERATION);
+	virtual_start = timer_host_get_time();
+	start = virtual_benchmark_now();
+	ret_code = sha204c_wakeup(wakeup_response);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_nonce(command, response, NONCE_MODE_NO_SEED_UPDATE, num_in);
+	if (ret_code == SHA204_SUCCESS)
+		ret_code = sha204m_mac(command, response, MAC_MODE_BLOCK2_TEMPKEY, VIRTUAL_BENCHMARK_KEY_MAC, NULL);
+	sha204p_sleep();
+	elapsed = virtual_benchmark_now() - start;
+	timer_host_set_acceleration(0);
+	client.timing = SHA204D_TIMING_OFF;
+	virtual_benchmark_check("Accelerated flow takes real time", (ret_code == SHA204_SUCCESS)
+			&& (elapsed * 1e6 * VIRTUAL_BENCHMARK_ACCELERATION >= timer_host_get_time() - virtual_start));
+
+	virtual_benchmark_faults(&client, num_in);
+
+	return virtual_benchmark_failures ? 1 : 0;
+}
@@ -0,0 +1,272 @@
+/** \file
+ *  \brief  Benchmark of the Encrypted Write Lot Module
+ *  \author Atmel Crypto Products
+ *  \date   October 17, 2026
+ * \copyright Copyright (c) 2013 Atmel Corporation. All rights reserved.
+ *
+ * \atmel_crypto_device_library_license_start
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. The name of Atmel may not be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * 4. This software may only be redistributed and used in connection with an
+ *    Atmel integrated circuit.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * EXPRESSLY AND SPECIFICALLY DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \atmel_crypto_device_library_license_stop
+ */
+
+/*
+ * This is a host application, not firmware. It builds a lot file for a random manifest
+ * with 1 up to N threads, and then provisions every device of the lot the way a line
+ * does: it finds the record by serial number, draws a RandOut, and calculates the cipher
+ * text and input MAC with sha204w_finish(). The results are checked against the
+ * interactive calculation with sha204h_nonce(), sha204h_gen_dig() and sha204h_encrypt(),
+ * and the rates of both are reported. Build and run it from the fw directory with:
+ *
+ *   gcc -O2 -pthread -ILibraries/SHA204Library -ILibraries/utilities
+ *       LibraryExamples/SHA204/MainModules/write_lot_benchmark_main.c
+ *       Libraries/SHA204Library/sha204_write_lot.c Libraries/SHA204Library/sha204_helper.c
+ *       Libraries/utilities/sha256.c Libraries/utilities/sha256_batch.c
+ *       Libraries/utilities/cryptoauth_core.c Libraries/utilities/cryptoauth_crc.c
+ *       Libraries/utilities/cryptoauth_wipe.c Libraries/utilities/cryptoauth_file.c
+ *       -o sha204_write_lot_benchmark
+ *   ./sha204_write_lot_benchmark [maximum number of threads] [lot file]
+ *
+ * The application returns 1 if a result differs from the interactive calculation.
+ */
+
+#include <stdio.h>                     // needed for printf()
+#include <stdlib.h>                    // needed for malloc()
+#include <string.h>                    // needed for memcmp()
+#include <stdint.h>                    // data type definitions
+#include <time.h>                      // needed for clock_gettime()
+#include <unistd.h>                    // needed for sysconf()
+
+#include "sha204_write_lot.h"          // definitions and declarations for the Encrypted Write Lot module
+#include "sha204_helper.h"             // definitions and declarations for the Helper module
+#include "sha204_lib_return_codes.h"   // declarations of function return codes
+
+
+//! number of devices in the lot
+#define WRITE_LOT_BENCHMARK_DEVICES    (1UL << 17)
+
+//! number of different parent keys in the lot
+#define WRITE_LOT_BENCHMARK_KEYS       (4)
+
+
+/** \brief This function returns a monotonic time stamp.
+ * \return time in seconds
+ */
+static double write_lot_benchmark_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+
+/** \brief This function returns pseudo-random numbers (xorshift64).
+ * \param[in,out] state pointer to generator state
+ * \return next number
+ */
+static uint64_t write_lot_benchmark_random(uint64_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+
+/** \brief This function fills a buffer with pseudo-random bytes.
+ * \param[in,out] state pointer to generator state
+ * \param[in] size size of buffer
+ * \param[out] buffer pointer to buffer
+ */
+static void write_lot_benchmark_fill(uint64_t *state, uint8_t size, uint8_t *buffer)
+{
+	while (size--)
+		*buffer++ = (uint8_t) write_lot_benchmark_random(state);
+}
+
+
+/** \brief This function calculates an encrypted write the interactive way.
+ * \param[in] entry pointer to manifest entry of the device
+ * \param[in] record pointer to record of the device, for its NumIn
+ * \param[in] rand_out pointer to 32-byte RandOut
+ * \param[out] crypto_data pointer to 32-byte cipher text
+ * \param[out] mac pointer to 32-byte input MAC
+ * \return status of the operation
+ */
+static uint8_t write_lot_benchmark_interactive(const struct sha204w_manifest_entry *entry,
+		const struct sha204w_record *record, uint8_t *rand_out, uint8_t *crypto_data, uint8_t *mac)
+{
+	struct sha204h_temp_key temp_key;
+	struct sha204h_nonce_in_out nonce_param;
+	struct sha204h_gen_dig_in_out gen_dig_param;
+	struct sha204h_encrypt_in_out encrypt_param;
+	uint8_t parent_key[SHA204_KEY_SIZE];
+	uint8_t num_in[NONCE_NUMIN_SIZE];
+	uint8_t ret_code;
+
+	memcpy(num_in, record->num_in, sizeof(num_in));
+	memcpy(parent_key, entry->parent_key, sizeof(parent_key));
+	memcpy(crypto_data, entry->data, SHA204_KEY_SIZE);
+
+	nonce_param.mode = NONCE_MODE_SEED_UPDATE;
+	nonce_param.num_in = num_in;
+	nonce_param.rand_out = rand_out;
+	nonce_param.temp_key = &temp_key;
+	ret_code = sha204h_nonce(&nonce_param);
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	gen_dig_param.zone = GENDIG_ZONE_DATA;
+	gen_dig_param.key_id = entry->parent_key_id;
+	gen_dig_param.stored_value = parent_key;
+	gen_dig_param.temp_key = &temp_key;
+	ret_code = sha204h_gen_dig(&gen_dig_param);
+	if (ret_code != SHA204_SUCCESS)
+		return ret_code;
+
+	encrypt_param.zone = SHA204_ZONE_DATA | SHA204_ZONE_COUNT_FLAG;
+	encrypt_param.address = (uint16_t) entry->slot << 3;
+	encrypt_param.crypto_data = crypto_data;
+	encrypt_param.mac = mac;
+	encrypt_param.temp_key = &temp_key;
+	return sha204h_encrypt(&encrypt_param);
+}
+
+
+/** \brief This function builds lot files, provisions the lot, and checks the results.
+ * \param[in] argc number of arguments
+ * \param[in] argv optional maximum number of threads and name of the lot file
+ * @return exit status of application, 1 if a result differs
+ */
+int main(int argc, char *argv[])
+{
+	struct sha204w_manifest_entry *entries = malloc(WRITE_LOT_BENCHMARK_DEVICES * sizeof(*entries));
+	uint8_t parent_keys[WRITE_LOT_BENCHMARK_KEYS][SHA204_KEY_SIZE];
+	uint8_t nonce_seed[SHA204W_NONCE_SEED_SIZE];
+	uint8_t *rand_out = malloc(WRITE_LOT_BENCHMARK_DEVICES * SHA204_KEY_SIZE);
+	uint8_t crypto_data[SHA204_KEY_SIZE], mac[SHA204_KEY_SIZE];
+	uint8_t expected_data[SHA204_KEY_SIZE], expected_mac[SHA204_KEY_SIZE];
+	long threads_max = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+	const char *file_name = argc > 2 ? argv[2] : "sha204_write_lot_benchmark.lot";
+	const struct sha204w_record *record;
+	struct sha204w_lot *lot;
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	uint32_t i, failed = 0;
+	double start, elapsed, interactive;
+	uint8_t threads, ret_code;
+
+	if (!entries || !rand_out) {
+		printf("out of memory\n");
+		return 1;
+	}
+	if (threads_max < 1)
+		threads_max = 1;
+	if (threads_max > SHA204W_THREADS_MAX)
+		threads_max = SHA204W_THREADS_MAX;
+
+	// All devices share a nonce seed. Their slots and parent keys vary.
+	for (i = 0; i < WRITE_LOT_BENCHMARK_KEYS; i++)
+		write_lot_benchmark_fill(&state, SHA204_KEY_SIZE, parent_keys[i]);
+	write_lot_benchmark_fill(&state, SHA204W_NONCE_SEED_SIZE, nonce_seed);
+	for (i = 0; i < WRITE_LOT_BENCHMARK_DEVICES; i++) {
+		entries[i].sn[0] = 0x01;
+		entries[i].sn[1] = 0x23;
+		write_lot_benchmark_fill(&state, 4, &entries[i].sn[2]);
+		entries[i].sn[6] = (uint8_t) (i >> 16);
+		entries[i].sn[7] = (uint8_t) (i >> 8);
+		entries[i].sn[8] = (uint8_t) i;
+		memcpy(entries[i].nonce_seed, nonce_seed, SHA204W_NONCE_SEED_SIZE);
+		entries[i].slot = (uint8_t) (i % 14);
+		write_lot_benchmark_fill(&state, SHA204_KEY_SIZE, entries[i].data);
+		entries[i].parent_key_id = 14 + (i & 1);
+		memcpy(entries[i].parent_key, parent_keys[i % WRITE_LOT_BENCHMARK_KEYS], SHA204_KEY_SIZE);
+	}
+	for (i = 0; i < WRITE_LOT_BENCHMARK_DEVICES; i++)
+		write_lot_benchmark_fill(&state, SHA204_KEY_SIZE, &rand_out[i * SHA204_KEY_SIZE]);
+
+	printf("%-26s %12s\n", "operation", "devices/s");
+
+	for (threads = 1; threads <= threads_max; threads++) {
+		start = write_lot_benchmark_now();
+		ret_code = sha204w_lot_build(threads, WRITE_LOT_BENCHMARK_DEVICES, entries, file_name);
+		elapsed = write_lot_benchmark_now() - start;
+		if (ret_code != SHA204_SUCCESS) {
+			printf("building the lot file failed: 0x%02X\n", ret_code);
+			return 1;
+		}
+		printf("build, %2u thread%-9s %12.0f\n", threads, threads > 1 ? "s" : "",
+				WRITE_LOT_BENCHMARK_DEVICES / elapsed);
+	}
+
+	ret_code = sha204w_lot_open(file_name, &lot);
+	if (ret_code != SHA204_SUCCESS) {
+		printf("opening the lot file failed: 0x%02X\n", ret_code);
+		return 1;
+	}
+
+	// The line finds every device by its serial number, in manifest order.
+	start = write_lot_benchmark_now();
+	for (i = 0; i < WRITE_LOT_BENCHMARK_DEVICES; i++) {
+		record = sha204w_lot_find(lot, entries[i].sn);
+		if (!record || (sha204w_finish(record, &rand_out[i * SHA204_KEY_SIZE], crypto_data, mac) != SHA204_SUCCESS))
+			failed++;
+	}
+	elapsed = write_lot_benchmark_now() - start;
+
+	start = write_lot_benchmark_now();
+	for (i = 0; i < WRITE_LOT_BENCHMARK_DEVICES; i++) {
+		record = sha204w_lot_find(lot, entries[i].sn);
+		if (!record || (write_lot_benchmark_interactive(&entries[i], record, &rand_out[i * SHA204_KEY_SIZE],
+				expected_data, expected_mac) != SHA204_SUCCESS))
+			failed++;
+	}
+	interactive = write_lot_benchmark_now() - start;
+
+	for (i = 0; i < WRITE_LOT_BENCHMARK_DEVICES; i++) {
+		record = sha204w_lot_find(lot, entries[i].sn);
+		if (!record || (sha204w_finish(record, &rand_out[i * SHA204_KEY_SIZE], crypto_data, mac) != SHA204_SUCCESS)
+				|| (write_lot_benchmark_interactive(&entries[i], record, &rand_out[i * SHA204_KEY_SIZE],
+					expected_data, expected_mac) != SHA204_SUCCESS)
+				|| memcmp(crypto_data, expected_data, sizeof(crypto_data)) || memcmp(mac, expected_mac, sizeof(mac)))
+			failed++;
+	}
+
+	printf("%-26s %12.0f\n", "interactive", WRITE_LOT_BENCHMARK_DEVICES / interactive);
+	printf("%-26s %12.0f\n", "finish from lot", WRITE_LOT_BENCHMARK_DEVICES / elapsed);
+	printf("%u of %lu devices differ\n", failed, WRITE_LOT_BENCHMARK_DEVICES);
+
+	sha204w_lot_close(lot);
+	remove(file_name);
+	free(rand_out);
+	free(entries);
+
+	return failed ? 1 : 0;
+}
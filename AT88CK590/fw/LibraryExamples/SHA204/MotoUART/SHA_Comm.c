@@ -23,6 +23,7 @@
 #include "SHA_CommInterface.h"
 #include "SHA_TimeUtils.h"
 #include "SHA_Status.h"
+#include "cryptoauth_crc.h"
 
 
 /** \brief Calculates CRC
@@ -32,31 +33,11 @@
  * \param[out] crc pointer to 16-bit CRC
  */
 void SHAC_CalculateCrc(uint8_t length, uint8_t *data, uint8_t *crc) {
-	uint8_t counter;
-	uint8_t crcLow = 0, crcHigh = 0, crcCarry;
-	uint8_t polyLow = 0x05, polyHigh = 0x80;
-	uint8_t shiftRegister;
-	uint8_t dataBit, crcBit;
-
-	for (counter = 0; counter < length; counter++) {
-	  for (shiftRegister = 0x01; shiftRegister > 0x00; shiftRegister <<= 1) {
-		 dataBit = (data[counter] & shiftRegister) ? 1 : 0;
-		 crcBit = crcHigh >> 7;
-
-		 // Shift CRC to the left by 1.
-		 crcCarry = crcLow >> 7;
-		 crcLow <<= 1;
-		 crcHigh <<= 1;
-		 crcHigh |= crcCarry;
-
-		 if ((dataBit ^ crcBit) != 0) {
-			crcLow ^= polyLow;
-			crcHigh ^= polyHigh;
-		 }
-	  }
-	}
-	crc[SHA_CRC_BYTE_INDEX_LOW] = crcLow;
-	crc[SHA_CRC_BYTE_INDEX_HIGH] = crcHigh;
+	uint8_t crcLittleEndian[CRYPTOAUTH_CRC_SIZE] = {0, 0};
+
+	cryptoauth_calculate_crc(length, data, crcLittleEndian);
+	crc[SHA_CRC_BYTE_INDEX_LOW] = crcLittleEndian[0];
+	crc[SHA_CRC_BYTE_INDEX_HIGH] = crcLittleEndian[1];
 }
 
 